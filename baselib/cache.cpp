@@ -0,0 +1,416 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <string.h>
+
+#include <glib.h>
+
+#include <oh_utils.h>
+#include <sahpi_wrappers.h>
+
+#include "cache.h"
+
+
+/***************************************************************
+ * Cache items
+ **************************************************************/
+struct cSessionCache::RptItem
+{
+    bool           next_valid;
+    SaHpiEntryIdT  next;
+    SaHpiRptEntryT rpte;
+};
+
+struct cSessionCache::RdrItem
+{
+    // false if the RDR was read by instrument id
+    bool          next_valid;
+    SaHpiEntryIdT next;
+    SaHpiRdrT     rdr;
+};
+
+struct cSessionCache::Resource
+{
+    bool         cnt_valid;
+    SaHpiUint32T cnt;
+    gint64       cnt_time;
+    // all RDRs from SAHPI_FIRST_ENTRY to SAHPI_LAST_ENTRY are cached
+    bool         complete;
+    // requested EntryId -> RdrItem
+    GHashTable * rdrs;
+};
+
+struct InstrumentKey
+{
+    SaHpiRdrTypeT      type;
+    SaHpiInstrumentIdT num;
+};
+
+/***************************************************************
+ * class cSessionCache
+ **************************************************************/
+cSessionCache::cSessionCache( guint max_age_sec )
+    : m_lock( wrap_g_mutex_new_init() ),
+      m_max_age( (gint64)max_age_sec * G_USEC_PER_SEC ),
+      m_gen( 0 ),
+      m_rpt_cnt_valid( false ),
+      m_rpt_cnt( 0 ),
+      m_rpt_cnt_time( 0 )
+{
+    m_rpt       = g_hash_table_new_full( g_direct_hash, g_direct_equal,
+                                         0, DeleteRptItem );
+    m_rpt_eids  = g_hash_table_new( g_direct_hash, g_direct_equal );
+    m_resources = g_hash_table_new_full( g_direct_hash, g_direct_equal,
+                                         0, DeleteResource );
+}
+
+cSessionCache::~cSessionCache()
+{
+    g_hash_table_destroy( m_resources );
+    g_hash_table_destroy( m_rpt_eids );
+    g_hash_table_destroy( m_rpt );
+    wrap_g_mutex_free_clear( m_lock );
+}
+
+guint cSessionCache::Generation()
+{
+    wrap_g_mutex_lock( m_lock );
+    guint gen = m_gen;
+    wrap_g_mutex_unlock( m_lock );
+
+    return gen;
+}
+
+bool cSessionCache::RptCountExpired()
+{
+    wrap_g_mutex_lock( m_lock );
+    bool expired = ( !m_rpt_cnt_valid ) || ( ( Now() - m_rpt_cnt_time ) > m_max_age );
+    wrap_g_mutex_unlock( m_lock );
+
+    return expired;
+}
+
+void cSessionCache::SetRptCount( SaHpiUint32T cnt )
+{
+    wrap_g_mutex_lock( m_lock );
+    if ( m_rpt_cnt_valid && ( m_rpt_cnt != cnt ) ) {
+        DoInvalidate();
+    }
+    m_rpt_cnt_valid = true;
+    m_rpt_cnt       = cnt;
+    m_rpt_cnt_time  = Now();
+    wrap_g_mutex_unlock( m_lock );
+}
+
+bool cSessionCache::RdrCountExpired( SaHpiResourceIdT rid )
+{
+    wrap_g_mutex_lock( m_lock );
+    Resource * res = GetResource( rid, false );
+    bool expired = ( !res ) || ( !res->cnt_valid ) ||
+                   ( ( Now() - res->cnt_time ) > m_max_age );
+    wrap_g_mutex_unlock( m_lock );
+
+    return expired;
+}
+
+void cSessionCache::SetRdrCount( SaHpiResourceIdT rid, SaHpiUint32T cnt )
+{
+    wrap_g_mutex_lock( m_lock );
+    Resource * res = GetResource( rid, true );
+    if ( res->cnt_valid && ( res->cnt != cnt ) ) {
+        g_hash_table_remove_all( res->rdrs );
+        res->complete = false;
+        ++m_gen;
+    }
+    res->cnt_valid = true;
+    res->cnt       = cnt;
+    res->cnt_time  = Now();
+    wrap_g_mutex_unlock( m_lock );
+}
+
+cSessionCache::eLookup cSessionCache::GetRptEntry( SaHpiEntryIdT eid,
+                                                   SaHpiEntryIdT& next_eid,
+                                                   SaHpiRptEntryT& rpte )
+{
+    eLookup rc = eMiss;
+
+    wrap_g_mutex_lock( m_lock );
+    gpointer rid;
+    if ( g_hash_table_lookup_extended( m_rpt_eids, GUINT_TO_POINTER( eid ), 0, &rid ) ) {
+        RptItem * item = reinterpret_cast<RptItem *>(g_hash_table_lookup( m_rpt, rid ));
+        if ( item && item->next_valid ) {
+            next_eid = item->next;
+            memcpy( &rpte, &item->rpte, sizeof(SaHpiRptEntryT) );
+            rc = eHit;
+        }
+    }
+    wrap_g_mutex_unlock( m_lock );
+
+    return rc;
+}
+
+cSessionCache::eLookup cSessionCache::GetRptEntryByResourceId( SaHpiResourceIdT rid,
+                                                               SaHpiRptEntryT& rpte )
+{
+    eLookup rc = eMiss;
+
+    wrap_g_mutex_lock( m_lock );
+    gpointer ptr = g_hash_table_lookup( m_rpt, GUINT_TO_POINTER( rid ) );
+    if ( ptr ) {
+        RptItem * item = reinterpret_cast<RptItem *>(ptr);
+        memcpy( &rpte, &item->rpte, sizeof(SaHpiRptEntryT) );
+        rc = eHit;
+    }
+    wrap_g_mutex_unlock( m_lock );
+
+    return rc;
+}
+
+void cSessionCache::PutRptEntry( guint gen,
+                                 SaHpiEntryIdT eid,
+                                 SaHpiEntryIdT next_eid,
+                                 const SaHpiRptEntryT& rpte )
+{
+    wrap_g_mutex_lock( m_lock );
+    if ( ( gen == m_gen ) && m_rpt_cnt_valid ) {
+        RptItem * item = g_new( RptItem, 1 );
+        item->next_valid = true;
+        item->next       = next_eid;
+        memcpy( &item->rpte, &rpte, sizeof(SaHpiRptEntryT) );
+        g_hash_table_insert( m_rpt, GUINT_TO_POINTER( rpte.ResourceId ), item );
+        // SAHPI_FIRST_ENTRY is kept as an alias of the first entry
+        g_hash_table_insert( m_rpt_eids,
+                             GUINT_TO_POINTER( eid ),
+                             GUINT_TO_POINTER( rpte.ResourceId ) );
+        g_hash_table_insert( m_rpt_eids,
+                             GUINT_TO_POINTER( rpte.EntryId ),
+                             GUINT_TO_POINTER( rpte.ResourceId ) );
+    }
+    wrap_g_mutex_unlock( m_lock );
+}
+
+void cSessionCache::PutRptEntry( guint gen, const SaHpiRptEntryT& rpte )
+{
+    wrap_g_mutex_lock( m_lock );
+    if ( ( gen == m_gen ) && m_rpt_cnt_valid ) {
+        gpointer ptr = g_hash_table_lookup( m_rpt, GUINT_TO_POINTER( rpte.ResourceId ) );
+        RptItem * item = reinterpret_cast<RptItem *>(ptr);
+        if ( !item ) {
+            item = g_new( RptItem, 1 );
+            item->next_valid = false;
+            item->next       = SAHPI_LAST_ENTRY;
+            g_hash_table_insert( m_rpt, GUINT_TO_POINTER( rpte.ResourceId ), item );
+        }
+        memcpy( &item->rpte, &rpte, sizeof(SaHpiRptEntryT) );
+    }
+    wrap_g_mutex_unlock( m_lock );
+}
+
+cSessionCache::eLookup cSessionCache::GetRdr( SaHpiResourceIdT rid,
+                                              SaHpiEntryIdT eid,
+                                              SaHpiEntryIdT& next_eid,
+                                              SaHpiRdrT& rdr )
+{
+    eLookup rc = eMiss;
+
+    wrap_g_mutex_lock( m_lock );
+    Resource * res = GetResource( rid, false );
+    if ( res ) {
+        gpointer ptr = g_hash_table_lookup( res->rdrs, GUINT_TO_POINTER( eid ) );
+        RdrItem * item = reinterpret_cast<RdrItem *>(ptr);
+        if ( item && item->next_valid ) {
+            next_eid = item->next;
+            memcpy( &rdr, &item->rdr, sizeof(SaHpiRdrT) );
+            rc = eHit;
+        }
+    }
+    wrap_g_mutex_unlock( m_lock );
+
+    return rc;
+}
+
+cSessionCache::eLookup cSessionCache::GetRdrByInstrumentId( SaHpiResourceIdT rid,
+                                                            SaHpiRdrTypeT type,
+                                                            SaHpiInstrumentIdT num,
+                                                            SaHpiRdrT& rdr )
+{
+    eLookup rc = eMiss;
+
+    wrap_g_mutex_lock( m_lock );
+    Resource * res = GetResource( rid, false );
+    if ( res ) {
+        InstrumentKey ik;
+        ik.type = type;
+        ik.num  = num;
+        gpointer ptr = g_hash_table_find( res->rdrs, FindInstrument, &ik );
+        if ( ptr ) {
+            memcpy( &rdr, &reinterpret_cast<RdrItem *>(ptr)->rdr, sizeof(SaHpiRdrT) );
+            rc = eHit;
+        } else if ( res->complete ) {
+            rc = eAbsent;
+        }
+    }
+    wrap_g_mutex_unlock( m_lock );
+
+    return rc;
+}
+
+void cSessionCache::PutRdr( guint gen,
+                            SaHpiResourceIdT rid,
+                            SaHpiEntryIdT eid,
+                            SaHpiEntryIdT next_eid,
+                            const SaHpiRdrT& rdr )
+{
+    wrap_g_mutex_lock( m_lock );
+    Resource * res = GetResource( rid, false );
+    if ( ( gen == m_gen ) && res && res->cnt_valid ) {
+        RdrItem * item = g_new( RdrItem, 1 );
+        item->next_valid = true;
+        item->next       = next_eid;
+        memcpy( &item->rdr, &rdr, sizeof(SaHpiRdrT) );
+        g_hash_table_insert( res->rdrs, GUINT_TO_POINTER( eid ), item );
+        if ( next_eid == SAHPI_LAST_ENTRY ) {
+            res->complete = CheckComplete( res );
+        }
+    }
+    wrap_g_mutex_unlock( m_lock );
+}
+
+void cSessionCache::PutRdr( guint gen, SaHpiResourceIdT rid, const SaHpiRdrT& rdr )
+{
+    wrap_g_mutex_lock( m_lock );
+    Resource * res = GetResource( rid, false );
+    if ( ( gen == m_gen ) && res && res->cnt_valid ) {
+        gpointer key = GUINT_TO_POINTER( rdr.RecordId );
+        if ( !g_hash_table_lookup( res->rdrs, key ) ) {
+            RdrItem * item = g_new( RdrItem, 1 );
+            item->next_valid = false;
+            item->next       = SAHPI_LAST_ENTRY;
+            memcpy( &item->rdr, &rdr, sizeof(SaHpiRdrT) );
+            g_hash_table_insert( res->rdrs, key, item );
+        }
+    }
+    wrap_g_mutex_unlock( m_lock );
+}
+
+void cSessionCache::InvalidateResource( SaHpiResourceIdT rid )
+{
+    wrap_g_mutex_lock( m_lock );
+    DoInvalidateResource( rid );
+    wrap_g_mutex_unlock( m_lock );
+}
+
+void cSessionCache::InvalidateRpt( SaHpiResourceIdT rid )
+{
+    wrap_g_mutex_lock( m_lock );
+    g_hash_table_remove( m_rpt, GUINT_TO_POINTER( rid ) );
+    ++m_gen;
+    wrap_g_mutex_unlock( m_lock );
+}
+
+void cSessionCache::Invalidate()
+{
+    wrap_g_mutex_lock( m_lock );
+    DoInvalidate();
+    wrap_g_mutex_unlock( m_lock );
+}
+
+gint64 cSessionCache::Now()
+{
+#if GLIB_CHECK_VERSION (2, 28, 0)
+    return g_get_monotonic_time();
+#else
+    GTimeVal tv;
+    g_get_current_time( &tv );
+    return (gint64)tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec;
+#endif
+}
+
+void cSessionCache::DeleteRptItem( gpointer ptr )
+{
+    g_free( ptr );
+}
+
+void cSessionCache::DeleteRdrItem( gpointer ptr )
+{
+    g_free( ptr );
+}
+
+gboolean cSessionCache::FindInstrument( gpointer key, gpointer value, gpointer user_data )
+{
+    const RdrItem * item = reinterpret_cast<const RdrItem *>(value);
+    const InstrumentKey * ik = reinterpret_cast<const InstrumentKey *>(user_data);
+
+    return ( item->rdr.RdrType == ik->type ) &&
+           ( oh_get_instrument_id( &item->rdr ) == ik->num );
+}
+
+void cSessionCache::DeleteResource( gpointer ptr )
+{
+    Resource * res = reinterpret_cast<Resource *>(ptr);
+    g_hash_table_destroy( res->rdrs );
+    g_free( res );
+}
+
+// Must be called under m_lock
+cSessionCache::Resource * cSessionCache::GetResource( SaHpiResourceIdT rid, bool create )
+{
+    gpointer key = GUINT_TO_POINTER( rid );
+    Resource * res = reinterpret_cast<Resource *>(g_hash_table_lookup( m_resources, key ));
+    if ( ( !res ) && create ) {
+        res = g_new0( Resource, 1 );
+        res->cnt_valid = false;
+        res->complete  = false;
+        res->rdrs      = g_hash_table_new_full( g_direct_hash, g_direct_equal,
+                                                0, DeleteRdrItem );
+        g_hash_table_insert( m_resources, key, res );
+    }
+
+    return res;
+}
+
+// Must be called under m_lock
+bool cSessionCache::CheckComplete( Resource * res )
+{
+    guint n = g_hash_table_size( res->rdrs );
+    SaHpiEntryIdT eid = SAHPI_FIRST_ENTRY;
+    for ( guint i = 0; i <= n; ++i ) {
+        gpointer ptr = g_hash_table_lookup( res->rdrs, GUINT_TO_POINTER( eid ) );
+        RdrItem * item = reinterpret_cast<RdrItem *>(ptr);
+        if ( ( !item ) || ( !item->next_valid ) ) {
+            return false;
+        }
+        if ( item->next == SAHPI_LAST_ENTRY ) {
+            return true;
+        }
+        eid = item->next;
+    }
+
+    return false;
+}
+
+// Must be called under m_lock
+void cSessionCache::DoInvalidateResource( SaHpiResourceIdT rid )
+{
+    g_hash_table_remove( m_rpt, GUINT_TO_POINTER( rid ) );
+    g_hash_table_remove( m_resources, GUINT_TO_POINTER( rid ) );
+    ++m_gen;
+}
+
+// Must be called under m_lock
+void cSessionCache::DoInvalidate()
+{
+    g_hash_table_remove_all( m_rpt );
+    g_hash_table_remove_all( m_rpt_eids );
+    g_hash_table_remove_all( m_resources );
+    m_rpt_cnt_valid = false;
+    ++m_gen;
+}
@@ -0,0 +1,129 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __BASELIB_CACHE_H
+#define __BASELIB_CACHE_H
+
+#include <glib.h>
+
+#include <SaHpi.h>
+
+
+/***************************************************************
+ * Client side RPT/RDR cache of a session
+ *
+ * Entries are stored as returned to the user,
+ * i.e. with the domain entity root already applied.
+ * RPT entries are valid as long as the domain RptUpdateCount
+ * stays the same, RDRs of a resource as long as its
+ * RDR update count stays the same. The counters are
+ * rechecked when they are older than max_age.
+ *
+ * Every invalidation bumps the generation number.
+ * The data read by an RPC is put to the cache only if
+ * the generation did not change while the RPC was in progress.
+ *
+ * All methods are thread safe.
+ **************************************************************/
+class cSessionCache
+{
+public:
+
+    enum eLookup
+    {
+        eMiss,      // not cached
+        eHit,       // cached
+        eAbsent     // all RDRs of the resource are cached and none matches
+    };
+
+    explicit cSessionCache( guint max_age_sec );
+    ~cSessionCache();
+
+    guint Generation();
+
+    // Update counters
+    bool RptCountExpired();
+    void SetRptCount( SaHpiUint32T cnt );
+    bool RdrCountExpired( SaHpiResourceIdT rid );
+    void SetRdrCount( SaHpiResourceIdT rid, SaHpiUint32T cnt );
+
+    // RPT
+    eLookup GetRptEntry( SaHpiEntryIdT eid,
+                         SaHpiEntryIdT& next_eid,
+                         SaHpiRptEntryT& rpte );
+    eLookup GetRptEntryByResourceId( SaHpiResourceIdT rid,
+                                     SaHpiRptEntryT& rpte );
+    void PutRptEntry( guint gen,
+                      SaHpiEntryIdT eid,
+                      SaHpiEntryIdT next_eid,
+                      const SaHpiRptEntryT& rpte );
+    void PutRptEntry( guint gen, const SaHpiRptEntryT& rpte );
+
+    // RDRs
+    eLookup GetRdr( SaHpiResourceIdT rid,
+                    SaHpiEntryIdT eid,
+                    SaHpiEntryIdT& next_eid,
+                    SaHpiRdrT& rdr );
+    eLookup GetRdrByInstrumentId( SaHpiResourceIdT rid,
+                                  SaHpiRdrTypeT type,
+                                  SaHpiInstrumentIdT num,
+                                  SaHpiRdrT& rdr );
+    void PutRdr( guint gen,
+                 SaHpiResourceIdT rid,
+                 SaHpiEntryIdT eid,
+                 SaHpiEntryIdT next_eid,
+                 const SaHpiRdrT& rdr );
+    void PutRdr( guint gen, SaHpiResourceIdT rid, const SaHpiRdrT& rdr );
+
+    // Invalidation
+    void InvalidateResource( SaHpiResourceIdT rid );
+    void InvalidateRpt( SaHpiResourceIdT rid );
+    void Invalidate();
+
+private:
+
+    cSessionCache( const cSessionCache& );
+    cSessionCache& operator =( cSessionCache& );
+
+    struct RptItem;
+    struct RdrItem;
+    struct Resource;
+
+    static gint64 Now();
+    static void DeleteRptItem( gpointer ptr );
+    static void DeleteRdrItem( gpointer ptr );
+    static void DeleteResource( gpointer ptr );
+    static gboolean FindInstrument( gpointer key, gpointer value, gpointer user_data );
+
+    Resource * GetResource( SaHpiResourceIdT rid, bool create );
+    bool CheckComplete( Resource * res );
+    void DoInvalidateResource( SaHpiResourceIdT rid );
+    void DoInvalidate();
+
+private:
+
+    // data
+    GMutex *     m_lock;
+    gint64       m_max_age;
+    guint        m_gen;
+    bool         m_rpt_cnt_valid;
+    SaHpiUint32T m_rpt_cnt;
+    gint64       m_rpt_cnt_time;
+    // ResourceId -> RptItem
+    GHashTable * m_rpt;
+    // RPT EntryId -> ResourceId
+    GHashTable * m_rpt_eids;
+    // ResourceId -> Resource
+    GHashTable * m_resources;
+};
+
+
+#endif /* __BASELIB_CACHE_H */
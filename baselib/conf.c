@@ -47,7 +47,11 @@ static int load_client_config(const char *filename);
 static void add_domain_conf(SaHpiDomainIdT did,
                             const char *host,
                             unsigned short port,
-                            const SaHpiEntityPathT *entity_root);
+                            const SaHpiEntityPathT *entity_root,
+                            unsigned int connections,
+                            unsigned int cache,
+                            unsigned int compression);
+static unsigned int default_compression(void);
 static void extract_keys(gpointer key, gpointer val, gpointer user_data);
 static gint compare_keys(const gint *a, const gint *b);
 
@@ -104,7 +108,8 @@ void ohc_conf_init(void)
             }
             oh_init_ep(&entity_root);
 
-            add_domain_conf(OH_DEFAULT_DOMAIN_ID, host, port, &entity_root);
+            add_domain_conf(OH_DEFAULT_DOMAIN_ID, host, port, &entity_root, 0, 0,
+                            default_compression());
         }
     }
 
@@ -170,7 +175,7 @@ SaErrorT ohc_add_domain_conf(const char *host,
     }
 
     *did = prev_did + 1;
-    add_domain_conf(*did, host, port, entity_root);
+    add_domain_conf(*did, host, port, entity_root, 0, 0, default_compression());
 
     ohc_unlock();
 
@@ -194,7 +199,7 @@ SaErrorT ohc_add_domain_conf_by_id(SaHpiDomainIdT did,
         return SA_ERR_HPI_DUPLICATE;
     }
     
-    add_domain_conf(did, host, port, entity_root);
+    add_domain_conf(did, host, port, entity_root, 0, 0, default_compression());
     ohc_unlock();
     return SA_OK;
 }
@@ -270,6 +275,9 @@ enum {
         HPI_CLIENT_CONF_TOKEN_PORT,
         HPI_CLIENT_CONF_TOKEN_ROOT,
         HPI_CLIENT_CONF_TOKEN_MY_EP,
+        HPI_CLIENT_CONF_TOKEN_CONNECTIONS,
+        HPI_CLIENT_CONF_TOKEN_CACHE,
+        HPI_CLIENT_CONF_TOKEN_COMPRESSION,
 } hpiClientConfType;
 
 struct tokens {
@@ -303,6 +311,18 @@ static struct tokens ohc_conf_tokens[] = {
                 .name = "my_entity",
                 .token = HPI_CLIENT_CONF_TOKEN_MY_EP
         },
+        {
+                .name = "connections",
+                .token = HPI_CLIENT_CONF_TOKEN_CONNECTIONS
+        },
+        {
+                .name = "cache",
+                .token = HPI_CLIENT_CONF_TOKEN_CACHE
+        },
+        {
+                .name = "compression",
+                .token = HPI_CLIENT_CONF_TOKEN_COMPRESSION
+        },
 };
 
 /*******************************************************************************
@@ -362,7 +382,10 @@ static int get_next_good_token_in_domain_stanza(GScanner *oh_scanner) {
         while (next_token != G_TOKEN_RIGHT_CURLY &&
                next_token != HPI_CLIENT_CONF_TOKEN_HOST &&
                next_token != HPI_CLIENT_CONF_TOKEN_PORT &&
-               next_token != HPI_CLIENT_CONF_TOKEN_ROOT) {
+               next_token != HPI_CLIENT_CONF_TOKEN_ROOT &&
+               next_token != HPI_CLIENT_CONF_TOKEN_CONNECTIONS &&
+               next_token != HPI_CLIENT_CONF_TOKEN_CACHE &&
+               next_token != HPI_CLIENT_CONF_TOKEN_COMPRESSION) {
                 if (next_token == G_TOKEN_EOF) break;
                 next_token = g_scanner_get_next_token(oh_scanner);
         }
@@ -373,7 +396,10 @@ static int get_next_good_token_in_domain_stanza(GScanner *oh_scanner) {
 static void add_domain_conf(SaHpiDomainIdT did,
                             const char *host,
                             unsigned short port,
-                            const SaHpiEntityPathT * entity_root)
+                            const SaHpiEntityPathT * entity_root,
+                            unsigned int connections,
+                            unsigned int cache,
+                            unsigned int compression)
 {
     struct ohc_domain_conf *domain_conf;
 
@@ -382,20 +408,42 @@ static void add_domain_conf(SaHpiDomainIdT did,
     strncpy(domain_conf->host, host, SAHPI_MAX_TEXT_BUFFER_LENGTH);
     domain_conf->port = port;
     memcpy(&domain_conf->entity_root, entity_root, sizeof(SaHpiEntityPathT));
+    domain_conf->connections = connections;
+    domain_conf->cache = cache;
+    domain_conf->compression = compression;
     g_hash_table_insert(ohc_domains, &domain_conf->did, domain_conf);
 }
 
+/* Used for domains without a "compression" setting,
+ * e.g. the ones added with oHpiDomainAdd */
+static unsigned int default_compression(void)
+{
+    const char *compression = getenv("OPENHPI_COMPRESSION");
+
+    if (compression == NULL) {
+        return 0;
+    }
+
+    return (atoi(compression) != 0) ? 1 : 0;
+}
+
 static int process_domain_token (GScanner *oh_scanner)
 {
         SaHpiDomainIdT did;
         char host[SAHPI_MAX_TEXT_BUFFER_LENGTH];
         unsigned int port;
         SaHpiEntityPathT entity_root;
+        unsigned int connections;
+        unsigned int cache;
+        unsigned int compression;
 
         int next_token;
 
         host[0] = '\0';
         port = OPENHPI_DEFAULT_DAEMON_PORT;
+        connections = 0;
+        cache = 0;
+        compression = default_compression();
         oh_init_ep(&entity_root);
 
         next_token = g_scanner_get_next_token(oh_scanner);
@@ -468,6 +516,42 @@ static int process_domain_token (GScanner *oh_scanner)
                                 CRIT("Processing entity_root: Invalid entity path");
                                 return -10;
                         }
+                } else if (next_token == HPI_CLIENT_CONF_TOKEN_CONNECTIONS) {
+                        next_token = g_scanner_get_next_token(oh_scanner);
+                        if (next_token != G_TOKEN_EQUAL_SIGN) {
+                                CRIT("Processing connections: Expected equal sign");
+                                return -10;
+                        }
+                        next_token = g_scanner_get_next_token(oh_scanner);
+                        if (next_token != G_TOKEN_INT) {
+                                CRIT("Processing connections: Expected an integer");
+                                return -10;
+                        }
+                        connections = oh_scanner->value.v_int;
+                } else if (next_token == HPI_CLIENT_CONF_TOKEN_CACHE) {
+                        next_token = g_scanner_get_next_token(oh_scanner);
+                        if (next_token != G_TOKEN_EQUAL_SIGN) {
+                                CRIT("Processing cache: Expected equal sign");
+                                return -10;
+                        }
+                        next_token = g_scanner_get_next_token(oh_scanner);
+                        if (next_token != G_TOKEN_INT) {
+                                CRIT("Processing cache: Expected an integer");
+                                return -10;
+                        }
+                        cache = oh_scanner->value.v_int;
+                } else if (next_token == HPI_CLIENT_CONF_TOKEN_COMPRESSION) {
+                        next_token = g_scanner_get_next_token(oh_scanner);
+                        if (next_token != G_TOKEN_EQUAL_SIGN) {
+                                CRIT("Processing compression: Expected equal sign");
+                                return -10;
+                        }
+                        next_token = g_scanner_get_next_token(oh_scanner);
+                        if (next_token != G_TOKEN_INT) {
+                                CRIT("Processing compression: Expected an integer");
+                                return -10;
+                        }
+                        compression = (oh_scanner->value.v_int != 0) ? 1 : 0;
                 } else {
                         CRIT("Processing domain: Should not get here!");
                         return -10;
@@ -483,7 +567,8 @@ static int process_domain_token (GScanner *oh_scanner)
                 return -10;
         }
 
-        add_domain_conf(did, host, port, &entity_root);
+        add_domain_conf(did, host, port, &entity_root, connections, cache,
+                        compression);
 
         return 0;
 }
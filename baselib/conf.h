@@ -34,6 +34,16 @@ struct ohc_domain_conf {
         char host[SAHPI_MAX_TEXT_BUFFER_LENGTH];
         unsigned short port;
         SaHpiEntityPathT entity_root;
+        /* 0 - one connection per calling thread,
+           N - at most N connections shared by all threads of a session */
+        unsigned int connections;
+        /* 0 - no client side RPT/RDR cache,
+           N - cache RPT entries and RDRs, revalidate them
+               against the update counters every N seconds */
+        unsigned int cache;
+        /* 0 - plain messages,
+           1 - compress messages if the daemon supports it */
+        unsigned int compression;
 };
 
 
@@ -432,3 +432,450 @@ SaErrorT SAHPI_API oHpiDomainEntryGetByDomainId (
     return SA_OK;
 }
 
+
+
+/*----------------------------------------------------------------------------*/
+/* oHpiSensorCacheStatsGet                                                    */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiSensorCacheStatsGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_OUT   oHpiSensorCacheStatsT *stats)
+{
+    SaErrorT rv;
+
+    if (!stats) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams;
+    ClientRpcParams oparams(stats);
+    rv = ohc_sess_rpc(eFoHpiSensorCacheStatsGet, sid, iparams, oparams);
+
+    return rv;
+}
+
+/*----------------------------------------------------------------------------*/
+/* oHpiSensorReadingsGet                                                      */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiSensorReadingsGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiResourceIdT rid,
+    SAHPI_INOUT oHpiSensorReadingsT *readings)
+{
+    SaErrorT rv;
+
+    if (!readings) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if (readings->NumberOfReadings > OH_MAX_SENSOR_READINGS) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams(&rid, readings);
+    ClientRpcParams oparams(readings);
+    rv = ohc_sess_rpc(eFoHpiSensorReadingsGet, sid, iparams, oparams);
+
+    return rv;
+}
+
+/*----------------------------------------------------------------------------*/
+/* oHpiSensorHistoryGet                                                       */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiSensorHistoryGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiResourceIdT rid,
+    SAHPI_IN    SaHpiSensorNumT num,
+    SAHPI_IN    SaHpiTimeT start,
+    SAHPI_IN    SaHpiTimeT end,
+    SAHPI_OUT   oHpiSensorHistoryT *history)
+{
+    SaErrorT rv;
+
+    if (!history) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams(&rid, &num, &start, &end);
+    ClientRpcParams oparams(history);
+    rv = ohc_sess_rpc(eFoHpiSensorHistoryGet, sid, iparams, oparams);
+
+    return rv;
+}
+
+/*----------------------------------------------------------------------------*/
+/* oHpiEventsGet                                                              */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiEventsGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiTimeoutT Timeout,
+    SAHPI_IN    SaHpiUint32T MaxEvents,
+    SAHPI_IN    SaHpiUint32T MaxBytes,
+    SAHPI_OUT   SaHpiUint32T *NumberOfEvents,
+    SAHPI_OUT   SaHpiEventT *Events,
+    SAHPI_INOUT SaHpiRdrT *Rdrs,
+    SAHPI_INOUT SaHpiRptEntryT *RptEntries,
+    SAHPI_INOUT SaHpiEvtQueueStatusT *EventQueueStatus)
+{
+    SaErrorT rv;
+
+    if (Timeout < SAHPI_TIMEOUT_BLOCK || !NumberOfEvents || !Events) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if (MaxEvents == 0) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if (MaxEvents > OH_MAX_EVENTS_GET) {
+        MaxEvents = OH_MAX_EVENTS_GET;
+    }
+
+    SaHpiBoolT want_rdrs = Rdrs ? SAHPI_TRUE : SAHPI_FALSE;
+    SaHpiBoolT want_rptes = RptEntries ? SAHPI_TRUE : SAHPI_FALSE;
+    oHpiEventBatchT batch;
+    SaHpiEvtQueueStatusT status = 0;
+
+    memset(&batch, 0, sizeof(batch));
+
+    ClientRpcParams iparams(&Timeout, &MaxEvents, &MaxBytes, &want_rdrs, &want_rptes);
+    ClientRpcParams oparams(&batch, &status);
+    rv = ohc_sess_rpc(eFoHpiEventsGet, sid, iparams, oparams);
+
+    SaHpiUint32T n = batch.NumberOfEvents;
+    if (rv == SA_OK) {
+        if ((n == 0) || (n > MaxEvents) ||
+            (want_rdrs && (batch.NumberOfRdrs != n)) ||
+            (want_rptes && (batch.NumberOfRptEntries != n)))
+        {
+            rv = SA_ERR_HPI_INTERNAL_ERROR;
+        }
+    }
+
+    if (rv == SA_OK) {
+        memcpy(Events, batch.Events, n * sizeof(SaHpiEventT));
+        if (Rdrs) {
+            memcpy(Rdrs, batch.Rdrs, n * sizeof(SaHpiRdrT));
+        }
+        if (RptEntries) {
+            memcpy(RptEntries, batch.RptEntries, n * sizeof(SaHpiRptEntryT));
+        }
+        if (EventQueueStatus) {
+            *EventQueueStatus = status;
+        }
+        *NumberOfEvents = n;
+    }
+
+    g_free(batch.Events);
+    g_free(batch.Rdrs);
+    g_free(batch.RptEntries);
+
+    if (rv != SA_OK) {
+        return rv;
+    }
+
+    /* Resource and domain changes outdate the cached RPT and RDRs */
+    for (SaHpiUint32T i = 0; i < n; ++i) {
+        switch (Events[i].EventType) {
+            case SAHPI_ET_RESOURCE:
+            case SAHPI_ET_HOTSWAP:
+                ohc_sess_cache_invalidate(sid, Events[i].Source);
+                break;
+            case SAHPI_ET_DOMAIN:
+                ohc_sess_cache_invalidate(sid, SAHPI_UNSPECIFIED_RESOURCE_ID);
+                break;
+            default:
+                break;
+        }
+    }
+
+    SaHpiEntityPathT entity_root;
+    rv = ohc_sess_get_entity_root(sid, entity_root);
+    if (rv != SA_OK) {
+        return rv;
+    }
+    for (SaHpiUint32T i = 0; i < n; ++i) {
+        if (RptEntries) {
+            oh_concat_ep(&RptEntries[i].ResourceEntity, &entity_root);
+        }
+        if (Rdrs) {
+            oh_concat_ep(&Rdrs[i].Entity, &entity_root);
+        }
+    }
+
+    return SA_OK;
+}
+
+/*----------------------------------------------------------------------------*/
+/* oHpiEventFilterSet                                                         */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiEventFilterSet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    const oHpiEventFilterT *filter)
+{
+    SaErrorT rv;
+    oHpiEventFilterT f;
+
+    // A filter passing all events removes the session filter
+    if (filter) {
+        memcpy(&f, filter, sizeof(oHpiEventFilterT));
+    } else {
+        memset(&f, 0, sizeof(oHpiEventFilterT));
+        f.MinSeverity = SAHPI_ALL_SEVERITIES;
+    }
+    if (f.NumberOfResources > OH_MAX_FILTER_RESOURCES) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if (f.NumberOfSensorTypes > OH_MAX_FILTER_SENSOR_TYPES) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams(&f);
+    ClientRpcParams oparams;
+    rv = ohc_sess_rpc(eFoHpiEventFilterSet, sid, iparams, oparams);
+
+    return rv;
+}
+
+/*----------------------------------------------------------------------------*/
+/* oHpiEventLogEntriesGet                                                     */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiEventLogEntriesGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiResourceIdT rid,
+    SAHPI_IN    SaHpiEventLogEntryIdT StartEntryId,
+    SAHPI_IN    SaHpiUint32T MaxEntries,
+    SAHPI_IN    SaHpiTimeT StartTime,
+    SAHPI_IN    SaHpiTimeT EndTime,
+    SAHPI_OUT   SaHpiUint32T *NumberOfEntries,
+    SAHPI_OUT   SaHpiEventLogEntryT *Entries,
+    SAHPI_INOUT SaHpiRdrT *Rdrs,
+    SAHPI_INOUT SaHpiRptEntryT *RptEntries,
+    SAHPI_OUT   SaHpiEventLogEntryIdT *NextEntryId)
+{
+    SaErrorT rv;
+
+    if (!NumberOfEntries || !Entries || !NextEntryId) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if ((MaxEntries == 0) || (StartEntryId == SAHPI_NO_MORE_ENTRIES)) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if (MaxEntries > OH_MAX_EVENT_LOG_ENTRIES_GET) {
+        MaxEntries = OH_MAX_EVENT_LOG_ENTRIES_GET;
+    }
+
+    SaHpiBoolT want_rdrs = Rdrs ? SAHPI_TRUE : SAHPI_FALSE;
+    SaHpiBoolT want_rptes = RptEntries ? SAHPI_TRUE : SAHPI_FALSE;
+    oHpiEventLogRangeT range;
+    oHpiEventLogBatchT batch;
+    SaHpiEventLogEntryIdT next_id = SAHPI_NO_MORE_ENTRIES;
+
+    range.StartEntryId   = StartEntryId;
+    range.MaxEntries     = MaxEntries;
+    range.StartTime      = StartTime;
+    range.EndTime        = EndTime;
+    range.WantRdrs       = want_rdrs;
+    range.WantRptEntries = want_rptes;
+    memset(&batch, 0, sizeof(batch));
+
+    ClientRpcParams iparams(&rid, &range);
+    ClientRpcParams oparams(&batch, &next_id);
+    rv = ohc_sess_rpc(eFoHpiEventLogEntriesGet, sid, iparams, oparams);
+
+    SaHpiUint32T n = batch.NumberOfEntries;
+    if (rv == SA_OK) {
+        if ((n > MaxEntries) ||
+            (want_rdrs && (batch.NumberOfRdrs != n)) ||
+            (want_rptes && (batch.NumberOfRptEntries != n)))
+        {
+            rv = SA_ERR_HPI_INTERNAL_ERROR;
+        }
+    }
+
+    if ((rv == SA_OK) && (n > 0)) {
+        memcpy(Entries, batch.Entries, n * sizeof(SaHpiEventLogEntryT));
+        if (Rdrs) {
+            memcpy(Rdrs, batch.Rdrs, n * sizeof(SaHpiRdrT));
+        }
+        if (RptEntries) {
+            memcpy(RptEntries, batch.RptEntries, n * sizeof(SaHpiRptEntryT));
+        }
+    }
+
+    g_free(batch.Entries);
+    g_free(batch.Rdrs);
+    g_free(batch.RptEntries);
+
+    if (rv != SA_OK) {
+        return rv;
+    }
+
+    /* Domain Events carry the client side DomainId */
+    if (rid == SAHPI_UNSPECIFIED_RESOURCE_ID) {
+        SaHpiDomainIdT did;
+        rv = ohc_sess_get_did(sid, did);
+        if (rv != SA_OK) {
+            return rv;
+        }
+        for (SaHpiUint32T i = 0; i < n; ++i) {
+            if (Entries[i].Event.EventType == SAHPI_ET_DOMAIN) {
+                Entries[i].Event.EventDataUnion.DomainEvent.DomainId = did;
+            }
+        }
+    }
+
+    SaHpiEntityPathT entity_root;
+    rv = ohc_sess_get_entity_root(sid, entity_root);
+    if (rv != SA_OK) {
+        return rv;
+    }
+    for (SaHpiUint32T i = 0; i < n; ++i) {
+        if (RptEntries) {
+            oh_concat_ep(&RptEntries[i].ResourceEntity, &entity_root);
+        }
+        if (Rdrs) {
+            oh_concat_ep(&Rdrs[i].Entity, &entity_root);
+        }
+    }
+
+    *NumberOfEntries = n;
+    *NextEntryId = next_id;
+
+    return SA_OK;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* oHpiHandlerStatusGet                                                       */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiHandlerStatusGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    oHpiHandlerIdT id,
+    SAHPI_OUT   oHpiHandlerStatusT *status)
+{
+    SaErrorT rv;
+
+    if (id == 0 || !status) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams(&id);
+    ClientRpcParams oparams(status);
+    rv = ohc_sess_rpc(eFoHpiHandlerStatusGet, sid, iparams, oparams);
+
+    return rv;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* oHpiMemPoolStatsGet                                                        */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiMemPoolStatsGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiEntryIdT EntryId,
+    SAHPI_OUT   SaHpiEntryIdT *NextEntryId,
+    SAHPI_OUT   oHpiMemPoolStatsT *Stats)
+{
+    SaErrorT rv;
+
+    if (EntryId == SAHPI_LAST_ENTRY || !NextEntryId || !Stats) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams(&EntryId);
+    ClientRpcParams oparams(NextEntryId, Stats);
+    rv = ohc_sess_rpc(eFoHpiMemPoolStatsGet, sid, iparams, oparams);
+
+    return rv;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* oHpiMetricGet                                                              */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiMetricGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiEntryIdT EntryId,
+    SAHPI_OUT   SaHpiEntryIdT *NextEntryId,
+    SAHPI_OUT   oHpiMetricT *Metric)
+{
+    SaErrorT rv;
+
+    if (EntryId == SAHPI_LAST_ENTRY || !NextEntryId || !Metric) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+
+    ClientRpcParams iparams(&EntryId);
+    ClientRpcParams oparams(NextEntryId, Metric);
+    rv = ohc_sess_rpc(eFoHpiMetricGet, sid, iparams, oparams);
+
+    return rv;
+}
+
+
+/*----------------------------------------------------------------------------*/
+/* oHpiIdrGet                                                                 */
+/*----------------------------------------------------------------------------*/
+SaErrorT SAHPI_API oHpiIdrGet (
+    SAHPI_IN    SaHpiSessionIdT sid,
+    SAHPI_IN    SaHpiResourceIdT rid,
+    SAHPI_IN    SaHpiIdrIdT IdrId,
+    SAHPI_IN    SaHpiEntryIdT StartAreaId,
+    SAHPI_IN    SaHpiUint32T MaxAreas,
+    SAHPI_IN    SaHpiUint32T MaxFields,
+    SAHPI_OUT   SaHpiIdrInfoT *IdrInfo,
+    SAHPI_OUT   SaHpiUint32T *NumberOfAreas,
+    SAHPI_OUT   SaHpiIdrAreaHeaderT *Areas,
+    SAHPI_OUT   SaHpiUint32T *NumberOfFields,
+    SAHPI_OUT   SaHpiIdrFieldT *Fields,
+    SAHPI_OUT   SaHpiEntryIdT *NextAreaId)
+{
+    SaErrorT rv;
+
+    if (!IdrInfo || !NumberOfAreas || !Areas ||
+        !NumberOfFields || !Fields || !NextAreaId) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if ((MaxAreas == 0) || (MaxFields == 0) ||
+        (StartAreaId == SAHPI_LAST_ENTRY)) {
+        return SA_ERR_HPI_INVALID_PARAMS;
+    }
+    if (MaxAreas > OH_MAX_IDR_AREAS_GET) {
+        MaxAreas = OH_MAX_IDR_AREAS_GET;
+    }
+    if (MaxFields > OH_MAX_IDR_FIELDS_GET) {
+        MaxFields = OH_MAX_IDR_FIELDS_GET;
+    }
+
+    oHpiIdrBatchT batch;
+    SaHpiEntryIdT next_id = SAHPI_LAST_ENTRY;
+
+    memset(&batch, 0, sizeof(batch));
+
+    ClientRpcParams iparams(&rid, &IdrId, &StartAreaId, &MaxAreas, &MaxFields);
+    ClientRpcParams oparams(IdrInfo, &batch, &next_id);
+    rv = ohc_sess_rpc(eFoHpiIdrGet, sid, iparams, oparams);
+
+    SaHpiUint32T na = batch.NumberOfAreas;
+    SaHpiUint32T nf = batch.NumberOfFields;
+    if (rv == SA_OK) {
+        if ((na > MaxAreas) || (nf > MaxFields)) {
+            rv = SA_ERR_HPI_INTERNAL_ERROR;
+        }
+    }
+
+    if (rv == SA_OK) {
+        if (na > 0) {
+            memcpy(Areas, batch.Areas, na * sizeof(SaHpiIdrAreaHeaderT));
+        }
+        if (nf > 0) {
+            memcpy(Fields, batch.Fields, nf * sizeof(SaHpiIdrFieldT));
+        }
+        *NumberOfAreas = na;
+        *NumberOfFields = nf;
+        *NextAreaId = next_id;
+    }
+
+    g_free(batch.Areas);
+    g_free(batch.Fields);
+
+    return rv;
+}
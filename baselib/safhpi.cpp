@@ -243,6 +243,10 @@ SaErrorT SAHPI_API saHpiDomainInfoGet(
     ClientRpcParams oparams(DomainInfo);
     rv = ohc_sess_rpc(eFsaHpiDomainInfoGet, SessionId, iparams, oparams);
 
+    if (rv == SA_OK) {
+        ohc_sess_cache_rpt_update_count(SessionId, DomainInfo->RptUpdateCount);
+    }
+
     /* Set Domain Id to real Domain Id */
     if (rv == SA_OK) {
         rv = ohc_sess_get_did(SessionId, DomainInfo->DomainId);
@@ -327,17 +331,7 @@ SaErrorT SAHPI_API saHpiRptEntryGet(
         return SA_ERR_HPI_INVALID_PARAMS;
     }
 
-    ClientRpcParams iparams(&EntryId);
-    ClientRpcParams oparams(NextEntryId, RptEntry);
-    rv = ohc_sess_rpc(eFsaHpiRptEntryGet, SessionId, iparams, oparams);
-
-    if (rv == SA_OK)  {
-        SaHpiEntityPathT entity_root;
-        rv = ohc_sess_get_entity_root(SessionId, entity_root);
-        if (rv == SA_OK) {
-            oh_concat_ep(&RptEntry->ResourceEntity, &entity_root);
-        }
-    }
+    rv = ohc_sess_rpt_entry_get(SessionId, EntryId, *NextEntryId, *RptEntry);
 
     return rv;
 }
@@ -358,17 +352,7 @@ SaErrorT SAHPI_API saHpiRptEntryGetByResourceId(
         return SA_ERR_HPI_INVALID_PARAMS;
     }
 
-    ClientRpcParams iparams(&ResourceId);
-    ClientRpcParams oparams(RptEntry);
-    rv = ohc_sess_rpc(eFsaHpiRptEntryGetByResourceId, SessionId, iparams, oparams);
-
-    if (rv == SA_OK)  {
-        SaHpiEntityPathT entity_root;
-        rv = ohc_sess_get_entity_root(SessionId, entity_root);
-        if (rv == SA_OK) {
-            oh_concat_ep(&RptEntry->ResourceEntity, &entity_root);
-        }
-    }
+    rv = ohc_sess_rpt_entry_get_by_rid(SessionId, ResourceId, *RptEntry);
 
     return rv;
 }
@@ -396,6 +380,9 @@ SaErrorT SAHPI_API saHpiResourceSeveritySet(
     ClientRpcParams oparams;
     rv = ohc_sess_rpc(eFsaHpiResourceSeveritySet, SessionId, iparams, oparams);
 
+    /* The cached RPT entry is outdated now */
+    ohc_sess_cache_invalidate(SessionId, ResourceId);
+
     return rv;
 }
 
@@ -419,6 +406,9 @@ SaErrorT SAHPI_API saHpiResourceTagSet(
     ClientRpcParams oparams;
     rv = ohc_sess_rpc(eFsaHpiResourceTagSet, SessionId, iparams, oparams);
 
+    /* The cached RPT entry is outdated now */
+    ohc_sess_cache_invalidate(SessionId, ResourceId);
+
     return rv;
 }
 
@@ -931,6 +921,21 @@ SaErrorT SAHPI_API saHpiEventGet(
         memcpy(EventQueueStatus, &status, sizeof(SaHpiEvtQueueStatusT));
     }
 
+    /* Resource and domain changes outdate the cached RPT and RDRs */
+    if (rv == SA_OK) {
+        switch (Event->EventType) {
+            case SAHPI_ET_RESOURCE:
+            case SAHPI_ET_HOTSWAP:
+                ohc_sess_cache_invalidate(SessionId, Event->Source);
+                break;
+            case SAHPI_ET_DOMAIN:
+                ohc_sess_cache_invalidate(SessionId, SAHPI_UNSPECIFIED_RESOURCE_ID);
+                break;
+            default:
+                break;
+        }
+    }
+
     if (rv == SA_OK)  {
         SaHpiEntityPathT entity_root;
         rv = ohc_sess_get_entity_root(SessionId, entity_root);
@@ -1147,17 +1152,7 @@ SaErrorT SAHPI_API saHpiRdrGet(
         return SA_ERR_HPI_INVALID_PARAMS;
     }
 
-    ClientRpcParams iparams(&ResourceId, &EntryId);
-    ClientRpcParams oparams(NextEntryId, Rdr);
-    rv = ohc_sess_rpc(eFsaHpiRdrGet, SessionId, iparams, oparams);
-
-    if (rv == SA_OK)  {
-        SaHpiEntityPathT entity_root;
-        rv = ohc_sess_get_entity_root(SessionId, entity_root);
-        if (rv == SA_OK) {
-            oh_concat_ep(&Rdr->Entity, &entity_root);
-        }
-    }
+    rv = ohc_sess_rdr_get(SessionId, ResourceId, EntryId, *NextEntryId, *Rdr);
 
     return rv;
 }
@@ -1180,17 +1175,7 @@ SaErrorT SAHPI_API saHpiRdrGetByInstrumentId(
         return SA_ERR_HPI_INVALID_PARAMS;
     }
 
-    ClientRpcParams iparams(&ResourceId, &RdrType, &InstrumentId);
-    ClientRpcParams oparams(Rdr);
-    rv = ohc_sess_rpc(eFsaHpiRdrGetByInstrumentId, SessionId, iparams, oparams);
-
-    if (rv == SA_OK)  {
-        SaHpiEntityPathT entity_root;
-        rv = ohc_sess_get_entity_root(SessionId, entity_root);
-        if (rv == SA_OK) {
-            oh_concat_ep(&Rdr->Entity, &entity_root);
-        }
-    }
+    rv = ohc_sess_rdr_get_by_instrument_id(SessionId, ResourceId, RdrType, InstrumentId, *Rdr);
 
     return rv;
 }
@@ -1215,6 +1200,10 @@ SaErrorT SAHPI_API saHpiRdrUpdateCountGet(
     ClientRpcParams oparams(UpdateCount);
     rv = ohc_sess_rpc(eFsaHpiRdrUpdateCountGet, SessionId, iparams, oparams);
 
+    if (rv == SA_OK) {
+        ohc_sess_cache_rdr_update_count(SessionId, ResourceId, *UpdateCount);
+    }
+
     return rv;
 }
 
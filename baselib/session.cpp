@@ -21,11 +21,13 @@
 
 #include <glib.h>
 
+#include <oh_utils.h>
 #include <oh_error.h>
 
 #include <marshal_hpi.h>
 #include <strmsock.h>
 
+#include "cache.h"
 #include "conf.h"
 #include "init.h"
 #include "lock.h"
@@ -45,17 +47,27 @@ public:
 
     void Ref()
     {
-        ++m_ref_cnt;
+        g_atomic_int_inc( &m_ref_cnt );
     }
 
-    void Unref()
+    // Takes a reference unless the session has already been released
+    bool TryRef()
     {
-        --m_ref_cnt;
+        for (;;) {
+            gint cnt = g_atomic_int_get( &m_ref_cnt );
+            if ( cnt <= 0 ) {
+                return false;
+            }
+            if ( g_atomic_int_compare_and_exchange( &m_ref_cnt, cnt, cnt + 1 ) ) {
+                return true;
+            }
+        }
     }
 
-    int GetRefCnf() const
+    // Returns true if the last reference was dropped
+    bool Unref()
     {
-        return m_ref_cnt;
+        return g_atomic_int_dec_and_test( &m_ref_cnt );
     }
 
     SaHpiDomainIdT GetDomainId() const
@@ -81,6 +93,26 @@ public:
                   ClientRpcParams& iparams,
                   ClientRpcParams& oparams );
 
+    // RPT/RDR reads that go through the cache if it is enabled
+    SaErrorT RptEntryGet( SaHpiEntryIdT eid,
+                          SaHpiEntryIdT& next_eid,
+                          SaHpiRptEntryT& rpte );
+    SaErrorT RptEntryGetByResourceId( SaHpiResourceIdT rid,
+                                      SaHpiRptEntryT& rpte );
+    SaErrorT RdrGet( SaHpiResourceIdT rid,
+                     SaHpiEntryIdT eid,
+                     SaHpiEntryIdT& next_eid,
+                     SaHpiRdrT& rdr );
+    SaErrorT RdrGetByInstrumentId( SaHpiResourceIdT rid,
+                                   SaHpiRdrTypeT type,
+                                   SaHpiInstrumentIdT num,
+                                   SaHpiRdrT& rdr );
+
+    cSessionCache * GetCache()
+    {
+        return m_cache;
+    }
+
 private:
 
     cSession( const cSession& );
@@ -91,23 +123,40 @@ private:
                     ClientRpcParams& oparams );
 
     SaErrorT GetSock( cClientStreamSock * & sock );
+    void PutSock( cClientStreamSock * sock );
+    void DropSock( cClientStreamSock * sock );
+    SaErrorT GetPooledSock( cClientStreamSock * & sock );
+    SaErrorT CreateSock( cClientStreamSock * & sock );
     static void DeleteSock( gpointer ptr );
 
+    bool ValidateRptCache();
+    bool ValidateRdrCache( SaHpiResourceIdT rid );
+
 private:
 
     static const size_t RPC_ATTEMPTS = 2;
     static const gulong NEXT_RPC_ATTEMPT_TIMEOUT = 2 * G_USEC_PER_SEC;
+    static const glong POOL_WAIT_TIMEOUT = G_USEC_PER_SEC;
 
     // data
-    volatile int    m_ref_cnt;
+    volatile gint   m_ref_cnt;
     SaHpiDomainIdT  m_did;
-    SaHpiSessionIdT m_sid;
+    volatile SaHpiSessionIdT m_sid;
     SaHpiSessionIdT m_remote_sid;
+    // one connection per calling thread
 #if GLIB_CHECK_VERSION (2, 32, 0)
     GPrivate        m_sockets;
 #else
     GStaticPrivate  m_sockets;
 #endif
+    // or a pool of at most m_max_socks connections shared by all threads
+    // (see "connections" in openhpiclient.conf)
+    guint           m_max_socks;
+    volatile gint   m_nsocks;
+    GAsyncQueue *   m_idle_socks;
+    // RPT/RDR cache, NULL if disabled
+    // (see "cache" in openhpiclient.conf)
+    cSessionCache * m_cache;
 };
 
 
@@ -115,7 +164,11 @@ cSession::cSession()
     : m_ref_cnt( 0 ),
       m_did( SAHPI_UNSPECIFIED_DOMAIN_ID ),
       m_sid( 0 ),
-      m_remote_sid( 0 )
+      m_remote_sid( 0 ),
+      m_max_socks( 0 ),
+      m_nsocks( 0 ),
+      m_idle_socks( 0 ),
+      m_cache( 0 )
 {
     #if GLIB_CHECK_VERSION (2, 32, 0)
     m_sockets = G_PRIVATE_INIT (g_free);
@@ -127,6 +180,14 @@ cSession::cSession()
 cSession::~cSession()
 {
     wrap_g_static_private_free( &m_sockets );
+    if ( m_idle_socks ) {
+        gpointer ptr;
+        while ( ( ptr = g_async_queue_try_pop( m_idle_socks ) ) != 0 ) {
+            DeleteSock( ptr );
+        }
+        g_async_queue_unref( m_idle_socks );
+    }
+    delete m_cache;
 }
 
 SaErrorT cSession::GetEntityRoot( SaHpiEntityPathT& entity_root ) const
@@ -148,6 +209,18 @@ SaErrorT cSession::GetEntityRoot( SaHpiEntityPathT& entity_root ) const
 SaErrorT cSession::RpcOpen( SaHpiDomainIdT did )
 {
     m_did = did;
+
+    ohc_lock();
+    const struct ohc_domain_conf * dc = ohc_get_domain_conf( m_did );
+    if ( dc && ( dc->connections > 0 ) ) {
+        m_max_socks  = dc->connections;
+        m_idle_socks = g_async_queue_new();
+    }
+    if ( dc && ( dc->cache > 0 ) ) {
+        m_cache = new cSessionCache( dc->cache );
+    }
+    ohc_unlock();
+
     SaHpiDomainIdT remote_did = SAHPI_UNSPECIFIED_DOMAIN_ID;
 
     ClientRpcParams iparams, oparams( &m_remote_sid );
@@ -170,6 +243,171 @@ SaErrorT cSession::Rpc( uint32_t id,
     return DoRpc( id, iparams, oparams );
 }
 
+SaErrorT cSession::RptEntryGet( SaHpiEntryIdT eid,
+                                SaHpiEntryIdT& next_eid,
+                                SaHpiRptEntryT& rpte )
+{
+    guint gen = 0;
+    bool use_cache = ValidateRptCache();
+    if ( use_cache ) {
+        gen = m_cache->Generation();
+        if ( m_cache->GetRptEntry( eid, next_eid, rpte ) == cSessionCache::eHit ) {
+            return SA_OK;
+        }
+    }
+
+    ClientRpcParams iparams( &eid );
+    ClientRpcParams oparams( &next_eid, &rpte );
+    SaErrorT rv = Rpc( eFsaHpiRptEntryGet, iparams, oparams );
+    if ( rv == SA_OK ) {
+        SaHpiEntityPathT entity_root;
+        rv = GetEntityRoot( entity_root );
+        if ( rv == SA_OK ) {
+            oh_concat_ep( &rpte.ResourceEntity, &entity_root );
+        }
+    }
+    if ( ( rv == SA_OK ) && use_cache ) {
+        m_cache->PutRptEntry( gen, eid, next_eid, rpte );
+    }
+
+    return rv;
+}
+
+SaErrorT cSession::RptEntryGetByResourceId( SaHpiResourceIdT rid,
+                                            SaHpiRptEntryT& rpte )
+{
+    guint gen = 0;
+    bool use_cache = ValidateRptCache();
+    if ( use_cache ) {
+        gen = m_cache->Generation();
+        if ( m_cache->GetRptEntryByResourceId( rid, rpte ) == cSessionCache::eHit ) {
+            return SA_OK;
+        }
+    }
+
+    ClientRpcParams iparams( &rid );
+    ClientRpcParams oparams( &rpte );
+    SaErrorT rv = Rpc( eFsaHpiRptEntryGetByResourceId, iparams, oparams );
+    if ( rv == SA_OK ) {
+        SaHpiEntityPathT entity_root;
+        rv = GetEntityRoot( entity_root );
+        if ( rv == SA_OK ) {
+            oh_concat_ep( &rpte.ResourceEntity, &entity_root );
+        }
+    }
+    if ( ( rv == SA_OK ) && use_cache ) {
+        m_cache->PutRptEntry( gen, rpte );
+    }
+
+    return rv;
+}
+
+SaErrorT cSession::RdrGet( SaHpiResourceIdT rid,
+                           SaHpiEntryIdT eid,
+                           SaHpiEntryIdT& next_eid,
+                           SaHpiRdrT& rdr )
+{
+    guint gen = 0;
+    bool use_cache = ValidateRdrCache( rid );
+    if ( use_cache ) {
+        gen = m_cache->Generation();
+        if ( m_cache->GetRdr( rid, eid, next_eid, rdr ) == cSessionCache::eHit ) {
+            return SA_OK;
+        }
+    }
+
+    ClientRpcParams iparams( &rid, &eid );
+    ClientRpcParams oparams( &next_eid, &rdr );
+    SaErrorT rv = Rpc( eFsaHpiRdrGet, iparams, oparams );
+    if ( rv == SA_OK ) {
+        SaHpiEntityPathT entity_root;
+        rv = GetEntityRoot( entity_root );
+        if ( rv == SA_OK ) {
+            oh_concat_ep( &rdr.Entity, &entity_root );
+        }
+    }
+    if ( ( rv == SA_OK ) && use_cache ) {
+        m_cache->PutRdr( gen, rid, eid, next_eid, rdr );
+    }
+
+    return rv;
+}
+
+SaErrorT cSession::RdrGetByInstrumentId( SaHpiResourceIdT rid,
+                                         SaHpiRdrTypeT type,
+                                         SaHpiInstrumentIdT num,
+                                         SaHpiRdrT& rdr )
+{
+    guint gen = 0;
+    bool use_cache = ValidateRdrCache( rid );
+    if ( use_cache ) {
+        gen = m_cache->Generation();
+        cSessionCache::eLookup rc = m_cache->GetRdrByInstrumentId( rid, type, num, rdr );
+        if ( rc == cSessionCache::eHit ) {
+            return SA_OK;
+        } else if ( rc == cSessionCache::eAbsent ) {
+            return SA_ERR_HPI_NOT_PRESENT;
+        }
+    }
+
+    ClientRpcParams iparams( &rid, &type, &num );
+    ClientRpcParams oparams( &rdr );
+    SaErrorT rv = Rpc( eFsaHpiRdrGetByInstrumentId, iparams, oparams );
+    if ( rv == SA_OK ) {
+        SaHpiEntityPathT entity_root;
+        rv = GetEntityRoot( entity_root );
+        if ( rv == SA_OK ) {
+            oh_concat_ep( &rdr.Entity, &entity_root );
+        }
+    }
+    if ( ( rv == SA_OK ) && use_cache ) {
+        m_cache->PutRdr( gen, rid, rdr );
+    }
+
+    return rv;
+}
+
+// Rechecks the domain RptUpdateCount if it is not known or too old.
+// Returns false if the cache is disabled or cannot be used now.
+bool cSession::ValidateRptCache()
+{
+    if ( !m_cache ) {
+        return false;
+    }
+    if ( m_cache->RptCountExpired() ) {
+        SaHpiDomainInfoT info;
+        ClientRpcParams iparams;
+        ClientRpcParams oparams( &info );
+        SaErrorT rv = Rpc( eFsaHpiDomainInfoGet, iparams, oparams );
+        if ( rv != SA_OK ) {
+            return false;
+        }
+        m_cache->SetRptCount( info.RptUpdateCount );
+    }
+
+    return true;
+}
+
+// Same as ValidateRptCache plus the RDR update count of the resource
+bool cSession::ValidateRdrCache( SaHpiResourceIdT rid )
+{
+    if ( !ValidateRptCache() ) {
+        return false;
+    }
+    if ( m_cache->RdrCountExpired( rid ) ) {
+        SaHpiUint32T cnt;
+        ClientRpcParams iparams( &rid );
+        ClientRpcParams oparams( &cnt );
+        SaErrorT rv = Rpc( eFsaHpiRdrUpdateCountGet, iparams, oparams );
+        if ( rv != SA_OK ) {
+            return false;
+        }
+        m_cache->SetRdrCount( rid, cnt );
+    }
+
+    return true;
+}
+
 SaErrorT cSession::DoRpc( uint32_t id,
                           ClientRpcParams& iparams,
                           ClientRpcParams& oparams )
@@ -187,12 +425,7 @@ SaErrorT cSession::DoRpc( uint32_t id,
     uint8_t  rp_type;
     uint32_t rp_id;
     int      rp_byte_order;
-
-    cc = HpiMarshalRequest( hm, data, iparams.const_array );
-    if ( cc < 0 ) {
-        return SA_ERR_HPI_INTERNAL_ERROR;
-    }
-    data_len = cc;
+    uint8_t  rp_rpc_version;
 
     bool rc = false;
     for ( size_t attempt = 0; attempt < RPC_ATTEMPTS; ++attempt ) {
@@ -205,19 +438,26 @@ SaErrorT cSession::DoRpc( uint32_t id,
             return rv;
         }
 
-        rc = sock->WriteMsg( eMhMsg, id, data, data_len );
+        // The request is encoded with the RPC version negotiated
+        // on this connection, a new connection starts with version 1.
+        uint8_t rq_rpc_version = sock->RpcVersion();
+        cc = HpiMarshalRequestVersion( rq_rpc_version, hm, data, iparams.const_array );
+        if ( cc < 0 ) {
+            PutSock( sock );
+            return SA_ERR_HPI_INTERNAL_ERROR;
+        }
+        data_len = cc;
+
+        rc = sock->WriteMsg( eMhMsg, id, data, data_len, rq_rpc_version );
         if ( rc ) {
-            rc = sock->ReadMsg( rp_type, rp_id, data, data_len, rp_byte_order );
+            rc = sock->ReadMsg( rp_type, rp_id, data, data_len, rp_byte_order, rp_rpc_version );
             if ( rc ) {
+                PutSock( sock );
                 break;
             }
         }
 
-        #if GLIB_CHECK_VERSION (2, 32, 0)
-        wrap_g_static_private_set( &m_sockets, 0);// close socket
-        #else
-        wrap_g_static_private_set( &m_sockets, 0, 0 ); // close socket
-        #endif
+        DropSock( sock ); // close socket
         g_usleep( NEXT_RPC_ATTEMPT_TIMEOUT );
     }
     if ( !rc ) {
@@ -225,7 +465,7 @@ SaErrorT cSession::DoRpc( uint32_t id,
     }
 
     oparams.SetFirst( &rv );
-    cc = HpiDemarshalReply( rp_byte_order, hm, data, oparams.array );
+    cc = HpiDemarshalReplyVersion( rp_rpc_version, rp_byte_order, hm, data, oparams.array );
 
     if ( ( cc <= 0 ) || ( rp_type != eMhMsg ) || ( id != rp_id ) ) {
         //Closing main socket(the socket that was used for saHpiSessionOpen)
@@ -240,37 +480,117 @@ SaErrorT cSession::DoRpc( uint32_t id,
 
 SaErrorT cSession::GetSock( cClientStreamSock * & sock )
 {
+    if ( m_idle_socks ) {
+        return GetPooledSock( sock );
+    }
+
     gpointer ptr = wrap_g_static_private_get( &m_sockets );
     if ( ptr ) {
         sock = reinterpret_cast<cClientStreamSock *>(ptr);
     } else {
-        ohc_lock();
-        const struct ohc_domain_conf * dc = ohc_get_domain_conf( m_did );
-        ohc_unlock();
-
-        if (!dc) {
-            return SA_ERR_HPI_INVALID_DOMAIN;
+        SaErrorT rv = CreateSock( sock );
+        if ( rv != SA_OK ) {
+            return rv;
         }
 
-        sock = new cClientStreamSock;
+        #if GLIB_CHECK_VERSION (2, 32, 0)
+        wrap_g_static_private_set( &m_sockets, sock );
+        #else
+        wrap_g_static_private_set( &m_sockets, sock, DeleteSock );
+        #endif
+    }
+
+    return SA_OK;
+}
+
+void cSession::PutSock( cClientStreamSock * sock )
+{
+    if ( m_idle_socks ) {
+        g_async_queue_push( m_idle_socks, sock );
+    }
+}
 
-        bool rc = sock->Create( dc->host, dc->port );
-        if ( !rc ) {
-            delete sock;
-            CRIT("Session: cannot open connection to domain %u.", m_did );
-            return SA_ERR_HPI_NO_RESPONSE;
+void cSession::DropSock( cClientStreamSock * sock )
+{
+    if ( m_idle_socks ) {
+        DeleteSock( sock );
+        g_atomic_int_add( &m_nsocks, -1 );
+    } else {
+        #if GLIB_CHECK_VERSION (2, 32, 0)
+        wrap_g_static_private_set( &m_sockets, 0);
+        #else
+        wrap_g_static_private_set( &m_sockets, 0, 0 );
+        #endif
+    }
+}
+
+SaErrorT cSession::GetPooledSock( cClientStreamSock * & sock )
+{
+    for (;;) {
+        gpointer ptr = g_async_queue_try_pop( m_idle_socks );
+        if ( ptr ) {
+            sock = reinterpret_cast<cClientStreamSock *>(ptr);
+            return SA_OK;
         }
 
-        // TODO configuration file, env vars?
-        sock->EnableKeepAliveProbes( /* keepalive_time*/    1,
-                                     /* keepalive_intvl */  1,
-                                     /* keepalive_probes */ 3 );
+        gint n = g_atomic_int_get( &m_nsocks );
+        if ( n < (gint)m_max_socks ) {
+            if ( !g_atomic_int_compare_and_exchange( &m_nsocks, n, n + 1 ) ) {
+                continue;
+            }
+            SaErrorT rv = CreateSock( sock );
+            if ( rv != SA_OK ) {
+                g_atomic_int_add( &m_nsocks, -1 );
+            }
+            return rv;
+        }
 
+        // All connections are busy. Wait for one to be returned,
+        // but recheck the pool size from time to time
+        // since a broken connection is dropped, not returned.
         #if GLIB_CHECK_VERSION (2, 32, 0)
-        wrap_g_static_private_set( &m_sockets, sock );
+        ptr = wrap_g_async_queue_timed_pop( m_idle_socks, POOL_WAIT_TIMEOUT );
         #else
-        wrap_g_static_private_set( &m_sockets, sock, DeleteSock );
+        GTimeVal end_time;
+        g_get_current_time( &end_time );
+        g_time_val_add( &end_time, POOL_WAIT_TIMEOUT );
+        ptr = wrap_g_async_queue_timed_pop( m_idle_socks, &end_time );
         #endif
+        if ( ptr ) {
+            sock = reinterpret_cast<cClientStreamSock *>(ptr);
+            return SA_OK;
+        }
+    }
+}
+
+SaErrorT cSession::CreateSock( cClientStreamSock * & sock )
+{
+    ohc_lock();
+    const struct ohc_domain_conf * dc = ohc_get_domain_conf( m_did );
+    ohc_unlock();
+
+    if (!dc) {
+        return SA_ERR_HPI_INVALID_DOMAIN;
+    }
+
+    sock = new cClientStreamSock;
+
+    bool rc = sock->Create( dc->host, dc->port );
+    if ( !rc ) {
+        delete sock;
+        CRIT("Session: cannot open connection to domain %u.", m_did );
+        return SA_ERR_HPI_NO_RESPONSE;
+    }
+
+    // TODO configuration file, env vars?
+    sock->EnableKeepAliveProbes( /* keepalive_time*/    1,
+                                 /* keepalive_intvl */  1,
+                                 /* keepalive_probes */ 3 );
+
+    if ( dc->compression && !sock->IsLocal() ) {
+        if ( !sock->EnableCompression() ) {
+            WARN( "Session: compression is not supported, using plain messages." );
+        }
     }
 
     return SA_OK;
@@ -285,21 +605,70 @@ void cSession::DeleteSock( gpointer ptr )
 
 /***************************************************************
  * Session Layer: Session Table
+ *
+ * Lookups do not take ohc_lock.
+ * The table is an array of slots, session sid lives
+ * in slot (sid - 1) % size. Writers change it under ohc_lock
+ * and replace it by a doubled copy when it gets half full.
+ * Sessions are reference counted with atomic operations.
+ * Released sessions and replaced tables are retired and
+ * deleted only when no lookup is in progress.
  **************************************************************/
-static GHashTable * sessions = 0;
+struct SessionTable
+{
+    guint      size;
+    gpointer * slots;
+};
+
+static SessionTable * volatile sessions = 0;
+static volatile gint sessions_readers = 0;
+static guint sessions_count = 0;
+static GSList * retired_sessions = 0;
+static GSList * retired_tables = 0;
+
+static const guint SESSIONS_INITIAL_SIZE = 16;
+
+static SessionTable * sessions_table_new( guint size )
+{
+    SessionTable * table = g_new0( SessionTable, 1 );
+    table->size  = size;
+    table->slots = g_new0( gpointer, size );
+    return table;
+}
+
+static guint sessions_slot( const SessionTable * table, SaHpiSessionIdT sid )
+{
+    return ( sid - 1 ) % table->size;
+}
 
-gpointer sid_key( SaHpiSessionIdT sid )
+// Must be called under ohc_lock
+static void sessions_reclaim()
 {
-    char * key = 0;
-    key += sid;
-    return key;
+    if ( g_atomic_int_get( &sessions_readers ) != 0 ) {
+        return;
+    }
+
+    GSList * item;
+    for ( item = retired_sessions; item; item = item->next ) {
+        delete reinterpret_cast<cSession*>(item->data);
+    }
+    g_slist_free( retired_sessions );
+    retired_sessions = 0;
+
+    for ( item = retired_tables; item; item = item->next ) {
+        SessionTable * table = reinterpret_cast<SessionTable*>(item->data);
+        g_free( table->slots );
+        g_free( table );
+    }
+    g_slist_free( retired_tables );
+    retired_tables = 0;
 }
 
 static void sessions_init()
 {
     ohc_lock();
     if ( !sessions ) {
-        sessions = g_hash_table_new( g_direct_hash, g_direct_equal );
+        g_atomic_pointer_set( &sessions, sessions_table_new( SESSIONS_INITIAL_SIZE ) );
     }
     ohc_unlock();
 }
@@ -309,10 +678,38 @@ static SaHpiSessionIdT sessions_add( cSession * session )
     static SaHpiSessionIdT next_sid = 1;
 
     ohc_lock();
-    SaHpiSessionIdT sid = next_sid;
-    ++next_sid;
+
+    SessionTable * table = sessions;
+    if ( ( sessions_count + 1 ) * 2 > table->size ) {
+        // sids that use different slots still do when the size doubles
+        SessionTable * table2 = sessions_table_new( table->size * 2 );
+        guint i;
+        for ( i = 0; i < table->size; ++i ) {
+            cSession * s = reinterpret_cast<cSession*>(table->slots[i]);
+            if ( s ) {
+                table2->slots[sessions_slot( table2, s->GetSid() )] = s;
+            }
+        }
+        g_atomic_pointer_set( &sessions, table2 );
+        retired_tables = g_slist_prepend( retired_tables, table );
+        table = table2;
+    }
+
+    SaHpiSessionIdT sid;
+    do {
+        sid = next_sid;
+        ++next_sid;
+        if ( next_sid == 0 ) {
+            next_sid = 1;
+        }
+    } while ( table->slots[sessions_slot( table, sid )] != 0 );
+
     session->SetSid( sid );
-    g_hash_table_insert( sessions, sid_key( sid ), session );
+    session->Ref(); // reference held by the table
+    g_atomic_pointer_set( &table->slots[sessions_slot( table, sid )], session );
+    ++sessions_count;
+
+    sessions_reclaim();
     ohc_unlock();
 
     return sid;
@@ -320,22 +717,20 @@ static SaHpiSessionIdT sessions_add( cSession * session )
 
 static cSession * sessions_get_ref( SaHpiSessionIdT sid )
 {
-    ohc_lock();
-    gpointer value = g_hash_table_lookup( sessions, sid_key( sid ) );
-    cSession * session = reinterpret_cast<cSession*>(value);
-    if ( session ) {
-        session->Ref();
+    cSession * session = 0;
+
+    g_atomic_int_inc( &sessions_readers );
+    SessionTable * table = reinterpret_cast<SessionTable*>(g_atomic_pointer_get( &sessions ));
+    if ( table && ( sid != 0 ) ) {
+        gpointer ptr = g_atomic_pointer_get( &table->slots[sessions_slot( table, sid )] );
+        cSession * s = reinterpret_cast<cSession*>(ptr);
+        if ( s && ( s->GetSid() == sid ) && s->TryRef() ) {
+            session = s;
+        }
     }
-    ohc_unlock();
-    return session;
-}
+    g_atomic_int_add( &sessions_readers, -1 );
 
-static void dehash_func( gpointer /* key */, gpointer value, gpointer user_data )
-{
-    GList ** pvalues = reinterpret_cast<GList **>(user_data);
-    cSession * session = reinterpret_cast<cSession*>(value);
-    session->Ref();
-    *pvalues = g_list_append( *pvalues, value );
+    return session;
 }
 
 static GList * sessions_get_ref_all()
@@ -343,7 +738,14 @@ static GList * sessions_get_ref_all()
     ohc_lock();
     GList * sessions_list = 0;
     if ( sessions ) {
-        g_hash_table_foreach( sessions, dehash_func, &sessions_list );
+        guint i;
+        for ( i = 0; i < sessions->size; ++i ) {
+            cSession * s = reinterpret_cast<cSession*>(sessions->slots[i]);
+            if ( s ) {
+                s->Ref();
+                sessions_list = g_list_append( sessions_list, s );
+            }
+        }
     }
     ohc_unlock();
 
@@ -352,16 +754,23 @@ static GList * sessions_get_ref_all()
 
 static void sessions_unref( cSession * session, bool closed = false )
 {
-    ohc_lock();
-    session->Unref();
     if ( closed ) {
-        session->Unref();
-        g_hash_table_remove( sessions, sid_key( session->GetSid() ) );
+        ohc_lock();
+        SessionTable * table = sessions;
+        guint i = sessions_slot( table, session->GetSid() );
+        if ( table->slots[i] == session ) {
+            g_atomic_pointer_set( &table->slots[i], 0 );
+            --sessions_count;
+            session->Unref(); // reference held by the table
+        }
+        ohc_unlock();
     }
-    if ( session->GetRefCnf() < 0 ) {
-        delete session;
+    if ( session->Unref() ) {
+        ohc_lock();
+        retired_sessions = g_slist_prepend( retired_sessions, session );
+        sessions_reclaim();
+        ohc_unlock();
     }
-    ohc_unlock();
 }
 
 
@@ -468,3 +877,113 @@ SaErrorT ohc_sess_get_entity_root( SaHpiSessionIdT sid, SaHpiEntityPathT& ep )
     return rv;
 }
 
+SaErrorT ohc_sess_rpt_entry_get( SaHpiSessionIdT sid,
+                                 SaHpiEntryIdT eid,
+                                 SaHpiEntryIdT& next_eid,
+                                 SaHpiRptEntryT& rpte )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return SA_ERR_HPI_INVALID_SESSION;
+    }
+
+    SaErrorT rv = session->RptEntryGet( eid, next_eid, rpte );
+    sessions_unref( session );
+
+    return rv;
+}
+
+SaErrorT ohc_sess_rpt_entry_get_by_rid( SaHpiSessionIdT sid,
+                                        SaHpiResourceIdT rid,
+                                        SaHpiRptEntryT& rpte )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return SA_ERR_HPI_INVALID_SESSION;
+    }
+
+    SaErrorT rv = session->RptEntryGetByResourceId( rid, rpte );
+    sessions_unref( session );
+
+    return rv;
+}
+
+SaErrorT ohc_sess_rdr_get( SaHpiSessionIdT sid,
+                           SaHpiResourceIdT rid,
+                           SaHpiEntryIdT eid,
+                           SaHpiEntryIdT& next_eid,
+                           SaHpiRdrT& rdr )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return SA_ERR_HPI_INVALID_SESSION;
+    }
+
+    SaErrorT rv = session->RdrGet( rid, eid, next_eid, rdr );
+    sessions_unref( session );
+
+    return rv;
+}
+
+SaErrorT ohc_sess_rdr_get_by_instrument_id( SaHpiSessionIdT sid,
+                                            SaHpiResourceIdT rid,
+                                            SaHpiRdrTypeT type,
+                                            SaHpiInstrumentIdT num,
+                                            SaHpiRdrT& rdr )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return SA_ERR_HPI_INVALID_SESSION;
+    }
+
+    SaErrorT rv = session->RdrGetByInstrumentId( rid, type, num, rdr );
+    sessions_unref( session );
+
+    return rv;
+}
+
+void ohc_sess_cache_rpt_update_count( SaHpiSessionIdT sid, SaHpiUint32T cnt )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return;
+    }
+
+    if ( session->GetCache() ) {
+        session->GetCache()->SetRptCount( cnt );
+    }
+    sessions_unref( session );
+}
+
+void ohc_sess_cache_rdr_update_count( SaHpiSessionIdT sid,
+                                      SaHpiResourceIdT rid,
+                                      SaHpiUint32T cnt )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return;
+    }
+
+    if ( session->GetCache() ) {
+        session->GetCache()->SetRdrCount( rid, cnt );
+    }
+    sessions_unref( session );
+}
+
+void ohc_sess_cache_invalidate( SaHpiSessionIdT sid, SaHpiResourceIdT rid )
+{
+    cSession * session = sessions_get_ref( sid );
+    if ( !session ) {
+        return;
+    }
+
+    cSessionCache * cache = session->GetCache();
+    if ( cache ) {
+        if ( rid == SAHPI_UNSPECIFIED_RESOURCE_ID ) {
+            cache->Invalidate();
+        } else {
+            cache->InvalidateResource( rid );
+        }
+    }
+    sessions_unref( session );
+}
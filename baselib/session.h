@@ -38,5 +38,34 @@ SaErrorT ohc_sess_rpc( uint32_t id,
 SaErrorT ohc_sess_get_did( SaHpiSessionIdT sid, SaHpiDomainIdT& did );
 SaErrorT ohc_sess_get_entity_root( SaHpiSessionIdT sid, SaHpiEntityPathT& ep );
 
+// RPT/RDR reads with the domain entity root applied.
+// They are served from the client side cache of the session
+// if it is enabled (see "cache" in openhpiclient.conf).
+SaErrorT ohc_sess_rpt_entry_get( SaHpiSessionIdT sid,
+                                 SaHpiEntryIdT eid,
+                                 SaHpiEntryIdT& next_eid,
+                                 SaHpiRptEntryT& rpte );
+SaErrorT ohc_sess_rpt_entry_get_by_rid( SaHpiSessionIdT sid,
+                                        SaHpiResourceIdT rid,
+                                        SaHpiRptEntryT& rpte );
+SaErrorT ohc_sess_rdr_get( SaHpiSessionIdT sid,
+                           SaHpiResourceIdT rid,
+                           SaHpiEntryIdT eid,
+                           SaHpiEntryIdT& next_eid,
+                           SaHpiRdrT& rdr );
+SaErrorT ohc_sess_rdr_get_by_instrument_id( SaHpiSessionIdT sid,
+                                            SaHpiResourceIdT rid,
+                                            SaHpiRdrTypeT type,
+                                            SaHpiInstrumentIdT num,
+                                            SaHpiRdrT& rdr );
+
+// Cache invalidation by observed update counters and events.
+// rid == SAHPI_UNSPECIFIED_RESOURCE_ID invalidates the whole cache.
+void ohc_sess_cache_rpt_update_count( SaHpiSessionIdT sid, SaHpiUint32T cnt );
+void ohc_sess_cache_rdr_update_count( SaHpiSessionIdT sid,
+                                      SaHpiResourceIdT rid,
+                                      SaHpiUint32T cnt );
+void ohc_sess_cache_invalidate( SaHpiSessionIdT sid, SaHpiResourceIdT rid );
+
 #endif /* __BASELIB_SESSION_H */
 
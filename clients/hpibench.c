@@ -0,0 +1,722 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Log:
+ *     Load generator and latency benchmark for the openhpi daemon.
+ *     A number of threads share a number of sessions and call a
+ *     weighted mix of HPI functions on the resources, sensors and
+ *     inventories found at start, for a fixed time or number of calls.
+ *     For every function the calls per second and the latency
+ *     percentiles are reported as text or JSON.
+ */
+
+#include <time.h>
+
+#include <sahpi_wrappers.h>
+
+#include "oh_clients.h"
+
+#define OH_SVN_REV "$Revision$"
+
+/*
+ * Latencies are counted in a log-linear histogram: values below
+ * 2^SUB_BITS ns have their own bucket, above that every power of two
+ * is split into 2^SUB_BITS buckets. So a percentile is exact to 1/16.
+ */
+#define SUB_BITS     4
+#define SUB_COUNT    (1 << SUB_BITS)
+#define MAX_EXP      40    /* about 18 minutes */
+#define NBUCKETS     ((MAX_EXP - SUB_BITS + 2) * SUB_COUNT)
+
+enum bench_op {
+        OP_RPT = 0,
+        OP_RDR,
+        OP_SENSOR,
+        OP_EVENT,
+        OP_IDR,
+        OP_COUNT
+};
+
+static const char *op_names[OP_COUNT] = {
+        "saHpiRptEntryGet",
+        "saHpiRdrGet",
+        "saHpiSensorReadingGet",
+        "saHpiEventGet",
+        "saHpiIdrFieldGet"
+};
+
+static const char *op_keys[OP_COUNT] = {
+        "rpt", "rdr", "sensor", "event", "idr"
+};
+
+struct op_stats {
+        guint64 ops;
+        guint64 errors;
+        guint64 sum;
+        guint64 max;
+        guint32 buckets[NBUCKETS];
+};
+
+struct rdr_target {
+        SaHpiResourceIdT rid;
+        SaHpiEntryIdT    entry;
+};
+
+struct sensor_target {
+        SaHpiResourceIdT   rid;
+        SaHpiSensorNumT    num;
+};
+
+struct field_target {
+        SaHpiResourceIdT rid;
+        SaHpiIdrIdT      idr;
+        SaHpiEntryIdT    area;
+        SaHpiEntryIdT    field;
+};
+
+struct bench_thread {
+        guint            index;
+        SaHpiSessionIdT  sid;
+        GThread          *thread;
+        struct op_stats  stats[OP_COUNT];
+};
+
+static gint nthreads = 4;
+static gint nsessions = 1;
+static gint duration = 10;
+static gint total_ops = 0;
+static gint seed = 1;
+static gchar *mix = NULL;
+static gchar *format = NULL;
+static oHpiCommonOptionsT copt;
+
+static GOptionEntry my_options[] =
+{
+  { "threads",  't', 0, G_OPTION_ARG_INT,    &nthreads,  "Number of threads (default 4)",            "n" },
+  { "sessions", 's', 0, G_OPTION_ARG_INT,    &nsessions, "Number of sessions shared by the threads\n"
+"                               (default 1)",                                                       "n" },
+  { "duration", 'd', 0, G_OPTION_ARG_INT,    &duration,  "Run for n seconds (default 10)",           "n" },
+  { "ops",      'o', 0, G_OPTION_ARG_INT,    &total_ops, "Stop after n calls instead",               "n" },
+  { "mix",      'm', 0, G_OPTION_ARG_STRING, &mix,       "Weights of the calls, for example\n"
+"                               \"rpt=1,rdr=1,sensor=4,event=1,idr=1\"\n"
+"                               (default: all with weight 1)",                                      "mix" },
+  { "seed",     'r', 0, G_OPTION_ARG_INT,    &seed,      "Seed for the choice of calls (default 1)", "n" },
+  { "format",   'f', 0, G_OPTION_ARG_STRING, &format,    "Output format: text or json (default text)", "fmt" },
+  { NULL }
+};
+
+static guint weights[OP_COUNT] = { 1, 1, 1, 1, 1 };
+static guint weight_sum = 0;
+
+static SaHpiEntryIdT *rpt_targets = NULL;
+static guint n_rpt = 0;
+static struct rdr_target *rdr_targets = NULL;
+static guint n_rdr = 0;
+static struct sensor_target *sensor_targets = NULL;
+static guint n_sensor = 0;
+static struct field_target *field_targets = NULL;
+static guint n_field = 0;
+
+static volatile gint stop = 0;
+static volatile gint ops_left = 0;
+
+
+static guint64 now_ns(void)
+{
+#if defined(CLOCK_MONOTONIC) && !defined(_WIN32)
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (guint64)ts.tv_sec * 1000000000ULL + (guint64)ts.tv_nsec;
+#elif GLIB_CHECK_VERSION (2, 28, 0)
+        return (guint64)g_get_monotonic_time() * 1000;
+#else
+        GTimeVal tv;
+
+        g_get_current_time(&tv);
+        return ((guint64)tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec) * 1000;
+#endif
+}
+
+/* Takes one call of the --ops budget, FALSE when none is left */
+static gboolean take_op(void)
+{
+#if GLIB_CHECK_VERSION (2, 30, 0)
+        return g_atomic_int_add(&ops_left, -1) > 0;
+#else
+        return g_atomic_int_exchange_and_add(&ops_left, -1) > 0;
+#endif
+}
+
+static guint bucket_of(guint64 ns)
+{
+        guint e;
+
+        if (ns < SUB_COUNT) {
+                return (guint)ns;
+        }
+        for (e = SUB_BITS; (e < MAX_EXP) && (ns >> (e + 1)); ++e) {
+                ;
+        }
+        if (ns >> (e + 1)) {
+                return NBUCKETS - 1;
+        }
+        return (e - SUB_BITS + 1) * SUB_COUNT +
+               (guint)((ns >> (e - SUB_BITS)) & (SUB_COUNT - 1));
+}
+
+/* Largest value that falls into the bucket */
+static guint64 bucket_top(guint b)
+{
+        guint e, sub;
+
+        if (b < SUB_COUNT) {
+                return b;
+        }
+        e = b / SUB_COUNT + SUB_BITS - 1;
+        sub = b % SUB_COUNT;
+        return ((guint64)(SUB_COUNT + sub + 1) << (e - SUB_BITS)) - 1;
+}
+
+static void stats_add(struct op_stats *s, guint64 ns, SaErrorT rv)
+{
+        s->ops++;
+        if (rv != SA_OK) {
+                s->errors++;
+        }
+        s->sum += ns;
+        if (ns > s->max) {
+                s->max = ns;
+        }
+        s->buckets[bucket_of(ns)]++;
+}
+
+static guint64 stats_percentile(const struct op_stats *s, double fraction)
+{
+        guint64 n = 0, want;
+        guint b;
+
+        if (s->ops == 0) {
+                return 0;
+        }
+        want = (guint64)(fraction * s->ops + 0.5);
+        if (want == 0) {
+                want = 1;
+        }
+        for (b = 0; b < NBUCKETS; ++b) {
+                n += s->buckets[b];
+                if (n >= want) {
+                        break;
+                }
+        }
+        if (b >= NBUCKETS) {
+                return s->max;
+        }
+        /* Never report more than the largest sample */
+        return (bucket_top(b) < s->max) ? bucket_top(b) : s->max;
+}
+
+static void stats_merge(struct op_stats *to, const struct op_stats *from)
+{
+        guint b;
+
+        to->ops += from->ops;
+        to->errors += from->errors;
+        to->sum += from->sum;
+        if (from->max > to->max) {
+                to->max = from->max;
+        }
+        for (b = 0; b < NBUCKETS; ++b) {
+                to->buckets[b] += from->buckets[b];
+        }
+}
+
+/*
+ * Parses "key=weight,key=weight". Calls not listed get weight 0.
+ */
+static gboolean parse_mix(const gchar *str)
+{
+        gchar **items, **item;
+        gboolean ok = TRUE;
+        guint op;
+
+        for (op = 0; op < OP_COUNT; ++op) {
+                weights[op] = 0;
+        }
+
+        items = g_strsplit(str, ",", 0);
+        for (item = items; *item && ok; ++item) {
+                gchar *eq = strchr(*item, '=');
+                gchar *end;
+                gulong w;
+
+                if (!eq) {
+                        ok = FALSE;
+                        break;
+                }
+                *eq = '\0';
+                w = strtoul(eq + 1, &end, 10);
+                if ((*end != '\0') || (end == eq + 1)) {
+                        ok = FALSE;
+                        break;
+                }
+                for (op = 0; op < OP_COUNT; ++op) {
+                        if (strcmp(g_strstrip(*item), op_keys[op]) == 0) {
+                                weights[op] = w;
+                                break;
+                        }
+                }
+                if (op == OP_COUNT) {
+                        ok = FALSE;
+                }
+        }
+        g_strfreev(items);
+
+        if (!ok) {
+                CRIT("invalid mix \"%s\", use for example "
+                     "\"rpt=1,rdr=1,sensor=4,event=1,idr=1\"", str);
+        }
+
+        return ok;
+}
+
+static void collect_fields(SaHpiSessionIdT sid, SaHpiResourceIdT rid,
+                           SaHpiIdrIdT idr, GArray *fields)
+{
+        SaHpiEntryIdT area_id, next_area;
+        SaHpiIdrAreaHeaderT area;
+
+        area_id = SAHPI_FIRST_ENTRY;
+        while (area_id != SAHPI_LAST_ENTRY) {
+                SaHpiEntryIdT field_id, next_field;
+                SaHpiIdrFieldT field;
+
+                if (saHpiIdrAreaHeaderGet(sid, rid, idr,
+                                          SAHPI_IDR_AREATYPE_UNSPECIFIED,
+                                          area_id, &next_area, &area) != SA_OK) {
+                        break;
+                }
+                field_id = SAHPI_FIRST_ENTRY;
+                while (field_id != SAHPI_LAST_ENTRY) {
+                        struct field_target t;
+
+                        if (saHpiIdrFieldGet(sid, rid, idr, area.AreaId,
+                                             SAHPI_IDR_FIELDTYPE_UNSPECIFIED,
+                                             field_id, &next_field,
+                                             &field) != SA_OK) {
+                                break;
+                        }
+                        t.rid = rid;
+                        t.idr = idr;
+                        t.area = area.AreaId;
+                        t.field = field.FieldId;
+                        g_array_append_val(fields, t);
+                        field_id = next_field;
+                }
+                area_id = next_area;
+        }
+}
+
+/*
+ * Walks the RPT and the RDRs once and keeps what the calls will read
+ */
+static SaErrorT collect_targets(SaHpiSessionIdT sid)
+{
+        GArray *rpts = g_array_new(FALSE, FALSE, sizeof(SaHpiEntryIdT));
+        GArray *rdrs = g_array_new(FALSE, FALSE, sizeof(struct rdr_target));
+        GArray *sensors = g_array_new(FALSE, FALSE, sizeof(struct sensor_target));
+        GArray *fields = g_array_new(FALSE, FALSE, sizeof(struct field_target));
+        SaHpiEntryIdT rpt_id, next_rpt;
+        SaHpiRptEntryT rpte;
+        SaErrorT rv;
+
+        rv = saHpiDiscover(sid);
+        if (rv != SA_OK) {
+                CRIT("saHpiDiscover returned %s", oh_lookup_error(rv));
+                return rv;
+        }
+
+        rpt_id = SAHPI_FIRST_ENTRY;
+        while (rpt_id != SAHPI_LAST_ENTRY) {
+                SaHpiEntryIdT rdr_id, next_rdr;
+                SaHpiRdrT rdr;
+
+                rv = saHpiRptEntryGet(sid, rpt_id, &next_rpt, &rpte);
+                if (rv == SA_ERR_HPI_NOT_PRESENT && rpt_id == SAHPI_FIRST_ENTRY) {
+                        break;
+                } else if (rv != SA_OK) {
+                        CRIT("saHpiRptEntryGet returned %s", oh_lookup_error(rv));
+                        break;
+                }
+                g_array_append_val(rpts, rpte.EntryId);
+
+                rdr_id = SAHPI_FIRST_ENTRY;
+                while ((rpte.ResourceCapabilities & SAHPI_CAPABILITY_RDR) &&
+                       (rdr_id != SAHPI_LAST_ENTRY)) {
+                        struct rdr_target rt;
+
+                        if (saHpiRdrGet(sid, rpte.ResourceId, rdr_id,
+                                        &next_rdr, &rdr) != SA_OK) {
+                                break;
+                        }
+                        rt.rid = rpte.ResourceId;
+                        rt.entry = rdr.RecordId;
+                        g_array_append_val(rdrs, rt);
+
+                        if (rdr.RdrType == SAHPI_SENSOR_RDR &&
+                            rdr.RdrTypeUnion.SensorRec.DataFormat.IsSupported) {
+                                struct sensor_target st;
+                                st.rid = rpte.ResourceId;
+                                st.num = rdr.RdrTypeUnion.SensorRec.Num;
+                                g_array_append_val(sensors, st);
+                        } else if (rdr.RdrType == SAHPI_INVENTORY_RDR) {
+                                collect_fields(sid, rpte.ResourceId,
+                                               rdr.RdrTypeUnion.InventoryRec.IdrId,
+                                               fields);
+                        }
+                        rdr_id = next_rdr;
+                }
+                rpt_id = next_rpt;
+        }
+
+        n_rpt = rpts->len;
+        rpt_targets = (SaHpiEntryIdT *)g_array_free(rpts, FALSE);
+        n_rdr = rdrs->len;
+        rdr_targets = (struct rdr_target *)g_array_free(rdrs, FALSE);
+        n_sensor = sensors->len;
+        sensor_targets = (struct sensor_target *)g_array_free(sensors, FALSE);
+        n_field = fields->len;
+        field_targets = (struct field_target *)g_array_free(fields, FALSE);
+
+        return SA_OK;
+}
+
+/*
+ * Calls without anything to call them on are left out of the mix
+ */
+static gboolean check_mix(void)
+{
+        guint counts[OP_COUNT];
+        guint op;
+
+        counts[OP_RPT] = n_rpt;
+        counts[OP_RDR] = n_rdr;
+        counts[OP_SENSOR] = n_sensor;
+        counts[OP_EVENT] = 1;
+        counts[OP_IDR] = n_field;
+
+        weight_sum = 0;
+        for (op = 0; op < OP_COUNT; ++op) {
+                if (weights[op] && !counts[op]) {
+                        WARN("no targets for %s, left out of the mix",
+                             op_names[op]);
+                        weights[op] = 0;
+                }
+                weight_sum += weights[op];
+        }
+        if (weight_sum == 0) {
+                CRIT("nothing to call, is a plugin with resources loaded?");
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+static enum bench_op pick_op(GRand *rand)
+{
+        guint32 r = g_rand_int_range(rand, 0, weight_sum);
+        guint op;
+
+        for (op = 0; op < OP_COUNT - 1; ++op) {
+                if (r < weights[op]) {
+                        break;
+                }
+                r -= weights[op];
+        }
+
+        return (enum bench_op)op;
+}
+
+static SaErrorT do_op(SaHpiSessionIdT sid, enum bench_op op, GRand *rand)
+{
+        SaHpiEntryIdT next;
+        SaErrorT rv = SA_OK;
+        guint i;
+
+        switch (op) {
+        case OP_RPT: {
+                SaHpiRptEntryT rpte;
+                i = g_rand_int_range(rand, 0, n_rpt);
+                rv = saHpiRptEntryGet(sid, rpt_targets[i], &next, &rpte);
+                break;
+        }
+        case OP_RDR: {
+                SaHpiRdrT rdr;
+                i = g_rand_int_range(rand, 0, n_rdr);
+                rv = saHpiRdrGet(sid, rdr_targets[i].rid, rdr_targets[i].entry,
+                                 &next, &rdr);
+                break;
+        }
+        case OP_SENSOR: {
+                SaHpiSensorReadingT reading;
+                SaHpiEventStateT state;
+                i = g_rand_int_range(rand, 0, n_sensor);
+                rv = saHpiSensorReadingGet(sid, sensor_targets[i].rid,
+                                           sensor_targets[i].num,
+                                           &reading, &state);
+                break;
+        }
+        case OP_EVENT: {
+                SaHpiEventT event;
+                rv = saHpiEventGet(sid, SAHPI_TIMEOUT_IMMEDIATE, &event,
+                                   NULL, NULL, NULL);
+                /* An empty queue is the normal answer */
+                if (rv == SA_ERR_HPI_TIMEOUT) {
+                        rv = SA_OK;
+                }
+                break;
+        }
+        case OP_IDR: {
+                SaHpiIdrFieldT field;
+                i = g_rand_int_range(rand, 0, n_field);
+                rv = saHpiIdrFieldGet(sid, field_targets[i].rid,
+                                      field_targets[i].idr,
+                                      field_targets[i].area,
+                                      SAHPI_IDR_FIELDTYPE_UNSPECIFIED,
+                                      field_targets[i].field, &next, &field);
+                break;
+        }
+        default:
+                break;
+        }
+
+        return rv;
+}
+
+static gpointer bench_func(gpointer data)
+{
+        struct bench_thread *t = (struct bench_thread *)data;
+        GRand *rand = g_rand_new_with_seed(seed + t->index);
+
+        while (!g_atomic_int_get(&stop)) {
+                enum bench_op op;
+                guint64 start;
+                SaErrorT rv;
+
+                if (total_ops > 0 && !take_op()) {
+                        break;
+                }
+                op = pick_op(rand);
+                start = now_ns();
+                rv = do_op(t->sid, op, rand);
+                stats_add(&t->stats[op], now_ns() - start, rv);
+        }
+
+        g_rand_free(rand);
+        return NULL;
+}
+
+static void print_text(const struct op_stats *all, double seconds)
+{
+        struct op_stats total;
+        guint op;
+
+        memset(&total, 0, sizeof(total));
+        for (op = 0; op < OP_COUNT; ++op) {
+                stats_merge(&total, &all[op]);
+        }
+
+        printf("%d threads, %d sessions, %.2f s, %" PRIu64 " calls, "
+               "%.1f calls/s\n", nthreads, nsessions, seconds,
+               (uint64_t)total.ops, total.ops / seconds);
+        printf("targets: %u resources, %u rdrs, %u sensors, %u idr fields\n\n",
+               n_rpt, n_rdr, n_sensor, n_field);
+        printf("%-22s %10s %10s %8s %9s %9s %9s %9s %9s\n",
+               "CALL", "CALLS", "CALLS/s", "ERRORS",
+               "AVG(us)", "P50(us)", "P99(us)", "P999(us)", "MAX(us)");
+        for (op = 0; op <= OP_COUNT; ++op) {
+                const struct op_stats *s = (op < OP_COUNT) ? &all[op] : &total;
+                if (s->ops == 0) {
+                        continue;
+                }
+                printf("%-22s %10" PRIu64 " %10.1f %8" PRIu64
+                       " %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                       (op < OP_COUNT) ? op_names[op] : "all",
+                       (uint64_t)s->ops, s->ops / seconds, (uint64_t)s->errors,
+                       (double)s->sum / s->ops / 1e3,
+                       stats_percentile(s, 0.50) / 1e3,
+                       stats_percentile(s, 0.99) / 1e3,
+                       stats_percentile(s, 0.999) / 1e3,
+                       s->max / 1e3);
+        }
+}
+
+static void print_json(const struct op_stats *all, double seconds)
+{
+        gboolean first = TRUE;
+        guint op;
+
+        printf("{\n");
+        printf("  \"threads\": %d,\n  \"sessions\": %d,\n"
+               "  \"seconds\": %.3f,\n", nthreads, nsessions, seconds);
+        printf("  \"targets\": { \"rpt\": %u, \"rdr\": %u, "
+               "\"sensor\": %u, \"idr\": %u },\n",
+               n_rpt, n_rdr, n_sensor, n_field);
+        printf("  \"calls\": {");
+        for (op = 0; op < OP_COUNT; ++op) {
+                const struct op_stats *s = &all[op];
+                if (s->ops == 0) {
+                        continue;
+                }
+                printf("%s\n    \"%s\": { \"calls\": %" PRIu64
+                       ", \"errors\": %" PRIu64 ", \"calls_per_sec\": %.1f, "
+                       "\"avg_us\": %.1f, \"p50_us\": %.1f, \"p99_us\": %.1f, "
+                       "\"p999_us\": %.1f, \"max_us\": %.1f }",
+                       first ? "" : ",", op_names[op],
+                       (uint64_t)s->ops, (uint64_t)s->errors, s->ops / seconds,
+                       (double)s->sum / s->ops / 1e3,
+                       stats_percentile(s, 0.50) / 1e3,
+                       stats_percentile(s, 0.99) / 1e3,
+                       stats_percentile(s, 0.999) / 1e3,
+                       s->max / 1e3);
+                first = FALSE;
+        }
+        printf("\n  }\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+        SaErrorT rv;
+        SaHpiSessionIdT *sids;
+        struct bench_thread *threads;
+        struct op_stats *all;
+        GOptionContext *context;
+        gboolean json = FALSE;
+        guint64 start, end;
+        gint i;
+        guint op;
+
+        /* Print version strings */
+        oh_prog_version(argv[0]);
+
+        /* Parsing options */
+        static char usetext[]="- Measure the throughput and latency of the openhpi daemon\n  "
+                              OH_SVN_REV;
+        OHC_PREPARE_REVISION(usetext);
+        context = g_option_context_new (usetext);
+        g_option_context_add_main_entries (context, my_options, NULL);
+
+        if (!ohc_option_parse(&argc, argv,
+                context, &copt,
+                OHC_ALL_OPTIONS
+                    - OHC_ENTITY_PATH_OPTION  // not applicable
+                    - OHC_VERBOSE_OPTION )) { // no verbose mode
+                g_option_context_free (context);
+                return 1;
+        }
+        g_option_context_free (context);
+
+        if (nthreads <= 0 || nsessions <= 0 || duration <= 0 || total_ops < 0) {
+                CRIT("threads, sessions and duration must be positive");
+                return 1;
+        }
+        if (nsessions > nthreads) {
+                nsessions = nthreads;
+        }
+        if (mix && !parse_mix(mix)) {
+                return 1;
+        }
+        if (format) {
+                if (strcmp(format, "json") == 0) {
+                        json = TRUE;
+                } else if (strcmp(format, "text") != 0) {
+                        CRIT("unknown format %s", format);
+                        return 1;
+                }
+        }
+
+        sids = g_new0(SaHpiSessionIdT, nsessions);
+        for (i = 0; i < nsessions; ++i) {
+                rv = ohc_session_open_by_option(&copt, &sids[i]);
+                if (rv != SA_OK) {
+                        return -1;
+                }
+                if (weights[OP_EVENT]) {
+                        rv = saHpiSubscribe(sids[i]);
+                        if (rv != SA_OK) {
+                                CRIT("saHpiSubscribe returned %s",
+                                     oh_lookup_error(rv));
+                                return -1;
+                        }
+                }
+        }
+
+        rv = collect_targets(sids[0]);
+        if (rv != SA_OK || !check_mix()) {
+                return -1;
+        }
+
+        if (copt.debug) {
+                DBG("%u resources, %u rdrs, %u sensors, %u idr fields",
+                    n_rpt, n_rdr, n_sensor, n_field);
+        }
+
+        threads = g_new0(struct bench_thread, nthreads);
+        ops_left = total_ops;
+        start = now_ns();
+        for (i = 0; i < nthreads; ++i) {
+                threads[i].index = i;
+                threads[i].sid = sids[i % nsessions];
+                threads[i].thread = wrap_g_thread_create_new("hpibench",
+                                        bench_func, &threads[i], TRUE, NULL);
+                if (!threads[i].thread) {
+                        CRIT("cannot create thread %d", i);
+                        g_atomic_int_set(&stop, 1);
+                        nthreads = i;
+                        break;
+                }
+        }
+
+        if (total_ops == 0) {
+                g_usleep((gulong)duration * G_USEC_PER_SEC);
+                g_atomic_int_set(&stop, 1);
+        }
+        for (i = 0; i < nthreads; ++i) {
+                g_thread_join(threads[i].thread);
+        }
+        end = now_ns();
+
+        all = g_new0(struct op_stats, OP_COUNT);
+        for (i = 0; i < nthreads; ++i) {
+                for (op = 0; op < OP_COUNT; ++op) {
+                        stats_merge(&all[op], &threads[i].stats[op]);
+                }
+        }
+
+        if (json) {
+                print_json(all, (end - start) / 1e9);
+        } else {
+                print_text(all, (end - start) / 1e9);
+        }
+
+        for (i = 0; i < nsessions; ++i) {
+                saHpiSessionClose(sids[i]);
+        }
+        g_free(all);
+        g_free(threads);
+        g_free(sids);
+        g_free(rpt_targets);
+        g_free(rdr_targets);
+        g_free(sensor_targets);
+        g_free(field_targets);
+
+        return 0;
+}
+
+/* end hpibench.c */
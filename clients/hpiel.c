@@ -186,6 +186,82 @@ SaErrorT harvest_sels(SaHpiSessionIdT sid, SaHpiDomainInfoT *dinfo)
         return error;
 }
 
+/* Number of entries fetched with one oHpiEventLogEntriesGet call */
+#define HPIEL_BATCH_SIZE 32
+
+static void display_elentry(SaHpiEventLogEntryT *elentry,
+                            SaHpiRdrT *rdr,
+                            SaHpiRptEntryT *res)
+{
+        SaHpiEntityPathT *ep = NULL;
+        /* Get a reference to the entity path for this log entry */
+        if (res->ResourceCapabilities) {
+                ep = &res->ResourceEntity;
+        } else if (rdr->RdrType != SAHPI_NO_RECORD) {
+                ep = &rdr->Entity;
+        }
+        /* Print the event log entry */
+        oh_print_eventlogentry(elentry, ep, 6);
+        if (opts.rdr) {
+                if (rdr->RdrType == SAHPI_NO_RECORD)
+                        printf("            No RDR associated with EventType =  %s\n\n",
+                               oh_lookup_eventtype(elentry->Event.EventType));
+                else
+                        oh_print_rdr(rdr, 12);
+        }
+
+        if (opts.resource) {
+                if (res->ResourceCapabilities == 0)
+                        printf("            No RPT associated with EventType =  %s\n\n",
+                               oh_lookup_eventtype(elentry->Event.EventType));
+                else
+                        oh_print_rptentry(res, 10);
+        }
+}
+
+/*
+ * Dumps the log with oHpiEventLogEntriesGet.
+ * Returns SA_ERR_HPI_UNSUPPORTED_API if the daemon does not support it
+ * and nothing has been printed yet.
+ */
+static SaErrorT display_el_batched(SaHpiSessionIdT sid, SaHpiResourceIdT rid)
+{
+        SaErrorT error = SA_OK;
+        SaHpiEventLogEntryIdT entryid = SAHPI_OLDEST_ENTRY;
+        SaHpiUint32T i, n;
+        SaHpiEventLogEntryT *elentries;
+        SaHpiRdrT *rdrs;
+        SaHpiRptEntryT *rptes;
+
+        elentries = g_new0(SaHpiEventLogEntryT, HPIEL_BATCH_SIZE);
+        rdrs = g_new0(SaHpiRdrT, HPIEL_BATCH_SIZE);
+        rptes = g_new0(SaHpiRptEntryT, HPIEL_BATCH_SIZE);
+
+        while (entryid != SAHPI_NO_MORE_ENTRIES) {
+                error = oHpiEventLogEntriesGet(sid, rid, entryid,
+                                               HPIEL_BATCH_SIZE,
+                                               SAHPI_TIME_UNSPECIFIED,
+                                               SAHPI_TIME_UNSPECIFIED,
+                                               &n, elentries, rdrs, rptes,
+                                               &entryid);
+                if (copt.debug)
+                   CRIT ("oHpiEventLogEntriesGet() returned %s\n",
+                         oh_lookup_error(error));
+                if (error != SA_OK) {
+                        break;
+                }
+                for (i = 0; i < n; i++) {
+                        display_elentry(&elentries[i], &rdrs[i], &rptes[i]);
+                }
+        }
+
+        g_free(elentries);
+        g_free(rdrs);
+        g_free(rptes);
+
+        return error;
+}
+
 SaErrorT display_el(SaHpiSessionIdT sid, SaHpiResourceIdT rid, SaHpiTextBufferT *tag)
 {
         SaErrorT error = SA_OK;
@@ -228,6 +304,12 @@ SaErrorT display_el(SaHpiSessionIdT sid, SaHpiResourceIdT rid, SaHpiTextBufferT
 
         }
 
+        error = display_el_batched(sid, rid);
+        if (error != SA_ERR_HPI_UNSUPPORTED_API) {
+                return error;
+        }
+
+        /* The daemon is older than the client, read entry by entry */
         entryid = SAHPI_OLDEST_ENTRY;
         while (entryid != SAHPI_NO_MORE_ENTRIES) {
                 error = saHpiEventLogEntryGet(sid, rid,
@@ -240,30 +322,7 @@ SaErrorT display_el(SaHpiSessionIdT sid, SaHpiResourceIdT rid, SaHpiTextBufferT
                    CRIT ("saHpiEventLogEntryGet() returned %s\n", 
                          oh_lookup_error(error));
                 if (error == SA_OK) {
-                	SaHpiEntityPathT *ep = NULL;
-                	/* Get a reference to the entity path for this log entry */
-                	if (res.ResourceCapabilities) {
-                		ep = &res.ResourceEntity;
-                	} else if (rdr.RdrType != SAHPI_NO_RECORD) {
-                		ep = &rdr.Entity;
-                	}
-                	/* Print the event log entry */
-                        oh_print_eventlogentry(&elentry, ep, 6);
-                        if (opts.rdr) {
-                                if (rdr.RdrType == SAHPI_NO_RECORD)
-                                        printf("            No RDR associated with EventType =  %s\n\n",
-                                               oh_lookup_eventtype(elentry.Event.EventType));
-                                else
-                                        oh_print_rdr(&rdr, 12);
-                        }
-
-                        if (opts.resource) {
-                                if (res.ResourceCapabilities == 0)
-                                        printf("            No RPT associated with EventType =  %s\n\n",
-                                               oh_lookup_eventtype(elentry.Event.EventType));
-                                else
-                                        oh_print_rptentry(&res, 10);
-                        }
+                        display_elentry(&elentry, &rdr, &res);
 
                         preventryid = entryid;
                         entryid = nextentryid;
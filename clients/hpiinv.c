@@ -402,14 +402,76 @@ static void print_idrfield(SaHpiIdrFieldT *field, int len)
    }
 }
 
+/*
+ * walkArea
+ * Reads and prints one area field by field.
+ * Returns the saHpiIdrAreaHeaderGet error and the number of fields read.
+ */
+static SaErrorT walkArea(SaHpiSessionIdT sessionid, SaHpiResourceIdT resourceid,
+		  SaHpiIdrInfoT *idrInfo, SaHpiEntryIdT areaId,
+		  SaHpiEntryIdT *nextareaId, SaHpiUint32T *countFields)
+{
+   SaErrorT 	rv = SA_OK, 
+   		rvField = SA_OK;
+
+   SaHpiIdrAreaHeaderT  areaHeader;
+
+   SaHpiEntryIdT	fieldId;
+   SaHpiEntryIdT	nextFieldId;
+   SaHpiIdrFieldTypeT 	fieldType;
+   SaHpiIdrFieldT  	thisField;
+
+   *countFields = 0;
+   rv = saHpiIdrAreaHeaderGet(sessionid, resourceid,
+			   idrInfo->IdrId, SAHPI_IDR_AREATYPE_UNSPECIFIED,
+			   areaId, nextareaId,
+			   &areaHeader);
+   if (rv != SA_OK) return(rv);
+
+   print_idrareaheader(&areaHeader, 8);
+
+   fieldType = SAHPI_IDR_FIELDTYPE_UNSPECIFIED;
+   fieldId = SAHPI_FIRST_ENTRY;
+
+   while ((rvField == SA_OK) && (fieldId != SAHPI_LAST_ENTRY))
+   {
+	rvField = saHpiIdrFieldGet( sessionid,	resourceid,
+				idrInfo->IdrId,
+				areaHeader.AreaId, fieldType,
+				fieldId, &nextFieldId,
+				&thisField);
+	if (copt.debug) 
+		DBG("saHpiIdrFieldGet[%x] rv = %d type=%u",
+			idrInfo->IdrId,rvField,
+			thisField.Type);
+	if (rvField == SA_OK) {
+		(*countFields)++; 
+		print_idrfield(&thisField, 12);
+		if (thisField.Type == SAHPI_IDR_FIELDTYPE_ASSET_TAG) {
+		   atag.rid   = resourceid;
+		   atag.idrid = idrInfo->IdrId;
+		   atag.areaid = areaHeader.AreaId;
+		   atag.fieldid = fieldId;
+		   foundasset = 1;
+		}
+	}
+	fieldId = nextFieldId;
+   }  /*while fields*/
+		
+   if ( *countFields != areaHeader.NumFields) 
+	printf("Area Header error: areaHeader.NumFields %u, countFields %u\n",
+		areaHeader.NumFields, *countFields);
+
+   return(rv);
+}  /*end walkArea*/
+
 int walkInventory(SaHpiSessionIdT sessionid, SaHpiResourceIdT resourceid,
 		  SaHpiIdrInfoT *idrInfo);
 int walkInventory(SaHpiSessionIdT sessionid, SaHpiResourceIdT resourceid,
 		  SaHpiIdrInfoT 	*idrInfo)
 {
 
-   SaErrorT 	rv = SA_OK, 
-   		rvField = SA_OK;
+   SaErrorT 	rv = SA_OK;
 
    SaHpiUint32T	numAreas;
    SaHpiUint32T	countAreas = 0;
@@ -417,60 +479,16 @@ int walkInventory(SaHpiSessionIdT sessionid, SaHpiResourceIdT resourceid,
 
    SaHpiEntryIdT	areaId;
    SaHpiEntryIdT	nextareaId;
-   SaHpiIdrAreaTypeT 	areaType;
-   SaHpiIdrAreaHeaderT  areaHeader;
-
-   SaHpiEntryIdT	fieldId;
-   SaHpiEntryIdT	nextFieldId;
-   SaHpiIdrFieldTypeT 	fieldType;
-   SaHpiIdrFieldT  	thisField;
 
    numAreas = idrInfo->NumAreas;
-   areaType = SAHPI_IDR_AREATYPE_UNSPECIFIED;
    areaId = SAHPI_FIRST_ENTRY; 
    foundasset = 0;
    while ((rv == SA_OK) && (areaId != SAHPI_LAST_ENTRY)) 
    {
-	rv = saHpiIdrAreaHeaderGet(sessionid, resourceid,
-				   idrInfo->IdrId, areaType,
-				   areaId, &nextareaId,
-				   &areaHeader);
+	rv = walkArea(sessionid, resourceid, idrInfo, areaId,
+		      &nextareaId, &countFields);
 	if (rv == SA_OK) {
 		countAreas++;
-		print_idrareaheader(&areaHeader, 8);
-
-		fieldType = SAHPI_IDR_FIELDTYPE_UNSPECIFIED;
-		fieldId = SAHPI_FIRST_ENTRY;
-		countFields = 0;
-	
-		while ((rvField == SA_OK) && (fieldId != SAHPI_LAST_ENTRY))
-		{
-			rvField = saHpiIdrFieldGet( sessionid,	resourceid,
-						idrInfo->IdrId,
-						areaHeader.AreaId, fieldType,
-						fieldId, &nextFieldId,
-						&thisField);
-			if (copt.debug) 
-				DBG("saHpiIdrFieldGet[%x] rv = %d type=%u",
-					idrInfo->IdrId,rvField,
-					thisField.Type);
-			if (rvField == SA_OK) {
-				countFields++; 
-				print_idrfield(&thisField, 12);
-				if (thisField.Type == SAHPI_IDR_FIELDTYPE_ASSET_TAG) {
-				   atag.rid   = resourceid;
-				   atag.idrid = idrInfo->IdrId;
-				   atag.areaid = areaHeader.AreaId;
-				   atag.fieldid = fieldId;
-				   foundasset = 1;
-				}
-			}
-			fieldId = nextFieldId;
-		}  /*while fields*/
-			
-		if ( countFields != areaHeader.NumFields) 
-			printf("Area Header error: areaHeader.NumFields %u, countFields %u\n",
-				areaHeader.NumFields, countFields);
 	} else {
 		printf("saHpiIdrAreaHeaderGet error %d\n",rv);
 	}
@@ -486,6 +504,104 @@ int walkInventory(SaHpiSessionIdT sessionid, SaHpiResourceIdT resourceid,
    return(rv);
 }  /*end walkInventory*/
 
+#ifdef OPENHPI_USED
+/*
+ * walkInventoryBulk
+ * Same as walkInventory, but reads the IDR with oHpiIdrGet in a few
+ * calls instead of one call per area and field.
+ * An area with more fields than fit into one reply is read with
+ * walkArea.
+ * Returns SA_ERR_HPI_UNSUPPORTED_API before printing anything if
+ * the daemon does not support oHpiIdrGet.
+ */
+static SaErrorT walkInventoryBulk(SaHpiSessionIdT sessionid,
+		  SaHpiResourceIdT resourceid, SaHpiIdrInfoT *idrInfo)
+{
+   SaErrorT	rv = SA_OK;
+   SaHpiIdrInfoT	info;
+   SaHpiIdrAreaHeaderT  *areas;
+   SaHpiIdrFieldT	*fields;
+   SaHpiUint32T	numAreas, numFields, a, f;
+   SaHpiUint32T	countAreas = 0;
+   SaHpiUint32T	countFields;
+   SaHpiEntryIdT	areaId = SAHPI_FIRST_ENTRY;
+   SaHpiEntryIdT	nextareaId;
+
+   areas = g_new(SaHpiIdrAreaHeaderT, OH_MAX_IDR_AREAS_GET);
+   fields = g_new(SaHpiIdrFieldT, OH_MAX_IDR_FIELDS_GET);
+   foundasset = 0;
+   while (areaId != SAHPI_LAST_ENTRY)
+   {
+	rv = oHpiIdrGet(sessionid, resourceid, idrInfo->IdrId, areaId,
+			OH_MAX_IDR_AREAS_GET, OH_MAX_IDR_FIELDS_GET,
+			&info, &numAreas, areas,
+			&numFields, fields, &nextareaId);
+	if (copt.debug)
+		DBG("oHpiIdrGet[%x] rv = %d areas=%u fields=%u",
+			idrInfo->IdrId, rv, numAreas, numFields);
+	if (rv == SA_ERR_HPI_OUT_OF_SPACE) {
+		/* Too many fields for one reply, read this area field by field */
+		rv = walkArea(sessionid, resourceid, idrInfo, areaId,
+			      &nextareaId, &countFields);
+		if (rv != SA_OK) {
+			printf("saHpiIdrAreaHeaderGet error %d\n",rv);
+			break;
+		}
+		countAreas++;
+		areaId = nextareaId;
+		continue;
+	}
+	if (rv != SA_OK) {
+		if ((rv != SA_ERR_HPI_UNSUPPORTED_API) || (countAreas > 0))
+			printf("oHpiIdrGet error %d\n",rv);
+		break;
+	}
+	f = 0;
+	for (a = 0; a < numAreas; a++) {
+		countAreas++;
+		print_idrareaheader(&areas[a], 8);
+		countFields = 0;
+		while ((f < numFields) && (fields[f].AreaId == areas[a].AreaId)) {
+			countFields++;
+			print_idrfield(&fields[f], 12);
+			if (fields[f].Type == SAHPI_IDR_FIELDTYPE_ASSET_TAG) {
+			   atag.rid   = resourceid;
+			   atag.idrid = idrInfo->IdrId;
+			   atag.areaid = areas[a].AreaId;
+			   atag.fieldid = fields[f].FieldId;
+			   foundasset = 1;
+			}
+			f++;
+		}
+		if ( countFields != areas[a].NumFields) 
+			printf("Area Header error: areaHeader.NumFields %u, countFields %u\n",
+				areas[a].NumFields, countFields);
+	}
+	if (numAreas == 0) break;
+	areaId = nextareaId;
+   }   /*while areas*/
+
+   g_free(areas);
+   g_free(fields);
+
+   if ((rv == SA_OK) && (countAreas != idrInfo->NumAreas)) 
+	printf("idrInfo error! idrInfo.NumAreas = %u; countAreas = %u\n", 
+			idrInfo->NumAreas, countAreas);
+
+   return(rv);
+}  /*end walkInventoryBulk*/
+#endif
+
+static int readInventory(SaHpiSessionIdT sessionid, SaHpiResourceIdT resourceid,
+		  SaHpiIdrInfoT *idrInfo)
+{
+#ifdef OPENHPI_USED
+   SaErrorT rv = walkInventoryBulk(sessionid, resourceid, idrInfo);
+   if (rv != SA_ERR_HPI_UNSUPPORTED_API) return(rv);
+#endif
+   return(walkInventory(sessionid, resourceid, idrInfo));
+}
+
 int
 main(int argc, char **argv)
 {
@@ -611,7 +727,7 @@ main(int argc, char **argv)
 	           printf("RDR[%x]: Inventory, IdrId=%x %s\n",rdr.RecordId,
 			idrid,rdr.IdString.Data);
 		   print_idrinfo(&idrInfo,4);
-		   rv_rdr = walkInventory(sessionid, resourceid, &idrInfo);
+		   rv_rdr = readInventory(sessionid, resourceid, &idrInfo);
 		   if (copt.debug) DBG("walkInventory rv_rdr = %d",rv_rdr);
 		}
 		
@@ -635,7 +751,7 @@ main(int argc, char **argv)
 			printf("Return Write Status = %d\n", rv_rdr);
 			if (rv_rdr == SA_OK) {
 			   printf ("Good write - re-reading!\n");
-			   rv_rdr = walkInventory(sessionid, resourceid, &idrInfo);
+			   rv_rdr = readInventory(sessionid, resourceid, &idrInfo);
 			   if (copt.debug) DBG("walkInventory rv_rdr = %d",rv_rdr);
 			} /* Good write - re-read */
 		   }  /*endif foundasset*/
@@ -68,10 +68,20 @@ static SaErrorT list_ann (SaHpiSessionIdT sessionid,
 			SaHpiRdrT *rdrptr, 
 			SaHpiResourceIdT l_resourceid);
 
+static SaErrorT walkArea(SaHpiSessionIdT sessionid,
+		   SaHpiResourceIdT resourceid,
+		   SaHpiIdrInfoT *idrInfo,
+		   SaHpiEntryIdT areaId,
+		   SaHpiEntryIdT *nextareaId);
+
 static SaErrorT walkInventory(SaHpiSessionIdT sessionid,
 		   SaHpiResourceIdT resourceid,
 		   SaHpiIdrInfoT *idrInfo);
 
+static SaErrorT walkInventoryBulk(SaHpiSessionIdT sessionid,
+		   SaHpiResourceIdT resourceid,
+		   SaHpiIdrInfoT *idrInfo);
+
 static 
 SaErrorT getcontrolstate(SaHpiSessionIdT sessionid,
 			SaHpiResourceIdT l_resourceid,
@@ -308,7 +318,10 @@ SaErrorT list_inv(SaHpiSessionIdT sessionid,
 					l_resourceid, idrid, oh_lookup_error(rvInvent));
 		} else {
 			oh_print_idrinfo(&idrInfo, 4);
-			walkInventory(sessionid, l_resourceid, &idrInfo);
+			if (walkInventoryBulk(sessionid, l_resourceid, &idrInfo)
+			    == SA_ERR_HPI_UNSUPPORTED_API) {
+				walkInventory(sessionid, l_resourceid, &idrInfo);
+			}
 		}
 	}
 	return(rvInvent);
@@ -326,67 +339,23 @@ SaErrorT walkInventory(	SaHpiSessionIdT sessionid,
 			SaHpiIdrInfoT	*idrInfo)
 {
 
-	SaErrorT 	rv = SA_OK, 
-			rvField = SA_OK;
+	SaErrorT 	rv = SA_OK;
 
 	SaHpiUint32T	numAreas;
 	SaHpiUint32T	countAreas = 0;
-	SaHpiUint32T	countFields = 0;
 
 	SaHpiEntryIdT	areaId;
 	SaHpiEntryIdT	nextareaId;
-	SaHpiIdrAreaTypeT areaType;
-	SaHpiIdrAreaHeaderT  areaHeader;
-
-	SaHpiEntryIdT	fieldId;
-	SaHpiEntryIdT	nextFieldId;
-	SaHpiIdrFieldTypeT fieldType;
-	SaHpiIdrFieldT	      thisField;
 
 
 
 	numAreas = idrInfo->NumAreas;
-	areaType = SAHPI_IDR_AREATYPE_UNSPECIFIED;
 	areaId = SAHPI_FIRST_ENTRY;
 
 	do {
-		rv = saHpiIdrAreaHeaderGet(sessionid,
-					   resourceid,
-					   idrInfo->IdrId,
-					   areaType,
-					   areaId,
-					   &nextareaId,
-					   &areaHeader);
+		rv = walkArea(sessionid, resourceid, idrInfo, areaId, &nextareaId);
 		if (rv == SA_OK) {
-			countFields = 0;	/* Bug #1057934 */
 			countAreas++;
-			oh_print_idrareaheader(&areaHeader, 8);
-
-			fieldType = SAHPI_IDR_FIELDTYPE_UNSPECIFIED;
-			fieldId = SAHPI_FIRST_ENTRY;
-		
-			do {
-				rvField = saHpiIdrFieldGet(
-							sessionid,	
-							resourceid,
-							idrInfo->IdrId,
-							areaHeader.AreaId, 
-							fieldType,
-							fieldId,
-							&nextFieldId,
-							&thisField);
-				if (rvField == SA_OK) {
-					countFields++; 
-					oh_print_idrfield(&thisField, 12);
-				}
- 
-				if (copt.debug) DBG("saHpiIdrFieldGet  error %s",oh_lookup_error(rvField));
-				fieldId = nextFieldId;
-			} while ((rvField == SA_OK) && (fieldId != SAHPI_LAST_ENTRY));
-		
-			if ( countFields != areaHeader.NumFields) 
-				printf("Area Header error! areaHeader.NumFields %u, countFields %u\n",
-					areaHeader.NumFields, countFields);
 		} else {
 			printf("saHpiIdrAreaHeaderGet error %s\n",oh_lookup_error(rv));
 		}
@@ -401,6 +370,149 @@ SaErrorT walkInventory(	SaHpiSessionIdT sessionid,
 	return(rv);
 }
 
+/* 
+ * Reads and prints one area of the idr field by field.
+ * Returns the saHpiIdrAreaHeaderGet error.
+ *
+**/
+static 
+SaErrorT walkArea(	SaHpiSessionIdT sessionid,
+			SaHpiResourceIdT resourceid,
+			SaHpiIdrInfoT	*idrInfo,
+			SaHpiEntryIdT	areaId,
+			SaHpiEntryIdT	*nextareaId)
+{
+
+	SaErrorT 	rv = SA_OK, 
+			rvField = SA_OK;
+
+	SaHpiUint32T	countFields = 0;
+
+	SaHpiIdrAreaHeaderT  areaHeader;
+
+	SaHpiEntryIdT	fieldId;
+	SaHpiEntryIdT	nextFieldId;
+	SaHpiIdrFieldTypeT fieldType;
+	SaHpiIdrFieldT	      thisField;
+
+	rv = saHpiIdrAreaHeaderGet(sessionid,
+				   resourceid,
+				   idrInfo->IdrId,
+				   SAHPI_IDR_AREATYPE_UNSPECIFIED,
+				   areaId,
+				   nextareaId,
+				   &areaHeader);
+	if (rv != SA_OK) return(rv);
+
+	oh_print_idrareaheader(&areaHeader, 8);
+
+	fieldType = SAHPI_IDR_FIELDTYPE_UNSPECIFIED;
+	fieldId = SAHPI_FIRST_ENTRY;
+
+	do {
+		rvField = saHpiIdrFieldGet(
+					sessionid,	
+					resourceid,
+					idrInfo->IdrId,
+					areaHeader.AreaId, 
+					fieldType,
+					fieldId,
+					&nextFieldId,
+					&thisField);
+		if (rvField == SA_OK) {
+			countFields++; 
+			oh_print_idrfield(&thisField, 12);
+		}
+
+		if (copt.debug) DBG("saHpiIdrFieldGet  error %s",oh_lookup_error(rvField));
+		fieldId = nextFieldId;
+	} while ((rvField == SA_OK) && (fieldId != SAHPI_LAST_ENTRY));
+
+	if ( countFields != areaHeader.NumFields) 
+		printf("Area Header error! areaHeader.NumFields %u, countFields %u\n",
+			areaHeader.NumFields, countFields);
+
+	return(rv);
+}
+
+/* 
+ * Same as walkInventory, but reads the idr with oHpiIdrGet in a few
+ * calls instead of one call per area and field.
+ * An area with more fields than fit into one reply is read with
+ * walkArea.
+ * Returns SA_ERR_HPI_UNSUPPORTED_API before printing anything if
+ * the daemon does not support oHpiIdrGet.
+ *
+**/
+static 
+SaErrorT walkInventoryBulk(SaHpiSessionIdT sessionid,
+			SaHpiResourceIdT resourceid,
+			SaHpiIdrInfoT	*idrInfo)
+{
+	SaErrorT	rv = SA_OK;
+	SaHpiIdrInfoT	info;
+	SaHpiIdrAreaHeaderT *areas;
+	SaHpiIdrFieldT	*fields;
+	SaHpiUint32T	numAreas, numFields, a, f;
+	SaHpiUint32T	countAreas = 0;
+	SaHpiUint32T	countFields;
+	SaHpiEntryIdT	areaId = SAHPI_FIRST_ENTRY;
+	SaHpiEntryIdT	nextareaId;
+
+	areas = g_new(SaHpiIdrAreaHeaderT, OH_MAX_IDR_AREAS_GET);
+	fields = g_new(SaHpiIdrFieldT, OH_MAX_IDR_FIELDS_GET);
+
+	while (areaId != SAHPI_LAST_ENTRY) {
+		rv = oHpiIdrGet(sessionid, resourceid, idrInfo->IdrId, areaId,
+				OH_MAX_IDR_AREAS_GET, OH_MAX_IDR_FIELDS_GET,
+				&info, &numAreas, areas,
+				&numFields, fields, &nextareaId);
+		if (rv == SA_ERR_HPI_OUT_OF_SPACE) {
+			/* Too many fields for one reply, read this area field by field */
+			rv = walkArea(sessionid, resourceid, idrInfo, areaId,
+				      &nextareaId);
+			if (rv != SA_OK) {
+				printf("saHpiIdrAreaHeaderGet error %s\n",oh_lookup_error(rv));
+				break;
+			}
+			countAreas++;
+			areaId = nextareaId;
+			continue;
+		}
+		if (rv != SA_OK) {
+			if ((rv != SA_ERR_HPI_UNSUPPORTED_API) || (countAreas > 0))
+				printf("oHpiIdrGet error %s\n",oh_lookup_error(rv));
+			break;
+		}
+		f = 0;
+		for (a = 0; a < numAreas; a++) {
+			countAreas++;
+			oh_print_idrareaheader(&areas[a], 8);
+			countFields = 0;
+			while ((f < numFields) &&
+			       (fields[f].AreaId == areas[a].AreaId)) {
+				countFields++;
+				oh_print_idrfield(&fields[f], 12);
+				f++;
+			}
+			if ( countFields != areas[a].NumFields) 
+				printf("Area Header error! areaHeader.NumFields %u, countFields %u\n",
+					areas[a].NumFields, countFields);
+		}
+		if (numAreas == 0) break;
+		areaId = nextareaId;
+	}
+
+	g_free(areas);
+	g_free(fields);
+
+	if ((rv == SA_OK) && (countAreas != idrInfo->NumAreas)) 
+		printf("idrInfo error! idrInfo.NumAreas = %u; countAreas = %u\n", 
+				idrInfo->NumAreas, countAreas);
+
+	return(rv);
+}
+
 
 /* 
  *
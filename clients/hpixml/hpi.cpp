@@ -15,10 +15,12 @@
  */
 
 #include <list>
+#include <vector>
 
 #include <oh_error.h>
 #include <oh_utils.h>
 #include <oh_clients.h>
+#include <sahpi_wrappers.h>
 
 #include "hpi.h"
 #include "hpi_xml_writer.h"
@@ -129,6 +131,48 @@ static bool FetchLog( SaHpiSessionIdT sid,
 
     SaHpiEventLogEntryIdT prev_id, id, next_id;
     LogEntry le;
+
+    // Batched read
+    const SaHpiUint32T batch_size = 32;
+    std::vector<SaHpiEventLogEntryT> entries( batch_size );
+    std::vector<SaHpiRdrT> rdrs( batch_size );
+    std::vector<SaHpiRptEntryT> rptes( batch_size );
+    id = SAHPI_OLDEST_ENTRY;
+    while ( id != SAHPI_NO_MORE_ENTRIES ) {
+        SaHpiUint32T n = 0;
+        rv = oHpiEventLogEntriesGet( sid,
+                                     rid,
+                                     id,
+                                     batch_size,
+                                     SAHPI_TIME_UNSPECIFIED,
+                                     SAHPI_TIME_UNSPECIFIED,
+                                     &n,
+                                     &entries[0],
+                                     &rdrs[0],
+                                     &rptes[0],
+                                     &next_id );
+        if ( rv != SA_OK ) {
+            break;
+        }
+        for ( SaHpiUint32T i = 0; i < n; ++i ) {
+            le.entry = entries[i];
+            le.rdr   = rdrs[i];
+            le.rpte  = rptes[i];
+            log.entries.push_back( le );
+        }
+        id = next_id;
+    }
+    if ( ( rv == SA_OK ) || ( rv == SA_ERR_HPI_NOT_PRESENT ) ) {
+        return true;
+    }
+    if ( rv != SA_ERR_HPI_UNSUPPORTED_API ) {
+        log.entries.clear();
+        CRIT( "oHpiEventLogEntriesGet returned %s", oh_lookup_error( rv ) );
+        return false;
+    }
+
+    // The daemon does not support batched read
+    log.entries.clear();
     id = SAHPI_OLDEST_ENTRY;
     while ( id != SAHPI_NO_MORE_ENTRIES ) {
         rv = saHpiEventLogEntryGet( sid,
@@ -202,9 +246,37 @@ static bool FetchInstruments( SaHpiSessionIdT sid,
     return true;
 }
 
-static bool FetchResources( SaHpiSessionIdT sid,
-                            SaHpiDomainInfoT& di,
-                            std::list<Resource>& rpt )
+static bool FetchResource( SaHpiSessionIdT sid,
+                           Resource& resource )
+{
+    bool rc;
+
+    resource.rdr_update_count = 0;
+    resource.instruments.clear();
+    resource.log.entries.clear();
+
+    if ( resource.rpte.ResourceFailed != SAHPI_FALSE ) {
+        return true;
+    }
+    if ( resource.rpte.ResourceCapabilities & SAHPI_CAPABILITY_RDR ) {
+        rc = FetchInstruments( sid, resource );
+        if ( !rc ) {
+            return false;
+        }
+    }
+    if ( resource.rpte.ResourceCapabilities & SAHPI_CAPABILITY_EVENT_LOG ) {
+        rc = FetchLog( sid, resource.rpte.ResourceId, resource.log );
+        if ( !rc ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool FetchRpt( SaHpiSessionIdT sid,
+                      SaHpiDomainInfoT& di,
+                      std::vector<Resource>& rpt )
 {
     SaHpiDomainInfoT di2;
 
@@ -220,6 +292,7 @@ static bool FetchResources( SaHpiSessionIdT sid,
 
         SaHpiEntryIdT id, next_id;
         Resource resource;
+        resource.rdr_update_count = 0;
         id = SAHPI_FIRST_ENTRY;
         while ( id != SAHPI_LAST_ENTRY ) {
             SaErrorT rv;
@@ -232,25 +305,6 @@ static bool FetchResources( SaHpiSessionIdT sid,
                 CRIT( "saHpiRptEntryGet returned %s", oh_lookup_error( rv ) );
                 return false;
             }
-
-            resource.instruments.clear();
-            resource.log.entries.clear();
-
-            if ( resource.rpte.ResourceFailed == SAHPI_FALSE ) {
-                if ( resource.rpte.ResourceCapabilities & SAHPI_CAPABILITY_RDR ) {
-                    rc = FetchInstruments( sid, resource );
-                    if ( !rc ) {
-                        break;
-                    }
-                }
-                if ( resource.rpte.ResourceCapabilities & SAHPI_CAPABILITY_EVENT_LOG ) {
-                    rc = FetchLog( sid, resource.rpte.ResourceId, resource.log );
-                    if ( !rc ) {
-                        break;
-                    }
-                }
-            }
-
             rpt.push_back( resource );
             id = next_id;
         }
@@ -346,25 +400,18 @@ static void DumpInstruments( cHpiXmlWriter& writer,
     }
 }
 
-static void DumpResources( cHpiXmlWriter& writer,
-                           SaHpiDomainInfoT& di,
-                           std::list<Resource>& rpt )
+static void DumpResource( cHpiXmlWriter& writer,
+                          Resource& resource )
 {
-    writer.BeginRptNode( di );
-    while ( !rpt.empty() ) {
-        Resource& resource = rpt.front();
-        writer.BeginResourceNode( resource.rpte, resource.rdr_update_count );
+    writer.BeginResourceNode( resource.rpte, resource.rdr_update_count );
 
-        if ( resource.rpte.ResourceCapabilities & SAHPI_CAPABILITY_EVENT_LOG ) {
-            DumpLog( writer, resource.rpte.ResourceId, resource.log );
-        }
+    if ( resource.rpte.ResourceCapabilities & SAHPI_CAPABILITY_EVENT_LOG ) {
+        DumpLog( writer, resource.rpte.ResourceId, resource.log );
+    }
 
-        DumpInstruments( writer, resource.instruments );
+    DumpInstruments( writer, resource.instruments );
 
-        writer.EndResourceNode();
-        rpt.pop_front();
-    }
-    writer.EndRptNode();
+    writer.EndResourceNode();
 }
 
 static void DumpDat( cHpiXmlWriter& writer,
@@ -380,14 +427,76 @@ static void DumpDat( cHpiXmlWriter& writer,
 }
 
 
+/***************************************************
+ * Parallel Resource Fetch
+ *
+ * Fetch threads get instruments and event logs of the resources
+ * over their own sessions. The dump writes the resources in RPT
+ * order as soon as they are fetched, so fetch and output overlap.
+ ***************************************************/
+enum FetchState
+{
+    FetchPending,
+    FetchDone,
+    FetchFailed
+};
+
+// Max number of resources fetched ahead of the output, per session
+static const size_t FetchAhead = 16;
+
+struct FetchQueue
+{
+    std::vector<Resource> rpt;
+    std::vector<FetchState> states;
+    size_t next;    // next resource to fetch
+    size_t limit;   // resources at or after it wait for the output
+    GMutex * lock;
+    GCond * cond;
+};
+
+struct FetchThread
+{
+    FetchQueue * queue;
+    SaHpiSessionIdT sid;
+    GThread * thread;
+};
+
+static gpointer FetchThreadFunc( gpointer data )
+{
+    FetchThread * ft = reinterpret_cast<FetchThread *>( data );
+    FetchQueue& q = *ft->queue;
+
+    wrap_g_mutex_lock( q.lock );
+    while ( q.next < q.rpt.size() ) {
+        if ( q.next >= q.limit ) {
+            g_cond_wait( q.cond, q.lock );
+            continue;
+        }
+        size_t i = q.next;
+        ++q.next;
+        wrap_g_mutex_unlock( q.lock );
+
+        bool rc = FetchResource( ft->sid, q.rpt[i] );
+
+        wrap_g_mutex_lock( q.lock );
+        q.states[i] = rc ? FetchDone : FetchFailed;
+        g_cond_broadcast( q.cond );
+    }
+    wrap_g_mutex_unlock( q.lock );
+
+    return 0;
+}
+
+
 /***************************************************
  * class cHpi
  ***************************************************/
-cHpi::cHpi( oHpiCommonOptionsT copt )
+cHpi::cHpi( oHpiCommonOptionsT copt, int fetch_sessions )
     : m_initialized( false ),
       m_opened( false ),
       m_copt( copt ),
-      m_sid( 0 )
+      m_sid( 0 ),
+      m_fetch_sessions( fetch_sessions )
 {
     // empty
 }
@@ -466,13 +575,10 @@ bool cHpi::Dump( cHpiXmlWriter& writer )
     }
     DumpDrt( writer, drt_di, drt );
 
-    SaHpiDomainInfoT rpt_di;
-    std::list<Resource> rpt;
-    rc = FetchResources( m_sid, rpt_di, rpt );
+    rc = DumpRpt( writer );
     if ( !rc ) {
         return false;
     }
-    DumpResources( writer, rpt_di, rpt );
 
     Log del;
     rc = FetchLog( m_sid, SAHPI_UNSPECIFIED_RESOURCE_ID, del );
@@ -496,3 +602,97 @@ bool cHpi::Dump( cHpiXmlWriter& writer )
     return true;
 }
 
+bool cHpi::DumpRpt( cHpiXmlWriter& writer )
+{
+    bool rc;
+    SaHpiDomainInfoT di;
+    FetchQueue q;
+
+    rc = FetchRpt( m_sid, di, q.rpt );
+    if ( !rc ) {
+        return false;
+    }
+
+    // Open fetch sessions and start fetch threads
+    std::vector<FetchThread> threads;
+    int n = m_fetch_sessions;
+    if ( (size_t)n > q.rpt.size() ) {
+        n = q.rpt.size();
+    }
+    threads.reserve( n );
+    q.states.assign( q.rpt.size(), FetchPending );
+    q.next  = 0;
+    q.limit = n * FetchAhead;
+    q.lock  = wrap_g_mutex_new_init();
+    q.cond  = wrap_g_cond_new_init();
+    for ( int i = 0; i < n; ++i ) {
+        FetchThread ft;
+        ft.queue  = &q;
+        ft.thread = 0;
+        SaErrorT rv = ohc_session_open_by_option( &m_copt, &ft.sid );
+        if ( rv != SA_OK ) {
+            break;
+        }
+        threads.push_back( ft );
+    }
+    for ( size_t i = 0; i < threads.size(); ++i ) {
+        threads[i].thread = wrap_g_thread_create_new( "hpixml",
+                                                      FetchThreadFunc,
+                                                      &threads[i],
+                                                      TRUE,
+                                                      0 );
+        if ( !threads[i].thread ) {
+            CRIT( "cannot create fetch thread" );
+        }
+    }
+
+    writer.BeginRptNode( di );
+    for ( size_t i = 0; i < q.rpt.size(); ++i ) {
+        FetchState state;
+
+        wrap_g_mutex_lock( q.lock );
+        if ( ( q.states[i] == FetchPending ) && ( q.next <= i ) ) {
+            // No fetch thread took it, fetch over the main session
+            ++q.next;
+            wrap_g_mutex_unlock( q.lock );
+            state = FetchResource( m_sid, q.rpt[i] ) ? FetchDone : FetchFailed;
+        } else {
+            if ( q.states[i] == FetchPending ) {
+                // Let the reader have the output while waiting
+                wrap_g_mutex_unlock( q.lock );
+                writer.Flush();
+                wrap_g_mutex_lock( q.lock );
+            }
+            while ( q.states[i] == FetchPending ) {
+                g_cond_wait( q.cond, q.lock );
+            }
+            state = q.states[i];
+            wrap_g_mutex_unlock( q.lock );
+        }
+
+        // A resource that failed to fetch has likely gone away
+        if ( state == FetchDone ) {
+            DumpResource( writer, q.rpt[i] );
+        }
+        q.rpt[i].instruments.clear();
+        q.rpt[i].log.entries.clear();
+
+        wrap_g_mutex_lock( q.lock );
+        q.limit = i + 1 + threads.size() * FetchAhead;
+        g_cond_broadcast( q.cond );
+        wrap_g_mutex_unlock( q.lock );
+    }
+    writer.EndRptNode();
+
+    for ( size_t i = 0; i < threads.size(); ++i ) {
+        if ( threads[i].thread ) {
+            g_thread_join( threads[i].thread );
+        }
+        saHpiSessionClose( threads[i].sid );
+    }
+    wrap_g_cond_free( q.cond );
+    wrap_g_mutex_free_clear( q.lock );
+
+    return true;
+}
+
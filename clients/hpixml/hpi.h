@@ -29,7 +29,7 @@ class cHpi
 {
 public:
 
-    explicit cHpi( oHpiCommonOptionsT copt );
+    explicit cHpi( oHpiCommonOptionsT copt, int fetch_sessions = 0 );
     ~cHpi();
 
     bool Open();
@@ -42,12 +42,15 @@ private:
     cHpi( const cHpi& );
     cHpi& operator =( const cHpi& );
 
+    bool DumpRpt( cHpiXmlWriter& writer );
+
 private:
 
     bool            m_initialized;
     bool            m_opened;
     oHpiCommonOptionsT m_copt;
     SaHpiSessionIdT m_sid;
+    int             m_fetch_sessions;
 };
 
 
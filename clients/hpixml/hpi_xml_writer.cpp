@@ -571,11 +571,28 @@ static Flags::Names NamesSaHpiEventLogCapabilitiesT =
 /***************************************************
  * class cHpiXmlWriter
  ***************************************************/
-cHpiXmlWriter::cHpiXmlWriter( int indent_step, bool use_names )
+/****************************
+ * Nodes that repeat within their parent
+ ***************************/
+static const char * const ListNodes[] =
+{
+    "Reference",
+    "Resource",
+    "Instrument",
+    "Entry",
+    "Alarm",
+    0
+};
+
+cHpiXmlWriter::cHpiXmlWriter( int indent_step,
+                              bool use_names,
+                              Format format )
     : cXmlWriter( "http://openhpi.org/SAI-HPI-B.03.02",
                   "http://openhpi.org hpixml.xsd",
                   indent_step,
-                  use_names )
+                  use_names,
+                  format,
+                  ListNodes )
 {
     // empty
 }
@@ -590,6 +607,11 @@ void cHpiXmlWriter::End( void )
     cXmlWriter::End( "HPI" );
 }
 
+void cHpiXmlWriter::Flush( void )
+{
+    cXmlWriter::Flush();
+}
+
 void cHpiXmlWriter::VersionNode( const SaHpiVersionT& ver )
 {
     NodeSaHpiVersionT( "Version", ver );
@@ -767,14 +789,14 @@ void cHpiXmlWriter::NodeSaHpiUint32T(
     const char * name,
     const SaHpiUint32T& x )
 {
-    cXmlWriter::Node( name, "%u", x );
+    cXmlWriter::NodeNumber( name, "%u", x );
 }
 
 void cHpiXmlWriter::NodeSaHpiUint64T(
     const char * name,
     const SaHpiUint64T& x )
 {
-    cXmlWriter::Node( name, "%llu", x );
+    cXmlWriter::NodeNumber( name, "%llu", x );
 }
 
 void cHpiXmlWriter::NodeSaHpiInt8T(
@@ -795,21 +817,21 @@ void cHpiXmlWriter::NodeSaHpiInt32T(
     const char * name,
     const SaHpiInt32T& x )
 {
-    cXmlWriter::Node( name, "%d", x );
+    cXmlWriter::NodeNumber( name, "%d", x );
 }
 
 void cHpiXmlWriter::NodeSaHpiInt64T(
     const char * name,
     const SaHpiInt64T& x )
 {
-    cXmlWriter::Node( name, "%lld", x );
+    cXmlWriter::NodeNumber( name, "%lld", x );
 }
 
 void cHpiXmlWriter::NodeSaHpiFloat64T(
     const char * name,
     const SaHpiFloat64T& x )
 {
-    cXmlWriter::Node( name, "%f", x );
+    cXmlWriter::NodeNumber( name, "%f", x );
 }
 
 
@@ -820,7 +842,7 @@ void cHpiXmlWriter::NodeSaHpiBoolT(
     const char * name,
     const SaHpiBoolT& x )
 {
-    cXmlWriter::Node( name, "%s", ( x == SAHPI_FALSE ) ? "false" : "true" );
+    cXmlWriter::NodeBool( name, x != SAHPI_FALSE );
 }
 
 void cHpiXmlWriter::NodeSaHpiManufacturerIdT(
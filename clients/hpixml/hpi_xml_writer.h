@@ -28,11 +28,19 @@ class cHpiXmlWriter : private cXmlWriter
 {
 public:
 
-    explicit cHpiXmlWriter( int indent_step, bool use_names );
+    using cXmlWriter::Format;
+    using cXmlWriter::FormatXml;
+    using cXmlWriter::FormatJson;
+
+    explicit cHpiXmlWriter( int indent_step,
+                            bool use_names,
+                            Format format = FormatXml );
 
     void Begin( void );
     void End( void );
 
+    void Flush( void );
+
     void VersionNode( const SaHpiVersionT& ver );
 
     void BeginDomainNode( const SaHpiDomainInfoT& di );
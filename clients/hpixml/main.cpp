@@ -25,6 +25,7 @@
 #include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <oh_error.h>
 
@@ -36,13 +37,18 @@
 static gboolean f_indent    = FALSE;
 static gboolean f_xsd       = FALSE;
 static gboolean f_use_names = FALSE;
+static gchar *   format      = NULL;
+static gint      sessions    = 4;
 static oHpiCommonOptionsT copt;
 
 static GOptionEntry my_options[] =
 {
-  { "indent", 'i', 0, G_OPTION_ARG_NONE, &f_indent,    "Use indentation",                                    NULL },
-  { "text",   't', 0, G_OPTION_ARG_NONE, &f_use_names, "Use enum and flag text names instead of raw values", NULL },
-  { "xsd",    's', 0, G_OPTION_ARG_NONE, &f_xsd,       "Show XML schema",                                    NULL },
+  { "indent",   'i', 0, G_OPTION_ARG_NONE,   &f_indent,    "Use indentation",                                    NULL },
+  { "text",     't', 0, G_OPTION_ARG_NONE,   &f_use_names, "Use enum and flag text names instead of raw values", NULL },
+  { "xsd",      's', 0, G_OPTION_ARG_NONE,   &f_xsd,       "Show XML schema",                                    NULL },
+  { "format",   'f', 0, G_OPTION_ARG_STRING, &format,      "Output format: xml or json (default xml)",           "fmt" },
+  { "sessions", 'p', 0, G_OPTION_ARG_INT,    &sessions,    "Number of sessions fetching resources in parallel\n"
+"                            (default 4, 0: fetch over the main session)",                    "n" },
  { NULL }
 };
 
@@ -56,9 +62,9 @@ int main( int argc, char * argv[] )
 
     GOptionContext *context;
 	    
-    context = g_option_context_new ("- Display system view in XML");
+    context = g_option_context_new ("- Display system view in XML or JSON");
     /* Parsing options */
-    static char usetext[]="- Display system view in XML.\n  "
+    static char usetext[]="- Display system view in XML or JSON.\n  "
                           OH_SVN_REV; 
     OHC_PREPARE_REVISION(usetext);
 
@@ -77,6 +83,20 @@ int main( int argc, char * argv[] )
         g_option_context_free (context);
     if (f_indent) indent_step = 1;
 
+    cHpiXmlWriter::Format fmt = cHpiXmlWriter::FormatXml;
+    if ( format ) {
+        if ( strcmp( format, "json" ) == 0 ) {
+            fmt = cHpiXmlWriter::FormatJson;
+        } else if ( strcmp( format, "xml" ) != 0 ) {
+            CRIT( "unknown format %s", format );
+            return 1;
+        }
+    }
+    if ( sessions < 0 ) {
+        CRIT( "number of sessions must not be negative" );
+        return 1;
+    }
+
     if ( f_xsd ) {
         for ( char * p = &schema_begin; p < &schema_end; ++p ) {
             fwrite( p, 1, 1, stdout );
@@ -86,15 +106,15 @@ int main( int argc, char * argv[] )
 
     bool rc;
 
-    cHpi hpi( copt );
+    cHpi hpi( copt, sessions );
     rc = hpi.Open();
     if ( !rc ) {
         return 1;
     }
-    cHpiXmlWriter writer( indent_step, f_use_names );
+    cHpiXmlWriter writer( indent_step, f_use_names, fmt );
     rc = hpi.Dump( writer );
     if ( !rc ) {
-        CRIT( "Failed to produce XML" );
+        CRIT( "Failed to produce %s", ( fmt == cHpiXmlWriter::FormatJson ) ? "JSON" : "XML" );
         return 1;
     }
 
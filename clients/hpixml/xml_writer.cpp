@@ -16,67 +16,124 @@
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
+
+#include <glib.h>
 
 #include "xml_writer.h"
 
 
+/***************************************************
+ * Output is written to stdout when the buffer grows over this size
+ ***************************************************/
+static const size_t FlushSize = 64 * 1024;
+
+
 /***************************************************
  * class cXmlWriter
  ***************************************************/
 cXmlWriter::cXmlWriter( const char * ns,
                         const char * schema_location,
                         int indent_step,
-                        bool use_names )
+                        bool use_names,
+                        Format format,
+                        const char * const * list_nodes )
     : m_ns( ns ),
       m_schema_location( schema_location ),
       m_indent( 0 ),
       m_indent_step( indent_step ),
-      m_use_names( use_names )
+      m_use_names( use_names ),
+      m_format( format ),
+      m_list_nodes( list_nodes )
 {
-    // empty
+    m_buf.reserve( FlushSize + 4096 );
+}
+
+cXmlWriter::~cXmlWriter()
+{
+    Flush();
 }
 
 void cXmlWriter::Begin( const char * name )
 {
-    printf( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
-    PrintIndent();
-    printf( "<%s"
-            " xmlns=\"%s\""
-            " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\""
-            " xsi:schemaLocation=\"%s\""
-            ">\n",
-            name,
-            m_ns.c_str(),
-            m_schema_location.c_str() );
+    if ( m_format == FormatJson ) {
+        Write( "{" );
+        BeginJsonLevel( 0 );
+        BeginNode( name );
+        return;
+    }
+
+    Write( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" );
+    WriteIndent();
+    Write( "<" );
+    Write( name );
+    Write( " xmlns=\"" );
+    Write( m_ns.c_str() );
+    Write( "\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"" );
+    Write( " xsi:schemaLocation=\"" );
+    Write( m_schema_location.c_str() );
+    Write( "\">\n" );
     m_indent += m_indent_step;
 }
 
 void cXmlWriter::End( const char * name )
 {
     EndNode( name );
+    if ( m_format == FormatJson ) {
+        EndJsonLevel();
+        Write( "\n" );
+    }
+    Flush();
+    fflush( stdout );
+}
+
+void cXmlWriter::Flush( void )
+{
+    if ( !m_buf.empty() ) {
+        fwrite( m_buf.data(), 1, m_buf.size(), stdout );
+        m_buf.clear();
+    }
 }
 
 void cXmlWriter::Node( const char * name, const char * format, ... )
 {
-    PrintIndent();
-    printf( "<%s>", name );
     va_list ap;
     va_start( ap, format );
-    vprintf( format, ap );
+    WriteValue( name, true, format, ap );
     va_end( ap );
-    printf( "</%s>\n", name );
+}
+
+void cXmlWriter::NodeNumber( const char * name, const char * format, ... )
+{
+    va_list ap;
+    va_start( ap, format );
+    WriteValue( name, false, format, ap );
+    va_end( ap );
+}
+
+void cXmlWriter::NodeBool( const char * name, bool value )
+{
+    if ( m_format == FormatJson ) {
+        BeginJsonMember( name );
+        Write( value ? "true" : "false" );
+    } else {
+        Node( name, "%s", value ? "true" : "false" );
+    }
 }
 
 void cXmlWriter::NodeHex( const char * name, const uint8_t * data, size_t len )
 {
-    PrintIndent();
-    printf( "<%s>", name );
+    static const char digits[] = "0123456789ABCDEF";
+
+    std::string s;
     if ( data ) {
+        s.reserve( len * 2 );
         for ( size_t i = 0; i < len; ++i ) {
-            printf( "%02X", data[i] );
+            s.push_back( digits[data[i] >> 4] );
+            s.push_back( digits[data[i] & 0x0F] );
         }
     }
-    printf( "</%s>\n", name );
+    Node( name, "%s", s.c_str() );
 }
 
 void cXmlWriter::NodeFlags( const char * name,
@@ -84,51 +141,219 @@ void cXmlWriter::NodeFlags( const char * name,
                             const Flags::Names * flag_names )
 {
     if ( ( !m_use_names ) || ( !flag_names ) ) {
-        Node( name, "%lu", (unsigned long)flags );
+        NodeNumber( name, "%lu", (unsigned long)flags );
         return;
     }
 
-    PrintIndent();
-    printf( "<%s>", name );
+    std::string s;
+    char raw[32];
     uint8_t i;
-    bool first = true;
     for ( i = 0; i < Flags::Num; ++i ) {
         Flags::Type flag = 1 << i;
         if ( flags & flag ) {
-            if ( !first ) {
-                printf( " " );
+            if ( !s.empty() ) {
+                s.push_back( ' ' );
             }
             const char * flag_name = (*flag_names)[i];
             if ( flag_name ) {
-                printf( "%s", flag_name );
+                s.append( flag_name );
             } else {
-                printf( "%lu", (unsigned long)flag );
+                snprintf( raw, sizeof(raw), "%lu", (unsigned long)flag );
+                s.append( raw );
             }
-            first = false;
         }
     }
-    printf( "</%s>\n", name );
+    Node( name, "%s", s.c_str() );
 }
 
 
 void cXmlWriter::BeginNode( const char * name )
 {
-    PrintIndent();
-    printf( "<%s>\n", name );
+    if ( m_format == FormatJson ) {
+        BeginJsonMember( name );
+        Write( "{" );
+        BeginJsonLevel( 0 );
+        return;
+    }
+
+    WriteIndent();
+    Write( "<" );
+    Write( name );
+    Write( ">\n" );
     m_indent += m_indent_step;
 }
 
 void cXmlWriter::EndNode( const char * name )
 {
+    if ( m_format == FormatJson ) {
+        // Close the array of list nodes left open by the last child
+        if ( m_levels.back().list ) {
+            EndJsonLevel();
+        }
+        EndJsonLevel();
+        return;
+    }
+
     m_indent -= m_indent_step;
-    PrintIndent();
-    printf( "</%s>\n", name );
+    WriteIndent();
+    Write( "</" );
+    Write( name );
+    Write( ">\n" );
+}
+
+void cXmlWriter::Write( const char * s, size_t len )
+{
+    m_buf.append( s, len );
+    if ( m_buf.size() >= FlushSize ) {
+        Flush();
+    }
+}
+
+void cXmlWriter::Write( const char * s )
+{
+    Write( s, strlen( s ) );
 }
 
-void cXmlWriter::PrintIndent( void )
+void cXmlWriter::WriteIndent( void )
 {
-    for ( int i = 0; i < m_indent; ++i ) {
-        putc( ' ', stdout );
+    if ( m_indent > 0 ) {
+        m_buf.append( m_indent, ' ' );
+    }
+}
+
+void cXmlWriter::WriteValue( const char * name,
+                             bool quote,
+                             const char * format,
+                             va_list ap )
+{
+    char buf[512];
+    char * value = buf;
+    va_list ap2;
+
+    G_VA_COPY( ap2, ap );
+    int len = vsnprintf( buf, sizeof(buf), format, ap );
+    if ( len < 0 ) {
+        len = 0;
+        buf[0] = '\0';
+    } else if ( (size_t)len >= sizeof(buf) ) {
+        value = g_strdup_vprintf( format, ap2 );
+    }
+    va_end( ap2 );
+
+    if ( m_format == FormatJson ) {
+        BeginJsonMember( name );
+        // Values like nan or inf are not JSON numbers
+        bool number = ( value[0] == '-' ) ? g_ascii_isdigit( value[1] )
+                                          : g_ascii_isdigit( value[0] );
+        if ( quote || !number ) {
+            WriteJsonString( value, len );
+        } else {
+            Write( value, len );
+        }
+    } else {
+        WriteIndent();
+        Write( "<" );
+        Write( name );
+        Write( ">" );
+        Write( value, len );
+        Write( "</" );
+        Write( name );
+        Write( ">\n" );
+    }
+
+    if ( value != buf ) {
+        g_free( value );
+    }
+}
+
+void cXmlWriter::WriteJsonString( const char * s, size_t len )
+{
+    static const char digits[] = "0123456789abcdef";
+
+    m_buf.push_back( '"' );
+    for ( size_t i = 0; i < len; ++i ) {
+        unsigned char c = s[i];
+        if ( c == '"' || c == '\\' ) {
+            m_buf.push_back( '\\' );
+            m_buf.push_back( c );
+        } else if ( c == '\n' ) {
+            m_buf.append( "\\n" );
+        } else if ( c == '\t' ) {
+            m_buf.append( "\\t" );
+        } else if ( c < 0x20 ) {
+            m_buf.append( "\\u00" );
+            m_buf.push_back( digits[c >> 4] );
+            m_buf.push_back( digits[c & 0x0F] );
+        } else {
+            m_buf.push_back( c );
+        }
+    }
+    Write( "\"" );
+}
+
+bool cXmlWriter::IsListNode( const char * name ) const
+{
+    if ( m_list_nodes ) {
+        for ( const char * const * p = m_list_nodes; *p; ++p ) {
+            if ( strcmp( *p, name ) == 0 ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void cXmlWriter::BeginJsonMember( const char * name )
+{
+    bool list = ( name != 0 ) && IsListNode( name );
+
+    // A node that does not continue the current array closes it
+    const char * open_list = m_levels.back().list;
+    if ( open_list && ( ( !list ) || strcmp( open_list, name ) != 0 ) ) {
+        EndJsonLevel();
+    }
+
+    if ( list && !m_levels.back().list ) {
+        BeginJsonMember( 0 );
+        Write( "\"" );
+        Write( name );
+        Write( "\": [" );
+        BeginJsonLevel( name );
+    }
+
+    Level& level = m_levels.back();
+    if ( !level.first ) {
+        m_buf.push_back( ',' );
+    }
+    level.first = false;
+    m_buf.push_back( '\n' );
+    WriteIndent();
+    if ( name && !list ) {
+        Write( "\"" );
+        Write( name );
+        Write( "\": " );
+    }
+}
+
+void cXmlWriter::BeginJsonLevel( const char * list )
+{
+    Level level;
+    level.first = true;
+    level.list = list;
+    m_levels.push_back( level );
+    m_indent += m_indent_step;
+}
+
+void cXmlWriter::EndJsonLevel( void )
+{
+    bool empty = m_levels.back().first;
+    bool list = ( m_levels.back().list != 0 );
+    m_levels.pop_back();
+    m_indent -= m_indent_step;
+    if ( !empty ) {
+        m_buf.push_back( '\n' );
+        WriteIndent();
     }
+    Write( list ? "]" : "}" );
 }
 
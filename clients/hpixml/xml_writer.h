@@ -16,30 +16,52 @@
 #ifndef XML_WRITER_H_EC5AF80F_A79B_49D7_8371_F71504C426A6
 #define XML_WRITER_H_EC5AF80F_A79B_49D7_8371_F71504C426A6
 
+#include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include <string>
+#include <vector>
 
 #include "flags.h"
 
 
 /***************************************************
  * class cXmlWriter
+ *
+ * Writes the node tree to stdout as XML or as JSON.
+ * Output is collected in a buffer and written out in large chunks.
+ *
+ * In JSON every node becomes an object member.
+ * Nodes listed in list_nodes may repeat within their parent,
+ * consecutive ones are written as one array member.
  ***************************************************/
 class cXmlWriter
 {
 public:
 
+    enum Format
+    {
+        FormatXml,
+        FormatJson
+    };
+
     explicit cXmlWriter( const char * ns,
                          const char * schema_location,
                          int indent_step,
-                         bool use_names );
+                         bool use_names,
+                         Format format = FormatXml,
+                         const char * const * list_nodes = 0 );
+    ~cXmlWriter();
 
     void Begin( const char * name );
     void End( const char * name );
 
+    void Flush( void );
+
     void Node( const char * name, const char * format, ... );
+    void NodeNumber( const char * name, const char * format, ... );
+    void NodeBool( const char * name, bool value );
 
     void NodeHex( const char * name, const uint8_t * data, size_t len );
 
@@ -55,7 +77,7 @@ public:
         if ( value_name ) {
             Node( name, "%s", value_name );
         } else {
-            Node( name, "%d", (int)value );
+            NodeNumber( name, "%d", (int)value );
         }
     }
 
@@ -71,7 +93,25 @@ private:
     cXmlWriter( const cXmlWriter& );
     cXmlWriter& operator =( const cXmlWriter& );
 
-    void PrintIndent( void );
+    struct Level
+    {
+        bool first;
+        const char * list;  // name of list nodes for an array, 0 for an object
+    };
+
+    void Write( const char * s, size_t len );
+    void Write( const char * s );
+    void WriteIndent( void );
+    void WriteValue( const char * name,
+                     bool quote,
+                     const char * format,
+                     va_list ap );
+    void WriteJsonString( const char * s, size_t len );
+
+    bool IsListNode( const char * name ) const;
+    void BeginJsonMember( const char * name );
+    void BeginJsonLevel( const char * list );
+    void EndJsonLevel( void );
 
 private:
 
@@ -80,6 +120,10 @@ private:
     int m_indent;
     int m_indent_step;
     bool m_use_names;
+    Format m_format;
+    const char * const * m_list_nodes;
+    std::vector<Level> m_levels;
+    std::string m_buf;
 };
 
 
@@ -334,6 +334,7 @@ static
 SaErrorT exechandlerinfo(oHpiHandlerIdT handlerid)
 {
    oHpiHandlerInfoT handlerinfo;
+   oHpiHandlerStatusT handlerstatus;
    SaErrorT rv = SA_OK;
    GHashTable *handlerconfig = g_hash_table_new_full(
                         g_str_hash, g_str_equal,
@@ -367,6 +368,19 @@ SaErrorT exechandlerinfo(oHpiHandlerIdT handlerid)
 
    printf("Failed attempts to load handler: %u\n",handlerinfo.load_failed);
 
+   /* Older daemons do not have oHpiHandlerStatusGet */
+   if (oHpiHandlerStatusGet(sessionid, handlerid, &handlerstatus) == SA_OK) {
+      printf("Handler state: %s\n",
+             handlerstatus.State == OHPI_HANDLER_READY ? "ready" :
+             handlerstatus.State == OHPI_HANDLER_STALE ? "stale" :
+             handlerstatus.State == OHPI_HANDLER_OPENING ? "opening" : "failed");
+      if (handlerstatus.SnapshotResources != 0) {
+         printf("Resources from snapshot: %u, not rediscovered yet: %u\n",
+                handlerstatus.SnapshotResources,
+                handlerstatus.StaleResources);
+      }
+   }
+
    printf("\nHandler configuration:\n");
    printf ("   plugin %s\n", (const char *)handlerinfo.plugin_name);
    printf ("   entity_root \"%s\"\n",(const char *) g_hash_table_lookup(handlerconfig, "entity_root")); 
@@ -0,0 +1,314 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Log:
+ *     Displays the metrics of the openhpi daemon read with
+ *     oHpiMetricGet(): RPC and plugin ABI latencies, lock waits,
+ *     queue lengths and counters. With --interval it refreshes
+ *     the view and shows the activity of each interval.
+ */
+
+#include <unistd.h>
+
+#include "oh_clients.h"
+
+#define OH_SVN_REV "$Revision$"
+
+#define NSEC_PER_USEC 1000ULL
+
+static gint interval = 0;
+static gint count = 0;
+static gint top = 25;
+static gboolean show_all = FALSE;
+static oHpiCommonOptionsT copt;
+
+static GOptionEntry my_options[] =
+{
+  { "interval", 'i', 0, G_OPTION_ARG_INT, &interval, "Refresh every n seconds and show the activity\n"
+"                               of the interval (default: totals, once)",    "n" },
+  { "count",    'c', 0, G_OPTION_ARG_INT, &count,    "Stop after n refreshes",                       "n" },
+  { "top",      't', 0, G_OPTION_ARG_INT, &top,      "Show the n busiest latency metrics (default 25)", "n" },
+  { "all",      'a', 0, G_OPTION_ARG_NONE, &show_all, "Also show metrics without activity",          NULL },
+  { NULL }
+};
+
+static const char *type_names[] = {
+        "rpc", "abi", "lock", "task", "queue", "counter"
+};
+
+
+/*
+ * Reads all metrics, the index in the array is the EntryId
+ */
+static SaErrorT read_metrics(SaHpiSessionIdT sid, GArray *metrics)
+{
+        SaErrorT rv;
+        SaHpiEntryIdT id, next_id;
+        oHpiMetricT m;
+
+        g_array_set_size(metrics, 0);
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                rv = oHpiMetricGet(sid, id, &next_id, &m);
+                if (rv != SA_OK) {
+                        CRIT("oHpiMetricGet returned %s", oh_lookup_error(rv));
+                        return rv;
+                }
+                g_array_append_val(metrics, m);
+        }
+
+        return SA_OK;
+}
+
+/*
+ * The activity since the previous reading. Max cannot be
+ * subtracted, it stays the largest sample so far.
+ */
+static void diff_metric(oHpiMetricT *d, const oHpiMetricT *cur,
+                        const oHpiMetricT *prev)
+{
+        int i;
+
+        *d = *cur;
+        if (!prev) {
+                return;
+        }
+        d->Count -= prev->Count;
+        d->Sum -= prev->Sum;
+        for (i = 0; i < OHPI_METRIC_BUCKETS; ++i) {
+                d->Buckets[i] -= prev->Buckets[i];
+        }
+}
+
+/*
+ * Upper bound of the bucket holding the given fraction of the samples,
+ * in bucket units
+ */
+static SaHpiUint64T percentile(const oHpiMetricT *m, double fraction)
+{
+        SaHpiUint64T n = 0, want;
+        int i;
+
+        if (m->Count == 0) {
+                return 0;
+        }
+        want = (SaHpiUint64T)(fraction * m->Count + 0.5);
+        if (want == 0) {
+                want = 1;
+        }
+        for (i = 0; i < OHPI_METRIC_BUCKETS; ++i) {
+                n += m->Buckets[i];
+                if (n >= want) {
+                        break;
+                }
+        }
+        if (i >= OHPI_METRIC_BUCKETS) {
+                i = OHPI_METRIC_BUCKETS - 1;
+        }
+
+        return (SaHpiUint64T)1 << i;
+}
+
+static void format_time(char *buf, size_t size, SaHpiUint64T ns)
+{
+        if (ns < 10000ULL) {
+                snprintf(buf, size, "%uns", (unsigned int)ns);
+        } else if (ns < 10000000ULL) {
+                snprintf(buf, size, "%.1fus", ns / 1e3);
+        } else if (ns < 10000000000ULL) {
+                snprintf(buf, size, "%.1fms", ns / 1e6);
+        } else {
+                snprintf(buf, size, "%.1fs", ns / 1e9);
+        }
+}
+
+static const char *metric_name(const oHpiMetricT *m, char *buf, size_t size)
+{
+        if (m->Type == OHPI_METRIC_ABI) {
+                snprintf(buf, size, "%u:%s", m->HandlerId,
+                         (const char *)m->Name.Data);
+        } else {
+                snprintf(buf, size, "%s", (const char *)m->Name.Data);
+        }
+
+        return buf;
+}
+
+static gint by_time(gconstpointer a, gconstpointer b)
+{
+        const oHpiMetricT *ma = (const oHpiMetricT *)a;
+        const oHpiMetricT *mb = (const oHpiMetricT *)b;
+
+        if (ma->Sum != mb->Sum) {
+                return (ma->Sum < mb->Sum) ? 1 : -1;
+        }
+        return (ma->Count < mb->Count) ? 1 : (ma->Count > mb->Count) ? -1 : 0;
+}
+
+static void format_rate(char *buf, size_t size, SaHpiUint64T n, double seconds)
+{
+        if (seconds > 0) {
+                snprintf(buf, size, "%.1f", n / seconds);
+        } else {
+                snprintf(buf, size, "-");
+        }
+}
+
+/*
+ * With seconds == 0 the totals are shown without rates
+ */
+static void print_metrics(GArray *cur, GArray *prev, double seconds)
+{
+        GArray *lat = g_array_new(FALSE, FALSE, sizeof(oHpiMetricT));
+        GArray *other = g_array_new(FALSE, FALSE, sizeof(oHpiMetricT));
+        char name[64], rate[16], avg[16], p50[16], p99[16], max[16];
+        oHpiMetricT d;
+        guint i;
+
+        for (i = 0; i < cur->len; ++i) {
+                const oHpiMetricT *p = NULL;
+                if (prev && (i < prev->len)) {
+                        p = &g_array_index(prev, oHpiMetricT, i);
+                }
+                diff_metric(&d, &g_array_index(cur, oHpiMetricT, i), p);
+                if ((d.Count == 0) && !show_all && (d.Type != OHPI_METRIC_QUEUE)) {
+                        continue;
+                }
+                if (d.Type <= OHPI_METRIC_TASK) {
+                        g_array_append_val(lat, d);
+                } else {
+                        g_array_append_val(other, d);
+                }
+        }
+        g_array_sort(lat, by_time);
+
+        printf("%-7s %-36s %10s %9s %9s %9s %9s %9s\n",
+               "TYPE", "NAME", "COUNT", "RATE/s", "AVG", "P50", "P99", "MAX");
+        for (i = 0; (i < lat->len) && ((top <= 0) || (i < (guint)top)); ++i) {
+                oHpiMetricT *m = &g_array_index(lat, oHpiMetricT, i);
+                format_time(avg, sizeof(avg), m->Count ? m->Sum / m->Count : 0);
+                format_time(p50, sizeof(p50),
+                            percentile(m, 0.50) * NSEC_PER_USEC);
+                format_time(p99, sizeof(p99),
+                            percentile(m, 0.99) * NSEC_PER_USEC);
+                format_time(max, sizeof(max), m->Max);
+                format_rate(rate, sizeof(rate), m->Count, seconds);
+                printf("%-7s %-36.36s %10" PRIu64 " %9s %9s %9s %9s %9s\n",
+                       type_names[m->Type], metric_name(m, name, sizeof(name)),
+                       (uint64_t)m->Count, rate,
+                       m->Count ? avg : "-", m->Count ? p50 : "-",
+                       m->Count ? p99 : "-", max);
+        }
+
+        printf("\n%-7s %-36s %10s %9s %9s %9s %9s\n",
+               "TYPE", "NAME", "COUNT", "RATE/s", "NOW", "AVG", "MAX");
+        for (i = 0; i < other->len; ++i) {
+                oHpiMetricT *m = &g_array_index(other, oHpiMetricT, i);
+                format_rate(rate, sizeof(rate), m->Count, seconds);
+                if (m->Type == OHPI_METRIC_QUEUE) {
+                        printf("%-7s %-36.36s %10" PRIu64 " %9s %9u %9.1f %9" PRIu64 "\n",
+                               type_names[m->Type], metric_name(m, name, sizeof(name)),
+                               (uint64_t)m->Count, rate, m->Current,
+                               m->Count ? (double)m->Sum / m->Count : 0.0,
+                               (uint64_t)m->Max);
+                } else {
+                        printf("%-7s %-36.36s %10" PRIu64 " %9s\n",
+                               "counter", metric_name(m, name, sizeof(name)),
+                               (uint64_t)m->Count, rate);
+                }
+        }
+
+        g_array_free(lat, TRUE);
+        g_array_free(other, TRUE);
+}
+
+static double now_seconds(void)
+{
+        GTimeVal tv;
+
+        g_get_current_time(&tv);
+        return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+int main(int argc, char **argv)
+{
+        SaErrorT rv;
+        SaHpiSessionIdT sessionid;
+        GOptionContext *context;
+        GArray *cur, *prev, *tmp;
+        double t_prev, t_cur;
+        gint n;
+
+        /* Print version strings */
+        oh_prog_version(argv[0]);
+
+        /* Parsing options */
+        static char usetext[]="- Display the metrics of the openhpi daemon\n  "
+                              OH_SVN_REV;
+        OHC_PREPARE_REVISION(usetext);
+        context = g_option_context_new (usetext);
+        g_option_context_add_main_entries (context, my_options, NULL);
+
+        if (!ohc_option_parse(&argc, argv,
+                context, &copt,
+                OHC_ALL_OPTIONS
+                    - OHC_ENTITY_PATH_OPTION  // not applicable
+                    - OHC_VERBOSE_OPTION )) { // no verbose mode
+                g_option_context_free (context);
+                return 1;
+        }
+        g_option_context_free (context);
+
+        if (interval < 0 || count < 0) {
+                CRIT("interval and count must not be negative");
+                return 1;
+        }
+
+        rv = ohc_session_open_by_option ( &copt, &sessionid);
+        if (rv != SA_OK) return -1;
+
+        cur = g_array_new(FALSE, FALSE, sizeof(oHpiMetricT));
+        prev = g_array_new(FALSE, FALSE, sizeof(oHpiMetricT));
+
+        /* Once: totals since the daemon started */
+        rv = read_metrics(sessionid, prev);
+        t_prev = now_seconds();
+        if ((rv == SA_OK) && (interval == 0)) {
+                print_metrics(prev, NULL, 0);
+        }
+
+        for (n = 0; (rv == SA_OK) && (interval > 0) &&
+                    ((count == 0) || (n < count)); ++n) {
+                g_usleep((gulong)interval * G_USEC_PER_SEC);
+                rv = read_metrics(sessionid, cur);
+                if (rv != SA_OK) {
+                        break;
+                }
+                t_cur = now_seconds();
+                if (isatty(STDOUT_FILENO)) {
+                        printf("\033[H\033[2J");
+                }
+                printf("openhpid metrics, last %.1f seconds\n\n", t_cur - t_prev);
+                print_metrics(cur, prev, t_cur - t_prev);
+                printf("\n");
+                fflush(stdout);
+
+                tmp = prev;
+                prev = cur;
+                cur = tmp;
+                t_prev = t_cur;
+        }
+
+        g_array_free(cur, TRUE);
+        g_array_free(prev, TRUE);
+        saHpiSessionClose(sessionid);
+
+        return (rv == SA_OK) ? 0 : rv;
+}
+
+/* end ohmetrics.c */
@@ -36,6 +36,14 @@
 #define OH_SAHPI_INTERFACE_VERSION_MAX_SUPPORTED SAHPI_INTERFACE_VERSION
 
 #define OH_PATH_PARAM_MAX_LENGTH 2048
+#define OH_MAX_SENSOR_READINGS 64
+#define OH_MAX_SENSOR_SAMPLES 256
+#define OH_MAX_EVENTS_GET 256
+#define OH_MAX_FILTER_RESOURCES 32
+#define OH_MAX_FILTER_SENSOR_TYPES 16
+#define OH_MAX_EVENT_LOG_ENTRIES_GET 256
+#define OH_MAX_IDR_AREAS_GET 64
+#define OH_MAX_IDR_FIELDS_GET 256
 
 #ifdef __cplusplus
 extern "C" {
@@ -104,6 +112,110 @@ typedef struct {
 } oHpiGlobalParamT;
 
 
+typedef struct {
+    SaHpiUint64T Hits;          /* Readings returned from the cache */
+    SaHpiUint64T Misses;        /* Readings that needed a plugin call */
+    SaHpiUint64T Coalesced;     /* Readings shared with a concurrent plugin call */
+    SaHpiUint64T Invalidations; /* Cached readings dropped because of events */
+    SaHpiUint32T Entries;       /* Sensors known to the cache */
+} oHpiSensorCacheStatsT;
+
+
+typedef struct {
+    SaHpiSensorNumT Num;          /* [in] Sensor number */
+    SaErrorT Result;              /* [out] saHpiSensorReadingGet result */
+    SaHpiSensorReadingT Reading;  /* [out] Valid if Result is SA_OK */
+    SaHpiEventStateT EventState;  /* [out] Valid if Result is SA_OK */
+} oHpiSensorReadingT;
+
+typedef struct {
+    SaHpiUint32T NumberOfReadings;
+    oHpiSensorReadingT Readings[OH_MAX_SENSOR_READINGS];
+} oHpiSensorReadingsT;
+
+
+typedef struct {
+    SaHpiTimeT Timestamp;
+    SaHpiFloat64T Value;
+} oHpiSensorSampleT;
+
+typedef struct {
+    SaHpiUint32T Count;           /* Samples in the requested window */
+    SaHpiFloat64T Min;            /* Aggregates of all samples in the window */
+    SaHpiFloat64T Max;
+    SaHpiFloat64T Avg;
+    SaHpiUint32T NumberOfSamples; /* Samples returned, the newest ones */
+    oHpiSensorSampleT Samples[OH_MAX_SENSOR_SAMPLES];
+} oHpiSensorHistoryT;
+
+/* Bit for an event type in oHpiEventFilterT.EventTypes */
+#define OH_EVENT_TYPE_BIT(t) ((SaHpiUint32T)1 << (t))
+
+typedef struct {
+    SaHpiUint32T EventTypes;          /* OH_EVENT_TYPE_BIT mask, 0 - any */
+    SaHpiSeverityT MinSeverity;       /* SAHPI_ALL_SEVERITIES - any */
+    SaHpiUint32T NumberOfResources;   /* 0 - any */
+    SaHpiResourceIdT Resources[OH_MAX_FILTER_RESOURCES];
+    SaHpiTextBufferT EntityPathPattern; /* Empty - any */
+    SaHpiUint32T NumberOfSensorTypes; /* 0 - any */
+    SaHpiSensorTypeT SensorTypes[OH_MAX_FILTER_SENSOR_TYPES];
+} oHpiEventFilterT;
+
+
+typedef enum {
+    OHPI_HANDLER_READY = 0, /* Opened, resources come from the plugin */
+    OHPI_HANDLER_STALE,     /* Opened, serving a warm-start snapshot */
+    OHPI_HANDLER_FAILED,    /* Failed to open */
+    OHPI_HANDLER_OPENING    /* Being opened in the background */
+} oHpiHandlerStateT;
+
+typedef struct {
+    oHpiHandlerStateT State;
+    SaHpiTimeT SnapshotTimestamp;    /* Save time of the loaded snapshot,
+                                        SAHPI_TIME_UNSPECIFIED if none */
+    SaHpiUint32T SnapshotResources;  /* Resources loaded from the snapshot */
+    SaHpiUint32T StaleResources;     /* Of them not rediscovered yet */
+} oHpiHandlerStatusT;
+
+typedef struct {
+    SaHpiTextBufferT Name;       /* "event", "rdr", "rpt_entry", ... */
+    SaHpiUint32T ObjectSize;     /* Bytes */
+    SaHpiUint32T Slabs;          /* 64 KiB each */
+    SaHpiUint32T Capacity;       /* Objects in all slabs */
+    SaHpiUint32T Free;           /* Free objects in the shared free list */
+    SaHpiUint32T Cached;         /* Free objects in per-thread caches */
+    SaHpiUint64T Allocs;
+    SaHpiUint64T Frees;
+    SaHpiUint64T HeapAllocs;     /* Served by the heap, pool was full */
+    SaHpiUint64T HeapFrees;      /* Freed objects that came from the heap */
+} oHpiMemPoolStatsT;
+
+typedef enum {
+    OHPI_METRIC_RPC = 0,  /* Processing of one RPC by the daemon */
+    OHPI_METRIC_ABI,      /* Calls of one plugin ABI function of one handler */
+    OHPI_METRIC_LOCK,     /* Waits for a daemon lock */
+    OHPI_METRIC_TASK,     /* Internal work, e.g. processing an event */
+    OHPI_METRIC_QUEUE,    /* Length of a queue, sampled for each item */
+    OHPI_METRIC_COUNTER   /* Occurrences, only Count is used */
+} oHpiMetricTypeT;
+
+#define OHPI_METRIC_BUCKETS 24
+
+typedef struct {
+    oHpiMetricTypeT Type;
+    oHpiHandlerIdT HandlerId;    /* OHPI_METRIC_ABI only, 0 otherwise */
+    SaHpiTextBufferT Name;       /* RPC, ABI function, lock, task or queue */
+    SaHpiUint64T Count;          /* Samples */
+    SaHpiUint64T Sum;            /* Sum of the samples */
+    SaHpiUint64T Max;            /* Largest sample */
+    SaHpiUint32T Current;        /* OHPI_METRIC_QUEUE: length now */
+    /* Buckets[0] counts samples below one unit, Buckets[i] samples
+       in [2^(i-1), 2^i) units, the last bucket also all larger ones.
+       The unit is a microsecond for times and 1 for queue lengths. */
+    SaHpiUint32T Buckets[OHPI_METRIC_BUCKETS];
+} oHpiMetricT;
+
+
 /***************************************************************************
 **
 ** Name: oHpiVersionGet()
@@ -337,6 +449,8 @@ SaErrorT SAHPI_API oHpiHandlerFind (
 **   SA_OK is returned if the handler was already successfully initialized.
 **   SA_ERR_HPI_NOT_PRESENT is returned when the targeted OpenHPI daemon
 **      has no handler with the specified id.
+**   SA_ERR_HPI_BUSY is returned if the handler is still being opened
+**      in the background.
 **
 ** Remarks:
 **   This is Daemon level function.
@@ -614,6 +728,451 @@ SaErrorT SAHPI_API oHpiDomainEntryGetByDomainId (
      SAHPI_IN    SaHpiDomainIdT    DomainId,
      SAHPI_OUT   oHpiDomainEntryT *DomainEntry );
 
+/***************************************************************************
+**
+** Name: oHpiSensorCacheStatsGet()
+**
+** Description:
+**   This function retrieves statistics of the sensor reading cache
+**   of the OpenHPI daemon.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   stats - [out] Pointer to the structure to hold the statistics.
+**
+** Return Value:
+**   SA_OK is returned on successful completion; otherwise, an error code is
+**      returned.
+**   SA_ERR_HPI_INVALID_PARAMS is returned if the stats pointer is passed in
+**      as NULL.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   The cache is enabled with the OPENHPI_SENSOR_CACHE_MAX_AGE global
+**   parameter or the "sensor_cache_max_age" handler parameter.
+**   All counters are zero if the cache is not used.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiSensorCacheStatsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_OUT   oHpiSensorCacheStatsT *stats );
+
+/***************************************************************************
+**
+** Name: oHpiSensorReadingsGet()
+**
+** Description:
+**   This function retrieves readings of several sensors of a resource
+**   in one call.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   rid - [in] Resource id.
+**   readings - [in/out] Pointer to the structure with the sensor numbers
+**      on input and their readings on output. The first NumberOfReadings
+**      entries of Readings are used.
+**
+** Return Value:
+**   SA_OK is returned if the readings were requested; the result for every
+**      sensor is returned in its Result field and is the same as
+**      saHpiSensorReadingGet() would return for it.
+**   SA_ERR_HPI_INVALID_PARAMS is returned if the readings pointer is passed
+**      in as NULL or if NumberOfReadings is greater than
+**      OH_MAX_SENSOR_READINGS.
+**   SA_ERR_HPI_INVALID_RESOURCE, SA_ERR_HPI_CAPABILITY are returned as
+**      by saHpiSensorReadingGet().
+**
+** Remarks:
+**   This is a Daemon level function.
+**   The readings are requested from the plugin at once if the plugin
+**   supports it, otherwise sensor by sensor.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiSensorReadingsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_INOUT oHpiSensorReadingsT *readings );
+
+/***************************************************************************
+**
+** Name: oHpiSensorHistoryGet()
+**
+** Description:
+**   This function retrieves readings of a sensor collected by the
+**   daemon sensor sampler in the specified time window.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   rid - [in] Resource id.
+**   num - [in] Sensor number.
+**   start - [in] Time of the oldest sample, SAHPI_TIME_UNSPECIFIED for
+**      the oldest sample kept.
+**   end - [in] Time of the newest sample, SAHPI_TIME_UNSPECIFIED for
+**      the newest sample kept.
+**   history - [out] Pointer to the structure to hold the samples and
+**      the aggregates.
+**
+** Return Value:
+**   SA_OK is returned on successful completion; otherwise, an error code is
+**      returned.
+**   SA_ERR_HPI_INVALID_PARAMS is returned if the history pointer is passed
+**      in as NULL.
+**   SA_ERR_HPI_INVALID_RESOURCE is returned if the resource does not exist.
+**   SA_ERR_HPI_NOT_PRESENT is returned if the sensor is not sampled.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   Sampling is enabled per handler with the "sensor_sampler_interval"
+**   handler parameter. Only numeric readings are kept.
+**   Count, Min, Max and Avg cover all samples in the window, while
+**   at most OH_MAX_SENSOR_SAMPLES newest samples are returned, oldest
+**   first. Older samples can be retrieved with end set to the time of
+**   the first returned sample minus one.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiSensorHistoryGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_IN    SaHpiSensorNumT num,
+     SAHPI_IN    SaHpiTimeT start,
+     SAHPI_IN    SaHpiTimeT end,
+     SAHPI_OUT   oHpiSensorHistoryT *history );
+
+/***************************************************************************
+**
+** Name: oHpiEventsGet()
+**
+** Description:
+**   This function works as saHpiEventGet() but retrieves several events
+**   from the session event queue in one call.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   Timeout - [in] The number of nanoseconds to wait for the first event,
+**      as in saHpiEventGet(). The following events are only taken if
+**      they are already queued.
+**   MaxEvents - [in] Maximal number of events to return.
+**   MaxBytes - [in] Maximal total size of the returned events, RDRs and
+**      RPT entries. 0 means no limit. At least one event is returned
+**      regardless of its size.
+**   NumberOfEvents - [out] Number of returned events.
+**   Events - [out] Array of MaxEvents elements for the events.
+**   Rdrs - [in/out] Array of MaxEvents elements for the RDRs associated
+**      with the events, as in saHpiEventGet(). NULL if not needed.
+**   RptEntries - [in/out] Array of MaxEvents elements for the RPT entries
+**      associated with the events. NULL if not needed.
+**   EventQueueStatus - [in/out] Queue overflow flag, set if the queue
+**      overflowed since the previous event retrieval. NULL if not needed.
+**
+** Return Value:
+**   As saHpiEventGet().
+**   SA_ERR_HPI_INVALID_PARAMS is also returned if NumberOfEvents or Events
+**      is passed in as NULL or MaxEvents is zero.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   At most OH_MAX_EVENTS_GET events are returned per call. The daemon
+**   also limits the reply size. RDRs and RPT entries are not transferred
+**   when the corresponding pointers are NULL.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiEventsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiTimeoutT Timeout,
+     SAHPI_IN    SaHpiUint32T MaxEvents,
+     SAHPI_IN    SaHpiUint32T MaxBytes,
+     SAHPI_OUT   SaHpiUint32T *NumberOfEvents,
+     SAHPI_OUT   SaHpiEventT *Events,
+     SAHPI_INOUT SaHpiRdrT *Rdrs,
+     SAHPI_INOUT SaHpiRptEntryT *RptEntries,
+     SAHPI_INOUT SaHpiEvtQueueStatusT *EventQueueStatus );
+
+/***************************************************************************
+**
+** Name: oHpiEventFilterSet()
+**
+** Description:
+**   This function sets a filter for the events delivered to the session.
+**   The filter is evaluated when the daemon distributes an event to the
+**   subscribed sessions, so events which do not pass the filter are
+**   never queued for the session.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   filter - [in] Pointer to the filter. NULL removes the filter.
+**      An event passes the filter if all of the following holds:
+**      - EventTypes is 0 or has the event type bit set;
+**      - the event severity is MinSeverity or more severe;
+**      - NumberOfResources is 0 or the event source is listed in
+**        Resources;
+**      - EntityPathPattern is empty or matches the entity path of the
+**        event source, see oh_compile_entitypath_pattern();
+**      - NumberOfSensorTypes is 0, the event is not a sensor or sensor
+**        enable change event, or its sensor type is listed in SensorTypes.
+**      The resource and entity path conditions are not applied to domain
+**      and user events.
+**
+** Return Value:
+**   SA_OK - Normal case.
+**   SA_ERR_HPI_INVALID_PARAMS - NumberOfResources or NumberOfSensorTypes
+**      is out of range or EntityPathPattern is not a valid pattern.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   The filter stays in effect until it is replaced or removed or the
+**   session is closed. Events already queued for the session are not
+**   affected.
+**   EntityPathPattern is matched against the entity paths known to the
+**   daemon, i.e. without the entity root configured for the client.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiEventFilterSet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    const oHpiEventFilterT *filter );
+
+/***************************************************************************
+**
+** Name: oHpiEventLogEntriesGet()
+**
+** Description:
+**   This function retrieves a range of event log entries in one call.
+**   It walks the log from StartEntryId towards the newest entry as
+**   repeated saHpiEventLogEntryGet() calls following NextEntryId would.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   rid - [in] Resource id of the event log,
+**      SAHPI_UNSPECIFIED_RESOURCE_ID for the domain event log.
+**   StartEntryId - [in] Identifier of the first entry to retrieve.
+**      SAHPI_OLDEST_ENTRY and SAHPI_NEWEST_ENTRY are accepted.
+**   MaxEntries - [in] Maximal number of entries to return.
+**   StartTime - [in] Entries logged before this time are skipped.
+**      SAHPI_TIME_UNSPECIFIED means no lower bound.
+**   EndTime - [in] Entries logged after this time are skipped.
+**      SAHPI_TIME_UNSPECIFIED means no upper bound.
+**   NumberOfEntries - [out] Number of returned entries.
+**   Entries - [out] Array of MaxEntries elements for the entries.
+**   Rdrs - [in/out] Array of MaxEntries elements for the RDRs associated
+**      with the entries. NULL if not needed.
+**   RptEntries - [in/out] Array of MaxEntries elements for the RPT entries
+**      associated with the entries. NULL if not needed.
+**   NextEntryId - [out] Identifier of the entry to continue from,
+**      SAHPI_NO_MORE_ENTRIES if the end of the log was reached.
+**
+** Return Value:
+**   As saHpiEventLogEntryGet() for the first entry.
+**   SA_ERR_HPI_INVALID_PARAMS is also returned if NumberOfEntries,
+**      Entries or NextEntryId is passed in as NULL or MaxEntries is zero.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   At most OH_MAX_EVENT_LOG_ENTRIES_GET entries are returned per call.
+**   The daemon also limits the reply size and the number of entries
+**   examined per call, so fewer entries than requested, even none, can
+**   be returned before the end of the log. The caller shall continue
+**   from NextEntryId until it is SAHPI_NO_MORE_ENTRIES.
+**   RDRs and RPT entries are not transferred when the corresponding
+**   pointers are NULL.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiEventLogEntriesGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_IN    SaHpiEventLogEntryIdT StartEntryId,
+     SAHPI_IN    SaHpiUint32T MaxEntries,
+     SAHPI_IN    SaHpiTimeT StartTime,
+     SAHPI_IN    SaHpiTimeT EndTime,
+     SAHPI_OUT   SaHpiUint32T *NumberOfEntries,
+     SAHPI_OUT   SaHpiEventLogEntryT *Entries,
+     SAHPI_INOUT SaHpiRdrT *Rdrs,
+     SAHPI_INOUT SaHpiRptEntryT *RptEntries,
+     SAHPI_OUT   SaHpiEventLogEntryIdT *NextEntryId );
+
+/***************************************************************************
+**
+** Name: oHpiHandlerStatusGet()
+**
+** Description:
+**   This function retrieves the state of the specified handler.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   id - [in] Unique (for the targeted OpenHPI daemon) id associated
+**      with the handler.
+**   status - [out] Pointer to the structure to hold the handler state.
+**
+** Return Value:
+**   SA_OK is returned on successful completion; otherwise, an error code is
+**      returned.
+**   SA_ERR_HPI_INVALID_PARAMS is returned if id is zero or the status
+**      pointer is passed in as NULL.
+**   SA_ERR_HPI_NOT_PRESENT is returned when the targeted OpenHPI daemon
+**      has no handler with the specified id.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   With OPENHPI_SNAPSHOT enabled the daemon starts with the resources
+**   saved by its previous run. A handler is OHPI_HANDLER_STALE until
+**   its first discovery has been processed and the resources it did
+**   not rediscover have been removed.
+**   With OPENHPI_HANDLER_OPEN_THREADS not zero the daemon opens its
+**   configured handlers in the background and serves requests at once.
+**   Such a handler is OHPI_HANDLER_OPENING until its open has finished.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiHandlerStatusGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    oHpiHandlerIdT id,
+     SAHPI_OUT   oHpiHandlerStatusT *status );
+
+/***************************************************************************
+**
+** Name: oHpiMemPoolStatsGet()
+**
+** Description:
+**   This function retrieves the statistics of one object pool of the
+**   daemon. Events, RDRs and RPT entries are allocated from these pools.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   EntryId - [in] Pool to read. SAHPI_FIRST_ENTRY for the first pool.
+**   NextEntryId - [out] Pointer to the location to store the EntryId of
+**      the next pool, SAHPI_LAST_ENTRY after the last pool.
+**   Stats - [out] Pointer to the structure to hold the pool statistics.
+**
+** Return Value:
+**   SA_OK is returned on successful completion; otherwise, an error code is
+**      returned.
+**   SA_ERR_HPI_INVALID_PARAMS is returned if EntryId is SAHPI_LAST_ENTRY
+**      or a pointer is passed in as NULL.
+**   SA_ERR_HPI_NOT_PRESENT is returned when there is no pool with the
+**      specified EntryId.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   A pool shows up once the daemon allocated its first object.
+**   Objects in use are Capacity - Free - Cached. The counters of
+**   running threads are read without stopping them, so they may lag
+**   slightly behind.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiMemPoolStatsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiEntryIdT EntryId,
+     SAHPI_OUT   SaHpiEntryIdT *NextEntryId,
+     SAHPI_OUT   oHpiMemPoolStatsT *Stats );
+
+/***************************************************************************
+**
+** Name: oHpiMetricGet()
+**
+** Description:
+**   This function retrieves one metric of the daemon: a latency
+**   histogram of an RPC, of a plugin ABI function of a handler, of a
+**   lock wait or of internal work, the lengths of a queue or a counter.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   EntryId - [in] Metric to read. SAHPI_FIRST_ENTRY for the first one.
+**   NextEntryId - [out] Pointer to the location to store the EntryId of
+**      the next metric, SAHPI_LAST_ENTRY after the last one.
+**   Metric - [out] Pointer to the structure to hold the metric.
+**
+** Return Value:
+**   SA_OK is returned on successful completion; otherwise, an error code is
+**      returned.
+**   SA_ERR_HPI_INVALID_PARAMS is returned if EntryId is SAHPI_LAST_ENTRY
+**      or a pointer is passed in as NULL.
+**   SA_ERR_HPI_NOT_PRESENT is returned when there is no metric with the
+**      specified EntryId.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   Times are in nanoseconds. Counting starts with the daemon and
+**   the values only grow, a client computes rates from two readings.
+**   RPC and ABI metrics show up on their first call and keep their
+**   EntryId, so a later walk returns them in the same order.
+**   The counters of running threads are read without stopping them,
+**   so they may lag slightly behind.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiMetricGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiEntryIdT EntryId,
+     SAHPI_OUT   SaHpiEntryIdT *NextEntryId,
+     SAHPI_OUT   oHpiMetricT *Metric );
+
+/***************************************************************************
+**
+** Name: oHpiIdrGet()
+**
+** Description:
+**   This function retrieves the info, the area headers and the fields
+**   of an Inventory Data Repository in one call. It returns what
+**   saHpiIdrInfoGet() and repeated saHpiIdrAreaHeaderGet() and
+**   saHpiIdrFieldGet() calls with unspecified types would return.
+**
+** Parameters:
+**   sid - [in] Identifier for a session context previously obtained using
+**      saHpiSessionOpen().
+**   rid - [in] Resource id of the IDR.
+**   IdrId - [in] Identifier of the IDR.
+**   StartAreaId - [in] Identifier of the first area to retrieve,
+**      SAHPI_FIRST_ENTRY to start from the beginning.
+**   MaxAreas - [in] Maximal number of areas to return.
+**   MaxFields - [in] Maximal number of fields to return.
+**   IdrInfo - [out] Pointer to the IDR info.
+**   NumberOfAreas - [out] Number of returned area headers.
+**   Areas - [out] Array of MaxAreas elements for the area headers.
+**   NumberOfFields - [out] Number of returned fields.
+**   Fields - [out] Array of MaxFields elements for the fields of the
+**      returned areas.
+**   NextAreaId - [out] Identifier of the area to continue from,
+**      SAHPI_LAST_ENTRY if the end of the IDR was reached.
+**
+** Return Value:
+**   As saHpiIdrInfoGet().
+**   SA_ERR_HPI_INVALID_PARAMS is also returned if a pointer is passed
+**      in as NULL, MaxAreas or MaxFields is zero or StartAreaId is
+**      SAHPI_LAST_ENTRY.
+**   SA_ERR_HPI_NOT_PRESENT is returned if there is no area with
+**      StartAreaId.
+**   SA_ERR_HPI_OUT_OF_SPACE is returned if the fields of the first
+**      area do not fit into MaxFields.
+**
+** Remarks:
+**   This is a Daemon level function.
+**   Only whole areas are returned. The fields follow in the order of
+**   their areas and carry the AreaId. At most OH_MAX_IDR_AREAS_GET
+**   areas and OH_MAX_IDR_FIELDS_GET fields are returned per call and
+**   the daemon also limits the reply size, so the caller shall
+**   continue from NextAreaId until it is SAHPI_LAST_ENTRY.
+**   An IDR without areas is returned with no areas.
+**
+***************************************************************************/
+SaErrorT SAHPI_API oHpiIdrGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_IN    SaHpiIdrIdT IdrId,
+     SAHPI_IN    SaHpiEntryIdT StartAreaId,
+     SAHPI_IN    SaHpiUint32T MaxAreas,
+     SAHPI_IN    SaHpiUint32T MaxFields,
+     SAHPI_OUT   SaHpiIdrInfoT *IdrInfo,
+     SAHPI_OUT   SaHpiUint32T *NumberOfAreas,
+     SAHPI_OUT   SaHpiIdrAreaHeaderT *Areas,
+     SAHPI_OUT   SaHpiUint32T *NumberOfFields,
+     SAHPI_OUT   SaHpiIdrFieldT *Fields,
+     SAHPI_OUT   SaHpiEntryIdT *NextAreaId );
+
 
 #define OHPI_VERSION_GET(v, VER) \
 { \
@@ -228,6 +228,25 @@ struct oh_abi_v2 {
 				 SaHpiRdrT *rdr,
 				 SaHpiRptEntryT *rptentry);
 
+        /***
+         * oHpiEventLogEntriesGet - optional
+         * Gets up to max consecutive entries starting from current.
+         * The number of returned entries goes to num, the id of the entry
+         * to continue from goes to next. rdrs and rptentries may be NULL.
+         * When the plugin does not implement it or returns
+         * SA_ERR_HPI_UNSUPPORTED_API the daemon calls get_el_entry
+         * for every entry.
+         **/
+        SaErrorT (*get_el_entries)(void *hnd,
+                                   SaHpiResourceIdT id,
+                                   SaHpiEventLogEntryIdT current,
+                                   SaHpiUint32T max,
+                                   SaHpiUint32T *num,
+                                   SaHpiEventLogEntryT *entries,
+                                   SaHpiRdrT *rdrs,
+                                   SaHpiRptEntryT *rptentries,
+                                   SaHpiEventLogEntryIdT *next);
+
         /***
          * saHpiEventLogClear
          **/
@@ -255,6 +274,21 @@ struct oh_abi_v2 {
                                        SaHpiSensorNumT num,
                                        SaHpiSensorReadingT *reading,
                                        SaHpiEventStateT *state);
+
+        /***
+         * oHpiSensorReadingsGet - optional
+         * Gets readings of num_sensors sensors of the resource at once.
+         * The result for nums[i] goes to readings[i], states[i] and
+         * results[i]. When the plugin does not implement it
+         * the daemon calls get_sensor_reading for every sensor.
+         **/
+        SaErrorT (*get_sensor_readings)(void *hnd,
+                                        SaHpiResourceIdT id,
+                                        SaHpiUint32T num_sensors,
+                                        const SaHpiSensorNumT *nums,
+                                        SaHpiSensorReadingT *readings,
+                                        SaHpiEventStateT *states,
+                                        SaErrorT *results);
         /***
          * saHpiSensorThresholdsGet
          **/
@@ -404,6 +438,29 @@ struct oh_abi_v2 {
                              	  SaHpiEntryIdT *nextfieldid,
 				  SaHpiIdrFieldT *field);
 
+        /***
+         * oHpiIdrGet - optional
+         * Gets the idr info and the whole areas starting from areaid
+         * with their fields, up to max_areas areas and max_fields
+         * fields. The fields follow in the order of the areas. The id
+         * of the area to continue from goes to next, SAHPI_LAST_ENTRY
+         * at the end. When the plugin does not implement it or returns
+         * SA_ERR_HPI_UNSUPPORTED_API the daemon calls get_idr_info,
+         * get_idr_area_header and get_idr_field.
+         **/
+        SaErrorT (*get_idr_all)(void *hnd,
+                                SaHpiResourceIdT rid,
+                                SaHpiIdrIdT idrid,
+                                SaHpiEntryIdT areaid,
+                                SaHpiUint32T max_areas,
+                                SaHpiUint32T max_fields,
+                                SaHpiIdrInfoT *idrinfo,
+                                SaHpiUint32T *num_areas,
+                                SaHpiIdrAreaHeaderT *areas,
+                                SaHpiUint32T *num_fields,
+                                SaHpiIdrFieldT *fields,
+                                SaHpiEntryIdT *next);
+
         /***
          * saHpiIdrFieldAdd
          **/
@@ -100,6 +100,8 @@ struct oh_handler {
         GStaticRecMutex refcount_lock;
 #endif
         int refcount;
+        /* Set while the handler waits for or is in its threaded open */
+        int opening;
 };
 extern struct oh_handlers oh_handlers;
 
@@ -120,8 +122,13 @@ struct oh_handler *oh_get_handler(unsigned int hid);
 void oh_release_handler(struct oh_handler *handler);
 int oh_getnext_handler_id(unsigned int hid, unsigned int *next_hid);
 SaErrorT oh_create_handler(GHashTable *handler_config, unsigned int *hid);
+SaErrorT oh_create_handler_deferred(GHashTable *handler_config, unsigned int *hid);
+void oh_open_handlers(unsigned int max_threads);
+void oh_wait_handlers_opened(void);
+void oh_stop_handlers_open(void);
 int oh_destroy_handler(unsigned int hid);
 SaErrorT oh_get_handler_info(unsigned int hid, oHpiHandlerInfoT *info, GHashTable *conf_params);
+SaErrorT oh_get_handler_status(unsigned int hid, oHpiHandlerStatusT *status);
 SaErrorT oh_discovery(void);
 
 /* Bind abi functions into plugin */
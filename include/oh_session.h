@@ -20,6 +20,7 @@
 #include <glib.h>
 
 #include <SaHpi.h>
+#include <oHpi.h>
 
 #include <oh_utils.h>
 
@@ -73,6 +74,11 @@ struct oh_session {
         */
         GAsyncQueue *eventq;
 
+        /*
+          Optional event filter set by oHpiEventFilterSet(), NULL if none
+        */
+        struct oh_session_filter *filter;
+
 };
 
 SaHpiSessionIdT oh_create_session(SaHpiDomainIdT did);
@@ -80,6 +86,11 @@ SaHpiDomainIdT oh_get_session_domain(SaHpiSessionIdT sid);
 GArray *oh_list_sessions(SaHpiDomainIdT did);
 SaErrorT oh_get_session_subscription(SaHpiSessionIdT sid, SaHpiBoolT *state);
 SaErrorT oh_set_session_subscription(SaHpiSessionIdT sid, SaHpiBoolT state);
+SaErrorT oh_set_session_filter(SaHpiSessionIdT sid,
+                               const oHpiEventFilterT *filter);
+SaHpiBoolT oh_session_event_wanted(SaHpiSessionIdT sid,
+                                   const SaHpiEventT *event,
+                                   const SaHpiEntityPathT *ep);
 SaErrorT oh_queue_session_event(SaHpiSessionIdT sid, struct oh_event *event);
 SaErrorT oh_dequeue_session_event(SaHpiSessionIdT sid,
                                   SaHpiTimeoutT timeout,
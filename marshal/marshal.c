@@ -700,3 +700,641 @@ DemarshalArray( int byte_order, const cMarshalType **types, void **data, const v
   return size;
 }
 
+
+
+/***********************************************************
+ * Compact encoding (OpenHPI RPC version 2)
+ *
+ * - 8-bit integers and floats are encoded as in Marshal()
+ * - wider integers are LEB128 varints,
+ *   signed ones are zigzag encoded first
+ * - fixed arrays are encoded as varint number of elements
+ *   followed by the elements; trailing all-zero elements
+ *   are not sent and are zeroed by the demarshaller.
+ *   So text buffers go with their data only and
+ *   entity paths are cut after the ROOT element.
+ * - structs, unions and var arrays are encoded as in Marshal()
+ * - user defined types use their own (de)marshaller
+ ***********************************************************/
+
+#define dMaxVarintSize 10
+
+
+static int
+MarshalVarint( tUint64 v, unsigned char *buffer )
+{
+  int size = 0;
+
+  while( v >= 0x80 )
+     {
+       buffer[size++] = (unsigned char)( v | 0x80 );
+       v >>= 7;
+     }
+  buffer[size++] = (unsigned char)v;
+
+  return size;
+}
+
+
+static int
+DemarshalVarint( tUint64 *v, const unsigned char *buffer )
+{
+  tUint64 r = 0;
+  int i;
+
+  for( i = 0; i < dMaxVarintSize; i++ )
+     {
+       r |= (tUint64)( buffer[i] & 0x7f ) << ( 7 * i );
+       if ( ( buffer[i] & 0x80 ) == 0 )
+	  {
+	    *v = r;
+	    return i + 1;
+	  }
+     }
+
+  CRIT( "DemarshalVarint: malformed varint!" );
+  return -EINVAL;
+}
+
+
+static tUint64
+ZigZagEncode( tInt64 v )
+{
+  return ( (tUint64)v << 1 ) ^ (tUint64)( v >> 63 );
+}
+
+
+static tInt64
+ZigZagDecode( tUint64 v )
+{
+  return (tInt64)( v >> 1 ) ^ -(tInt64)( v & 1 );
+}
+
+
+static int
+MarshalCompactSimpleType( tMarshalType type, const void *data, void *buffer )
+{
+  union
+  {
+    tInt16    i16;
+    tUint16   ui16;
+    tInt32    i32;
+    tUint32   ui32;
+    tInt64    i64;
+    tUint64   ui64;
+  } u;
+
+  switch( type )
+     {
+       case eMtInt16:
+	    memcpy(&u.i16, data, sizeof(tInt16));
+	    return MarshalVarint( ZigZagEncode( u.i16 ), buffer );
+       case eMtUint16:
+	    memcpy(&u.ui16, data, sizeof(tUint16));
+	    return MarshalVarint( u.ui16, buffer );
+       case eMtInt32:
+	    memcpy(&u.i32, data, sizeof(tInt32));
+	    return MarshalVarint( ZigZagEncode( u.i32 ), buffer );
+       case eMtUint32:
+	    memcpy(&u.ui32, data, sizeof(tUint32));
+	    return MarshalVarint( u.ui32, buffer );
+       case eMtInt64:
+	    memcpy(&u.i64, data, sizeof(tInt64));
+	    return MarshalVarint( ZigZagEncode( u.i64 ), buffer );
+       case eMtUint64:
+	    memcpy(&u.ui64, data, sizeof(tUint64));
+	    return MarshalVarint( u.ui64, buffer );
+       default:
+	    return MarshalSimpleType( type, data, buffer );
+     }
+}
+
+
+static int
+DemarshalCompactSimpleType( int byte_order, tMarshalType type, void *data, const void *buffer )
+{
+  union
+  {
+    tInt16    i16;
+    tUint16   ui16;
+    tInt32    i32;
+    tUint32   ui32;
+    tInt64    i64;
+    tUint64   ui64;
+  } u;
+  tUint64 v;
+  tInt64  sv;
+  int     cc;
+
+  switch( type )
+     {
+       case eMtInt16:
+       case eMtUint16:
+       case eMtInt32:
+       case eMtUint32:
+       case eMtInt64:
+       case eMtUint64:
+	    break;
+       default:
+	    return DemarshalSimpleTypes( byte_order, type, data, buffer );
+     }
+
+  cc = DemarshalVarint( &v, buffer );
+  if ( cc < 0 )
+       return cc;
+  sv = ZigZagDecode( v );
+
+  switch( type )
+     {
+       case eMtInt16:
+	    if ( sv < G_MININT16 || sv > G_MAXINT16 )
+		 return -EINVAL;
+	    u.i16 = (tInt16)sv;
+	    memcpy(data, &u.i16, sizeof(tInt16));
+	    break;
+       case eMtUint16:
+	    if ( v > G_MAXUINT16 )
+		 return -EINVAL;
+	    u.ui16 = (tUint16)v;
+	    memcpy(data, &u.ui16, sizeof(tUint16));
+	    break;
+       case eMtInt32:
+	    if ( sv < G_MININT32 || sv > G_MAXINT32 )
+		 return -EINVAL;
+	    u.i32 = (tInt32)sv;
+	    memcpy(data, &u.i32, sizeof(tInt32));
+	    break;
+       case eMtUint32:
+	    if ( v > G_MAXUINT32 )
+		 return -EINVAL;
+	    u.ui32 = (tUint32)v;
+	    memcpy(data, &u.ui32, sizeof(tUint32));
+	    break;
+       case eMtInt64:
+	    u.i64 = sv;
+	    memcpy(data, &u.i64, sizeof(tInt64));
+	    break;
+       default:
+	    u.ui64 = v;
+	    memcpy(data, &u.ui64, sizeof(tUint64));
+	    break;
+     }
+
+  return cc;
+}
+
+
+static gboolean
+IsZeroMemory( const unsigned char *data, size_t size )
+{
+  size_t i;
+  for( i = 0; i < size; i++ )
+     {
+       if ( data[i] != 0 )
+	    return FALSE;
+     }
+
+  return TRUE;
+}
+
+
+int
+MarshalCompact( const cMarshalType *type, const void *d, void *b )
+{
+  if ( IsSimpleType( type->m_type ) )
+     {
+       return MarshalCompactSimpleType( type->m_type, d, b );
+     }
+
+  int                  size   = 0;
+  const unsigned char *data   = d;
+  unsigned char       *buffer = b;
+
+  switch( type->m_type )
+     {
+       case eMtArray:
+	    {
+	      const cMarshalType *elem = type->u.m_array.m_element;
+	      const size_t elem_sizeof = type->u.m_array.m_element_sizeof;
+	      size_t nelems = type->u.m_array.m_nelements;
+
+	      // skip trailing all-zero elements
+	      while( nelems > 0 && IsZeroMemory( data + ( nelems - 1 ) * elem_sizeof, elem_sizeof ) )
+		   nelems--;
+
+	      size = MarshalVarint( nelems, buffer );
+	      buffer += size;
+
+	      if ( elem->m_type == eMtUint8 || elem->m_type == eMtInt8 )
+		 {
+		   memcpy( buffer, data, nelems );
+		   size += nelems;
+		   break;
+		 }
+
+	      size_t i;
+	      for( i = 0; i < nelems; i++ )
+		 {
+		   int cc = MarshalCompact( elem, data, buffer );
+		   if ( cc < 0 )
+		      {
+			   CRIT( "MarshalCompact: %s[%zd]: failure, cc = %d!", type->m_name, i, cc );
+			   return cc;
+		      }
+
+		   data   += elem_sizeof;
+		   buffer += cc;
+		   size   += cc;
+		 }
+	    }
+	    break;
+
+       case eMtStruct:
+	    {
+	      const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+	      size_t i;
+	      for( i = 0; elems[i].m_type == eMtStructElement; i++ )
+		 {
+		   const cMarshalType *elem = elems[i].u.m_struct_element.m_element;
+		   const size_t offset      = elems[i].u.m_struct_element.m_offset;
+		   int cc = 0;
+
+		   if ( elem->m_type == eMtUnion )
+		      {
+			const size_t mod2_idx = elem->u.m_union.m_mod_idx;
+			const size_t mod2 = GetStructElementIntegerValue( type, mod2_idx, data );
+			const cMarshalType *elem2 = GetUnionElement( elem, mod2 );
+			if ( !elem2 ) {
+ 	                    CRIT( "MarshalCompact: %s:%s: invalid mod value %u!",
+			          type->m_name, elems[i].m_name, (unsigned int)mod2 );
+			    return -EINVAL;
+			}
+
+			cc = MarshalCompact( elem2, data + offset, buffer );
+			if ( cc < 0 )
+			   {
+			     CRIT( "MarshalCompact: %s:%s, mod %u: failure, cc = %d!",
+			           type->m_name, elems[i].m_name, (unsigned int)mod2, cc );
+			     return cc;
+			   }
+		      }
+		   else if ( elem->m_type == eMtVarArray )
+		      {
+			const size_t nelems2_idx   = elem->u.m_var_array.m_nelements_idx;
+			const cMarshalType *elem2  = elem->u.m_var_array.m_element;
+			const size_t elem2_sizeof  = elem->u.m_var_array.m_element_sizeof;
+			const size_t nelems2 = GetStructElementIntegerValue( type, nelems2_idx, data );
+
+			// (data + offset ) points to pointer to var array content
+			const unsigned char *data2;
+			memcpy(&data2, data + offset, sizeof(void *));
+
+			unsigned char *buffer2 = buffer;
+			size_t i2;
+			for( i2 = 0; i2 < nelems2; i2++ )
+			   {
+			     int cc2 = MarshalCompact( elem2, data2, buffer2 );
+			     if ( cc2 < 0 )
+				{
+			          CRIT( "MarshalCompact: %s:%s[%zd]: failure, cc = %d!",
+			                 type->m_name, elems[i].m_name, i2, cc2 );
+				  return cc2;
+				}
+
+			     data2   += elem2_sizeof;
+			     buffer2 += cc2;
+			     cc      += cc2;
+			   }
+		      }
+		   else
+		      {
+			cc = MarshalCompact( elem, data + offset, buffer );
+			if ( cc < 0 )
+			   {
+			     CRIT( "MarshalCompact: %s:%s: failure, cc = %d!",
+			           type->m_name, elems[i].m_name, cc );
+			     return cc;
+			   }
+		      }
+
+		   buffer += cc;
+		   size   += cc;
+		 }
+	    }
+	    break;
+
+       case eMtUserDefined:
+	    size = Marshal( type, d, b );
+	    break;
+
+       default:
+	    return -ENOSYS;
+     }
+
+  return size;
+}
+
+
+static int
+VarintSize( tUint64 v )
+{
+  int size = 1;
+
+  while( v >= 0x80 )
+     {
+       v >>= 7;
+       size++;
+     }
+
+  return size;
+}
+
+
+// Upper bound of the MarshalCompact() size of any value of the type.
+// Returns -ENOSYS for types without a bound (var arrays, user defined).
+int
+MarshalCompactMaxSize( const cMarshalType *type )
+{
+  switch( type->m_type )
+     {
+       case eMtVoid:
+	    return 0;
+       case eMtInt8:
+       case eMtUint8:
+	    return 1;
+       case eMtInt16:
+       case eMtUint16:
+	    return 3;
+       case eMtInt32:
+       case eMtUint32:
+	    return 5;
+       case eMtInt64:
+       case eMtUint64:
+	    return dMaxVarintSize;
+       case eMtFloat32:
+	    return sizeof( tFloat32 );
+       case eMtFloat64:
+	    return sizeof( tFloat64 );
+       default:
+	    break;
+     }
+
+  int size = 0;
+
+  switch( type->m_type )
+     {
+       case eMtArray:
+	    {
+	      const size_t nelems = type->u.m_array.m_nelements;
+	      int cc = MarshalCompactMaxSize( type->u.m_array.m_element );
+	      if ( cc < 0 )
+		   return cc;
+
+	      size = VarintSize( nelems ) + nelems * cc;
+	    }
+	    break;
+
+       case eMtStruct:
+	    {
+	      const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+	      size_t i;
+	      for( i = 0; elems[i].m_type == eMtStructElement; i++ )
+		 {
+		   int cc = MarshalCompactMaxSize( elems[i].u.m_struct_element.m_element );
+		   if ( cc < 0 )
+			return cc;
+
+		   size += cc;
+		 }
+	    }
+	    break;
+
+       case eMtUnion:
+	    {
+	      const cMarshalType *elems = &type->u.m_union.m_elements[0];
+	      size_t i;
+	      for( i = 0; elems[i].m_type == eMtUnionElement; i++ )
+		 {
+		   int cc = MarshalCompactMaxSize( elems[i].u.m_union_element.m_element );
+		   if ( cc < 0 )
+			return cc;
+
+		   if ( cc > size )
+			size = cc;
+		 }
+	    }
+	    break;
+
+       default:
+	    return -ENOSYS;
+     }
+
+  return size;
+}
+
+
+int
+MarshalCompactArray( const cMarshalType **types, const void **data, void *b )
+{
+  int            size = 0;
+  unsigned char *buffer = b;
+
+  int i;
+  for( i = 0; types[i]; i++ )
+     {
+       int cc = MarshalCompact( types[i], data[i], buffer );
+       if ( cc < 0 )
+	  {
+	    CRIT( "MarshalCompactArray[%d]: %s: failure, cc = %d!", i, types[i]->m_name, cc );
+	    return cc;
+	  }
+
+       size   += cc;
+       buffer += cc;
+     }
+
+  return size;
+}
+
+
+int
+DemarshalCompact( int byte_order, const cMarshalType *type, void *d, const void *b )
+{
+  if ( IsSimpleType( type->m_type ) )
+     {
+       return DemarshalCompactSimpleType( byte_order, type->m_type, d, b );
+     }
+
+  int                  size = 0;
+  unsigned char       *data  = d;
+  const unsigned char *buffer = b;
+
+  switch( type->m_type )
+     {
+       case eMtArray:
+	    {
+	      const cMarshalType *elem = type->u.m_array.m_element;
+	      const size_t elem_sizeof = type->u.m_array.m_element_sizeof;
+	      const size_t max_nelems  = type->u.m_array.m_nelements;
+	      tUint64 nelems;
+
+	      size = DemarshalVarint( &nelems, buffer );
+	      if ( size < 0 )
+		   return size;
+	      if ( nelems > max_nelems )
+		 {
+		   CRIT( "DemarshalCompact: %s: too many elements %llu!",
+			 type->m_name, nelems );
+		   return -EINVAL;
+		 }
+	      buffer += size;
+
+	      if ( elem->m_type == eMtUint8 || elem->m_type == eMtInt8 )
+		 {
+		   memcpy( data, buffer, nelems );
+		   memset( data + nelems, 0, max_nelems - nelems );
+		   size += nelems;
+		   break;
+		 }
+
+	      size_t i;
+	      for( i = 0; i < nelems; i++ )
+		 {
+		   int cc = DemarshalCompact( byte_order, elem, data, buffer );
+		   if ( cc < 0 )
+		      {
+			   CRIT( "DemarshalCompact: %s[%zd]: failure, cc = %d!", type->m_name, i, cc );
+			   return cc;
+		      }
+
+		   data   += elem_sizeof;
+		   buffer += cc;
+		   size   += cc;
+		 }
+
+	      memset( data, 0, ( max_nelems - nelems ) * elem_sizeof );
+	    }
+	    break;
+
+       case eMtStruct:
+	    {
+	      const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+	      size_t i;
+	      for( i = 0; elems[i].m_type == eMtStructElement; i++ )
+		 {
+		   const cMarshalType *elem = elems[i].u.m_struct_element.m_element;
+		   const size_t offset      = elems[i].u.m_struct_element.m_offset;
+		   int cc = 0;
+
+		   if ( elem->m_type == eMtUnion )
+		      {
+			const size_t mod2_idx = elem->u.m_union.m_mod_idx;
+			if ( mod2_idx >= i ) {
+			    // NB: this is a limitation of demarshaling of unions
+ 	                    CRIT( "DemarshalCompact: %s:%s: mod field must be before union!",
+			          type->m_name, elems[i].m_name );
+			    return -EINVAL;
+			}
+			const size_t mod2 = GetStructElementIntegerValue( type, mod2_idx, data );
+			const cMarshalType *elem2 = GetUnionElement( elem, mod2 );
+			if ( !elem2 ) {
+ 	                    CRIT( "DemarshalCompact: %s:%s: invalid mod value %u!",
+			          type->m_name, elems[i].m_name, (unsigned int)mod2 );
+			    return -EINVAL;
+			}
+
+			cc = DemarshalCompact( byte_order, elem2, data + offset, buffer );
+			if ( cc < 0 )
+			   {
+			     CRIT( "DemarshalCompact: %s:%s, mod %u: failure, cc = %d!",
+			           type->m_name, elems[i].m_name, (unsigned int)mod2, cc );
+			     return cc;
+			   }
+		      }
+		   else if ( elem->m_type == eMtVarArray )
+		      {
+			const size_t nelems2_idx   = elem->u.m_var_array.m_nelements_idx;
+			const cMarshalType *elem2  = elem->u.m_var_array.m_element;
+			const size_t elem2_sizeof  = elem->u.m_var_array.m_element_sizeof;
+
+			if ( nelems2_idx >= i ) {
+			    // NB: this is a limitation of demarshaling of var arrays
+ 	                    CRIT( "DemarshalCompact: %s:%s: nelements field must be before vararray!",
+			          type->m_name, elems[i].m_name );
+			    return -EINVAL;
+			}
+			const size_t nelems2 = GetStructElementIntegerValue( type, nelems2_idx, data );
+
+			// allocate storage for var array content
+			unsigned char *data2 = g_new0(unsigned char, nelems2 * elem2_sizeof );
+			// (data + offset ) points to pointer to var array content
+			memcpy(data + offset, &data2, sizeof(void *));
+
+			const unsigned char *buffer2 = buffer;
+			size_t i2;
+			for( i2 = 0; i2 < nelems2; i2++ )
+			   {
+			     int cc2 = DemarshalCompact( byte_order, elem2, data2, buffer2 );
+			     if ( cc2 < 0 )
+				{
+			          CRIT( "DemarshalCompact: %s:%s[%zd]: failure, cc = %d!",
+			                 type->m_name, elems[i].m_name, i2, cc2 );
+				  return cc2;
+				}
+
+			     data2   += elem2_sizeof;
+			     buffer2 += cc2;
+			     cc      += cc2;
+			   }
+		      }
+		   else
+		      {
+			cc = DemarshalCompact( byte_order, elem, data + offset, buffer );
+			if ( cc < 0 )
+			   {
+			     CRIT( "DemarshalCompact: %s:%s: failure, cc = %d!",
+			           type->m_name, elems[i].m_name, cc );
+			     return cc;
+			   }
+		      }
+
+		   buffer += cc;
+		   size   += cc;
+		 }
+	    }
+	    break;
+
+       case eMtUserDefined:
+	    size = Demarshal( byte_order, type, d, b );
+	    break;
+
+       default:
+	    return -ENOSYS;
+     }
+
+  return size;
+}
+
+
+int
+DemarshalCompactArray( int byte_order, const cMarshalType **types, void **data, const void *b )
+{
+  int size = 0;
+  const unsigned char *buffer = b;
+
+  int i;
+  for( i = 0; types[i]; i++ )
+     {
+       int cc = DemarshalCompact( byte_order, types[i], data[i], buffer );
+       if ( cc < 0 )
+	  {
+	    CRIT( "DemarshalCompactArray[%d]: %s: failure, cc = %d!", i, types[i]->m_name, cc );
+	    return cc;
+	  }
+
+       size   += cc;
+       buffer += cc;
+     }
+
+  return size;
+}
@@ -258,6 +258,13 @@ int MarshalArray( const cMarshalType **types, const void **data, void *buffer );
 int Demarshal( int byte_order, const cMarshalType *type, void *data, const void *buffer );
 int DemarshalArray( int byte_order, const cMarshalType **types, void **data, const void *buffer );
 
+// compact encoding, see marshal.c
+int MarshalCompact( const cMarshalType *type, const void *data, void  *buffer );
+int MarshalCompactArray( const cMarshalType **types, const void **data, void *buffer );
+int DemarshalCompact( int byte_order, const cMarshalType *type, void *data, const void *buffer );
+int DemarshalCompactArray( int byte_order, const cMarshalType **types, void **data, const void *buffer );
+int MarshalCompactMaxSize( const cMarshalType *type );
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,726 @@
+/*
+ * generator of type-specialized marshallers
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Walks the cMarshalType tables of every hpi_marshal entry
+ * and writes C code with straight-line encode/decode functions
+ * for each reachable type to stdout (marshal_hpi_gen.c).
+ *
+ * The generated code produces exactly the same wire format as
+ * Marshal()/Demarshal() in marshal.c, which remain the reference.
+ * Types whose memory layout equals the wire layout (no padding,
+ * no unions, no var arrays) are copied with a single memcpy.
+ * On demarshal such a bulk copy is used when the byte order of
+ * the peer matches ours.
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "marshal_hpi.h"
+
+
+#define dMaxTypes 1024
+#define dMaxPath  4096
+
+
+typedef struct
+{
+  const cMarshalType *m_type;
+  char                m_name[128];
+  char                m_path[dMaxPath]; // C expression that yields m_type
+} cGenType;
+
+static cGenType gen_types[dMaxTypes];
+static int      gen_types_num = 0;
+
+
+static int
+SimpleSize( tMarshalType type )
+{
+  switch( type )
+     {
+       case eMtVoid:
+            return 0;
+       case eMtInt8:
+       case eMtUint8:
+            return 1;
+       case eMtInt16:
+       case eMtUint16:
+            return 2;
+       case eMtInt32:
+       case eMtUint32:
+       case eMtFloat32:
+            return 4;
+       case eMtInt64:
+       case eMtUint64:
+       case eMtFloat64:
+            return 8;
+       default:
+            return -1;
+     }
+}
+
+
+static const char *
+SimpleName( tMarshalType type )
+{
+  switch( type )
+     {
+       case eMtInt8:    return "tInt8";
+       case eMtUint8:   return "tUint8";
+       case eMtInt16:   return "tInt16";
+       case eMtUint16:  return "tUint16";
+       case eMtInt32:   return "tInt32";
+       case eMtUint32:  return "tUint32";
+       case eMtInt64:   return "tInt64";
+       case eMtUint64:  return "tUint64";
+       case eMtFloat32: return "tUint32";
+       case eMtFloat64: return "tUint64";
+       default:         return 0;
+     }
+}
+
+
+/***********************************************************
+ * Returns wire size of the type if its memory layout
+ * is the same as the wire layout, -1 otherwise
+ ***********************************************************/
+static int
+FlatSize( const cMarshalType *type )
+{
+  int s = SimpleSize( type->m_type );
+  if ( s >= 0 )
+       return s;
+
+  if ( type->m_type == eMtArray )
+     {
+       int e = FlatSize( type->u.m_array.m_element );
+       if ( e < 0 || (size_t)e != type->u.m_array.m_element_sizeof )
+            return -1;
+       return e * (int)type->u.m_array.m_nelements;
+     }
+
+  if ( type->m_type == eMtStruct )
+     {
+       const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+       int size = 0;
+       size_t i;
+       for( i = 0; elems[i].m_type == eMtStructElement; i++ )
+          {
+            const cMarshalType *elem = elems[i].u.m_struct_element.m_element;
+            if ( elems[i].u.m_struct_element.m_offset != (size_t)size )
+                 return -1;
+            int e = FlatSize( elem );
+            if ( e < 0 )
+                 return -1;
+            size += e;
+          }
+       return size;
+     }
+
+  return -1;
+}
+
+
+/***********************************************************
+ * Returns TRUE if the flat type is made of single bytes only
+ * and so never needs byte swapping
+ ***********************************************************/
+static int
+IsByteType( const cMarshalType *type )
+{
+  int s = SimpleSize( type->m_type );
+  if ( s >= 0 )
+       return s <= 1;
+
+  if ( type->m_type == eMtArray )
+       return IsByteType( type->u.m_array.m_element );
+
+  if ( type->m_type == eMtStruct )
+     {
+       const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+       size_t i;
+       for( i = 0; elems[i].m_type == eMtStructElement; i++ )
+          {
+            if ( !IsByteType( elems[i].u.m_struct_element.m_element ) )
+                 return 0;
+          }
+       return 1;
+     }
+
+  return 0;
+}
+
+
+static int
+IsIntegerElement( const cMarshalType *type, size_t idx )
+{
+  const cMarshalType *elem = type->u.m_struct.m_elements[idx].u.m_struct_element.m_element;
+
+  switch( elem->m_type )
+     {
+       case eMtInt8:
+       case eMtUint8:
+       case eMtInt16:
+       case eMtUint16:
+       case eMtInt32:
+       case eMtUint32:
+       case eMtInt64:
+       case eMtUint64:
+            return 1;
+       default:
+            return 0;
+     }
+}
+
+
+static int
+FindType( const cMarshalType *type )
+{
+  int i;
+  for( i = 0; i < gen_types_num; i++ )
+       if ( gen_types[i].m_type == type )
+            return i;
+
+  return -1;
+}
+
+
+static int
+PathTooLong( const cMarshalType *type )
+{
+  fprintf( stderr, "marshal_gen: %s: type is nested too deep!\n", type->m_name );
+  return -1;
+}
+
+
+static int
+CollectType( const cMarshalType *type, const char *path )
+{
+  if ( FindType( type ) >= 0 )
+       return 0;
+
+  if ( gen_types_num >= dMaxTypes )
+     {
+       fprintf( stderr, "marshal_gen: too many types!\n" );
+       return -1;
+     }
+
+  cGenType *gt = &gen_types[gen_types_num];
+  gt->m_type = type;
+  snprintf( gt->m_path, sizeof( gt->m_path ), "%s", path );
+
+  char name[64];
+  size_t j;
+  for( j = 0; type->m_name[j] && j < sizeof( name ) - 1; j++ )
+     {
+       char c = type->m_name[j];
+       name[j] = ( ( c >= 'a' && c <= 'z' ) || ( c >= 'A' && c <= 'Z' )
+                   || ( c >= '0' && c <= '9' ) ) ? c : '_';
+     }
+  name[j] = 0;
+  snprintf( gt->m_name, sizeof( gt->m_name ), "%03d_%s", gen_types_num, name );
+  gen_types_num++;
+
+  char sub[dMaxPath];
+  int rv = 0;
+
+  switch( type->m_type )
+     {
+       case eMtArray:
+            if ( snprintf( sub, sizeof( sub ), "(%s)->u.m_array.m_element", path ) >= (int)sizeof( sub ) )
+                 return PathTooLong( type );
+            rv = CollectType( type->u.m_array.m_element, sub );
+            break;
+
+       case eMtStruct:
+            {
+              const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+              size_t i;
+              for( i = 0; rv == 0 && elems[i].m_type == eMtStructElement; i++ )
+                 {
+                   const cMarshalType *elem = elems[i].u.m_struct_element.m_element;
+                   char epath[dMaxPath];
+                   if ( snprintf( epath, sizeof( epath ),
+                                  "(%s)->u.m_struct.m_elements[%zu].u.m_struct_element.m_element",
+                                  path, i ) >= (int)sizeof( epath ) )
+                        return PathTooLong( type );
+
+                   if ( elem->m_type == eMtUnion )
+                      {
+                        const size_t mod_idx = elem->u.m_union.m_mod_idx;
+                        if ( mod_idx >= i || !IsIntegerElement( type, mod_idx ) )
+                           {
+                             fprintf( stderr, "marshal_gen: %s:%s: mod field must be an integer before union!\n",
+                                      type->m_name, elems[i].m_name );
+                             return -1;
+                           }
+                        const cMarshalType *arms = &elem->u.m_union.m_elements[0];
+                        size_t a;
+                        for( a = 0; rv == 0 && arms[a].m_type == eMtUnionElement; a++ )
+                           {
+                             if ( snprintf( sub, sizeof( sub ),
+                                            "(%s)->u.m_union.m_elements[%zu].u.m_union_element.m_element",
+                                            epath, a ) >= (int)sizeof( sub ) )
+                                  return PathTooLong( type );
+                             rv = CollectType( arms[a].u.m_union_element.m_element, sub );
+                           }
+                      }
+                   else if ( elem->m_type == eMtVarArray )
+                      {
+                        const size_t nelems_idx = elem->u.m_var_array.m_nelements_idx;
+                        if ( nelems_idx >= i || !IsIntegerElement( type, nelems_idx ) )
+                           {
+                             fprintf( stderr, "marshal_gen: %s:%s: nelements field must be an integer before vararray!\n",
+                                      type->m_name, elems[i].m_name );
+                             return -1;
+                           }
+                        if ( snprintf( sub, sizeof( sub ), "(%s)->u.m_var_array.m_element", epath )
+                             >= (int)sizeof( sub ) )
+                             return PathTooLong( type );
+                        rv = CollectType( elem->u.m_var_array.m_element, sub );
+                      }
+                   else
+                      {
+                        rv = CollectType( elem, epath );
+                      }
+                 }
+            }
+            break;
+
+       case eMtUserDefined:
+       default:
+            break;
+     }
+
+  return rv;
+}
+
+
+/***********************************************************
+ * Emits code that reads integer struct element @idx
+ * of struct @type from "data" into variable @var
+ ***********************************************************/
+static void
+EmitReadInteger( const cMarshalType *type, size_t idx, const char *var )
+{
+  const cMarshalType *elem = &type->u.m_struct.m_elements[idx];
+  const char *tname = SimpleName( elem->u.m_struct_element.m_element->m_type );
+
+  printf( "  {\n" );
+  printf( "    %s v;\n", tname );
+  printf( "    memcpy( &v, data + %zu, sizeof( v ) );\n", elem->u.m_struct_element.m_offset );
+  printf( "    %s = (size_t)v;\n", var );
+  printf( "  }\n" );
+}
+
+
+static void
+EmitMarshalElement( const cMarshalType *type, const char *src, const char *indent )
+{
+  int flat = FlatSize( type );
+
+  if ( flat == 0 )
+       return;
+
+  if ( flat > 0 )
+     {
+       printf( "%smemcpy( b, %s, %d );\n", indent, src, flat );
+       printf( "%sb += %d;\n", indent, flat );
+       return;
+     }
+
+  printf( "%scc = Marshal_%s( %s, b );\n", indent, gen_types[FindType( type )].m_name, src );
+  printf( "%sif ( cc < 0 )\n", indent );
+  printf( "%s     return cc;\n", indent );
+  printf( "%sb += cc;\n", indent );
+}
+
+
+static void
+EmitDemarshalElement( const cMarshalType *type, const char *dst, const char *indent )
+{
+  int flat = FlatSize( type );
+  const char *name = gen_types[FindType( type )].m_name;
+
+  if ( flat == 0 )
+       return;
+
+  if ( flat > 0 && IsByteType( type ) )
+     {
+       printf( "%smemcpy( %s, b, %d );\n", indent, dst, flat );
+       printf( "%sb += %d;\n", indent, flat );
+       return;
+     }
+
+  const char *sname = SimpleName( type->m_type );
+  if ( sname )
+     {
+       printf( "%sDemarshalSwap%d( byte_order, %s, b );\n", indent, flat * 8, dst );
+       printf( "%sb += %d;\n", indent, flat );
+       return;
+     }
+
+  printf( "%scc = Demarshal_%s( byte_order, %s, b );\n", indent, name, dst );
+  printf( "%sif ( cc < 0 )\n", indent );
+  printf( "%s     return cc;\n", indent );
+  printf( "%sb += cc;\n", indent );
+}
+
+
+static void
+EmitVarArray( const cMarshalType *type, size_t idx, int demarshal )
+{
+  const cMarshalType *selem = &type->u.m_struct.m_elements[idx];
+  const cMarshalType *va    = selem->u.m_struct_element.m_element;
+  const cMarshalType *elem  = va->u.m_var_array.m_element;
+  const size_t offset       = selem->u.m_struct_element.m_offset;
+  const size_t elem_sizeof  = va->u.m_var_array.m_element_sizeof;
+  int flat = FlatSize( elem );
+  char ref[64];
+
+  printf( "  // %s\n", selem->m_name );
+  EmitReadInteger( type, va->u.m_var_array.m_nelements_idx, "n" );
+
+  if ( !demarshal )
+     {
+       printf( "  memcpy( &vdata, data + %zu, sizeof( void * ) );\n", offset );
+       if ( flat >= 0 && (size_t)flat == elem_sizeof )
+          {
+            printf( "  memcpy( b, vdata, n * %d );\n", flat );
+            printf( "  b += n * %d;\n", flat );
+            return;
+          }
+       printf( "  for( i = 0; i < n; i++ )\n" );
+       printf( "     {\n" );
+       snprintf( ref, sizeof( ref ), "vdata + i * %zu", elem_sizeof );
+       EmitMarshalElement( elem, ref, "       " );
+       printf( "     }\n" );
+       return;
+     }
+
+  printf( "  vdata = g_new0( unsigned char, n * %zu );\n", elem_sizeof );
+  printf( "  memcpy( data + %zu, &vdata, sizeof( void * ) );\n", offset );
+  if ( flat >= 0 && (size_t)flat == elem_sizeof && IsByteType( elem ) )
+     {
+       printf( "  memcpy( vdata, b, n * %d );\n", flat );
+       printf( "  b += n * %d;\n", flat );
+       return;
+     }
+  if ( flat >= 0 && (size_t)flat == elem_sizeof )
+     {
+       printf( "  if ( byte_order == G_BYTE_ORDER )\n" );
+       printf( "     {\n" );
+       printf( "       memcpy( vdata, b, n * %d );\n", flat );
+       printf( "       b += n * %d;\n", flat );
+       printf( "     }\n" );
+       printf( "  else\n" );
+       printf( "     {\n" );
+       printf( "       for( i = 0; i < n; i++ )\n" );
+       printf( "            b += Demarshal_%s( byte_order, vdata + i * %zu, b );\n",
+               gen_types[FindType( elem )].m_name, elem_sizeof );
+       printf( "     }\n" );
+       return;
+     }
+  printf( "  for( i = 0; i < n; i++ )\n" );
+  printf( "     {\n" );
+  snprintf( ref, sizeof( ref ), "vdata + i * %zu", elem_sizeof );
+  EmitDemarshalElement( elem, ref, "       " );
+  printf( "     }\n" );
+}
+
+
+static void
+EmitUnion( const cMarshalType *type, size_t idx, int demarshal )
+{
+  const cMarshalType *selem = &type->u.m_struct.m_elements[idx];
+  const cMarshalType *un    = selem->u.m_struct_element.m_element;
+  const cMarshalType *arms  = &un->u.m_union.m_elements[0];
+  const size_t offset       = selem->u.m_struct_element.m_offset;
+  char ref[64];
+  size_t a, p;
+
+  snprintf( ref, sizeof( ref ), "data + %zu", offset );
+
+  printf( "  // %s\n", selem->m_name );
+  EmitReadInteger( type, un->u.m_union.m_mod_idx, "mod" );
+  printf( "  switch( mod )\n" );
+  printf( "     {\n" );
+  for( a = 0; arms[a].m_type == eMtUnionElement; a++ )
+     {
+       // the interpreter takes the first matching union element
+       for( p = 0; p < a; p++ )
+            if ( arms[p].u.m_union_element.m_mod == arms[a].u.m_union_element.m_mod )
+                 break;
+       if ( p < a )
+            continue;
+
+       printf( "       case %zuULL:\n", arms[a].u.m_union_element.m_mod );
+       if ( demarshal )
+            EmitDemarshalElement( arms[a].u.m_union_element.m_element, ref, "            " );
+       else
+            EmitMarshalElement( arms[a].u.m_union_element.m_element, ref, "            " );
+       printf( "            break;\n" );
+     }
+  printf( "       default:\n" );
+  printf( "            CRIT( \"%s: %s:%s: invalid mod value %%u!\",\n",
+          demarshal ? "Demarshal" : "Marshal", type->m_name, selem->m_name );
+  printf( "                  (unsigned int)mod );\n" );
+  printf( "            return -EINVAL;\n" );
+  printf( "     }\n" );
+}
+
+
+static void
+EmitTypeFunctions( const cGenType *gt, int demarshal )
+{
+  const cMarshalType *type = gt->m_type;
+  int flat = FlatSize( type );
+
+  if ( demarshal )
+     {
+       printf( "static int\n" );
+       printf( "Demarshal_%s( int byte_order, unsigned char *data, const unsigned char *buffer )\n",
+               gt->m_name );
+     }
+  else
+     {
+       printf( "static int\n" );
+       printf( "Marshal_%s( const unsigned char *data, unsigned char *buffer )\n", gt->m_name );
+     }
+  printf( "{\n" );
+
+  if ( type->m_type == eMtUserDefined )
+     {
+       // no specialization possible, fall back to the interpreter
+       if ( demarshal )
+            printf( "  return Demarshal( byte_order, %s, data, buffer );\n", gt->m_path );
+       else
+            printf( "  return Marshal( %s, data, buffer );\n", gt->m_path );
+       printf( "}\n\n\n" );
+       return;
+     }
+
+  printf( "  %sunsigned char *b = buffer;\n", demarshal ? "const " : "" );
+  printf( "  int cc = 0;\n" );
+  printf( "  size_t i = 0, n = 0, mod = 0;\n" );
+  printf( "  unsigned char *vdata = 0;\n" );
+  printf( "\n" );
+
+  if ( demarshal && flat > 0 && IsByteType( type ) )
+     {
+       printf( "  memcpy( data, buffer, %d );\n", flat );
+       printf( "\n" );
+       printf( "  (void)byte_order; (void)b; (void)cc; (void)i; (void)n; (void)mod; (void)vdata;\n" );
+       printf( "\n" );
+       printf( "  return %d;\n", flat );
+       printf( "}\n\n\n" );
+       return;
+     }
+
+  if ( demarshal && flat > 0 && !SimpleName( type->m_type ) )
+     {
+       // same layout and byte order: bulk copy
+       printf( "  if ( byte_order == G_BYTE_ORDER )\n" );
+       printf( "     {\n" );
+       printf( "       memcpy( data, buffer, %d );\n", flat );
+       printf( "       return %d;\n", flat );
+       printf( "     }\n" );
+       printf( "\n" );
+     }
+
+  if ( SimpleName( type->m_type ) )
+     {
+       if ( demarshal )
+            EmitDemarshalElement( type, "data", "  " );
+       else
+            EmitMarshalElement( type, "data", "  " );
+     }
+  else if ( !demarshal && flat >= 0 )
+     {
+       EmitMarshalElement( type, "data", "  " );
+     }
+  else if ( type->m_type == eMtArray )
+     {
+       const cMarshalType *elem = type->u.m_array.m_element;
+       const size_t elem_sizeof = type->u.m_array.m_element_sizeof;
+       char ref[64];
+
+       snprintf( ref, sizeof( ref ), "data + i * %zu", elem_sizeof );
+       printf( "  for( i = 0; i < %zu; i++ )\n", type->u.m_array.m_nelements );
+       printf( "     {\n" );
+       if ( demarshal )
+            EmitDemarshalElement( elem, ref, "       " );
+       else
+            EmitMarshalElement( elem, ref, "       " );
+       printf( "     }\n" );
+     }
+  else if ( type->m_type == eMtStruct )
+     {
+       const cMarshalType *elems = &type->u.m_struct.m_elements[0];
+       size_t i;
+       for( i = 0; elems[i].m_type == eMtStructElement; i++ )
+          {
+            const cMarshalType *elem = elems[i].u.m_struct_element.m_element;
+
+            if ( elem->m_type == eMtUnion )
+               {
+                 EmitUnion( type, i, demarshal );
+               }
+            else if ( elem->m_type == eMtVarArray )
+               {
+                 EmitVarArray( type, i, demarshal );
+               }
+            else
+               {
+                 char ref[64];
+                 snprintf( ref, sizeof( ref ), "data + %zu", elems[i].u.m_struct_element.m_offset );
+                 printf( "  // %s\n", elems[i].m_name );
+                 if ( demarshal )
+                      EmitDemarshalElement( elem, ref, "  " );
+                 else
+                      EmitMarshalElement( elem, ref, "  " );
+               }
+          }
+     }
+
+  printf( "\n" );
+  printf( "  (void)cc; (void)i; (void)n; (void)mod; (void)vdata;\n" );
+  printf( "\n" );
+  printf( "  return (int)( b - buffer );\n" );
+  printf( "}\n\n\n" );
+}
+
+
+static void
+EmitArrayFunctions( const cHpiMarshal *m, const cMarshalType **types,
+                    const char *suffix, int demarshal )
+{
+  int i;
+
+  printf( "static int\n" );
+  if ( demarshal )
+       printf( "Demarshal_%s%s( int byte_order, void **params, const void *buffer )\n",
+               m->m_name, suffix );
+  else
+       printf( "Marshal_%s%s( const void **params, void *buffer )\n", m->m_name, suffix );
+  printf( "{\n" );
+  printf( "  %sunsigned char *b = buffer;\n", demarshal ? "const " : "" );
+  printf( "  int cc = 0;\n" );
+  printf( "\n" );
+
+  for( i = 0; types[i]; i++ )
+     {
+       char ref[32];
+       snprintf( ref, sizeof( ref ), "params[%d]", i );
+       printf( "  // %s\n", types[i]->m_name );
+       if ( demarshal )
+            EmitDemarshalElement( types[i], ref, "  " );
+       else
+            EmitMarshalElement( types[i], ref, "  " );
+     }
+
+  printf( "\n" );
+  printf( "  (void)cc;\n" );
+  printf( "\n" );
+  printf( "  return (int)( b - (%sunsigned char *)buffer );\n", demarshal ? "const " : "" );
+  printf( "}\n\n\n" );
+}
+
+
+int
+main( int argc, char *argv[] )
+{
+  int id, i;
+  cHpiMarshal *m;
+
+  for( id = 1; ( m = HpiMarshalFind( id ) ) != 0; id++ )
+     {
+       char path[dMaxPath];
+       for( i = 0; m->m_request[i]; i++ )
+          {
+            snprintf( path, sizeof( path ), "HpiMarshalFind( %d )->m_request[%d]", id, i );
+            if ( CollectType( m->m_request[i], path ) )
+                 return 1;
+          }
+       for( i = 0; m->m_reply[i]; i++ )
+          {
+            snprintf( path, sizeof( path ), "HpiMarshalFind( %d )->m_reply[%d]", id, i );
+            if ( CollectType( m->m_reply[i], path ) )
+                 return 1;
+          }
+     }
+
+  printf( "/*\n" );
+  printf( " * WARNING! This file is generated by marshal_gen.\n" );
+  printf( " *          Do not change this file manually.\n" );
+  printf( " */\n\n" );
+  printf( "#include <errno.h>\n" );
+  printf( "#include <stddef.h>\n" );
+  printf( "#include <string.h>\n\n" );
+  printf( "#include <glib.h>\n\n" );
+  printf( "#include <oh_error.h>\n\n" );
+  printf( "#include \"marshal_hpi.h\"\n\n\n" );
+
+  printf( "#define dDemarshalSwap( bits, byte_order, d, b ) \\\n" );
+  printf( "  do { \\\n" );
+  printf( "    guint##bits v; \\\n" );
+  printf( "    memcpy( &v, b, sizeof( v ) ); \\\n" );
+  printf( "    if ( byte_order != G_BYTE_ORDER ) \\\n" );
+  printf( "         v = GUINT##bits##_SWAP_LE_BE( v ); \\\n" );
+  printf( "    memcpy( d, &v, sizeof( v ) ); \\\n" );
+  printf( "  } while( 0 )\n\n" );
+  printf( "#define DemarshalSwap16( byte_order, d, b ) dDemarshalSwap( 16, byte_order, d, b )\n" );
+  printf( "#define DemarshalSwap32( byte_order, d, b ) dDemarshalSwap( 32, byte_order, d, b )\n" );
+  printf( "#define DemarshalSwap64( byte_order, d, b ) dDemarshalSwap( 64, byte_order, d, b )\n\n\n" );
+
+  for( i = 0; i < gen_types_num; i++ )
+     {
+       // flat types are mostly copied inline, so some functions stay unused
+       printf( "static int Marshal_%s( const unsigned char *data, unsigned char *buffer ) G_GNUC_UNUSED;\n",
+               gen_types[i].m_name );
+       printf( "static int Demarshal_%s( int byte_order, unsigned char *data, const unsigned char *buffer ) G_GNUC_UNUSED;\n",
+               gen_types[i].m_name );
+     }
+  printf( "\n\n" );
+
+  for( i = 0; i < gen_types_num; i++ )
+     {
+       EmitTypeFunctions( &gen_types[i], 0 );
+       EmitTypeFunctions( &gen_types[i], 1 );
+     }
+
+  for( id = 1; ( m = HpiMarshalFind( id ) ) != 0; id++ )
+     {
+       EmitArrayFunctions( m, m->m_request, "In", 0 );
+       EmitArrayFunctions( m, m->m_request, "In", 1 );
+       EmitArrayFunctions( m, m->m_reply, "Out", 0 );
+       EmitArrayFunctions( m, m->m_reply, "Out", 1 );
+     }
+
+  printf( "const cHpiMarshalGen hpi_marshal_gen[] =\n" );
+  printf( "{\n" );
+  for( id = 1; ( m = HpiMarshalFind( id ) ) != 0; id++ )
+     {
+       printf( "  {\n" );
+       printf( "    %d, // %s\n", m->m_id, m->m_name );
+       printf( "    Marshal_%sIn,\n", m->m_name );
+       printf( "    Demarshal_%sIn,\n", m->m_name );
+       printf( "    Marshal_%sOut,\n", m->m_name );
+       printf( "    Demarshal_%sOut\n", m->m_name );
+       printf( "  },\n" );
+     }
+  printf( "};\n\n" );
+  printf( "const int hpi_marshal_gen_num = sizeof( hpi_marshal_gen ) / sizeof( cHpiMarshalGen );\n" );
+
+  return 0;
+}
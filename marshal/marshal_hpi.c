@@ -20,6 +20,7 @@
  *     Ulrich Kleber <ulikleber@users.sourceforge.net>
  */
 
+#include <errno.h>
 #include <stddef.h>
 
 #include <oh_error.h>
@@ -2016,6 +2017,171 @@ static const cMarshalType *oHpiInjectEventOut[] =
 };
 
 
+static const cMarshalType *oHpiSensorCacheStatsGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  0
+};
+
+static const cMarshalType *oHpiSensorCacheStatsGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &oHpiSensorCacheStatsType,
+  0
+};
+
+
+static const cMarshalType *oHpiSensorReadingsGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiResourceIdType,
+  &oHpiSensorReadingsType,
+  0
+};
+
+static const cMarshalType *oHpiSensorReadingsGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &oHpiSensorReadingsType,
+  0
+};
+
+
+static const cMarshalType *oHpiSensorHistoryGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiResourceIdType,
+  &SaHpiSensorNumType,
+  &SaHpiTimeType,
+  &SaHpiTimeType,
+  0
+};
+
+static const cMarshalType *oHpiSensorHistoryGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &oHpiSensorHistoryType,
+  0
+};
+
+
+static const cMarshalType *oHpiEventsGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiTimeoutType,
+  &SaHpiUint32Type, // max events
+  &SaHpiUint32Type, // max bytes
+  &SaHpiBoolType, // RDRs wanted
+  &SaHpiBoolType, // RPT entries wanted
+  0
+};
+
+static const cMarshalType *oHpiEventsGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &oHpiEventBatchType,
+  &SaHpiEvtQueueStatusType,
+  0
+};
+
+
+static const cMarshalType *oHpiEventFilterSetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &oHpiEventFilterType,
+  0
+};
+
+static const cMarshalType *oHpiEventFilterSetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  0
+};
+
+
+static const cMarshalType *oHpiEventLogEntriesGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiResourceIdType,
+  &oHpiEventLogRangeType,
+  0
+};
+
+static const cMarshalType *oHpiEventLogEntriesGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &oHpiEventLogBatchType,
+  &SaHpiEventLogEntryIdType,
+  0
+};
+
+
+static const cMarshalType *oHpiHandlerStatusGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &oHpiHandlerIdType,
+  0
+};
+
+static const cMarshalType *oHpiHandlerStatusGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &oHpiHandlerStatusType,
+  0
+};
+
+
+static const cMarshalType *oHpiMemPoolStatsGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiEntryIdType,
+  0
+};
+
+static const cMarshalType *oHpiMemPoolStatsGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &SaHpiEntryIdType,
+  &oHpiMemPoolStatsType,
+  0
+};
+
+static const cMarshalType *oHpiMetricGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiEntryIdType,
+  0
+};
+
+static const cMarshalType *oHpiMetricGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &SaHpiEntryIdType,
+  &oHpiMetricType,
+  0
+};
+
+static const cMarshalType *oHpiIdrGetIn[] =
+{
+  &SaHpiSessionIdType, // session id (SaHpiSessionIdT)
+  &SaHpiResourceIdType,
+  &SaHpiIdrIdType,
+  &SaHpiEntryIdType,
+  &SaHpiUint32Type,
+  &SaHpiUint32Type,
+  0
+};
+
+static const cMarshalType *oHpiIdrGetOut[] =
+{
+  &SaErrorType, // result (SaErrorT)
+  &SaHpiIdrInfoType,
+  &oHpiIdrBatchType,
+  &SaHpiEntryIdType,
+  0
+};
+
+
 static cHpiMarshal hpi_marshal[] =
 {
   dHpiMarshalEntry( saHpiSessionOpen ),
@@ -2149,6 +2315,18 @@ static cHpiMarshal hpi_marshal[] =
   dHpiMarshalEntry( saHpiFumiAutoRollbackDisableSet ),
   dHpiMarshalEntry( saHpiFumiActivateStart ),
   dHpiMarshalEntry( saHpiFumiCleanup ),
+
+  // OpenHPI extensions added after the B.03.01 functions
+  dHpiMarshalEntry( oHpiSensorCacheStatsGet ),
+  dHpiMarshalEntry( oHpiSensorReadingsGet ),
+  dHpiMarshalEntry( oHpiSensorHistoryGet ),
+  dHpiMarshalEntry( oHpiEventsGet ),
+  dHpiMarshalEntry( oHpiEventFilterSet ),
+  dHpiMarshalEntry( oHpiEventLogEntriesGet ),
+  dHpiMarshalEntry( oHpiHandlerStatusGet ),
+  dHpiMarshalEntry( oHpiMemPoolStatsGet ),
+  dHpiMarshalEntry( oHpiMetricGet ),
+  dHpiMarshalEntry( oHpiIdrGet ),
 };
 
 
@@ -2167,10 +2345,40 @@ HpiMarshalFind( int id )
 }
 
 
+/***********************************************************
+ * Gets generated marshallers for the hpi function
+ *
+ * returns 0 if there are no generated marshallers,
+ * in this case the cMarshalType interpreter shall be used
+ ***********************************************************/
+static const cHpiMarshalGen *
+HpiMarshalGenFind( const cHpiMarshal *m )
+{
+#ifndef MARSHAL_INTERPRETER_ONLY
+  int idx = m->m_id - 1;
+
+  if ( idx < 0 || idx >= hpi_marshal_gen_num )
+       return 0;
+  if ( hpi_marshal_gen[idx].m_id != m->m_id )
+       return 0;
+
+  return &hpi_marshal_gen[idx];
+#else
+  return 0;
+#endif
+}
+
+
 int
 HpiMarshalRequest( cHpiMarshal *m, void *buffer, const void **param )
 {
-    int cc = MarshalArray( m->m_request, param, buffer );
+    const cHpiMarshalGen *g = HpiMarshalGenFind( m );
+    int cc;
+    if ( g ) {
+        cc = g->m_marshal_request( param, buffer );
+    } else {
+        cc = MarshalArray( m->m_request, param, buffer );
+    }
     if ( cc < 0 ) {
         CRIT( "%s: HpiMarshalRequest: failure, cc = %d", m->m_name, cc );
     }
@@ -2259,7 +2467,13 @@ HpiMarshalRequest6( cHpiMarshal *m, void *buffer, const void *p1, const void *p2
 int
 HpiDemarshalRequest( int byte_order, cHpiMarshal *m, const void *buffer, void **params )
 {
-    int cc = DemarshalArray( byte_order, m->m_request, params, buffer );
+    const cHpiMarshalGen *g = HpiMarshalGenFind( m );
+    int cc;
+    if ( g ) {
+        cc = g->m_demarshal_request( byte_order, params, buffer );
+    } else {
+        cc = DemarshalArray( byte_order, m->m_request, params, buffer );
+    }
     if ( cc < 0 ) {
         CRIT( "%s: HpiDemarshalRequest: failure, cc = %d", m->m_name, cc );
     }
@@ -2348,9 +2562,15 @@ HpiMarshalReply( cHpiMarshal *m, void *buffer, const void **params )
     // the first value is the result.
     SaErrorT err = *(const SaErrorT *)params[0];
 
+    // NB m can be 0 here if the daemon rejects an unknown RPC id
     int cc;
     if ( err == SA_OK ) {
-        cc = MarshalArray( m->m_reply, params, buffer );
+        const cHpiMarshalGen *g = HpiMarshalGenFind( m );
+        if ( g ) {
+            cc = g->m_marshal_reply( params, buffer );
+        } else {
+            cc = MarshalArray( m->m_reply, params, buffer );
+        }
     } else {
         cc = Marshal( &SaErrorType, &err, buffer );
     }
@@ -2450,7 +2670,12 @@ HpiDemarshalReply( int byte_order, cHpiMarshal *m, const void *buffer, void **pa
     if ( cc > 0 ) {
         SaErrorT err = *(SaErrorT *)params[0];
         if ( err == SA_OK ) {
-            cc = DemarshalArray( byte_order, m->m_reply, params, buffer );
+            const cHpiMarshalGen *g = HpiMarshalGenFind( m );
+            if ( g ) {
+                cc = g->m_demarshal_reply( byte_order, params, buffer );
+            } else {
+                cc = DemarshalArray( byte_order, m->m_reply, params, buffer );
+            }
         }
     }
     if ( cc < 0 ) {
@@ -2534,3 +2759,101 @@ HpiDemarshalReply5( int byte_order, cHpiMarshal *m, const void *buffer, void *re
 
   return HpiDemarshalReply( byte_order, m, buffer, param );
 }
+
+
+/***********************************************************
+ * Version aware variants of the functions above.
+ * dHpiRpcVersion1 payloads are handled as above,
+ * dHpiRpcVersion2 payloads use the compact encoding.
+ ***********************************************************/
+
+int
+HpiMarshalRequestVersion( int rpc_version, cHpiMarshal *m, void *buffer, const void **params )
+{
+    int cc;
+    if ( rpc_version == dHpiRpcVersion1 ) {
+        return HpiMarshalRequest( m, buffer, params );
+    } else if ( rpc_version == dHpiRpcVersion2 ) {
+        cc = MarshalCompactArray( m->m_request, params, buffer );
+    } else {
+        cc = -EINVAL;
+    }
+    if ( cc < 0 ) {
+        CRIT( "%s: HpiMarshalRequestVersion %d: failure, cc = %d", m->m_name, rpc_version, cc );
+    }
+    return cc;
+}
+
+
+int
+HpiDemarshalRequestVersion( int rpc_version, int byte_order, cHpiMarshal *m, const void *buffer, void **params )
+{
+    int cc;
+    if ( rpc_version == dHpiRpcVersion1 ) {
+        return HpiDemarshalRequest( byte_order, m, buffer, params );
+    } else if ( rpc_version == dHpiRpcVersion2 ) {
+        cc = DemarshalCompactArray( byte_order, m->m_request, params, buffer );
+    } else {
+        cc = -EINVAL;
+    }
+    if ( cc < 0 ) {
+        CRIT( "%s: HpiDemarshalRequestVersion %d: failure, cc = %d", m->m_name, rpc_version, cc );
+    }
+    return cc;
+}
+
+
+int
+HpiMarshalReplyVersion( int rpc_version, cHpiMarshal *m, void *buffer, const void **params )
+{
+    if ( rpc_version == dHpiRpcVersion1 ) {
+        return HpiMarshalReply( m, buffer, params );
+    } else if ( rpc_version != dHpiRpcVersion2 ) {
+        CRIT( "HpiMarshalReplyVersion: unsupported RPC version %d", rpc_version );
+        return -EINVAL;
+    }
+
+    // the first value is the result.
+    SaErrorT err = *(const SaErrorT *)params[0];
+
+    // NB m can be 0 here if the daemon rejects an unknown RPC id
+    int cc;
+    if ( err == SA_OK ) {
+        cc = MarshalCompactArray( m->m_reply, params, buffer );
+    } else {
+        cc = MarshalCompact( &SaErrorType, &err, buffer );
+    }
+    if ( cc < 0 ) {
+        CRIT( "%s: HpiMarshalReplyVersion: failure, cc = %d", m->m_name, cc );
+    }
+
+    return cc;
+}
+
+
+int
+HpiDemarshalReplyVersion( int rpc_version, int byte_order, cHpiMarshal *m, const void *buffer, void **params )
+{
+    if ( rpc_version == dHpiRpcVersion1 ) {
+        return HpiDemarshalReply( byte_order, m, buffer, params );
+    } else if ( rpc_version != dHpiRpcVersion2 ) {
+        CRIT( "%s: HpiDemarshalReplyVersion: unsupported RPC version %d",
+              m->m_name, rpc_version );
+        return -EINVAL;
+    }
+
+    int cc;
+    // the first value is the error code
+    cc = DemarshalCompact( byte_order, &SaErrorType, params[0], buffer );
+    if ( cc > 0 ) {
+        SaErrorT err = *(SaErrorT *)params[0];
+        if ( err == SA_OK ) {
+            cc = DemarshalCompactArray( byte_order, m->m_reply, params, buffer );
+        }
+    }
+    if ( cc < 0 ) {
+        CRIT( "%s: HpiDemarshalReplyVersion: failure, cc = %d", m->m_name, cc );
+    }
+
+    return cc;
+}
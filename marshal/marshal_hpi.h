@@ -166,6 +166,18 @@ typedef enum
   eFsaHpiFumiActivateStart,
   eFsaHpiFumiCleanup,
 
+  // OpenHPI extensions added after the B.03.01 functions
+  eFoHpiSensorCacheStatsGet,
+  eFoHpiSensorReadingsGet,
+  eFoHpiSensorHistoryGet,
+  eFoHpiEventsGet,
+  eFoHpiEventFilterSet,
+  eFoHpiEventLogEntriesGet,
+  eFoHpiHandlerStatusGet,
+  eFoHpiMemPoolStatsGet,
+  eFoHpiMetricGet,
+  eFoHpiIdrGet,
+
 } tHpiFucntionId;
 
 
@@ -189,6 +201,36 @@ typedef struct
 
 cHpiMarshal *HpiMarshalFind( int id );
 
+
+// Type-specialized marshallers generated from hpi_marshal[] by marshal_gen.
+// They produce the same wire format as MarshalArray()/DemarshalArray().
+typedef int (*tHpiMarshalGenFunction)( const void **params, void *buffer );
+typedef int (*tHpiDemarshalGenFunction)( int byte_order, void **params, const void *buffer );
+
+typedef struct
+{
+  int                      m_id;
+  tHpiMarshalGenFunction   m_marshal_request;
+  tHpiDemarshalGenFunction m_demarshal_request;
+  tHpiMarshalGenFunction   m_marshal_reply;
+  tHpiDemarshalGenFunction m_demarshal_reply;
+} cHpiMarshalGen;
+
+#ifndef MARSHAL_INTERPRETER_ONLY
+extern const cHpiMarshalGen hpi_marshal_gen[];
+extern const int hpi_marshal_gen_num;
+#endif
+
+
+// RPC payload encodings, see dMhRpcVersion in transport/strmsock.h
+#define dHpiRpcVersion1 1 // fixed size fields, MarshalArray()
+#define dHpiRpcVersion2 2 // compact encoding, MarshalCompactArray()
+
+int HpiMarshalRequestVersion  ( int rpc_version, cHpiMarshal *m, void *buffer, const void **params );
+int HpiDemarshalRequestVersion( int rpc_version, int byte_order, cHpiMarshal *m, const void *buffer, void **params );
+int HpiMarshalReplyVersion    ( int rpc_version, cHpiMarshal *m, void *buffer, const void **params );
+int HpiDemarshalReplyVersion  ( int rpc_version, int byte_order, cHpiMarshal *m, const void *buffer, void **params );
+
 int HpiMarshalRequest ( cHpiMarshal *m, void *buffer, const void **params );
 int HpiMarshalRequest1( cHpiMarshal *m, void *buffer, const void *p1 );
 int HpiMarshalRequest2( cHpiMarshal *m, void *buffer, const void *p1, const void *p2 );
@@ -1145,3 +1145,194 @@ static cMarshalType oHpiGlobalParamTypeElements[] =
 
 cMarshalType oHpiGlobalParamType = dStruct( oHpiGlobalParamTypeElements );
 
+
+// sensor reading cache statistics
+static cMarshalType oHpiSensorCacheStatsTypeElements[] =
+{
+  dStructElement( oHpiSensorCacheStatsT, Hits, SaHpiUint64Type ),
+  dStructElement( oHpiSensorCacheStatsT, Misses, SaHpiUint64Type ),
+  dStructElement( oHpiSensorCacheStatsT, Coalesced, SaHpiUint64Type ),
+  dStructElement( oHpiSensorCacheStatsT, Invalidations, SaHpiUint64Type ),
+  dStructElement( oHpiSensorCacheStatsT, Entries, SaHpiUint32Type ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiSensorCacheStatsType = dStruct( oHpiSensorCacheStatsTypeElements );
+
+
+// batched sensor readings
+static cMarshalType oHpiSensorReadingTypeElements[] =
+{
+  dStructElement( oHpiSensorReadingT, Num, SaHpiSensorNumType ),
+  dStructElement( oHpiSensorReadingT, Result, SaErrorType ),
+  dStructElement( oHpiSensorReadingT, Reading, SaHpiSensorReadingType ),
+  dStructElement( oHpiSensorReadingT, EventState, SaHpiEventStateType ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiSensorReadingType = dStruct( oHpiSensorReadingTypeElements );
+
+static cMarshalType oHpiSensorReadingsArray = dArray( "oHpiSensorReadingsArray", OH_MAX_SENSOR_READINGS, oHpiSensorReadingT, oHpiSensorReadingType );
+
+static cMarshalType oHpiSensorReadingsTypeElements[] =
+{
+  dStructElement( oHpiSensorReadingsT, NumberOfReadings, SaHpiUint32Type ),
+  dStructElement( oHpiSensorReadingsT, Readings, oHpiSensorReadingsArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiSensorReadingsType = dStruct( oHpiSensorReadingsTypeElements );
+
+
+// sensor history
+static cMarshalType oHpiSensorSampleTypeElements[] =
+{
+  dStructElement( oHpiSensorSampleT, Timestamp, SaHpiTimeType ),
+  dStructElement( oHpiSensorSampleT, Value, SaHpiFloat64Type ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiSensorSampleType = dStruct( oHpiSensorSampleTypeElements );
+
+static cMarshalType oHpiSensorSamplesArray = dArray( "oHpiSensorSamplesArray", OH_MAX_SENSOR_SAMPLES, oHpiSensorSampleT, oHpiSensorSampleType );
+
+static cMarshalType oHpiSensorHistoryTypeElements[] =
+{
+  dStructElement( oHpiSensorHistoryT, Count, SaHpiUint32Type ),
+  dStructElement( oHpiSensorHistoryT, Min, SaHpiFloat64Type ),
+  dStructElement( oHpiSensorHistoryT, Max, SaHpiFloat64Type ),
+  dStructElement( oHpiSensorHistoryT, Avg, SaHpiFloat64Type ),
+  dStructElement( oHpiSensorHistoryT, NumberOfSamples, SaHpiUint32Type ),
+  dStructElement( oHpiSensorHistoryT, Samples, oHpiSensorSamplesArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiSensorHistoryType = dStruct( oHpiSensorHistoryTypeElements );
+
+static cMarshalType oHpiEventFilterResourcesArray = dArray( "oHpiEventFilterResourcesArray", OH_MAX_FILTER_RESOURCES, SaHpiResourceIdT, SaHpiResourceIdType );
+static cMarshalType oHpiEventFilterSensorTypesArray = dArray( "oHpiEventFilterSensorTypesArray", OH_MAX_FILTER_SENSOR_TYPES, SaHpiSensorTypeT, SaHpiSensorTypeType );
+static cMarshalType oHpiEventFilterTypeElements[] =
+{
+  dStructElement( oHpiEventFilterT, EventTypes, SaHpiUint32Type ),
+  dStructElement( oHpiEventFilterT, MinSeverity, SaHpiSeverityType ),
+  dStructElement( oHpiEventFilterT, NumberOfResources, SaHpiUint32Type ),
+  dStructElement( oHpiEventFilterT, Resources, oHpiEventFilterResourcesArray ),
+  dStructElement( oHpiEventFilterT, EntityPathPattern, SaHpiTextBufferType ),
+  dStructElement( oHpiEventFilterT, NumberOfSensorTypes, SaHpiUint32Type ),
+  dStructElement( oHpiEventFilterT, SensorTypes, oHpiEventFilterSensorTypesArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiEventFilterType = dStruct( oHpiEventFilterTypeElements );
+
+static cMarshalType EventBatchEventsArray = dVarArray( "EventBatchEventsArray", 0, SaHpiEventT, SaHpiEventType );
+static cMarshalType EventBatchRdrsArray = dVarArray( "EventBatchRdrsArray", 2, SaHpiRdrT, SaHpiRdrType );
+static cMarshalType EventBatchRptEntriesArray = dVarArray( "EventBatchRptEntriesArray", 4, SaHpiRptEntryT, SaHpiRptEntryType );
+static cMarshalType oHpiEventBatchTypeElements[] =
+{
+  dStructElement( oHpiEventBatchT, NumberOfEvents, SaHpiUint32Type ),
+  dStructElement( oHpiEventBatchT, Events, EventBatchEventsArray ),
+  dStructElement( oHpiEventBatchT, NumberOfRdrs, SaHpiUint32Type ),
+  dStructElement( oHpiEventBatchT, Rdrs, EventBatchRdrsArray ),
+  dStructElement( oHpiEventBatchT, NumberOfRptEntries, SaHpiUint32Type ),
+  dStructElement( oHpiEventBatchT, RptEntries, EventBatchRptEntriesArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiEventBatchType = dStruct( oHpiEventBatchTypeElements );
+
+static cMarshalType oHpiEventLogRangeTypeElements[] =
+{
+  dStructElement( oHpiEventLogRangeT, StartEntryId, SaHpiEventLogEntryIdType ),
+  dStructElement( oHpiEventLogRangeT, MaxEntries, SaHpiUint32Type ),
+  dStructElement( oHpiEventLogRangeT, StartTime, SaHpiTimeType ),
+  dStructElement( oHpiEventLogRangeT, EndTime, SaHpiTimeType ),
+  dStructElement( oHpiEventLogRangeT, WantRdrs, SaHpiBoolType ),
+  dStructElement( oHpiEventLogRangeT, WantRptEntries, SaHpiBoolType ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiEventLogRangeType = dStruct( oHpiEventLogRangeTypeElements );
+
+static cMarshalType EventLogBatchEntriesArray = dVarArray( "EventLogBatchEntriesArray", 0, SaHpiEventLogEntryT, SaHpiEventLogEntryType );
+static cMarshalType EventLogBatchRdrsArray = dVarArray( "EventLogBatchRdrsArray", 2, SaHpiRdrT, SaHpiRdrType );
+static cMarshalType EventLogBatchRptEntriesArray = dVarArray( "EventLogBatchRptEntriesArray", 4, SaHpiRptEntryT, SaHpiRptEntryType );
+static cMarshalType oHpiEventLogBatchTypeElements[] =
+{
+  dStructElement( oHpiEventLogBatchT, NumberOfEntries, SaHpiUint32Type ),
+  dStructElement( oHpiEventLogBatchT, Entries, EventLogBatchEntriesArray ),
+  dStructElement( oHpiEventLogBatchT, NumberOfRdrs, SaHpiUint32Type ),
+  dStructElement( oHpiEventLogBatchT, Rdrs, EventLogBatchRdrsArray ),
+  dStructElement( oHpiEventLogBatchT, NumberOfRptEntries, SaHpiUint32Type ),
+  dStructElement( oHpiEventLogBatchT, RptEntries, EventLogBatchRptEntriesArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiEventLogBatchType = dStruct( oHpiEventLogBatchTypeElements );
+
+
+
+// handler status
+static cMarshalType oHpiHandlerStatusTypeElements[] =
+{
+  dStructElement( oHpiHandlerStatusT, State, oHpiHandlerStateType ),
+  dStructElement( oHpiHandlerStatusT, SnapshotTimestamp, SaHpiTimeType ),
+  dStructElement( oHpiHandlerStatusT, SnapshotResources, SaHpiUint32Type ),
+  dStructElement( oHpiHandlerStatusT, StaleResources, SaHpiUint32Type ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiHandlerStatusType = dStruct( oHpiHandlerStatusTypeElements );
+
+
+// object pool statistics
+static cMarshalType oHpiMemPoolStatsTypeElements[] =
+{
+  dStructElement( oHpiMemPoolStatsT, Name, SaHpiTextBufferType ),
+  dStructElement( oHpiMemPoolStatsT, ObjectSize, SaHpiUint32Type ),
+  dStructElement( oHpiMemPoolStatsT, Slabs, SaHpiUint32Type ),
+  dStructElement( oHpiMemPoolStatsT, Capacity, SaHpiUint32Type ),
+  dStructElement( oHpiMemPoolStatsT, Free, SaHpiUint32Type ),
+  dStructElement( oHpiMemPoolStatsT, Cached, SaHpiUint32Type ),
+  dStructElement( oHpiMemPoolStatsT, Allocs, SaHpiUint64Type ),
+  dStructElement( oHpiMemPoolStatsT, Frees, SaHpiUint64Type ),
+  dStructElement( oHpiMemPoolStatsT, HeapAllocs, SaHpiUint64Type ),
+  dStructElement( oHpiMemPoolStatsT, HeapFrees, SaHpiUint64Type ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiMemPoolStatsType = dStruct( oHpiMemPoolStatsTypeElements );
+
+
+// daemon metrics
+static cMarshalType oHpiMetricBucketsArray = dArray( "oHpiMetricBucketsArray", OHPI_METRIC_BUCKETS, SaHpiUint32T, SaHpiUint32Type );
+
+static cMarshalType oHpiMetricTypeElements[] =
+{
+  dStructElement( oHpiMetricT, Type, oHpiMetricTypeType ),
+  dStructElement( oHpiMetricT, HandlerId, oHpiHandlerIdType ),
+  dStructElement( oHpiMetricT, Name, SaHpiTextBufferType ),
+  dStructElement( oHpiMetricT, Count, SaHpiUint64Type ),
+  dStructElement( oHpiMetricT, Sum, SaHpiUint64Type ),
+  dStructElement( oHpiMetricT, Max, SaHpiUint64Type ),
+  dStructElement( oHpiMetricT, Current, SaHpiUint32Type ),
+  dStructElement( oHpiMetricT, Buckets, oHpiMetricBucketsArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiMetricType = dStruct( oHpiMetricTypeElements );
+
+
+// oHpiIdrGet
+static cMarshalType IdrBatchAreasArray = dVarArray( "IdrBatchAreasArray", 0, SaHpiIdrAreaHeaderT, SaHpiIdrAreaHeaderType );
+static cMarshalType IdrBatchFieldsArray = dVarArray( "IdrBatchFieldsArray", 2, SaHpiIdrFieldT, SaHpiIdrFieldType );
+static cMarshalType oHpiIdrBatchTypeElements[] =
+{
+  dStructElement( oHpiIdrBatchT, NumberOfAreas, SaHpiUint32Type ),
+  dStructElement( oHpiIdrBatchT, Areas, IdrBatchAreasArray ),
+  dStructElement( oHpiIdrBatchT, NumberOfFields, SaHpiUint32Type ),
+  dStructElement( oHpiIdrBatchT, Fields, IdrBatchFieldsArray ),
+  dStructElementEnd()
+};
+
+cMarshalType oHpiIdrBatchType = dStruct( oHpiIdrBatchTypeElements );
@@ -298,6 +298,62 @@ extern cMarshalType oHpiHandlerConfigType;
 extern cMarshalType oHpiHandlerInfoType;
 #define oHpiGlobalParamTypeType SaHpiUint32Type
 extern cMarshalType oHpiGlobalParamType;
+extern cMarshalType oHpiSensorCacheStatsType;
+extern cMarshalType oHpiSensorReadingType;
+extern cMarshalType oHpiSensorReadingsType;
+extern cMarshalType oHpiSensorSampleType;
+extern cMarshalType oHpiSensorHistoryType;
+extern cMarshalType oHpiEventFilterType;
+
+// oHpiEventsGet reply, Rdrs and RptEntries are empty if not requested
+typedef struct {
+	SaHpiUint32T NumberOfEvents;
+	SaHpiEventT *Events;
+	SaHpiUint32T NumberOfRdrs;
+	SaHpiRdrT *Rdrs;
+	SaHpiUint32T NumberOfRptEntries;
+	SaHpiRptEntryT *RptEntries;
+} oHpiEventBatchT;
+extern cMarshalType oHpiEventBatchType;
+
+// oHpiEventLogEntriesGet request
+typedef struct {
+	SaHpiEventLogEntryIdT StartEntryId;
+	SaHpiUint32T MaxEntries;
+	SaHpiTimeT StartTime;
+	SaHpiTimeT EndTime;
+	SaHpiBoolT WantRdrs;
+	SaHpiBoolT WantRptEntries;
+} oHpiEventLogRangeT;
+extern cMarshalType oHpiEventLogRangeType;
+
+// oHpiEventLogEntriesGet reply, Rdrs and RptEntries are empty if not requested
+typedef struct {
+	SaHpiUint32T NumberOfEntries;
+	SaHpiEventLogEntryT *Entries;
+	SaHpiUint32T NumberOfRdrs;
+	SaHpiRdrT *Rdrs;
+	SaHpiUint32T NumberOfRptEntries;
+	SaHpiRptEntryT *RptEntries;
+} oHpiEventLogBatchT;
+extern cMarshalType oHpiEventLogBatchType;
+
+#define oHpiHandlerStateType SaHpiUint32Type
+extern cMarshalType oHpiHandlerStatusType;
+
+extern cMarshalType oHpiMemPoolStatsType;
+
+#define oHpiMetricTypeType SaHpiUint32Type
+extern cMarshalType oHpiMetricType;
+
+// oHpiIdrGet reply, the fields follow in the order of the areas
+typedef struct {
+	SaHpiUint32T NumberOfAreas;
+	SaHpiIdrAreaHeaderT *Areas;
+	SaHpiUint32T NumberOfFields;
+	SaHpiIdrFieldT *Fields;
+} oHpiIdrBatchT;
+extern cMarshalType oHpiIdrBatchType;
 
 #ifdef __cplusplus
 }
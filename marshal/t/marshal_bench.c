@@ -0,0 +1,273 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Marshal benchmarks for RDR and event sized messages,
+ * in the fixed (dHpiRpcVersion1) and compact (dHpiRpcVersion2)
+ * encodings. The size is the number of different messages
+ * that are marshalled in turn.
+ *
+ * Usage: marshal_bench [size...]
+ */
+
+#include <glib.h>
+#include <SaHpi.h>
+#include "marshal_hpi.h"
+#include "bench.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#define dBufferSize 4096
+#define dMaxParams  8
+
+
+static const guint default_sizes[] = { 1, 16, 256, 4096 };
+
+
+typedef struct
+{
+  SaErrorT             m_rv;
+  SaHpiSessionIdT      m_sid;
+  SaHpiEntryIdT        m_next;
+  SaHpiEventT          m_event;
+  SaHpiRdrT            m_rdr;
+  SaHpiRptEntryT       m_rpte;
+  SaHpiEvtQueueStatusT m_status;
+} cPayload;
+
+
+typedef struct
+{
+  const char *m_name;
+  int         m_id;
+  int         m_reply;     // 0: request
+  int         m_demarshal; // 0: marshal
+  int         m_version;
+} cBenchCase;
+
+
+static const cBenchCase cases[] =
+{
+  { "MarshalRequest saHpiEventAdd",    eFsaHpiEventAdd, 0, 0, dHpiRpcVersion1 },
+  { "DemarshalRequest saHpiEventAdd",  eFsaHpiEventAdd, 0, 1, dHpiRpcVersion1 },
+  { "MarshalReply saHpiRdrGet",        eFsaHpiRdrGet,   1, 0, dHpiRpcVersion1 },
+  { "DemarshalReply saHpiRdrGet",      eFsaHpiRdrGet,   1, 1, dHpiRpcVersion1 },
+  { "MarshalReply saHpiEventGet",      eFsaHpiEventGet, 1, 0, dHpiRpcVersion1 },
+  { "DemarshalReply saHpiEventGet",    eFsaHpiEventGet, 1, 1, dHpiRpcVersion1 },
+  { "MarshalReply saHpiRdrGet v2",     eFsaHpiRdrGet,   1, 0, dHpiRpcVersion2 },
+  { "DemarshalReply saHpiRdrGet v2",   eFsaHpiRdrGet,   1, 1, dHpiRpcVersion2 },
+  { "MarshalReply saHpiEventGet v2",   eFsaHpiEventGet, 1, 0, dHpiRpcVersion2 },
+  { "DemarshalReply saHpiEventGet v2", eFsaHpiEventGet, 1, 1, dHpiRpcVersion2 },
+  { 0, 0, 0, 0, 0 }
+};
+
+static const cBenchCase *current = 0;
+
+
+static void
+SetText( SaHpiTextBufferT *tb, const char *text )
+{
+  tb->DataType   = SAHPI_TL_TYPE_TEXT;
+  tb->Language   = SAHPI_LANG_ENGLISH;
+  tb->DataLength = strlen( text );
+  memcpy( tb->Data, text, tb->DataLength );
+}
+
+
+static void
+FillPayload( cPayload *p, guint i )
+{
+  SaHpiSensorRecT *s = &p->m_rdr.RdrTypeUnion.SensorRec;
+  SaHpiSensorEventT *se = &p->m_event.EventDataUnion.SensorEvent;
+  int j;
+
+  memset( p, 0, sizeof( cPayload ) );
+  p->m_rv   = SA_OK;
+  p->m_sid  = 1;
+  p->m_next = i + 2;
+
+  p->m_rpte.EntryId = p->m_rpte.ResourceId = i % 64 + 1;
+  for( j = 0; j < 3; j++ )
+     {
+       p->m_rpte.ResourceEntity.Entry[j].EntityType = SAHPI_ENT_SYSTEM_BLADE + j;
+       p->m_rpte.ResourceEntity.Entry[j].EntityLocation = i + j;
+     }
+  p->m_rpte.ResourceEntity.Entry[3].EntityType = SAHPI_ENT_ROOT;
+  p->m_rpte.ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE | SAHPI_CAPABILITY_RDR
+                                   | SAHPI_CAPABILITY_SENSOR;
+  p->m_rpte.ResourceSeverity = SAHPI_MAJOR;
+  SetText( &p->m_rpte.ResourceTag, "Blade resource tag" );
+
+  p->m_rdr.RecordId = i + 1;
+  p->m_rdr.RdrType  = SAHPI_SENSOR_RDR;
+  p->m_rdr.Entity   = p->m_rpte.ResourceEntity;
+  s->Num        = i;
+  s->Type       = SAHPI_TEMPERATURE;
+  s->Category   = SAHPI_EC_THRESHOLD;
+  s->EnableCtrl = SAHPI_TRUE;
+  s->EventCtrl  = SAHPI_SEC_PER_EVENT;
+  s->Events     = SAHPI_ES_UPPER_MINOR | SAHPI_ES_UPPER_MAJOR | SAHPI_ES_UPPER_CRIT;
+  s->DataFormat.IsSupported = SAHPI_TRUE;
+  s->DataFormat.ReadingType = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+  s->DataFormat.BaseUnits   = SAHPI_SU_DEGREES_C;
+  s->DataFormat.Range.Flags = SAHPI_SRF_MIN | SAHPI_SRF_MAX;
+  s->DataFormat.Range.Max.IsSupported = SAHPI_TRUE;
+  s->DataFormat.Range.Max.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+  s->DataFormat.Range.Max.Value.SensorFloat64 = 125.0;
+  s->DataFormat.Range.Min.IsSupported = SAHPI_TRUE;
+  s->DataFormat.Range.Min.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+  s->DataFormat.Range.Min.Value.SensorFloat64 = -40.0;
+  s->ThresholdDefn.IsAccessible = SAHPI_TRUE;
+  s->ThresholdDefn.ReadThold = SAHPI_STM_UP_MINOR | SAHPI_STM_UP_MAJOR | SAHPI_STM_UP_CRIT;
+  SetText( &p->m_rdr.IdString, "CPU temperature sensor" );
+
+  p->m_event.Source    = p->m_rpte.ResourceId;
+  p->m_event.EventType = SAHPI_ET_SENSOR;
+  p->m_event.Timestamp = (SaHpiTimeT)i * 1000000;
+  p->m_event.Severity  = SAHPI_MINOR;
+  se->SensorNum     = s->Num;
+  se->SensorType    = s->Type;
+  se->EventCategory = s->Category;
+  se->Assertion     = SAHPI_TRUE;
+  se->EventState    = SAHPI_ES_UPPER_MINOR;
+  se->OptionalDataPresent = SAHPI_SOD_TRIGGER_READING | SAHPI_SOD_CURRENT_STATE;
+  se->TriggerReading.IsSupported = SAHPI_TRUE;
+  se->TriggerReading.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+  se->TriggerReading.Value.SensorFloat64 = 80.0 + i % 10;
+  se->CurrentState = SAHPI_ES_UPPER_MINOR;
+
+  p->m_status = 0;
+}
+
+
+static void
+PayloadParams( const cBenchCase *c, cPayload *p, void **params )
+{
+  if ( !c->m_reply )
+     {
+       // saHpiEventAdd
+       params[0] = &p->m_sid;
+       params[1] = &p->m_event;
+       params[2] = 0;
+     }
+  else if ( c->m_id == eFsaHpiRdrGet )
+     {
+       params[0] = &p->m_rv;
+       params[1] = &p->m_next;
+       params[2] = &p->m_rdr;
+       params[3] = 0;
+     }
+  else
+     {
+       params[0] = &p->m_rv;
+       params[1] = &p->m_event;
+       params[2] = &p->m_rdr;
+       params[3] = &p->m_rpte;
+       params[4] = &p->m_status;
+       params[5] = 0;
+     }
+}
+
+
+static int
+DoMarshal( const cBenchCase *c, cHpiMarshal *m, cPayload *p, void *buffer )
+{
+  void *params[dMaxParams];
+
+  PayloadParams( c, p, params );
+
+  if ( c->m_reply )
+       return HpiMarshalReplyVersion( c->m_version, m, buffer, (const void **)params );
+
+  return HpiMarshalRequestVersion( c->m_version, m, buffer, (const void **)params );
+}
+
+
+static int
+DoDemarshal( const cBenchCase *c, cHpiMarshal *m, cPayload *p, const void *buffer )
+{
+  void *params[dMaxParams];
+
+  PayloadParams( c, p, params );
+
+  if ( c->m_reply )
+       return HpiDemarshalReplyVersion( c->m_version, G_BYTE_ORDER, m, buffer, params );
+
+  return HpiDemarshalRequestVersion( c->m_version, G_BYTE_ORDER, m, buffer, params );
+}
+
+
+static guint64
+RunCase( guint size, guint64 *ops )
+{
+  const cBenchCase *c = current;
+  cHpiMarshal *m = HpiMarshalFind( c->m_id );
+  guint rounds = bench_rounds( size, BENCH_MIN_OPS );
+  cPayload *payloads = g_new( cPayload, size );
+  unsigned char *buffers = (unsigned char *)g_malloc( (gsize)size * dBufferSize );
+  cPayload out;
+  guint64 start, total;
+  guint r, i;
+
+  for( i = 0; i < size; i++ )
+     {
+       FillPayload( &payloads[i], i );
+       if ( DoMarshal( c, m, &payloads[i], buffers + (gsize)i * dBufferSize ) < 0 )
+          {
+            fprintf( stderr, "%s: marshal failed\n", c->m_name );
+            exit( 1 );
+          }
+     }
+
+  start = bench_now();
+
+  for( r = 0; r < rounds; r++ )
+     {
+       for( i = 0; i < size; i++ )
+          {
+            unsigned char *buffer = buffers + (gsize)i * dBufferSize;
+
+            if ( c->m_demarshal )
+                 DoDemarshal( c, m, &out, buffer );
+            else
+                 DoMarshal( c, m, &payloads[i], buffer );
+          }
+     }
+
+  total = bench_now() - start;
+
+  g_free( buffers );
+  g_free( payloads );
+  *ops = (guint64)rounds * size;
+
+  return total;
+}
+
+
+int
+main( int argc, char *argv[] )
+{
+  GArray *sizes = bench_sizes( argc, argv, default_sizes,
+                               G_N_ELEMENTS( default_sizes ) );
+  guint i;
+
+  bench_header( "marshal_bench" );
+
+  for( i = 0; i < sizes->len; i++ )
+     {
+       guint size = g_array_index( sizes, guint, i );
+
+       for( current = cases; current->m_name; current++ )
+            bench_run( current->m_name, RunCase, size );
+     }
+
+  g_array_free( sizes, TRUE );
+
+  return 0;
+}
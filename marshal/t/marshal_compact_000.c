@@ -0,0 +1,363 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Checks that the compact encoding (RPC version 2) gives
+ * the same demarshaled data as the fixed size encoding.
+ */
+
+#include <glib.h>
+#include "marshal_hpi.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#define dParamSize  16384
+#define dBufferSize 65536
+#define dMaxParams  8
+
+
+static unsigned char in[dMaxParams][dParamSize];
+static unsigned char out1[dMaxParams][dParamSize];
+static unsigned char out2[dMaxParams][dParamSize];
+static unsigned char buf1[dBufferSize];
+static unsigned char buf2[dBufferSize];
+
+
+static int
+num_params( const cMarshalType **types )
+{
+  int n = 0;
+  while( types[n] )
+       n++;
+  return n;
+}
+
+
+// returns compact size or -1
+static int
+check_types( const char *name, const cMarshalType **types, int cmp_params )
+{
+  const void *iparams[dMaxParams];
+  void *oparams1[dMaxParams];
+  void *oparams2[dMaxParams];
+  int n = num_params( types );
+  int i;
+
+  for( i = 0; i < dMaxParams; i++ )
+     {
+       iparams[i]  = in[i];
+       oparams1[i] = out1[i];
+       oparams2[i] = out2[i];
+     }
+
+  memset( out1, 0, sizeof( out1 ) );
+  memset( out2, 0, sizeof( out2 ) );
+  // the compact demarshaller must zero the skipped array elements
+  memset( out2, 0xa5, sizeof( out2 ) );
+
+  int s1 = MarshalArray( types, iparams, buf1 );
+  int s2 = MarshalCompactArray( types, iparams, buf2 );
+  // zeroed data is not valid for some unions
+  if ( s1 < 0 && s2 < 0 )
+       return 0;
+  if ( s1 < 0 || s2 < 0 )
+     {
+       printf( "%s: marshal failure %d/%d\n", name, s1, s2 );
+       return -1;
+     }
+
+  int d1 = DemarshalArray( G_BYTE_ORDER, types, oparams1, buf1 );
+  int d2 = DemarshalCompactArray( G_BYTE_ORDER, types, oparams2, buf2 );
+  if ( d1 != s1 || d2 != s2 )
+     {
+       printf( "%s: demarshal size mismatch %d/%d %d/%d\n", name, s1, d1, s2, d2 );
+       return -1;
+     }
+
+  for( i = 0; cmp_params && i < n; i++ )
+     {
+       // compare the demarshaled part only
+       int size = Marshal( types[i], out1[i], buf1 );
+       int size2 = Marshal( types[i], out2[i], buf2 );
+       if ( size != size2 || memcmp( buf1, buf2, size ) )
+	  {
+	    printf( "%s: demarshal mismatch in param %d\n", name, i );
+	    return -1;
+	  }
+     }
+
+  return s2;
+}
+
+
+static int
+check( cHpiMarshal *m )
+{
+  if ( check_types( m->m_name, m->m_request, 1 ) < 0 )
+       return 1;
+  if ( check_types( m->m_name, m->m_reply, 1 ) < 0 )
+       return 1;
+
+  return 0;
+}
+
+
+static void
+fill_entity_path( SaHpiEntityPathT *ep )
+{
+  ep->Entry[0].EntityType     = SAHPI_ENT_SYSTEM_BOARD;
+  ep->Entry[0].EntityLocation = 3;
+  ep->Entry[1].EntityType     = SAHPI_ENT_ROOT;
+  ep->Entry[1].EntityLocation = 0;
+}
+
+
+static void
+fill_text_buffer( SaHpiTextBufferT *tb, const char *s )
+{
+  tb->DataType   = SAHPI_TL_TYPE_TEXT;
+  tb->Language   = SAHPI_LANG_ENGLISH;
+  tb->DataLength = strlen( s );
+  memcpy( tb->Data, s, tb->DataLength );
+}
+
+
+static int
+check_integer( const cMarshalType *type, const void *value, size_t size, int expected_len )
+{
+  unsigned char data[8];
+  int cc = MarshalCompact( type, value, buf1 );
+  if ( cc != expected_len )
+     {
+       printf( "%s: encoded size %d != %d\n", type->m_name, cc, expected_len );
+       return 1;
+     }
+
+  memset( data, 0, sizeof( data ) );
+  if ( DemarshalCompact( G_BYTE_ORDER, type, data, buf1 ) != cc
+       || memcmp( data, value, size ) )
+     {
+       printf( "%s: value mismatch\n", type->m_name );
+       return 1;
+     }
+
+  return 0;
+}
+
+
+int
+main( int argc, char *argv[] )
+{
+  cHpiMarshal *m;
+  int id;
+
+  // integers
+  {
+    tUint16 u16 = 0xffff;
+    tUint32 u32 = 127;
+    tUint64 u64 = 0xffffffffffffffffULL;
+    tInt32  i32 = -1;
+    tInt64  i64 = G_MININT64;
+    tInt8   i8  = -5;
+
+    if (    check_integer( &Marshal_Uint16Type, &u16, sizeof( u16 ), 3 )
+         || check_integer( &Marshal_Uint32Type, &u32, sizeof( u32 ), 1 )
+         || check_integer( &Marshal_Uint64Type, &u64, sizeof( u64 ), 10 )
+         || check_integer( &Marshal_Int32Type,  &i32, sizeof( i32 ), 1 )
+         || check_integer( &Marshal_Int64Type,  &i64, sizeof( i64 ), 10 )
+         || check_integer( &Marshal_Int8Type,   &i8,  sizeof( i8 ), 1 ) )
+         return 1;
+
+    // out of range value for the type
+    u32 = 0x10000;
+    MarshalCompact( &Marshal_Uint32Type, &u32, buf1 );
+    if ( DemarshalCompact( G_BYTE_ORDER, &Marshal_Uint16Type, &u16, buf1 ) >= 0 )
+         return 1;
+  }
+
+  // all entries with zeroed data
+  memset( in, 0, sizeof( in ) );
+  for( id = 1; ( m = HpiMarshalFind( id ) ) != 0; id++ )
+     {
+       if ( check( m ) )
+	    return 1;
+     }
+
+  // saHpiEventGet reply: sensor event with RDR and RPT entry
+  m = HpiMarshalFind( eFsaHpiEventGet );
+  if ( !m )
+       return 1;
+
+  memset( in, 0, sizeof( in ) );
+  {
+    SaErrorT         *rv  = (SaErrorT *)in[0];
+    SaHpiEventT      *e   = (SaHpiEventT *)in[1];
+    SaHpiRdrT        *rdr = (SaHpiRdrT *)in[2];
+    SaHpiRptEntryT   *rpt = (SaHpiRptEntryT *)in[3];
+
+    *rv          = SA_OK;
+    e->Source    = 17;
+    e->EventType = SAHPI_ET_SENSOR;
+    e->Timestamp = 0x0102030405060708LL;
+    e->Severity  = SAHPI_MAJOR;
+    e->EventDataUnion.SensorEvent.SensorNum  = 5;
+    e->EventDataUnion.SensorEvent.SensorType = SAHPI_TEMPERATURE;
+    e->EventDataUnion.SensorEvent.EventCategory = SAHPI_EC_THRESHOLD;
+    e->EventDataUnion.SensorEvent.Assertion  = SAHPI_TRUE;
+    e->EventDataUnion.SensorEvent.EventState = SAHPI_ES_UPPER_MAJOR;
+    e->EventDataUnion.SensorEvent.OptionalDataPresent = SAHPI_SOD_TRIGGER_READING;
+    e->EventDataUnion.SensorEvent.TriggerReading.IsSupported = SAHPI_TRUE;
+    e->EventDataUnion.SensorEvent.TriggerReading.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+    e->EventDataUnion.SensorEvent.TriggerReading.Value.SensorFloat64 = 81.5;
+
+    rdr->RecordId = 42;
+    rdr->RdrType  = SAHPI_SENSOR_RDR;
+    fill_entity_path( &rdr->Entity );
+    rdr->IsFru    = SAHPI_FALSE;
+    rdr->RdrTypeUnion.SensorRec.Num      = 5;
+    rdr->RdrTypeUnion.SensorRec.Type     = SAHPI_TEMPERATURE;
+    rdr->RdrTypeUnion.SensorRec.Category = SAHPI_EC_THRESHOLD;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.IsSupported = SAHPI_TRUE;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.ReadingType = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.Range.Max.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.Range.Max.Value.SensorFloat64 = 125.0;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.Range.Min.Value.SensorInt64 = -40;
+    fill_text_buffer( &rdr->IdString, "CPU temperature" );
+
+    rpt->EntryId    = 17;
+    rpt->ResourceId = 17;
+    fill_entity_path( &rpt->ResourceEntity );
+    rpt->ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE | SAHPI_CAPABILITY_RDR
+                              | SAHPI_CAPABILITY_SENSOR;
+    rpt->ResourceSeverity = SAHPI_CRITICAL;
+    fill_text_buffer( &rpt->ResourceTag, "System board" );
+  }
+
+  {
+    const void *iparams[dMaxParams] = { in[0], in[1], in[2], in[3], in[4] };
+    void *oparams[dMaxParams] = { out2[0], out2[1], out2[2], out2[3], out2[4] };
+
+    int s1 = MarshalArray( m->m_reply, iparams, buf1 );
+    int s2 = check_types( m->m_name, m->m_reply, 1 );
+    if ( s2 < 0 )
+	 return 1;
+    // text buffers and entity paths dominate the fixed size encoding
+    if ( s2 * 4 > s1 )
+       {
+	 printf( "%s: compact size %d, fixed size %d\n", m->m_name, s2, s1 );
+	 return 1;
+       }
+
+    // through the versioned reply functions
+    memset( out2, 0, sizeof( out2 ) );
+    s2 = HpiMarshalReplyVersion( dHpiRpcVersion2, m, buf2, iparams );
+    if ( s2 < 0 || HpiDemarshalReplyVersion( dHpiRpcVersion2, G_BYTE_ORDER, m, buf2, oparams ) != s2 )
+	 return 1;
+    if ( memcmp( out2[2], in[2], sizeof( SaHpiRdrT ) ) )
+	 return 1;
+
+    // the worst case bounds the actual sizes
+    if (    MarshalCompact( &SaHpiEventType, in[1], buf2 ) > MarshalCompactMaxSize( &SaHpiEventType )
+	 || MarshalCompact( &SaHpiRdrType, in[2], buf2 ) > MarshalCompactMaxSize( &SaHpiRdrType )
+	 || MarshalCompact( &SaHpiRptEntryType, in[3], buf2 ) > MarshalCompactMaxSize( &SaHpiRptEntryType ) )
+	 return 1;
+  }
+
+  // worst case size: every integer takes its longest varint,
+  // which is more than the in-memory size of the RPT entry
+  {
+    SaHpiRptEntryT rpt;
+    int max = MarshalCompactMaxSize( &SaHpiRptEntryType );
+
+    memset( &rpt, 0x7f, sizeof( rpt ) );
+    int cc = MarshalCompact( &SaHpiRptEntryType, &rpt, buf1 );
+    if ( cc <= 0 || cc > max || max <= (int)sizeof( rpt ) )
+       {
+	 printf( "SaHpiRptEntryT: compact size %d, max %d, sizeof %d\n",
+		 cc, max, (int)sizeof( rpt ) );
+	 return 1;
+       }
+
+    if ( MarshalCompactMaxSize( &oHpiHandlerConfigType ) >= 0 )
+	 return 1;
+  }
+
+  // error reply is just the error code
+  {
+    SaErrorT rv = SA_ERR_HPI_NOT_PRESENT;
+    SaErrorT rv2 = SA_OK;
+    const void *iparams[1] = { &rv };
+    void *oparams[dMaxParams] = { &rv2, out2[1], out2[2], out2[3] };
+
+    int s1 = MarshalCompact( &SaErrorType, &rv, buf1 );
+    int s2 = HpiMarshalReplyVersion( dHpiRpcVersion2, m, buf2, iparams );
+    if ( s1 <= 0 || s2 != s1 )
+	 return 1;
+    if ( HpiDemarshalReplyVersion( dHpiRpcVersion2, G_BYTE_ORDER, m, buf2, oparams ) != s2
+	 || rv2 != rv )
+	 return 1;
+  }
+
+  // saHpiRdrGet reply: control RDR
+  m = HpiMarshalFind( eFsaHpiRdrGet );
+  if ( !m )
+       return 1;
+
+  memset( in, 0, sizeof( in ) );
+  {
+    SaHpiRdrT *rdr = (SaHpiRdrT *)in[2];
+
+    rdr->RecordId = 7;
+    rdr->RdrType  = SAHPI_CTRL_RDR;
+    fill_entity_path( &rdr->Entity );
+    rdr->RdrTypeUnion.CtrlRec.Num        = 1;
+    rdr->RdrTypeUnion.CtrlRec.OutputType = SAHPI_CTRL_LED;
+    rdr->RdrTypeUnion.CtrlRec.Type       = SAHPI_CTRL_TYPE_TEXT;
+    rdr->RdrTypeUnion.CtrlRec.TypeUnion.Text.MaxChars = 16;
+    rdr->RdrTypeUnion.CtrlRec.TypeUnion.Text.MaxLines = 2;
+    fill_text_buffer( &rdr->RdrTypeUnion.CtrlRec.TypeUnion.Text.Default.Text, "Hello" );
+    fill_text_buffer( &rdr->IdString, "Front panel" );
+  }
+
+  if ( check( m ) )
+       return 1;
+
+  // oHpiHandlerCreate request: var array
+  m = HpiMarshalFind( eFoHpiHandlerCreate );
+  if ( !m )
+       return 1;
+
+  memset( in, 0, sizeof( in ) );
+  {
+    static oHpiHandlerConfigParamT params[2];
+    oHpiHandlerConfigT *cfg = (oHpiHandlerConfigT *)in[1];
+
+    strcpy( (char *)params[0].Name, "plugin" );
+    strcpy( (char *)params[0].Value, "libsimulator" );
+    strcpy( (char *)params[1].Name, "entity_root" );
+    strcpy( (char *)params[1].Value, "{SYSTEM_CHASSIS,1}" );
+    cfg->NumberOfParams = 2;
+    cfg->Params = params;
+  }
+
+  // demarshaled var arrays are allocated, so compare their content
+  if ( check_types( m->m_name, m->m_request, 0 ) < 0 )
+       return 1;
+  {
+    oHpiHandlerConfigT *cfg1 = (oHpiHandlerConfigT *)out1[1];
+    oHpiHandlerConfigT *cfg2 = (oHpiHandlerConfigT *)out2[1];
+
+    if ( cfg1->NumberOfParams != 2 || cfg2->NumberOfParams != 2 )
+         return 1;
+    if ( memcmp( cfg1->Params, cfg2->Params, 2 * sizeof( oHpiHandlerConfigParamT ) ) )
+         return 1;
+  }
+
+  return 0;
+}
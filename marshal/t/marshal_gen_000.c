@@ -0,0 +1,311 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Checks that the generated marshallers (marshal_hpi_gen.c)
+ * produce the same results as the cMarshalType interpreter.
+ */
+
+#include <glib.h>
+#include "marshal_hpi.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+#define dParamSize  16384
+#define dBufferSize 65536
+#define dMaxParams  8
+
+#define dOtherByteOrder ( G_BYTE_ORDER == G_LITTLE_ENDIAN ? G_BIG_ENDIAN : G_LITTLE_ENDIAN )
+
+
+static unsigned char in[dMaxParams][dParamSize];
+static unsigned char out1[dMaxParams][dParamSize];
+static unsigned char out2[dMaxParams][dParamSize];
+static unsigned char buf1[dBufferSize];
+static unsigned char buf2[dBufferSize];
+
+
+static int
+num_params( const cMarshalType **types )
+{
+  int n = 0;
+  while( types[n] )
+       n++;
+  return n;
+}
+
+
+static int
+check_reply( cHpiMarshal *m, int byte_order )
+{
+  const void *iparams[dMaxParams];
+  void *oparams1[dMaxParams];
+  void *oparams2[dMaxParams];
+  int n = num_params( m->m_reply );
+  int i;
+
+  for( i = 0; i < dMaxParams; i++ )
+     {
+       iparams[i]  = in[i];
+       oparams1[i] = out1[i];
+       oparams2[i] = out2[i];
+     }
+
+  memset( buf1, 0, sizeof( buf1 ) );
+  memset( buf2, 0, sizeof( buf2 ) );
+
+  int s1 = MarshalArray( m->m_reply, iparams, buf1 );
+  int s2 = HpiMarshalReply( m, buf2, iparams );
+  if ( s1 != s2 || ( s1 > 0 && memcmp( buf1, buf2, s1 ) ) )
+     {
+       printf( "%s: reply marshal mismatch %d/%d\n", m->m_name, s1, s2 );
+       return 1;
+     }
+  if ( s1 < 0 )
+       return 0;
+
+  memset( out1, 0, sizeof( out1 ) );
+  memset( out2, 0, sizeof( out2 ) );
+
+  int d1 = DemarshalArray( byte_order, m->m_reply, oparams1, buf1 );
+  int d2 = HpiDemarshalReply( byte_order, m, buf1, oparams2 );
+  // reading a buffer as the other byte order may fail on
+  // union discriminators; both paths must then fail alike
+  if ( d1 < 0 && d2 == d1 && byte_order != G_BYTE_ORDER )
+       return 0;
+  if ( d1 != s1 || d2 != s1 )
+     {
+       printf( "%s: reply demarshal size mismatch %d/%d/%d\n", m->m_name, s1, d1, d2 );
+       return 1;
+     }
+  for( i = 0; i < n; i++ )
+     {
+       if ( memcmp( out1[i], out2[i], dParamSize ) )
+	  {
+	    printf( "%s: reply demarshal mismatch in param %d\n", m->m_name, i );
+	    return 1;
+	  }
+     }
+
+  return 0;
+}
+
+
+static int
+check_request( cHpiMarshal *m, int byte_order, int cmp_params )
+{
+  const void *iparams[dMaxParams];
+  void *oparams1[dMaxParams];
+  void *oparams2[dMaxParams];
+  int n = num_params( m->m_request );
+  int i;
+
+  for( i = 0; i < dMaxParams; i++ )
+     {
+       iparams[i]  = in[i];
+       oparams1[i] = out1[i];
+       oparams2[i] = out2[i];
+     }
+
+  memset( buf1, 0, sizeof( buf1 ) );
+  memset( buf2, 0, sizeof( buf2 ) );
+
+  int s1 = MarshalArray( m->m_request, iparams, buf1 );
+  int s2 = HpiMarshalRequest( m, buf2, iparams );
+  if ( s1 != s2 || ( s1 > 0 && memcmp( buf1, buf2, s1 ) ) )
+     {
+       printf( "%s: request marshal mismatch %d/%d\n", m->m_name, s1, s2 );
+       return 1;
+     }
+  if ( s1 < 0 )
+       return 0;
+
+  memset( out1, 0, sizeof( out1 ) );
+  memset( out2, 0, sizeof( out2 ) );
+
+  int d1 = DemarshalArray( byte_order, m->m_request, oparams1, buf1 );
+  int d2 = HpiDemarshalRequest( byte_order, m, buf1, oparams2 );
+  // reading a buffer as the other byte order may fail on
+  // union discriminators; both paths must then fail alike
+  if ( d1 < 0 && d2 == d1 && byte_order != G_BYTE_ORDER )
+       return 0;
+  if ( d1 != s1 || d2 != s1 )
+     {
+       printf( "%s: request demarshal size mismatch %d/%d/%d\n", m->m_name, s1, d1, d2 );
+       return 1;
+     }
+  for( i = 0; cmp_params && i < n; i++ )
+     {
+       if ( memcmp( out1[i], out2[i], dParamSize ) )
+	  {
+	    printf( "%s: request demarshal mismatch in param %d\n", m->m_name, i );
+	    return 1;
+	  }
+     }
+
+  return 0;
+}
+
+
+static int
+check( cHpiMarshal *m )
+{
+  if ( check_request( m, G_BYTE_ORDER, 1 ) || check_request( m, dOtherByteOrder, 1 ) )
+       return 1;
+
+  if ( check_reply( m, G_BYTE_ORDER ) || check_reply( m, dOtherByteOrder ) )
+       return 1;
+
+  return 0;
+}
+
+
+static void
+fill_entity_path( SaHpiEntityPathT *ep )
+{
+  ep->Entry[0].EntityType     = SAHPI_ENT_SYSTEM_BOARD;
+  ep->Entry[0].EntityLocation = 3;
+  ep->Entry[1].EntityType     = SAHPI_ENT_ROOT;
+  ep->Entry[1].EntityLocation = 0;
+}
+
+
+static void
+fill_text_buffer( SaHpiTextBufferT *tb, const char *s )
+{
+  tb->DataType   = SAHPI_TL_TYPE_TEXT;
+  tb->Language   = SAHPI_LANG_ENGLISH;
+  tb->DataLength = strlen( s );
+  memcpy( tb->Data, s, tb->DataLength );
+}
+
+
+int
+main( int argc, char *argv[] )
+{
+  cHpiMarshal *m;
+  int id;
+
+  // all entries with zeroed data
+  memset( in, 0, sizeof( in ) );
+  for( id = 1; ( m = HpiMarshalFind( id ) ) != 0; id++ )
+     {
+       if ( check( m ) )
+	    return 1;
+     }
+
+  // saHpiEventGet reply: sensor event with RDR and RPT entry
+  m = HpiMarshalFind( eFsaHpiEventGet );
+  if ( !m )
+       return 1;
+
+  memset( in, 0, sizeof( in ) );
+  {
+    SaHpiEventT      *e   = (SaHpiEventT *)in[1];
+    SaHpiRdrT        *rdr = (SaHpiRdrT *)in[2];
+    SaHpiRptEntryT   *rpt = (SaHpiRptEntryT *)in[3];
+
+    e->Source    = 17;
+    e->EventType = SAHPI_ET_SENSOR;
+    e->Timestamp = 0x0102030405060708LL;
+    e->Severity  = SAHPI_MAJOR;
+    e->EventDataUnion.SensorEvent.SensorNum  = 5;
+    e->EventDataUnion.SensorEvent.SensorType = SAHPI_TEMPERATURE;
+    e->EventDataUnion.SensorEvent.EventCategory = SAHPI_EC_THRESHOLD;
+    e->EventDataUnion.SensorEvent.Assertion  = SAHPI_TRUE;
+    e->EventDataUnion.SensorEvent.EventState = SAHPI_ES_UPPER_MAJOR;
+    e->EventDataUnion.SensorEvent.OptionalDataPresent = SAHPI_SOD_TRIGGER_READING;
+    e->EventDataUnion.SensorEvent.TriggerReading.IsSupported = SAHPI_TRUE;
+    e->EventDataUnion.SensorEvent.TriggerReading.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+    e->EventDataUnion.SensorEvent.TriggerReading.Value.SensorFloat64 = 81.5;
+
+    rdr->RecordId = 42;
+    rdr->RdrType  = SAHPI_SENSOR_RDR;
+    fill_entity_path( &rdr->Entity );
+    rdr->IsFru    = SAHPI_FALSE;
+    rdr->RdrTypeUnion.SensorRec.Num      = 5;
+    rdr->RdrTypeUnion.SensorRec.Type     = SAHPI_TEMPERATURE;
+    rdr->RdrTypeUnion.SensorRec.Category = SAHPI_EC_THRESHOLD;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.IsSupported = SAHPI_TRUE;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.ReadingType = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.Range.Max.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+    rdr->RdrTypeUnion.SensorRec.DataFormat.Range.Max.Value.SensorFloat64 = 125.0;
+    fill_text_buffer( &rdr->IdString, "CPU temperature" );
+
+    rpt->EntryId    = 17;
+    rpt->ResourceId = 17;
+    fill_entity_path( &rpt->ResourceEntity );
+    rpt->ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE | SAHPI_CAPABILITY_RDR
+                              | SAHPI_CAPABILITY_SENSOR;
+    rpt->ResourceSeverity = SAHPI_CRITICAL;
+    fill_text_buffer( &rpt->ResourceTag, "System board" );
+  }
+
+  if ( check( m ) )
+       return 1;
+
+  // saHpiRdrGet reply: control RDR
+  m = HpiMarshalFind( eFsaHpiRdrGet );
+  if ( !m )
+       return 1;
+
+  memset( in, 0, sizeof( in ) );
+  {
+    SaHpiRdrT *rdr = (SaHpiRdrT *)in[2];
+
+    rdr->RecordId = 7;
+    rdr->RdrType  = SAHPI_CTRL_RDR;
+    fill_entity_path( &rdr->Entity );
+    rdr->RdrTypeUnion.CtrlRec.Num        = 1;
+    rdr->RdrTypeUnion.CtrlRec.OutputType = SAHPI_CTRL_LED;
+    rdr->RdrTypeUnion.CtrlRec.Type       = SAHPI_CTRL_TYPE_TEXT;
+    rdr->RdrTypeUnion.CtrlRec.TypeUnion.Text.MaxChars = 16;
+    rdr->RdrTypeUnion.CtrlRec.TypeUnion.Text.MaxLines = 2;
+    fill_text_buffer( &rdr->RdrTypeUnion.CtrlRec.TypeUnion.Text.Default.Text, "Hello" );
+    fill_text_buffer( &rdr->IdString, "Front panel" );
+  }
+
+  if ( check( m ) )
+       return 1;
+
+  // oHpiHandlerCreate request: var array
+  m = HpiMarshalFind( eFoHpiHandlerCreate );
+  if ( !m )
+       return 1;
+
+  memset( in, 0, sizeof( in ) );
+  {
+    static oHpiHandlerConfigParamT params[2];
+    oHpiHandlerConfigT *cfg = (oHpiHandlerConfigT *)in[1];
+
+    strcpy( (char *)params[0].Name, "plugin" );
+    strcpy( (char *)params[0].Value, "libsimulator" );
+    strcpy( (char *)params[1].Name, "entity_root" );
+    strcpy( (char *)params[1].Value, "{SYSTEM_CHASSIS,1}" );
+    cfg->NumberOfParams = 2;
+    cfg->Params = params;
+  }
+
+  // demarshaled var arrays are allocated, so compare their content
+  if ( check_request( m, G_BYTE_ORDER, 0 ) )
+       return 1;
+  {
+    oHpiHandlerConfigT *cfg1 = (oHpiHandlerConfigT *)out1[1];
+    oHpiHandlerConfigT *cfg2 = (oHpiHandlerConfigT *)out2[1];
+
+    if ( cfg1->NumberOfParams != 2 || cfg2->NumberOfParams != 2 )
+         return 1;
+    if ( memcmp( cfg1->Params, cfg2->Params, 2 * sizeof( oHpiHandlerConfigParamT ) ) )
+         return 1;
+    if ( strcmp( (const char *)cfg2->Params[1].Value, "{SYSTEM_CHASSIS,1}" ) )
+         return 1;
+  }
+
+  return 0;
+}
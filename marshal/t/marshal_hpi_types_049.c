@@ -0,0 +1,107 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_sensor_reading( oHpiSensorReadingT *d1, oHpiSensorReadingT *d2 )
+{
+  if ( d1->Num != d2->Num )
+       return 0;
+
+  if ( d1->Result != d2->Result )
+       return 0;
+
+  if ( d1->Reading.IsSupported != d2->Reading.IsSupported )
+       return 0;
+
+  if ( d1->Reading.Type != d2->Reading.Type )
+       return 0;
+
+  if ( d1->Reading.Value.SensorFloat64 != d2->Reading.Value.SensorFloat64 )
+       return 0;
+
+  if ( d1->EventState != d2->EventState )
+       return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiSensorReadingsT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiSensorReadingsType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  cTest value;
+  cTest result;
+  unsigned int i;
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.NumberOfReadings = 3;
+  value.m_v1.Readings[0].Num                         = 1;
+  value.m_v1.Readings[0].Result                      = SA_OK;
+  value.m_v1.Readings[0].Reading.IsSupported         = SAHPI_TRUE;
+  value.m_v1.Readings[0].Reading.Type                = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+  value.m_v1.Readings[0].Reading.Value.SensorFloat64 = 42.5;
+  value.m_v1.Readings[0].EventState                  = SAHPI_ES_UPPER_MINOR;
+  value.m_v1.Readings[1].Num                         = 0x2e;
+  value.m_v1.Readings[1].Result                      = SA_ERR_HPI_NOT_PRESENT;
+  value.m_v1.Readings[2].Num                         = 0x6b;
+  value.m_v1.Readings[2].Result                      = SA_OK;
+  value.m_v1.Readings[2].Reading.IsSupported         = SAHPI_FALSE;
+  value.m_v1.Readings[2].EventState                  = SAHPI_ES_UNSPECIFIED;
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( value ) * 2 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( value.m_v1.NumberOfReadings != result.m_v1.NumberOfReadings )
+       return 1;
+
+  for( i = 0; i < OH_MAX_SENSOR_READINGS; i++ )
+       if ( !cmp_sensor_reading( &value.m_v1.Readings[i], &result.m_v1.Readings[i] ) )
+            return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  return 0;
+}
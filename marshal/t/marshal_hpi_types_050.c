@@ -0,0 +1,102 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_history( oHpiSensorHistoryT *d1, oHpiSensorHistoryT *d2 )
+{
+  unsigned int i;
+
+  if ( d1->Count != d2->Count )
+       return 0;
+
+  if ( d1->Min != d2->Min || d1->Max != d2->Max || d1->Avg != d2->Avg )
+       return 0;
+
+  if ( d1->NumberOfSamples != d2->NumberOfSamples )
+       return 0;
+
+  for( i = 0; i < OH_MAX_SENSOR_SAMPLES; i++ )
+     {
+       if ( d1->Samples[i].Timestamp != d2->Samples[i].Timestamp )
+	    return 0;
+
+       if ( d1->Samples[i].Value != d2->Samples[i].Value )
+	    return 0;
+     }
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiSensorHistoryT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiSensorHistoryType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  cTest value;
+  cTest result;
+  unsigned int i;
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.Count           = 1000;
+  value.m_v1.Min             = -12.5;
+  value.m_v1.Max             = 87.25;
+  value.m_v1.Avg             = 40.0;
+  value.m_v1.NumberOfSamples = OH_MAX_SENSOR_SAMPLES;
+  for( i = 0; i < OH_MAX_SENSOR_SAMPLES; i++ )
+     {
+       value.m_v1.Samples[i].Timestamp = 1000000000LL * ( 1000 + i );
+       value.m_v1.Samples[i].Value     = 20.0 + i / 4.0;
+     }
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( value ) * 2 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( !cmp_history( &value.m_v1, &result.m_v1 ) )
+       return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  return 0;
+}
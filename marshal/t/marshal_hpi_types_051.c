@@ -0,0 +1,154 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_event( SaHpiEventT *d1, SaHpiEventT *d2 )
+{
+  if ( d1->Source != d2->Source )
+       return 0;
+
+  if ( d1->EventType != d2->EventType )
+       return 0;
+
+  if ( d1->Timestamp != d2->Timestamp )
+       return 0;
+
+  if ( d1->Severity != d2->Severity )
+       return 0;
+
+  if ( d1->EventDataUnion.SensorEvent.SensorNum != d2->EventDataUnion.SensorEvent.SensorNum )
+       return 0;
+
+  if ( d1->EventDataUnion.SensorEvent.EventState != d2->EventDataUnion.SensorEvent.EventState )
+       return 0;
+
+  return 1;
+}
+
+
+static int
+cmp_rpte( SaHpiRptEntryT *d1, SaHpiRptEntryT *d2 )
+{
+  if ( d1->ResourceId != d2->ResourceId )
+       return 0;
+
+  if ( d1->ResourceCapabilities != d2->ResourceCapabilities )
+       return 0;
+
+  if ( d1->ResourceTag.DataLength != d2->ResourceTag.DataLength )
+       return 0;
+
+  if ( memcmp( d1->ResourceTag.Data, d2->ResourceTag.Data, d1->ResourceTag.DataLength ) )
+       return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiEventBatchT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiEventBatchType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  SaHpiEventT events[3];
+  SaHpiRptEntryT rptes[3];
+  cTest value;
+  cTest result;
+  unsigned int i;
+
+  memset( events, 0, sizeof( events ) );
+  memset( rptes, 0, sizeof( rptes ) );
+  for( i = 0; i < 3; i++ )
+     {
+       events[i].Source    = 10 + i;
+       events[i].EventType = SAHPI_ET_SENSOR;
+       events[i].Timestamp = 1000000000LL * ( 100 + i );
+       events[i].Severity  = SAHPI_MINOR;
+       events[i].EventDataUnion.SensorEvent.SensorNum  = 20 + i;
+       events[i].EventDataUnion.SensorEvent.SensorType = SAHPI_TEMPERATURE;
+       events[i].EventDataUnion.SensorEvent.EventState = SAHPI_ES_UPPER_MINOR;
+
+       rptes[i].ResourceId           = 10 + i;
+       rptes[i].ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE | SAHPI_CAPABILITY_SENSOR;
+       rptes[i].ResourceTag.DataType = SAHPI_TL_TYPE_TEXT;
+       rptes[i].ResourceTag.Language = SAHPI_LANG_ENGLISH;
+       rptes[i].ResourceTag.DataLength = 5;
+       memcpy( rptes[i].ResourceTag.Data, "board", 5 );
+     }
+
+  // RDRs are not requested
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.NumberOfEvents     = 3;
+  value.m_v1.Events             = events;
+  value.m_v1.NumberOfRdrs       = 0;
+  value.m_v1.Rdrs               = 0;
+  value.m_v1.NumberOfRptEntries = 3;
+  value.m_v1.RptEntries         = rptes;
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( events ) + sizeof( rptes ) + 256 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( result.m_v1.NumberOfEvents != 3 || result.m_v1.NumberOfRdrs != 0 )
+       return 1;
+
+  if ( result.m_v1.NumberOfRptEntries != 3 )
+       return 1;
+
+  for( i = 0; i < 3; i++ )
+     {
+       if ( !cmp_event( &events[i], &result.m_v1.Events[i] ) )
+	    return 1;
+
+       if ( !cmp_rpte( &rptes[i], &result.m_v1.RptEntries[i] ) )
+	    return 1;
+     }
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  g_free( result.m_v1.Events );
+  g_free( result.m_v1.Rdrs );
+  g_free( result.m_v1.RptEntries );
+
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_filter( oHpiEventFilterT *d1, oHpiEventFilterT *d2 )
+{
+  unsigned int i;
+
+  if ( d1->EventTypes != d2->EventTypes )
+       return 0;
+
+  if ( d1->MinSeverity != d2->MinSeverity )
+       return 0;
+
+  if ( d1->NumberOfResources != d2->NumberOfResources )
+       return 0;
+
+  for( i = 0; i < OH_MAX_FILTER_RESOURCES; i++ )
+       if ( d1->Resources[i] != d2->Resources[i] )
+	    return 0;
+
+  if ( d1->EntityPathPattern.DataLength != d2->EntityPathPattern.DataLength )
+       return 0;
+
+  if ( memcmp( d1->EntityPathPattern.Data, d2->EntityPathPattern.Data,
+	       d1->EntityPathPattern.DataLength ) )
+       return 0;
+
+  if ( d1->NumberOfSensorTypes != d2->NumberOfSensorTypes )
+       return 0;
+
+  for( i = 0; i < OH_MAX_FILTER_SENSOR_TYPES; i++ )
+       if ( d1->SensorTypes[i] != d2->SensorTypes[i] )
+	    return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiEventFilterT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiEventFilterType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  cTest value;
+  cTest result;
+  const char *epp = "{SYSTEM_CHASSIS,.}{*}";
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.EventTypes          = OH_EVENT_TYPE_BIT( SAHPI_ET_SENSOR )
+                                 | OH_EVENT_TYPE_BIT( SAHPI_ET_HOTSWAP );
+  value.m_v1.MinSeverity         = SAHPI_MAJOR;
+  value.m_v1.NumberOfResources   = 2;
+  value.m_v1.Resources[0]        = 5;
+  value.m_v1.Resources[1]        = 77;
+  value.m_v1.EntityPathPattern.DataType   = SAHPI_TL_TYPE_TEXT;
+  value.m_v1.EntityPathPattern.Language   = SAHPI_LANG_ENGLISH;
+  value.m_v1.EntityPathPattern.DataLength = strlen( epp );
+  memcpy( value.m_v1.EntityPathPattern.Data, epp, strlen( epp ) );
+  value.m_v1.NumberOfSensorTypes = 2;
+  value.m_v1.SensorTypes[0]      = SAHPI_TEMPERATURE;
+  value.m_v1.SensorTypes[1]      = SAHPI_FAN;
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( value ) * 2 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( !cmp_filter( &value.m_v1, &result.m_v1 ) )
+       return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  return 0;
+}
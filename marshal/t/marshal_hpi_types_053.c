@@ -0,0 +1,167 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_entry( SaHpiEventLogEntryT *d1, SaHpiEventLogEntryT *d2 )
+{
+  SaHpiTextBufferT *t1 = &d1->Event.EventDataUnion.UserEvent.UserEventData;
+  SaHpiTextBufferT *t2 = &d2->Event.EventDataUnion.UserEvent.UserEventData;
+
+  if ( d1->EntryId != d2->EntryId )
+       return 0;
+
+  if ( d1->Timestamp != d2->Timestamp )
+       return 0;
+
+  if ( d1->Event.Source != d2->Event.Source )
+       return 0;
+
+  if ( d1->Event.EventType != d2->Event.EventType )
+       return 0;
+
+  if ( d1->Event.Severity != d2->Event.Severity )
+       return 0;
+
+  if ( t1->DataLength != t2->DataLength )
+       return 0;
+
+  if ( memcmp( t1->Data, t2->Data, t1->DataLength ) )
+       return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiEventLogRangeT m_v1;
+  tUint8 m_pad2;
+  oHpiEventLogBatchT m_v2;
+  tUint8 m_pad3;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiEventLogRangeType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v2   , oHpiEventLogBatchType ),
+  dStructElement( cTest, m_pad3 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  SaHpiEventLogEntryT entries[2];
+  SaHpiRdrT rdrs[2];
+  cTest value;
+  cTest result;
+  unsigned int i;
+
+  memset( entries, 0, sizeof( entries ) );
+  memset( rdrs, 0, sizeof( rdrs ) );
+  for( i = 0; i < 2; i++ )
+     {
+       SaHpiTextBufferT *t = &entries[i].Event.EventDataUnion.UserEvent.UserEventData;
+
+       entries[i].EntryId         = 100 + i;
+       entries[i].Timestamp       = 1000000000LL * ( 500 + i );
+       entries[i].Event.Source    = SAHPI_UNSPECIFIED_RESOURCE_ID;
+       entries[i].Event.EventType = SAHPI_ET_USER;
+       entries[i].Event.Timestamp = entries[i].Timestamp;
+       entries[i].Event.Severity  = SAHPI_INFORMATIONAL;
+       t->DataType   = SAHPI_TL_TYPE_TEXT;
+       t->Language   = SAHPI_LANG_ENGLISH;
+       t->DataLength = 4;
+       memcpy( t->Data, "test", 4 );
+
+       rdrs[i].RdrType = SAHPI_NO_RECORD;
+     }
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.StartEntryId   = SAHPI_OLDEST_ENTRY;
+  value.m_v1.MaxEntries     = 32;
+  value.m_v1.StartTime      = 1000000000LL * 400;
+  value.m_v1.EndTime        = SAHPI_TIME_UNSPECIFIED;
+  value.m_v1.WantRdrs       = SAHPI_TRUE;
+  value.m_v1.WantRptEntries = SAHPI_FALSE;
+  value.m_pad2 = 48;
+  // RPT entries are not requested
+  value.m_v2.NumberOfEntries    = 2;
+  value.m_v2.Entries            = entries;
+  value.m_v2.NumberOfRdrs       = 2;
+  value.m_v2.Rdrs               = rdrs;
+  value.m_v2.NumberOfRptEntries = 0;
+  value.m_v2.RptEntries         = 0;
+  value.m_pad3 = 49;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( entries ) + sizeof( rdrs ) + 256 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( value.m_v1.StartEntryId != result.m_v1.StartEntryId ||
+       value.m_v1.MaxEntries != result.m_v1.MaxEntries )
+       return 1;
+
+  if ( value.m_v1.StartTime != result.m_v1.StartTime ||
+       value.m_v1.EndTime != result.m_v1.EndTime )
+       return 1;
+
+  if ( value.m_v1.WantRdrs != result.m_v1.WantRdrs ||
+       value.m_v1.WantRptEntries != result.m_v1.WantRptEntries )
+       return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  if ( result.m_v2.NumberOfEntries != 2 || result.m_v2.NumberOfRdrs != 2 )
+       return 1;
+
+  if ( result.m_v2.NumberOfRptEntries != 0 )
+       return 1;
+
+  for( i = 0; i < 2; i++ )
+     {
+       if ( !cmp_entry( &entries[i], &result.m_v2.Entries[i] ) )
+	    return 1;
+
+       if ( result.m_v2.Rdrs[i].RdrType != SAHPI_NO_RECORD )
+	    return 1;
+     }
+
+  if ( value.m_pad3 != result.m_pad3 )
+       return 1;
+
+  g_free( result.m_v2.Entries );
+  g_free( result.m_v2.Rdrs );
+  g_free( result.m_v2.RptEntries );
+
+  return 0;
+}
@@ -0,0 +1,87 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_status( oHpiHandlerStatusT *d1, oHpiHandlerStatusT *d2 )
+{
+  if ( d1->State != d2->State )
+       return 0;
+
+  if ( d1->SnapshotTimestamp != d2->SnapshotTimestamp )
+       return 0;
+
+  if ( d1->SnapshotResources != d2->SnapshotResources )
+       return 0;
+
+  if ( d1->StaleResources != d2->StaleResources )
+       return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiHandlerStatusT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiHandlerStatusType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  cTest value;
+  cTest result;
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.State             = OHPI_HANDLER_STALE;
+  value.m_v1.SnapshotTimestamp = 1234567890123LL;
+  value.m_v1.SnapshotResources = 42;
+  value.m_v1.StaleResources    = 7;
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( value ) * 2 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( !cmp_status( &value.m_v1, &result.m_v1 ) )
+       return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  return 0;
+}
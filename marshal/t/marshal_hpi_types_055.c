@@ -0,0 +1,117 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_stats( oHpiMemPoolStatsT *d1, oHpiMemPoolStatsT *d2 )
+{
+  if ( d1->Name.DataLength != d2->Name.DataLength )
+       return 0;
+
+  if ( memcmp( d1->Name.Data, d2->Name.Data, d1->Name.DataLength ) != 0 )
+       return 0;
+
+  if ( d1->ObjectSize != d2->ObjectSize )
+       return 0;
+
+  if ( d1->Slabs != d2->Slabs )
+       return 0;
+
+  if ( d1->Capacity != d2->Capacity )
+       return 0;
+
+  if ( d1->Free != d2->Free )
+       return 0;
+
+  if ( d1->Cached != d2->Cached )
+       return 0;
+
+  if ( d1->Allocs != d2->Allocs )
+       return 0;
+
+  if ( d1->Frees != d2->Frees )
+       return 0;
+
+  if ( d1->HeapAllocs != d2->HeapAllocs )
+       return 0;
+
+  if ( d1->HeapFrees != d2->HeapFrees )
+       return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiMemPoolStatsT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiMemPoolStatsType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  cTest value;
+  cTest result;
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.Name.DataType   = SAHPI_TL_TYPE_TEXT;
+  value.m_v1.Name.Language   = SAHPI_LANG_ENGLISH;
+  value.m_v1.Name.DataLength = 5;
+  memcpy( value.m_v1.Name.Data, "event", 5 );
+  value.m_v1.ObjectSize      = 1344;
+  value.m_v1.Slabs           = 3;
+  value.m_v1.Capacity        = 144;
+  value.m_v1.Free            = 40;
+  value.m_v1.Cached          = 31;
+  value.m_v1.Allocs          = 12345678901LL;
+  value.m_v1.Frees           = 12345678828LL;
+  value.m_v1.HeapAllocs      = 2;
+  value.m_v1.HeapFrees       = 977;
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( value ) * 2 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( !cmp_stats( &value.m_v1, &result.m_v1 ) )
+       return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  return 0;
+}
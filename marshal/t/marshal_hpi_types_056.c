@@ -0,0 +1,116 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_metric( oHpiMetricT *d1, oHpiMetricT *d2 )
+{
+  int i;
+
+  if ( d1->Type != d2->Type )
+       return 0;
+
+  if ( d1->HandlerId != d2->HandlerId )
+       return 0;
+
+  if ( d1->Name.DataLength != d2->Name.DataLength )
+       return 0;
+
+  if ( memcmp( d1->Name.Data, d2->Name.Data, d1->Name.DataLength ) != 0 )
+       return 0;
+
+  if ( d1->Count != d2->Count )
+       return 0;
+
+  if ( d1->Sum != d2->Sum )
+       return 0;
+
+  if ( d1->Max != d2->Max )
+       return 0;
+
+  if ( d1->Current != d2->Current )
+       return 0;
+
+  for ( i = 0; i < OHPI_METRIC_BUCKETS; i++ ) {
+       if ( d1->Buckets[i] != d2->Buckets[i] )
+            return 0;
+  }
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiMetricT m_v1;
+  tUint8 m_pad2;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiMetricType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  cTest value;
+  cTest result;
+  int i;
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.Type            = OHPI_METRIC_ABI;
+  value.m_v1.HandlerId       = 3;
+  value.m_v1.Name.DataType   = SAHPI_TL_TYPE_TEXT;
+  value.m_v1.Name.Language   = SAHPI_LANG_ENGLISH;
+  value.m_v1.Name.DataLength = 18;
+  memcpy( value.m_v1.Name.Data, "get_sensor_reading", 18 );
+  value.m_v1.Count           = 12345678901LL;
+  value.m_v1.Sum             = 98765432109876LL;
+  value.m_v1.Max             = 4000000123LL;
+  value.m_v1.Current         = 17;
+  for ( i = 0; i < OHPI_METRIC_BUCKETS; i++ ) {
+       value.m_v1.Buckets[i] = 1000 * i + 7;
+  }
+  value.m_pad2 = 48;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( value ) * 2 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( !cmp_metric( &value.m_v1, &result.m_v1 ) )
+       return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  return 0;
+}
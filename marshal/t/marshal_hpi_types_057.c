@@ -0,0 +1,176 @@
+/*
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <glib.h>
+#include <oHpi.h>
+#include "marshal_hpi_types.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+
+static int
+cmp_area( SaHpiIdrAreaHeaderT *d1, SaHpiIdrAreaHeaderT *d2 )
+{
+  if ( d1->AreaId != d2->AreaId )
+       return 0;
+
+  if ( d1->Type != d2->Type )
+       return 0;
+
+  if ( d1->ReadOnly != d2->ReadOnly )
+       return 0;
+
+  if ( d1->NumFields != d2->NumFields )
+       return 0;
+
+  return 1;
+}
+
+
+static int
+cmp_field( SaHpiIdrFieldT *d1, SaHpiIdrFieldT *d2 )
+{
+  if ( d1->AreaId != d2->AreaId )
+       return 0;
+
+  if ( d1->FieldId != d2->FieldId )
+       return 0;
+
+  if ( d1->Type != d2->Type )
+       return 0;
+
+  if ( d1->ReadOnly != d2->ReadOnly )
+       return 0;
+
+  if ( d1->Field.DataType != d2->Field.DataType )
+       return 0;
+
+  if ( d1->Field.Language != d2->Field.Language )
+       return 0;
+
+  if ( d1->Field.DataLength != d2->Field.DataLength )
+       return 0;
+
+  if ( memcmp( d1->Field.Data, d2->Field.Data, d1->Field.DataLength ) )
+       return 0;
+
+  return 1;
+}
+
+
+typedef struct
+{
+  tUint8 m_pad1;
+  oHpiIdrBatchT m_v1;
+  tUint8 m_pad2;
+  oHpiIdrBatchT m_v2;
+  tUint8 m_pad3;
+} cTest;
+
+cMarshalType StructElements[] =
+{
+  dStructElement( cTest, m_pad1 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v1   , oHpiIdrBatchType ),
+  dStructElement( cTest, m_pad2 , Marshal_Uint8Type ),
+  dStructElement( cTest, m_v2   , oHpiIdrBatchType ),
+  dStructElement( cTest, m_pad3 , Marshal_Uint8Type ),
+  dStructElementEnd()
+};
+
+cMarshalType TestType = dStruct( StructElements );
+
+
+int
+main( int argc, char *argv[] )
+{
+  SaHpiIdrAreaHeaderT areas[2];
+  SaHpiIdrFieldT fields[3];
+  cTest value;
+  cTest result;
+  unsigned int i;
+
+  memset( areas, 0, sizeof( areas ) );
+  memset( fields, 0, sizeof( fields ) );
+
+  areas[0].AreaId    = 1;
+  areas[0].Type      = SAHPI_IDR_AREATYPE_BOARD_INFO;
+  areas[0].ReadOnly  = SAHPI_TRUE;
+  areas[0].NumFields = 2;
+  areas[1].AreaId    = 2;
+  areas[1].Type      = SAHPI_IDR_AREATYPE_PRODUCT_INFO;
+  areas[1].ReadOnly  = SAHPI_FALSE;
+  areas[1].NumFields = 1;
+
+  for( i = 0; i < 3; i++ )
+     {
+       fields[i].AreaId   = ( i < 2 ) ? 1 : 2;
+       fields[i].FieldId  = i;
+       fields[i].Type     = SAHPI_IDR_FIELDTYPE_SERIAL_NUMBER;
+       fields[i].ReadOnly = SAHPI_TRUE;
+       fields[i].Field.DataType   = SAHPI_TL_TYPE_TEXT;
+       fields[i].Field.Language   = SAHPI_LANG_ENGLISH;
+       fields[i].Field.DataLength = 6;
+       memcpy( fields[i].Field.Data, "SN0000", 6 );
+       fields[i].Field.Data[5] = '0' + i;
+     }
+
+  memset( &value, 0, sizeof( value ) );
+  value.m_pad1 = 47;
+  value.m_v1.NumberOfAreas  = 2;
+  value.m_v1.Areas          = areas;
+  value.m_v1.NumberOfFields = 3;
+  value.m_v1.Fields         = fields;
+  value.m_pad2 = 48;
+  // an IDR without areas
+  value.m_v2.NumberOfAreas  = 0;
+  value.m_v2.Areas          = 0;
+  value.m_v2.NumberOfFields = 0;
+  value.m_v2.Fields         = 0;
+  value.m_pad3 = 49;
+
+  unsigned char *buffer = (unsigned char *)malloc( sizeof( areas ) + sizeof( fields ) + 256 );
+
+  unsigned int s1 = Marshal( &TestType, &value, buffer );
+  unsigned int s2 = Demarshal( G_BYTE_ORDER, &TestType, &result, buffer );
+
+  if ( s1 != s2 )
+       return 1;
+
+  if ( value.m_pad1 != result.m_pad1 )
+       return 1;
+
+  if ( result.m_v1.NumberOfAreas != 2 || result.m_v1.NumberOfFields != 3 )
+       return 1;
+
+  for( i = 0; i < 2; i++ )
+       if ( !cmp_area( &areas[i], &result.m_v1.Areas[i] ) )
+	    return 1;
+
+  for( i = 0; i < 3; i++ )
+       if ( !cmp_field( &fields[i], &result.m_v1.Fields[i] ) )
+	    return 1;
+
+  if ( value.m_pad2 != result.m_pad2 )
+       return 1;
+
+  if ( result.m_v2.NumberOfAreas != 0 || result.m_v2.NumberOfFields != 0 )
+       return 1;
+
+  if ( value.m_pad3 != result.m_pad3 )
+       return 1;
+
+  g_free( result.m_v1.Areas );
+  g_free( result.m_v1.Fields );
+  g_free( result.m_v2.Areas );
+  g_free( result.m_v2.Fields );
+  free( buffer );
+
+  return 0;
+}
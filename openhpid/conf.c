@@ -59,6 +59,13 @@ static const char *known_globals[] = {
         "OPENHPI_UNCONFIGURED",
         "OPENHPI_AUTOINSERT_TIMEOUT",
         "OPENHPI_AUTOINSERT_TIMEOUT_READONLY",
+        "OPENHPI_SENSOR_CACHE_MAX_AGE",
+        "OPENHPI_SNAPSHOT",
+        "OPENHPI_HANDLER_OPEN_THREADS",
+        "OPENHPI_EVT_RATE_LIMIT",
+        "OPENHPI_EVT_RATE_BURST",
+        "OPENHPI_EVT_RATE_SEV",
+        "OPENHPI_EVT_COALESCE_WINDOW",
         NULL
 };
 
@@ -77,6 +84,13 @@ static struct {
         SaHpiBoolT unconfigured;
         SaHpiTimeoutT ai_timeout;
         SaHpiBoolT ai_timeout_readonly;
+        SaHpiUint32T sensor_cache_max_age;
+        SaHpiBoolT snapshot;
+        SaHpiUint32T handler_open_threads;
+        SaHpiUint32T evt_rate_limit;
+        SaHpiUint32T evt_rate_burst;
+        SaHpiSeverityT evt_rate_sev;
+        SaHpiUint32T evt_coalesce_window;
         unsigned char read_env;
         GStaticRecMutex lock;
 } global_params = { /* Defaults for global params are set here */
@@ -93,6 +107,13 @@ static struct {
         .unconfigured = SAHPI_FALSE,
         .ai_timeout = 0,
         .ai_timeout_readonly = SAHPI_TRUE,
+        .sensor_cache_max_age = 0, /* No sensor reading cache */
+        .snapshot = SAHPI_FALSE,
+        .handler_open_threads = 0, /* 0 is open one by one at startup */
+        .evt_rate_limit = 0, /* No rate limit */
+        .evt_rate_burst = 100,
+        .evt_rate_sev = SAHPI_MINOR,
+        .evt_coalesce_window = 0, /* No coalescing */
         .read_env = 0,
         .lock = G_STATIC_REC_MUTEX_INIT
 };
@@ -237,6 +258,26 @@ static void process_global_param(const char *name, char *value)
                 } else {
                         global_params.ai_timeout_readonly = SAHPI_FALSE;
                 }
+        } else if (!strcmp("OPENHPI_SENSOR_CACHE_MAX_AGE", name)) {
+                global_params.sensor_cache_max_age = strtoul(value, 0, 10);
+        } else if (!strcmp("OPENHPI_SNAPSHOT", name)) {
+                if (!strcmp("YES", value)) {
+                        global_params.snapshot = SAHPI_TRUE;
+                } else {
+                        global_params.snapshot = SAHPI_FALSE;
+                }
+        } else if (!strcmp("OPENHPI_HANDLER_OPEN_THREADS", name)) {
+                global_params.handler_open_threads = strtoul(value, 0, 10);
+        } else if (!strcmp("OPENHPI_EVT_RATE_LIMIT", name)) {
+                global_params.evt_rate_limit = strtoul(value, 0, 10);
+        } else if (!strcmp("OPENHPI_EVT_RATE_BURST", name)) {
+                global_params.evt_rate_burst = strtoul(value, 0, 10);
+        } else if (!strcmp("OPENHPI_EVT_RATE_SEV", name)) {
+                SaHpiTextBufferT buffer;
+                strncpy((char *)buffer.Data, value, SAHPI_MAX_TEXT_BUFFER_LENGTH);
+                oh_encode_severity(&buffer, &global_params.evt_rate_sev);
+        } else if (!strcmp("OPENHPI_EVT_COALESCE_WINDOW", name)) {
+                global_params.evt_coalesce_window = strtoul(value, 0, 10);
 	} else {
                 CRIT("Invalid global parameter %s in config file.", name);
         }
@@ -700,16 +741,24 @@ int oh_load_config (char *filename, struct oh_parsed_config *config)
 SaErrorT oh_process_config(struct oh_parsed_config *config)
 {
         GSList *node = NULL;
+        struct oh_global_param param;
 
         if (!config) return SA_ERR_HPI_INVALID_PARAMS;
 
+        oh_get_global_param2(OPENHPI_HANDLER_OPEN_THREADS, &param);
+
         /* Initialize handlers */
         for (node = config->handler_configs; node; node = node->next) {
                 GHashTable *handler_config = (GHashTable *)node->data;
 		unsigned int hid = 0;
 		SaErrorT error = SA_OK;
 
-		error = oh_create_handler(handler_config, &hid);
+                /* With open threads the handlers are opened by oh_open_handlers */
+                if (param.u.handler_open_threads != 0) {
+                        error = oh_create_handler_deferred(handler_config, &hid);
+                } else {
+                        error = oh_create_handler(handler_config, &hid);
+                }
                 if (error == SA_OK) {
                         DBG("Loaded handler for plugin %s",
                             (char *)g_hash_table_lookup(handler_config, "plugin"));
@@ -803,6 +852,27 @@ int oh_get_global_param(struct oh_global_param *param)
                 case OPENHPI_AUTOINSERT_TIMEOUT_READONLY:
                         param->u.ai_timeout_readonly = global_params.ai_timeout_readonly;
                         break;
+                case OPENHPI_SENSOR_CACHE_MAX_AGE:
+                        param->u.sensor_cache_max_age = global_params.sensor_cache_max_age;
+                        break;
+                case OPENHPI_SNAPSHOT:
+                        param->u.snapshot = global_params.snapshot;
+                        break;
+                case OPENHPI_HANDLER_OPEN_THREADS:
+                        param->u.handler_open_threads = global_params.handler_open_threads;
+                        break;
+                case OPENHPI_EVT_RATE_LIMIT:
+                        param->u.evt_rate_limit = global_params.evt_rate_limit;
+                        break;
+                case OPENHPI_EVT_RATE_BURST:
+                        param->u.evt_rate_burst = global_params.evt_rate_burst;
+                        break;
+                case OPENHPI_EVT_RATE_SEV:
+                        param->u.evt_rate_sev = global_params.evt_rate_sev;
+                        break;
+                case OPENHPI_EVT_COALESCE_WINDOW:
+                        param->u.evt_coalesce_window = global_params.evt_coalesce_window;
+                        break;
                 default:
                         wrap_g_static_rec_mutex_unlock(&global_params.lock);
                         CRIT("Invalid global parameter %d!", param->type);
@@ -896,6 +966,27 @@ int oh_set_global_param(const struct oh_global_param *param)
                 case OPENHPI_AUTOINSERT_TIMEOUT_READONLY:
                         global_params.ai_timeout_readonly = param->u.ai_timeout_readonly;
                         break;
+                case OPENHPI_SENSOR_CACHE_MAX_AGE:
+                        global_params.sensor_cache_max_age = param->u.sensor_cache_max_age;
+                        break;
+                case OPENHPI_SNAPSHOT:
+                        global_params.snapshot = param->u.snapshot;
+                        break;
+                case OPENHPI_HANDLER_OPEN_THREADS:
+                        global_params.handler_open_threads = param->u.handler_open_threads;
+                        break;
+                case OPENHPI_EVT_RATE_LIMIT:
+                        global_params.evt_rate_limit = param->u.evt_rate_limit;
+                        break;
+                case OPENHPI_EVT_RATE_BURST:
+                        global_params.evt_rate_burst = param->u.evt_rate_burst;
+                        break;
+                case OPENHPI_EVT_RATE_SEV:
+                        global_params.evt_rate_sev = param->u.evt_rate_sev;
+                        break;
+                case OPENHPI_EVT_COALESCE_WINDOW:
+                        global_params.evt_coalesce_window = param->u.evt_coalesce_window;
+                        break;
                 default:
                         wrap_g_static_rec_mutex_unlock(&global_params.lock);
                         CRIT("Invalid global parameter %d!", param->type);
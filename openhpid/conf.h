@@ -46,7 +46,14 @@ typedef enum {
         OPENHPI_CONF, 
 	OPENHPI_UNCONFIGURED,
         OPENHPI_AUTOINSERT_TIMEOUT,
-        OPENHPI_AUTOINSERT_TIMEOUT_READONLY
+        OPENHPI_AUTOINSERT_TIMEOUT_READONLY,
+        OPENHPI_SENSOR_CACHE_MAX_AGE,
+        OPENHPI_SNAPSHOT,
+        OPENHPI_HANDLER_OPEN_THREADS,
+        OPENHPI_EVT_RATE_LIMIT,
+        OPENHPI_EVT_RATE_BURST,
+        OPENHPI_EVT_RATE_SEV,
+        OPENHPI_EVT_COALESCE_WINDOW
 } oh_global_param_type;
 
 typedef union {
@@ -64,6 +71,13 @@ typedef union {
 	SaHpiBoolT unconfigured;
         SaHpiTimeoutT ai_timeout;
         SaHpiBoolT ai_timeout_readonly;
+        SaHpiUint32T sensor_cache_max_age; /* msec, 0 - no cache */
+        SaHpiBoolT snapshot; /* Warm-start RPT snapshots */
+        SaHpiUint32T handler_open_threads; /* 0 - open at startup */
+        SaHpiUint32T evt_rate_limit; /* events/sec per resource, 0 - no limit */
+        SaHpiUint32T evt_rate_burst;
+        SaHpiSeverityT evt_rate_sev; /* this and less severe are limited */
+        SaHpiUint32T evt_coalesce_window; /* msec, 0 - no coalescing */
 } oh_global_param_union;
 
 struct oh_global_param {
@@ -27,6 +27,7 @@
 #include "alarm.h"
 #include "conf.h"
 #include "event.h"
+#include "metrics.h"
 #include "sahpi_wrappers.h"
 
 #define domains_lock() wrap_g_static_rec_mutex_lock(&oh_domains.lock)
@@ -119,7 +120,7 @@ static GList *__get_domain(SaHpiDomainIdT did)
         /* Unlock domain table */
         domains_unlock();
         /* Wait to get domain lock */
-        wrap_g_static_rec_mutex_lock(&domain->lock);
+        oh_metrics_lock(OH_METRIC_DOMAIN_LOCK, &domain->lock);
 
         return node;
 }
@@ -34,7 +34,11 @@
 
 #include "alarm.h"
 #include "conf.h"
+#include "metrics.h"
 #include "event.h"
+#include "event_sched.h"
+#include "sensor_cache.h"
+#include "snapshot.h"
 
 
 extern volatile int signal_stop;
@@ -176,7 +180,7 @@ static SaErrorT harvest_events_for_handler(struct oh_handler *h)
 	if (!h->hnd || !h->abi->get_event) return SA_OK;
 
         do {
-                error = h->abi->get_event(h->hnd);
+                OH_METRICS_ABI_CALL(h, get_event, error);
                 if (error < 1) {
                         DBG("Handler is out of Events");
                 }
@@ -269,6 +273,7 @@ static int process_hpi_event(struct oh_domain *d, struct oh_event *e)
         SaHpiEventT *event = NULL;
         SaHpiRptEntryT *resource = NULL;
         SaHpiRdrT *rdr = NULL;
+        const SaHpiEntityPathT *ep = NULL;
 
         if (!d || !e) return -1;
 
@@ -303,16 +308,23 @@ static int process_hpi_event(struct oh_domain *d, struct oh_event *e)
                 return 0;
         }
 
+        /* Entity path for the session event filters */
+        if (resource->ResourceCapabilities != 0) {
+                ep = &resource->ResourceEntity;
+        } else {
+                SaHpiRptEntryT *rpte = oh_get_resource_by_id(&d->rpt, event->Source);
+                if (rpte) ep = &rpte->ResourceEntity;
+        }
+
         /* multiplex event to the appropriate sessions */
         for (i = 0; i < sessions->len; i++) {
-                SaHpiBoolT is_subscribed = SAHPI_FALSE;
 #if defined(__sparc) || defined(__sparc__)
                 sid = ((SaHpiSessionIdT *)((void *)(sessions->data)))[i];
 #else
                 sid = g_array_index(sessions, SaHpiSessionIdT, i);
 #endif
-                oh_get_session_subscription(sid, &is_subscribed);
-                if (is_subscribed) {
+                /* Subscription and filter are checked before the event dup */
+                if (oh_session_event_wanted(sid, event, ep)) {
                         oh_queue_session_event(sid, e);
                 }
         }
@@ -397,6 +409,7 @@ static int process_resource_event(struct oh_domain *d, struct oh_event *e)
                 }
             }
         }
+        oh_snapshot_resource_seen(rpt, e);
 
         if ( process ) {
             process_hpi_event(d, e);
@@ -434,6 +447,7 @@ static int process_hs_event(struct oh_domain *d, struct oh_event *e)
                 }
             }
         }
+        oh_snapshot_resource_seen(rpt, e);
 
         if (hse->HotSwapState != hse->PreviousHotSwapState) {
             process_hpi_event(d, e);
@@ -459,6 +473,24 @@ static int process_event(SaHpiDomainIdT did,
 
         DBG("Processing event for domain %u", d->id);
 
+        /* Drop cached sensor readings outdated by the event */
+        switch (e->event.EventType) {
+        case SAHPI_ET_SENSOR:
+                oh_sensor_cache_invalidate(e->event.Source,
+                        e->event.EventDataUnion.SensorEvent.SensorNum);
+                break;
+        case SAHPI_ET_SENSOR_ENABLE_CHANGE:
+                oh_sensor_cache_invalidate(e->event.Source,
+                        e->event.EventDataUnion.SensorEnableChangeEvent.SensorNum);
+                break;
+        case SAHPI_ET_RESOURCE:
+        case SAHPI_ET_HOTSWAP:
+                oh_sensor_cache_invalidate_resource(e->event.Source);
+                break;
+        default:
+                break;
+        }
+
         switch (e->event.EventType) {
         case SAHPI_ET_RESOURCE:
                 if (!e->hid) {
@@ -531,9 +563,19 @@ SaErrorT oh_process_events()
 {
         int cc;
         struct oh_event *e;
+        guint64 start;
 
-        while ((e = g_async_queue_pop(oh_process_q)) != NULL) {
+        while ((e = oh_event_sched_pop(oh_process_q)) != NULL) {
+                if (oh_snapshot_detect_sync_event(e) == 0) {
+                        oh_snapshot_sync(e->hid);
+                        oh_event_free(e, FALSE);
+                        continue;
+                }
+                oh_metrics_queue(OH_METRIC_PROCESS_QUEUE,
+                                 oh_event_queue_length() + 1);
+                start = oh_metrics_now();
                 process_event(OH_DEFAULT_DOMAIN_ID, e);
+                oh_metrics_time(OH_METRIC_EVENT_PROCESS, start);
                 cc = oh_detect_quit_event(e);
                 oh_event_free(e, FALSE);
                 if (cc == 0) {
@@ -544,3 +586,13 @@ SaErrorT oh_process_events()
         return SA_OK;
 }
 
+guint oh_event_queue_length(void)
+{
+        struct oh_event_sched_stats stats;
+        gint n;
+
+        n = oh_process_q ? g_async_queue_length(oh_process_q) : 0;
+        oh_event_sched_get_stats(&stats);
+
+        return ((n > 0) ? n : 0) + stats.queued;
+}
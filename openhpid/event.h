@@ -35,6 +35,8 @@ void oh_post_quit_event(void);
 int oh_detect_quit_event(struct oh_event * e);
 SaErrorT oh_harvest_events(void);
 SaErrorT oh_process_events(void);
+/* Events in the process queue and the priority lanes */
+guint oh_event_queue_length(void);
 
 #ifdef __cplusplus
 }
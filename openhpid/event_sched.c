@@ -0,0 +1,668 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Order of event processing and event storm limits.
+ *
+ * Events are moved from the process queue to priority lanes by
+ * severity and the most severe lane is processed first. Resource
+ * and hotswap events share the first lane with CRITICAL events.
+ * Events of one lane keep their order. The queued events of a sensor
+ * are kept in one lane, so that e.g. a deassertion is not processed
+ * after a later assertion: a more severe event of the sensor moves
+ * them to its lane, a less severe one is queued in their lane.
+ * Likewise a resource or hotswap event moves all queued events of its
+ * resource to its lane first, so that e.g. a sensor assertion is not
+ * processed after the resource is removed.
+ * Snapshot sync and quit events
+ * are barriers: all events queued before them are processed first.
+ *
+ * At most SCHED_DRAIN events are moved to the lanes per processed
+ * event, so a CRITICAL event waits for at most the event being
+ * processed and that many moves.
+ *
+ * With OPENHPI_EVT_RATE_LIMIT not zero every resource has a token
+ * bucket of OPENHPI_EVT_RATE_BURST events that is refilled with
+ * OPENHPI_EVT_RATE_LIMIT events per second. Events of severity
+ * OPENHPI_EVT_RATE_SEV or less severe are dropped while the bucket
+ * of their resource is empty. Resource and hotswap events, sensor
+ * deassertions and events disabling a sensor are never dropped: they
+ * clear alarms raised by earlier events.
+ *
+ * With OPENHPI_EVT_COALESCE_WINDOW not zero a sensor event with the
+ * same resource, sensor, event state and assertion as an event
+ * accepted less than that many milliseconds before is dropped and
+ * counted on the accepted one. An event with the opposite assertion
+ * ends the window, so no state change is lost.
+ */
+
+#include <string.h>
+
+#include <glib.h>
+
+#include <oh_error.h>
+#include <oh_utils.h>
+
+#include "conf.h"
+#include "event.h"
+#include "event_sched.h"
+#include "metrics.h"
+#include "snapshot.h"
+
+
+#define SCHED_LANES 4
+#define SCHED_DRAIN 256
+/* Interval for dropping old buckets and coalescing entries, nsec */
+#define SCHED_SWEEP_INTERVAL 10000000000ULL
+
+struct sched_item;
+
+struct sched_coalesce_entry {
+        SaHpiResourceIdT rid;
+        SaHpiSensorNumT num;
+        SaHpiEventStateT state;
+        SaHpiBoolT assertion;
+        /* Time the event was accepted */
+        guint64 time;
+        /* The accepted event while it is in a lane */
+        struct sched_item *item;
+};
+
+/* Sensor with events in the lanes */
+struct sched_sensor {
+        SaHpiResourceIdT rid;
+        SaHpiSensorNumT num;
+        /* Lane of all its events */
+        guint lane;
+        /* Its events, oldest first */
+        GQueue items;
+};
+
+/* Resource with events in the lanes */
+struct sched_resource {
+        SaHpiResourceIdT rid;
+        /* Its events, oldest first */
+        GQueue items;
+};
+
+struct sched_item {
+        struct oh_event *e;
+        struct sched_coalesce_entry *entry;
+        struct sched_sensor *sensor;
+        struct sched_resource *resource;
+        /* Lane of the item and its link there */
+        guint lane;
+        GList *link;
+        /* Link of the item in the events of its resource */
+        GList *rlink;
+        /* Number of duplicates dropped */
+        guint coalesced;
+};
+
+struct sched_bucket {
+        gdouble tokens;
+        guint64 time;
+        /* Events are being dropped */
+        gboolean limited;
+};
+
+static struct {
+        gboolean initialized;
+        /* Configuration */
+        guint rate;
+        guint burst;
+        SaHpiSeverityT rate_sev;
+        guint64 window; /* nsec */
+        /* Only the processing thread uses the fields below */
+        GQueue lanes[SCHED_LANES];
+        struct oh_event *barrier;
+        GHashTable *buckets;
+        GHashTable *coalesce;
+        GHashTable *sensors;
+        GHashTable *resources;
+        guint64 sweep_time;
+        /* Read by other threads */
+        volatile gint queued;
+        volatile gint rate_limited;
+        volatile gint coalesced;
+} sched;
+
+
+static guint coalesce_hash(gconstpointer key)
+{
+        const struct sched_coalesce_entry *c = key;
+
+        return (c->rid * 257) ^ (c->num << 16) ^ c->state ^ c->assertion;
+}
+
+static gboolean coalesce_equal(gconstpointer a, gconstpointer b)
+{
+        const struct sched_coalesce_entry *ca = a;
+        const struct sched_coalesce_entry *cb = b;
+
+        return (ca->rid == cb->rid) && (ca->num == cb->num) &&
+               (ca->state == cb->state) && (ca->assertion == cb->assertion);
+}
+
+static void coalesce_free(gpointer data)
+{
+        struct sched_coalesce_entry *c = data;
+
+        if (c->item) {
+                c->item->entry = NULL;
+        }
+        g_free(c);
+}
+
+static void bucket_free(gpointer data)
+{
+        g_free(data);
+}
+
+static guint sensor_hash(gconstpointer key)
+{
+        const struct sched_sensor *s = key;
+
+        return (s->rid * 257) ^ s->num;
+}
+
+static gboolean sensor_equal(gconstpointer a, gconstpointer b)
+{
+        const struct sched_sensor *sa = a;
+        const struct sched_sensor *sb = b;
+
+        return (sa->rid == sb->rid) && (sa->num == sb->num);
+}
+
+static void sensor_free(gpointer data)
+{
+        struct sched_sensor *s = data;
+
+        g_list_free(s->items.head);
+        g_free(s);
+}
+
+static void resource_free(gpointer data)
+{
+        struct sched_resource *r = data;
+
+        g_list_free(r->items.head);
+        g_free(r);
+}
+
+int oh_event_sched_init(void)
+{
+        struct oh_global_param param;
+
+        if (sched.initialized) {
+                return 0;
+        }
+
+        oh_get_global_param2(OPENHPI_EVT_RATE_LIMIT, &param);
+        sched.rate = param.u.evt_rate_limit;
+        oh_get_global_param2(OPENHPI_EVT_RATE_BURST, &param);
+        sched.burst = param.u.evt_rate_burst ? param.u.evt_rate_burst : 1;
+        oh_get_global_param2(OPENHPI_EVT_RATE_SEV, &param);
+        sched.rate_sev = param.u.evt_rate_sev;
+        oh_get_global_param2(OPENHPI_EVT_COALESCE_WINDOW, &param);
+        sched.window = (guint64)param.u.evt_coalesce_window * 1000000ULL;
+
+        memset(&sched.lanes, 0, sizeof(sched.lanes));
+        sched.barrier = NULL;
+        sched.buckets = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                              NULL, bucket_free);
+        sched.coalesce = g_hash_table_new_full(coalesce_hash, coalesce_equal,
+                                               coalesce_free, NULL);
+        sched.sensors = g_hash_table_new_full(sensor_hash, sensor_equal,
+                                              sensor_free, NULL);
+        sched.resources = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                                NULL, resource_free);
+        sched.sweep_time = oh_metrics_now();
+        sched.initialized = TRUE;
+
+        if (sched.rate) {
+                INFO("Rate limit is %u events/s per resource, burst %u.",
+                     sched.rate, sched.burst);
+        }
+        if (sched.window) {
+                INFO("Duplicate sensor events are coalesced within %u ms.",
+                     (guint)(sched.window / 1000000ULL));
+        }
+
+        return 0;
+}
+
+int oh_event_sched_finit(void)
+{
+        struct sched_item *item;
+        guint i;
+
+        if (!sched.initialized) {
+                return 0;
+        }
+
+        g_hash_table_destroy(sched.coalesce);
+        g_hash_table_destroy(sched.buckets);
+        g_hash_table_destroy(sched.sensors);
+        g_hash_table_destroy(sched.resources);
+        for (i = 0; i < SCHED_LANES; ++i) {
+                while ((item = g_queue_pop_head(&sched.lanes[i])) != NULL) {
+                        oh_event_free(item->e, FALSE);
+                        g_slice_free(struct sched_item, item);
+                }
+        }
+        if (sched.barrier) {
+                oh_event_free(sched.barrier, FALSE);
+                sched.barrier = NULL;
+        }
+        g_atomic_int_set(&sched.queued, 0);
+        sched.initialized = FALSE;
+
+        return 0;
+}
+
+static guint sched_lane(const struct oh_event *e)
+{
+        switch (e->event.EventType) {
+        case SAHPI_ET_RESOURCE:
+        case SAHPI_ET_HOTSWAP:
+                return 0;
+        default:
+                break;
+        }
+
+        switch (e->event.Severity) {
+        case SAHPI_CRITICAL:
+                return 0;
+        case SAHPI_MAJOR:
+                return 1;
+        case SAHPI_MINOR:
+                return 2;
+        default:
+                return 3;
+        }
+}
+
+/* Returns TRUE and the sensor number for events of a sensor */
+static gboolean sched_sensor_num(const struct oh_event *e, SaHpiSensorNumT *num)
+{
+        switch (e->event.EventType) {
+        case SAHPI_ET_SENSOR:
+                *num = e->event.EventDataUnion.SensorEvent.SensorNum;
+                return TRUE;
+        case SAHPI_ET_SENSOR_ENABLE_CHANGE:
+                *num = e->event.EventDataUnion.SensorEnableChangeEvent.SensorNum;
+                return TRUE;
+        default:
+                return FALSE;
+        }
+}
+
+/* Returns TRUE for events of the resource lifecycle */
+static gboolean sched_lifecycle(const struct oh_event *e)
+{
+        return (e->event.EventType == SAHPI_ET_RESOURCE ||
+                e->event.EventType == SAHPI_ET_HOTSWAP);
+}
+
+/* Moves the queued items in less severe lanes to the lane, in order */
+static void sched_pull(GQueue *items, guint lane)
+{
+        GList *l;
+
+        for (l = items->head; l != NULL; l = l->next) {
+                struct sched_item *queued = l->data;
+                if (queued->lane <= lane) {
+                        continue;
+                }
+                g_queue_unlink(&sched.lanes[queued->lane], queued->link);
+                g_queue_push_tail_link(&sched.lanes[lane], queued->link);
+                queued->lane = lane;
+                if (queued->sensor) {
+                        queued->sensor->lane = lane;
+                }
+        }
+}
+
+static void sched_queue(struct sched_item *item)
+{
+        SaHpiResourceIdT rid = item->e->event.Source;
+        struct sched_resource *r;
+        struct sched_sensor key, *s;
+        guint lane = sched_lane(item->e);
+
+        item->link = g_list_alloc();
+        item->link->data = item;
+
+        r = g_hash_table_lookup(sched.resources, GUINT_TO_POINTER(rid));
+        if (!r) {
+                r = g_new0(struct sched_resource, 1);
+                r->rid = rid;
+                g_hash_table_insert(sched.resources, GUINT_TO_POINTER(rid), r);
+        } else if (sched_lifecycle(item->e)) {
+                sched_pull(&r->items, lane);
+        }
+
+        if (sched_sensor_num(item->e, &key.num)) {
+                key.rid = rid;
+                s = g_hash_table_lookup(sched.sensors, &key);
+                if (!s) {
+                        s = g_new0(struct sched_sensor, 1);
+                        s->rid = key.rid;
+                        s->num = key.num;
+                        s->lane = lane;
+                        g_hash_table_insert(sched.sensors, s, s);
+                } else if (lane < s->lane) {
+                        /* Move the queued events of the sensor along */
+                        sched_pull(&s->items, lane);
+                } else {
+                        lane = s->lane;
+                }
+                item->sensor = s;
+                g_queue_push_tail(&s->items, item);
+        }
+
+        item->lane = lane;
+        item->resource = r;
+        g_queue_push_tail(&r->items, item);
+        item->rlink = r->items.tail;
+        g_queue_push_tail_link(&sched.lanes[lane], item->link);
+}
+
+static gboolean sweep_bucket(gpointer key, gpointer value, gpointer data)
+{
+        struct sched_bucket *b = value;
+        guint64 now = *(guint64 *)data;
+
+        /* A bucket that is full again is the same as a new one */
+        return (gdouble)(now - b->time) * sched.rate / 1e9 + b->tokens
+               >= sched.burst;
+}
+
+static gboolean sweep_coalesce(gpointer key, gpointer value, gpointer data)
+{
+        struct sched_coalesce_entry *c = key;
+        guint64 now = *(guint64 *)data;
+
+        return (now - c->time >= sched.window);
+}
+
+static void sched_sweep(guint64 now)
+{
+        if (now - sched.sweep_time < SCHED_SWEEP_INTERVAL) {
+                return;
+        }
+        sched.sweep_time = now;
+        g_hash_table_foreach_remove(sched.buckets, sweep_bucket, &now);
+        g_hash_table_foreach_remove(sched.coalesce, sweep_coalesce, &now);
+}
+
+/* Returns TRUE for events that are never rate limited */
+static gboolean sched_rate_exempt(const struct oh_event *e)
+{
+        const SaHpiSensorEnableChangeEventT *ec;
+
+        switch (e->event.EventType) {
+        case SAHPI_ET_RESOURCE:
+        case SAHPI_ET_HOTSWAP:
+                return TRUE;
+        case SAHPI_ET_SENSOR:
+                return (e->event.EventDataUnion.SensorEvent.Assertion ==
+                        SAHPI_FALSE);
+        case SAHPI_ET_SENSOR_ENABLE_CHANGE:
+                ec = &e->event.EventDataUnion.SensorEnableChangeEvent;
+                return (ec->SensorEnable == SAHPI_FALSE ||
+                        ec->SensorEventEnable == SAHPI_FALSE);
+        default:
+                return FALSE;
+        }
+}
+
+/* Returns TRUE if the event is to be dropped */
+static gboolean sched_rate_limit(const struct oh_event *e, guint64 now)
+{
+        SaHpiResourceIdT rid = e->event.Source;
+        struct sched_bucket *b;
+
+        if (sched.rate == 0) {
+                return FALSE;
+        }
+        if (sched_rate_exempt(e)) {
+                return FALSE;
+        }
+        if (e->event.Severity < sched.rate_sev) {
+                return FALSE;
+        }
+
+        b = g_hash_table_lookup(sched.buckets, GUINT_TO_POINTER(rid));
+        if (!b) {
+                b = g_new0(struct sched_bucket, 1);
+                b->tokens = sched.burst;
+                b->time = now;
+                g_hash_table_insert(sched.buckets, GUINT_TO_POINTER(rid), b);
+        }
+
+        b->tokens += (gdouble)(now - b->time) * sched.rate / 1e9;
+        if (b->tokens > sched.burst) {
+                b->tokens = sched.burst;
+        }
+        b->time = now;
+
+        if (b->tokens >= 1.0) {
+                b->tokens -= 1.0;
+                if (b->limited) {
+                        INFO("Events from resource %u are no longer dropped.",
+                             rid);
+                        b->limited = FALSE;
+                }
+                return FALSE;
+        }
+
+        if (!b->limited) {
+                WARN("Event storm from resource %u, dropping events "
+                     "over %u/s.", rid, sched.rate);
+                b->limited = TRUE;
+        }
+
+        return TRUE;
+}
+
+static void coalesce_key(const struct oh_event *e,
+                         SaHpiBoolT assertion,
+                         struct sched_coalesce_entry *key)
+{
+        const SaHpiSensorEventT *se = &e->event.EventDataUnion.SensorEvent;
+
+        key->rid = e->event.Source;
+        key->num = se->SensorNum;
+        key->state = se->EventState;
+        key->assertion = assertion;
+}
+
+/* Returns TRUE if the event is a duplicate to be dropped */
+static gboolean sched_coalesce(const struct oh_event *e, guint64 now)
+{
+        struct sched_coalesce_entry key, *c;
+        SaHpiBoolT assertion;
+
+        if (sched.window == 0 || e->event.EventType != SAHPI_ET_SENSOR) {
+                return FALSE;
+        }
+
+        assertion = e->event.EventDataUnion.SensorEvent.Assertion;
+
+        /* A state change ends the window of the opposite assertion */
+        coalesce_key(e, !assertion, &key);
+        g_hash_table_remove(sched.coalesce, &key);
+
+        coalesce_key(e, assertion, &key);
+        c = g_hash_table_lookup(sched.coalesce, &key);
+        if (!c || now - c->time >= sched.window) {
+                return FALSE;
+        }
+
+        if (c->item) {
+                ++c->item->coalesced;
+        }
+
+        return TRUE;
+}
+
+static void sched_remember(struct sched_item *item, guint64 now)
+{
+        struct sched_coalesce_entry *c;
+
+        if (sched.window == 0 || item->e->event.EventType != SAHPI_ET_SENSOR) {
+                return;
+        }
+
+        c = g_new0(struct sched_coalesce_entry, 1);
+        coalesce_key(item->e,
+                     item->e->event.EventDataUnion.SensorEvent.Assertion,
+                     c);
+        c->time = now;
+        c->item = item;
+        item->entry = c;
+        /* Replaces the entry of an earlier window */
+        g_hash_table_replace(sched.coalesce, c, c);
+}
+
+static void sched_admit(struct oh_event *e)
+{
+        struct sched_item *item;
+        guint64 now;
+
+        if (oh_snapshot_detect_sync_event(e) == 0 ||
+            oh_detect_quit_event(e) == 0) {
+                sched.barrier = e;
+                return;
+        }
+
+        now = oh_metrics_now();
+        sched_sweep(now);
+
+        if (sched_coalesce(e, now)) {
+                g_atomic_int_inc(&sched.coalesced);
+                oh_metrics_count(OH_METRIC_EVENTS_COALESCED);
+                oh_event_free(e, FALSE);
+                return;
+        }
+        if (sched_rate_limit(e, now)) {
+                g_atomic_int_inc(&sched.rate_limited);
+                oh_metrics_count(OH_METRIC_EVENTS_RATE_LIMITED);
+                oh_event_free(e, FALSE);
+                return;
+        }
+
+        item = g_slice_new0(struct sched_item);
+        item->e = e;
+        sched_remember(item, now);
+        sched_queue(item);
+        g_atomic_int_inc(&sched.queued);
+}
+
+static struct oh_event * sched_take(void)
+{
+        struct sched_item *item;
+        struct sched_sensor *s;
+        struct sched_resource *r;
+        struct oh_event *e;
+        GList *link = NULL;
+        guint i;
+
+        for (i = 0; i < SCHED_LANES; ++i) {
+                link = g_queue_pop_head_link(&sched.lanes[i]);
+                if (link) {
+                        break;
+                }
+        }
+        if (!link) {
+                return NULL;
+        }
+        item = link->data;
+        g_list_free_1(link);
+        g_atomic_int_add(&sched.queued, -1);
+
+        /* The item is the oldest one of its sensor */
+        s = item->sensor;
+        if (s) {
+                g_queue_pop_head(&s->items);
+                if (s->items.length == 0) {
+                        g_hash_table_remove(sched.sensors, s);
+                }
+        }
+        /* Events of other sensors of the resource may be older */
+        r = item->resource;
+        g_queue_delete_link(&r->items, item->rlink);
+        if (r->items.length == 0) {
+                g_hash_table_remove(sched.resources, GUINT_TO_POINTER(r->rid));
+        }
+
+        e = item->e;
+        if (item->entry) {
+                item->entry->item = NULL;
+        }
+        if (item->coalesced) {
+                DBG("Coalesced %u duplicates of event from resource %u "
+                    "sensor %u.", item->coalesced, e->event.Source,
+                    e->event.EventDataUnion.SensorEvent.SensorNum);
+        }
+        g_slice_free(struct sched_item, item);
+
+        return e;
+}
+
+struct oh_event * oh_event_sched_pop(oh_evt_queue *queue)
+{
+        struct oh_event *e;
+        guint i;
+
+        if (!sched.initialized) {
+                oh_event_sched_init();
+        }
+
+        while (TRUE) {
+                if (!sched.barrier) {
+                        /* Wait only when there is nothing to process */
+                        if (g_atomic_int_get(&sched.queued) == 0) {
+                                e = g_async_queue_pop(queue);
+                                if (!e) {
+                                        return NULL;
+                                }
+                                sched_admit(e);
+                        }
+                        for (i = 0; i < SCHED_DRAIN && !sched.barrier; ++i) {
+                                e = g_async_queue_try_pop(queue);
+                                if (!e) {
+                                        break;
+                                }
+                                sched_admit(e);
+                        }
+                }
+
+                e = sched_take();
+                if (e) {
+                        return e;
+                }
+                if (sched.barrier) {
+                        e = sched.barrier;
+                        sched.barrier = NULL;
+                        return e;
+                }
+        }
+}
+
+void oh_event_sched_get_stats(struct oh_event_sched_stats *stats)
+{
+        if (!stats) {
+                return;
+        }
+        stats->queued = g_atomic_int_get(&sched.queued);
+        stats->rate_limited = g_atomic_int_get(&sched.rate_limited);
+        stats->coalesced = g_atomic_int_get(&sched.coalesced);
+}
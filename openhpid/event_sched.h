@@ -0,0 +1,44 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __OH_EVENT_SCHED_H
+#define __OH_EVENT_SCHED_H
+
+#include <glib.h>
+
+#include <SaHpi.h>
+#include <oh_utils.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oh_event_sched_stats {
+        guint queued;       /* events waiting in the priority lanes */
+        guint rate_limited; /* events dropped by the rate limit */
+        guint coalesced;    /* duplicate events dropped */
+};
+
+/* Reads OPENHPI_EVT_RATE_* and OPENHPI_EVT_COALESCE_WINDOW */
+int oh_event_sched_init(void);
+int oh_event_sched_finit(void);
+
+/* Returns the next event to process, waits for events on queue.
+ * Only one thread may call it. */
+struct oh_event * oh_event_sched_pop(oh_evt_queue *queue);
+
+void oh_event_sched_get_stats(struct oh_event_sched_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OH_EVENT_SCHED_H */
@@ -36,8 +36,12 @@
 
 #include "conf.h"
 #include "event.h"
+#include "event_sched.h"
 #include "init.h"
 #include "lock.h"
+#include "sensor_cache.h"
+#include "sensor_sampler.h"
+#include "snapshot.h"
 #include "threaded.h"
 #include "sahpi_wrappers.h"
 
@@ -66,6 +70,12 @@ int oh_init(void)
         /* Initialize event queue */
         oh_event_init();
 
+        /* Initialize sensor reading cache */
+        oh_sensor_cache_init();
+
+        /* Initialize warm-start snapshots */
+        oh_snapshot_init();
+
 #ifdef HAVE_OPENSSL
         INFO("Initializing SSL Library.");
 	if (oh_ssl_init()) {
@@ -154,6 +164,19 @@ int oh_init(void)
          */
         oh_clean_config(&config);
 
+        /* Serve the saved resources until the first discovery */
+        if (config.handlers_loaded > 0) {
+                unsigned int hid = 0, next_hid;
+                while (oh_getnext_handler_id(hid, &next_hid) == 0 && next_hid) {
+                        hid = next_hid;
+                        oh_snapshot_load(hid);
+                }
+        }
+
+        /* Open the handlers in the background, if configured so */
+        oh_get_global_param2(OPENHPI_HANDLER_OPEN_THREADS, &param);
+        oh_open_handlers(param.u.handler_open_threads);
+
         /*
          * If any handlers were defined in the config file AND
          * all of them failed to load, Then return with an error.
@@ -166,9 +189,15 @@ int oh_init(void)
                      " Check previous messages.");
         }
 
+        /* Set up event priority lanes and storm limits */
+        oh_event_sched_init();
+
         /* Start discovery and event threads */
 	oh_threaded_start();
 
+        /* Start sensor sampler, if a handler samples sensors */
+        oh_sensor_sampler_start();
+
         initialized = 1;
         data_access_unlock();
 	INFO("OpenHPI has been initialized.");
@@ -201,6 +230,12 @@ int oh_init(void)
  **/
 int oh_finit(void)
 {
+        oh_sensor_sampler_stop();
+
+        oh_stop_handlers_open();
+
+        oh_snapshot_save_all();
+
         data_access_lock();
         oh_close_handlers();
         data_access_unlock();
@@ -216,7 +251,10 @@ int oh_finit(void)
         oh_ssl_finit();
 #endif
 
+        oh_event_sched_finit();
         oh_event_finit();
+        oh_sensor_cache_finit();
+        oh_snapshot_finit();
 
 	INFO("OpenHPI has been finalized.");
 
@@ -0,0 +1,531 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ *     Daemon metrics: latency histograms of RPCs, plugin ABI calls,
+ *     lock waits and event processing, queue lengths and counters.
+ *
+ *     Every thread records into its own series, so recording takes
+ *     no lock. A reader adds up the series of all threads. The series
+ *     of an exiting thread are added to the retired ones.
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include <glib.h>
+
+#include <oh_error.h>
+#include <oh_handler.h>
+#include <oh_session.h>
+#include <oh_utils.h>
+
+#include "event.h"
+#include "metrics.h"
+#include "sahpi_wrappers.h"
+
+
+#define METRICS_MAX_SERIES  1024
+#define METRICS_CHUNK       32   /* series allocated at once per thread */
+#define METRICS_MAX_RPC     512
+#define METRICS_ABI_TABLE   2048 /* power of 2, > METRICS_MAX_SERIES */
+#define METRICS_TIME_UNIT   1000 /* nanoseconds per bucket unit */
+
+struct metric_desc {
+        oHpiMetricTypeT type;
+        guint hid;
+        guint code; /* RPC id or ABI function index */
+        const char *name;
+};
+
+struct metric_series {
+        guint64 count;
+        guint64 sum;
+        guint64 max;
+        guint32 buckets[OHPI_METRIC_BUCKETS];
+};
+
+struct metrics_thread {
+        gpointer volatile chunks[METRICS_MAX_SERIES / METRICS_CHUNK];
+};
+
+/* Entries are only appended, under desc_lock */
+static struct metric_desc descs[METRICS_MAX_SERIES] = {
+        { OHPI_METRIC_LOCK,    0, 0, "domain" },
+        { OHPI_METRIC_LOCK,    0, 0, "handler" },
+        { OHPI_METRIC_TASK,    0, 0, "process_event" },
+        { OHPI_METRIC_QUEUE,   0, 0, "process_queue" },
+        { OHPI_METRIC_QUEUE,   0, 0, "session_queue" },
+        { OHPI_METRIC_COUNTER, 0, 0, "session_events_dropped" },
+        { OHPI_METRIC_COUNTER, 0, 0, "events_rate_limited" },
+        { OHPI_METRIC_COUNTER, 0, 0, "events_coalesced" },
+};
+static volatile gint nseries = OH_METRIC_FIXED;
+
+/* Series index + 1, 0 until the first call */
+static volatile gint rpc_series[METRICS_MAX_RPC];
+/* Series index + 1 of ABI calls, open addressing by handler and function */
+static volatile gint abi_series[METRICS_ABI_TABLE];
+
+#if GLIB_CHECK_VERSION (2, 32, 0)
+static GMutex desc_lock;   /* appending to descs */
+static GMutex thread_lock; /* threads, retired */
+#else
+static GStaticMutex desc_lock = G_STATIC_MUTEX_INIT;
+static GStaticMutex thread_lock = G_STATIC_MUTEX_INIT;
+#endif
+static GSList *threads = NULL;
+static struct metrics_thread retired;
+
+static void thread_release(gpointer data);
+
+#if GLIB_CHECK_VERSION (2, 32, 0)
+static GPrivate thread_key = G_PRIVATE_INIT(thread_release);
+#else
+static GStaticPrivate thread_key = G_STATIC_PRIVATE_INIT;
+#endif
+
+#define ABI_NAME(func) { OH_ABI_FUNC(func), #func }
+
+static const struct {
+        guint func;
+        const char *name;
+} abi_names[] = {
+        ABI_NAME(open),
+        ABI_NAME(close),
+        ABI_NAME(get_event),
+        ABI_NAME(discover_resources),
+        ABI_NAME(set_resource_tag),
+        ABI_NAME(set_resource_severity),
+        ABI_NAME(resource_failed_remove),
+        ABI_NAME(get_el_info),
+        ABI_NAME(get_el_caps),
+        ABI_NAME(set_el_time),
+        ABI_NAME(add_el_entry),
+        ABI_NAME(get_el_entry),
+        ABI_NAME(get_el_entries),
+        ABI_NAME(clear_el),
+        ABI_NAME(set_el_state),
+        ABI_NAME(reset_el_overflow),
+        ABI_NAME(get_sensor_reading),
+        ABI_NAME(get_sensor_readings),
+        ABI_NAME(get_sensor_thresholds),
+        ABI_NAME(set_sensor_thresholds),
+        ABI_NAME(get_sensor_enable),
+        ABI_NAME(set_sensor_enable),
+        ABI_NAME(get_sensor_event_enables),
+        ABI_NAME(set_sensor_event_enables),
+        ABI_NAME(get_sensor_event_masks),
+        ABI_NAME(set_sensor_event_masks),
+        ABI_NAME(get_control_state),
+        ABI_NAME(set_control_state),
+        ABI_NAME(get_idr_info),
+        ABI_NAME(get_idr_area_header),
+        ABI_NAME(add_idr_area),
+        ABI_NAME(add_idr_area_id),
+        ABI_NAME(del_idr_area),
+        ABI_NAME(get_idr_field),
+        ABI_NAME(get_idr_all),
+        ABI_NAME(add_idr_field),
+        ABI_NAME(add_idr_field_id),
+        ABI_NAME(set_idr_field),
+        ABI_NAME(del_idr_field),
+        ABI_NAME(get_watchdog_info),
+        ABI_NAME(set_watchdog_info),
+        ABI_NAME(reset_watchdog),
+        ABI_NAME(get_next_announce),
+        ABI_NAME(get_announce),
+        ABI_NAME(ack_announce),
+        ABI_NAME(add_announce),
+        ABI_NAME(del_announce),
+        ABI_NAME(get_annunc_mode),
+        ABI_NAME(set_annunc_mode),
+        ABI_NAME(get_dimi_info),
+        ABI_NAME(get_dimi_test),
+        ABI_NAME(get_dimi_test_ready),
+        ABI_NAME(start_dimi_test),
+        ABI_NAME(cancel_dimi_test),
+        ABI_NAME(get_dimi_test_status),
+        ABI_NAME(get_dimi_test_results),
+        ABI_NAME(get_fumi_spec),
+        ABI_NAME(get_fumi_service_impact),
+        ABI_NAME(set_fumi_source),
+        ABI_NAME(validate_fumi_source),
+        ABI_NAME(get_fumi_source),
+        ABI_NAME(get_fumi_source_component),
+        ABI_NAME(get_fumi_target),
+        ABI_NAME(get_fumi_target_component),
+        ABI_NAME(get_fumi_logical_target),
+        ABI_NAME(get_fumi_logical_target_component),
+        ABI_NAME(start_fumi_backup),
+        ABI_NAME(set_fumi_bank_order),
+        ABI_NAME(start_fumi_bank_copy),
+        ABI_NAME(start_fumi_install),
+        ABI_NAME(get_fumi_status),
+        ABI_NAME(start_fumi_verify),
+        ABI_NAME(start_fumi_verify_main),
+        ABI_NAME(cancel_fumi_upgrade),
+        ABI_NAME(get_fumi_autorollback_disable),
+        ABI_NAME(set_fumi_autorollback_disable),
+        ABI_NAME(start_fumi_rollback),
+        ABI_NAME(activate_fumi),
+        ABI_NAME(start_fumi_activate),
+        ABI_NAME(cleanup_fumi),
+        ABI_NAME(hotswap_policy_cancel),
+        ABI_NAME(set_autoinsert_timeout),
+        ABI_NAME(get_autoextract_timeout),
+        ABI_NAME(set_autoextract_timeout),
+        ABI_NAME(get_hotswap_state),
+        ABI_NAME(set_hotswap_state),
+        ABI_NAME(request_hotswap_action),
+        ABI_NAME(get_indicator_state),
+        ABI_NAME(set_indicator_state),
+        ABI_NAME(get_power_state),
+        ABI_NAME(set_power_state),
+        ABI_NAME(control_parm),
+        ABI_NAME(load_id_get),
+        ABI_NAME(load_id_set),
+        ABI_NAME(get_reset_state),
+        ABI_NAME(set_reset_state),
+        ABI_NAME(inject_event),
+};
+
+static const char *abi_name(guint func)
+{
+        guint i;
+
+        for (i = 0; i < G_N_ELEMENTS(abi_names); ++i) {
+                if (abi_names[i].func == func) {
+                        return abi_names[i].name;
+                }
+        }
+
+        return "unknown";
+}
+
+guint64 oh_metrics_now(void)
+{
+#if defined(CLOCK_MONOTONIC) && !defined(_WIN32)
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (guint64)ts.tv_sec * 1000000000ULL + (guint64)ts.tv_nsec;
+#elif GLIB_CHECK_VERSION (2, 28, 0)
+        return (guint64)g_get_monotonic_time() * 1000;
+#else
+        GTimeVal tv;
+
+        g_get_current_time(&tv);
+        return ((guint64)tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec) * 1000;
+#endif
+}
+
+static struct metrics_thread *thread_get(void)
+{
+        struct metrics_thread *t;
+
+        t = (struct metrics_thread *)wrap_g_static_private_get(&thread_key);
+        if (t) {
+                return t;
+        }
+
+        t = g_new0(struct metrics_thread, 1);
+#if GLIB_CHECK_VERSION (2, 32, 0)
+        wrap_g_static_private_set(&thread_key, t);
+#else
+        wrap_g_static_private_set(&thread_key, t, thread_release);
+#endif
+        wrap_g_static_mutex_lock(&thread_lock);
+        threads = g_slist_prepend(threads, t);
+        wrap_g_static_mutex_unlock(&thread_lock);
+
+        return t;
+}
+
+static void series_merge(struct metric_series *to,
+                         const struct metric_series *from)
+{
+        guint i;
+
+        to->count += from->count;
+        to->sum += from->sum;
+        if (from->max > to->max) {
+                to->max = from->max;
+        }
+        for (i = 0; i < OHPI_METRIC_BUCKETS; ++i) {
+                to->buckets[i] += from->buckets[i];
+        }
+}
+
+/* Adds the series of an exiting thread to the retired ones */
+static void thread_release(gpointer data)
+{
+        struct metrics_thread *t = (struct metrics_thread *)data;
+        guint c, i;
+
+        wrap_g_static_mutex_lock(&thread_lock);
+        threads = g_slist_remove(threads, t);
+        for (c = 0; c < G_N_ELEMENTS(t->chunks); ++c) {
+                struct metric_series *from = (struct metric_series *)t->chunks[c];
+                struct metric_series *to = (struct metric_series *)retired.chunks[c];
+
+                if (!from) {
+                        continue;
+                }
+                if (!to) {
+                        to = g_new0(struct metric_series, METRICS_CHUNK);
+                        retired.chunks[c] = to;
+                }
+                for (i = 0; i < METRICS_CHUNK; ++i) {
+                        series_merge(&to[i], &from[i]);
+                }
+                g_free(from);
+        }
+        wrap_g_static_mutex_unlock(&thread_lock);
+
+        g_free(t);
+}
+
+/* The series of the calling thread */
+static struct metric_series *series_get(guint index)
+{
+        struct metrics_thread *t = thread_get();
+        struct metric_series *chunk;
+
+        chunk = (struct metric_series *)t->chunks[index / METRICS_CHUNK];
+        if (!chunk) {
+                chunk = g_new0(struct metric_series, METRICS_CHUNK);
+                g_atomic_pointer_set(&t->chunks[index / METRICS_CHUNK], chunk);
+        }
+
+        return &chunk[index % METRICS_CHUNK];
+}
+
+static void series_add(guint index, guint64 value, guint64 unit)
+{
+        struct metric_series *s = series_get(index);
+        guint64 units = value / unit;
+        guint b;
+
+        if (units >= ((guint64)1 << (OHPI_METRIC_BUCKETS - 2))) {
+                b = OHPI_METRIC_BUCKETS - 1;
+        } else {
+                b = units ? g_bit_storage((gulong)units) : 0;
+        }
+
+        ++s->count;
+        s->sum += value;
+        if (value > s->max) {
+                s->max = value;
+        }
+        ++s->buckets[b];
+}
+
+/* Must be called with desc_lock held. Returns -1 if all series are taken. */
+static gint desc_add(oHpiMetricTypeT type, guint hid, guint code,
+                     const char *name)
+{
+        static gboolean warned = FALSE;
+        gint n = g_atomic_int_get(&nseries);
+
+        if (n >= METRICS_MAX_SERIES) {
+                if (!warned) {
+                        WARN("Too many metrics, %s is not recorded.", name);
+                        warned = TRUE;
+                }
+                return -1;
+        }
+
+        descs[n].type = type;
+        descs[n].hid = hid;
+        descs[n].code = code;
+        descs[n].name = name;
+        g_atomic_int_set(&nseries, n + 1);
+
+        return n;
+}
+
+void oh_metrics_time(enum oh_metric_id id, guint64 start)
+{
+        series_add(id, oh_metrics_now() - start, METRICS_TIME_UNIT);
+}
+
+void oh_metrics_rpc(guint rpc_id, const char *name, guint64 start)
+{
+        guint64 time = oh_metrics_now() - start;
+        gint index;
+
+        if (rpc_id >= METRICS_MAX_RPC) {
+                return;
+        }
+
+        index = g_atomic_int_get(&rpc_series[rpc_id]) - 1;
+        if (index < 0) {
+                wrap_g_static_mutex_lock(&desc_lock);
+                index = g_atomic_int_get(&rpc_series[rpc_id]) - 1;
+                if (index < 0) {
+                        index = desc_add(OHPI_METRIC_RPC, 0, rpc_id, name);
+                        g_atomic_int_set(&rpc_series[rpc_id], index + 1);
+                }
+                wrap_g_static_mutex_unlock(&desc_lock);
+                if (index < 0) {
+                        return;
+                }
+        }
+
+        series_add(index, time, METRICS_TIME_UNIT);
+}
+
+static guint abi_hash(guint hid, guint func)
+{
+        return (hid * 131 + func) & (METRICS_ABI_TABLE - 1);
+}
+
+/* Returns the slot of the series or, if there is none, -1 - free slot */
+static gint abi_lookup(guint hid, guint func)
+{
+        guint i;
+
+        for (i = abi_hash(hid, func); ; i = (i + 1) & (METRICS_ABI_TABLE - 1)) {
+                gint v = g_atomic_int_get(&abi_series[i]);
+                if (v == 0) {
+                        return -1 - (gint)i;
+                }
+                if ((descs[v - 1].hid == hid) && (descs[v - 1].code == func)) {
+                        return v - 1;
+                }
+        }
+}
+
+void oh_metrics_abi(guint hid, guint func, guint64 start)
+{
+        guint64 time = oh_metrics_now() - start;
+        gint index;
+
+        index = abi_lookup(hid, func);
+        if (index < 0) {
+                wrap_g_static_mutex_lock(&desc_lock);
+                index = abi_lookup(hid, func);
+                if (index < 0) {
+                        gint slot = -1 - index;
+                        index = desc_add(OHPI_METRIC_ABI, hid, func, abi_name(func));
+                        if (index >= 0) {
+                                g_atomic_int_set(&abi_series[slot], index + 1);
+                        }
+                }
+                wrap_g_static_mutex_unlock(&desc_lock);
+                if (index < 0) {
+                        return;
+                }
+        }
+
+        series_add(index, time, METRICS_TIME_UNIT);
+}
+
+void oh_metrics_queue(enum oh_metric_id id, guint length)
+{
+        series_add(id, length, 1);
+}
+
+void oh_metrics_count(enum oh_metric_id id)
+{
+        struct metric_series *s = series_get(id);
+
+        ++s->count;
+        ++s->sum;
+}
+
+void oh_metrics_lock(enum oh_metric_id id, void *mutex)
+{
+        guint64 start;
+
+        /* Most locks are free, they are counted without reading the clock */
+        if (wrap_g_static_rec_mutex_trylock(mutex)) {
+                series_add(id, 0, METRICS_TIME_UNIT);
+                return;
+        }
+
+        start = oh_metrics_now();
+        wrap_g_static_rec_mutex_lock(mutex);
+        oh_metrics_time(id, start);
+}
+
+static void add_session_queue(gpointer key, gpointer value, gpointer data)
+{
+        struct oh_session *session = (struct oh_session *)value;
+        gint length = g_async_queue_length(session->eventq);
+
+        if (length > 0) {
+                *(guint *)data += length;
+        }
+}
+
+static guint queue_length(enum oh_metric_id id)
+{
+        guint length = 0;
+
+        if (id == OH_METRIC_PROCESS_QUEUE) {
+                length = oh_event_queue_length();
+        } else if (id == OH_METRIC_SESSION_QUEUE) {
+                wrap_g_static_rec_mutex_lock(&oh_sessions.lock);
+                if (oh_sessions.table) {
+                        g_hash_table_foreach(oh_sessions.table,
+                                             add_session_queue, &length);
+                }
+                wrap_g_static_rec_mutex_unlock(&oh_sessions.lock);
+        }
+
+        return length;
+}
+
+gboolean oh_metrics_get(guint index, oHpiMetricT *metric)
+{
+        struct metric_series sum;
+        struct metric_desc desc;
+        guint c = index / METRICS_CHUNK;
+        struct metric_series *chunk;
+        GSList *node;
+
+        if (index >= (guint)g_atomic_int_get(&nseries)) {
+                return FALSE;
+        }
+        if (!metric) {
+                return TRUE;
+        }
+        desc = descs[index];
+
+        memset(&sum, 0, sizeof(sum));
+        wrap_g_static_mutex_lock(&thread_lock);
+        chunk = (struct metric_series *)retired.chunks[c];
+        if (chunk) {
+                series_merge(&sum, &chunk[index % METRICS_CHUNK]);
+        }
+        for (node = threads; node; node = node->next) {
+                struct metrics_thread *t = (struct metrics_thread *)node->data;
+                chunk = (struct metric_series *)g_atomic_pointer_get(&t->chunks[c]);
+                if (chunk) {
+                        series_merge(&sum, &chunk[index % METRICS_CHUNK]);
+                }
+        }
+        wrap_g_static_mutex_unlock(&thread_lock);
+
+        memset(metric, 0, sizeof(*metric));
+        metric->Type = desc.type;
+        metric->HandlerId = desc.hid;
+        oh_init_textbuffer(&metric->Name);
+        oh_append_textbuffer(&metric->Name, desc.name ? desc.name : "");
+        metric->Count = sum.count;
+        metric->Sum = sum.sum;
+        metric->Max = sum.max;
+        memcpy(metric->Buckets, sum.buckets, sizeof(metric->Buckets));
+        if (desc.type == OHPI_METRIC_QUEUE) {
+                metric->Current = queue_length((enum oh_metric_id)index);
+        }
+
+        return TRUE;
+}
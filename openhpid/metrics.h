@@ -0,0 +1,87 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __OH_METRICS_H
+#define __OH_METRICS_H
+
+#include <stddef.h>
+
+#include <glib.h>
+
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_handler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Metrics that always exist, in the order oHpiMetricGet() returns them.
+ * RPC and ABI metrics follow in order of first use. */
+enum oh_metric_id {
+        OH_METRIC_DOMAIN_LOCK = 0,
+        OH_METRIC_HANDLER_LOCK,
+        OH_METRIC_EVENT_PROCESS,
+        OH_METRIC_PROCESS_QUEUE,
+        OH_METRIC_SESSION_QUEUE,
+        OH_METRIC_EVENTS_DROPPED,
+        OH_METRIC_EVENTS_RATE_LIMITED,
+        OH_METRIC_EVENTS_COALESCED,
+        OH_METRIC_FIXED
+};
+
+/* Index of a function in struct oh_abi_v2 */
+#define OH_ABI_FUNC(func) \
+        (offsetof(struct oh_abi_v2, func) / sizeof(void (*)(void)))
+
+/* Calls a plugin ABI function and records its time.
+ * The caller checks that the handler has the function. */
+#define OH_METRICS_ABI_CALL(h, func, ret, params...) \
+        { \
+                guint64 __abi_start = oh_metrics_now(); \
+                ret = h->abi->func(h->hnd, ## params); \
+                oh_metrics_abi(h->id, OH_ABI_FUNC(func), __abi_start); \
+        }
+
+/* OH_CALL_ABI of sahpimacros.h that also records the time of the call */
+#define OH_CALL_ABI_TIMED(handler, func, err, ret, params...) \
+        { \
+                if (!handler || !handler->abi->func) { \
+                        oh_release_handler(handler); \
+                        return err; \
+                } \
+                OH_METRICS_ABI_CALL(handler, func, ret, params); \
+        }
+
+/* Monotonic time in nanoseconds */
+guint64 oh_metrics_now(void);
+
+/* Record the time since start for a fixed metric, an RPC or an ABI call */
+void oh_metrics_time(enum oh_metric_id id, guint64 start);
+void oh_metrics_rpc(guint rpc_id, const char *name, guint64 start);
+void oh_metrics_abi(guint hid, guint func, guint64 start);
+
+/* Record a queue length or count one occurrence */
+void oh_metrics_queue(enum oh_metric_id id, guint length);
+void oh_metrics_count(enum oh_metric_id id);
+
+/* Lock a GRecMutex/GStaticRecMutex and record the wait */
+void oh_metrics_lock(enum oh_metric_id id, void *mutex);
+
+/* Returns FALSE if there is no metric with that index.
+ * With a NULL metric only checks that it exists. */
+gboolean oh_metrics_get(guint index, oHpiMetricT *metric);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OH_METRICS_H */
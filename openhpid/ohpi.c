@@ -30,10 +30,15 @@
 #include <oh_utils.h>
 #include <sahpimacros.h>
 
+#include <marshal_hpi_types.h>
+
 #include "conf.h"
 #include "event.h"
 #include "init.h"
 #include "lock.h"
+#include "metrics.h"
+#include "sensor_cache.h"
+#include "sensor_sampler.h"
 
 
 /**
@@ -80,6 +85,13 @@ SaErrorT SAHPI_API oHpiHandlerCreate (
  
         oh_release_domain(d); /* Unlock domain */
 
+        /* The new handler may be the first one to sample sensors */
+        if (error == SA_OK) {
+                data_access_lock();
+                oh_sensor_sampler_start();
+                data_access_unlock();
+        }
+
 	return error;
 }
 
@@ -294,6 +306,13 @@ SaErrorT SAHPI_API oHpiHandlerRetry (
 		return SA_OK;
 	}
 
+	if (h->opening) {
+                // handler open is in progress
+ 		oh_release_handler(h);
+                oh_release_domain(d); /* Unlock domain */
+		return SA_ERR_HPI_BUSY;
+	}
+
 	h->hnd = h->abi->open(h->config, h->id, oh_process_q);
 	if (h->hnd == NULL) error = SA_ERR_HPI_INTERNAL_ERROR;
 	else error = SA_OK;
@@ -486,3 +505,788 @@ SaErrorT SAHPI_API oHpiDomainEntryGet (
 }
 
 
+
+/**
+ * oHpiSensorCacheStatsGet
+ **/
+SaErrorT SAHPI_API oHpiSensorCacheStatsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_OUT   oHpiSensorCacheStatsT *stats )
+{
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (!stats) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+
+        oh_sensor_cache_get_stats(stats);
+
+        return SA_OK;
+}
+
+/**
+ * oHpiSensorReadingsGet
+ **/
+SaErrorT SAHPI_API oHpiSensorReadingsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_INOUT oHpiSensorReadingsT *readings )
+{
+        SaErrorT rv;
+        struct oh_handler *h;
+        SaHpiRptEntryT *res;
+        SaHpiDomainIdT did;
+        struct oh_domain *d = NULL;
+        SaHpiSensorNumT nums[OH_MAX_SENSOR_READINGS];
+        SaHpiSensorReadingT r[OH_MAX_SENSOR_READINGS];
+        SaHpiEventStateT s[OH_MAX_SENSOR_READINGS];
+        SaErrorT results[OH_MAX_SENSOR_READINGS];
+        guint idx[OH_MAX_SENSOR_READINGS];
+        SaHpiUint32T i, n;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (!readings) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+        if (readings->NumberOfReadings > OH_MAX_SENSOR_READINGS) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+        OH_GET_DID(sid, did);
+        OH_GET_DOMAIN(did, d); /* Lock domain */
+        OH_RESOURCE_GET_CHECK(d, rid, res);
+
+        if (!(res->ResourceCapabilities & SAHPI_CAPABILITY_SENSOR)) {
+                oh_release_domain(d); /* Unlock domain */
+                return SA_ERR_HPI_CAPABILITY;
+        }
+
+        /* Only sensors that have RDRs go to the plugin */
+        n = 0;
+        for (i = 0; i < readings->NumberOfReadings; ++i) {
+                oHpiSensorReadingT *sr = &readings->Readings[i];
+                memset(&sr->Reading, 0, sizeof(SaHpiSensorReadingT));
+                sr->EventState = 0;
+                if (!oh_get_rdr_by_type(&(d->rpt), rid, SAHPI_SENSOR_RDR, sr->Num)) {
+                        sr->Result = SA_ERR_HPI_NOT_PRESENT;
+                        continue;
+                }
+                nums[n] = sr->Num;
+                idx[n] = i;
+                ++n;
+        }
+
+        OH_HANDLER_GET(d, rid, h);
+        oh_release_domain(d); /* Unlock domain */
+
+        if (!h) {
+                return SA_ERR_HPI_INVALID_CMD;
+        }
+
+        rv = SA_OK;
+        if (n > 0) {
+                memset(r, 0, sizeof(r));
+                memset(s, 0, sizeof(s));
+                rv = oh_sensor_cache_readings_get(h, rid, n, nums, r, s, results);
+        }
+        oh_release_handler(h);
+
+        if (rv != SA_OK) {
+                return rv;
+        }
+
+        for (i = 0; i < n; ++i) {
+                oHpiSensorReadingT *sr = &readings->Readings[idx[i]];
+                sr->Result = results[i];
+                if (results[i] != SA_OK) {
+                        continue;
+                }
+                /* See saHpiSensorReadingGet */
+                if (r[i].IsSupported == SAHPI_FALSE) {
+                        r[i].Type = 0;
+                        memset(&(r[i].Value), 0, sizeof(SaHpiSensorReadingUnionT));
+                }
+                memcpy(&sr->Reading, &r[i], sizeof(SaHpiSensorReadingT));
+                sr->EventState = s[i];
+        }
+
+        return SA_OK;
+}
+
+/**
+ * oHpiSensorHistoryGet
+ **/
+SaErrorT SAHPI_API oHpiSensorHistoryGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_IN    SaHpiSensorNumT num,
+     SAHPI_IN    SaHpiTimeT start,
+     SAHPI_IN    SaHpiTimeT end,
+     SAHPI_OUT   oHpiSensorHistoryT *history )
+{
+        SaHpiRptEntryT *res;
+        SaHpiDomainIdT did;
+        struct oh_domain *d = NULL;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (!history) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+        OH_GET_DID(sid, did);
+        OH_GET_DOMAIN(did, d); /* Lock domain */
+        OH_RESOURCE_GET(d, rid, res);
+        oh_release_domain(d); /* Unlock domain */
+
+        return oh_sensor_sampler_history_get(rid, num, start, end, history);
+}
+
+/* Upper limit for the marshaled payload of the batched replies */
+#define OH_BATCH_MAX_REPLY 60000
+
+/*
+ * Upper bound of the marshaled size of a batch entry. The fixed size
+ * encoding of RPC version 1 is at most the in-memory size, while the
+ * varints of version 2 can exceed it.
+ */
+static SaHpiUint32T oh_batch_entry_size(const cMarshalType *type, gsize size)
+{
+        int max = MarshalCompactMaxSize(type);
+
+        return (max > (int)size) ? (SaHpiUint32T)max : (SaHpiUint32T)size;
+}
+
+static void oh_events_get_copy(struct oh_event *e,
+                               SaHpiEventT *event,
+                               SaHpiRdrT *rdr,
+                               SaHpiRptEntryT *rpte)
+{
+        *event = e->event;
+        if (rpte) *rpte = e->resource;
+        if (rdr) {
+                if (e->rdrs) {
+                        memcpy(rdr, e->rdrs->data, sizeof(SaHpiRdrT));
+                } else {
+                        rdr->RdrType = SAHPI_NO_RECORD;
+                }
+        }
+}
+
+/**
+ * oHpiEventsGet
+ **/
+SaErrorT SAHPI_API oHpiEventsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiTimeoutT Timeout,
+     SAHPI_IN    SaHpiUint32T MaxEvents,
+     SAHPI_IN    SaHpiUint32T MaxBytes,
+     SAHPI_OUT   SaHpiUint32T *NumberOfEvents,
+     SAHPI_OUT   SaHpiEventT *Events,
+     SAHPI_INOUT SaHpiRdrT *Rdrs,
+     SAHPI_INOUT SaHpiRptEntryT *RptEntries,
+     SAHPI_INOUT SaHpiEvtQueueStatusT *EventQueueStatus )
+{
+        SaHpiDomainIdT did;
+        SaHpiBoolT subscribed;
+        struct oh_event e;
+        SaErrorT error;
+        SaHpiEvtQueueStatusT qstatus = 0, qs = 0;
+        SaHpiUint32T n, limit, per_event;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (!NumberOfEvents || !Events || MaxEvents == 0) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        } else if ((Timeout <= 0) && (Timeout != SAHPI_TIMEOUT_BLOCK) &&
+                   (Timeout != SAHPI_TIMEOUT_IMMEDIATE)) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+        OH_GET_DID(sid, did);
+
+        error = oh_get_session_subscription(sid, &subscribed);
+        if (error != SA_OK) return error;
+        if (!subscribed) {
+                return SA_ERR_HPI_INVALID_REQUEST;
+        }
+
+        per_event = oh_batch_entry_size(&SaHpiEventType, sizeof(SaHpiEventT));
+        if (Rdrs) {
+                per_event += oh_batch_entry_size(&SaHpiRdrType, sizeof(SaHpiRdrT));
+        }
+        if (RptEntries) {
+                per_event += oh_batch_entry_size(&SaHpiRptEntryType,
+                                                 sizeof(SaHpiRptEntryT));
+        }
+        if ((MaxBytes == 0) || (MaxBytes > OH_BATCH_MAX_REPLY)) {
+                MaxBytes = OH_BATCH_MAX_REPLY;
+        }
+        limit = MaxBytes / per_event;
+        if (limit > MaxEvents) limit = MaxEvents;
+        if (limit > OH_MAX_EVENTS_GET) limit = OH_MAX_EVENTS_GET;
+        if (limit == 0) limit = 1;
+
+        /* The first event is waited for as in saHpiEventGet */
+        error = oh_dequeue_session_event(sid, SAHPI_TIMEOUT_IMMEDIATE,
+                                         &e, &qs);
+        qstatus |= qs;
+        if (error == SA_ERR_HPI_TIMEOUT) {
+                error = oh_dequeue_session_event(sid, Timeout, &e, &qs);
+                qstatus |= qs;
+        }
+        if (error != SA_OK) {
+                return error;
+        }
+        oh_events_get_copy(&e, &Events[0],
+                           Rdrs ? &Rdrs[0] : NULL,
+                           RptEntries ? &RptEntries[0] : NULL);
+        oh_event_free(&e, TRUE);
+
+        /* The rest is only taken if already queued */
+        for (n = 1; n < limit; ++n) {
+                error = oh_dequeue_session_event(sid, SAHPI_TIMEOUT_IMMEDIATE,
+                                                 &e, &qs);
+                qstatus |= qs;
+                if (error != SA_OK) {
+                        break;
+                }
+                oh_events_get_copy(&e, &Events[n],
+                                   Rdrs ? &Rdrs[n] : NULL,
+                                   RptEntries ? &RptEntries[n] : NULL);
+                oh_event_free(&e, TRUE);
+        }
+
+        *NumberOfEvents = n;
+        if (EventQueueStatus) {
+                *EventQueueStatus = qstatus;
+        }
+
+        return SA_OK;
+}
+
+/**
+ * oHpiEventFilterSet
+ **/
+SaErrorT SAHPI_API oHpiEventFilterSet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    const oHpiEventFilterT *filter )
+{
+        SaHpiDomainIdT did;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+
+        OH_CHECK_INIT_STATE(sid);
+        OH_GET_DID(sid, did);
+
+        return oh_set_session_filter(sid, filter);
+}
+
+/* Max number of log entries examined by one oHpiEventLogEntriesGet call */
+#define OH_EL_ENTRIES_SCAN_MAX 4096
+
+static SaHpiBoolT oh_el_entry_in_window(const SaHpiEventLogEntryT *entry,
+                                        SaHpiTimeT start,
+                                        SaHpiTimeT end)
+{
+        if ((start != SAHPI_TIME_UNSPECIFIED) && (entry->Timestamp < start)) {
+                return SAHPI_FALSE;
+        }
+        if ((end != SAHPI_TIME_UNSPECIFIED) && (entry->Timestamp > end)) {
+                return SAHPI_FALSE;
+        }
+        return SAHPI_TRUE;
+}
+
+/*
+ * Reads the plugin log with the get_el_entries ABI.
+ * The entries outside of the time window are dropped.
+ */
+static SaErrorT oh_el_entries_get_batched(struct oh_handler *h,
+                                          SaHpiResourceIdT rid,
+                                          SaHpiEventLogEntryIdT *id,
+                                          SaHpiUint32T limit,
+                                          SaHpiTimeT start,
+                                          SaHpiTimeT end,
+                                          SaHpiUint32T *n,
+                                          SaHpiUint32T *scanned,
+                                          SaHpiEventLogEntryT *entries,
+                                          SaHpiRdrT *rdrs,
+                                          SaHpiRptEntryT *rptes)
+{
+        SaErrorT rv = SA_OK;
+        SaHpiUint32T got, base, i;
+        SaHpiEventLogEntryIdT next;
+
+        while ((*n < limit) && (*scanned < OH_EL_ENTRIES_SCAN_MAX) &&
+               (*id != SAHPI_NO_MORE_ENTRIES)) {
+                got = 0;
+                next = SAHPI_NO_MORE_ENTRIES;
+                rv = h->abi->get_el_entries(h->hnd, rid, *id, limit - *n,
+                                            &got,
+                                            &entries[*n],
+                                            rdrs ? &rdrs[*n] : NULL,
+                                            rptes ? &rptes[*n] : NULL,
+                                            &next);
+                if (rv != SA_OK) {
+                        break;
+                }
+                if (got > limit - *n) {
+                        CRIT("Plugin returned too many log entries.");
+                        rv = SA_ERR_HPI_INTERNAL_ERROR;
+                        break;
+                }
+                *scanned += got;
+                /* Compact the entries within the time window */
+                base = *n;
+                for (i = 0; i < got; i++) {
+                        SaHpiUint32T from = base + i;
+                        if (!oh_el_entry_in_window(&entries[from], start, end)) {
+                                continue;
+                        }
+                        if (from != *n) {
+                                entries[*n] = entries[from];
+                                if (rdrs) rdrs[*n] = rdrs[from];
+                                if (rptes) rptes[*n] = rptes[from];
+                        }
+                        ++(*n);
+                }
+                *id = next;
+                if (got == 0) {
+                        break;
+                }
+        }
+
+        return rv;
+}
+
+/**
+ * oHpiEventLogEntriesGet
+ **/
+SaErrorT SAHPI_API oHpiEventLogEntriesGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_IN    SaHpiEventLogEntryIdT StartEntryId,
+     SAHPI_IN    SaHpiUint32T MaxEntries,
+     SAHPI_IN    SaHpiTimeT StartTime,
+     SAHPI_IN    SaHpiTimeT EndTime,
+     SAHPI_OUT   SaHpiUint32T *NumberOfEntries,
+     SAHPI_OUT   SaHpiEventLogEntryT *Entries,
+     SAHPI_INOUT SaHpiRdrT *Rdrs,
+     SAHPI_INOUT SaHpiRptEntryT *RptEntries,
+     SAHPI_OUT   SaHpiEventLogEntryIdT *NextEntryId )
+{
+        SaErrorT rv = SA_OK;
+        SaHpiRptEntryT *res;
+        struct oh_handler *h;
+        struct oh_domain *d;
+        SaHpiDomainIdT did;
+        SaHpiEventLogEntryIdT id, prev, next;
+        SaHpiUint32T n, scanned, limit, per_entry;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (!NumberOfEntries || !Entries || !NextEntryId ||
+            MaxEntries == 0 || StartEntryId == SAHPI_NO_MORE_ENTRIES) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        per_entry = oh_batch_entry_size(&SaHpiEventLogEntryType,
+                                        sizeof(SaHpiEventLogEntryT));
+        if (Rdrs) {
+                per_entry += oh_batch_entry_size(&SaHpiRdrType, sizeof(SaHpiRdrT));
+        }
+        if (RptEntries) {
+                per_entry += oh_batch_entry_size(&SaHpiRptEntryType,
+                                                 sizeof(SaHpiRptEntryT));
+        }
+        limit = OH_BATCH_MAX_REPLY / per_entry;
+        if (limit > MaxEntries) limit = MaxEntries;
+        if (limit > OH_MAX_EVENT_LOG_ENTRIES_GET) limit = OH_MAX_EVENT_LOG_ENTRIES_GET;
+        if (limit == 0) limit = 1;
+
+        OH_CHECK_INIT_STATE(sid);
+        OH_GET_DID(sid, did);
+        OH_GET_DOMAIN(did, d); /* Lock domain */
+
+        n = 0;
+        id = StartEntryId;
+
+        /* test for special domain case */
+        if (rid == SAHPI_UNSPECIFIED_RESOURCE_ID) {
+                oh_el_entry *elentry;
+                for (scanned = 0;
+                     (n < limit) && (scanned < OH_EL_ENTRIES_SCAN_MAX) &&
+                     (id != SAHPI_NO_MORE_ENTRIES);
+                     ++scanned) {
+                        rv = oh_el_get(d->del, id, &prev, &next, &elentry);
+                        if (rv != SA_OK) {
+                                break;
+                        }
+                        if (oh_el_entry_in_window(&elentry->event, StartTime, EndTime)) {
+                                Entries[n] = elentry->event;
+                                if (Rdrs) Rdrs[n] = elentry->rdr;
+                                if (RptEntries) RptEntries[n] = elentry->res;
+                                ++n;
+                        }
+                        id = next;
+                }
+                oh_release_domain(d); /* Unlock domain */
+        } else {
+                OH_RESOURCE_GET_CHECK(d, rid, res);
+
+                if (!(res->ResourceCapabilities & SAHPI_CAPABILITY_EVENT_LOG)) {
+                        oh_release_domain(d); /* Unlock domain */
+                        return SA_ERR_HPI_CAPABILITY;
+                }
+
+                OH_HANDLER_GET(d, rid, h);
+                oh_release_domain(d); /* Unlock domain */
+
+                if (!h || !h->abi->get_el_entry) {
+                        oh_release_handler(h);
+                        return SA_ERR_HPI_INVALID_CMD;
+                }
+                scanned = 0;
+                rv = SA_ERR_HPI_UNSUPPORTED_API;
+                if (h->abi->get_el_entries) {
+                        rv = oh_el_entries_get_batched(h, rid, &id, limit,
+                                                       StartTime, EndTime,
+                                                       &n, &scanned,
+                                                       Entries, Rdrs,
+                                                       RptEntries);
+                }
+                /* Entry by entry if the plugin cannot do better */
+                if ((rv == SA_ERR_HPI_UNSUPPORTED_API) && (scanned == 0)) {
+                        rv = SA_OK;
+                        for (scanned = 0;
+                             (n < limit) && (scanned < OH_EL_ENTRIES_SCAN_MAX) &&
+                             (id != SAHPI_NO_MORE_ENTRIES);
+                             ++scanned) {
+                                SaHpiRdrT rdr;
+                                SaHpiRptEntryT rpte;
+                                rv = h->abi->get_el_entry(h->hnd, rid, id,
+                                                          &prev, &next,
+                                                          &Entries[n],
+                                                          &rdr, &rpte);
+                                if (rv != SA_OK) {
+                                        break;
+                                }
+                                if (oh_el_entry_in_window(&Entries[n],
+                                                          StartTime, EndTime)) {
+                                        if (Rdrs) Rdrs[n] = rdr;
+                                        if (RptEntries) RptEntries[n] = rpte;
+                                        ++n;
+                                }
+                                id = next;
+                        }
+                }
+                oh_release_handler(h);
+        }
+
+        /* Only a failure on the first entry is reported,
+         * otherwise the caller continues from NextEntryId */
+        if ((rv != SA_OK) && (scanned == 0)) {
+                return rv;
+        }
+
+        *NumberOfEntries = n;
+        *NextEntryId = id;
+
+        return SA_OK;
+}
+
+
+/**
+ * oHpiHandlerStatusGet
+ **/
+SaErrorT SAHPI_API oHpiHandlerStatusGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    oHpiHandlerIdT id,
+     SAHPI_OUT   oHpiHandlerStatusT *status )
+{
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (id == 0 || !status) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+
+        return oh_get_handler_status(id, status);
+}
+
+
+/**
+ * oHpiMemPoolStatsGet
+ **/
+SaErrorT SAHPI_API oHpiMemPoolStatsGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiEntryIdT EntryId,
+     SAHPI_OUT   SaHpiEntryIdT *NextEntryId,
+     SAHPI_OUT   oHpiMemPoolStatsT *Stats )
+{
+        struct oh_pool_stats stats;
+        struct oh_pool_stats next;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (EntryId == SAHPI_LAST_ENTRY || !NextEntryId || !Stats) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+
+        if (!oh_pool_get_stats(EntryId, &stats)) {
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+
+        memset(Stats, 0, sizeof(*Stats));
+        oh_init_textbuffer(&Stats->Name);
+        oh_append_textbuffer(&Stats->Name, stats.name);
+        Stats->ObjectSize = stats.size;
+        Stats->Slabs = stats.slabs;
+        Stats->Capacity = stats.capacity;
+        Stats->Free = stats.free;
+        Stats->Cached = stats.cached;
+        Stats->Allocs = stats.allocs;
+        Stats->Frees = stats.frees;
+        Stats->HeapAllocs = stats.heap_allocs;
+        Stats->HeapFrees = stats.heap_frees;
+
+        if (oh_pool_get_stats(EntryId + 1, &next)) {
+                *NextEntryId = EntryId + 1;
+        } else {
+                *NextEntryId = SAHPI_LAST_ENTRY;
+        }
+
+        return SA_OK;
+}
+
+/**
+ * oHpiMetricGet
+ **/
+SaErrorT SAHPI_API oHpiMetricGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiEntryIdT EntryId,
+     SAHPI_OUT   SaHpiEntryIdT *NextEntryId,
+     SAHPI_OUT   oHpiMetricT *Metric )
+{
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (EntryId == SAHPI_LAST_ENTRY || !NextEntryId || !Metric) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        OH_CHECK_INIT_STATE(sid);
+
+        if (!oh_metrics_get(EntryId, Metric)) {
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+
+        if (oh_metrics_get(EntryId + 1, NULL)) {
+                *NextEntryId = EntryId + 1;
+        } else {
+                *NextEntryId = SAHPI_LAST_ENTRY;
+        }
+
+        return SA_OK;
+}
+
+/*
+ * Reads whole areas of an IDR with get_idr_area_header and get_idr_field.
+ * Stops before an area whose fields do not fit any more.
+ */
+static SaErrorT oh_idr_get_iterated(struct oh_handler *h,
+                                    SaHpiResourceIdT rid,
+                                    SaHpiIdrIdT idrid,
+                                    SaHpiEntryIdT start,
+                                    SaHpiUint32T max_areas,
+                                    SaHpiUint32T max_fields,
+                                    SaHpiIdrInfoT *info,
+                                    SaHpiUint32T *na,
+                                    SaHpiIdrAreaHeaderT *areas,
+                                    SaHpiUint32T *nf,
+                                    SaHpiIdrFieldT *fields,
+                                    SaHpiEntryIdT *next)
+{
+        SaErrorT rv;
+        SaHpiEntryIdT id, next_id, fid, next_fid;
+        SaHpiUint32T n;
+
+        OH_METRICS_ABI_CALL(h, get_idr_info, rv, rid, idrid, info);
+        if (rv != SA_OK) {
+                return rv;
+        }
+
+        *na = 0;
+        *nf = 0;
+        id = start;
+        while ((id != SAHPI_LAST_ENTRY) && (*na < max_areas)) {
+                OH_METRICS_ABI_CALL(h, get_idr_area_header, rv,
+                                    rid, idrid,
+                                    SAHPI_IDR_AREATYPE_UNSPECIFIED,
+                                    id, &next_id, &areas[*na]);
+                if ((rv == SA_ERR_HPI_NOT_PRESENT) &&
+                    (id == SAHPI_FIRST_ENTRY)) {
+                        /* IDR without areas */
+                        id = SAHPI_LAST_ENTRY;
+                        rv = SA_OK;
+                        break;
+                }
+                if (rv != SA_OK) {
+                        return rv;
+                }
+
+                n = *nf;
+                fid = SAHPI_FIRST_ENTRY;
+                while (fid != SAHPI_LAST_ENTRY) {
+                        if (n == max_fields) {
+                                rv = SA_ERR_HPI_OUT_OF_SPACE;
+                                break;
+                        }
+                        OH_METRICS_ABI_CALL(h, get_idr_field, rv,
+                                            rid, idrid, areas[*na].AreaId,
+                                            SAHPI_IDR_FIELDTYPE_UNSPECIFIED,
+                                            fid, &next_fid, &fields[n]);
+                        if ((rv == SA_ERR_HPI_NOT_PRESENT) &&
+                            (fid == SAHPI_FIRST_ENTRY)) {
+                                /* Area without fields */
+                                rv = SA_OK;
+                                break;
+                        }
+                        if (rv != SA_OK) {
+                                break;
+                        }
+                        ++n;
+                        fid = next_fid;
+                }
+                if (rv == SA_ERR_HPI_OUT_OF_SPACE) {
+                        if (*na == 0) {
+                                return rv;
+                        }
+                        /* The next call continues from this area */
+                        rv = SA_OK;
+                        break;
+                }
+                if (rv != SA_OK) {
+                        return rv;
+                }
+                *nf = n;
+                ++(*na);
+                id = next_id;
+        }
+
+        *next = id;
+
+        return SA_OK;
+}
+
+/**
+ * oHpiIdrGet
+ **/
+SaErrorT SAHPI_API oHpiIdrGet (
+     SAHPI_IN    SaHpiSessionIdT sid,
+     SAHPI_IN    SaHpiResourceIdT rid,
+     SAHPI_IN    SaHpiIdrIdT IdrId,
+     SAHPI_IN    SaHpiEntryIdT StartAreaId,
+     SAHPI_IN    SaHpiUint32T MaxAreas,
+     SAHPI_IN    SaHpiUint32T MaxFields,
+     SAHPI_OUT   SaHpiIdrInfoT *IdrInfo,
+     SAHPI_OUT   SaHpiUint32T *NumberOfAreas,
+     SAHPI_OUT   SaHpiIdrAreaHeaderT *Areas,
+     SAHPI_OUT   SaHpiUint32T *NumberOfFields,
+     SAHPI_OUT   SaHpiIdrFieldT *Fields,
+     SAHPI_OUT   SaHpiEntryIdT *NextAreaId )
+{
+        SaErrorT rv;
+        SaHpiRptEntryT *res;
+        SaHpiRdrT *rdr;
+        struct oh_handler *h;
+        struct oh_domain *d;
+        SaHpiDomainIdT did;
+        SaHpiUint32T max_areas, max_fields, na = 0, nf = 0;
+        SaHpiEntryIdT next = SAHPI_LAST_ENTRY;
+        gsize room;
+
+        if (sid == 0)
+		return SA_ERR_HPI_INVALID_SESSION;
+        if (!IdrInfo || !NumberOfAreas || !Areas ||
+            !NumberOfFields || !Fields || !NextAreaId ||
+            MaxAreas == 0 || MaxFields == 0 ||
+            StartAreaId == SAHPI_LAST_ENTRY) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        max_areas = MaxAreas;
+        if (max_areas > OH_MAX_IDR_AREAS_GET) max_areas = OH_MAX_IDR_AREAS_GET;
+        room = OH_BATCH_MAX_REPLY -
+               oh_batch_entry_size(&SaHpiIdrInfoType, sizeof(SaHpiIdrInfoT)) -
+               max_areas * oh_batch_entry_size(&SaHpiIdrAreaHeaderType,
+                                               sizeof(SaHpiIdrAreaHeaderT));
+        max_fields = room / oh_batch_entry_size(&SaHpiIdrFieldType,
+                                                sizeof(SaHpiIdrFieldT));
+        if (max_fields > MaxFields) max_fields = MaxFields;
+        if (max_fields > OH_MAX_IDR_FIELDS_GET) max_fields = OH_MAX_IDR_FIELDS_GET;
+
+        OH_CHECK_INIT_STATE(sid);
+        OH_GET_DID(sid, did);
+        OH_GET_DOMAIN(did, d); /* Lock domain */
+        OH_RESOURCE_GET_CHECK(d, rid, res);
+
+        if (!(res->ResourceCapabilities & SAHPI_CAPABILITY_INVENTORY_DATA)) {
+                oh_release_domain(d); /* Unlock domain */
+                return SA_ERR_HPI_CAPABILITY;
+        }
+
+        rdr = oh_get_rdr_by_type(&(d->rpt), rid, SAHPI_INVENTORY_RDR, IdrId);
+        if (!rdr) {
+                oh_release_domain(d); /* Unlock domain */
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+        OH_HANDLER_GET(d, rid, h);
+        oh_release_domain(d); /* Unlock domain */
+
+        if (!h || !h->abi->get_idr_info ||
+            !h->abi->get_idr_area_header || !h->abi->get_idr_field) {
+                oh_release_handler(h);
+                return SA_ERR_HPI_INVALID_CMD;
+        }
+
+        rv = SA_ERR_HPI_UNSUPPORTED_API;
+        if (h->abi->get_idr_all) {
+                OH_METRICS_ABI_CALL(h, get_idr_all, rv,
+                                    rid, IdrId, StartAreaId,
+                                    max_areas, max_fields,
+                                    IdrInfo, &na, Areas, &nf, Fields, &next);
+                if ((rv == SA_OK) && ((na > max_areas) || (nf > max_fields))) {
+                        CRIT("Plugin returned too many IDR areas or fields.");
+                        rv = SA_ERR_HPI_INTERNAL_ERROR;
+                }
+        }
+        /* Area by area and field by field if the plugin cannot do better */
+        if (rv == SA_ERR_HPI_UNSUPPORTED_API) {
+                rv = oh_idr_get_iterated(h, rid, IdrId, StartAreaId,
+                                         max_areas, max_fields,
+                                         IdrInfo, &na, Areas, &nf, Fields,
+                                         &next);
+        }
+        oh_release_handler(h);
+
+        if (rv != SA_OK) {
+                return rv;
+        }
+
+        *NumberOfAreas = na;
+        *NumberOfFields = nf;
+        *NextAreaId = next;
+
+        return SA_OK;
+}
@@ -54,6 +54,7 @@ static gboolean verbose_flag    = FALSE;
 static gchar    *bindaddr       = NULL;
 static gint     port            = OPENHPI_DEFAULT_DAEMON_PORT;
 static gchar    *portstr        = NULL;
+static gchar    *unixpath       = NULL;
 static gchar    *optpidfile     = NULL;
 static gint     sock_timeout    = 0;  // unlimited -- TODO: unlimited or 30 minutes default? was unsigned int
 static gint     max_threads     = -1; // unlimited
@@ -81,6 +82,10 @@ static GOptionEntry daemon_options[] =
                                     "                            No bind address is used by default.",              "bind_address" },
   { "port",      'p', 0, G_OPTION_ARG_STRING,   &portstr,       "Overrides the default listening port (4743) of\n"
                                     "                            the daemon. The option is optional.",              "port" },
+  { "unix",      'u', 0, G_OPTION_ARG_FILENAME, &unixpath,      "Also listen on a Unix-domain socket at path for\n"
+                                    "                            local clients. Also the path can be specified with\n"
+                                    "                            OPENHPI_DAEMON_UNIX_SOCKET environment variable.\n"
+                                    "                            The option is optional.",                          "path" },
 
   { "pidfile",   'f', 0, G_OPTION_ARG_FILENAME, &optpidfile,    "Overrides the default path/name for the daemon.\n"
                                     "                            pid file. The option is optional.",                "pidfile" },
@@ -132,6 +137,10 @@ void display_help(void)
     printf("                            No bind address is used by default.\n");
     printf("  -p, --port=port           Overrides the default listening port (4743) of\n");
     printf("                            the daemon. The option is optional.\n");
+    printf("  -u, --unix=path           Also listen on a Unix-domain socket at path for\n");
+    printf("                            local clients. Also the path can be specified with\n");
+    printf("                            OPENHPI_DAEMON_UNIX_SOCKET environment variable.\n");
+    printf("                            The option is optional.\n");
     printf("  -f, --pidfile=pidfile     Overrides the default path/name for the daemon.\n");
     printf("                            pid file. The option is optional.\n");
     printf("  -s, --timeout=seconds     Overrides the default socket read timeout of 30\n");
@@ -369,6 +378,11 @@ int main(int argc, char *argv[])
     if (portstr) {
         port = atoi(portstr);
     }
+    if (unixpath) {
+        setenv("OPENHPI_DAEMON_UNIX_SOCKET", unixpath, 1);
+    } else {
+        unixpath = getenv("OPENHPI_DAEMON_UNIX_SOCKET");
+    }
 
 #ifdef HAVE_ENCRYPT
     if (g_decrypt) {
@@ -432,6 +446,9 @@ int main(int argc, char *argv[])
         INFO("OPENHPI_DAEMON_BIND_ADDRESS = %s.", bindaddr);
     }
     INFO("OPENHPI_DAEMON_PORT = %u.", port);
+    if (unixpath) {
+        INFO("OPENHPI_DAEMON_UNIX_SOCKET = %s.", unixpath);
+    }
     INFO("Enabled IP versions:%s%s.",
          (ipvflags & FlagIPv4) ? " IPv4" : "",
          (ipvflags & FlagIPv6) ? " IPv6" : "");
@@ -443,7 +460,7 @@ int main(int argc, char *argv[])
         return 8;
     }
 
-    bool rc = oh_server_run(ipvflags, bindaddr, port, sock_timeout, max_threads);
+    bool rc = oh_server_run(ipvflags, bindaddr, port, unixpath, sock_timeout, max_threads);
     if (!rc) {
         return 9;
     }
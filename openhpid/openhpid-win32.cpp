@@ -240,7 +240,7 @@ int main(int argc, char *argv[])
         return 8;
     }
 
-    bool rc = oh_server_run(ipvflags, bindaddr, port, sock_timeout, max_threads);
+    bool rc = oh_server_run(ipvflags, bindaddr, port, 0, sock_timeout, max_threads);
     if (!rc) {
         return 9;
     }
@@ -35,6 +35,8 @@
 #include "conf.h"
 #include "event.h"
 #include "lock.h"
+#include "metrics.h"
+#include "snapshot.h"
 #include "sahpi_wrappers.h"
 
 extern volatile int signal_stop;
@@ -412,7 +414,7 @@ struct oh_handler *oh_get_handler(unsigned int hid)
         }
         __inc_handler_refcount(handler);
         wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
-        wrap_g_static_rec_mutex_lock(&handler->lock);
+        oh_metrics_lock(OH_METRIC_HANDLER_LOCK, &handler->lock);
 
         return handler;
 }
@@ -560,35 +562,17 @@ cleanexit:
  * contain a valid handler id, but SA_ERR_HPI_INTERNAL_ERROR will be
  * returned.
  **/
-SaErrorT oh_create_handler (GHashTable *handler_config, unsigned int *hid)
+static void *__open_handler(struct oh_handler *handler)
 {
-        struct oh_handler *handler = NULL;
-
-        if (!handler_config || !hid) {
-                CRIT("ERROR creating handler. Invalid parameters.");
-                return SA_ERR_HPI_INVALID_PARAMS;
-        }
-
-	*hid = 0;
-
-        handler = new_handler(handler_config);
-        if (!handler) return SA_ERR_HPI_ERROR;
-
-        *hid = handler->id;
-        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
-        oh_handlers.list = g_slist_append(oh_handlers.list, handler);
-        g_hash_table_insert(oh_handlers.table,
-                            &(handler->id),
-                            g_slist_last(oh_handlers.list));
+        void *hnd;
 
-        handler->hnd = handler->abi->open(handler->config,
-                                          handler->id,
-                                          oh_process_q);
-        if (!handler->hnd) {
+        hnd = handler->abi->open(handler->config,
+                                 handler->id,
+                                 oh_process_q);
+        if (!hnd) {
                 CRIT("A handler #%d on the %s plugin could not be opened.",
                     handler->id, handler->plugin_name);
-		wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
-		return SA_ERR_HPI_INTERNAL_ERROR;
+                return NULL;
         }
 
         // TODO reimplement to get timeout value from domain
@@ -602,18 +586,305 @@ SaErrorT oh_create_handler (GHashTable *handler_config, unsigned int *hid)
                 DBG("auto-insert timeout readonly=%d, auto-insert timeout to set=%" PRId64,
                        param.u.ai_timeout_readonly, (int64_t)ai_timeout);
                 if (!param.u.ai_timeout_readonly && ai_timeout) {
-                        rv = handler->abi->set_autoinsert_timeout(handler->hnd, ai_timeout);
+                        rv = handler->abi->set_autoinsert_timeout(hnd, ai_timeout);
                         if (rv != SA_OK) {
                                 CRIT("Cannot propagate auto-insert timeout to handler.");
                         }
                  }
         }
 
+        return hnd;
+}
+
+static struct oh_handler *__add_handler(GHashTable *handler_config,
+                                        unsigned int *hid)
+{
+        struct oh_handler *handler = NULL;
+
+        if (!handler_config || !hid) {
+                CRIT("ERROR creating handler. Invalid parameters.");
+                return NULL;
+        }
+
+	*hid = 0;
+
+        handler = new_handler(handler_config);
+        if (!handler) return NULL;
+
+        *hid = handler->id;
+        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+        oh_handlers.list = g_slist_append(oh_handlers.list, handler);
+        g_hash_table_insert(oh_handlers.table,
+                            &(handler->id),
+                            g_slist_last(oh_handlers.list));
+
+        return handler;
+}
+
+SaErrorT oh_create_handler (GHashTable *handler_config, unsigned int *hid)
+{
+        struct oh_handler *handler = NULL;
+
+        if (!handler_config || !hid) {
+                CRIT("ERROR creating handler. Invalid parameters.");
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        handler = __add_handler(handler_config, hid);
+        if (!handler) return SA_ERR_HPI_ERROR;
+
+        handler->hnd = __open_handler(handler);
+
+        wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+
+        return handler->hnd ? SA_OK : SA_ERR_HPI_INTERNAL_ERROR;
+}
+
+/**
+ * oh_create_handler_deferred
+ * @handler_config: Hash table containing the configuration for a handler
+ * read from the configuration file.
+ * @hid: pointer where hid of newly created handler will be stored.
+ *
+ * Like oh_create_handler, but the handler is left unopened until
+ * oh_open_handlers() is called. Until it has been opened the handler
+ * has no hnd and is reported as OHPI_HANDLER_OPENING.
+ *
+ * Returns: SA_OK on success.
+ **/
+SaErrorT oh_create_handler_deferred (GHashTable *handler_config, unsigned int *hid)
+{
+        struct oh_handler *handler = NULL;
+
+        handler = __add_handler(handler_config, hid);
+        if (!handler) return SA_ERR_HPI_ERROR;
+
+        handler->opening = TRUE;
+
         wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
 
         return SA_OK;
 }
 
+/*
+ * Deferred handlers are opened by a pool of threads, so slow plugin
+ * logins neither wait for each other nor delay the daemon startup.
+ * Plugins are not required to have a reentrant open(), so the handlers
+ * of one plugin are opened one after another by the same thread.
+ */
+static GThreadPool *open_pool = 0;
+static GMutex *open_lock = 0;
+static GCond *open_cond = 0;
+static guint open_pending = 0;
+/* Threads in oh_wait_handlers_opened */
+static guint open_waiters = 0;
+/* Set by oh_stop_handlers_open, the handlers left are not opened */
+static gboolean open_stop = FALSE;
+
+static SaErrorT __discover_handler(struct oh_handler *h);
+
+static void __open_deferred(unsigned int hid)
+{
+        struct oh_handler *h = NULL;
+        GSList *node = NULL;
+        void *hnd = NULL;
+        int present = 0;
+        gboolean stop;
+
+        g_mutex_lock(open_lock);
+        stop = open_stop;
+        g_mutex_unlock(open_lock);
+
+        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+        node = g_hash_table_lookup(oh_handlers.table, &hid);
+        h = node ? node->data : NULL;
+        if (h) __inc_handler_refcount(h);
+        wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+
+        if (h && stop) {
+                /* Shutting down, leave the handler unopened */
+                wrap_g_static_rec_mutex_lock(&h->lock);
+                h->opening = FALSE;
+                oh_release_handler(h);
+        } else if (h) {
+                /* Open without locks, callers see the handler as not ready */
+                hnd = __open_handler(h);
+
+                wrap_g_static_rec_mutex_lock(&h->lock);
+                wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+                present = (g_hash_table_lookup(oh_handlers.table, &hid) != NULL);
+                wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+                h->opening = FALSE;
+                if (present) {
+                        h->hnd = hnd;
+                } else if (hnd && h->abi->close) {
+                        /* Destroyed while opening */
+                        h->abi->close(hnd);
+                }
+                oh_release_handler(h);
+        }
+
+        if (present && hnd) {
+                /* Discover now rather than on the next discovery pass */
+                h = oh_get_handler(hid);
+                if (h) {
+                        if (signal_stop == FALSE) {
+                                __discover_handler(h);
+                        }
+                        oh_release_handler(h);
+                }
+        } else if (present) {
+                oh_snapshot_forget(hid);
+        }
+
+        g_mutex_lock(open_lock);
+        --open_pending;
+        g_cond_broadcast(open_cond);
+        g_mutex_unlock(open_lock);
+}
+
+/* Opens the handlers of one plugin, in configuration order */
+static void open_handler_func(gpointer data, gpointer user_data)
+{
+        GSList *hids = data, *node = NULL;
+
+        for (node = hids; node; node = node->next) {
+                __open_deferred(GPOINTER_TO_UINT(node->data));
+        }
+        g_slist_free(hids);
+}
+
+static void push_plugin_handlers(gpointer key, gpointer value, gpointer data)
+{
+        g_thread_pool_push(open_pool, g_slist_reverse(value), 0);
+}
+
+/**
+ * oh_open_handlers
+ * @max_threads: max number of plugins whose handlers are opened
+ * at the same time
+ *
+ * Opens the handlers created with oh_create_handler_deferred in the
+ * background. Handlers of different plugins are opened in parallel,
+ * the handlers of one plugin one by one. Each handler is discovered
+ * as soon as it has been opened.
+ *
+ * Returns: void
+ **/
+void oh_open_handlers(unsigned int max_threads)
+{
+        GHashTable *plugins = NULL;
+        GSList *node = NULL, *hids = NULL;
+        struct oh_handler *h = NULL;
+        guint count = 0;
+
+        if (!open_lock) {
+                open_lock = wrap_g_mutex_new_init();
+                open_cond = wrap_g_cond_new_init();
+        }
+
+        /* Handler ids by plugin name */
+        plugins = g_hash_table_new(g_str_hash, g_str_equal);
+
+        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+        for (node = oh_handlers.list; node; node = node->next) {
+                h = node->data;
+                if (!h->opening) continue;
+                hids = g_hash_table_lookup(plugins, h->plugin_name);
+                hids = g_slist_prepend(hids, GUINT_TO_POINTER(h->id));
+                g_hash_table_insert(plugins, h->plugin_name, hids);
+                ++count;
+        }
+
+        if (count != 0) {
+                if (!open_pool) {
+                        open_pool = g_thread_pool_new(open_handler_func, 0,
+                                                      max_threads ? max_threads : 1,
+                                                      FALSE, 0);
+                }
+
+                g_mutex_lock(open_lock);
+                open_pending += count;
+                g_mutex_unlock(open_lock);
+
+                g_hash_table_foreach(plugins, push_plugin_handlers, 0);
+        }
+        wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+
+        g_hash_table_destroy(plugins);
+}
+
+/**
+ * oh_wait_handlers_opened
+ *
+ * Waits until all handlers passed to the open threads have been
+ * opened and discovered, or failed to open.
+ *
+ * Returns: void
+ **/
+void oh_wait_handlers_opened(void)
+{
+        GMutex *lock = 0;
+
+        /* oh_stop_handlers_open clears open_lock under oh_handlers.lock */
+        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+        lock = open_lock;
+        if (lock) {
+                g_mutex_lock(lock);
+                ++open_waiters;
+        }
+        wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+
+        if (!lock) return;
+
+        while (open_pending != 0) {
+                g_cond_wait(open_cond, lock);
+        }
+        --open_waiters;
+        g_cond_broadcast(open_cond);
+        g_mutex_unlock(lock);
+}
+
+/**
+ * oh_stop_handlers_open
+ *
+ * Leaves the handlers not yet being opened unopened, waits for the
+ * opens in progress and for the threads waiting in
+ * oh_wait_handlers_opened to return.
+ *
+ * Returns: void
+ **/
+void oh_stop_handlers_open(void)
+{
+        if (!open_lock) return;
+
+        g_mutex_lock(open_lock);
+        open_stop = TRUE;
+        g_mutex_unlock(open_lock);
+
+        /* The queued handlers are still passed to __open_deferred,
+         * so each of them is accounted in open_pending. */
+        if (open_pool) {
+                g_thread_pool_free(open_pool, FALSE, TRUE);
+                open_pool = 0;
+        }
+
+        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+        g_mutex_lock(open_lock);
+        g_cond_broadcast(open_cond);
+        while (open_waiters != 0) {
+                g_cond_wait(open_cond, open_lock);
+        }
+        g_mutex_unlock(open_lock);
+        wrap_g_cond_free(open_cond);
+        open_cond = 0;
+        wrap_g_mutex_free_clear(open_lock);
+        open_lock = 0;
+        open_pending = 0;
+        open_stop = FALSE;
+        wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+}
+
 /**
  * oh_destroy_handler
  * @hid: Id of handler to destroy
@@ -629,6 +900,8 @@ int oh_destroy_handler(unsigned int hid)
                 return -1;
         }
 
+        oh_snapshot_forget(hid);
+
         handler = oh_get_handler(hid);
         if (!handler) {
                 CRIT("ERROR - Handler %d not found.", hid);
@@ -692,7 +965,7 @@ SaErrorT oh_get_handler_info(unsigned int hid, oHpiHandlerInfoT *info, GHashTabl
                 oh_encode_entitypath(entity_root_str, &info->entity_root);
         }
 
-        info->load_failed = (!h->hnd) ? 1 : 0;
+        info->load_failed = (!h->hnd && !h->opening) ? 1 : 0;
 
         // copy h->config to the output hash table
         g_hash_table_foreach(h->config,copy_hashed_config_info,conf_params);
@@ -708,11 +981,60 @@ SaErrorT oh_get_handler_info(unsigned int hid, oHpiHandlerInfoT *info, GHashTabl
         return SA_OK;
 }
 
+/**
+ * oh_get_handler_status
+ *
+ * Returns: SA_OK on success.
+ **/
+SaErrorT oh_get_handler_status(unsigned int hid, oHpiHandlerStatusT *status)
+{
+        struct oh_handler *h = NULL;
+        GSList *node = NULL;
+
+        if ((hid == 0) || (!status)) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        wrap_g_static_rec_mutex_lock(&oh_handlers.lock);
+        node = g_hash_table_lookup(oh_handlers.table, &hid);
+        h = node ? (struct oh_handler *)(node->data) : NULL;
+        if (!h) {
+                wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+        if (h->hnd) {
+                status->State = OHPI_HANDLER_READY;
+        } else if (h->opening) {
+                status->State = OHPI_HANDLER_OPENING;
+        } else {
+                status->State = OHPI_HANDLER_FAILED;
+        }
+        wrap_g_static_rec_mutex_unlock(&oh_handlers.lock);
+
+        oh_snapshot_get_status(hid, status);
+
+        return SA_OK;
+}
+
 /**
  * oh_discover_resources
  *
  * Returns: SA_OK on success.
  **/
+static SaErrorT __discover_handler(struct oh_handler *h)
+{
+        SaErrorT error = SA_ERR_HPI_ERROR;
+
+        if (h->abi->discover_resources && h->hnd) {
+                OH_METRICS_ABI_CALL(h, discover_resources, error);
+                if (error == SA_OK) {
+                        oh_snapshot_post_sync_event(h->id);
+                }
+        }
+
+        return error;
+}
+
 SaErrorT oh_discovery(void)
 {
         unsigned int hid = 0, next_hid;
@@ -736,11 +1058,9 @@ SaErrorT oh_discovery(void)
                         break;
                 }
 
-		if (h->abi->discover_resources && h->hnd) {
-                        cur_error = h->abi->discover_resources(h->hnd);
-                        if (cur_error == SA_OK && error) {
-                                error = cur_error;
-                        }
+                cur_error = __discover_handler(h);
+                if (cur_error == SA_OK && error) {
+                        error = cur_error;
                 }
                 oh_release_handler(h);
                 oh_getnext_handler_id(hid, &next_hid);
@@ -806,6 +1126,9 @@ int oh_load_plugin_functions(struct oh_plugin *plugin, struct oh_abi_v2 **abi)
 	g_module_symbol(plugin->dl_handle,
 	                "oh_get_el_entry",
 	                (gpointer*)(&(*abi)->get_el_entry));
+	g_module_symbol(plugin->dl_handle,
+	                "oh_get_el_entries",
+	                (gpointer*)(&(*abi)->get_el_entries));
 	g_module_symbol(plugin->dl_handle,
 	                "oh_clear_el",
 	                (gpointer*)(&(*abi)->clear_el));
@@ -818,6 +1141,9 @@ int oh_load_plugin_functions(struct oh_plugin *plugin, struct oh_abi_v2 **abi)
 	g_module_symbol(plugin->dl_handle,
 	                "oh_get_sensor_reading",
 	                (gpointer*)(&(*abi)->get_sensor_reading));
+	g_module_symbol(plugin->dl_handle,
+	                "oh_get_sensor_readings",
+	                (gpointer*)(&(*abi)->get_sensor_readings));
 	g_module_symbol(plugin->dl_handle,
 	                "oh_get_sensor_thresholds",
 	                (gpointer*)(&(*abi)->get_sensor_thresholds));
@@ -866,6 +1192,9 @@ int oh_load_plugin_functions(struct oh_plugin *plugin, struct oh_abi_v2 **abi)
 	g_module_symbol(plugin->dl_handle,
 	                "oh_get_idr_field",
 	                (gpointer*)(&(*abi)->get_idr_field));
+	g_module_symbol(plugin->dl_handle,
+	                "oh_get_idr_all",
+	                (gpointer*)(&(*abi)->get_idr_all));
 	g_module_symbol(plugin->dl_handle,
 	                "oh_add_idr_field",
 	                (gpointer*)(&(*abi)->add_idr_field));
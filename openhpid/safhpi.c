@@ -40,6 +40,8 @@
 #include "event.h"
 #include "hotswap.h"
 #include "init.h"
+#include "metrics.h"
+#include "sensor_cache.h"
 #include "threaded.h"
 
 
@@ -100,6 +102,9 @@ SaErrorT SAHPI_API saHpiDiscover(
 {
         OH_CHECK_INIT_STATE(SessionId);
 
+        /* Handlers still being opened are discovered when the open ends */
+        oh_wait_handlers_opened();
+
         /* This will wake the discovery thread up
          * and wait until it does a round throughout the
          * plugin instances. If the thread is already running,
@@ -324,7 +329,7 @@ SaErrorT SAHPI_API saHpiResourceSeveritySet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_resource_severity, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, set_resource_severity, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, Severity);
         if (error != SA_OK) {
                 oh_release_handler(h);
@@ -370,7 +375,7 @@ SaErrorT SAHPI_API saHpiResourceTagSet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_resource_tag, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_resource_tag, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, ResourceTag);
         if (rv != SA_OK) {
                 oh_release_handler(h);
@@ -603,7 +608,7 @@ SaErrorT SAHPI_API saHpiResourceFailedRemove (
         oh_release_domain(d);
 
         if (h && h->abi->resource_failed_remove) {
-                OH_CALL_ABI(h, resource_failed_remove, SA_ERR_HPI_INTERNAL_ERROR, error,
+                OH_CALL_ABI_TIMED(h, resource_failed_remove, SA_ERR_HPI_INTERNAL_ERROR, error,
                             ResourceId);
        	        oh_release_handler(h);
 	        return error;
@@ -613,7 +618,7 @@ SaErrorT SAHPI_API saHpiResourceFailedRemove (
 	/* If the resource_failed_remove ABI is not defined, then remove the
 	 * resource from rptcache */
         if (rpte->ResourceCapabilities & SAHPI_CAPABILITY_MANAGED_HOTSWAP) {
-                OH_CALL_ABI(h, get_hotswap_state, SA_ERR_HPI_INTERNAL_ERROR, error,
+                OH_CALL_ABI_TIMED(h, get_hotswap_state, SA_ERR_HPI_INTERNAL_ERROR, error,
                             ResourceId, &hsstate);
 	        if (error != SA_OK) {
         	        oh_release_handler(h);
@@ -685,7 +690,7 @@ SaErrorT SAHPI_API saHpiEventLogInfoGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_el_info, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_el_info, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, Info);
         oh_release_handler(h);
 
@@ -729,7 +734,7 @@ SaErrorT SAHPI_API saHpiEventLogCapabilitiesGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_el_caps, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, get_el_caps, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, EventLogCapabilities);
         oh_release_handler(h);        
 
@@ -790,7 +795,7 @@ SaErrorT SAHPI_API saHpiEventLogEntryGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_el_entry, SA_ERR_HPI_INVALID_CMD, rv, 
+        OH_CALL_ABI_TIMED(h, get_el_entry, SA_ERR_HPI_INVALID_CMD, rv, 
                     ResourceId, EntryId, PrevEntryId, NextEntryId,
                     EventLogEntry, Rdr, RptEntry);
         oh_release_handler(h);
@@ -885,7 +890,7 @@ SaErrorT SAHPI_API saHpiEventLogEntryAdd (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, add_el_entry, SA_ERR_HPI_INVALID_CMD, rv, ResourceId, EvtEntry);
+        OH_CALL_ABI_TIMED(h, add_el_entry, SA_ERR_HPI_INVALID_CMD, rv, ResourceId, EvtEntry);
         oh_release_handler(h);
 
         return rv;
@@ -944,7 +949,7 @@ SaErrorT SAHPI_API saHpiEventLogClear (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, clear_el, SA_ERR_HPI_INVALID_CMD, rv, ResourceId);
+        OH_CALL_ABI_TIMED(h, clear_el, SA_ERR_HPI_INVALID_CMD, rv, ResourceId);
         oh_release_handler(h);
 
         return rv;
@@ -1032,7 +1037,7 @@ SaErrorT SAHPI_API saHpiEventLogTimeSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_el_time, SA_ERR_HPI_INVALID_CMD, rv, ResourceId, Time);
+        OH_CALL_ABI_TIMED(h, set_el_time, SA_ERR_HPI_INVALID_CMD, rv, ResourceId, Time);
         oh_release_handler(h);
 
         return rv;
@@ -1116,7 +1121,7 @@ SaErrorT SAHPI_API saHpiEventLogStateSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_el_state, SA_ERR_HPI_INVALID_CMD, rv, ResourceId, Enable);
+        OH_CALL_ABI_TIMED(h, set_el_state, SA_ERR_HPI_INVALID_CMD, rv, ResourceId, Enable);
         oh_release_handler(h);
 
         return rv;
@@ -1173,7 +1178,7 @@ SaErrorT SAHPI_API saHpiEventLogOverflowReset (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, reset_el_overflow, SA_ERR_HPI_INVALID_CMD, rv, ResourceId);
+        OH_CALL_ABI_TIMED(h, reset_el_overflow, SA_ERR_HPI_INVALID_CMD, rv, ResourceId);
         oh_release_handler(h);
 
         return rv;
@@ -1786,8 +1791,8 @@ SaErrorT SAHPI_API saHpiSensorReadingGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_sensor_reading, SA_ERR_HPI_INVALID_CMD, rv,
-                    ResourceId, SensorNum, Reading, EventState);
+        rv = oh_sensor_cache_reading_get(h, ResourceId, SensorNum,
+                                         Reading, EventState);
 
 	/* If the Reading->IsSupported is set to False, then Reading->Type and
 	 * Reading->Value fields are not valid. Hence, these two fields may not
@@ -1852,7 +1857,7 @@ SaErrorT SAHPI_API saHpiSensorThresholdsGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_sensor_thresholds, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_sensor_thresholds, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, SensorThresholds);
         oh_release_handler(h);
 
@@ -1932,9 +1937,13 @@ SaErrorT SAHPI_API saHpiSensorThresholdsSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_sensor_thresholds, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_sensor_thresholds, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, SensorThresholds);
         oh_release_handler(h);
+        if (rv == SA_OK) {
+                /* Event state of the cached reading may be outdated */
+                oh_sensor_cache_invalidate(ResourceId, SensorNum);
+        }
 
         return rv;
 }
@@ -2021,7 +2030,7 @@ SaErrorT SAHPI_API saHpiSensorEnableGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_sensor_enable, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_sensor_enable, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, SensorEnabled);
         oh_release_handler(h);
 
@@ -2067,10 +2076,11 @@ SaErrorT SAHPI_API saHpiSensorEnableSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_sensor_enable, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_sensor_enable, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, SensorEnabled);
         oh_release_handler(h);
         if (rv == SA_OK) {
+                oh_sensor_cache_invalidate(ResourceId, SensorNum);
                 oh_detect_sensor_enable_alarm(did, ResourceId,
                                               SensorNum, SensorEnabled);
         }
@@ -2116,7 +2126,7 @@ SaErrorT SAHPI_API saHpiSensorEventEnableGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_sensor_event_enables, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_sensor_event_enables, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, SensorEventsEnabled);
         oh_release_handler(h);
 
@@ -2165,7 +2175,7 @@ SaErrorT SAHPI_API saHpiSensorEventEnableSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_sensor_event_enables, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_sensor_event_enables, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, SensorEventsEnabled);
         oh_release_handler(h);
         if (rv == SA_OK) {
@@ -2213,7 +2223,7 @@ SaErrorT SAHPI_API saHpiSensorEventMasksGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_sensor_event_masks, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_sensor_event_masks, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, AssertEventMask, DeassertEventMask);
         oh_release_handler(h);
 
@@ -2285,7 +2295,7 @@ SaErrorT SAHPI_API saHpiSensorEventMasksSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_sensor_event_masks, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_sensor_event_masks, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, SensorNum, Action, AssertEventMask, DeassertEventMask);
         oh_release_handler(h);
 
@@ -2396,7 +2406,7 @@ SaErrorT SAHPI_API saHpiControlGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_control_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_control_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, CtrlNum, CtrlMode, CtrlState);
         oh_release_handler(h);
 
@@ -2463,7 +2473,7 @@ SaErrorT SAHPI_API saHpiControlSet (
 	if (!rdr->RdrTypeUnion.CtrlRec.WriteOnly &&
 	    rdr->RdrTypeUnion.CtrlRec.Type == SAHPI_CTRL_TYPE_DIGITAL) {
 	    
-		OH_CALL_ABI(h, get_control_state, SA_ERR_HPI_INVALID_CMD, rv,
+		OH_CALL_ABI_TIMED(h, get_control_state, SA_ERR_HPI_INVALID_CMD, rv,
         	    	    ResourceId, CtrlNum, &cur_mode, &cur_state);
 
 		if (CtrlMode != SAHPI_CTRL_MODE_AUTO) {		
@@ -2477,7 +2487,7 @@ SaErrorT SAHPI_API saHpiControlSet (
 		}
 	}
 	
-        OH_CALL_ABI(h, set_control_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_control_state, SA_ERR_HPI_INVALID_CMD, rv,
         	    ResourceId, CtrlNum, CtrlMode, CtrlState);
         oh_release_handler(h);
 
@@ -2528,7 +2538,7 @@ SaErrorT SAHPI_API saHpiIdrInfoGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_idr_info, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_idr_info, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, IdrInfo);
         oh_release_handler(h);
 
@@ -2581,7 +2591,7 @@ SaErrorT SAHPI_API saHpiIdrAreaHeaderGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_idr_area_header, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_idr_area_header, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, AreaType, AreaId, NextAreaId, Header);
         oh_release_handler(h);
 
@@ -2628,7 +2638,7 @@ SaErrorT SAHPI_API saHpiIdrAreaAdd(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, add_idr_area, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, add_idr_area, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, AreaType, AreaId);
         oh_release_handler(h);
 
@@ -2680,7 +2690,7 @@ SaErrorT SAHPI_API saHpiIdrAreaAddById(
         oh_release_domain(d); /* Unlock domain */
         
         /* Check if IDR is read-only */
-        OH_CALL_ABI(h, get_idr_info, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, get_idr_info, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, IdrId, &info);
         if (error != SA_OK) {
                 oh_release_handler(h);
@@ -2692,7 +2702,7 @@ SaErrorT SAHPI_API saHpiIdrAreaAddById(
 
         /* Check if the AreaId requested already exists */
         if (AreaId != SAHPI_FIRST_ENTRY) {
-                OH_CALL_ABI(h, get_idr_area_header, SA_ERR_HPI_INTERNAL_ERROR, error,
+                OH_CALL_ABI_TIMED(h, get_idr_area_header, SA_ERR_HPI_INTERNAL_ERROR, error,
                             ResourceId, IdrId, AreaType, AreaId, &next, &header);
                 if (error == SA_OK) {
                         oh_release_handler(h);
@@ -2700,7 +2710,7 @@ SaErrorT SAHPI_API saHpiIdrAreaAddById(
                 }
         }
 
-        OH_CALL_ABI(h, add_idr_area_id, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, add_idr_area_id, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, IdrId, AreaType, AreaId);
         oh_release_handler(h);
 
@@ -2743,7 +2753,7 @@ SaErrorT SAHPI_API saHpiIdrAreaDelete(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, del_idr_area, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, del_idr_area, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, AreaId);
         oh_release_handler(h);
 
@@ -2794,7 +2804,7 @@ SaErrorT SAHPI_API saHpiIdrFieldGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, AreaId, FieldType, FieldId, NextFieldId, Field);
         oh_release_handler(h);
 
@@ -2843,7 +2853,7 @@ SaErrorT SAHPI_API saHpiIdrFieldAdd(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, add_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, add_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, Field);
         oh_release_handler(h);
 
@@ -2900,7 +2910,7 @@ SaErrorT SAHPI_API saHpiIdrFieldAddById(
         oh_release_domain(d); /* Unlock domain */
         
         /* Check if AreaId specified in Field exists */
-        OH_CALL_ABI(h, get_idr_area_header, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, get_idr_area_header, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, IdrId, SAHPI_IDR_AREATYPE_UNSPECIFIED,
                     Field->AreaId, &nextid, &header);
         if (error != SA_OK) {
@@ -2912,7 +2922,7 @@ SaErrorT SAHPI_API saHpiIdrFieldAddById(
         }
         /* Check if FieldId requested does not already exists */
         if ( Field->FieldId != SAHPI_FIRST_ENTRY ) {
-           OH_CALL_ABI(h, get_idr_field, SA_ERR_HPI_INTERNAL_ERROR, error,
+           OH_CALL_ABI_TIMED(h, get_idr_field, SA_ERR_HPI_INTERNAL_ERROR, error,
                        ResourceId, IdrId, Field->AreaId,
                        SAHPI_IDR_FIELDTYPE_UNSPECIFIED,
                        Field->FieldId, &nextid, &field);
@@ -2922,7 +2932,7 @@ SaErrorT SAHPI_API saHpiIdrFieldAddById(
            }
         }        
         /* All checks done. Pass call down to plugin */
-        OH_CALL_ABI(h, add_idr_field_id, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, add_idr_field_id, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, IdrId, Field);
         oh_release_handler(h);
 
@@ -2969,7 +2979,7 @@ SaErrorT SAHPI_API saHpiIdrFieldSet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, Field);
         oh_release_handler(h);
 
@@ -3013,7 +3023,7 @@ SaErrorT SAHPI_API saHpiIdrFieldDelete(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, del_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, del_idr_field, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, IdrId, AreaId, FieldId);
         oh_release_handler(h);
 
@@ -3055,7 +3065,7 @@ SaErrorT SAHPI_API saHpiWatchdogTimerGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_watchdog_info, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_watchdog_info, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, WatchdogNum, Watchdog);
         oh_release_handler(h);
 
@@ -3098,7 +3108,7 @@ SaErrorT SAHPI_API saHpiWatchdogTimerSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_watchdog_info, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_watchdog_info, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, WatchdogNum, Watchdog);
         oh_release_handler(h);
 
@@ -3129,7 +3139,7 @@ SaErrorT SAHPI_API saHpiWatchdogTimerReset (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, reset_watchdog, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, reset_watchdog, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, WatchdogNum);
         oh_release_handler(h);
 
@@ -3185,7 +3195,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorGetNext(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_next_announce, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_next_announce, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, Severity, UnacknowledgedOnly,
                     Announcement);
         oh_release_handler(h);
@@ -3235,7 +3245,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_announce, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_announce, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, EntryId, Announcement);
         oh_release_handler(h);
 
@@ -3283,7 +3293,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorAcknowledge(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, ack_announce, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, ack_announce, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, EntryId, Severity);
         oh_release_handler(h);
 
@@ -3349,7 +3359,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorAdd(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, add_announce, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, add_announce, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, Announcement);
         oh_release_handler(h);
 
@@ -3411,7 +3421,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorDelete(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, del_announce, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, del_announce, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, EntryId, Severity);
         oh_release_handler(h);
 
@@ -3456,7 +3466,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorModeGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_annunc_mode, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_annunc_mode, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, Mode);
         oh_release_handler(h);
 
@@ -3509,7 +3519,7 @@ SaErrorT SAHPI_API saHpiAnnunciatorModeSet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, set_annunc_mode, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_annunc_mode, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, AnnunciatorNum, Mode);
         oh_release_handler(h);
 
@@ -3563,7 +3573,7 @@ SaErrorT SAHPI_API saHpiDimiInfoGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
         
-        OH_CALL_ABI(h, get_dimi_info, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_dimi_info, SA_ERR_HPI_INVALID_CMD, error,
         	    ResourceId, DimiNum, DimiInfo);
 	oh_release_handler(h);
         
@@ -3610,7 +3620,7 @@ SaErrorT SAHPI_API saHpiDimiTestInfoGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
         
-        OH_CALL_ABI(h, get_dimi_test, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_dimi_test, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, DimiNum, TestNum, DimiTest);
         oh_release_handler(h);
         
@@ -3657,7 +3667,7 @@ SaErrorT SAHPI_API saHpiDimiTestReadinessGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_dimi_test_ready, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_dimi_test_ready, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, DimiNum, TestNum, DimiReady);
         oh_release_handler(h);
         
@@ -3706,7 +3716,7 @@ SaErrorT SAHPI_API saHpiDimiTestStart (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_dimi_test, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_dimi_test, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, DimiNum, TestNum, NumberOfParams, ParamsList);
         oh_release_handler(h);
         
@@ -3750,7 +3760,7 @@ SaErrorT SAHPI_API saHpiDimiTestCancel (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, cancel_dimi_test, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, cancel_dimi_test, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, DimiNum, TestNum);
         oh_release_handler(h);
         
@@ -3799,7 +3809,7 @@ SaErrorT SAHPI_API saHpiDimiTestStatusGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_dimi_test_status, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_dimi_test_status, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, DimiNum, TestNum, PercentCompleted, RunStatus);
         oh_release_handler(h);
         
@@ -3847,7 +3857,7 @@ SaErrorT SAHPI_API saHpiDimiTestResultsGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_dimi_test_results, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_dimi_test_results, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, DimiNum, TestNum, TestResults);
         oh_release_handler(h);
         
@@ -3900,7 +3910,7 @@ SaErrorT SAHPI_API saHpiFumiSpecInfoGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_spec, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_spec, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, SpecInfo);
         oh_release_handler(h);
 
@@ -3947,7 +3957,7 @@ SaErrorT SAHPI_API saHpiFumiServiceImpactGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_service_impact, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_service_impact, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, ServiceImpact);
 
         oh_release_handler(h);
@@ -3998,7 +4008,7 @@ SaErrorT SAHPI_API saHpiFumiSourceSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, set_fumi_source, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, set_fumi_source, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, SourceUri);
         oh_release_handler(h);
         
@@ -4042,7 +4052,7 @@ SaErrorT SAHPI_API saHpiFumiSourceInfoValidateStart (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, validate_fumi_source, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, validate_fumi_source, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum);
         oh_release_handler(h);
         
@@ -4090,7 +4100,7 @@ SaErrorT SAHPI_API saHpiFumiSourceInfoGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_source, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_source, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, SourceInfo);
         oh_release_handler(h);
         
@@ -4145,7 +4155,7 @@ SaErrorT SAHPI_API saHpiFumiSourceComponentInfoGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_source_component, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_source_component, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, ComponentEntryId,
                     NextComponentEntryId, ComponentInfo);
         oh_release_handler(h);
@@ -4194,7 +4204,7 @@ SaErrorT SAHPI_API saHpiFumiTargetInfoGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_target, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_target, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, BankInfo);
         oh_release_handler(h);
         
@@ -4249,7 +4259,7 @@ SaErrorT SAHPI_API saHpiFumiTargetComponentInfoGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_target_component, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_target_component, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, ComponentEntryId,
                     NextComponentEntryId, ComponentInfo);
         oh_release_handler(h);
@@ -4297,7 +4307,7 @@ SaErrorT SAHPI_API saHpiFumiLogicalTargetInfoGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_logical_target, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_logical_target, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankInfo);
         oh_release_handler(h);
         
@@ -4351,7 +4361,7 @@ SaErrorT SAHPI_API saHpiFumiLogicalTargetComponentInfoGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_logical_target_component, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_logical_target_component, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, ComponentEntryId,
                     NextComponentEntryId, ComponentInfo);
         oh_release_handler(h);
@@ -4398,7 +4408,7 @@ SaErrorT SAHPI_API saHpiFumiBackupStart(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_backup, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_backup, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum);
         oh_release_handler(h);
         
@@ -4446,7 +4456,7 @@ SaErrorT SAHPI_API saHpiFumiBankBootOrderSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, set_fumi_bank_order, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, set_fumi_bank_order, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, Position);
         oh_release_handler(h);
         
@@ -4498,7 +4508,7 @@ SaErrorT SAHPI_API saHpiFumiBankCopyStart(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_bank_copy, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_bank_copy, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, SourceBankNum, TargetBankNum);
         oh_release_handler(h);
         
@@ -4554,7 +4564,7 @@ SaErrorT SAHPI_API saHpiFumiInstallStart (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_install, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_install, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum);
         oh_release_handler(h);
         
@@ -4602,7 +4612,7 @@ SaErrorT SAHPI_API saHpiFumiUpgradeStatusGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_status, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_fumi_status, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum, UpgradeStatus);
         oh_release_handler(h);
         
@@ -4661,7 +4671,7 @@ SaErrorT SAHPI_API saHpiFumiTargetVerifyStart (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_verify, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_verify, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum);
         oh_release_handler(h);
         
@@ -4719,7 +4729,7 @@ SaErrorT SAHPI_API saHpiFumiTargetVerifyMainStart(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_verify_main, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_verify_main, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum);
         oh_release_handler(h);
         
@@ -4763,7 +4773,7 @@ SaErrorT SAHPI_API saHpiFumiUpgradeCancel (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, cancel_fumi_upgrade, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, cancel_fumi_upgrade, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum);
         oh_release_handler(h);
         
@@ -4813,7 +4823,7 @@ SaErrorT SAHPI_API saHpiFumiAutoRollbackDisableGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, get_fumi_autorollback_disable, SA_ERR_HPI_INVALID_CMD,
+        OH_CALL_ABI_TIMED(h, get_fumi_autorollback_disable, SA_ERR_HPI_INVALID_CMD,
                     error, ResourceId, FumiNum, Disable);
         oh_release_handler(h);
         
@@ -4863,7 +4873,7 @@ SaErrorT SAHPI_API saHpiFumiAutoRollbackDisableSet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, set_fumi_autorollback_disable, SA_ERR_HPI_INVALID_CMD,
+        OH_CALL_ABI_TIMED(h, set_fumi_autorollback_disable, SA_ERR_HPI_INVALID_CMD,
                     error, ResourceId, FumiNum, Disable);
         oh_release_handler(h);
         
@@ -4909,7 +4919,7 @@ SaErrorT SAHPI_API saHpiFumiRollbackStart (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_rollback, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_rollback, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum);
         oh_release_handler(h);
         
@@ -4952,7 +4962,7 @@ SaErrorT SAHPI_API saHpiFumiActivate (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, activate_fumi, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, activate_fumi, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum);
         oh_release_handler(h);
         
@@ -4996,7 +5006,7 @@ SaErrorT SAHPI_API saHpiFumiActivateStart(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, start_fumi_activate, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, start_fumi_activate, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, Logical);
         oh_release_handler(h);
         
@@ -5040,7 +5050,7 @@ SaErrorT SAHPI_API saHpiFumiCleanup(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d);
 
-        OH_CALL_ABI(h, cleanup_fumi, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, cleanup_fumi, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, FumiNum, BankNum);
         oh_release_handler(h);
         
@@ -5096,7 +5106,7 @@ SaErrorT SAHPI_API saHpiHotSwapPolicyCancel (
         timeout = d->ai_timeout;
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, hotswap_policy_cancel, SA_OK, error,
+        OH_CALL_ABI_TIMED(h, hotswap_policy_cancel, SA_OK, error,
                     ResourceId, timeout);
         oh_release_handler(h);
 
@@ -5142,7 +5152,7 @@ SaErrorT SAHPI_API saHpiResourceActiveSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_hotswap_state, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, set_hotswap_state, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, SAHPI_HS_STATE_ACTIVE);
         oh_release_handler(h);
 
@@ -5189,7 +5199,7 @@ SaErrorT SAHPI_API saHpiResourceInactiveSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_hotswap_state, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, set_hotswap_state, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, SAHPI_HS_STATE_INACTIVE);
         oh_release_handler(h);
 
@@ -5292,7 +5302,7 @@ SaErrorT SAHPI_API saHpiAutoInsertTimeoutSet(
                 }
 
                 if (h->abi->set_autoinsert_timeout) {
-                        OH_CALL_ABI(h, set_autoinsert_timeout, SA_ERR_HPI_INTERNAL_ERROR,
+                        OH_CALL_ABI_TIMED(h, set_autoinsert_timeout, SA_ERR_HPI_INTERNAL_ERROR,
                                     error, Timeout);
                 }
                 oh_release_handler(h);
@@ -5336,7 +5346,7 @@ SaErrorT SAHPI_API saHpiAutoExtractTimeoutGet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock Domain */
 
-        OH_CALL_ABI(h, get_autoextract_timeout, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, get_autoextract_timeout, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, Timeout);
         oh_release_handler(h);
 
@@ -5376,7 +5386,7 @@ SaErrorT SAHPI_API saHpiAutoExtractTimeoutSet(
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock Domain */
 
-        OH_CALL_ABI(h, set_autoextract_timeout, SA_ERR_HPI_INVALID_CMD, error,
+        OH_CALL_ABI_TIMED(h, set_autoextract_timeout, SA_ERR_HPI_INVALID_CMD, error,
                     ResourceId, Timeout);
         oh_release_handler(h);
 
@@ -5411,7 +5421,7 @@ SaErrorT SAHPI_API saHpiHotSwapStateGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_hotswap_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_hotswap_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, State);
         oh_release_handler(h);
 
@@ -5465,7 +5475,7 @@ SaErrorT SAHPI_API saHpiHotSwapActionRequest (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, request_hotswap_action, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, request_hotswap_action, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, Action);
         oh_release_handler(h);
 
@@ -5509,7 +5519,7 @@ SaErrorT SAHPI_API saHpiHotSwapIndicatorStateGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_indicator_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_indicator_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, State);
         oh_release_handler(h);
 
@@ -5553,7 +5563,7 @@ SaErrorT SAHPI_API saHpiHotSwapIndicatorStateSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_indicator_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_indicator_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, State);
         oh_release_handler(h);
 
@@ -5594,7 +5604,7 @@ SaErrorT SAHPI_API saHpiParmControl (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, control_parm, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, control_parm, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, Action);
         oh_release_handler(h);
 
@@ -5635,7 +5645,7 @@ SaErrorT SAHPI_API saHpiResourceLoadIdGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
         
-        OH_CALL_ABI(h, load_id_get, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, load_id_get, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, LoadId);
         oh_release_handler(h);
         
@@ -5671,7 +5681,7 @@ SaErrorT SAHPI_API saHpiResourceLoadIdSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
         
-        OH_CALL_ABI(h, load_id_set, SA_ERR_HPI_INTERNAL_ERROR, error,
+        OH_CALL_ABI_TIMED(h, load_id_set, SA_ERR_HPI_INTERNAL_ERROR, error,
                     ResourceId, LoadId);
         oh_release_handler(h);
         
@@ -5713,7 +5723,7 @@ SaErrorT SAHPI_API saHpiResourceResetStateGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_reset_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_reset_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, ResetAction);
         oh_release_handler(h);
 
@@ -5748,7 +5758,7 @@ SaErrorT SAHPI_API saHpiResourceResetStateSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_reset_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_reset_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, ResetAction);
         oh_release_handler(h);
 
@@ -5789,7 +5799,7 @@ SaErrorT SAHPI_API saHpiResourcePowerStateGet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, get_power_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, get_power_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, State);
         oh_release_handler(h);
 
@@ -5824,7 +5834,7 @@ SaErrorT SAHPI_API saHpiResourcePowerStateSet (
         OH_HANDLER_GET(d, ResourceId, h);
         oh_release_domain(d); /* Unlock domain */
 
-        OH_CALL_ABI(h, set_power_state, SA_ERR_HPI_INVALID_CMD, rv,
+        OH_CALL_ABI_TIMED(h, set_power_state, SA_ERR_HPI_INVALID_CMD, rv,
                     ResourceId, State);
         oh_release_handler(h);
 
@@ -0,0 +1,482 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Sensor reading cache.
+ *
+ * A reading returned by a plugin is kept for max_age milliseconds.
+ * max_age is the "sensor_cache_max_age" handler parameter or,
+ * if the handler has none, the OPENHPI_SENSOR_CACHE_MAX_AGE
+ * global parameter. Zero (the default) disables the cache.
+ *
+ * Concurrent requests for the same sensor that miss the cache
+ * share one plugin call: the first request calls the plugin,
+ * the others wait for its result.
+ *
+ * Sensor events for the sensor and resource/hotswap events for
+ * its resource invalidate the cached reading.
+ *
+ * Readings of several sensors are requested from the plugin
+ * with one get_sensor_readings call if the plugin has it.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <oh_error.h>
+#include <oh_plugin.h>
+
+#include "conf.h"
+#include "metrics.h"
+#include "sensor_cache.h"
+#include "sahpi_wrappers.h"
+
+
+struct oh_sensor_cache_entry {
+        SaHpiResourceIdT rid;
+        SaHpiSensorNumT num;
+        /* The reading below can be returned from cache */
+        SaHpiBoolT valid;
+        /* Time the reading was taken */
+        gint64 time;
+        /* A plugin call is in progress */
+        SaHpiBoolT busy;
+        /* Requests waiting for the plugin call */
+        guint waiters;
+        /* Number of completed plugin calls */
+        guint calls;
+        /* Changed on every invalidation */
+        guint gen;
+        /* Result of the last plugin call */
+        SaErrorT rv;
+        SaHpiSensorReadingT reading;
+        SaHpiEventStateT state;
+};
+
+static GMutex *sc_lock = 0;
+static GCond *sc_cond = 0;
+static GHashTable *sc_entries = 0;
+static oHpiSensorCacheStatsT sc_stats;
+
+
+static guint sc_hash(gconstpointer key)
+{
+        const struct oh_sensor_cache_entry *e = key;
+
+        return (e->rid * 257) ^ e->num;
+}
+
+static gboolean sc_equal(gconstpointer a, gconstpointer b)
+{
+        const struct oh_sensor_cache_entry *ea = a;
+        const struct oh_sensor_cache_entry *eb = b;
+
+        return (ea->rid == eb->rid) && (ea->num == eb->num);
+}
+
+static gint64 sc_now(void)
+{
+#if GLIB_CHECK_VERSION (2, 28, 0)
+        return g_get_monotonic_time();
+#else
+        GTimeVal tv;
+        g_get_current_time(&tv);
+        return (gint64)tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec;
+#endif
+}
+
+/* Returns max age in microseconds, 0 if the cache is disabled */
+static gint64 sc_max_age(struct oh_handler *h)
+{
+        const char *value = NULL;
+        struct oh_global_param param;
+
+        if (h->config) {
+                value = (const char *)g_hash_table_lookup(h->config,
+                                                          OH_SENSOR_CACHE_MAX_AGE_PARAM);
+        }
+        if (value) {
+                return (gint64)strtoul(value, NULL, 10) * 1000;
+        }
+
+        if (oh_get_global_param2(OPENHPI_SENSOR_CACHE_MAX_AGE, &param)) {
+                return 0;
+        }
+
+        return (gint64)param.u.sensor_cache_max_age * 1000;
+}
+
+static void sc_copy_result(const struct oh_sensor_cache_entry *e,
+                           SaHpiSensorReadingT *reading,
+                           SaHpiEventStateT *state)
+{
+        if (reading) {
+                memcpy(reading, &e->reading, sizeof(SaHpiSensorReadingT));
+        }
+        if (state) {
+                *state = e->state;
+        }
+}
+
+static void sc_mark_invalid(struct oh_sensor_cache_entry *e)
+{
+        if (e->valid) {
+                ++sc_stats.Invalidations;
+        }
+        e->valid = SAHPI_FALSE;
+        ++e->gen;
+}
+
+/* Must be called under sc_lock */
+static gboolean sc_remove_resource_entry(gpointer key, gpointer value, gpointer data)
+{
+        struct oh_sensor_cache_entry *e = value;
+        SaHpiResourceIdT rid = *(SaHpiResourceIdT *)data;
+
+        if (e->rid != rid) {
+                return FALSE;
+        }
+
+        sc_mark_invalid(e);
+
+        /* Entries in use are dropped by the next invalidation */
+        return (!e->busy && e->waiters == 0) ? TRUE : FALSE;
+}
+
+/* Must be called under sc_lock */
+static struct oh_sensor_cache_entry * sc_get_entry(SaHpiResourceIdT rid,
+                                                   SaHpiSensorNumT num)
+{
+        struct oh_sensor_cache_entry key, *e;
+
+        key.rid = rid;
+        key.num = num;
+        e = g_hash_table_lookup(sc_entries, &key);
+        if (!e) {
+                e = g_new0(struct oh_sensor_cache_entry, 1);
+                e->rid = rid;
+                e->num = num;
+                g_hash_table_insert(sc_entries, e, e);
+        }
+
+        return e;
+}
+
+int oh_sensor_cache_init(void)
+{
+        if (sc_entries) {
+                return 0;
+        }
+
+        sc_lock = wrap_g_mutex_new_init();
+        sc_cond = wrap_g_cond_new_init();
+        sc_entries = g_hash_table_new_full(sc_hash, sc_equal, NULL, g_free);
+        memset(&sc_stats, 0, sizeof(sc_stats));
+
+        return 0;
+}
+
+int oh_sensor_cache_finit(void)
+{
+        if (!sc_entries) {
+                return 0;
+        }
+
+        g_hash_table_destroy(sc_entries);
+        sc_entries = 0;
+        wrap_g_cond_free(sc_cond);
+        sc_cond = 0;
+        wrap_g_mutex_free_clear(sc_lock);
+        sc_lock = 0;
+
+        return 0;
+}
+
+/**
+ * oh_sensor_cache_reading_get
+ * @h: handler that owns the sensor, must be referenced by the caller
+ * @rid: resource id
+ * @num: sensor number
+ * @reading: reading, may be NULL
+ * @state: event state, may be NULL
+ *
+ * Gets sensor reading from cache or from the plugin.
+ *
+ * Returns: result of the plugin get_sensor_reading call.
+ **/
+SaErrorT oh_sensor_cache_reading_get(struct oh_handler *h,
+                                     SaHpiResourceIdT rid,
+                                     SaHpiSensorNumT num,
+                                     SaHpiSensorReadingT *reading,
+                                     SaHpiEventStateT *state)
+{
+        struct oh_sensor_cache_entry *e;
+        SaHpiSensorReadingT r;
+        SaHpiEventStateT s;
+        SaErrorT rv;
+        gint64 max_age;
+        guint gen;
+
+        if (!h || !h->abi->get_sensor_reading) {
+                return SA_ERR_HPI_INVALID_CMD;
+        }
+
+        max_age = sc_entries ? sc_max_age(h) : 0;
+        if (max_age <= 0) {
+                OH_METRICS_ABI_CALL(h, get_sensor_reading, rv,
+                                    rid, num, reading, state);
+                return rv;
+        }
+
+        g_mutex_lock(sc_lock);
+
+        e = sc_get_entry(rid, num);
+
+        for (;;) {
+                guint calls;
+
+                if (e->valid && ((sc_now() - e->time) <= max_age)) {
+                        ++sc_stats.Hits;
+                        sc_copy_result(e, reading, state);
+                        g_mutex_unlock(sc_lock);
+                        return SA_OK;
+                }
+                if (!e->busy) {
+                        break;
+                }
+
+                /* Wait for the plugin call in progress and share its result */
+                calls = e->calls;
+                ++e->waiters;
+                while (e->busy && e->calls == calls) {
+                        g_cond_wait(sc_cond, sc_lock);
+                }
+                --e->waiters;
+                if (e->calls != calls) {
+                        ++sc_stats.Coalesced;
+                        rv = e->rv;
+                        sc_copy_result(e, reading, state);
+                        g_mutex_unlock(sc_lock);
+                        return rv;
+                }
+        }
+
+        ++sc_stats.Misses;
+        e->busy = SAHPI_TRUE;
+        gen = e->gen;
+        g_mutex_unlock(sc_lock);
+
+        memset(&r, 0, sizeof(r));
+        s = SAHPI_ES_UNSPECIFIED;
+        OH_METRICS_ABI_CALL(h, get_sensor_reading, rv, rid, num, &r, &s);
+
+        g_mutex_lock(sc_lock);
+        e->busy = SAHPI_FALSE;
+        ++e->calls;
+        e->rv = rv;
+        memcpy(&e->reading, &r, sizeof(r));
+        e->state = s;
+        e->time = sc_now();
+        /* Errors are not cached, nor is a reading that was
+         * invalidated by an event while the plugin call was in progress */
+        e->valid = ((rv == SA_OK) && (gen == e->gen)) ? SAHPI_TRUE : SAHPI_FALSE;
+        g_cond_broadcast(sc_cond);
+        g_mutex_unlock(sc_lock);
+
+        if (reading) {
+                memcpy(reading, &r, sizeof(r));
+        }
+        if (state) {
+                *state = s;
+        }
+
+        return rv;
+}
+
+/**
+ * oh_sensor_cache_readings_get
+ * @h: handler that owns the sensors, must be referenced by the caller
+ * @rid: resource id
+ * @n: number of sensors
+ * @nums: sensor numbers
+ * @readings: readings, n elements
+ * @states: event states, n elements
+ * @results: result for every sensor, n elements
+ *
+ * Gets readings of several sensors. Readings that are not in the
+ * cache are requested with one get_sensor_readings plugin call,
+ * or sensor by sensor if the plugin does not implement it.
+ *
+ * Returns: SA_OK if the per sensor results are valid.
+ **/
+SaErrorT oh_sensor_cache_readings_get(struct oh_handler *h,
+                                      SaHpiResourceIdT rid,
+                                      SaHpiUint32T n,
+                                      const SaHpiSensorNumT *nums,
+                                      SaHpiSensorReadingT *readings,
+                                      SaHpiEventStateT *states,
+                                      SaErrorT *results)
+{
+        SaHpiSensorNumT *mnums;
+        SaHpiSensorReadingT *mreadings;
+        SaHpiEventStateT *mstates;
+        SaErrorT *mresults;
+        guint *midx;
+        guint *mgen;
+        SaHpiUint32T i, m;
+        gint64 max_age, now;
+        SaErrorT rv;
+
+        if (!h || !nums || !readings || !states || !results) {
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+        if (!h->abi->get_sensor_readings) {
+                if (!h->abi->get_sensor_reading) {
+                        return SA_ERR_HPI_INVALID_CMD;
+                }
+                for (i = 0; i < n; ++i) {
+                        results[i] = oh_sensor_cache_reading_get(h, rid, nums[i],
+                                                                 &readings[i],
+                                                                 &states[i]);
+                }
+                return SA_OK;
+        }
+
+        max_age = sc_entries ? sc_max_age(h) : 0;
+        if (max_age <= 0) {
+                OH_METRICS_ABI_CALL(h, get_sensor_readings, rv,
+                                    rid, n, nums, readings, states, results);
+                return rv;
+        }
+
+        mnums = g_new0(SaHpiSensorNumT, n);
+        mreadings = g_new0(SaHpiSensorReadingT, n);
+        mstates = g_new0(SaHpiEventStateT, n);
+        mresults = g_new0(SaErrorT, n);
+        midx = g_new0(guint, n);
+        mgen = g_new0(guint, n);
+
+        /* Take what is cached, collect the rest */
+        m = 0;
+        g_mutex_lock(sc_lock);
+        now = sc_now();
+        for (i = 0; i < n; ++i) {
+                struct oh_sensor_cache_entry *e = sc_get_entry(rid, nums[i]);
+                if (e->valid && ((now - e->time) <= max_age)) {
+                        ++sc_stats.Hits;
+                        sc_copy_result(e, &readings[i], &states[i]);
+                        results[i] = SA_OK;
+                        continue;
+                }
+                ++sc_stats.Misses;
+                mnums[m] = nums[i];
+                mgen[m] = e->gen;
+                midx[m] = i;
+                ++m;
+        }
+        g_mutex_unlock(sc_lock);
+
+        rv = SA_OK;
+        if (m > 0) {
+                OH_METRICS_ABI_CALL(h, get_sensor_readings, rv, rid, m, mnums,
+                                    mreadings, mstates, mresults);
+        }
+
+        if ((m > 0) && (rv == SA_OK)) {
+                g_mutex_lock(sc_lock);
+                now = sc_now();
+                for (i = 0; i < m; ++i) {
+                        struct oh_sensor_cache_entry *e = sc_get_entry(rid, mnums[i]);
+                        /* A single reading in progress will overwrite it anyway */
+                        if ((mresults[i] == SA_OK) && !e->busy && (mgen[i] == e->gen)) {
+                                e->rv = SA_OK;
+                                memcpy(&e->reading, &mreadings[i], sizeof(SaHpiSensorReadingT));
+                                e->state = mstates[i];
+                                e->time = now;
+                                e->valid = SAHPI_TRUE;
+                        }
+                        memcpy(&readings[midx[i]], &mreadings[i], sizeof(SaHpiSensorReadingT));
+                        states[midx[i]] = mstates[i];
+                        results[midx[i]] = mresults[i];
+                }
+                g_mutex_unlock(sc_lock);
+        }
+
+        g_free(mnums);
+        g_free(mreadings);
+        g_free(mstates);
+        g_free(mresults);
+        g_free(midx);
+        g_free(mgen);
+
+        return rv;
+}
+
+/**
+ * oh_sensor_cache_invalidate
+ * @rid: resource id
+ * @num: sensor number
+ *
+ * Drops cached reading of the sensor.
+ **/
+void oh_sensor_cache_invalidate(SaHpiResourceIdT rid, SaHpiSensorNumT num)
+{
+        struct oh_sensor_cache_entry key, *e;
+
+        if (!sc_entries) {
+                return;
+        }
+
+        g_mutex_lock(sc_lock);
+        key.rid = rid;
+        key.num = num;
+        e = g_hash_table_lookup(sc_entries, &key);
+        if (e) {
+                sc_mark_invalid(e);
+        }
+        g_mutex_unlock(sc_lock);
+}
+
+/**
+ * oh_sensor_cache_invalidate_resource
+ * @rid: resource id
+ *
+ * Drops cached readings of all sensors of the resource.
+ **/
+void oh_sensor_cache_invalidate_resource(SaHpiResourceIdT rid)
+{
+        if (!sc_entries) {
+                return;
+        }
+
+        g_mutex_lock(sc_lock);
+        g_hash_table_foreach_remove(sc_entries, sc_remove_resource_entry, &rid);
+        g_mutex_unlock(sc_lock);
+}
+
+/**
+ * oh_sensor_cache_get_stats
+ * @stats: statistics
+ *
+ * Gets sensor reading cache statistics.
+ **/
+void oh_sensor_cache_get_stats(oHpiSensorCacheStatsT *stats)
+{
+        memset(stats, 0, sizeof(oHpiSensorCacheStatsT));
+
+        if (!sc_entries) {
+                return;
+        }
+
+        g_mutex_lock(sc_lock);
+        memcpy(stats, &sc_stats, sizeof(oHpiSensorCacheStatsT));
+        stats->Entries = g_hash_table_size(sc_entries);
+        g_mutex_unlock(sc_lock);
+}
@@ -0,0 +1,51 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __OH_SENSOR_CACHE_H
+#define __OH_SENSOR_CACHE_H
+
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_plugin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Handler configuration parameter, overrides OPENHPI_SENSOR_CACHE_MAX_AGE */
+#define OH_SENSOR_CACHE_MAX_AGE_PARAM "sensor_cache_max_age"
+
+int oh_sensor_cache_init(void);
+int oh_sensor_cache_finit(void);
+
+SaErrorT oh_sensor_cache_reading_get(struct oh_handler *h,
+                                     SaHpiResourceIdT rid,
+                                     SaHpiSensorNumT num,
+                                     SaHpiSensorReadingT *reading,
+                                     SaHpiEventStateT *state);
+SaErrorT oh_sensor_cache_readings_get(struct oh_handler *h,
+                                      SaHpiResourceIdT rid,
+                                      SaHpiUint32T n,
+                                      const SaHpiSensorNumT *nums,
+                                      SaHpiSensorReadingT *readings,
+                                      SaHpiEventStateT *states,
+                                      SaErrorT *results);
+
+void oh_sensor_cache_invalidate(SaHpiResourceIdT rid, SaHpiSensorNumT num);
+void oh_sensor_cache_invalidate_resource(SaHpiResourceIdT rid);
+
+void oh_sensor_cache_get_stats(oHpiSensorCacheStatsT *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OH_SENSOR_CACHE_H */
@@ -0,0 +1,663 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Background sensor sampler.
+ *
+ * One thread samples the sensors of the handlers that have the
+ * "sensor_sampler_interval" parameter (seconds) set.
+ * "sensor_sampler_sensors" limits sampling to a comma separated
+ * list of sensor numbers, "sensor_sampler_history" is the number
+ * of samples kept per sensor.
+ *
+ * The thread is started with the first handler that has sampling
+ * configured and runs until the daemon is finalized.
+ *
+ * Only numeric readings are kept. The readings of a resource
+ * are requested with one oh_sensor_cache_readings_get call,
+ * so the sampler and the clients share the sensor reading cache.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <oh_domain.h>
+#include <oh_error.h>
+#include <oh_plugin.h>
+#include <oh_utils.h>
+
+#include "sensor_cache.h"
+#include "sensor_sampler.h"
+#include "sahpi_wrappers.h"
+
+
+#define OH_SENSOR_SAMPLER_TICK            G_USEC_PER_SEC
+#define OH_SENSOR_SAMPLER_DEFAULT_HISTORY 360
+
+struct oh_sample {
+        SaHpiTimeT time;
+        SaHpiFloat64T value;
+};
+
+/* History of one sensor */
+struct oh_sample_ring {
+        SaHpiResourceIdT rid;
+        SaHpiSensorNumT num;
+        unsigned int hid;
+        /* Last sampling pass of the handler that saw the sensor */
+        guint pass;
+        guint size;
+        /* Position of the next sample */
+        guint head;
+        guint count;
+        struct oh_sample *samples;
+};
+
+/* Schedule of one handler, used by the sampler thread only.
+ * The handler parameters are copied, so that the handler lock is
+ * only held while the readings are requested. */
+struct oh_sampler_handler {
+        unsigned int hid;
+        gint64 next;
+        guint pass;
+        guint round;
+        guint size;
+        gchar *sensors;
+};
+
+/* Sensors of a resource to read at once */
+struct oh_sample_batch {
+        SaHpiResourceIdT rid;
+        SaHpiUint32T n;
+        SaHpiSensorNumT nums[OH_MAX_SENSOR_READINGS];
+};
+
+static GMutex *ss_lock = 0;
+static GHashTable *ss_rings = 0;
+
+static GThread *ss_thread = 0;
+static GMutex *ss_wait_lock = 0;
+static GCond *ss_wait_cond = 0;
+static volatile int ss_stop = FALSE;
+static GHashTable *ss_handlers = 0;
+static guint ss_round = 0;
+
+
+static guint ss_hash(gconstpointer key)
+{
+        const struct oh_sample_ring *r = key;
+
+        return (r->rid * 257) ^ r->num;
+}
+
+static gboolean ss_equal(gconstpointer a, gconstpointer b)
+{
+        const struct oh_sample_ring *ra = a;
+        const struct oh_sample_ring *rb = b;
+
+        return (ra->rid == rb->rid) && (ra->num == rb->num);
+}
+
+static void ss_free_ring(gpointer data)
+{
+        struct oh_sample_ring *r = data;
+
+        g_free(r->samples);
+        g_free(r);
+}
+
+static void ss_free_handler(gpointer data)
+{
+        struct oh_sampler_handler *sh = data;
+
+        g_free(sh->sensors);
+        g_free(sh);
+}
+
+static gint64 ss_now(void)
+{
+#if GLIB_CHECK_VERSION (2, 28, 0)
+        return g_get_monotonic_time();
+#else
+        GTimeVal tv;
+        g_get_current_time(&tv);
+        return (gint64)tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec;
+#endif
+}
+
+static gulong ss_param(struct oh_handler *h, const char *name, gulong def)
+{
+        const char *value;
+
+        if (!h->config) {
+                return def;
+        }
+        value = (const char *)g_hash_table_lookup(h->config, name);
+        if (!value) {
+                return def;
+        }
+
+        return strtoul(value, NULL, 0);
+}
+
+/* Returns TRUE if the sensor is listed in "sensor_sampler_sensors" */
+static gboolean ss_selected(const char *value, SaHpiSensorNumT num)
+{
+        const char *p;
+        char *end;
+
+        if (!value || !strcmp(value, "all")) {
+                return TRUE;
+        }
+
+        for (p = value; *p != '\0'; p = end) {
+                gulong n = strtoul(p, &end, 0);
+                if (end == p) {
+                        ++end;
+                        continue;
+                }
+                if (n == num) {
+                        return TRUE;
+                }
+        }
+
+        return FALSE;
+}
+
+static gboolean ss_value(const SaHpiSensorReadingT *reading, SaHpiFloat64T *value)
+{
+        if (reading->IsSupported == SAHPI_FALSE) {
+                return FALSE;
+        }
+
+        switch (reading->Type) {
+        case SAHPI_SENSOR_READING_TYPE_INT64:
+                *value = (SaHpiFloat64T)reading->Value.SensorInt64;
+                return TRUE;
+        case SAHPI_SENSOR_READING_TYPE_UINT64:
+                *value = (SaHpiFloat64T)reading->Value.SensorUint64;
+                return TRUE;
+        case SAHPI_SENSOR_READING_TYPE_FLOAT64:
+                *value = reading->Value.SensorFloat64;
+                return TRUE;
+        default:
+                return FALSE;
+        }
+}
+
+/* Must be called under ss_lock */
+static struct oh_sample_ring * ss_get_ring(SaHpiResourceIdT rid,
+                                           SaHpiSensorNumT num,
+                                           unsigned int hid,
+                                           guint size,
+                                           gboolean create)
+{
+        struct oh_sample_ring key, *r;
+
+        key.rid = rid;
+        key.num = num;
+        r = g_hash_table_lookup(ss_rings, &key);
+        if (r && (r->hid != hid || r->size != size)) {
+                /* Resource id reused or history size changed */
+                g_hash_table_remove(ss_rings, r);
+                r = 0;
+        }
+        if (!r && create) {
+                r = g_new0(struct oh_sample_ring, 1);
+                r->rid = rid;
+                r->num = num;
+                r->hid = hid;
+                r->size = size;
+                r->samples = g_new0(struct oh_sample, size);
+                g_hash_table_insert(ss_rings, r, r);
+        }
+
+        return r;
+}
+
+static gboolean ss_remove_gone(gpointer key, gpointer value, gpointer data)
+{
+        const struct oh_sample_ring *r = value;
+        const struct oh_sampler_handler *sh = data;
+
+        return (r->hid == sh->hid && r->pass != sh->pass) ? TRUE : FALSE;
+}
+
+static gboolean ss_remove_unsampled(gpointer key, gpointer value, gpointer data)
+{
+        const struct oh_sample_ring *r = value;
+        const struct oh_sampler_handler *sh;
+
+        sh = g_hash_table_lookup(ss_handlers, GUINT_TO_POINTER(r->hid));
+
+        return (!sh || sh->round != ss_round) ? TRUE : FALSE;
+}
+
+static gboolean ss_remove_handler(gpointer key, gpointer value, gpointer data)
+{
+        const struct oh_sampler_handler *sh = value;
+
+        return (sh->round != ss_round) ? TRUE : FALSE;
+}
+
+/* Takes the domain lock only, the caller must not hold a handler */
+static GArray * ss_collect(const struct oh_sampler_handler *sh)
+{
+        struct oh_domain *d;
+        SaHpiRptEntryT *res;
+        GArray *batches;
+
+        batches = g_array_new(FALSE, FALSE, sizeof(struct oh_sample_batch));
+
+        d = oh_get_domain(OH_DEFAULT_DOMAIN_ID);
+        if (!d) {
+                return batches;
+        }
+
+        for (res = oh_get_resource_by_id(&d->rpt, SAHPI_FIRST_ENTRY);
+             res != NULL;
+             res = oh_get_resource_next(&d->rpt, res->ResourceId)) {
+                unsigned int *hid;
+                SaHpiRdrT *rdr;
+                struct oh_sample_batch *b = 0;
+
+                hid = oh_get_resource_data(&d->rpt, res->ResourceId);
+                if (!hid || *hid != sh->hid) {
+                        continue;
+                }
+                if (!(res->ResourceCapabilities & SAHPI_CAPABILITY_SENSOR)) {
+                        continue;
+                }
+                if (res->ResourceFailed != SAHPI_FALSE) {
+                        continue;
+                }
+
+                for (rdr = oh_get_rdr_by_id(&d->rpt, res->ResourceId, SAHPI_FIRST_ENTRY);
+                     rdr != NULL;
+                     rdr = oh_get_rdr_next(&d->rpt, res->ResourceId, rdr->RecordId)) {
+                        const SaHpiSensorRecT *rec;
+
+                        if (rdr->RdrType != SAHPI_SENSOR_RDR) {
+                                continue;
+                        }
+                        rec = &rdr->RdrTypeUnion.SensorRec;
+                        if (rec->DataFormat.IsSupported == SAHPI_FALSE) {
+                                continue;
+                        }
+                        if (rec->DataFormat.ReadingType == SAHPI_SENSOR_READING_TYPE_BUFFER) {
+                                continue;
+                        }
+                        if (!ss_selected(sh->sensors, rec->Num)) {
+                                continue;
+                        }
+                        if (!b || b->n == OH_MAX_SENSOR_READINGS) {
+                                struct oh_sample_batch nb;
+                                nb.rid = res->ResourceId;
+                                nb.n = 0;
+                                g_array_append_val(batches, nb);
+                                b = &g_array_index(batches, struct oh_sample_batch,
+                                                   batches->len - 1);
+                        }
+                        b->nums[b->n] = rec->Num;
+                        ++b->n;
+                }
+        }
+
+        oh_release_domain(d);
+
+        return batches;
+}
+
+/* Called without locks held. Like the API calls, the domain lock
+ * is taken and released before the handler is locked. */
+static void ss_sample_handler(struct oh_sampler_handler *sh)
+{
+        GArray *batches;
+        guint i;
+        struct oh_handler *h;
+        SaHpiSensorReadingT readings[OH_MAX_SENSOR_READINGS];
+        SaHpiEventStateT states[OH_MAX_SENSOR_READINGS];
+        SaErrorT results[OH_MAX_SENSOR_READINGS];
+
+        ++sh->pass;
+        batches = ss_collect(sh);
+
+        for (i = 0; (i < batches->len) && (ss_stop == FALSE); ++i) {
+                struct oh_sample_batch *b;
+                SaHpiTimeT now;
+                SaHpiUint32T j;
+                SaErrorT rv;
+
+                b = &g_array_index(batches, struct oh_sample_batch, i);
+                h = oh_get_handler(sh->hid);
+                if (!h) {
+                        break;
+                }
+                if (!h->hnd) {
+                        oh_release_handler(h);
+                        break;
+                }
+                memset(readings, 0, sizeof(readings));
+                memset(states, 0, sizeof(states));
+                rv = oh_sensor_cache_readings_get(h, b->rid, b->n, b->nums,
+                                                  readings, states, results);
+                oh_release_handler(h);
+                oh_gettimeofday(&now);
+
+                g_mutex_lock(ss_lock);
+                for (j = 0; j < b->n; ++j) {
+                        struct oh_sample_ring *r;
+                        SaHpiFloat64T value;
+                        gboolean ok;
+
+                        ok = (rv == SA_OK) && (results[j] == SA_OK) &&
+                             ss_value(&readings[j], &value);
+                        r = ss_get_ring(b->rid, b->nums[j], sh->hid, sh->size, ok);
+                        if (!r) {
+                                continue;
+                        }
+                        r->pass = sh->pass;
+                        if (!ok) {
+                                continue;
+                        }
+                        r->samples[r->head].time = now;
+                        r->samples[r->head].value = value;
+                        r->head = (r->head + 1) % r->size;
+                        if (r->count < r->size) {
+                                ++r->count;
+                        }
+                }
+                g_mutex_unlock(ss_lock);
+        }
+
+        /* Drop history of sensors that are gone, unless the pass
+         * was cut short */
+        if ((ss_stop == FALSE) && (i == batches->len)) {
+                g_mutex_lock(ss_lock);
+                g_hash_table_foreach_remove(ss_rings, ss_remove_gone, sh);
+                g_mutex_unlock(ss_lock);
+        }
+
+        g_array_free(batches, TRUE);
+}
+
+static void ss_run(void)
+{
+        unsigned int hid = 0, next_hid;
+        struct oh_handler *h;
+        gint64 now = ss_now();
+
+        ++ss_round;
+
+        oh_getnext_handler_id(hid, &next_hid);
+        while (next_hid && (ss_stop == FALSE)) {
+                struct oh_sampler_handler *sh;
+                gulong interval;
+                const char *sensors = NULL;
+
+                hid = next_hid;
+                oh_getnext_handler_id(hid, &next_hid);
+
+                h = oh_get_handler(hid);
+                if (!h) {
+                        continue;
+                }
+                interval = ss_param(h, OH_SENSOR_SAMPLER_INTERVAL_PARAM, 0);
+                if (interval == 0 || !h->hnd) {
+                        oh_release_handler(h);
+                        continue;
+                }
+
+                sh = g_hash_table_lookup(ss_handlers, GUINT_TO_POINTER(hid));
+                if (!sh) {
+                        sh = g_new0(struct oh_sampler_handler, 1);
+                        sh->hid = hid;
+                        sh->next = now;
+                        g_hash_table_insert(ss_handlers, GUINT_TO_POINTER(hid), sh);
+                }
+                sh->round = ss_round;
+                sh->size = ss_param(h, OH_SENSOR_SAMPLER_HISTORY_PARAM,
+                                    OH_SENSOR_SAMPLER_DEFAULT_HISTORY);
+                if (sh->size == 0) {
+                        sh->size = OH_SENSOR_SAMPLER_DEFAULT_HISTORY;
+                }
+                if (h->config) {
+                        sensors = (const char *)g_hash_table_lookup(h->config,
+                                        OH_SENSOR_SAMPLER_SENSORS_PARAM);
+                }
+                g_free(sh->sensors);
+                sh->sensors = g_strdup(sensors);
+                oh_release_handler(h);
+
+                if (now >= sh->next) {
+                        sh->next = now + (gint64)interval * G_USEC_PER_SEC;
+                        ss_sample_handler(sh);
+                }
+        }
+
+        if (ss_stop != FALSE) {
+                return;
+        }
+
+        /* Drop history of handlers that are gone or not sampled anymore */
+        g_mutex_lock(ss_lock);
+        g_hash_table_foreach_remove(ss_rings, ss_remove_unsampled, 0);
+        g_mutex_unlock(ss_lock);
+        g_hash_table_foreach_remove(ss_handlers, ss_remove_handler, 0);
+}
+
+static gpointer ss_func(gpointer data)
+{
+        DBG("Begin sensor sampling.");
+
+        g_mutex_lock(ss_wait_lock);
+        while (ss_stop == FALSE) {
+                g_mutex_unlock(ss_wait_lock);
+                ss_run();
+                g_mutex_lock(ss_wait_lock);
+
+                if (ss_stop != FALSE)
+                        break;
+
+                #if GLIB_CHECK_VERSION (2, 32, 0)
+                gint64 time;
+                time = g_get_monotonic_time();
+                time = time + OH_SENSOR_SAMPLER_TICK;
+                wrap_g_cond_timed_wait(ss_wait_cond, ss_wait_lock, time);
+                #else
+                GTimeVal time;
+                g_get_current_time(&time);
+                g_time_val_add(&time, OH_SENSOR_SAMPLER_TICK);
+                wrap_g_cond_timed_wait(ss_wait_cond, ss_wait_lock, &time);
+                #endif
+        }
+        g_mutex_unlock(ss_wait_lock);
+
+        DBG("Done with sensor sampling.");
+
+        return 0;
+}
+
+/* Returns TRUE if a handler has the sampling interval set */
+static gboolean ss_configured(void)
+{
+        unsigned int hid = 0, next_hid;
+        struct oh_handler *h;
+        gboolean found = FALSE;
+
+        oh_getnext_handler_id(hid, &next_hid);
+        while (next_hid && (found == FALSE)) {
+                hid = next_hid;
+                oh_getnext_handler_id(hid, &next_hid);
+
+                h = oh_get_handler(hid);
+                if (!h) {
+                        continue;
+                }
+                found = (ss_param(h, OH_SENSOR_SAMPLER_INTERVAL_PARAM, 0) != 0);
+                oh_release_handler(h);
+        }
+
+        return found;
+}
+
+/**
+ * oh_sensor_sampler_start
+ *
+ * Starts the sampler thread if a handler has sampling configured.
+ * Called at initialization and whenever a handler is added.
+ * Callers hold the data access lock.
+ *
+ * Returns: 0.
+ **/
+int oh_sensor_sampler_start(void)
+{
+        if (ss_thread || !ss_configured()) {
+                return 0;
+        }
+
+        ss_lock = wrap_g_mutex_new_init();
+        ss_rings = g_hash_table_new_full(ss_hash, ss_equal, NULL, ss_free_ring);
+        ss_handlers = g_hash_table_new_full(g_direct_hash, g_direct_equal,
+                                            NULL, ss_free_handler);
+
+        ss_stop = FALSE;
+        ss_wait_lock = wrap_g_mutex_new_init();
+        ss_wait_cond = wrap_g_cond_new_init();
+        ss_thread = wrap_g_thread_create_new("SensorSampler", ss_func,
+                                             0, TRUE, 0);
+
+        return 0;
+}
+
+int oh_sensor_sampler_stop(void)
+{
+        if (!ss_thread) {
+                return 0;
+        }
+
+        g_mutex_lock(ss_wait_lock);
+        ss_stop = TRUE;
+        g_cond_broadcast(ss_wait_cond);
+        g_mutex_unlock(ss_wait_lock);
+        g_thread_join(ss_thread);
+        ss_thread = 0;
+        wrap_g_mutex_free_clear(ss_wait_lock);
+        wrap_g_cond_free(ss_wait_cond);
+        ss_wait_lock = 0;
+        ss_wait_cond = 0;
+
+        g_hash_table_destroy(ss_handlers);
+        ss_handlers = 0;
+        g_mutex_lock(ss_lock);
+        g_hash_table_destroy(ss_rings);
+        ss_rings = 0;
+        g_mutex_unlock(ss_lock);
+        wrap_g_mutex_free_clear(ss_lock);
+        ss_lock = 0;
+
+        return 0;
+}
+
+static gboolean ss_in_window(SaHpiTimeT t, SaHpiTimeT start, SaHpiTimeT end)
+{
+        if (start != SAHPI_TIME_UNSPECIFIED && t < start) {
+                return FALSE;
+        }
+        if (end != SAHPI_TIME_UNSPECIFIED && t > end) {
+                return FALSE;
+        }
+
+        return TRUE;
+}
+
+/**
+ * oh_sensor_sampler_history_get
+ * @rid: resource id
+ * @num: sensor number
+ * @start: oldest sample time, SAHPI_TIME_UNSPECIFIED for no limit
+ * @end: newest sample time, SAHPI_TIME_UNSPECIFIED for no limit
+ * @history: samples and aggregates
+ *
+ * Gets the newest OH_MAX_SENSOR_SAMPLES samples in the window, oldest
+ * first, and min/max/avg of all samples in the window.
+ *
+ * Returns: SA_OK, SA_ERR_HPI_NOT_PRESENT if the sensor is not sampled.
+ **/
+SaErrorT oh_sensor_sampler_history_get(SaHpiResourceIdT rid,
+                                       SaHpiSensorNumT num,
+                                       SaHpiTimeT start,
+                                       SaHpiTimeT end,
+                                       oHpiSensorHistoryT *history)
+{
+        struct oh_sample_ring key, *r;
+        SaHpiFloat64T sum = 0;
+        guint first, count, skip, i;
+
+        memset(history, 0, sizeof(oHpiSensorHistoryT));
+
+        if (!ss_thread) {
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+
+        g_mutex_lock(ss_lock);
+
+        key.rid = rid;
+        key.num = num;
+        r = g_hash_table_lookup(ss_rings, &key);
+        if (!r) {
+                g_mutex_unlock(ss_lock);
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+
+        first = (r->head + r->size - r->count) % r->size;
+
+        count = 0;
+        for (i = 0; i < r->count; ++i) {
+                const struct oh_sample *s = &r->samples[(first + i) % r->size];
+                if (!ss_in_window(s->time, start, end)) {
+                        continue;
+                }
+                if (count == 0 || s->value < history->Min) {
+                        history->Min = s->value;
+                }
+                if (count == 0 || s->value > history->Max) {
+                        history->Max = s->value;
+                }
+                sum += s->value;
+                ++count;
+        }
+
+        history->Count = count;
+        if (count > 0) {
+                history->Avg = sum / count;
+        }
+
+        skip = (count > OH_MAX_SENSOR_SAMPLES) ? count - OH_MAX_SENSOR_SAMPLES : 0;
+        for (i = 0; i < r->count; ++i) {
+                const struct oh_sample *s = &r->samples[(first + i) % r->size];
+                oHpiSensorSampleT *out;
+                if (!ss_in_window(s->time, start, end)) {
+                        continue;
+                }
+                if (skip > 0) {
+                        --skip;
+                        continue;
+                }
+                out = &history->Samples[history->NumberOfSamples];
+                out->Timestamp = s->time;
+                out->Value = s->value;
+                ++history->NumberOfSamples;
+        }
+
+        g_mutex_unlock(ss_lock);
+
+        return SA_OK;
+}
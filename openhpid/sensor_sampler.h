@@ -0,0 +1,40 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __OH_SENSOR_SAMPLER_H
+#define __OH_SENSOR_SAMPLER_H
+
+#include <SaHpi.h>
+#include <oHpi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Handler configuration parameters */
+#define OH_SENSOR_SAMPLER_INTERVAL_PARAM "sensor_sampler_interval"
+#define OH_SENSOR_SAMPLER_HISTORY_PARAM  "sensor_sampler_history"
+#define OH_SENSOR_SAMPLER_SENSORS_PARAM  "sensor_sampler_sensors"
+
+int oh_sensor_sampler_start(void);
+int oh_sensor_sampler_stop(void);
+
+SaErrorT oh_sensor_sampler_history_get(SaHpiResourceIdT rid,
+                                       SaHpiSensorNumT num,
+                                       SaHpiTimeT start,
+                                       SaHpiTimeT end,
+                                       oHpiSensorHistoryT *history);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OH_SENSOR_SAMPLER_H */
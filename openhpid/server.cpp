@@ -22,6 +22,8 @@
 
 #include <string.h>
 
+#include <vector>
+
 #include <glib.h>
 
 #include <SaHpi.h>
@@ -34,6 +36,8 @@
 #include <strmsock.h>
 #include <sahpi_wrappers.h>
 
+#include "metrics.h"
+
 
 /*--------------------------------------------------------------------*/
 /* Forward Declarations                                               */
@@ -41,6 +45,7 @@
 
 static void service_thread(gpointer sock_ptr, gpointer /* user_data */);
 static SaErrorT process_msg(cHpiMarshal * hm,
+                            uint8_t rq_rpc_version,
                             int rq_byte_order,
                             char * data,
                             uint32_t& data_len,
@@ -133,6 +138,8 @@ static void LogIp( const cStreamSock * sock )
               ip[0], ip[1], ip[2], ip[3], ip[4], ip[5], ip[6], ip[7],
               ip[8], ip[9], ip[10], ip[11], ip[12], ip[13], ip[14], ip[15],
               g_ntohs( sa6->sin6_port ) );
+    } else if ( storage.ss_family == AF_UNIX ) {
+        INFO( "Got connection on Unix-domain socket" );
     } else {
         WARN( "Unsupported socket address family!" );
     }
@@ -143,24 +150,8 @@ static void LogIp( const cStreamSock * sock )
 /* HPI Server Interface                                               */
 /*--------------------------------------------------------------------*/
 
-bool oh_server_run( int ipvflags,
-                    const char * bindaddr,
-                    uint16_t port,
-                    unsigned int sock_timeout,
-                    int max_threads )
+static void accept_loop( cServerStreamSock * ssock, GThreadPool * pool )
 {
-    // create the server socket
-    cServerStreamSock * ssock = new cServerStreamSock;
-    if (!ssock->Create(ipvflags, bindaddr, port)) {
-        CRIT("Error creating server socket. Exiting.");
-        return false;
-    }
-    add_socket_to_list( ssock );
-
-    // create the thread pool
-    GThreadPool *pool;
-    pool = g_thread_pool_new(service_thread, 0, max_threads, FALSE, 0);
-
     cStreamSock::eWaitCc wc;
     // wait for a connection and then service the connection
     while (!stop) {
@@ -194,7 +185,75 @@ bool oh_server_run( int ipvflags,
         DBG("### Spawning thread to handle connection. ###");
         g_thread_pool_push(pool, (gpointer)sock, 0);
     }
+}
+
+struct unix_accept_args
+{
+    cServerStreamSock * ssock;
+    GThreadPool * pool;
+};
+
+static gpointer unix_accept_thread( gpointer data )
+{
+    struct unix_accept_args * args = (struct unix_accept_args *)data;
+    accept_loop( args->ssock, args->pool );
+    return 0;
+}
+
+bool oh_server_run( int ipvflags,
+                    const char * bindaddr,
+                    uint16_t port,
+                    const char * unix_path,
+                    unsigned int sock_timeout,
+                    int max_threads )
+{
+    // create the server socket
+    cServerStreamSock * ssock = new cServerStreamSock;
+    if (!ssock->Create(ipvflags, bindaddr, port)) {
+        CRIT("Error creating server socket. Exiting.");
+        return false;
+    }
+    add_socket_to_list( ssock );
+
+    // create the Unix-domain server socket for local clients
+    cServerStreamSock * usock = 0;
+    if ( unix_path ) {
+        usock = new cServerStreamSock;
+        if (!usock->CreateUnix(unix_path)) {
+            CRIT("Error creating Unix-domain server socket %s. Exiting.", unix_path);
+            remove_socket_from_list( ssock );
+            delete usock;
+            delete ssock;
+            return false;
+        }
+        add_socket_to_list( usock );
+    }
 
+    // create the thread pool
+    GThreadPool *pool;
+    pool = g_thread_pool_new(service_thread, 0, max_threads, FALSE, 0);
+
+    // the Unix-domain socket is served by its own thread
+    GThread * uthread = 0;
+    struct unix_accept_args uargs = { usock, pool };
+    if ( usock ) {
+        uthread = wrap_g_thread_create_new("unix_accept_thread",
+                                           unix_accept_thread,
+                                           &uargs, TRUE, 0);
+        if ( !uthread ) {
+            CRIT("Cannot start Unix-domain socket thread.");
+        }
+    }
+
+    accept_loop( ssock, pool );
+
+    if ( uthread ) {
+        g_thread_join( uthread );
+    }
+    if ( usock ) {
+        remove_socket_from_list( usock );
+        delete usock;
+    }
     remove_socket_from_list( ssock );
     delete ssock;
     DBG("Server socket closed.");
@@ -230,6 +289,11 @@ static void service_thread(gpointer sock_ptr, gpointer /* user_data */)
     // TODO
     //sock->SetReadTimeout(sock_timeout);
 
+    /* Replies are compressed only for clients that ask for it */
+    if (!sock->IsLocal()) {
+        sock->EnableCompression();
+    }
+
     DBG("### service_thread, thrdid [%p] ###", (void *)thrdid);
 
     while (!stop) {
@@ -239,8 +303,9 @@ static void service_thread(gpointer sock_ptr, gpointer /* user_data */)
         uint8_t  type;
         uint32_t id;
         int      rq_byte_order;
+        uint8_t  rq_rpc_version;
 
-        rc = sock->ReadMsg(type, id, data, data_len, rq_byte_order);
+        rc = sock->ReadMsg(type, id, data, data_len, rq_byte_order, rq_rpc_version);
         if (stop) {
             break;
         }
@@ -250,6 +315,12 @@ static void service_thread(gpointer sock_ptr, gpointer /* user_data */)
             // one of the false return is not a real error
             // CRIT("%p Error or Timeout while reading socket.", thrdid);
             break;
+        } else if (type == eMhShm) {
+            rc = sock->AttachShm(id, data, data_len);
+            if (!rc) {
+                CRIT("%p Socket write failed.", thrdid);
+                break;
+            }
         } else if (type != eMhMsg) {
             CRIT("%p Unsupported message type. Discarding.", thrdid);
             sock->WriteMsg(eMhError, id, 0, 0);
@@ -258,19 +329,23 @@ static void service_thread(gpointer sock_ptr, gpointer /* user_data */)
             SaErrorT process_rv;
             SaHpiSessionIdT changed_sid = 0;
             if ( hm ) {
-                process_rv = process_msg(hm, rq_byte_order, data, data_len, changed_sid);
+                guint64 start = oh_metrics_now();
+                process_rv = process_msg(hm, rq_rpc_version, rq_byte_order, data, data_len, changed_sid);
+                oh_metrics_rpc(hm->m_id, hm->m_name, start);
             } else {
                 process_rv = SA_ERR_HPI_UNSUPPORTED_API;
             }
+            // the reply uses the RPC version of the request
             if (process_rv != SA_OK) {
-                int cc = HpiMarshalReply0(hm, data, &process_rv);
+                const void * rp_params[1] = { &process_rv };
+                int cc = HpiMarshalReplyVersion(rq_rpc_version, hm, data, rp_params);
                 if (cc < 0) {
                     CRIT("%p Marshal failed, cc = %d", thrdid, cc);
                     break;
                 }
                 data_len = (uint32_t)cc;
             }
-            rc = sock->WriteMsg(eMhMsg, id, data, data_len);
+            rc = sock->WriteMsg(eMhMsg, id, data, data_len, rq_rpc_version);
             if (stop) {
                 break;
             }
@@ -307,17 +382,17 @@ static void service_thread(gpointer sock_ptr, gpointer /* user_data */)
 /* RPC Call Processing                                                        */
 /*----------------------------------------------------------------------------*/
 
-#define DEMARSHAL_RQ(rq_byte_order, hm, data, iparams) \
+#define DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams) \
 { \
-    int cc = HpiDemarshalRequest(rq_byte_order, hm, data, iparams.array); \
+    int cc = HpiDemarshalRequestVersion(rq_rpc_version, rq_byte_order, hm, data, iparams.array); \
     if (cc < 0) { \
         return SA_ERR_HPI_INVALID_PARAMS; \
     } \
 }
 
-#define MARSHAL_RP(hm, data, data_len, oparams) \
+#define MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams) \
 { \
-    int cc = HpiMarshalReply(hm, data, oparams.const_array); \
+    int cc = HpiMarshalReplyVersion(rq_rpc_version, hm, data, oparams.const_array); \
     if (cc < 0) { \
         return SA_ERR_HPI_INTERNAL_ERROR; \
     } \
@@ -330,6 +405,7 @@ static void service_thread(gpointer sock_ptr, gpointer /* user_data */)
 /*--------------------------------------------------------------------*/
 
 static SaErrorT process_msg(cHpiMarshal * hm,
+                            uint8_t rq_rpc_version,
                             int rq_byte_order,
                             char * data,
                             uint32_t& data_len,
@@ -362,7 +438,7 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             void            *security = 0;
 
             RpcParams iparams(&did);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             DBG("OpenHPID calling the saHpiSessionOpen");
             rv = saHpiSessionOpen(OH_DEFAULT_DOMAIN_ID, &sid, security);
@@ -371,14 +447,14 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             }
 
             RpcParams oparams(&rv, &sid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiSessionClose: {
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSessionClose(sid);
             if (rv == SA_OK) {
@@ -386,19 +462,19 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             }
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiDiscover: {
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDiscover(sid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -406,12 +482,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDomainInfoT info;
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDomainInfoGet(sid, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -421,12 +497,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDrtEntryT  drte;
 
             RpcParams iparams(&sid, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDrtEntryGet(sid, eid, &next_eid, &drte);
 
             RpcParams oparams(&rv, &next_eid, &drte);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -434,12 +510,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTextBufferT tag;
 
             RpcParams iparams(&sid, &tag);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDomainTagSet(sid, &tag);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -448,24 +524,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntryIdT   next_eid;
 
             RpcParams iparams(&sid, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiRptEntryGet(sid, eid, &next_eid, &rpte);
 
             RpcParams oparams(&rv, &next_eid, &rpte);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiRptEntryGetByResourceId: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiRptEntryGetByResourceId(sid, rid, &rpte);
 
             RpcParams oparams(&rv, &rpte);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -473,12 +549,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSeverityT   sev;
 
             RpcParams iparams(&sid, &rid, &sev);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceSeveritySet(sid, rid, sev);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -486,12 +562,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTextBufferT tag;
 
             RpcParams iparams(&sid, &rid, &tag);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceTagSet(sid, rid, &tag);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -499,24 +575,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntityPathT ep;
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiMyEntityPathGet(sid, &ep);
 
             RpcParams oparams(&rv, &ep);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiResourceIdGet: {
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceIdGet(sid, &rid);
 
             RpcParams oparams(&rv, &rid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -528,12 +604,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiUint32T       rpt_update_cnt;
 
             RpcParams iparams(&sid, &ep, &instr_type, &instance);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiGetIdByEntityPath(sid, ep, instr_type, &instance, &rid, &instr_id, &rpt_update_cnt);
 
             RpcParams oparams(&rv, &instance, &rid, &instr_id, &rpt_update_cnt);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -544,24 +620,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiUint32T     rpt_update_cnt;
 
             RpcParams iparams(&sid, &parent_ep, &instance);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiGetChildEntityPath(sid, parent_ep, &instance, &child_ep, &rpt_update_cnt);
 
             RpcParams oparams(&rv, &instance, &child_ep, &rpt_update_cnt);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiResourceFailedRemove: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceFailedRemove(sid, rid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -569,12 +645,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventLogInfoT info;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogInfoGet(sid, rid, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -582,12 +658,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventLogCapabilitiesT caps;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogCapabilitiesGet(sid, rid, &caps);
 
             RpcParams oparams(&rv, &caps);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -598,12 +674,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventLogEntryT   ele;
 
             RpcParams iparams(&sid, &rid, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogEntryGet(sid, rid, eid, &prev_eid, &next_eid, &ele, &rdr, &rpte);
 
             RpcParams oparams(&rv, &prev_eid, &next_eid, &ele, &rdr, &rpte);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -611,24 +687,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventT evt;
 
             RpcParams iparams(&sid, &rid, &evt);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogEntryAdd(sid, rid, &evt);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiEventLogClear: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogClear(sid, rid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -636,12 +712,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTimeT time;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogTimeGet(sid, rid, &time);
 
             RpcParams oparams(&rv, &time);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -649,12 +725,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTimeT time;
 
             RpcParams iparams(&sid, &rid, &time);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogTimeSet(sid, rid, time);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -662,12 +738,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT enable;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogStateGet(sid, rid, &enable);
 
             RpcParams oparams(&rv, &enable);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -675,48 +751,48 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT enable;
 
             RpcParams iparams(&sid, &rid, &enable);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogStateSet(sid, rid, enable);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiEventLogOverflowReset: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventLogOverflowReset(sid, rid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiSubscribe: {
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSubscribe(sid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiUnsubscribe: {
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiUnsubscribe(sid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -726,12 +802,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEvtQueueStatusT status;
 
             RpcParams iparams(&sid, &timeout);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventGet(sid, timeout, &evt, &rdr, &rpte, &status);
 
             RpcParams oparams(&rv, &evt, &rdr, &rpte, &status);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -739,12 +815,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventT evt;
 
             RpcParams iparams(&sid, &evt);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiEventAdd(sid, &evt);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -754,12 +830,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAlarmT    alarm;
 
             RpcParams iparams(&sid, &sev, &unack, &alarm);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAlarmGetNext(sid, sev, unack, &alarm);
 
             RpcParams oparams(&rv, &alarm);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -768,12 +844,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAlarmT   alarm;
 
             RpcParams iparams(&sid, &aid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAlarmGet(sid, aid, &alarm);
 
             RpcParams oparams(&rv, &alarm);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -782,12 +858,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSeverityT sev;
 
             RpcParams iparams(&sid, &aid, &sev);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAlarmAcknowledge(sid, aid, sev);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -795,12 +871,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAlarmT alarm;
 
             RpcParams iparams(&sid, &alarm);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAlarmAdd(sid, &alarm);
 
             RpcParams oparams(&rv, &alarm);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -809,12 +885,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSeverityT sev;
 
             RpcParams iparams(&sid, &aid, &sev);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAlarmDelete(sid, aid, sev);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -823,12 +899,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntryIdT next_eid;
 
             RpcParams iparams(&sid, &rid, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiRdrGet(sid, rid, eid, &next_eid, &rdr);
 
             RpcParams oparams(&rv, &next_eid, &rdr);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -837,12 +913,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiInstrumentIdT instr_id;
 
             RpcParams iparams(&sid, &rid, &rdr_type, &instr_id);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiRdrGetByInstrumentId(sid, rid, rdr_type, instr_id, &rdr);
 
             RpcParams oparams(&rv, &rdr);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -850,12 +926,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiUint32T rdr_update_cnt;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiRdrUpdateCountGet(sid, rid, &rdr_update_cnt);
 
             RpcParams oparams(&rv, &rdr_update_cnt);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -864,12 +940,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventStateT    state;
 
             RpcParams iparams(&sid, &rid, &snum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorReadingGet(sid, rid, snum, &reading, &state);
 
             RpcParams oparams(&rv, &reading, &state);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -877,12 +953,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSensorThresholdsT tholds;
 
             RpcParams iparams(&sid, &rid, &snum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorThresholdsGet(sid, rid, snum, &tholds);
 
             RpcParams oparams(&rv, &tholds);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -890,12 +966,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSensorThresholdsT tholds;
 
             RpcParams iparams(&sid, &rid, &snum, &tholds);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorThresholdsSet(sid, rid, snum, &tholds);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -904,12 +980,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventCategoryT cat;
 
             RpcParams iparams(&sid, &rid, &snum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorTypeGet(sid, rid, snum, &type, &cat);
 
             RpcParams oparams(&rv, &type, &cat);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -917,12 +993,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT enabled;
 
             RpcParams iparams(&sid, &rid, &snum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorEnableGet(sid, rid, snum, &enabled);
 
             RpcParams oparams(&rv, &enabled);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -930,12 +1006,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT enabled;
 
             RpcParams iparams(&sid, &rid, &snum, &enabled);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorEnableSet(sid, rid, snum, enabled);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -943,12 +1019,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT enabled;
 
             RpcParams iparams(&sid, &rid, &snum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorEventEnableGet(sid, rid, snum, &enabled);
 
             RpcParams oparams(&rv, &enabled);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -956,12 +1032,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT enabled;
 
             RpcParams iparams(&sid, &rid, &snum, &enabled);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorEventEnableSet(sid, rid, snum, enabled);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -970,12 +1046,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventStateT dmask;
 
             RpcParams iparams(&sid, &rid, &snum, &amask, &dmask);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorEventMasksGet(sid, rid, snum, &amask, &dmask);
 
             RpcParams oparams(&rv, &amask, &dmask);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -985,12 +1061,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventStateT            dmask;
 
             RpcParams iparams(&sid, &rid, &snum, &action, &amask, &dmask);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiSensorEventMasksSet(sid, rid, snum, action, amask, dmask);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -998,12 +1074,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiCtrlTypeT type;
 
             RpcParams iparams(&sid, &rid, &cnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiControlTypeGet(sid, rid, cnum, &type);
 
             RpcParams oparams(&rv, &type);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1012,12 +1088,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiCtrlStateT state;
 
             RpcParams iparams(&sid, &rid, &cnum, &state);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiControlGet(sid, rid, cnum, &mode, &state);
 
             RpcParams oparams(&rv, &mode, &state);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1026,12 +1102,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiCtrlStateT state;
 
             RpcParams iparams(&sid, &rid, &cnum, &mode, &state);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiControlSet(sid, rid, cnum, mode, &state);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1039,12 +1115,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiIdrInfoT info;
 
             RpcParams iparams(&sid, &rid, &iid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrInfoGet(sid, rid, iid, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1055,12 +1131,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiIdrAreaHeaderT hdr;
 
             RpcParams iparams(&sid, &rid, &iid, &area, &aid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrAreaHeaderGet(sid, rid, iid, area, aid, &next_aid, &hdr);
 
             RpcParams oparams(&rv, &next_aid, &hdr);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1069,12 +1145,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntryIdT     aid;
 
             RpcParams iparams(&sid, &rid, &iid, &area);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrAreaAdd(sid, rid, iid, area, &aid);
 
             RpcParams oparams(&rv, &aid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1083,12 +1159,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntryIdT     aid;
 
             RpcParams iparams(&sid, &rid, &iid, &type, &aid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrAreaAddById(sid, rid, iid, type, aid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1096,12 +1172,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntryIdT aid;
 
             RpcParams iparams(&sid, &rid, &iid, &aid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrAreaDelete(sid, rid, iid, aid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1113,12 +1189,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiIdrFieldT     field;
 
             RpcParams iparams(&sid, &rid, &iid, &aid, &type, &fid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrFieldGet(sid, rid, iid, aid, type, fid, &next_fid, &field);
 
             RpcParams oparams(&rv, &next_fid, &field);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1126,12 +1202,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiIdrFieldT field;
 
             RpcParams iparams(&sid, &rid, &iid, &field);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrFieldAdd(sid, rid, iid, &field);
 
             RpcParams oparams(&rv, &field);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1139,12 +1215,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiIdrFieldT field;
 
             RpcParams iparams(&sid, &rid, &iid, &field);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrFieldAddById(sid, rid, iid, &field);
 
             RpcParams oparams(&rv, &field);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1152,12 +1228,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiIdrFieldT field;
 
             RpcParams iparams(&sid, &rid, &iid, &field);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrFieldSet(sid, rid, iid, &field);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1166,12 +1242,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEntryIdT fid;
 
             RpcParams iparams(&sid, &rid, &iid, &aid, &fid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiIdrFieldDelete(sid, rid, iid, aid, fid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1179,12 +1255,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiWatchdogT wdt;
 
             RpcParams iparams(&sid, &rid, &wnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiWatchdogTimerGet(sid, rid, wnum, &wdt);
 
             RpcParams oparams(&rv, &wdt);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1192,24 +1268,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiWatchdogT wdt;
 
             RpcParams iparams(&sid, &rid, &wnum, &wdt);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiWatchdogTimerSet(sid, rid, wnum, &wdt);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiWatchdogTimerReset: {
 
             RpcParams iparams(&sid, &rid, &wnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiWatchdogTimerReset(sid, rid, wnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1219,12 +1295,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAnnouncementT ann;
 
             RpcParams iparams(&sid, &rid, &anum, &sev, &unack, &ann);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorGetNext(sid, rid, anum, sev, unack, &ann);
 
             RpcParams oparams(&rv, &ann);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1233,12 +1309,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAnnouncementT ann;
 
             RpcParams iparams(&sid, &rid, &anum, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorGet(sid, rid, anum, eid, &ann);
 
             RpcParams oparams(&rv, &ann);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1247,12 +1323,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSeverityT sev;
 
             RpcParams iparams(&sid, &rid, &anum, &eid, &sev);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorAcknowledge(sid, rid, anum, eid, sev);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1260,12 +1336,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAnnouncementT ann;
 
             RpcParams iparams(&sid, &rid, &anum, &ann);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorAdd(sid, rid, anum, &ann);
 
             RpcParams oparams(&rv, &ann);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1274,12 +1350,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiSeverityT sev;
 
             RpcParams iparams(&sid, &rid, &anum, &eid, &sev);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorDelete(sid, rid, anum, eid, sev);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1287,12 +1363,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAnnunciatorModeT mode;
 
             RpcParams iparams(&sid, &rid, &anum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorModeGet(sid, rid, anum, &mode);
 
             RpcParams oparams(&rv, &mode);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1300,12 +1376,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiAnnunciatorModeT mode;
 
             RpcParams iparams(&sid, &rid, &anum, &mode);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAnnunciatorModeSet(sid, rid, anum, mode);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1313,12 +1389,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiInfoT info;
 
             RpcParams iparams(&sid, &rid, &dnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiInfoGet(sid, rid, dnum, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1327,12 +1403,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiTestT    test;
 
             RpcParams iparams(&sid, &rid, &dnum, &tnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiTestInfoGet(sid, rid, dnum, tnum, &test);
 
             RpcParams oparams(&rv, &test);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1341,12 +1417,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiReadyT   ready;
 
             RpcParams iparams(&sid, &rid, &dnum, &tnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiTestReadinessGet(sid, rid, dnum, tnum, &ready);
 
             RpcParams oparams(&rv, &ready);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1357,13 +1433,13 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiTestVariableParamsT*&   testparams  = pl.ParamsList;
 
             RpcParams iparams(&sid, &rid, &dnum, &tnum, &pl);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiTestStart(sid, rid, dnum, tnum, ntestparams, testparams);
             g_free(pl.ParamsList);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1371,12 +1447,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiTestNumT tnum;
 
             RpcParams iparams(&sid, &rid, &dnum, &tnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiTestCancel(sid, rid, dnum, tnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1386,12 +1462,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiTestRunStatusT        status;
 
             RpcParams iparams(&sid, &rid, &dnum, &tnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiTestStatusGet(sid, rid, dnum, tnum, &percent, &status);
 
             RpcParams oparams(&rv, &percent, &status);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1400,12 +1476,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiDimiTestResultsT results;
 
             RpcParams iparams(&sid, &rid, &dnum, &tnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiDimiTestResultsGet(sid, rid, dnum, tnum, &results);
 
             RpcParams oparams(&rv, &results);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1413,12 +1489,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiSpecInfoT info;
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiSpecInfoGet(sid, rid, fnum, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1426,12 +1502,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiServiceImpactDataT impact;
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiServiceImpactGet(sid, rid, fnum, &impact);
 
             RpcParams oparams(&rv, &impact);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1440,12 +1516,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTextBufferT uri;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum, &uri);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiSourceSet(sid, rid, fnum, bnum, &uri);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1453,12 +1529,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBankNumT bnum;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiSourceInfoValidateStart(sid, rid, fnum, bnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1467,12 +1543,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiSourceInfoT info;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiSourceInfoGet(sid, rid, fnum, bnum, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1484,12 +1560,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
 
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiSourceComponentInfoGet(sid, rid, fnum, bnum, eid, &next_eid, &info);
 
             RpcParams oparams(&rv, &next_eid, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1498,12 +1574,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiBankInfoT info;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiTargetInfoGet(sid, rid, fnum, bnum, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1514,12 +1590,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiComponentInfoT info;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiTargetComponentInfoGet(sid, rid, fnum, bnum, eid, &next_eid, &info);
 
             RpcParams oparams(&rv, &next_eid, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1527,12 +1603,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiLogicalBankInfoT info;
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiLogicalTargetInfoGet(sid, rid, fnum, &info);
 
             RpcParams oparams(&rv, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1542,24 +1618,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiLogicalComponentInfoT info;
 
             RpcParams iparams(&sid, &rid, &fnum, &eid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiLogicalTargetComponentInfoGet(sid, rid, fnum, eid, &next_eid, &info);
 
             RpcParams oparams(&rv, &next_eid, &info);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiFumiBackupStart: {
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiBackupStart(sid, rid, fnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1568,12 +1644,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiUint32T  pos;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum, &pos);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiBankBootOrderSet(sid, rid, fnum, bnum, pos);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1582,12 +1658,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBankNumT dst_bnum;
 
             RpcParams iparams(&sid, &rid, &fnum, &src_bnum, &dst_bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiBankCopyStart(sid, rid, fnum, src_bnum, dst_bnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1595,12 +1671,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBankNumT bnum;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiInstallStart(sid, rid, fnum, bnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1609,12 +1685,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiFumiUpgradeStatusT status;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiUpgradeStatusGet(sid, rid, fnum, bnum, &status);
 
             RpcParams oparams(&rv, &status);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1622,24 +1698,24 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBankNumT bnum;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiTargetVerifyStart(sid, rid, fnum, bnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiFumiTargetVerifyMainStart: {
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiTargetVerifyMainStart(sid, rid, fnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1647,12 +1723,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBankNumT bnum;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiUpgradeCancel(sid, rid, fnum, bnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1660,12 +1736,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT disable;
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiAutoRollbackDisableGet(sid, rid, fnum, &disable);
 
             RpcParams oparams(&rv, &disable);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1673,36 +1749,36 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT disable;
 
             RpcParams iparams(&sid, &rid, &fnum, &disable);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiAutoRollbackDisableSet(sid, rid, fnum, disable);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiFumiRollbackStart: {
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiRollbackStart(sid, rid, fnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiFumiActivate: {
 
             RpcParams iparams(&sid, &rid, &fnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiActivate(sid, rid, fnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1710,12 +1786,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBoolT logical;
 
             RpcParams iparams(&sid, &rid, &fnum, &logical);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiActivateStart(sid, rid, fnum, logical);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1723,48 +1799,48 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiBankNumT bnum;
 
             RpcParams iparams(&sid, &rid, &fnum, &bnum);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiFumiCleanup(sid, rid, fnum, bnum);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiHotSwapPolicyCancel: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiHotSwapPolicyCancel(sid, rid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiResourceActiveSet: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceActiveSet(sid, rid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
         case eFsaHpiResourceInactiveSet: {
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceInactiveSet(sid, rid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1772,12 +1848,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTimeoutT timeout;
 
             RpcParams iparams(&sid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAutoInsertTimeoutGet(sid, &timeout);
 
             RpcParams oparams(&rv, &timeout);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1785,12 +1861,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTimeoutT timeout;
 
             RpcParams iparams(&sid, &timeout);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAutoInsertTimeoutSet(sid, timeout);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1798,12 +1874,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTimeoutT timeout;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAutoExtractTimeoutGet(sid, rid, &timeout);
 
             RpcParams oparams(&rv, &timeout);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1811,12 +1887,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiTimeoutT timeout;
 
             RpcParams iparams(&sid, &rid, &timeout);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiAutoExtractTimeoutSet(sid, rid, timeout);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1824,12 +1900,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiHsStateT state;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiHotSwapStateGet(sid, rid, &state);
 
             RpcParams oparams(&rv, &state);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1837,12 +1913,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiHsActionT action;
 
             RpcParams iparams(&sid, &rid, &action);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiHotSwapActionRequest(sid, rid, action);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1850,12 +1926,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiHsIndicatorStateT state;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiHotSwapIndicatorStateGet(sid, rid, &state);
 
             RpcParams oparams(&rv, &state);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1863,12 +1939,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiHsIndicatorStateT state;
 
             RpcParams iparams(&sid, &rid, &state);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiHotSwapIndicatorStateSet(sid, rid, state);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1876,12 +1952,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiParmActionT action;
 
             RpcParams iparams(&sid, &rid, &action);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiParmControl(sid, rid, action);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1889,12 +1965,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiLoadIdT lid;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceLoadIdGet(sid, rid, &lid);
 
             RpcParams oparams(&rv, &lid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1902,12 +1978,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiLoadIdT lid;
 
             RpcParams iparams(&sid, &rid, &lid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceLoadIdSet(sid, rid, &lid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1915,12 +1991,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiResetActionT action;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceResetStateGet(sid, rid, &action);
 
             RpcParams oparams(&rv, &action);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1928,12 +2004,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiResetActionT action;
 
             RpcParams iparams(&sid, &rid, &action);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourceResetStateSet(sid, rid, action);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1941,12 +2017,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiPowerStateT state;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourcePowerStateGet(sid, rid, &state);
 
             RpcParams oparams(&rv, &state);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1954,12 +2030,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiPowerStateT state;
 
             RpcParams iparams(&sid, &rid, &state);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = saHpiResourcePowerStateSet(sid, rid, state);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1968,7 +2044,7 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiHandlerConfigT cfg;
 
             RpcParams iparams(&sid, &cfg);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             GHashTable *cfg_tbl;
             cfg_tbl = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
@@ -1983,7 +2059,7 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             g_hash_table_destroy(cfg_tbl);
 
             RpcParams oparams(&rv, &hid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -1991,12 +2067,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiHandlerIdT hid;
 
             RpcParams iparams(&sid, &hid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiHandlerDestroy(sid, hid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -2007,7 +2083,7 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             GHashTable *cfg_tbl;
 
             RpcParams iparams(&sid, &hid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             cfg_tbl = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
 
@@ -2019,7 +2095,7 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             g_hash_table_foreach(cfg_tbl, dehash_handler_cfg, &cfg);
 
             RpcParams oparams(&rv, &info, &cfg);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
             // cleanup
             g_hash_table_destroy(cfg_tbl);
         }
@@ -2029,12 +2105,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiHandlerIdT hid, next_hid;
 
             RpcParams iparams(&sid, &hid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiHandlerGetNext(sid, hid, &next_hid);
 
             RpcParams oparams(&rv, &next_hid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -2042,12 +2118,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiHandlerIdT hid;
 
             RpcParams iparams(&sid, &rid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiHandlerFind(sid, rid, &hid);
 
             RpcParams oparams(&rv, &hid);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -2055,12 +2131,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiHandlerIdT hid;
 
             RpcParams iparams(&sid, &hid);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiHandlerRetry(sid, hid);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -2068,12 +2144,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiGlobalParamT param;
 
             RpcParams iparams(&sid, &param);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiGlobalParamGet(sid, &param);
 
             RpcParams oparams(&rv, &param);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -2081,12 +2157,12 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             oHpiGlobalParamT param;
 
             RpcParams iparams(&sid, &param);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiGlobalParamSet(sid, &param);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
@@ -2095,12 +2171,233 @@ static SaErrorT process_msg(cHpiMarshal * hm,
             SaHpiEventT     evt;
 
             RpcParams iparams(&sid, &hid, &evt, &rpte, &rdr);
-            DEMARSHAL_RQ(rq_byte_order, hm, data, iparams);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
 
             rv = oHpiInjectEvent(sid, hid, &evt, &rpte, &rdr);
 
             RpcParams oparams(&rv);
-            MARSHAL_RP(hm, data, data_len, oparams);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiSensorCacheStatsGet: {
+            oHpiSensorCacheStatsT stats;
+
+            RpcParams iparams(&sid);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiSensorCacheStatsGet(sid, &stats);
+
+            RpcParams oparams(&rv, &stats);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiSensorReadingsGet: {
+            oHpiSensorReadingsT readings;
+
+            RpcParams iparams(&sid, &rid, &readings);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiSensorReadingsGet(sid, rid, &readings);
+
+            RpcParams oparams(&rv, &readings);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiSensorHistoryGet: {
+            SaHpiSensorNumT    num;
+            SaHpiTimeT         start;
+            SaHpiTimeT         end;
+            oHpiSensorHistoryT history;
+
+            RpcParams iparams(&sid, &rid, &num, &start, &end);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiSensorHistoryGet(sid, rid, num, start, end, &history);
+
+            RpcParams oparams(&rv, &history);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiEventsGet: {
+            SaHpiTimeoutT        timeout;
+            SaHpiUint32T         max_events;
+            SaHpiUint32T         max_bytes;
+            SaHpiBoolT           want_rdrs;
+            SaHpiBoolT           want_rptes;
+            SaHpiEvtQueueStatusT status = 0;
+            oHpiEventBatchT      batch;
+
+            RpcParams iparams(&sid, &timeout, &max_events, &max_bytes,
+                              &want_rdrs, &want_rptes);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            if (max_events > OH_MAX_EVENTS_GET) {
+                max_events = OH_MAX_EVENTS_GET;
+            }
+            std::vector<SaHpiEventT> evts(max_events ? max_events : 1);
+            std::vector<SaHpiRdrT> rdrs(want_rdrs ? evts.size() : 0);
+            std::vector<SaHpiRptEntryT> rptes(want_rptes ? evts.size() : 0);
+
+            SaHpiUint32T n = 0;
+            rv = oHpiEventsGet(sid, timeout, max_events, max_bytes, &n,
+                               &evts[0],
+                               want_rdrs ? &rdrs[0] : 0,
+                               want_rptes ? &rptes[0] : 0,
+                               &status);
+            if (rv != SA_OK) {
+                n = 0;
+            }
+
+            batch.NumberOfEvents     = n;
+            batch.Events             = &evts[0];
+            batch.NumberOfRdrs       = want_rdrs ? n : 0;
+            batch.Rdrs               = want_rdrs ? &rdrs[0] : 0;
+            batch.NumberOfRptEntries = want_rptes ? n : 0;
+            batch.RptEntries         = want_rptes ? &rptes[0] : 0;
+
+            RpcParams oparams(&rv, &batch, &status);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiEventFilterSet: {
+            oHpiEventFilterT filter;
+
+            RpcParams iparams(&sid, &filter);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiEventFilterSet(sid, &filter);
+
+            RpcParams oparams(&rv);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiEventLogEntriesGet: {
+            oHpiEventLogRangeT    range;
+            SaHpiEventLogEntryIdT next_id = SAHPI_NO_MORE_ENTRIES;
+            oHpiEventLogBatchT    batch;
+
+            RpcParams iparams(&sid, &rid, &range);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            SaHpiUint32T max_entries = range.MaxEntries;
+            SaHpiBoolT want_rdrs     = range.WantRdrs;
+            SaHpiBoolT want_rptes    = range.WantRptEntries;
+            if (max_entries > OH_MAX_EVENT_LOG_ENTRIES_GET) {
+                max_entries = OH_MAX_EVENT_LOG_ENTRIES_GET;
+            }
+            std::vector<SaHpiEventLogEntryT> entries(max_entries ? max_entries : 1);
+            std::vector<SaHpiRdrT> rdrs(want_rdrs ? entries.size() : 0);
+            std::vector<SaHpiRptEntryT> rptes(want_rptes ? entries.size() : 0);
+
+            SaHpiUint32T n = 0;
+            rv = oHpiEventLogEntriesGet(sid, rid, range.StartEntryId, max_entries,
+                                        range.StartTime, range.EndTime, &n,
+                                        &entries[0],
+                                        want_rdrs ? &rdrs[0] : 0,
+                                        want_rptes ? &rptes[0] : 0,
+                                        &next_id);
+            if (rv != SA_OK) {
+                n = 0;
+            }
+
+            batch.NumberOfEntries    = n;
+            batch.Entries            = &entries[0];
+            batch.NumberOfRdrs       = want_rdrs ? n : 0;
+            batch.Rdrs               = want_rdrs ? &rdrs[0] : 0;
+            batch.NumberOfRptEntries = want_rptes ? n : 0;
+            batch.RptEntries         = want_rptes ? &rptes[0] : 0;
+
+            RpcParams oparams(&rv, &batch, &next_id);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiHandlerStatusGet: {
+            oHpiHandlerIdT hid;
+            oHpiHandlerStatusT status;
+
+            RpcParams iparams(&sid, &hid);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiHandlerStatusGet(sid, hid, &status);
+
+            RpcParams oparams(&rv, &status);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiMemPoolStatsGet: {
+            SaHpiEntryIdT entry_id;
+            SaHpiEntryIdT next_entry_id = SAHPI_LAST_ENTRY;
+            oHpiMemPoolStatsT stats;
+
+            RpcParams iparams(&sid, &entry_id);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiMemPoolStatsGet(sid, entry_id, &next_entry_id, &stats);
+
+            RpcParams oparams(&rv, &next_entry_id, &stats);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiMetricGet: {
+            SaHpiEntryIdT entry_id;
+            SaHpiEntryIdT next_entry_id = SAHPI_LAST_ENTRY;
+            oHpiMetricT metric;
+
+            RpcParams iparams(&sid, &entry_id);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            rv = oHpiMetricGet(sid, entry_id, &next_entry_id, &metric);
+
+            RpcParams oparams(&rv, &next_entry_id, &metric);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
+        }
+        break;
+
+        case eFoHpiIdrGet: {
+            SaHpiEntryIdT  start_aid;
+            SaHpiUint32T   max_areas;
+            SaHpiUint32T   max_fields;
+            SaHpiIdrInfoT  info;
+            SaHpiEntryIdT  next_aid = SAHPI_LAST_ENTRY;
+            oHpiIdrBatchT  batch;
+
+            RpcParams iparams(&sid, &rid, &iid, &start_aid, &max_areas, &max_fields);
+            DEMARSHAL_RQ(rq_rpc_version, rq_byte_order, hm, data, iparams);
+
+            if (max_areas > OH_MAX_IDR_AREAS_GET) {
+                max_areas = OH_MAX_IDR_AREAS_GET;
+            }
+            if (max_fields > OH_MAX_IDR_FIELDS_GET) {
+                max_fields = OH_MAX_IDR_FIELDS_GET;
+            }
+            std::vector<SaHpiIdrAreaHeaderT> areas(max_areas ? max_areas : 1);
+            std::vector<SaHpiIdrFieldT> fields(max_fields ? max_fields : 1);
+
+            SaHpiUint32T na = 0, nf = 0;
+            memset(&info, 0, sizeof(info));
+            rv = oHpiIdrGet(sid, rid, iid, start_aid, max_areas, max_fields,
+                            &info, &na, &areas[0], &nf, &fields[0], &next_aid);
+            if (rv != SA_OK) {
+                na = 0;
+                nf = 0;
+            }
+
+            batch.NumberOfAreas  = na;
+            batch.Areas          = &areas[0];
+            batch.NumberOfFields = nf;
+            batch.Fields         = &fields[0];
+
+            RpcParams oparams(&rv, &info, &batch, &next_aid);
+            MARSHAL_RP(rq_rpc_version, hm, data, data_len, oparams);
         }
         break;
 
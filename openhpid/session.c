@@ -26,6 +26,7 @@
 #include "conf.h"
 #include "event.h"
 #include "lock.h"
+#include "metrics.h"
 #include <sahpi_wrappers.h>
 
 struct oh_session_table oh_sessions = {
@@ -35,6 +36,15 @@ struct oh_session_table oh_sessions = {
 #endif
 };
 
+/*
+ * Compiled form of oHpiEventFilterT
+ */
+struct oh_session_filter {
+        oHpiEventFilterT f;
+        SaHpiBoolT has_epp;
+        oh_entitypath_pattern epp;
+};
+
 
 /**
  * oh_create_session
@@ -216,6 +226,168 @@ SaErrorT oh_set_session_subscription(SaHpiSessionIdT sid, SaHpiBoolT state)
         return SA_OK;
 }
 
+/**
+ * oh_set_session_filter
+ * @sid: session id
+ * @filter: event filter, NULL removes the session filter
+ *
+ * A filter which passes all events is not stored.
+ *
+ * Returns: SA_OK on success.
+ **/
+SaErrorT oh_set_session_filter(SaHpiSessionIdT sid,
+                               const oHpiEventFilterT *filter)
+{
+        struct oh_session *session = NULL;
+        struct oh_session_filter *sf = NULL;
+        struct oh_session_filter *old = NULL;
+
+        if (sid < 1)
+                return SA_ERR_HPI_INVALID_SESSION;
+
+        if (filter) {
+                if (filter->NumberOfResources > OH_MAX_FILTER_RESOURCES ||
+                    filter->NumberOfSensorTypes > OH_MAX_FILTER_SENSOR_TYPES ||
+                    filter->EntityPathPattern.DataLength > SAHPI_MAX_TEXT_BUFFER_LENGTH) {
+                        return SA_ERR_HPI_INVALID_PARAMS;
+                }
+        }
+
+        if (filter && (filter->EventTypes != 0 ||
+                       filter->MinSeverity != SAHPI_ALL_SEVERITIES ||
+                       filter->NumberOfResources != 0 ||
+                       filter->EntityPathPattern.DataLength != 0 ||
+                       filter->NumberOfSensorTypes != 0)) {
+                sf = g_new0(struct oh_session_filter, 1);
+                sf->f = *filter;
+                if (filter->EntityPathPattern.DataLength != 0) {
+                        char epp_str[SAHPI_MAX_TEXT_BUFFER_LENGTH + 1];
+                        memcpy(epp_str, filter->EntityPathPattern.Data,
+                               filter->EntityPathPattern.DataLength);
+                        epp_str[filter->EntityPathPattern.DataLength] = '\0';
+                        if (oh_compile_entitypath_pattern(epp_str, &sf->epp) != SA_OK) {
+                                g_free(sf);
+                                return SA_ERR_HPI_INVALID_PARAMS;
+                        }
+                        sf->has_epp = SAHPI_TRUE;
+                }
+        }
+
+        wrap_g_static_rec_mutex_lock(&oh_sessions.lock); /* Locked session table */
+        session = g_hash_table_lookup(oh_sessions.table, &sid);
+        if (!session) {
+                wrap_g_static_rec_mutex_unlock(&oh_sessions.lock);
+                g_free(sf);
+                return SA_ERR_HPI_INVALID_SESSION;
+        }
+        old = session->filter;
+        session->filter = sf;
+        wrap_g_static_rec_mutex_unlock(&oh_sessions.lock); /* Unlocked session table */
+
+        g_free(old);
+
+        return SA_OK;
+}
+
+static SaHpiBoolT oh_session_filter_match(const struct oh_session_filter *sf,
+                                          const SaHpiEventT *event,
+                                          const SaHpiEntityPathT *ep)
+{
+        const oHpiEventFilterT *f = &sf->f;
+        SaHpiUint32T i;
+
+        if (f->EventTypes != 0) {
+                if (event->EventType >= 32 ||
+                    !(f->EventTypes & OH_EVENT_TYPE_BIT(event->EventType))) {
+                        return SAHPI_FALSE;
+                }
+        }
+
+        /* Lower severity values are more severe */
+        if (f->MinSeverity != SAHPI_ALL_SEVERITIES) {
+                if (event->Severity > f->MinSeverity) {
+                        return SAHPI_FALSE;
+                }
+        }
+
+        if (event->EventType != SAHPI_ET_DOMAIN &&
+            event->EventType != SAHPI_ET_USER) {
+                if (f->NumberOfResources != 0) {
+                        for (i = 0; i < f->NumberOfResources; i++) {
+                                if (f->Resources[i] == event->Source) break;
+                        }
+                        if (i == f->NumberOfResources) {
+                                return SAHPI_FALSE;
+                        }
+                }
+                if (sf->has_epp) {
+                        SaHpiEntityPathT tmp;
+                        if (!ep) {
+                                return SAHPI_FALSE;
+                        }
+                        tmp = *ep;
+                        if (!oh_match_entitypath_pattern((oh_entitypath_pattern *)&sf->epp,
+                                                         &tmp)) {
+                                return SAHPI_FALSE;
+                        }
+                }
+        }
+
+        if (f->NumberOfSensorTypes != 0) {
+                SaHpiSensorTypeT type;
+                if (event->EventType == SAHPI_ET_SENSOR) {
+                        type = event->EventDataUnion.SensorEvent.SensorType;
+                } else if (event->EventType == SAHPI_ET_SENSOR_ENABLE_CHANGE) {
+                        type = event->EventDataUnion.SensorEnableChangeEvent.SensorType;
+                } else {
+                        return SAHPI_TRUE;
+                }
+                for (i = 0; i < f->NumberOfSensorTypes; i++) {
+                        if (f->SensorTypes[i] == type) break;
+                }
+                if (i == f->NumberOfSensorTypes) {
+                        return SAHPI_FALSE;
+                }
+        }
+
+        return SAHPI_TRUE;
+}
+
+/**
+ * oh_session_event_wanted
+ * @sid: session id
+ * @event: event to be distributed
+ * @ep: entity path of the event source, NULL if unknown
+ *
+ * Checks the session subscription and the session event filter.
+ *
+ * Returns: SAHPI_TRUE if the event shall be queued for the session.
+ **/
+SaHpiBoolT oh_session_event_wanted(SaHpiSessionIdT sid,
+                                   const SaHpiEventT *event,
+                                   const SaHpiEntityPathT *ep)
+{
+        struct oh_session *session = NULL;
+        SaHpiBoolT wanted;
+
+        if (sid < 1 || !event)
+                return SAHPI_FALSE;
+
+        wrap_g_static_rec_mutex_lock(&oh_sessions.lock); /* Locked session table */
+        session = g_hash_table_lookup(oh_sessions.table, &sid);
+        if (!session) {
+                wrap_g_static_rec_mutex_unlock(&oh_sessions.lock);
+                return SAHPI_FALSE;
+        }
+        wanted = session->subscribed;
+        if (wanted && session->filter) {
+                wanted = oh_session_filter_match(session->filter, event, ep);
+        }
+        wrap_g_static_rec_mutex_unlock(&oh_sessions.lock); /* Unlocked session table */
+
+        return wanted;
+}
+
 /**
  * oh_queue_session_event
  * @sid:
@@ -232,6 +404,7 @@ SaErrorT oh_queue_session_event(SaHpiSessionIdT sid,
         struct oh_event *qevent = NULL;
         struct oh_global_param param = {.type = OPENHPI_EVT_QUEUE_LIMIT };
         SaHpiBoolT nolimit = SAHPI_FALSE;
+        gint qlength;
 
         if (sid < 1 || !event)
                 return SA_ERR_HPI_INVALID_PARAMS;
@@ -255,11 +428,12 @@ SaErrorT oh_queue_session_event(SaHpiSessionIdT sid,
         if (nolimit == SAHPI_FALSE) {
                 SaHpiSessionIdT tmp_sid;
                 tmp_sid = session->id;
-                gint qlength = g_async_queue_length(session->eventq);
+                qlength = g_async_queue_length(session->eventq);
                 if (qlength > 0 && qlength >= param.u.evt_queue_limit) {
                         /* Don't proceed with event push if queue is overflowed */
                         session->eventq_status = SAHPI_EVT_QUEUE_OVERFLOW;
                         wrap_g_static_rec_mutex_unlock(&oh_sessions.lock);
+                        oh_metrics_count(OH_METRIC_EVENTS_DROPPED);
                         oh_event_free(qevent, FALSE);
                         CRIT("Session %d's queue is out of space; "
                             "# of events is %d; Max is %d",
@@ -269,7 +443,9 @@ SaErrorT oh_queue_session_event(SaHpiSessionIdT sid,
         }
 
         g_async_queue_push(session->eventq, qevent);
+        qlength = g_async_queue_length(session->eventq);
         wrap_g_static_rec_mutex_unlock(&oh_sessions.lock); /* Unlocked session table */
+        oh_metrics_queue(OH_METRIC_SESSION_QUEUE, (qlength > 0) ? qlength : 0);
 
         return SA_OK;
 }
@@ -369,7 +545,10 @@ SaErrorT oh_dequeue_session_event(SaHpiSessionIdT sid,
                         return SA_ERR_HPI_NO_RESPONSE;
                 }
                 memcpy(event, devent, sizeof(struct oh_event));
-                g_free(devent);
+                /* The caller owns the RDRs now */
+                devent->rdrs = NULL;
+                devent->rdrs_to_remove = NULL;
+                oh_event_free(devent, FALSE);
                 return SA_OK;
         } else {
                 memset(event, 0, sizeof(struct oh_event));
@@ -415,6 +594,7 @@ SaErrorT oh_destroy_session(SaHpiSessionIdT sid)
                 }
         }
         g_async_queue_unref(session->eventq);
+        g_free(session->filter);
         g_free(session);
 
         return SA_OK;
@@ -0,0 +1,721 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Warm-start RPT snapshots.
+ *
+ * If OPENHPI_SNAPSHOT is "YES", the resources and RDRs of every
+ * configured handler are saved to OPENHPI_VARPATH/snapshot.<key>.
+ * The key is a hash of the handler configuration, so a changed
+ * configuration does not pick up an old snapshot.
+ *
+ * At startup the snapshot is put into the domain RPT before the
+ * first discovery. Resource ids are taken from the UID map,
+ * so they are the ids the plugin will assign.
+ * The handler is stale until its first discovery pass has been
+ * processed:
+ * - a resource reported by the plugin replaces the snapshot copy,
+ *   including its RDRs if the event carries them;
+ * - the snapshot resources the plugin did not report are removed
+ *   with resource removed or hotswap NOT_PRESENT events.
+ *
+ * After every discovery pass a sync event is put into the event
+ * queue. When it is processed, the handler resources are saved
+ * if they have changed.
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <glib.h>
+
+#include <oh_domain.h>
+#include <oh_error.h>
+#include <oh_plugin.h>
+#include <oh_utils.h>
+
+#include "conf.h"
+#include "event.h"
+#include "snapshot.h"
+#include "sahpi_wrappers.h"
+
+
+#define OH_SNAPSHOT_MAGIC   0x5353484FU /* "OHSS" */
+#define OH_SNAPSHOT_VERSION 1
+
+/*
+ * File layout: the header, then for every resource its
+ * SaHpiRptEntryT, the number of RDRs and the SaHpiRdrT records.
+ * The structures are stored as is, so the sizes are checked on load.
+ */
+struct oh_snapshot_header {
+        SaHpiUint32T magic;
+        SaHpiUint32T version;
+        SaHpiUint32T rpte_size;
+        SaHpiUint32T rdr_size;
+        SaHpiUint64T config_hash;
+        SaHpiTimeT timestamp;
+        SaHpiUint32T num_resources;
+        SaHpiUint32T reserved;
+};
+
+struct oh_snapshot_handler {
+        unsigned int hid;
+        SaHpiUint64T config_hash;
+        /* Snapshot resources the plugin has not reported yet */
+        GHashTable *pending;
+        SaHpiBoolT stale;
+        SaHpiUint32T loaded;
+        SaHpiTimeT timestamp;
+        /* Hash of the handler resources at the last save */
+        SaHpiBoolT saved;
+        SaHpiUint64T saved_gen;
+};
+
+static GMutex *snap_lock = 0;
+static GHashTable *snap_handlers = 0;
+static GHashTable *snap_sync_events = 0;
+
+
+static void snap_free_handler(gpointer data)
+{
+        struct oh_snapshot_handler *sh = data;
+
+        g_hash_table_destroy(sh->pending);
+        g_free(sh);
+}
+
+static SaHpiBoolT snap_enabled(void)
+{
+        struct oh_global_param param;
+
+        if (oh_get_global_param2(OPENHPI_SNAPSHOT, &param)) {
+                return SAHPI_FALSE;
+        }
+
+        return param.u.snapshot;
+}
+
+/* 64-bit FNV-1a */
+static SaHpiUint64T snap_hash(SaHpiUint64T h, const void *data, size_t len)
+{
+        const unsigned char *p = data;
+        size_t i;
+
+        for (i = 0; i < len; ++i) {
+                h ^= p[i];
+                h *= 0x100000001b3ULL;
+        }
+
+        return h;
+}
+
+static void snap_collect_key(gpointer key, gpointer value, gpointer data)
+{
+        GSList **keys = data;
+
+        *keys = g_slist_prepend(*keys, key);
+}
+
+static SaHpiUint64T snap_config_hash(GHashTable *config)
+{
+        GSList *keys = NULL;
+        GSList *node;
+        SaHpiUint64T h = 0xcbf29ce484222325ULL;
+
+        g_hash_table_foreach(config, snap_collect_key, &keys);
+        keys = g_slist_sort(keys, (GCompareFunc)strcmp);
+        for (node = keys; node; node = node->next) {
+                const char *name = node->data;
+                const char *value = g_hash_table_lookup(config, name);
+
+                h = snap_hash(h, name, strlen(name) + 1);
+                h = snap_hash(h, value, strlen(value) + 1);
+        }
+        g_slist_free(keys);
+
+        return h;
+}
+
+static void snap_path(SaHpiUint64T config_hash, char *path, size_t len)
+{
+        struct oh_global_param param;
+
+        oh_get_global_param2(OPENHPI_VARPATH, &param);
+        snprintf(path, len, "%s/snapshot.%016" PRIx64,
+                 param.u.varpath, (uint64_t)config_hash);
+}
+
+int oh_snapshot_init(void)
+{
+        if (snap_handlers) {
+                return 0;
+        }
+
+        snap_lock = wrap_g_mutex_new_init();
+        snap_handlers = g_hash_table_new_full(g_int_hash, g_int_equal,
+                                              NULL, snap_free_handler);
+        snap_sync_events = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+        return 0;
+}
+
+int oh_snapshot_finit(void)
+{
+        if (!snap_handlers) {
+                return 0;
+        }
+
+        g_hash_table_destroy(snap_sync_events);
+        snap_sync_events = 0;
+        g_hash_table_destroy(snap_handlers);
+        snap_handlers = 0;
+        wrap_g_mutex_free_clear(snap_lock);
+        snap_lock = 0;
+
+        return 0;
+}
+
+static int snap_read_resource(FILE *fp, RPTable *rpt, unsigned int hid,
+                              struct oh_snapshot_handler *sh)
+{
+        SaHpiRptEntryT rpte;
+        SaHpiRdrT rdr;
+        SaHpiUint32T num_rdrs, i;
+        SaHpiResourceIdT rid;
+        SaHpiBoolT add = SAHPI_TRUE;
+        unsigned int *hidp;
+
+        if (fread(&rpte, sizeof(rpte), 1, fp) != 1) return -1;
+        if (fread(&num_rdrs, sizeof(num_rdrs), 1, fp) != 1) return -1;
+
+        rid = oh_uid_from_entity_path(&rpte.ResourceEntity);
+        if (rid == 0 || oh_get_resource_by_id(rpt, rid)) {
+                /* No stable id or already reported, skip it */
+                add = SAHPI_FALSE;
+        } else {
+                rpte.ResourceId = rid;
+                rpte.EntryId = rid;
+                hidp = g_new0(unsigned int, 1);
+                *hidp = hid;
+                if (oh_add_resource(rpt, &rpte, hidp, FREE_RPT_DATA) != SA_OK) {
+                        g_free(hidp);
+                        add = SAHPI_FALSE;
+                }
+        }
+
+        for (i = 0; i < num_rdrs; ++i) {
+                if (fread(&rdr, sizeof(rdr), 1, fp) != 1) return -1;
+                if (add) {
+                        oh_add_rdr(rpt, rid, &rdr, NULL, 0);
+                }
+        }
+
+        if (add) {
+                g_hash_table_insert(sh->pending, GUINT_TO_POINTER(rid),
+                                    GUINT_TO_POINTER(1));
+                ++sh->loaded;
+        }
+
+        return 0;
+}
+
+/**
+ * oh_snapshot_load
+ * @hid: id of an opened handler or of one about to be opened
+ *
+ * Starts tracking the handler and puts its saved resources into
+ * the default domain RPT. Must be called before the discovery starts.
+ **/
+void oh_snapshot_load(unsigned int hid)
+{
+        struct oh_handler *h = NULL;
+        struct oh_domain *d = NULL;
+        struct oh_snapshot_handler *sh = NULL;
+        struct oh_snapshot_header hdr;
+        SaHpiUint64T config_hash;
+        SaHpiUint32T i;
+        char path[OH_PATH_PARAM_MAX_LENGTH + 64];
+        FILE *fp;
+
+        if (!snap_handlers || !snap_enabled()) {
+                return;
+        }
+
+        h = oh_get_handler(hid);
+        if (!h) {
+                return;
+        }
+        if (!h->hnd && !h->opening) {
+                oh_release_handler(h);
+                return;
+        }
+        config_hash = snap_config_hash(h->config);
+        oh_release_handler(h);
+
+        d = oh_get_domain(OH_DEFAULT_DOMAIN_ID);
+        if (!d) {
+                return;
+        }
+
+        g_mutex_lock(snap_lock);
+        sh = g_new0(struct oh_snapshot_handler, 1);
+        sh->hid = hid;
+        sh->config_hash = config_hash;
+        sh->pending = g_hash_table_new(g_direct_hash, g_direct_equal);
+        sh->timestamp = SAHPI_TIME_UNSPECIFIED;
+        g_hash_table_replace(snap_handlers, &sh->hid, sh);
+
+        snap_path(config_hash, path, sizeof(path));
+        fp = fopen(path, "rb");
+        if (!fp) {
+                DBG("No snapshot %s for handler %u.", path, hid);
+                g_mutex_unlock(snap_lock);
+                oh_release_domain(d);
+                return;
+        }
+
+        if ((fread(&hdr, sizeof(hdr), 1, fp) != 1) ||
+            (hdr.magic != OH_SNAPSHOT_MAGIC) ||
+            (hdr.version != OH_SNAPSHOT_VERSION) ||
+            (hdr.rpte_size != sizeof(SaHpiRptEntryT)) ||
+            (hdr.rdr_size != sizeof(SaHpiRdrT)) ||
+            (hdr.config_hash != config_hash)) {
+                WARN("Ignoring incompatible snapshot %s.", path);
+                fclose(fp);
+                g_mutex_unlock(snap_lock);
+                oh_release_domain(d);
+                return;
+        }
+
+        for (i = 0; i < hdr.num_resources; ++i) {
+                if (snap_read_resource(fp, &d->rpt, hid, sh) != 0) {
+                        WARN("Snapshot %s is truncated.", path);
+                        break;
+                }
+        }
+        fclose(fp);
+
+        sh->stale = (sh->loaded != 0) ? SAHPI_TRUE : SAHPI_FALSE;
+        sh->timestamp = hdr.timestamp;
+        INFO("Handler %u: %u resources loaded from snapshot %s.",
+             hid, sh->loaded, path);
+
+        g_mutex_unlock(snap_lock);
+        oh_release_domain(d);
+}
+
+/**
+ * oh_snapshot_post_sync_event
+ * @hid: id of the handler that has finished a discovery pass
+ *
+ * Queues a sync event behind the events of the discovery pass.
+ **/
+void oh_snapshot_post_sync_event(unsigned int hid)
+{
+        struct oh_event *e;
+
+        if (!snap_handlers || !oh_process_q) {
+                return;
+        }
+
+        g_mutex_lock(snap_lock);
+        if (!g_hash_table_lookup(snap_handlers, &hid)) {
+                g_mutex_unlock(snap_lock);
+                return;
+        }
+
+        e = oh_new_event();
+        e->hid = hid;
+        e->event.Source = SAHPI_UNSPECIFIED_RESOURCE_ID;
+        e->event.EventType = SAHPI_ET_HPI_SW;
+        e->event.Severity = SAHPI_INFORMATIONAL;
+        g_hash_table_insert(snap_sync_events, e, e);
+        g_mutex_unlock(snap_lock);
+
+        oh_evt_queue_push(oh_process_q, e);
+}
+
+/**
+ * oh_snapshot_detect_sync_event
+ * @e: event taken from the event queue
+ *
+ * Returns: 0 if @e is a sync event.
+ **/
+int oh_snapshot_detect_sync_event(struct oh_event *e)
+{
+        gboolean found;
+
+        if (!e || !snap_handlers || (e->event.EventType != SAHPI_ET_HPI_SW)) {
+                return ENOENT;
+        }
+
+        g_mutex_lock(snap_lock);
+        found = g_hash_table_remove(snap_sync_events, e);
+        g_mutex_unlock(snap_lock);
+
+        return found ? 0 : ENOENT;
+}
+
+/**
+ * oh_snapshot_resource_seen
+ * @rpt: domain RPT, the domain is locked by the caller
+ * @e: resource or hotswap event that has just been applied to @rpt
+ *
+ * Marks a snapshot resource as reported by the plugin.
+ * The snapshot RDRs are replaced by the RDRs of the event, if any.
+ **/
+void oh_snapshot_resource_seen(RPTable *rpt, struct oh_event *e)
+{
+        struct oh_snapshot_handler *sh;
+        SaHpiResourceIdT rid = e->resource.ResourceId;
+        SaHpiRdrT *rdr;
+        GSList *node;
+        gboolean pending = FALSE;
+
+        if (!snap_handlers) {
+                return;
+        }
+
+        g_mutex_lock(snap_lock);
+        sh = g_hash_table_lookup(snap_handlers, &e->hid);
+        if (sh && sh->stale) {
+                pending = g_hash_table_remove(sh->pending, GUINT_TO_POINTER(rid));
+        }
+        g_mutex_unlock(snap_lock);
+
+        if (!pending || !e->rdrs || !oh_get_resource_by_id(rpt, rid)) {
+                return;
+        }
+
+        while ((rdr = oh_get_rdr_next(rpt, rid, SAHPI_FIRST_ENTRY)) != NULL) {
+                oh_remove_rdr(rpt, rid, rdr->RecordId);
+        }
+        for (node = e->rdrs; node; node = node->next) {
+                oh_add_rdr(rpt, rid, (SaHpiRdrT *)node->data, NULL, 0);
+        }
+}
+
+static struct oh_event *snap_make_removal_event(unsigned int hid,
+                                                const SaHpiRptEntryT *rpte)
+{
+        struct oh_event *e = oh_new_event();
+
+        e->hid = hid;
+        e->resource = *rpte;
+        e->event.Source = rpte->ResourceId;
+        e->event.Severity = rpte->ResourceSeverity;
+        oh_gettimeofday(&e->event.Timestamp);
+        if (rpte->ResourceCapabilities & SAHPI_CAPABILITY_FRU) {
+                SaHpiHotSwapEventT *hse = &e->event.EventDataUnion.HotSwapEvent;
+                e->event.EventType = SAHPI_ET_HOTSWAP;
+                hse->HotSwapState = SAHPI_HS_STATE_NOT_PRESENT;
+                hse->PreviousHotSwapState = SAHPI_HS_STATE_ACTIVE;
+                hse->CauseOfStateChange = SAHPI_HS_CAUSE_UNKNOWN;
+        } else {
+                e->event.EventType = SAHPI_ET_RESOURCE;
+                e->event.EventDataUnion.ResourceEvent.ResourceEventType =
+                        SAHPI_RESE_RESOURCE_REMOVED;
+        }
+
+        return e;
+}
+
+/* Queues removal events for the snapshot resources the plugin has not reported */
+static SaHpiUint32T snap_reconcile(unsigned int hid)
+{
+        struct oh_domain *d;
+        struct oh_snapshot_handler *sh;
+        GHashTableIter iter;
+        gpointer key;
+        GSList *events = NULL, *node;
+        SaHpiUint32T n = 0;
+
+        d = oh_get_domain(OH_DEFAULT_DOMAIN_ID);
+        if (!d) {
+                return 0;
+        }
+
+        g_mutex_lock(snap_lock);
+        sh = g_hash_table_lookup(snap_handlers, &hid);
+        if (!sh || !sh->stale) {
+                g_mutex_unlock(snap_lock);
+                oh_release_domain(d);
+                return 0;
+        }
+        g_hash_table_iter_init(&iter, sh->pending);
+        while (g_hash_table_iter_next(&iter, &key, NULL)) {
+                SaHpiResourceIdT rid = GPOINTER_TO_UINT(key);
+                SaHpiRptEntryT *rpte = oh_get_resource_by_id(&d->rpt, rid);
+                unsigned int *hidp = oh_get_resource_data(&d->rpt, rid);
+                if (rpte && hidp && (*hidp == hid)) {
+                        events = g_slist_prepend(events,
+                                                 snap_make_removal_event(hid, rpte));
+                        ++n;
+                }
+        }
+        g_hash_table_remove_all(sh->pending);
+        sh->stale = SAHPI_FALSE;
+        g_mutex_unlock(snap_lock);
+        oh_release_domain(d);
+
+        for (node = events; node; node = node->next) {
+                oh_evt_queue_push(oh_process_q, node->data);
+        }
+        g_slist_free(events);
+
+        INFO("Handler %u: snapshot reconciled, %u stale resources removed.",
+             hid, n);
+
+        return n;
+}
+
+/**
+ * oh_snapshot_forget
+ * @hid: id of a handler being destroyed or that failed to open
+ *
+ * Stops tracking the handler. The snapshot resources it has not
+ * reported are removed. Its snapshot file is kept.
+ **/
+void oh_snapshot_forget(unsigned int hid)
+{
+        if (!snap_handlers) {
+                return;
+        }
+
+        snap_reconcile(hid);
+
+        g_mutex_lock(snap_lock);
+        g_hash_table_remove(snap_handlers, &hid);
+        g_mutex_unlock(snap_lock);
+}
+
+static int snap_write(const char *path, struct oh_snapshot_header *hdr,
+                      GArray *rptes, GArray *counts, GArray *rdrs)
+{
+        char tmp_path[OH_PATH_PARAM_MAX_LENGTH + 64];
+        SaHpiUint32T i, j, k = 0;
+        FILE *fp;
+        int ok;
+
+        snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+        fp = fopen(tmp_path, "wb");
+        if (!fp) {
+                CRIT("Snapshot file '%s' could not be opened", tmp_path);
+                return -1;
+        }
+
+        ok = (fwrite(hdr, sizeof(*hdr), 1, fp) == 1);
+        for (i = 0; ok && (i < rptes->len); ++i) {
+                SaHpiUint32T n = g_array_index(counts, SaHpiUint32T, i);
+                ok = (fwrite(&g_array_index(rptes, SaHpiRptEntryT, i),
+                             sizeof(SaHpiRptEntryT), 1, fp) == 1) &&
+                     (fwrite(&n, sizeof(n), 1, fp) == 1);
+                for (j = 0; ok && (j < n); ++j, ++k) {
+                        ok = (fwrite(&g_array_index(rdrs, SaHpiRdrT, k),
+                                     sizeof(SaHpiRdrT), 1, fp) == 1);
+                }
+        }
+        if (fclose(fp) != 0) {
+                ok = 0;
+        }
+        if (!ok) {
+                CRIT("Couldn't write to file '%s'.", tmp_path);
+                remove(tmp_path);
+                return -1;
+        }
+
+#ifdef _WIN32
+        remove(path);
+#endif
+        if (rename(tmp_path, path) != 0) {
+                CRIT("Couldn't rename '%s' to '%s'.", tmp_path, path);
+                remove(tmp_path);
+                return -1;
+        }
+
+        return 0;
+}
+
+/* Saves the handler resources if they have changed since the last save */
+static void snap_save(unsigned int hid)
+{
+        struct oh_domain *d;
+        struct oh_snapshot_handler *sh;
+        struct oh_snapshot_header hdr;
+        SaHpiRptEntryT *rpte;
+        SaHpiRdrT *rdr;
+        SaHpiUint64T gen;
+        GArray *rptes, *counts, *rdrs;
+        char path[OH_PATH_PARAM_MAX_LENGTH + 64];
+
+        d = oh_get_domain(OH_DEFAULT_DOMAIN_ID);
+        if (!d) {
+                return;
+        }
+
+        memset(&hdr, 0, sizeof(hdr));
+        g_mutex_lock(snap_lock);
+        sh = g_hash_table_lookup(snap_handlers, &hid);
+        if (!sh || sh->stale) {
+                g_mutex_unlock(snap_lock);
+                oh_release_domain(d);
+                return;
+        }
+        hdr.config_hash = sh->config_hash;
+        g_mutex_unlock(snap_lock);
+
+        rptes = g_array_new(FALSE, FALSE, sizeof(SaHpiRptEntryT));
+        counts = g_array_new(FALSE, FALSE, sizeof(SaHpiUint32T));
+        rdrs = g_array_new(FALSE, FALSE, sizeof(SaHpiRdrT));
+        /* Only the handler's own resources make the generation, so the
+         * changes of other handlers do not rewrite this snapshot */
+        gen = 0xcbf29ce484222325ULL;
+        for (rpte = oh_get_resource_next(&d->rpt, SAHPI_FIRST_ENTRY);
+             rpte;
+             rpte = oh_get_resource_next(&d->rpt, rpte->ResourceId)) {
+                unsigned int *hidp = oh_get_resource_data(&d->rpt, rpte->ResourceId);
+                SaHpiUint32T n = 0, rdr_count = 0;
+                if (!hidp || (*hidp != hid)) {
+                        continue;
+                }
+                oh_get_rdr_update_count(&d->rpt, rpte->ResourceId, &rdr_count);
+                g_array_append_val(rptes, *rpte);
+                for (rdr = oh_get_rdr_next(&d->rpt, rpte->ResourceId, SAHPI_FIRST_ENTRY);
+                     rdr;
+                     rdr = oh_get_rdr_next(&d->rpt, rpte->ResourceId, rdr->RecordId)) {
+                        g_array_append_val(rdrs, *rdr);
+                        ++n;
+                }
+                g_array_append_val(counts, n);
+                gen = snap_hash(gen, rpte, sizeof(*rpte));
+                gen = snap_hash(gen, &rdr_count, sizeof(rdr_count));
+                gen = snap_hash(gen, &n, sizeof(n));
+        }
+        oh_release_domain(d);
+
+        g_mutex_lock(snap_lock);
+        sh = g_hash_table_lookup(snap_handlers, &hid);
+        if (sh && sh->saved && (sh->saved_gen == gen)) {
+                sh = NULL;
+        }
+        g_mutex_unlock(snap_lock);
+
+        if (sh) {
+                hdr.magic = OH_SNAPSHOT_MAGIC;
+                hdr.version = OH_SNAPSHOT_VERSION;
+                hdr.rpte_size = sizeof(SaHpiRptEntryT);
+                hdr.rdr_size = sizeof(SaHpiRdrT);
+                oh_gettimeofday(&hdr.timestamp);
+                hdr.num_resources = rptes->len;
+                snap_path(hdr.config_hash, path, sizeof(path));
+                if (snap_write(path, &hdr, rptes, counts, rdrs) == 0) {
+                        DBG("Handler %u: %u resources saved to snapshot %s.",
+                            hid, rptes->len, path);
+                        g_mutex_lock(snap_lock);
+                        sh = g_hash_table_lookup(snap_handlers, &hid);
+                        if (sh) {
+                                sh->saved = SAHPI_TRUE;
+                                sh->saved_gen = gen;
+                        }
+                        g_mutex_unlock(snap_lock);
+                }
+        }
+
+        g_array_free(rptes, TRUE);
+        g_array_free(counts, TRUE);
+        g_array_free(rdrs, TRUE);
+}
+
+/**
+ * oh_snapshot_sync
+ * @hid: handler id of a sync event
+ *
+ * Called from the event processing thread for a sync event.
+ * Removes the unconfirmed snapshot resources of a stale handler,
+ * otherwise saves the handler resources.
+ **/
+void oh_snapshot_sync(unsigned int hid)
+{
+        if (!snap_handlers) {
+                return;
+        }
+
+        if (snap_reconcile(hid) != 0) {
+                /* Save once the removal events have been processed */
+                oh_snapshot_post_sync_event(hid);
+                return;
+        }
+
+        snap_save(hid);
+}
+
+/**
+ * oh_snapshot_save_all
+ *
+ * Saves the resources of all tracked handlers that are not stale.
+ **/
+void oh_snapshot_save_all(void)
+{
+        GHashTableIter iter;
+        gpointer key;
+        GSList *hids = NULL, *node;
+
+        if (!snap_handlers) {
+                return;
+        }
+
+        g_mutex_lock(snap_lock);
+        g_hash_table_iter_init(&iter, snap_handlers);
+        while (g_hash_table_iter_next(&iter, &key, NULL)) {
+                hids = g_slist_prepend(hids, GUINT_TO_POINTER(*(unsigned int *)key));
+        }
+        g_mutex_unlock(snap_lock);
+
+        for (node = hids; node; node = node->next) {
+                snap_save(GPOINTER_TO_UINT(node->data));
+        }
+        g_slist_free(hids);
+}
+
+/**
+ * oh_snapshot_get_status
+ * @hid: handler id
+ * @status: handler status, State is set by the caller
+ *
+ * Fills in the snapshot fields and marks the handler as stale if its
+ * snapshot has not been reconciled yet.
+ **/
+void oh_snapshot_get_status(unsigned int hid, oHpiHandlerStatusT *status)
+{
+        struct oh_snapshot_handler *sh;
+
+        status->SnapshotTimestamp = SAHPI_TIME_UNSPECIFIED;
+        status->SnapshotResources = 0;
+        status->StaleResources = 0;
+
+        if (!snap_handlers) {
+                return;
+        }
+
+        g_mutex_lock(snap_lock);
+        sh = g_hash_table_lookup(snap_handlers, &hid);
+        if (sh) {
+                status->SnapshotTimestamp = sh->timestamp;
+                status->SnapshotResources = sh->loaded;
+                if (sh->stale) {
+                        status->StaleResources = g_hash_table_size(sh->pending);
+                        if (status->State == OHPI_HANDLER_READY) {
+                                status->State = OHPI_HANDLER_STALE;
+                        }
+                }
+        }
+        g_mutex_unlock(snap_lock);
+}
@@ -0,0 +1,42 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __OH_SNAPSHOT_H
+#define __OH_SNAPSHOT_H
+
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_utils.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int oh_snapshot_init(void);
+int oh_snapshot_finit(void);
+
+void oh_snapshot_load(unsigned int hid);
+void oh_snapshot_forget(unsigned int hid);
+void oh_snapshot_save_all(void);
+
+void oh_snapshot_post_sync_event(unsigned int hid);
+int oh_snapshot_detect_sync_event(struct oh_event *e);
+void oh_snapshot_sync(unsigned int hid);
+
+void oh_snapshot_resource_seen(RPTable *rpt, struct oh_event *e);
+
+void oh_snapshot_get_status(unsigned int hid, oHpiHandlerStatusT *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OH_SNAPSHOT_H */
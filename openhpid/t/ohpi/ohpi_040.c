@@ -0,0 +1,156 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_utils.h>
+#include <event.h>
+
+/**
+ * Create a simulator handler with the sensor reading cache enabled.
+ * Read a sensor twice and check the miss and hit counters of
+ * oHpiSensorCacheStatsGet, then post a sensor event and check that
+ * the cached reading was invalidated and the next read misses.
+ * Pass on success, otherwise test failed.
+ **/
+
+/* Finds a sensor with a reading */
+static int find_sensor(SaHpiSessionIdT sid,
+                       SaHpiResourceIdT *rid,
+                       SaHpiSensorNumT *num)
+{
+        SaHpiEntryIdT id, next_id, rdr_id, next_rdr_id;
+        SaHpiRptEntryT res;
+        SaHpiRdrT rdr;
+        SaHpiSensorReadingT reading;
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (saHpiRptEntryGet(sid, id, &next_id, &res))
+                        return -1;
+                if (!(res.ResourceCapabilities & SAHPI_CAPABILITY_SENSOR))
+                        continue;
+                for (rdr_id = SAHPI_FIRST_ENTRY; rdr_id != SAHPI_LAST_ENTRY;
+                     rdr_id = next_rdr_id) {
+                        if (saHpiRdrGet(sid, res.ResourceId, rdr_id,
+                                        &next_rdr_id, &rdr))
+                                break;
+                        if (rdr.RdrType != SAHPI_SENSOR_RDR)
+                                continue;
+                        if (saHpiSensorReadingGet(sid, res.ResourceId,
+                                                  rdr.RdrTypeUnion.SensorRec.Num,
+                                                  &reading, NULL))
+                                continue;
+                        *rid = res.ResourceId;
+                        *num = rdr.RdrTypeUnion.SensorRec.Num;
+                        return 0;
+                }
+        }
+
+        return -1;
+}
+
+/* Waits for the discovery events to be processed */
+static void wait_events(void)
+{
+        int i;
+
+        for (i = 0; i < 100 && oh_event_queue_length() != 0; ++i) {
+                g_usleep(G_USEC_PER_SEC / 20);
+        }
+}
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        GHashTable *config = g_hash_table_new(g_str_hash, g_str_equal);
+        oHpiHandlerIdT hid = 0;
+        oHpiSensorCacheStatsT before, after;
+        SaHpiResourceIdT rid;
+        SaHpiSensorNumT num;
+        SaHpiSensorReadingT reading;
+        struct oh_event *e;
+        int i;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiSensorCacheStatsGet(sid, NULL))
+                return -1;
+
+        g_hash_table_insert(config, "plugin", "libsimulator");
+        g_hash_table_insert(config, "entity_root", "{SYSTEM_CHASSIS,1}");
+        g_hash_table_insert(config, "name", "test");
+        g_hash_table_insert(config, "addr", "0");
+        g_hash_table_insert(config, "sensor_cache_max_age", "600000");
+
+        if (oHpiHandlerCreate(sid, config, &hid))
+                return -1;
+
+        if (saHpiDiscover(sid))
+                return -1;
+        wait_events();
+
+        /* The first read of the sensor fills the cache */
+        if (find_sensor(sid, &rid, &num))
+                return -1;
+
+        /* Cached now */
+        if (oHpiSensorCacheStatsGet(sid, &before))
+                return -1;
+        if (saHpiSensorReadingGet(sid, rid, num, &reading, NULL))
+                return -1;
+        if (oHpiSensorCacheStatsGet(sid, &after))
+                return -1;
+        if (after.Hits != before.Hits + 1 || after.Misses != before.Misses)
+                return -1;
+        if (after.Entries == 0)
+                return -1;
+
+        /* A sensor event drops the cached reading */
+        e = oh_new_event();
+        e->hid = hid;
+        e->event.Source = rid;
+        e->event.EventType = SAHPI_ET_SENSOR;
+        e->event.Severity = SAHPI_INFORMATIONAL;
+        oh_gettimeofday(&e->event.Timestamp);
+        e->event.EventDataUnion.SensorEvent.SensorNum = num;
+        e->event.EventDataUnion.SensorEvent.Assertion = SAHPI_TRUE;
+        e->event.EventDataUnion.SensorEvent.EventState = SAHPI_ES_UPPER_MINOR;
+        oh_evt_queue_push(oh_process_q, e);
+
+        for (i = 0; i < 100; ++i) {
+                if (oHpiSensorCacheStatsGet(sid, &before))
+                        return -1;
+                if (before.Invalidations > after.Invalidations)
+                        break;
+                g_usleep(G_USEC_PER_SEC / 20);
+        }
+        if (before.Invalidations != after.Invalidations + 1)
+                return -1;
+
+        if (saHpiSensorReadingGet(sid, rid, num, &reading, NULL))
+                return -1;
+        if (oHpiSensorCacheStatsGet(sid, &after))
+                return -1;
+        if (after.Misses != before.Misses + 1 || after.Hits != before.Hits)
+                return -1;
+
+        if (oHpiHandlerDestroy(sid, hid))
+                return -1;
+
+        return 0;
+}
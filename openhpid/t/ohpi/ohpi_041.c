@@ -0,0 +1,168 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_utils.h>
+#include <event.h>
+
+/**
+ * Create a simulator handler with the sensor reading cache enabled
+ * and read all sensors of a resource plus a missing one with
+ * oHpiSensorReadingsGet. Check every result against
+ * saHpiSensorReadingGet, then read them again in one call and check
+ * that the readings came from the cache.
+ * Pass on success, otherwise test failed.
+ **/
+
+#define MISSING_SENSOR 0xfff0
+
+/* Finds a resource with sensors and lists its sensors */
+static int find_sensors(SaHpiSessionIdT sid,
+                        SaHpiResourceIdT *rid,
+                        oHpiSensorReadingsT *readings)
+{
+        SaHpiEntryIdT id, next_id, rdr_id, next_rdr_id;
+        SaHpiRptEntryT res;
+        SaHpiRdrT rdr;
+        SaHpiUint32T n;
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (saHpiRptEntryGet(sid, id, &next_id, &res))
+                        return -1;
+                if (!(res.ResourceCapabilities & SAHPI_CAPABILITY_SENSOR))
+                        continue;
+                n = 0;
+                for (rdr_id = SAHPI_FIRST_ENTRY;
+                     rdr_id != SAHPI_LAST_ENTRY && n < OH_MAX_SENSOR_READINGS - 1;
+                     rdr_id = next_rdr_id) {
+                        if (saHpiRdrGet(sid, res.ResourceId, rdr_id,
+                                        &next_rdr_id, &rdr))
+                                break;
+                        if (rdr.RdrType != SAHPI_SENSOR_RDR)
+                                continue;
+                        readings->Readings[n++].Num =
+                                rdr.RdrTypeUnion.SensorRec.Num;
+                }
+                if (n < 2)
+                        continue;
+                readings->Readings[n++].Num = MISSING_SENSOR;
+                readings->NumberOfReadings = n;
+                *rid = res.ResourceId;
+                return 0;
+        }
+
+        return -1;
+}
+
+/* Waits for the discovery events to be processed */
+static void wait_events(void)
+{
+        int i;
+
+        for (i = 0; i < 100 && oh_event_queue_length() != 0; ++i) {
+                g_usleep(G_USEC_PER_SEC / 20);
+        }
+}
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        GHashTable *config = g_hash_table_new(g_str_hash, g_str_equal);
+        oHpiHandlerIdT hid = 0;
+        oHpiSensorReadingsT readings;
+        oHpiSensorCacheStatsT before, after;
+        SaHpiResourceIdT rid;
+        SaHpiSensorReadingT reading;
+        SaHpiEventStateT state;
+        SaHpiUint32T i, ok = 0;
+        SaErrorT rv;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiSensorReadingsGet(sid, 1, NULL))
+                return -1;
+
+        g_hash_table_insert(config, "plugin", "libsimulator");
+        g_hash_table_insert(config, "entity_root", "{SYSTEM_CHASSIS,1}");
+        g_hash_table_insert(config, "name", "test");
+        g_hash_table_insert(config, "addr", "0");
+        g_hash_table_insert(config, "sensor_cache_max_age", "600000");
+
+        if (oHpiHandlerCreate(sid, config, &hid))
+                return -1;
+
+        if (saHpiDiscover(sid))
+                return -1;
+        wait_events();
+
+        memset(&readings, 0, sizeof(readings));
+        if (find_sensors(sid, &rid, &readings))
+                return -1;
+
+        readings.NumberOfReadings = OH_MAX_SENSOR_READINGS + 1;
+        if (oHpiSensorReadingsGet(sid, rid, &readings) != SA_ERR_HPI_INVALID_PARAMS)
+                return -1;
+        for (i = 0; i < OH_MAX_SENSOR_READINGS; ++i) {
+                if (readings.Readings[i].Num == MISSING_SENSOR) {
+                        readings.NumberOfReadings = i + 1;
+                        break;
+                }
+        }
+
+        /* Each result is the one of saHpiSensorReadingGet */
+        if (oHpiSensorReadingsGet(sid, rid, &readings))
+                return -1;
+        for (i = 0; i < readings.NumberOfReadings; ++i) {
+                oHpiSensorReadingT *r = &readings.Readings[i];
+                rv = saHpiSensorReadingGet(sid, rid, r->Num, &reading, &state);
+                if (rv != r->Result)
+                        return -1;
+                if (rv != SA_OK)
+                        continue;
+                if (reading.IsSupported != r->Reading.IsSupported ||
+                    state != r->EventState)
+                        return -1;
+                if (reading.IsSupported &&
+                    (reading.Type != r->Reading.Type ||
+                     oh_compare_sensorreading(reading.Type, &reading,
+                                              &r->Reading) != 0))
+                        return -1;
+                ++ok;
+        }
+        if (ok == 0)
+                return -1;
+        if (readings.Readings[readings.NumberOfReadings - 1].Result !=
+            SA_ERR_HPI_NOT_PRESENT)
+                return -1;
+
+        /* The readings that succeeded are cached now */
+        if (oHpiSensorCacheStatsGet(sid, &before))
+                return -1;
+        if (oHpiSensorReadingsGet(sid, rid, &readings))
+                return -1;
+        if (oHpiSensorCacheStatsGet(sid, &after))
+                return -1;
+        if (after.Hits < before.Hits + ok)
+                return -1;
+
+        if (oHpiHandlerDestroy(sid, hid))
+                return -1;
+
+        return 0;
+}
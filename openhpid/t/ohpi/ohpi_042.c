@@ -0,0 +1,168 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+
+/**
+ * Create a simulator handler sampled every second, wait for two
+ * samples of a numeric sensor and check the history contents:
+ * samples oldest first with the sensor reading as value, consistent
+ * aggregates and time windows. Sensors and resources that are not
+ * sampled are reported as such.
+ * Pass on success, otherwise test failed.
+ **/
+
+#define MISSING_SENSOR 0xfff0
+
+/* Finds a sensor with a numeric reading */
+static int find_sensor(SaHpiSessionIdT sid,
+                       SaHpiResourceIdT *rid,
+                       SaHpiSensorNumT *num,
+                       SaHpiFloat64T *value)
+{
+        SaHpiEntryIdT id, next_id, rdr_id, next_rdr_id;
+        SaHpiRptEntryT res;
+        SaHpiRdrT rdr;
+        SaHpiSensorReadingT r;
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (saHpiRptEntryGet(sid, id, &next_id, &res))
+                        return -1;
+                if (!(res.ResourceCapabilities & SAHPI_CAPABILITY_SENSOR))
+                        continue;
+                for (rdr_id = SAHPI_FIRST_ENTRY; rdr_id != SAHPI_LAST_ENTRY;
+                     rdr_id = next_rdr_id) {
+                        if (saHpiRdrGet(sid, res.ResourceId, rdr_id,
+                                        &next_rdr_id, &rdr))
+                                break;
+                        if (rdr.RdrType != SAHPI_SENSOR_RDR)
+                                continue;
+                        if (saHpiSensorReadingGet(sid, res.ResourceId,
+                                                  rdr.RdrTypeUnion.SensorRec.Num,
+                                                  &r, NULL))
+                                continue;
+                        if (!r.IsSupported)
+                                continue;
+                        switch (r.Type) {
+                        case SAHPI_SENSOR_READING_TYPE_INT64:
+                                *value = r.Value.SensorInt64;
+                                break;
+                        case SAHPI_SENSOR_READING_TYPE_UINT64:
+                                *value = r.Value.SensorUint64;
+                                break;
+                        case SAHPI_SENSOR_READING_TYPE_FLOAT64:
+                                *value = r.Value.SensorFloat64;
+                                break;
+                        default:
+                                continue;
+                        }
+                        *rid = res.ResourceId;
+                        *num = rdr.RdrTypeUnion.SensorRec.Num;
+                        return 0;
+                }
+        }
+
+        return -1;
+}
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        GHashTable *config = g_hash_table_new(g_str_hash, g_str_equal);
+        oHpiHandlerIdT hid = 0;
+        oHpiSensorHistoryT history;
+        SaHpiResourceIdT rid;
+        SaHpiSensorNumT num;
+        SaHpiFloat64T value;
+        SaHpiTimeT first, last;
+        SaHpiUint32T i;
+        int tries;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiSensorHistoryGet(sid, 1, 1, SAHPI_TIME_UNSPECIFIED,
+                                 SAHPI_TIME_UNSPECIFIED, NULL))
+                return -1;
+
+        g_hash_table_insert(config, "plugin", "libsimulator");
+        g_hash_table_insert(config, "entity_root", "{SYSTEM_CHASSIS,1}");
+        g_hash_table_insert(config, "name", "test");
+        g_hash_table_insert(config, "addr", "0");
+        g_hash_table_insert(config, "sensor_sampler_interval", "1");
+        g_hash_table_insert(config, "sensor_sampler_history", "10");
+
+        if (oHpiHandlerCreate(sid, config, &hid))
+                return -1;
+
+        if (saHpiDiscover(sid))
+                return -1;
+
+        if (find_sensor(sid, &rid, &num, &value))
+                return -1;
+
+        /* The sampler takes one sample a second */
+        for (tries = 0; tries < 100; ++tries) {
+                if (oHpiSensorHistoryGet(sid, rid, num, SAHPI_TIME_UNSPECIFIED,
+                                         SAHPI_TIME_UNSPECIFIED, &history) == SA_OK &&
+                    history.Count >= 2)
+                        break;
+                g_usleep(G_USEC_PER_SEC / 10);
+        }
+        if (history.Count < 2 || history.Count > 10)
+                return -1;
+        if (history.NumberOfSamples != history.Count)
+                return -1;
+
+        /* The simulator reading does not change */
+        if (history.Min != value || history.Max != value || history.Avg != value)
+                return -1;
+        for (i = 0; i < history.NumberOfSamples; ++i) {
+                if (history.Samples[i].Value != value)
+                        return -1;
+                if (i > 0 &&
+                    history.Samples[i].Timestamp <= history.Samples[i - 1].Timestamp)
+                        return -1;
+        }
+        first = history.Samples[0].Timestamp;
+        last = history.Samples[history.NumberOfSamples - 1].Timestamp;
+
+        /* Windows select samples by their time */
+        if (oHpiSensorHistoryGet(sid, rid, num, last, SAHPI_TIME_UNSPECIFIED,
+                                 &history))
+                return -1;
+        if (history.Count < 1 || history.Samples[0].Timestamp != last)
+                return -1;
+        if (oHpiSensorHistoryGet(sid, rid, num, SAHPI_TIME_UNSPECIFIED, first - 1,
+                                 &history))
+                return -1;
+        if (history.Count != 0 || history.NumberOfSamples != 0)
+                return -1;
+
+        if (oHpiSensorHistoryGet(sid, rid, MISSING_SENSOR, SAHPI_TIME_UNSPECIFIED,
+                                 SAHPI_TIME_UNSPECIFIED, &history) != SA_ERR_HPI_NOT_PRESENT)
+                return -1;
+        if (oHpiSensorHistoryGet(sid, 5555, num, SAHPI_TIME_UNSPECIFIED,
+                                 SAHPI_TIME_UNSPECIFIED, &history) != SA_ERR_HPI_INVALID_RESOURCE)
+                return -1;
+
+        if (oHpiHandlerDestroy(sid, hid))
+                return -1;
+
+        return 0;
+}
@@ -0,0 +1,46 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+
+/**
+ * Pass null arguments and zero MaxEvents to oHpiEventsGet
+ * Pass on error, otherwise test failed.
+ **/
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        SaHpiUint32T n = 0;
+        SaHpiEventT events[2];
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiEventsGet(sid, SAHPI_TIMEOUT_IMMEDIATE, 2, 0,
+                           NULL, events, NULL, NULL, NULL))
+                return -1;
+
+        if (!oHpiEventsGet(sid, SAHPI_TIMEOUT_IMMEDIATE, 2, 0,
+                           &n, NULL, NULL, NULL, NULL))
+                return -1;
+
+        if (!oHpiEventsGet(sid, SAHPI_TIMEOUT_IMMEDIATE, 0, 0,
+                           &n, events, NULL, NULL, NULL))
+                return -1;
+
+        return 0;
+}
@@ -0,0 +1,196 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_utils.h>
+#include <event.h>
+
+/**
+ * Set valid and invalid event filters with oHpiEventFilterSet.
+ * Then filter one of two subscribed sessions, push events that fail
+ * each condition of the filter and two that pass, and check that the
+ * filtered session gets only those two while the other session gets
+ * all of them. Removing the filter lets all events through again.
+ * Pass on success, otherwise test failed.
+ **/
+
+#define EVENT_TIMEOUT (5 * (SaHpiTimeoutT)1000000000)
+
+static void push_event(SaHpiEventTypeT type,
+                       SaHpiResourceIdT rid,
+                       SaHpiSeverityT sev,
+                       SaHpiSensorTypeT sensor_type,
+                       const char *ep)
+{
+        struct oh_event *e = oh_new_event();
+
+        e->hid = 1;
+        e->event.Source = rid;
+        e->event.EventType = type;
+        e->event.Severity = sev;
+        oh_gettimeofday(&e->event.Timestamp);
+        if (type == SAHPI_ET_SENSOR) {
+                e->event.EventDataUnion.SensorEvent.SensorNum = 1;
+                e->event.EventDataUnion.SensorEvent.SensorType = sensor_type;
+                e->event.EventDataUnion.SensorEvent.Assertion = SAHPI_TRUE;
+                e->event.EventDataUnion.SensorEvent.EventState =
+                        SAHPI_ES_UPPER_MINOR;
+        }
+        if (ep) {
+                e->resource.ResourceId = rid;
+                e->resource.ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE |
+                                                   SAHPI_CAPABILITY_SENSOR;
+                oh_encode_entitypath(ep, &e->resource.ResourceEntity);
+        }
+        oh_evt_queue_push(oh_process_q, e);
+}
+
+/* Gets the events queued for the session */
+static int get_events(SaHpiSessionIdT sid, SaHpiTimeoutT timeout,
+                      SaHpiEventT *events, int max)
+{
+        int n = 0;
+
+        while (n < max &&
+               saHpiEventGet(sid, timeout, &events[n], NULL, NULL, NULL) == SA_OK) {
+                ++n;
+        }
+
+        return n;
+}
+
+static int check_delivery(SaHpiSessionIdT sid, SaHpiSessionIdT sid_all)
+{
+        const char *good_ep = "{SYSTEM_CHASSIS,1}{FAN,2}";
+        const char *pattern = "{SYSTEM_CHASSIS,1}{FAN,.}";
+        oHpiEventFilterT filter;
+        SaHpiEventT events[16];
+        int i, n, sensor = 0, user = 0;
+
+        if (saHpiSubscribe(sid) || saHpiSubscribe(sid_all))
+                return -1;
+
+        memset(&filter, 0, sizeof(filter));
+        filter.EventTypes = OH_EVENT_TYPE_BIT(SAHPI_ET_SENSOR) |
+                            OH_EVENT_TYPE_BIT(SAHPI_ET_USER);
+        filter.MinSeverity = SAHPI_MAJOR;
+        filter.NumberOfResources = 1;
+        filter.Resources[0] = 100;
+        filter.NumberOfSensorTypes = 1;
+        filter.SensorTypes[0] = SAHPI_TEMPERATURE;
+        filter.EntityPathPattern.DataType = SAHPI_TL_TYPE_TEXT;
+        filter.EntityPathPattern.Language = SAHPI_LANG_ENGLISH;
+        filter.EntityPathPattern.DataLength = strlen(pattern);
+        memcpy(filter.EntityPathPattern.Data, pattern, strlen(pattern));
+        if (oHpiEventFilterSet(sid, &filter))
+                return -1;
+
+        /* Passes */
+        push_event(SAHPI_ET_SENSOR, 100, SAHPI_CRITICAL, SAHPI_TEMPERATURE, good_ep);
+        /* Not severe enough */
+        push_event(SAHPI_ET_SENSOR, 100, SAHPI_MINOR, SAHPI_TEMPERATURE, good_ep);
+        /* Resource not listed */
+        push_event(SAHPI_ET_SENSOR, 101, SAHPI_CRITICAL, SAHPI_TEMPERATURE, good_ep);
+        /* Sensor type not listed */
+        push_event(SAHPI_ET_SENSOR, 100, SAHPI_CRITICAL, SAHPI_VOLTAGE, good_ep);
+        /* Entity path does not match */
+        push_event(SAHPI_ET_SENSOR, 100, SAHPI_CRITICAL, SAHPI_TEMPERATURE,
+                   "{SYSTEM_CHASSIS,2}{FAN,2}");
+        /* Event type not selected */
+        push_event(SAHPI_ET_WATCHDOG, 100, SAHPI_CRITICAL, 0, good_ep);
+        /* Passes, resource and entity path do not apply to user events */
+        push_event(SAHPI_ET_USER, SAHPI_UNSPECIFIED_RESOURCE_ID, SAHPI_MAJOR, 0, NULL);
+        /* Not severe enough */
+        push_event(SAHPI_ET_USER, SAHPI_UNSPECIFIED_RESOURCE_ID, SAHPI_MINOR, 0, NULL);
+
+        /* The unfiltered session gets all of them */
+        if (get_events(sid_all, EVENT_TIMEOUT, events, 8) != 8)
+                return -1;
+        g_usleep(G_USEC_PER_SEC / 10);
+
+        n = get_events(sid, SAHPI_TIMEOUT_IMMEDIATE, events, 16);
+        if (n != 2)
+                return -1;
+        for (i = 0; i < n; ++i) {
+                if (events[i].EventType == SAHPI_ET_SENSOR &&
+                    events[i].Source == 100 &&
+                    events[i].Severity == SAHPI_CRITICAL &&
+                    events[i].EventDataUnion.SensorEvent.SensorType ==
+                    SAHPI_TEMPERATURE) {
+                        ++sensor;
+                } else if (events[i].EventType == SAHPI_ET_USER &&
+                           events[i].Severity == SAHPI_MAJOR) {
+                        ++user;
+                }
+        }
+        if (sensor != 1 || user != 1)
+                return -1;
+
+        /* Without the filter the session gets all events again */
+        if (oHpiEventFilterSet(sid, NULL))
+                return -1;
+        push_event(SAHPI_ET_WATCHDOG, 101, SAHPI_MINOR, 0, NULL);
+        if (get_events(sid_all, EVENT_TIMEOUT, events, 1) != 1)
+                return -1;
+        if (get_events(sid, EVENT_TIMEOUT, events, 1) != 1 ||
+            events[0].EventType != SAHPI_ET_WATCHDOG)
+                return -1;
+
+        return 0;
+}
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0, sid_all = 0;
+        oHpiEventFilterT filter;
+        const char *good = "{SYSTEM_CHASSIS,.}{*}";
+        const char *bad = "{NO_SUCH_ENTITY,1";
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        memset(&filter, 0, sizeof(filter));
+        filter.EventTypes = OH_EVENT_TYPE_BIT(SAHPI_ET_SENSOR);
+        filter.MinSeverity = SAHPI_MINOR;
+        filter.NumberOfSensorTypes = 1;
+        filter.SensorTypes[0] = SAHPI_TEMPERATURE;
+        filter.EntityPathPattern.DataType = SAHPI_TL_TYPE_TEXT;
+        filter.EntityPathPattern.Language = SAHPI_LANG_ENGLISH;
+        filter.EntityPathPattern.DataLength = strlen(good);
+        memcpy(filter.EntityPathPattern.Data, good, strlen(good));
+        if (oHpiEventFilterSet(sid, &filter))
+                return -1;
+
+        filter.EntityPathPattern.DataLength = strlen(bad);
+        memcpy(filter.EntityPathPattern.Data, bad, strlen(bad));
+        if (!oHpiEventFilterSet(sid, &filter))
+                return -1;
+
+        filter.EntityPathPattern.DataLength = 0;
+        filter.NumberOfResources = OH_MAX_FILTER_RESOURCES + 1;
+        if (!oHpiEventFilterSet(sid, &filter))
+                return -1;
+
+        if (oHpiEventFilterSet(sid, NULL))
+                return -1;
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid_all, NULL))
+                return -1;
+
+        return check_delivery(sid, sid_all);
+}
@@ -0,0 +1,71 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+
+/**
+ * Pass null arguments, zero MaxEntries and SAHPI_NO_MORE_ENTRIES
+ * to oHpiEventLogEntriesGet
+ * Pass on error, otherwise test failed.
+ **/
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        SaHpiUint32T n = 0;
+        SaHpiEventLogEntryT entries[2];
+        SaHpiEventLogEntryIdT next;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiEventLogEntriesGet(sid, SAHPI_UNSPECIFIED_RESOURCE_ID,
+                                    SAHPI_OLDEST_ENTRY, 2,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    NULL, entries, NULL, NULL, &next))
+                return -1;
+
+        if (!oHpiEventLogEntriesGet(sid, SAHPI_UNSPECIFIED_RESOURCE_ID,
+                                    SAHPI_OLDEST_ENTRY, 2,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    &n, NULL, NULL, NULL, &next))
+                return -1;
+
+        if (!oHpiEventLogEntriesGet(sid, SAHPI_UNSPECIFIED_RESOURCE_ID,
+                                    SAHPI_OLDEST_ENTRY, 2,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    &n, entries, NULL, NULL, NULL))
+                return -1;
+
+        if (!oHpiEventLogEntriesGet(sid, SAHPI_UNSPECIFIED_RESOURCE_ID,
+                                    SAHPI_OLDEST_ENTRY, 0,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    &n, entries, NULL, NULL, &next))
+                return -1;
+
+        if (!oHpiEventLogEntriesGet(sid, SAHPI_UNSPECIFIED_RESOURCE_ID,
+                                    SAHPI_NO_MORE_ENTRIES, 2,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    SAHPI_TIME_UNSPECIFIED,
+                                    &n, entries, NULL, NULL, &next))
+                return -1;
+
+        return 0;
+}
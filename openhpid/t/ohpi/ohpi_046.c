@@ -0,0 +1,229 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <glib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_domain.h>
+#include <oh_utils.h>
+#include <conf.h>
+#include <event.h>
+#include <snapshot.h>
+
+/**
+ * Pass null arguments, handler id 0 and a bad handler id
+ * to oHpiHandlerStatusGet.
+ * Then save the resources of a simulator handler plus one the plugin
+ * does not report to a snapshot, destroy the handler and create it
+ * again. The snapshot resources are back in the RPT and the handler
+ * is stale. After the discovery the rediscovered resources are kept,
+ * the extra one is removed and the handler is ready.
+ * Pass on success, otherwise test failed.
+ **/
+
+/* Waits for the queued events to be processed */
+static void wait_events(void)
+{
+        int i;
+
+        for (i = 0; i < 100 && oh_event_queue_length() != 0; ++i) {
+                g_usleep(G_USEC_PER_SEC / 20);
+        }
+        g_usleep(G_USEC_PER_SEC / 10);
+}
+
+static SaHpiUint32T count_resources(SaHpiSessionIdT sid)
+{
+        SaHpiEntryIdT id, next_id;
+        SaHpiRptEntryT res;
+        SaHpiUint32T n = 0;
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (saHpiRptEntryGet(sid, id, &next_id, &res))
+                        break;
+                ++n;
+        }
+
+        return n;
+}
+
+/* Puts a resource of the handler into the RPT that the plugin does not know */
+static SaHpiResourceIdT add_extra_resource(unsigned int hid)
+{
+        struct oh_domain *d;
+        SaHpiRptEntryT rpte;
+        unsigned int *hidp;
+
+        memset(&rpte, 0, sizeof(rpte));
+        if (oh_encode_entitypath("{SYSTEM_CHASSIS,1}{FAN,99}",
+                                 &rpte.ResourceEntity))
+                return 0;
+        rpte.ResourceId = oh_uid_from_entity_path(&rpte.ResourceEntity);
+        rpte.EntryId = rpte.ResourceId;
+        rpte.ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE;
+        rpte.ResourceSeverity = SAHPI_MINOR;
+        rpte.ResourceFailed = SAHPI_FALSE;
+        oh_init_textbuffer(&rpte.ResourceTag);
+        oh_append_textbuffer(&rpte.ResourceTag, "Extra fan");
+
+        d = oh_get_domain(OH_DEFAULT_DOMAIN_ID);
+        if (!d)
+                return 0;
+        hidp = g_new0(unsigned int, 1);
+        *hidp = hid;
+        if (oh_add_resource(&d->rpt, &rpte, hidp, FREE_RPT_DATA)) {
+                g_free(hidp);
+                rpte.ResourceId = 0;
+        }
+        oh_release_domain(d);
+
+        return rpte.ResourceId;
+}
+
+static void remove_dir(const char *path)
+{
+        GDir *dir = g_dir_open(path, 0, NULL);
+        const gchar *name;
+
+        if (dir) {
+                while ((name = g_dir_read_name(dir)) != NULL) {
+                        gchar *file = g_build_filename(path, name, NULL);
+                        remove(file);
+                        g_free(file);
+                }
+                g_dir_close(dir);
+        }
+        rmdir(path);
+}
+
+static int run(SaHpiSessionIdT sid, const char *varpath)
+{
+        GHashTable *config = g_hash_table_new(g_str_hash, g_str_equal);
+        struct oh_global_param param;
+        oHpiHandlerIdT hid = 0;
+        oHpiHandlerStatusT status;
+        SaHpiRptEntryT res;
+        SaHpiResourceIdT extra;
+        SaHpiUint32T n;
+        int i;
+
+        param.type = OPENHPI_VARPATH;
+        strncpy(param.u.varpath, varpath, OH_MAX_TEXT_BUFFER_LENGTH - 1);
+        param.u.varpath[OH_MAX_TEXT_BUFFER_LENGTH - 1] = '\0';
+        oh_set_global_param(&param);
+        param.type = OPENHPI_SNAPSHOT;
+        param.u.snapshot = SAHPI_TRUE;
+        oh_set_global_param(&param);
+
+        g_hash_table_insert(config, "plugin", "libsimulator");
+        g_hash_table_insert(config, "entity_root", "{SYSTEM_CHASSIS,1}");
+        g_hash_table_insert(config, "name", "test");
+        g_hash_table_insert(config, "addr", "0");
+
+        /* Save */
+        if (oHpiHandlerCreate(sid, config, &hid))
+                return -1;
+        oh_snapshot_load(hid);
+        if (saHpiDiscover(sid))
+                return -1;
+        wait_events();
+        n = count_resources(sid);
+        if (n == 0)
+                return -1;
+        extra = add_extra_resource(hid);
+        if (extra == 0)
+                return -1;
+        oh_snapshot_save_all();
+
+        /* Restart the handler, its resources are gone */
+        if (oHpiHandlerDestroy(sid, hid))
+                return -1;
+        wait_events();
+        if (count_resources(sid) != 0)
+                return -1;
+
+        /* Reload */
+        if (oHpiHandlerCreate(sid, config, &hid))
+                return -1;
+        oh_snapshot_load(hid);
+        if (count_resources(sid) != n + 1)
+                return -1;
+        if (saHpiRptEntryGetByResourceId(sid, extra, &res))
+                return -1;
+        if (oHpiHandlerStatusGet(sid, hid, &status))
+                return -1;
+        if (status.State != OHPI_HANDLER_STALE ||
+            status.SnapshotResources != n + 1 ||
+            status.StaleResources != n + 1 ||
+            status.SnapshotTimestamp == SAHPI_TIME_UNSPECIFIED)
+                return -1;
+
+        /* Reconcile */
+        if (saHpiDiscover(sid))
+                return -1;
+        for (i = 0; i < 100; ++i) {
+                if (oHpiHandlerStatusGet(sid, hid, &status))
+                        return -1;
+                if (status.State == OHPI_HANDLER_READY &&
+                    count_resources(sid) == n)
+                        break;
+                g_usleep(G_USEC_PER_SEC / 20);
+        }
+        if (status.State != OHPI_HANDLER_READY ||
+            status.StaleResources != 0 ||
+            status.SnapshotResources != n + 1)
+                return -1;
+        if (count_resources(sid) != n)
+                return -1;
+        if (saHpiRptEntryGetByResourceId(sid, extra, &res) !=
+            SA_ERR_HPI_INVALID_RESOURCE)
+                return -1;
+
+        if (oHpiHandlerDestroy(sid, hid))
+                return -1;
+        g_hash_table_destroy(config);
+
+        return 0;
+}
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        oHpiHandlerStatusT status;
+        char varpath[] = "./snapshot.XXXXXX";
+        int rv;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiHandlerStatusGet(sid, 1, NULL))
+                return -1;
+
+        if (!oHpiHandlerStatusGet(sid, 0, &status))
+                return -1;
+
+        if (oHpiHandlerStatusGet(sid, 5555, &status) != SA_ERR_HPI_NOT_PRESENT)
+                return -1;
+
+        if (!mkdtemp(varpath))
+                return -1;
+        rv = run(sid, varpath);
+        remove_dir(varpath);
+
+        return rv;
+}
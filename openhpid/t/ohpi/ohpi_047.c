@@ -0,0 +1,82 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+#include <oh_utils.h>
+
+/**
+ * Pass null arguments and SAHPI_LAST_ENTRY to oHpiMemPoolStatsGet,
+ * then allocate and free events and find them in the event pool
+ * statistics.
+ * Pass on success, otherwise test failed.
+ **/
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        SaHpiEntryIdT id, next_id;
+        oHpiMemPoolStatsT stats;
+        struct oh_event *e[3];
+        int i, found = 0;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiMemPoolStatsGet(sid, SAHPI_FIRST_ENTRY, NULL, &stats))
+                return -1;
+
+        if (!oHpiMemPoolStatsGet(sid, SAHPI_FIRST_ENTRY, &next_id, NULL))
+                return -1;
+
+        if (!oHpiMemPoolStatsGet(sid, SAHPI_LAST_ENTRY, &next_id, &stats))
+                return -1;
+
+        for (i = 0; i < 3; ++i) {
+                e[i] = oh_new_event();
+                if (!e[i] || e[i]->hid != 0 || e[i]->rdrs != NULL)
+                        return -1;
+                e[i]->rdrs = g_slist_append(NULL, oh_new_rdr());
+        }
+        /* RDRs that do not come from the pool are accepted too */
+        e[0]->rdrs = g_slist_append(e[0]->rdrs, g_new0(SaHpiRdrT, 1));
+        for (i = 0; i < 3; ++i) {
+                oh_event_free(e[i], FALSE);
+        }
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (oHpiMemPoolStatsGet(sid, id, &next_id, &stats))
+                        return -1;
+                if (strcmp((const char *)stats.Name.Data, "event") != 0)
+                        continue;
+                found = 1;
+                if (stats.ObjectSize != sizeof(struct oh_event))
+                        return -1;
+                if (stats.Allocs < 3 || stats.Frees < 3)
+                        return -1;
+                if (stats.Capacity == 0 || stats.Slabs == 0)
+                        return -1;
+                if (stats.Free + stats.Cached > stats.Capacity)
+                        return -1;
+        }
+        if (!found)
+                return -1;
+
+        if (oHpiMemPoolStatsGet(sid, 5555, &next_id, &stats) != SA_ERR_HPI_NOT_PRESENT)
+                return -1;
+
+        return 0;
+}
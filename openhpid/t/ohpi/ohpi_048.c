@@ -0,0 +1,95 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+
+/**
+ * Pass null arguments and SAHPI_LAST_ENTRY to oHpiMetricGet,
+ * then call saHpiDomainInfoGet and find its domain lock
+ * acquisitions in the metrics.
+ * Pass on success, otherwise test failed.
+ **/
+
+static SaHpiUint64T domain_lock_count(SaHpiSessionIdT sid)
+{
+        SaHpiEntryIdT id, next_id;
+        oHpiMetricT m;
+        SaHpiUint64T n;
+        int i;
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (oHpiMetricGet(sid, id, &next_id, &m))
+                        return 0;
+                if (m.Type != OHPI_METRIC_LOCK ||
+                    strcmp((const char *)m.Name.Data, "domain") != 0)
+                        continue;
+                n = 0;
+                for (i = 0; i < OHPI_METRIC_BUCKETS; ++i) {
+                        n += m.Buckets[i];
+                }
+                if (n != m.Count || m.Max > m.Sum)
+                        return 0;
+                return m.Count;
+        }
+
+        return 0;
+}
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        SaHpiEntryIdT id, next_id;
+        SaHpiDomainInfoT info;
+        oHpiMetricT m;
+        SaHpiUint64T before, after;
+        int i, queues = 0;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiMetricGet(sid, SAHPI_FIRST_ENTRY, NULL, &m))
+                return -1;
+
+        if (!oHpiMetricGet(sid, SAHPI_FIRST_ENTRY, &next_id, NULL))
+                return -1;
+
+        if (!oHpiMetricGet(sid, SAHPI_LAST_ENTRY, &next_id, &m))
+                return -1;
+
+        before = domain_lock_count(sid);
+        for (i = 0; i < 10; ++i) {
+                if (saHpiDomainInfoGet(sid, &info))
+                        return -1;
+        }
+        after = domain_lock_count(sid);
+        if (after < before + 10)
+                return -1;
+
+        for (id = SAHPI_FIRST_ENTRY; id != SAHPI_LAST_ENTRY; id = next_id) {
+                if (oHpiMetricGet(sid, id, &next_id, &m))
+                        return -1;
+                if (m.Type == OHPI_METRIC_QUEUE)
+                        ++queues;
+        }
+        if (queues != 2)
+                return -1;
+
+        if (oHpiMetricGet(sid, 5555, &next_id, &m) != SA_ERR_HPI_NOT_PRESENT)
+                return -1;
+
+        return 0;
+}
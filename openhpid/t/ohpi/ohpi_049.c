@@ -0,0 +1,71 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <SaHpi.h>
+#include <oHpi.h>
+
+/**
+ * Pass null arguments, zero maximums and SAHPI_LAST_ENTRY to oHpiIdrGet,
+ * then ask for the IDR of a resource that does not exist.
+ * Pass on error, otherwise test failed.
+ **/
+
+int main(int argc, char **argv)
+{
+        SaHpiSessionIdT sid = 0;
+        SaHpiIdrInfoT info;
+        SaHpiUint32T na, nf;
+        SaHpiIdrAreaHeaderT areas[4];
+        SaHpiIdrFieldT fields[16];
+        SaHpiEntryIdT next;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        if (saHpiSessionOpen(SAHPI_UNSPECIFIED_DOMAIN_ID, &sid, NULL))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_FIRST_ENTRY, 4, 16,
+                        NULL, &na, areas, &nf, fields, &next))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_FIRST_ENTRY, 4, 16,
+                        &info, &na, NULL, &nf, fields, &next))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_FIRST_ENTRY, 4, 16,
+                        &info, &na, areas, &nf, NULL, &next))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_FIRST_ENTRY, 4, 16,
+                        &info, &na, areas, &nf, fields, NULL))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_FIRST_ENTRY, 0, 16,
+                        &info, &na, areas, &nf, fields, &next))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_FIRST_ENTRY, 4, 0,
+                        &info, &na, areas, &nf, fields, &next))
+                return -1;
+
+        if (!oHpiIdrGet(sid, 1, 0, SAHPI_LAST_ENTRY, 4, 16,
+                        &info, &na, areas, &nf, fields, &next))
+                return -1;
+
+        if (oHpiIdrGet(sid, 5555, 0, SAHPI_FIRST_ENTRY, 4, 16,
+                       &info, &na, areas, &nf, fields, &next)
+            != SA_ERR_HPI_INVALID_RESOURCE)
+                return -1;
+
+        return 0;
+}
@@ -0,0 +1,234 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <stdlib.h>
+#include <glib.h>
+#include <SaHpi.h>
+#include <oh_utils.h>
+#include <conf.h>
+#include <event_sched.h>
+
+/**
+ * Queue events of mixed severity and check that the event scheduler
+ * returns hotswap and critical events first, while the events of one
+ * sensor keep their order and the events of a resource are not
+ * processed after its hotswap or resource events. Then enable the rate limit
+ * and duplicate coalescing and check that a storm from one resource is
+ * cut down while its major events, deassertions and sensor disables
+ * still pass.
+ * Pass on success, otherwise test failed.
+ **/
+
+static struct oh_event *new_event(SaHpiResourceIdT rid,
+                                  SaHpiEventTypeT type,
+                                  SaHpiSeverityT sev,
+                                  SaHpiSensorNumT num)
+{
+        struct oh_event *e = oh_new_event();
+
+        e->hid = 1;
+        e->event.Source = rid;
+        e->event.EventType = type;
+        e->event.Severity = sev;
+        if (type == SAHPI_ET_SENSOR) {
+                e->event.EventDataUnion.SensorEvent.SensorNum = num;
+                e->event.EventDataUnion.SensorEvent.Assertion = SAHPI_TRUE;
+                e->event.EventDataUnion.SensorEvent.EventState =
+                        SAHPI_ES_UPPER_MINOR;
+        }
+
+        return e;
+}
+
+static struct oh_event *new_sensor_event(SaHpiResourceIdT rid,
+                                         SaHpiSeverityT sev,
+                                         SaHpiBoolT assertion)
+{
+        struct oh_event *e = new_event(rid, SAHPI_ET_SENSOR, sev, 1);
+
+        e->event.EventDataUnion.SensorEvent.Assertion = assertion;
+
+        return e;
+}
+
+/* Pops an event and checks its source and assertion */
+static int pop_sensor(oh_evt_queue *q, SaHpiResourceIdT rid,
+                      SaHpiBoolT assertion)
+{
+        struct oh_event *e = oh_event_sched_pop(q);
+        int rv = 0;
+
+        if (!e) return -1;
+        if (e->event.Source != rid ||
+            e->event.EventDataUnion.SensorEvent.Assertion != assertion)
+                rv = -1;
+        oh_event_free(e, FALSE);
+
+        return rv;
+}
+
+static int pop_source(oh_evt_queue *q, SaHpiResourceIdT *rid)
+{
+        struct oh_event *e = oh_event_sched_pop(q);
+
+        if (!e) return -1;
+        *rid = e->event.Source;
+        oh_event_free(e, FALSE);
+
+        return 0;
+}
+
+/* Pops an event and checks its source and type */
+static int pop_type(oh_evt_queue *q, SaHpiResourceIdT rid,
+                    SaHpiEventTypeT type)
+{
+        struct oh_event *e = oh_event_sched_pop(q);
+        int rv = 0;
+
+        if (!e) return -1;
+        if (e->event.Source != rid || e->event.EventType != type)
+                rv = -1;
+        oh_event_free(e, FALSE);
+
+        return rv;
+}
+
+static void set_param(oh_global_param_type type, SaHpiUint32T value)
+{
+        struct oh_global_param param;
+
+        param.type = type;
+        switch (type) {
+        case OPENHPI_EVT_RATE_LIMIT:
+                param.u.evt_rate_limit = value;
+                break;
+        case OPENHPI_EVT_RATE_BURST:
+                param.u.evt_rate_burst = value;
+                break;
+        case OPENHPI_EVT_COALESCE_WINDOW:
+                param.u.evt_coalesce_window = value;
+                break;
+        default:
+                return;
+        }
+        oh_set_global_param(&param);
+}
+
+int main(int argc, char **argv)
+{
+        static const SaHpiResourceIdT order[] = { 3, 4, 5, 2, 1 };
+        struct oh_event_sched_stats stats;
+        oh_evt_queue *q;
+        SaHpiResourceIdT rid;
+        int i;
+
+        /* Unset config file env variable */
+        setenv("OPENHPI_CONF","./noconfig", 1);
+
+        q = g_async_queue_new();
+
+        /* Priority lanes, the source tells the events apart */
+        oh_event_sched_init();
+        g_async_queue_push(q, new_event(1, SAHPI_ET_SENSOR, SAHPI_INFORMATIONAL, 1));
+        g_async_queue_push(q, new_event(2, SAHPI_ET_SENSOR, SAHPI_MINOR, 1));
+        g_async_queue_push(q, new_event(3, SAHPI_ET_HOTSWAP, SAHPI_INFORMATIONAL, 0));
+        g_async_queue_push(q, new_event(4, SAHPI_ET_SENSOR, SAHPI_CRITICAL, 1));
+        g_async_queue_push(q, new_event(5, SAHPI_ET_SENSOR, SAHPI_MAJOR, 1));
+        for (i = 0; i < 5; ++i) {
+                if (pop_source(q, &rid) || rid != order[i])
+                        return -1;
+        }
+        oh_event_sched_get_stats(&stats);
+        if (stats.queued != 0 || stats.rate_limited != 0 || stats.coalesced != 0)
+                return -1;
+
+        /* A flapping sensor keeps assert, deassert, assert order.
+         * The OK deassertion of resource 13 is queued before its
+         * critical assertion and must stay before it. */
+        g_async_queue_push(q, new_event(11, SAHPI_ET_SENSOR, SAHPI_INFORMATIONAL, 1));
+        g_async_queue_push(q, new_sensor_event(13, SAHPI_OK, SAHPI_FALSE));
+        g_async_queue_push(q, new_event(12, SAHPI_ET_SENSOR, SAHPI_MAJOR, 1));
+        g_async_queue_push(q, new_sensor_event(10, SAHPI_CRITICAL, SAHPI_TRUE));
+        g_async_queue_push(q, new_sensor_event(10, SAHPI_OK, SAHPI_FALSE));
+        g_async_queue_push(q, new_sensor_event(10, SAHPI_CRITICAL, SAHPI_TRUE));
+        g_async_queue_push(q, new_sensor_event(13, SAHPI_CRITICAL, SAHPI_TRUE));
+        if (pop_sensor(q, 10, SAHPI_TRUE) ||
+            pop_sensor(q, 10, SAHPI_FALSE) ||
+            pop_sensor(q, 10, SAHPI_TRUE) ||
+            pop_sensor(q, 13, SAHPI_FALSE) ||
+            pop_sensor(q, 13, SAHPI_TRUE) ||
+            pop_source(q, &rid) || rid != 12 ||
+            pop_source(q, &rid) || rid != 11)
+                return -1;
+
+        /* The hotswap event of resource 20 takes its queued sensor
+         * events along, so none of them is processed after it. */
+        g_async_queue_push(q, new_event(20, SAHPI_ET_SENSOR, SAHPI_MINOR, 1));
+        g_async_queue_push(q, new_event(21, SAHPI_ET_SENSOR, SAHPI_CRITICAL, 1));
+        g_async_queue_push(q, new_event(22, SAHPI_ET_SENSOR, SAHPI_MINOR, 1));
+        g_async_queue_push(q, new_event(20, SAHPI_ET_SENSOR, SAHPI_MAJOR, 2));
+        g_async_queue_push(q, new_event(20, SAHPI_ET_HOTSWAP, SAHPI_INFORMATIONAL, 0));
+        g_async_queue_push(q, new_event(20, SAHPI_ET_SENSOR, SAHPI_MINOR, 3));
+        if (pop_type(q, 21, SAHPI_ET_SENSOR) ||
+            pop_type(q, 20, SAHPI_ET_SENSOR) ||
+            pop_type(q, 20, SAHPI_ET_SENSOR) ||
+            pop_type(q, 20, SAHPI_ET_HOTSWAP) ||
+            pop_type(q, 22, SAHPI_ET_SENSOR) ||
+            pop_type(q, 20, SAHPI_ET_SENSOR))
+                return -1;
+        oh_event_sched_finit();
+
+        /* Rate limit of 1 event/s with a burst of 3 on resource 7 */
+        set_param(OPENHPI_EVT_RATE_LIMIT, 1);
+        set_param(OPENHPI_EVT_RATE_BURST, 3);
+        oh_event_sched_init();
+        for (i = 0; i < 10; ++i) {
+                g_async_queue_push(q, new_event(7, SAHPI_ET_SENSOR, SAHPI_MINOR, i));
+        }
+        /* The bucket is empty, these clear alarms and pass anyway */
+        g_async_queue_push(q, new_sensor_event(7, SAHPI_OK, SAHPI_FALSE));
+        g_async_queue_push(q, new_event(7, SAHPI_ET_SENSOR_ENABLE_CHANGE,
+                                        SAHPI_INFORMATIONAL, 0));
+        for (i = 0; i < 2; ++i) {
+                g_async_queue_push(q, new_event(8, SAHPI_ET_SENSOR, SAHPI_MAJOR, i));
+        }
+        /* Major events are above OPENHPI_EVT_RATE_SEV and come first */
+        for (i = 0; i < 7; ++i) {
+                if (pop_source(q, &rid) || rid != (i < 2 ? 8 : 7))
+                        return -1;
+        }
+        oh_event_sched_get_stats(&stats);
+        if (stats.queued != 0 || stats.rate_limited != 7)
+                return -1;
+        oh_event_sched_finit();
+
+        /* Duplicates of one sensor within 10 s are coalesced */
+        set_param(OPENHPI_EVT_RATE_LIMIT, 0);
+        set_param(OPENHPI_EVT_COALESCE_WINDOW, 10000);
+        oh_event_sched_init();
+        for (i = 0; i < 6; ++i) {
+                g_async_queue_push(q, new_event(9, SAHPI_ET_SENSOR, SAHPI_MINOR, i % 2));
+        }
+        for (i = 0; i < 2; ++i) {
+                if (pop_source(q, &rid) || rid != 9)
+                        return -1;
+        }
+        oh_event_sched_get_stats(&stats);
+        if (stats.queued != 0 || stats.coalesced != 4)
+                return -1;
+        oh_event_sched_finit();
+
+        if (g_async_queue_length(q) != 0)
+                return -1;
+        g_async_queue_unref(q);
+
+        return 0;
+}
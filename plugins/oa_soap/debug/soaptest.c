@@ -117,6 +117,7 @@ int main(int argc, char *argv[])
     byte			bay;
     int				slot;
     int				i;
+    guint			j;
     int				ret;
     int				old_timeout = 0;
     char			*str;
@@ -1053,12 +1054,13 @@ int main(int argc, char *argv[])
 	    /* Successful call...print what we got from the events array.
 	     * Note that not all event information is printed below.
 	     */
-	    if (! getAllEvents_response.eventInfoArray) {
+	    if (getAllEvents_response.events->len == 0) {
 	    	printf("  Note: getAllEvents() returned successfully, but "
 		       "with no events.  (This is not an error.)\n");
 	    }
-	    while (getAllEvents_response.eventInfoArray) {
-		soap_getEventInfo(getAllEvents_response.eventInfoArray, &event);
+	    for (j = 0; j < getAllEvents_response.events->len; j++) {
+		event = *(struct eventInfo *)
+			g_ptr_array_index(getAllEvents_response.events, j);
 		printf("  Event:\n");
 		printf("    event type = %d\n",  event.event);
 		printf("    time stamp = %ld\n", event.eventTimeStamp);
@@ -1142,8 +1144,6 @@ int main(int argc, char *argv[])
 		    	printf("      type: other\n");
 			break;
 		}
-		getAllEvents_response.eventInfoArray =
-			soap_next_node(getAllEvents_response.eventInfoArray);
 	    }
 	}
     }
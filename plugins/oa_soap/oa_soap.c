@@ -167,6 +167,7 @@ SaErrorT build_oa_soap_custom_handler(struct oh_handler_state *oh_handler)
 		oa_handler->oa_2->oh_handler = oh_handler;
                 memset(oa_handler->memErrRecFlag, 0, sizeof( SaHpiInt32T) * 16);
                 memset(oa_handler->server_insert_timer, 0, sizeof( time_t) * 16);
+                oa_handler->mirror = oa_soap_mirror_new(oh_handler->config);
 
                 /* Put the oa_handler in oh_handler */
                 oh_handler->data = oa_handler;
@@ -414,6 +415,9 @@ void oa_soap_close(void *oh_handler)
         wrap_g_free(oa_handler->oa_2);
         dbg("Released the oa_info structures from handler");
 
+        /* Release the enclosure state mirror */
+        oa_soap_mirror_free(oa_handler->mirror);
+
         /* Release the oa handler structure */
         wrap_g_free(oa_handler);
         wrap_g_free(handler);
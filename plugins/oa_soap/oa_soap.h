@@ -48,6 +48,7 @@
 #include <oh_error.h>
 
 #include "oa_soap_calls.h"
+#include "oa_soap_mirror.h"
 
 /* The resource numbers in OA SOAP. The rpt and rdr arrays are indexed based on
  * the entity numbers defined below.
@@ -218,6 +219,9 @@ struct oa_soap_handler
         uint desired_rated_circuit_cap;
         SaHpiInt32T memErrRecFlag[16];
         time_t server_insert_timer[16];
+
+        /* Last known sensor readings, NULL if disabled */
+        struct oa_soap_mirror *mirror;
 };
 
 /* Structure for storing the current hotswap state of the resource */
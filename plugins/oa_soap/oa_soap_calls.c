@@ -826,12 +826,15 @@ static void parse_getBladeThermalInfoArray(xmlNode *node,
 
 }
 
-/* parse_getAllEvents - Parses a getAllEventsResponse structure */
-static void     parse_getAllEvents(xmlNode *node,
-                                   struct getAllEventsResponse *response)
+/* decode_eventInfo - Decodes an eventInfo node of a streamed
+ *      getAllEventsEx response
+ */
+static gpointer decode_eventInfo(xmlNode *node)
 {
-        response->eventInfoArray =
-                soap_walk_tree(node, "eventInfoArray:eventInfo");
+        struct eventInfo *event = g_new0(struct eventInfo, 1);
+
+        soap_getEventInfo(node, event);
+        return(event);
 }
 
 
@@ -1293,7 +1296,8 @@ void	soap_bladeThermalInfo(xmlNode *node, struct bladeThermalInfo * result)
 }
 
 /* soap_getEventInfo - Walks list of eventInfo nodes, providing details
- *      on each event.  Used after calling soap_getAllEvents().
+ *      on each event.  Used to decode the events of soap_getEvent() and
+ *      soap_getAllEventsEx().
  *
  * Outputs:
  *      event:          indicates the type of event
@@ -1605,16 +1609,19 @@ int soap_getAllEventsEx(SOAP_CON *con,
                       struct getAllEventsResponse *response)
 {
         SOAP_PARM_CHECK
-        if (! (ret = soap_request(con, GET_ALL_EVENTSEX,
+        /* The events are decoded while the response is read, rather than
+         * by walking the document of the whole response afterwards
+         */
+        con->stream_name = "eventInfo";
+        con->stream_fn = decode_eventInfo;
+        ret = soap_request(con, GET_ALL_EVENTSEX,
                            request->pid,
                            request->waitTilEventHappens, /* xsd:boolean */
                            request->lcdEvents, /* xsd:boolean */
-                           request->oaFwVersion))) {
-                parse_getAllEvents(soap_walk_doc(con->doc,
-                                                 "Body:"
-                                                 "getAllEventsExResponse"),
-                                   response);
-        }
+                           request->oaFwVersion);
+        con->stream_name = NULL;
+        con->stream_fn = NULL;
+        response->events = ret ? NULL : con->stream_items;
         return(ret);
 }
 
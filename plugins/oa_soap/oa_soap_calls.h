@@ -2194,7 +2194,10 @@ struct eventInfo
 
 struct getAllEventsResponse
 {
-        xmlNode *eventInfoArray;
+        /* struct eventInfo records, decoded while the response was read.
+         * They belong to the connection and are valid until its next call.
+         */
+        GPtrArray *events;
 };
 
 struct getBladeThermalInfoArray
@@ -50,6 +50,12 @@
  *                                individual SOAP client call functions to
  *                                communicate with the OA
  *
+ *      Responses with long lists, such as getAllEventsEx, can be decoded
+ *      while they are read: the call sets stream_name and stream_fn in the
+ *      connection, and each element with that name is passed to stream_fn
+ *      as soon as its end tag is parsed, then unlinked from the document.
+ *      The decoded records are left in stream_items.
+ *
  * XML Response Tree Parsing:
  *      soap_find_node()        - Recursively searches an XML tree, starting
  *                                with a specified node, looking for the
@@ -70,7 +76,8 @@
  *                                the next response node
  *      soap_enum()             - Performs enum string matching, which would
  *                                otherwise require a large amount of parameter
- *                                parsing code
+ *                                parsing code.  Uses lookup tables that are
+ *                                built once for each enum type
  *      soap_inv_enum()         - Performs the inverse of soap_enum()
  *
  * General Utility:
@@ -89,6 +96,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <glib.h>
+#include <libxml/SAX2.h>
 #include <oh_error.h>
 #include "oa_soap_callsupport.h"
 #include "sahpi_wrappers.h"
@@ -107,9 +115,27 @@ enum soap_error_enum {
 };
 
 
+/* Lookup tables for the combined enum value strings, built on first use.
+ * They are keyed by the address of the string, which is a constant defined
+ * by OA_SOAP_ENUM(), and are kept until the plugin is unloaded.
+ */
+struct soap_enum_table {
+        GHashTable      *values;        /* Enum name to enum value + 1 */
+        GPtrArray       *names;         /* Enum value to enum name */
+};
+
+#if GLIB_CHECK_VERSION (2, 32, 0)
+static GMutex soap_enum_lock;
+#else
+static GStaticMutex soap_enum_lock = G_STATIC_MUTEX_INIT;
+#endif
+static GHashTable *soap_enum_tables = NULL;
+
+
 /* Forward declarations of static functions */
 static int      soap_login(SOAP_CON *connection);
 static int      soap_logout(SOAP_CON *connection);
+static void     soap_stream_free(SOAP_CON *connection);
 
 
 /**
@@ -186,10 +212,8 @@ xmlNode         *soap_walk_tree(xmlNode *node, char *colonstring)
         /* Look for this in the node tree's children */
         node = node->children;
         while (node) {
-                if ((! xmlStrncmp(node->name,
-                                  (const xmlChar *)colonstring,
-                                  len)) &&
-                    (xmlStrlen(node->name) == len)) {
+                if ((! strncmp((const char *)node->name, colonstring, len)) &&
+                    (node->name[len] == '\0')) {
                         if (*next) {
                                 return(soap_walk_tree(node, next));
                         }
@@ -299,6 +323,58 @@ xmlNode         *soap_next_node(xmlNode *node)
 }
 
 
+/**
+ * soap_enum_table
+ * @enums:      Combined enum value string, as generated by the OA_SOAP_ENUM()
+ *              macro.
+ *
+ * Used internally to get the lookup table for an enum type.  On first use,
+ * the combined enum string is split at the ',' separators into the enum
+ * names, so later lookups need neither strstr() nor separator counting.
+ *
+ * Return value: the lookup table for the enum type.
+ **/
+static struct soap_enum_table *soap_enum_table(const char *enums)
+{
+        struct soap_enum_table *table;
+        const char      *start;
+        const char      *end;
+        char            *name;
+
+        wrap_g_static_mutex_lock(&soap_enum_lock);
+        if (! soap_enum_tables) {
+                soap_enum_tables = g_hash_table_new(g_direct_hash,
+                                                    g_direct_equal);
+        }
+        table = g_hash_table_lookup(soap_enum_tables, enums);
+        if (! table) {
+                table = g_new0(struct soap_enum_table, 1);
+                table->values = g_hash_table_new(g_str_hash, g_str_equal);
+                table->names = g_ptr_array_new();
+                for (start = enums; start; start = end ? end + 1 : NULL) {
+                        while (*start == ' ')
+                                start++;
+                        end = strchr(start, ',');
+                        if (end)
+                                name = g_strndup(start, end - start);
+                        else
+                                name = g_strdup(start);
+                        g_strchomp(name);
+                        g_ptr_array_add(table->names, name);
+                        /* The first of duplicate names wins, as before */
+                        if (! g_hash_table_lookup(table->values, name)) {
+                                g_hash_table_insert(table->values, name,
+                                        GINT_TO_POINTER(table->names->len));
+                        }
+                }
+                g_hash_table_insert(soap_enum_tables, (gpointer)enums, table);
+        }
+        wrap_g_static_mutex_unlock(&soap_enum_lock);
+
+        return(table);
+}
+
+
 /**
  * soap_enum
  * @enums:      Combined enum value string, as generated by the OA_SOAP_ENUM()
@@ -314,61 +390,33 @@ xmlNode         *soap_next_node(xmlNode *node)
  * There would be a large amount of string matching code to do this job.
  *
  * Instead, during the definition of each enum, a single string is also created
- * containing the string values that need to be matched.  A single call to
- * strstr() will locate the enum value in the string, and then it's position in
- * the combined enum string determines the enum value to be returned.
+ * containing the string values that need to be matched.  The position of a
+ * name in the combined enum string determines the enum value to be returned.
+ * The string is split into a hash table the first time the enum is used, so
+ * that each match is a single hash lookup.
  *
  * Return value: The enum value (a non-negative integer) if a match is found.
  * If there is no successful match, the value -1 is returned.
  **/
 int             soap_enum(const char *enums, char *value)
 {
-        char            *found;
-        const char      *start = enums;
-        int             n = 0;
-        int             len;
+        struct soap_enum_table *table;
+        int             n;
 
         if (! value) {                  /* Can't proceed without a string */
                 err("could not find enum (NULL value) in \"%s\"", enums);
                 return(-1);
         }
 
-        len = strlen(value);
-        if(len == 0){
-               return -1;		
-        }
-	/* We have to search repeatedly, in case the match is just a substring
-	 * of an enum value.
-	 */
-	while (start) {
-        	found = strstr(start, value);
-		/* To match, a value must be found, it must either be at the
-		 * start of the string or be preceeded by a space, and must
-		 * be at the end of the string or be followed by a ','
-		 */
-        	if ((found) &&
-		    ((found == start) || (*(found - 1) == ' ')) &&
-		    ((*(found + len) == ',') || (*(found + len) == '\0'))) {
-		    	/* Having found a match, count backwards to see which
-			 * enum value should be returned.
-			 */
-                	while (--found >= enums) {
-                        	if (*found == ',')
-                                	n++;
-                	}
-                	return(n);
-        	}
-		if (found) {
-			/* We found something but it was a substring.  We need
-			 * to search again, but starting further along in the
-			 * enums string.
-			 */
-			start = found + len;
-		}
-		else {
-			start = NULL;	/* We won't search any more */
-		}
-	}
+        if (*value == '\0') {
+               return -1;
+        }
+
+        table = soap_enum_table(enums);
+        n = GPOINTER_TO_INT(g_hash_table_lookup(table->values, value));
+        if (n) {
+                return(n - 1);
+        }
 
         err("could not find enum value \"%s\" in \"%s\"", value, enums);
         return(-1);
@@ -388,14 +436,10 @@ int             soap_enum(const char *enums, char *value)
  *
  * In this case, the user provides an enum value, and we need to send an ASCII
  * string to the OA.  Instead of a case statement, this function uses the same
- * combined enum value string to produce the string that needs to go to across
- * the wire.
- *
- * The process is to count the enum value separators (the ',') placed by the
- * OA_SOAP_ENUM() macro and find the right enum name string.  It is necessary
- * to copy this string to a temporary buffer, because the string will become
- * an argument to sprintf(), and needs to be null-terminated.  Therefore, the
- * caller must provide a buffer big enough for the resulting string.
+ * lookup table as soap_enum() to find the string that needs to go to across
+ * the wire.  The name is copied to a caller buffer, because the string will
+ * become an argument to sprintf().  Therefore, the caller must provide a
+ * buffer big enough for the resulting string.
  *
  * Note that there are no error checks on the buffer size, so please ensure
  * that "result" is big enough for any of the enum names.
@@ -406,33 +450,20 @@ int             soap_enum(const char *enums, char *value)
  **/
 int             soap_inv_enum(char *result, const char *enums, int value)
 {
-        char            *found;
-        int             len;
+        struct soap_enum_table *table;
 
         if (value < 0) {                /* Error check */
                 err("inappropriate value");
                 return(-1);
         }
 
-        while (value && enums) {
-                enums = strchr(enums, ',') + 1;
-                value--;
-        }
-        if (! enums) {
+        table = soap_enum_table(enums);
+        if ((guint)value >= table->names->len) {
                 err("can't find enum");
                 return(-1);
         }
 
-        if (*enums == ' ')
-                enums++;
-
-        found = strchr(enums, ',');
-        if (found)
-                len = found - enums;
-        else
-                len = strlen(enums);
-        strncpy(result, enums, len);
-        result[len] = '\0';
+        strcpy(result, g_ptr_array_index(table->names, value));
         return(0);
 }
 
@@ -591,6 +622,10 @@ void            soap_close(SOAP_CON *connection)
         }
 
         /* Free our OA SOAP connection data structure */
+        soap_stream_free(connection);
+        if (connection->stream_items) {
+                g_ptr_array_free(connection->stream_items, TRUE);
+        }
         if (connection->doc) {
                 xmlFreeDoc(connection->doc);
         }
@@ -613,6 +648,89 @@ void            soap_close(SOAP_CON *connection)
 }
 
 
+/**
+ * soap_stream_free
+ * @connection: OA SOAP connection provided by soap_open()
+ *
+ * Frees the records and the unlinked nodes of the last streamed response.
+ * The nodes use the dictionary of the document, so this must be done
+ * before the document is freed.
+ *
+ * Return value: (none)
+ **/
+static void     soap_stream_free(SOAP_CON *connection)
+{
+        GSList  *node;
+        guint   i;
+
+        if (connection->stream_items) {
+                for (i = 0; i < connection->stream_items->len; i++) {
+                        g_free(g_ptr_array_index(connection->stream_items, i));
+                }
+                g_ptr_array_set_size(connection->stream_items, 0);
+        }
+        for (node = connection->stream_nodes; node; node = node->next) {
+                xmlFreeNode((xmlNode *) node->data);
+        }
+        g_slist_free(connection->stream_nodes);
+        connection->stream_nodes = NULL;
+}
+
+
+/**
+ * soap_stream_end
+ * @ctx:        XML parser context
+ * @localname:  name of the element
+ * @prefix:     namespace prefix of the element
+ * @URI:        namespace URI of the element
+ *
+ * SAX end element handler.  Builds the document like the default handler,
+ * and decodes the elements named by stream_name of the connection as soon
+ * as they are complete.
+ *
+ * Return value: (none)
+ **/
+static void     soap_stream_end(void *ctx,
+                                const xmlChar *localname,
+                                const xmlChar *prefix,
+                                const xmlChar *URI)
+{
+        xmlParserCtxtPtr parse = (xmlParserCtxtPtr) ctx;
+        SOAP_CON        *connection = (SOAP_CON *) parse->_private;
+        xmlNode         *node = parse->node;
+        xmlNode         *parent;
+        xmlNode         *text;
+        gpointer        item;
+
+        xmlSAX2EndElementNs(ctx, localname, prefix, URI);
+
+        if ((! node) || (! connection->stream_name) ||
+            strcmp((const char *) localname, connection->stream_name)) {
+                return;
+        }
+
+        parent = node->parent;
+        xmlUnlinkNode(node);
+        connection->stream_nodes = g_slist_prepend(connection->stream_nodes,
+                                                   node);
+
+        /* The parser would append the text that follows to the whitespace
+         * before the element, using its state for the text inside the
+         * element.  The whitespace is not needed, so drop it.
+         */
+        while (parent && parent->last &&
+               (parent->last->type == XML_TEXT_NODE)) {
+                text = parent->last;
+                xmlUnlinkNode(text);
+                xmlFreeNode(text);
+        }
+        item = connection->stream_fn(node);
+        if (item) {
+                g_ptr_array_add(connection->stream_items, item);
+        }
+}
+
+
 /**
  * soap_message
  * @connection: OA SOAP connection provided by soap_open()
@@ -637,6 +755,7 @@ static int      soap_message(SOAP_CON *connection, char *request,
         char *          header=NULL;                              
         char            response[OA_SOAP_RESP_BUFFER_SIZE];
         xmlParserCtxtPtr parse = NULL;
+        xmlSAXHandler   sax;
 
         /* Error checking */
         if (! connection) {
@@ -735,12 +854,36 @@ static int      soap_message(SOAP_CON *connection, char *request,
         }
         response[nbytes] = '\0';
         dbg("OA response(1):\n%s\n", response);
-        parse = xmlCreatePushParserCtxt(NULL, NULL, response, nbytes, NULL);
+        if (connection->stream_name) {
+                /* Default handlers, apart from the end of elements */
+                memset(&sax, 0, sizeof(sax));
+                xmlSAXVersion(&sax, 2);
+                sax.endElementNs = soap_stream_end;
+                if (! connection->stream_items) {
+                        connection->stream_items = g_ptr_array_new();
+                }
+                parse = xmlCreatePushParserCtxt(&sax, NULL, NULL, 0, NULL);
+        }
+        else {
+                parse = xmlCreatePushParserCtxt(NULL, NULL, NULL, 0, NULL);
+        }
         if (! parse) {
                 (void) oh_ssl_disconnect(connection->bio, OH_SSL_BI);
                 err("failed to create XML push parser context");
                 return(-1);
         }
+        parse->_private = connection;
+        /* Short text values, which are most of the response, are stored
+         * in the nodes themselves instead of separate allocations.
+         */
+        xmlCtxtUseOptions(parse, XML_PARSE_COMPACT);
+        ret = xmlParseChunk(parse, response, nbytes, 0);
+        if (ret) {
+                err("xmlParseChunk() failed with error %d", ret);
+                (void) oh_ssl_disconnect(connection->bio, OH_SSL_BI);
+                xmlFreeParserCtxt(parse);
+                return(-1);
+        }
 
         /* Remaining chunks */
         while ((nbytes = oh_ssl_read(connection->bio,
@@ -1080,6 +1223,7 @@ int             soap_call(SOAP_CON *connection)
                         /* First, we need to free any previously-used XML
                          * memory
                          */
+                        soap_stream_free(connection);
                         if (connection->doc) {
                                 xmlFreeDoc(connection->doc);
                                 connection->doc = NULL;
@@ -42,6 +42,7 @@
 
 
 /* Include files */
+#include <glib.h>
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <oh_ssl.h>
@@ -166,6 +167,12 @@
 
 
 /* Data structures */
+
+/* Decodes an element of a streamed response, see soap_con.stream_name.
+ * Returns a record allocated with g_malloc(), or NULL to skip it.
+ */
+typedef gpointer (*soap_stream_fn)(xmlNode *node);
+
 struct soap_con {
     SSL_CTX     *ctx;
     BIO         *bio;
@@ -177,6 +184,17 @@ struct soap_con {
     xmlDocPtr   doc;                    /* We keep this here so that memory can
                                          * be freed during the next call
                                          */
+    const char  *stream_name;           /* Elements with this name are
+                                         * decoded with stream_fn as soon
+                                         * as they are parsed, and are
+                                         * unlinked from doc
+                                         */
+    soap_stream_fn stream_fn;
+    GPtrArray   *stream_items;          /* Decoded records, freed with
+                                         * stream_nodes during the next
+                                         * call
+                                         */
+    GSList      *stream_nodes;
     char        req_buf[OA_SOAP_REQ_BUFFER_SIZE];
     int         req_high_water;
     int         ignore_errors;
@@ -270,7 +270,7 @@ gpointer oa_soap_event_thread(gpointer oa_pointer)
                         /* OA returns empty event response payload for LCD
                          * status change events. Ignore empty event response.
                          */
-                        if (response.eventInfoArray == NULL) {
+                        if (response.events->len == 0) {
                                 dbg("Ignoring empty event response");
                         } else
                                 process_oa_events(handler, oa, &response);
@@ -688,6 +688,7 @@ void process_oa_events(struct oh_handler_state *oh_handler,
                        struct getAllEventsResponse *response)
 {
         SaHpiInt32T loc=0;
+        guint i;
         struct eventInfo event;
         struct oa_soap_handler *oa_handler = NULL;
 
@@ -698,13 +699,16 @@ void process_oa_events(struct oh_handler_state *oh_handler,
 
         oa_handler = (struct oa_soap_handler *) oh_handler->data;
 
-        /* Extract the events from eventInfoArray */
-        while (response->eventInfoArray) {
+        /* Go through the events of the response */
+        for (i = 0; response->events && i < response->events->len; i++) {
         	OA_SOAP_CHEK_SHUTDOWN_REQ(oa_handler, NULL, NULL, NULL);
-                /* Get the event from eventInfoArray */
-                soap_getEventInfo(response->eventInfoArray, &event);
+                /* Get the event, it was decoded with the response */
+                event = *(struct eventInfo *)
+                        g_ptr_array_index(response->events, i);
 		dbg("\nThread id=%p event %d received\n",
 				g_thread_self(), event.event);
+                /* Keep the enclosure state mirror up to date */
+                oa_soap_mirror_proc_event(oa_handler->mirror, &event);
                 switch (event.event) {
                         case EVENT_HEARTBEAT:
                                 dbg("HEART BEAT EVENT");
@@ -1165,7 +1169,7 @@ void process_oa_events(struct oh_handler_state *oh_handler,
                         case EVENT_OA_REBOOT:
                                 dbg("EVENT_OA_REBOOT");
                                 process_oa_reboot_event(oh_handler, oa);
-                                response->eventInfoArray = NULL; 
+                                response->events = NULL;
                                 break;
                         case EVENT_OA_LOGOFF_REQUEST:
                                 dbg("EVENT_OA_LOGOFF_REQUEST -- Not processed");
@@ -1364,9 +1368,6 @@ void process_oa_events(struct oh_handler_state *oh_handler,
                                 dbg("EVENT NOT REGISTERED, Event id %d",
                                     event.event);
                 }
-                /* Get the next event from the eventInfoArray */
-                response->eventInfoArray =
-                        soap_next_node(response->eventInfoArray);
         }
 
         return;
@@ -0,0 +1,394 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * This file implements the enclosure state mirror of the oa_soap plugin.
+ *
+ * The mirror keeps the last known sensor readings of the enclosure
+ * components, so sensor reads do not need a SOAP call each.  Readings are
+ * stored when update_sensor_rdr() fetches them from the OA and when the
+ * event thread receives fan, power supply, power subsystem, thermal and
+ * blade status events.  A reading older than OA_Sensor_Max_Age seconds is
+ * not used, so the next read fetches it from the OA again.
+ *
+ *      oa_soap_mirror_new()            - Creates the mirror for a handler
+ *
+ *      oa_soap_mirror_free()           - Frees the mirror
+ *
+ *      oa_soap_mirror_flush()          - Drops all readings
+ *
+ *      oa_soap_mirror_set()            - Stores a reading
+ *
+ *      oa_soap_mirror_get()            - Returns a reading, if fresh
+ *
+ *      oa_soap_mirror_proc_event()     - Stores the readings of an OA event
+ */
+
+#include <stdlib.h>
+#include <time.h>
+#include <oh_error.h>
+#include <SaHpiOaSoap.h>
+#include "oa_soap_mirror.h"
+#include "sahpi_wrappers.h"
+
+struct oa_soap_mirror {
+        GMutex *mutex;
+        GHashTable *readings;           /* Key to struct oa_soap_mirror_val */
+        time_t max_age;
+};
+
+struct oa_soap_mirror_val {
+        guint64 key;
+        SaHpiFloat64T value;
+        time_t stamp;
+};
+
+/**
+ * oa_soap_mirror_key
+ *      @type: Entity type of the resource
+ *      @bay: Bay number of the resource
+ *      @num: Sensor number
+ *
+ * Purpose:
+ *      Builds the mirror key of a sensor reading
+ *
+ * Detailed Description:
+ *      - All the blade types share the key space, as blade events do not
+ *        carry the blade type
+ *      - Resources with one reading use sensor number 0, as
+ *        update_sensor_rdr() returns the same reading for all their sensors
+ *
+ * Return values:
+ *      The key
+ **/
+static guint64 oa_soap_mirror_key(SaHpiEntityTypeT type,
+                                  SaHpiInt32T bay,
+                                  SaHpiSensorNumT num)
+{
+        switch (type) {
+                case SAHPI_ENT_IO_BLADE:
+                case SAHPI_ENT_DISK_BLADE:
+                        type = SAHPI_ENT_SYSTEM_BLADE;
+                        break;
+                case SAHPI_ENT_SWITCH_BLADE:
+                case SAHPI_ENT_SYS_MGMNT_MODULE:
+                case SAHPI_ENT_SYSTEM_CHASSIS:
+                case SAHPI_ENT_POWER_SUPPLY:
+                        num = 0;
+                        break;
+                case SAHPI_ENT_POWER_MGMNT:
+                        bay = 0;
+                        break;
+                default:
+                        break;
+        }
+
+        return ((guint64)type << 32) |
+               ((guint64)(bay & 0xffff) << 16) |
+               (guint64)(num & 0xffff);
+}
+
+/**
+ * oa_soap_mirror_new
+ *      @handler_config: Handler configuration
+ *
+ * Purpose:
+ *      Creates the enclosure state mirror of a handler
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      Pointer to the mirror, or NULL if the mirror is disabled
+ **/
+struct oa_soap_mirror *oa_soap_mirror_new(GHashTable *handler_config)
+{
+        struct oa_soap_mirror *mirror = NULL;
+        const char *value = NULL;
+        long max_age = OA_SOAP_MIRROR_MAX_AGE_DEFAULT;
+
+        if (handler_config != NULL) {
+                value = (const char *) g_hash_table_lookup(handler_config,
+                                                OA_SOAP_MIRROR_MAX_AGE_PARAM);
+        }
+        if (value != NULL) {
+                max_age = strtol(value, NULL, 10);
+        }
+        if (max_age <= 0) {
+                dbg("OA SOAP enclosure state mirror is disabled");
+                return NULL;
+        }
+
+        mirror = g_new0(struct oa_soap_mirror, 1);
+        mirror->mutex = wrap_g_mutex_new_init();
+        mirror->readings = g_hash_table_new_full(g_int64_hash, g_int64_equal,
+                                                 NULL, g_free);
+        mirror->max_age = max_age;
+
+        return mirror;
+}
+
+/**
+ * oa_soap_mirror_free
+ *      @mirror: Pointer to the mirror
+ *
+ * Purpose:
+ *      Frees the enclosure state mirror
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      NONE
+ **/
+void oa_soap_mirror_free(struct oa_soap_mirror *mirror)
+{
+        if (mirror == NULL) {
+                return;
+        }
+
+        g_hash_table_destroy(mirror->readings);
+        wrap_g_mutex_free_clear(mirror->mutex);
+        g_free(mirror);
+}
+
+/**
+ * oa_soap_mirror_flush
+ *      @mirror: Pointer to the mirror
+ *
+ * Purpose:
+ *      Drops all the readings, so the next reads go to the OA
+ *
+ * Detailed Description:
+ *      - Used on re-discovery and when a component is removed
+ *
+ * Return values:
+ *      NONE
+ **/
+void oa_soap_mirror_flush(struct oa_soap_mirror *mirror)
+{
+        if (mirror == NULL) {
+                return;
+        }
+
+        wrap_g_mutex_lock(mirror->mutex);
+        g_hash_table_remove_all(mirror->readings);
+        wrap_g_mutex_unlock(mirror->mutex);
+}
+
+/**
+ * oa_soap_mirror_set
+ *      @mirror: Pointer to the mirror
+ *      @type: Entity type of the resource
+ *      @bay: Bay number of the resource
+ *      @num: Sensor number
+ *      @value: Sensor reading
+ *
+ * Purpose:
+ *      Stores a sensor reading
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      NONE
+ **/
+void oa_soap_mirror_set(struct oa_soap_mirror *mirror,
+                        SaHpiEntityTypeT type,
+                        SaHpiInt32T bay,
+                        SaHpiSensorNumT num,
+                        SaHpiFloat64T value)
+{
+        struct oa_soap_mirror_val *val = NULL;
+        guint64 key;
+
+        if (mirror == NULL) {
+                return;
+        }
+
+        key = oa_soap_mirror_key(type, bay, num);
+
+        wrap_g_mutex_lock(mirror->mutex);
+        val = (struct oa_soap_mirror_val *)
+                g_hash_table_lookup(mirror->readings, &key);
+        if (val == NULL) {
+                val = g_new0(struct oa_soap_mirror_val, 1);
+                val->key = key;
+                g_hash_table_insert(mirror->readings, &val->key, val);
+        }
+        val->value = value;
+        val->stamp = time(NULL);
+        wrap_g_mutex_unlock(mirror->mutex);
+}
+
+/**
+ * oa_soap_mirror_get
+ *      @mirror: Pointer to the mirror
+ *      @type: Entity type of the resource
+ *      @bay: Bay number of the resource
+ *      @num: Sensor number
+ *      @value: Pointer to store the sensor reading
+ *
+ * Purpose:
+ *      Returns a sensor reading that is not older than the maximum age
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      SA_OK - on success.
+ *      SA_ERR_HPI_NOT_PRESENT - no fresh reading, or the mirror is disabled
+ **/
+SaErrorT oa_soap_mirror_get(struct oa_soap_mirror *mirror,
+                            SaHpiEntityTypeT type,
+                            SaHpiInt32T bay,
+                            SaHpiSensorNumT num,
+                            SaHpiFloat64T *value)
+{
+        struct oa_soap_mirror_val *val = NULL;
+        SaErrorT rv = SA_ERR_HPI_NOT_PRESENT;
+        guint64 key;
+        time_t now;
+
+        if (mirror == NULL || value == NULL) {
+                return SA_ERR_HPI_NOT_PRESENT;
+        }
+
+        key = oa_soap_mirror_key(type, bay, num);
+        now = time(NULL);
+
+        wrap_g_mutex_lock(mirror->mutex);
+        val = (struct oa_soap_mirror_val *)
+                g_hash_table_lookup(mirror->readings, &key);
+        /* A clock step backwards makes the reading stale, too */
+        if (val != NULL && now >= val->stamp &&
+            now - val->stamp < mirror->max_age) {
+                *value = val->value;
+                rv = SA_OK;
+        }
+        wrap_g_mutex_unlock(mirror->mutex);
+
+        return rv;
+}
+
+/**
+ * oa_soap_mirror_proc_event
+ *      @mirror: Pointer to the mirror
+ *      @event: Pointer to the OA event
+ *
+ * Purpose:
+ *      Stores the sensor readings carried by an OA event
+ *
+ * Detailed Description:
+ *      - Called by the event thread for every event, before the event
+ *        is processed
+ *      - Removal of a component drops all the readings, as its bay can
+ *        be filled by a different component
+ *
+ * Return values:
+ *      NONE
+ **/
+void oa_soap_mirror_proc_event(struct oa_soap_mirror *mirror,
+                               struct eventInfo *event)
+{
+        struct fanInfo *fan = NULL;
+        struct powerSupplyInfo *ps = NULL;
+        struct powerSubsystemInfo *ps_sub = NULL;
+        struct thermalInfo *thermal = NULL;
+        struct bladeStatus *blade = NULL;
+
+        if (mirror == NULL || event == NULL) {
+                return;
+        }
+
+        switch (event->event) {
+                case EVENT_FAN_STATUS:
+                        fan = &(event->eventData.fanInfo);
+                        if (fan->presence != PRESENT) {
+                                break;
+                        }
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_FAN,
+                                           fan->bayNumber,
+                                           OA_SOAP_SEN_FAN_SPEED,
+                                           fan->maxFanSpeed);
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_FAN,
+                                           fan->bayNumber,
+                                           OA_SOAP_SEN_PWR_STATUS,
+                                           fan->powerConsumed);
+                        break;
+                case EVENT_PS_INFO:
+                        ps = &(event->eventData.powerSupplyInfo);
+                        if (ps->presence != PRESENT) {
+                                break;
+                        }
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_POWER_SUPPLY,
+                                           ps->bayNumber, 0,
+                                           ps->actualOutput);
+                        break;
+                case EVENT_PS_SUBSYSTEM_STATUS:
+                case EVENT_PS_REDUNDANT:
+                case EVENT_PS_OVERLOAD:
+                        ps_sub = &(event->eventData.powerSubsystemInfo);
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_POWER_MGMNT, 0,
+                                           OA_SOAP_SEN_IN_PWR,
+                                           ps_sub->inputPowerVa);
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_POWER_MGMNT, 0,
+                                           OA_SOAP_SEN_OUT_PWR,
+                                           ps_sub->outputPower);
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_POWER_MGMNT, 0,
+                                           OA_SOAP_SEN_PWR_STATUS,
+                                           ps_sub->powerConsumed);
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_POWER_MGMNT, 0,
+                                           OA_SOAP_SEN_PWR_CAPACITY,
+                                           ps_sub->capacity);
+                        break;
+                case EVENT_THERMAL_STATUS:
+                        thermal = &(event->eventData.thermalInfo);
+                        switch (thermal->sensorType) {
+                                case SENSOR_TYPE_INTERCONNECT:
+                                        oa_soap_mirror_set(mirror,
+                                                SAHPI_ENT_SWITCH_BLADE,
+                                                thermal->bayNumber, 0,
+                                                thermal->temperatureC);
+                                        break;
+                                case SENSOR_TYPE_OA:
+                                        oa_soap_mirror_set(mirror,
+                                                SAHPI_ENT_SYS_MGMNT_MODULE,
+                                                thermal->bayNumber, 0,
+                                                thermal->temperatureC);
+                                        break;
+                                case SENSOR_TYPE_ENC:
+                                        oa_soap_mirror_set(mirror,
+                                                SAHPI_ENT_SYSTEM_CHASSIS,
+                                                thermal->bayNumber, 0,
+                                                thermal->temperatureC);
+                                        break;
+                                default:
+                                        /* Blade thermal sensors are read
+                                         * as an array, not mirrored here
+                                         */
+                                        break;
+                        }
+                        break;
+                case EVENT_BLADE_STATUS:
+                        blade = &(event->eventData.bladeStatus);
+                        if (blade->presence != PRESENT) {
+                                break;
+                        }
+                        oa_soap_mirror_set(mirror, SAHPI_ENT_SYSTEM_BLADE,
+                                           blade->bayNumber,
+                                           OA_SOAP_SEN_PWR_STATUS,
+                                           blade->powerConsumed);
+                        break;
+                case EVENT_FAN_REMOVED:
+                case EVENT_PS_REMOVED:
+                case EVENT_INTERCONNECT_REMOVED:
+                case EVENT_BLADE_REMOVED:
+                case EVENT_OA_REMOVED:
+                        oa_soap_mirror_flush(mirror);
+                        break;
+                default:
+                        break;
+        }
+}
@@ -0,0 +1,47 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef _OA_SOAP_MIRROR_H
+#define _OA_SOAP_MIRROR_H
+
+/* Include files */
+#include <glib.h>
+#include <SaHpi.h>
+#include "oa_soap_calls.h"
+
+/* Handler configuration parameter, in seconds. 0 disables the mirror */
+#define OA_SOAP_MIRROR_MAX_AGE_PARAM "OA_Sensor_Max_Age"
+#define OA_SOAP_MIRROR_MAX_AGE_DEFAULT 5
+
+struct oa_soap_mirror;
+
+struct oa_soap_mirror *oa_soap_mirror_new(GHashTable *handler_config);
+
+void oa_soap_mirror_free(struct oa_soap_mirror *mirror);
+
+void oa_soap_mirror_flush(struct oa_soap_mirror *mirror);
+
+void oa_soap_mirror_set(struct oa_soap_mirror *mirror,
+                        SaHpiEntityTypeT type,
+                        SaHpiInt32T bay,
+                        SaHpiSensorNumT num,
+                        SaHpiFloat64T value);
+
+SaErrorT oa_soap_mirror_get(struct oa_soap_mirror *mirror,
+                            SaHpiEntityTypeT type,
+                            SaHpiInt32T bay,
+                            SaHpiSensorNumT num,
+                            SaHpiFloat64T *value);
+
+void oa_soap_mirror_proc_event(struct oa_soap_mirror *mirror,
+                               struct eventInfo *event);
+
+#endif
@@ -162,7 +162,8 @@ SaErrorT process_oa_failover_event(struct oh_handler_state *oh_handler,
         struct oa_soap_handler *oa_handler = NULL;
         struct getAllEventsEx request;
         struct getAllEventsResponse response;
-        struct eventInfo event;
+        struct eventInfo *event;
+        guint i;
         GTimer *timer = NULL;
         gulong micro_seconds;
         gdouble time_elapsed = 0;
@@ -256,23 +257,21 @@ SaErrorT process_oa_failover_event(struct oh_handler_state *oh_handler,
                 /* OA returns empty event response payload for LCD status
                  * change events.  Ignore empty event response.
                  */
-                if (response.eventInfoArray == NULL) {
+                if (response.events->len == 0) {
                         dbg("Ignoring empty event response");
                         time_elapsed = g_timer_elapsed(timer, &micro_seconds);
                         continue;
                 }
 
                 /* Check for transition complete event */
-                while (response.eventInfoArray) {
+                for (i = 0; i < response.events->len; i++) {
 			OA_SOAP_CHEK_SHUTDOWN_REQ(oa_handler, oa_handler->mutex,
 						  NULL, timer);
-                        soap_getEventInfo(response.eventInfoArray, &event);
-                        if (event.event == EVENT_OA_TRANSITION_COMPLETE) {
+                        event = g_ptr_array_index(response.events, i);
+                        if (event->event == EVENT_OA_TRANSITION_COMPLETE) {
                                 is_transition_complete = SAHPI_TRUE;
                                 break;
                         }
-                        response.eventInfoArray =
-                                soap_next_node(response.eventInfoArray);
                 }
                 /* Get the time (in seconds) since the timer has been started */
                 time_elapsed = g_timer_elapsed(timer, &micro_seconds);
@@ -165,6 +165,9 @@ SaErrorT oa_soap_re_discover_resources(struct oh_handler_state *oh_handler,
 
         oa_handler = (struct oa_soap_handler *) oh_handler->data;
 
+        /* Readings from before the re-discovery may be out of date */
+        oa_soap_mirror_flush(oa_handler->mirror);
+
 	/* Re-discovery is called by locking the OA handler mutex and oa_info
 	 * mutex. Hence on getting request to shutdown, pass the locked mutexes
 	 * for unlocking
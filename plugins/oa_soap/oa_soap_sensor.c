@@ -42,6 +42,9 @@
  *
  *      oa_soap_get_sensor_reading()    - Gets the sensor reading of resource
  *
+ *      oa_soap_get_sensor_readings()   - Gets the readings of several sensors
+ *                                        of resource
+ *
  *      oa_soap_get_sensor_thresholds() - Retreives sensor's threshold values,
  *                                        if defined
  *
@@ -234,6 +237,188 @@ SaErrorT oa_soap_get_sensor_reading(void *oh_handler,
         return SA_OK;
 }
 
+/**
+ * oa_soap_get_sensor_readings
+ *      @oh_handler: Handler data pointer
+ *      @resource_id: Resource ID
+ *      @num_sensors: Number of sensors
+ *      @rdr_nums: Sensor rdr numbers
+ *      @data: Array for receiving sensor reading values
+ *      @state: Array for receiving sensor event states
+ *      @results: Array for receiving the result for every sensor
+ *
+ * Purpose:
+ *      Gets the readings of several sensors of the resource
+ *
+ * Detailed Description:
+ *      - The blade thermal sensors are read from one
+ *        getBladeThermalInfoArray soap call instead of one call
+ *        per sensor
+ *      - All other sensors are read by oa_soap_get_sensor_reading
+ *
+ * Return values:
+ *      SA_OK - Normal case, the result for every sensor is in results
+ *      SA_ERR_HPI_INVALID_PARAMS - On wrong parameters
+ *      SA_ERR_HPI_INVALID_RESOURCE - Invalid resource id specified
+ *      SA_ERR_HPI_CAPABILITY - Resource doesn't have SAHPI_CAPABILITY_SENSOR
+ **/
+SaErrorT oa_soap_get_sensor_readings(void *oh_handler,
+                                     SaHpiResourceIdT resource_id,
+                                     SaHpiUint32T num_sensors,
+                                     const SaHpiSensorNumT *rdr_nums,
+                                     SaHpiSensorReadingT *data,
+                                     SaHpiEventStateT *state,
+                                     SaErrorT *results)
+{
+        SaErrorT rv = SA_OK;
+        struct oh_handler_state *handler = NULL;
+        struct oa_soap_handler *oa_handler = NULL;
+        struct oa_soap_sensor_info *sensor_info = NULL;
+        struct getBladeThermalInfoArray blade_thermal_request;
+        struct bladeThermalInfoArrayResponse blade_thermal_response;
+        struct bladeThermalInfo blade_thermal_info;
+        SaHpiBoolT blade = SAHPI_FALSE;
+        SaErrorT thermal_rv = SA_ERR_HPI_NOT_PRESENT;
+        SaHpiRptEntryT *rpt = NULL;
+        SaHpiRdrT *rdr = NULL;
+        SaHpiSensorNumT rdr_num;
+        SaHpiUint32T i;
+
+        if (oh_handler == NULL || rdr_nums == NULL || data == NULL ||
+            state == NULL || results == NULL) {
+                err("Invalid parameters");
+                return SA_ERR_HPI_INVALID_PARAMS;
+        }
+
+        handler = (struct oh_handler_state *) oh_handler;
+        oa_handler = (struct oa_soap_handler *) handler->data;
+        rv = lock_oa_soap_handler(oa_handler);
+        if (rv != SA_OK) {
+                err("OA SOAP handler is locked");
+                return rv;
+        }
+
+        rpt = oh_get_resource_by_id(handler->rptcache, resource_id);
+        if (rpt == NULL) {
+                err("INVALID RESOURCE");
+                return SA_ERR_HPI_INVALID_RESOURCE;
+        }
+
+        if (! (rpt->ResourceCapabilities & SAHPI_CAPABILITY_SENSOR)) {
+                err("INVALID RESOURCE CAPABILITY");
+                return SA_ERR_HPI_CAPABILITY;
+        }
+
+        switch (rpt->ResourceEntity.Entry[0].EntityType) {
+                case (SAHPI_ENT_SYSTEM_BLADE):
+                case (SAHPI_ENT_IO_BLADE):
+                case (SAHPI_ENT_DISK_BLADE):
+                        blade = SAHPI_TRUE;
+                        break;
+                default:
+                        break;
+        }
+        blade_thermal_request.bayNumber =
+                rpt->ResourceEntity.Entry[0].EntityLocation;
+
+        for (i = 0; i < num_sensors; i++) {
+                rdr_num = rdr_nums[i];
+                if ((blade == SAHPI_FALSE) ||
+                    ((rdr_num != OA_SOAP_SEN_TEMP_STATUS) &&
+                     ((rdr_num < OA_SOAP_BLD_THRM_SEN_START) ||
+                      (rdr_num > OA_SOAP_BLD_THRM_SEN_END)))) {
+                        results[i] = oa_soap_get_sensor_reading(oh_handler,
+                                                                resource_id,
+                                                                rdr_num,
+                                                                &data[i],
+                                                                &state[i]);
+                        continue;
+                }
+
+                /* Blade thermal sensor, the checks are the same as in
+                 * oa_soap_get_sensor_reading
+                 */
+                rdr = oh_get_rdr_by_type(handler->rptcache,
+                                         resource_id,
+                                         SAHPI_SENSOR_RDR,
+                                         rdr_num);
+                if (rdr == NULL) {
+                        results[i] = SA_ERR_HPI_NOT_PRESENT;
+                        continue;
+                }
+                sensor_info = (struct oa_soap_sensor_info*)
+                        oh_get_rdr_data(handler->rptcache, resource_id,
+                                        rdr->RecordId);
+                if (sensor_info == NULL) {
+                        results[i] = SA_ERR_HPI_INTERNAL_ERROR;
+                        continue;
+                }
+                if (sensor_info->sensor_enable == SAHPI_FALSE) {
+                        results[i] = SA_ERR_HPI_NOT_PRESENT;
+                        continue;
+                }
+                if (rdr->RdrTypeUnion.SensorRec.DataFormat.IsSupported ==
+                    SAHPI_FALSE) {
+                        data[i].IsSupported = SAHPI_FALSE;
+                        state[i] = sensor_info->current_state;
+                        results[i] = SA_OK;
+                        continue;
+                }
+
+                if (oa_soap_mirror_get(oa_handler->mirror,
+                                       rpt->ResourceEntity.Entry[0].EntityType,
+                                       blade_thermal_request.bayNumber,
+                                       rdr_num, &data[i].Value.SensorFloat64)
+                    == SA_OK) {
+                        data[i].IsSupported = SAHPI_TRUE;
+                        data[i].Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+                        state[i] = sensor_info->current_state;
+                        results[i] = SA_OK;
+                        continue;
+                }
+
+                /* Fetch the thermal info array once for all sensors */
+                if (thermal_rv == SA_ERR_HPI_NOT_PRESENT) {
+                        rv = soap_getBladeThermalInfoArray(
+                                                oa_handler->active_con,
+                                                &blade_thermal_request,
+                                                &blade_thermal_response);
+                        if (rv != SOAP_OK) {
+                                err("Get blade's thermal info failed");
+                                thermal_rv = SA_ERR_HPI_INTERNAL_ERROR;
+                        } else {
+                                thermal_rv = SA_OK;
+                        }
+                }
+                if (thermal_rv != SA_OK) {
+                        results[i] = thermal_rv;
+                        continue;
+                }
+
+                rv = oa_soap_get_bld_thrm_sen_data(rdr_num,
+                                                   blade_thermal_response,
+                                                   &blade_thermal_info);
+                if (rv != SA_OK) {
+                        err("Could not find the matching"
+                            " sensors info from blade");
+                        results[i] = rv;
+                        continue;
+                }
+
+                data[i].IsSupported = SAHPI_TRUE;
+                data[i].Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+                data[i].Value.SensorFloat64 = blade_thermal_info.temperatureC;
+                oa_soap_mirror_set(oa_handler->mirror,
+                                   rpt->ResourceEntity.Entry[0].EntityType,
+                                   blade_thermal_request.bayNumber, rdr_num,
+                                   blade_thermal_info.temperatureC);
+                state[i] = sensor_info->current_state;
+                results[i] = SA_OK;
+        }
+
+        return SA_OK;
+}
+
 /**
  * oa_soap_get_sensor_thresholds
  *      @oh_handler: Handler data pointer
@@ -1002,8 +1187,11 @@ SaErrorT oa_soap_set_sensor_event_masks(void *oh_handler,
  *      Returns current status of the sensor RDR from resource
  *
  * Detailed Description:
- *      - Fetches current reading of the sensor from the resource
- *        by soap call and returns reading in sensor data
+ *      - Returns the reading from the enclosure state mirror, if it is
+ *        recent enough
+ *      - Otherwise fetches current reading of the sensor from the resource
+ *        by soap call, stores it in the mirror and returns reading in
+ *        sensor data
  *
  * Return values:
  *      SA_OK - Normal case
@@ -1035,6 +1223,8 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
         struct powerSupplyInfo *power_supply_response = NULL;
         struct powerSubsystemInfo ps_response;
         SaHpiInt32T location = -1;
+        SaHpiEntityTypeT type;
+        SaHpiFloat64T value;
 
         if (oh_handler == NULL || rpt == NULL || sensor_data == NULL) {
                 err("Invalid parameters");
@@ -1049,11 +1239,23 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
         fan_request.bayNumber = 
 	power_supply_request.bayNumber = 
 	blade_thermal_request.bayNumber = location;
+        type = rpt->ResourceEntity.Entry[0].EntityType;
+
+        /* Serve the reading from the enclosure state mirror, if it is
+         * recent enough
+         */
+        if (oa_soap_mirror_get(oa_handler->mirror, type, location,
+                               rdr_num, &value) == SA_OK) {
+                sensor_data->data.IsSupported = SAHPI_TRUE;
+                sensor_data->data.Type = SAHPI_SENSOR_READING_TYPE_FLOAT64;
+                sensor_data->data.Value.SensorFloat64 = value;
+                return SA_OK;
+        }
 
         /* Getting the current reading of the sensor directly from resource
          * using a soap call
          */
-        switch (rpt->ResourceEntity.Entry[0].EntityType) {
+        switch (type) {
                 case (SAHPI_ENT_SYSTEM_BLADE):
                 case (SAHPI_ENT_IO_BLADE):
                 case (SAHPI_ENT_DISK_BLADE):
@@ -1092,6 +1294,9 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                         SAHPI_SENSOR_READING_TYPE_FLOAT64;
                                 sensor_data->data.Value.SensorFloat64 =
                                         blade_thermal_info.temperatureC;
+                                oa_soap_mirror_set(oa_handler->mirror, type,
+                                        location, rdr_num,
+                                        blade_thermal_info.temperatureC);
                         }
                         else if (rdr_num == OA_SOAP_SEN_PWR_STATUS) {
 
@@ -1110,6 +1315,9 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                         SAHPI_SENSOR_READING_TYPE_FLOAT64;
                                 sensor_data->data.Value.SensorFloat64 =
                                         server_status_response.powerConsumed;
+                                oa_soap_mirror_set(oa_handler->mirror, type,
+                                        location, rdr_num,
+                                        server_status_response.powerConsumed);
                         }
                         break;
                 case (SAHPI_ENT_SWITCH_BLADE):
@@ -1129,6 +1337,9 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                 SAHPI_SENSOR_READING_TYPE_FLOAT64;
                         sensor_data->data.Value.SensorFloat64 =
                                 thermal_response.temperatureC;
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           rdr_num,
+                                           thermal_response.temperatureC);
                         break;
                 case (SAHPI_ENT_SYS_MGMNT_MODULE):
                         thermal_request.sensorType = SENSOR_TYPE_OA;
@@ -1147,6 +1358,9 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                 SAHPI_SENSOR_READING_TYPE_FLOAT64;
                         sensor_data->data.Value.SensorFloat64 =
                                 thermal_response.temperatureC;
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           rdr_num,
+                                           thermal_response.temperatureC);
                         break;
                 case (SAHPI_ENT_SYSTEM_CHASSIS):
                         thermal_request.sensorType = SENSOR_TYPE_ENC;
@@ -1165,6 +1379,9 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                 SAHPI_SENSOR_READING_TYPE_FLOAT64;
                         sensor_data->data.Value.SensorFloat64 =
                                 thermal_response.temperatureC;
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           rdr_num,
+                                           thermal_response.temperatureC);
                         break;
                 case (SAHPI_ENT_FAN):
 
@@ -1186,6 +1403,12 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                 sensor_data->data.Value.SensorFloat64 =
                                         fan_response.powerConsumed;
                         }
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           OA_SOAP_SEN_FAN_SPEED,
+                                           fan_response.maxFanSpeed);
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           OA_SOAP_SEN_PWR_STATUS,
+                                           fan_response.powerConsumed);
                         break;
                 case (SAHPI_ENT_POWER_MGMNT):
 
@@ -1214,6 +1437,18 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                 sensor_data->data.Value.SensorFloat64 =
                                         ps_response.capacity;
                         }
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           OA_SOAP_SEN_IN_PWR,
+                                           ps_response.inputPowerVa);
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           OA_SOAP_SEN_OUT_PWR,
+                                           ps_response.outputPower);
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           OA_SOAP_SEN_PWR_STATUS,
+                                           ps_response.powerConsumed);
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           OA_SOAP_SEN_PWR_CAPACITY,
+                                           ps_response.capacity);
                         break;
                 case (SAHPI_ENT_POWER_SUPPLY):
                         /* Fetching current actual power output info of
@@ -1241,6 +1476,9 @@ SaErrorT update_sensor_rdr(struct oh_handler_state *oh_handler,
                                 SAHPI_SENSOR_READING_TYPE_FLOAT64;
                         sensor_data->data.Value.SensorFloat64 =
                                 power_supply_response->actualOutput;
+                        oa_soap_mirror_set(oa_handler->mirror, type, location,
+                                           rdr_num,
+                                           power_supply_response->actualOutput);
                         wrap_g_free(power_supply_response);
                         break;
                 default:
@@ -2679,6 +2917,14 @@ void * oh_get_sensor_reading (void *, SaHpiResourceIdT,
                               SaHpiEventStateT    *)
                 __attribute__ ((weak, alias("oa_soap_get_sensor_reading")));
 
+void * oh_get_sensor_readings (void *, SaHpiResourceIdT,
+                               SaHpiUint32T,
+                               const SaHpiSensorNumT *,
+                               SaHpiSensorReadingT *,
+                               SaHpiEventStateT *,
+                               SaErrorT *)
+                __attribute__ ((weak, alias("oa_soap_get_sensor_readings")));
+
 void * oh_get_sensor_thresholds (void *, SaHpiResourceIdT,
                                  SaHpiSensorNumT,
                                  SaHpiSensorThresholdsT *)
@@ -264,6 +264,14 @@ SaErrorT oa_soap_get_sensor_reading(void *oh_handler,
                                    SaHpiSensorReadingT *data,
                                    SaHpiEventStateT    *state);
 
+SaErrorT oa_soap_get_sensor_readings(void *oh_handler,
+                                     SaHpiResourceIdT resource_id,
+                                     SaHpiUint32T num_sensors,
+                                     const SaHpiSensorNumT *rdr_nums,
+                                     SaHpiSensorReadingT *data,
+                                     SaHpiEventStateT *state,
+                                     SaErrorT *results);
+
 SaErrorT oa_soap_get_sensor_thresholds(void *oh_handler,
                                       SaHpiResourceIdT resource_id,
                                       SaHpiSensorNumT num,
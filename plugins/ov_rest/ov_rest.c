@@ -54,6 +54,7 @@
 
 #include "ov_rest.h"
 #include "ov_rest_utils.h"
+#include "ov_rest_scmb.h"
 #include "sahpi_wrappers.h"
 
 /**
@@ -240,6 +241,9 @@ void ov_rest_close(void *oh_handler)
 	if(ov_handler->thread_handler != NULL){
 		g_thread_join(ov_handler->thread_handler);
 	}
+	/* The listener is gone, stop the SCMB pipeline worker */
+	ov_rest_scmb_pool_free(ov_handler->scmb_pool);
+	ov_handler->scmb_pool = NULL;
 	ov_rest_clean_rptable(handler);
 	wrap_g_free(handler->rptcache);
 }
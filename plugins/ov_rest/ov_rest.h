@@ -150,6 +150,7 @@ struct ov_rest_handler
 	SaHpiInt32T max_current_rms_count;
 	SaHpiInt32T discover_called_count;
 	GHashTable *uri_rid;
+	struct ov_rest_scmb_pool *scmb_pool;
 	struct cert {
 		char fCaRoot[15];
 		char fSslKey[15];
@@ -57,6 +57,11 @@
  *      ov_rest_event_thread()          - handles the OV events and pushes the
  *                                        same into the framework queue
  *
+ *      ov_rest_scmb_listner()          - receives the SCMB messages and
+ *                                        pushes them to the SCMB pipeline
+ *                                        (ov_rest_scmb.c), acks the
+ *                                        messages it has processed
+ *
  *      process_ov_events()             - handles the ov events and calls
  *                                        correct handler function for
  *                                        different events
@@ -1413,7 +1418,13 @@ void ov_die_on_amqp_error(amqp_rpc_reply_t x, char const *context)
  *      in to single queue.And then these messages will get parsed and
  *      appropriate handler will be called to handle the alert/task.
  *
- * Detailed Description: NA
+ * Detailed Description:
+ *      - With the SCMB pipeline, the messages are pushed to its worker and
+ *        acked once processed. The broker prefetch bounds the messages
+ *        in flight
+ *      - Without it, the messages are auto-acked and processed here
+ *      - On a connection failure the pipeline is reset, the broker
+ *        redelivers the messages not acked yet
  *
  * Return values:
  *      SA_OK                     - on success.
@@ -1424,6 +1435,7 @@ void ov_die_on_amqp_error(amqp_rpc_reply_t x, char const *context)
 SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 {
 	struct ov_rest_handler *ov_handler = NULL;
+	struct ov_rest_scmb_pool *pool = NULL;
 	json_object *jobj = NULL, *scmb_resource = NULL;
 	int status = 0;
 	char *messages = NULL;
@@ -1431,9 +1443,11 @@ SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 	amqp_connection_state_t conn = {0};
 	amqp_bytes_t queuename;
 	struct timeval timeout = {0};
+	uint64_t delivery_tag = 0;
 	SaErrorT rv = SA_OK;
 
 	ov_handler = (struct ov_rest_handler *)handler->data;
+	pool = ov_handler->scmb_pool;
 	conn = amqp_new_connection();
 	if(!conn){
 		err("Error creating connection");
@@ -1478,6 +1492,12 @@ SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 				AMQP_EXTERNAL_PASSWORD), "Logging in");
 	amqp_channel_open(conn, 1);
 	ov_die_on_amqp_error(amqp_get_rpc_reply(conn), "Opening channel");
+	/* Messages are acked once processed, so the prefetch bounds the
+	 * messages queued in the pipeline */
+	if (pool != NULL) {
+		amqp_basic_qos(conn, 1, 0, ov_rest_scmb_pool_prefetch(pool), 0);
+		ov_die_on_amqp_error(amqp_get_rpc_reply(conn), "Setting QoS");
+	}
 	{
 		amqp_queue_declare_ok_t *r = amqp_queue_declare(conn, 1, 
 				amqp_empty_bytes, 
@@ -1501,8 +1521,8 @@ SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 			amqp_cstring_bytes(AMQP_TASKS_BINDINGKEY),
 			amqp_empty_table);
 	ov_die_on_amqp_error(amqp_get_rpc_reply(conn), "Binding queue");
-	amqp_basic_consume(conn, 1, queuename, amqp_empty_bytes, 0, 1, 0, 
-			amqp_empty_table);
+	amqp_basic_consume(conn, 1, queuename, amqp_empty_bytes, 0, 
+			(pool == NULL), 0, amqp_empty_table);
 	amqp_get_rpc_reply(conn);
 	while (1) {
 		amqp_rpc_reply_t res = {0};
@@ -1510,9 +1530,24 @@ SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 		amqp_maybe_release_buffers(conn);
 		OV_REST_CHEK_SHUTDOWN_REQ(ov_handler, NULL, NULL, NULL);
 
+		/* Ack the messages the worker is done with. Only this thread
+		 * may use the connection */
+		while (pool != NULL &&
+			ov_rest_scmb_pool_pop_done(pool, &delivery_tag)) {
+			if (amqp_basic_ack(conn, 1, delivery_tag, 0))
+				err("Failed to ack SCMB message %llu",
+					(unsigned long long) delivery_tag);
+		}
+
 		/* FIXME: res */
-		timeout.tv_sec = AMQP_CONSUME_TIMEOUT_SEC;
-		timeout.tv_usec = AMQP_CONSUME_TIMEOUT_USEC;
+		if (pool != NULL && ov_rest_scmb_pool_outstanding(pool)) {
+			/* Come back soon to ack what the worker completes */
+			timeout.tv_sec = 0;
+			timeout.tv_usec = AMQP_ACK_POLL_USEC;
+		} else {
+			timeout.tv_sec = AMQP_CONSUME_TIMEOUT_SEC;
+			timeout.tv_usec = AMQP_CONSUME_TIMEOUT_USEC;
+		}
 		res = amqp_consume_message(conn, &envelope, &timeout, 0);
 		switch(res.reply_type){
 			case AMQP_RESPONSE_NORMAL:
@@ -1525,6 +1560,9 @@ SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 				rv = ov_rest_amqp_err_handling(handler, 
 						res.library_error);
 				if(rv != SA_OK){
+					/* Unacked messages are redelivered 
+					 * on the next connection */
+					ov_rest_scmb_pool_reset(pool);
 					amqp_bytes_free(queuename);
 					amqp_channel_close(conn, 1, AMQP_REPLY_SUCCESS);
 					amqp_connection_close(conn, AMQP_REPLY_SUCCESS);
@@ -1556,10 +1594,16 @@ SaErrorT ov_rest_scmb_listner(struct oh_handler_state *handler)
 		memcpy(messages, (char *)envelope.message.body.bytes, 
 				envelope.message.body.len);
 		jobj = json_tokener_parse(messages);
-		scmb_resource = ov_rest_wrap_json_object_object_get(jobj, 
-				"resource");
-		process_ov_events(handler, scmb_resource);
-		ov_rest_wrap_json_object_put(jobj);
+		if (pool != NULL) {
+			/* The worker processes and frees jobj */
+			ov_rest_scmb_pool_push(pool, envelope.delivery_tag,
+					jobj);
+		} else {
+			scmb_resource = ov_rest_wrap_json_object_object_get(
+					jobj, "resource");
+			process_ov_events(handler, scmb_resource);
+			ov_rest_wrap_json_object_put(jobj);
+		}
 		wrap_g_free(messages);
 		amqp_destroy_envelope(&envelope);
 	}
@@ -1908,6 +1952,11 @@ gpointer ov_rest_event_thread(gpointer ov_pointer)
 			getallevents_doc);
 	ov_rest_wrap_json_object_put(event_response.root_jobj);
 	wrap_free(ov_handler->connection->url);
+	/* Events are processed by the SCMB pipeline worker. Without it, the
+	 * listener processes them inline */
+	if (ov_handler->scmb_pool == NULL) {
+		ov_handler->scmb_pool = ov_rest_scmb_pool_new(handler);
+	}
 	/* Listen for the events from OneView Synergy SCMB messages */
 	while(1){
 		OV_REST_CHEK_SHUTDOWN_REQ(ov_handler, NULL, NULL, NULL);
@@ -47,6 +47,7 @@
 #include "ov_rest_interconnect_event.h"
 #include "ov_rest_ps_event.h"
 #include "ov_rest_fan_event.h"
+#include "ov_rest_scmb.h"
 
 #define AMQP_USER "scmbadmin"
 #define AMQP_EXTERNAL_USER "guest"
@@ -57,6 +58,8 @@
 #define AMQP_TASKS_BINDINGKEY "scmb.tasks.#"
 #define AMQP_CONSUME_TIMEOUT_SEC 5
 #define AMQP_CONSUME_TIMEOUT_USEC 0
+/* Consume timeout while messages wait to be acked */
+#define AMQP_ACK_POLL_USEC 100000
 
 int ov_rest_get_event(void *oh_handler);
 int ov_rest_get_baynumber(const char *path);
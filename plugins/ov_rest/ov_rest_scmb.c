@@ -0,0 +1,466 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * This file implements the SCMB message pipeline of the ov_rest plugin.
+ *
+ * The SCMB listener only receives and parses the messages and pushes them
+ * to the pipeline.  A worker thread hands them to process_ov_events() in
+ * arrival order, so the REST calls made while processing an event do not
+ * hold up the AMQP connection.  The listener acknowledges a message once
+ * the worker is done with it, so messages not yet processed are
+ * redelivered by the broker after a connection loss.
+ *
+ * Task messages carry the whole task state.  A queued progress update of a
+ * task is dropped, and reported as done, when a newer message of the same
+ * task arrives.  Alerts are never dropped.
+ *
+ * There is one worker, as the event handlers share the REST connection
+ * and the RPT cache of the handler without locking.
+ *
+ *      ov_rest_scmb_pool_new()         - Creates the pipeline and its worker
+ *
+ *      ov_rest_scmb_pool_free()        - Stops the worker, frees the pipeline
+ *
+ *      ov_rest_scmb_pool_prefetch()    - Returns the configured prefetch
+ *
+ *      ov_rest_scmb_pool_push()        - Queues a message for the worker
+ *
+ *      ov_rest_scmb_pool_pop_done()    - Returns a delivery tag to ack
+ *
+ *      ov_rest_scmb_pool_outstanding() - Number of messages not yet acked
+ *
+ *      ov_rest_scmb_pool_reset()       - Drops the state of a lost connection
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <oh_error.h>
+#include "ov_rest_scmb.h"
+#include "ov_rest_event.h"
+#include "sahpi_wrappers.h"
+
+struct ov_rest_scmb_msg {
+	guint64 tag;
+	json_object *jobj;
+	json_object *resource;
+	char *task_uri;		/* Set for task messages */
+	gboolean transient;	/* Progress update, may be superseded */
+};
+
+struct ov_rest_scmb_pool {
+	struct oh_handler_state *oh_handler;
+	GThread *worker;
+	GMutex *mutex;
+	GCond *cond;
+	GQueue *queue;		/* struct ov_rest_scmb_msg, oldest first */
+	GHashTable *transient;	/* Task uri to its queued progress update */
+	GArray *done;		/* Delivery tags to ack */
+	guint prefetch;
+	gboolean busy;
+	gboolean stop;
+};
+
+/* Task states after which OneView sends no further update of a task */
+static const char *ov_rest_scmb_final_states[] = {
+	"Completed", "Error", "Warning", "Terminated", "Killed", NULL
+};
+
+/**
+ * ov_rest_scmb_msg_free
+ *      @msg: Pointer to the message
+ *
+ * Purpose:
+ *      Frees a message and the json document it holds
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      NONE
+ **/
+static void ov_rest_scmb_msg_free(struct ov_rest_scmb_msg *msg)
+{
+	if (msg->jobj != NULL)
+		ov_rest_wrap_json_object_put(msg->jobj);
+	wrap_g_free(msg->task_uri);
+	g_free(msg);
+}
+
+/**
+ * ov_rest_scmb_classify
+ *      @msg: Pointer to the message
+ *
+ * Purpose:
+ *      Fills the coalescing fields of a task message
+ *
+ * Detailed Description:
+ *      - A task message is identified by the "uri" of the task
+ *      - It is transient while the task has not reached a final state and
+ *        is not 100% complete, as the task handlers only act on completed
+ *        tasks
+ *
+ * Return values:
+ *      NONE
+ **/
+static void ov_rest_scmb_classify(struct ov_rest_scmb_msg *msg)
+{
+	json_object *jval = NULL;
+	const char *state = NULL;
+	int i = 0;
+
+	jval = ov_rest_wrap_json_object_object_get(msg->resource, "category");
+	if (jval == NULL || strcmp(json_object_get_string(jval), "tasks"))
+		return;
+
+	jval = ov_rest_wrap_json_object_object_get(msg->resource, "uri");
+	if (jval == NULL || json_object_get_string(jval) == NULL)
+		return;
+	msg->task_uri = g_strdup(json_object_get_string(jval));
+
+	jval = ov_rest_wrap_json_object_object_get(msg->resource,
+						   "percentComplete");
+	if (jval != NULL && json_object_get_int(jval) >= 100)
+		return;
+
+	jval = ov_rest_wrap_json_object_object_get(msg->resource, "taskState");
+	if (jval == NULL || (state = json_object_get_string(jval)) == NULL)
+		return;
+	for (i = 0; ov_rest_scmb_final_states[i] != NULL; i++) {
+		if (!strcmp(state, ov_rest_scmb_final_states[i]))
+			return;
+	}
+	msg->transient = TRUE;
+}
+
+/**
+ * ov_rest_scmb_worker
+ *      @data: Pointer to the pipeline
+ *
+ * Purpose:
+ *      Processes the queued messages in arrival order
+ *
+ * Detailed Description:
+ *      - The pipeline lock is not held while processing, so the listener
+ *        can keep queueing and coalescing
+ *      - process_ov_events() exits this thread on a shutdown request
+ *
+ * Return values:
+ *      NULL
+ **/
+static gpointer ov_rest_scmb_worker(gpointer data)
+{
+	struct ov_rest_scmb_pool *pool = (struct ov_rest_scmb_pool *)data;
+	struct ov_rest_scmb_msg *msg = NULL;
+
+	wrap_g_mutex_lock(pool->mutex);
+	while (1) {
+		while (!pool->stop && g_queue_is_empty(pool->queue))
+			g_cond_wait(pool->cond, pool->mutex);
+		if (pool->stop)
+			break;
+
+		msg = (struct ov_rest_scmb_msg *)g_queue_pop_head(pool->queue);
+		if (msg->transient)
+			g_hash_table_remove(pool->transient, msg->task_uri);
+		pool->busy = TRUE;
+		wrap_g_mutex_unlock(pool->mutex);
+
+		process_ov_events(pool->oh_handler, msg->resource);
+
+		wrap_g_mutex_lock(pool->mutex);
+		pool->busy = FALSE;
+		g_array_append_val(pool->done, msg->tag);
+		ov_rest_scmb_msg_free(msg);
+		g_cond_broadcast(pool->cond);
+	}
+	wrap_g_mutex_unlock(pool->mutex);
+
+	return NULL;
+}
+
+/**
+ * ov_rest_scmb_pool_new
+ *      @oh_handler: Pointer to the openhpi handler structure
+ *
+ * Purpose:
+ *      Creates the SCMB pipeline and starts its worker
+ *
+ * Detailed Description:
+ *      - The prefetch is read from the OV_SCMB_Prefetch handler parameter
+ *
+ * Return values:
+ *      Pointer to the pipeline - on success
+ *      NULL                    - on failure
+ **/
+struct ov_rest_scmb_pool *ov_rest_scmb_pool_new(
+				struct oh_handler_state *oh_handler)
+{
+	struct ov_rest_scmb_pool *pool = NULL;
+	char *value = NULL;
+	long prefetch = OV_REST_SCMB_PREFETCH_DEFAULT;
+
+	if (oh_handler == NULL) {
+		err("Invalid parameter");
+		return NULL;
+	}
+
+	value = (char *)g_hash_table_lookup(oh_handler->config,
+					    OV_REST_SCMB_PREFETCH_PARAM);
+	if (value != NULL) {
+		prefetch = strtol(value, NULL, 10);
+		if (prefetch < 1 || prefetch > OV_REST_SCMB_PREFETCH_MAX) {
+			err("Invalid %s value %s, using %d",
+			    OV_REST_SCMB_PREFETCH_PARAM, value,
+			    OV_REST_SCMB_PREFETCH_DEFAULT);
+			prefetch = OV_REST_SCMB_PREFETCH_DEFAULT;
+		}
+	}
+
+	pool = g_new0(struct ov_rest_scmb_pool, 1);
+	pool->oh_handler = oh_handler;
+	pool->prefetch = (guint)prefetch;
+	pool->mutex = wrap_g_mutex_new_init();
+	pool->cond = wrap_g_cond_new_init();
+	pool->queue = g_queue_new();
+	pool->transient = g_hash_table_new(g_str_hash, g_str_equal);
+	pool->done = g_array_new(FALSE, FALSE, sizeof(guint64));
+
+	pool->worker = wrap_g_thread_create_new("ov_rest_scmb_worker",
+						ov_rest_scmb_worker,
+						pool, TRUE, NULL);
+	if (pool->worker == NULL) {
+		err("wrap_g_thread_create_new failed");
+		ov_rest_scmb_pool_free(pool);
+		return NULL;
+	}
+
+	return pool;
+}
+
+/**
+ * ov_rest_scmb_pool_free
+ *      @pool: Pointer to the pipeline
+ *
+ * Purpose:
+ *      Stops the worker and frees the pipeline
+ *
+ * Detailed Description:
+ *      - Must be called after the SCMB listener has stopped
+ *
+ * Return values:
+ *      NONE
+ **/
+void ov_rest_scmb_pool_free(struct ov_rest_scmb_pool *pool)
+{
+	if (pool == NULL)
+		return;
+
+	if (pool->worker != NULL) {
+		wrap_g_mutex_lock(pool->mutex);
+		pool->stop = TRUE;
+		g_cond_broadcast(pool->cond);
+		wrap_g_mutex_unlock(pool->mutex);
+		g_thread_join(pool->worker);
+	}
+
+	g_hash_table_destroy(pool->transient);
+	g_queue_foreach(pool->queue, (GFunc)ov_rest_scmb_msg_free, NULL);
+	g_queue_free(pool->queue);
+	g_array_free(pool->done, TRUE);
+	wrap_g_cond_free(pool->cond);
+	wrap_g_mutex_free_clear(pool->mutex);
+	g_free(pool);
+}
+
+/**
+ * ov_rest_scmb_pool_prefetch
+ *      @pool: Pointer to the pipeline
+ *
+ * Purpose:
+ *      Returns the number of unacknowledged messages the broker may send
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      The prefetch count
+ **/
+guint ov_rest_scmb_pool_prefetch(struct ov_rest_scmb_pool *pool)
+{
+	return pool->prefetch;
+}
+
+/**
+ * ov_rest_scmb_pool_push
+ *      @pool: Pointer to the pipeline
+ *      @delivery_tag: AMQP delivery tag of the message
+ *      @jobj: Parsed message, owned by the pipeline from now on
+ *
+ * Purpose:
+ *      Queues a message for the worker
+ *
+ * Detailed Description:
+ *      - A message without "resource" is reported as done right away
+ *      - A queued progress update of the same task is dropped and reported
+ *        as done
+ *      - The queue is bounded by the broker prefetch, as every queued
+ *        message is still unacknowledged
+ *
+ * Return values:
+ *      NONE
+ **/
+void ov_rest_scmb_pool_push(struct ov_rest_scmb_pool *pool,
+			    guint64 delivery_tag,
+			    json_object *jobj)
+{
+	struct ov_rest_scmb_msg *msg = NULL, *old = NULL;
+	GList *link = NULL;
+
+	msg = g_new0(struct ov_rest_scmb_msg, 1);
+	msg->tag = delivery_tag;
+	msg->jobj = jobj;
+	if (jobj != NULL)
+		msg->resource = ov_rest_wrap_json_object_object_get(jobj,
+								    "resource");
+	if (msg->resource != NULL)
+		ov_rest_scmb_classify(msg);
+
+	wrap_g_mutex_lock(pool->mutex);
+	if (msg->resource == NULL) {
+		err("SCMB message %llu has no resource, ignoring it",
+		    (unsigned long long)delivery_tag);
+		g_array_append_val(pool->done, msg->tag);
+		wrap_g_mutex_unlock(pool->mutex);
+		ov_rest_scmb_msg_free(msg);
+		return;
+	}
+
+	if (msg->task_uri != NULL) {
+		link = (GList *)g_hash_table_lookup(pool->transient,
+						    msg->task_uri);
+	}
+	if (link != NULL) {
+		old = (struct ov_rest_scmb_msg *)link->data;
+		dbg("Task %s update %llu superseded by %llu", old->task_uri,
+		    (unsigned long long)old->tag,
+		    (unsigned long long)msg->tag);
+		g_hash_table_remove(pool->transient, old->task_uri);
+		g_queue_delete_link(pool->queue, link);
+		g_array_append_val(pool->done, old->tag);
+		ov_rest_scmb_msg_free(old);
+	}
+
+	g_queue_push_tail(pool->queue, msg);
+	if (msg->transient) {
+		g_hash_table_insert(pool->transient, msg->task_uri,
+				    g_queue_peek_tail_link(pool->queue));
+	}
+	g_cond_broadcast(pool->cond);
+	wrap_g_mutex_unlock(pool->mutex);
+}
+
+/**
+ * ov_rest_scmb_pool_pop_done
+ *      @pool: Pointer to the pipeline
+ *      @delivery_tag: Pointer to return the delivery tag
+ *
+ * Purpose:
+ *      Returns the delivery tag of a message the worker is done with
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      TRUE  - @delivery_tag is set and must be acknowledged
+ *      FALSE - nothing to acknowledge
+ **/
+gboolean ov_rest_scmb_pool_pop_done(struct ov_rest_scmb_pool *pool,
+				    guint64 *delivery_tag)
+{
+	gboolean found = FALSE;
+
+	wrap_g_mutex_lock(pool->mutex);
+	if (pool->done->len > 0) {
+		*delivery_tag = g_array_index(pool->done, guint64, 0);
+		g_array_remove_index(pool->done, 0);
+		found = TRUE;
+	}
+	wrap_g_mutex_unlock(pool->mutex);
+
+	return found;
+}
+
+/**
+ * ov_rest_scmb_pool_outstanding
+ *      @pool: Pointer to the pipeline
+ *
+ * Purpose:
+ *      Returns the number of messages pushed and not yet acknowledged
+ *
+ * Detailed Description: NA
+ *
+ * Return values:
+ *      The number of messages
+ **/
+guint ov_rest_scmb_pool_outstanding(struct ov_rest_scmb_pool *pool)
+{
+	guint count = 0;
+
+	wrap_g_mutex_lock(pool->mutex);
+	count = g_queue_get_length(pool->queue) + pool->done->len +
+		(pool->busy ? 1 : 0);
+	wrap_g_mutex_unlock(pool->mutex);
+
+	return count;
+}
+
+/**
+ * ov_rest_scmb_pool_reset
+ *      @pool: Pointer to the pipeline
+ *
+ * Purpose:
+ *      Drops the state tied to a closed AMQP connection
+ *
+ * Detailed Description:
+ *      - Queued messages are dropped, the broker redelivers them on the
+ *        next connection
+ *      - Waits for the message being processed, so the caller may touch
+ *        the RPT cache (re-discovery) once this returns.  The wait ends on
+ *        a shutdown request, as the worker then exits mid-message
+ *      - Pending delivery tags are dropped, they are not valid on another
+ *        connection
+ *
+ * Return values:
+ *      NONE
+ **/
+void ov_rest_scmb_pool_reset(struct ov_rest_scmb_pool *pool)
+{
+	struct ov_rest_handler *ov_handler = NULL;
+
+	if (pool == NULL)
+		return;
+
+	ov_handler = (struct ov_rest_handler *)pool->oh_handler->data;
+
+	wrap_g_mutex_lock(pool->mutex);
+	g_hash_table_remove_all(pool->transient);
+	g_queue_foreach(pool->queue, (GFunc)ov_rest_scmb_msg_free, NULL);
+	g_queue_clear(pool->queue);
+	while (pool->busy && ov_handler->shutdown_event_thread != SAHPI_TRUE) {
+#if GLIB_CHECK_VERSION (2, 32, 0)
+		gint64 time;
+		time = g_get_monotonic_time() + G_USEC_PER_SEC;
+		wrap_g_cond_timed_wait(pool->cond, pool->mutex, time);
+#else
+		GTimeVal time;
+		g_get_current_time(&time);
+		g_time_val_add(&time, G_USEC_PER_SEC);
+		wrap_g_cond_timed_wait(pool->cond, pool->mutex, &time);
+#endif
+	}
+	g_array_set_size(pool->done, 0);
+	wrap_g_mutex_unlock(pool->mutex);
+}
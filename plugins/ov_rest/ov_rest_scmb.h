@@ -0,0 +1,49 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef _OV_REST_SCMB_H
+#define _OV_REST_SCMB_H
+
+/* Include files */
+#include <glib.h>
+#include <SaHpi.h>
+#include <oh_handler.h>
+#include <json-c/json.h>
+
+/* Handler configuration parameter: number of unacknowledged SCMB messages
+ * the broker may hand to the plugin at once. This also bounds the queue
+ * between the SCMB consumer and the event processing worker.
+ */
+#define OV_REST_SCMB_PREFETCH_PARAM "OV_SCMB_Prefetch"
+#define OV_REST_SCMB_PREFETCH_DEFAULT 32
+#define OV_REST_SCMB_PREFETCH_MAX 1024
+
+struct ov_rest_scmb_pool;
+
+struct ov_rest_scmb_pool *ov_rest_scmb_pool_new(
+                                struct oh_handler_state *oh_handler);
+
+void ov_rest_scmb_pool_free(struct ov_rest_scmb_pool *pool);
+
+guint ov_rest_scmb_pool_prefetch(struct ov_rest_scmb_pool *pool);
+
+void ov_rest_scmb_pool_push(struct ov_rest_scmb_pool *pool,
+                            guint64 delivery_tag,
+                            json_object *jobj);
+
+gboolean ov_rest_scmb_pool_pop_done(struct ov_rest_scmb_pool *pool,
+                                    guint64 *delivery_tag);
+
+guint ov_rest_scmb_pool_outstanding(struct ov_rest_scmb_pool *pool);
+
+void ov_rest_scmb_pool_reset(struct ov_rest_scmb_pool *pool);
+
+#endif
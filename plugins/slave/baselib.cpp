@@ -568,6 +568,23 @@ bool cBaseLib::LoadBaseLib()
           reinterpret_cast<gpointer *>( &m_abi.oHpiDomainAdd ),
           nerrors );
 
+    // Optional functions
+    if ( g_module_symbol( m_handle,
+                          "oHpiEventsGet",
+                          reinterpret_cast<gpointer *>( &m_abi.oHpiEventsGet ) ) == FALSE ) {
+        m_abi.oHpiEventsGet = 0;
+    }
+    if ( g_module_symbol( m_handle,
+                          "oHpiEventLogEntriesGet",
+                          reinterpret_cast<gpointer *>( &m_abi.oHpiEventLogEntriesGet ) ) == FALSE ) {
+        m_abi.oHpiEventLogEntriesGet = 0;
+    }
+    if ( g_module_symbol( m_handle,
+                          "oHpiIdrGet",
+                          reinterpret_cast<gpointer *>( &m_abi.oHpiIdrGet ) ) == FALSE ) {
+        m_abi.oHpiIdrGet = 0;
+    }
+
     if ( nerrors != 0 ) {
         g_module_close( m_handle );
         m_handle = 0;
@@ -988,6 +988,50 @@ SaErrorT SAHPI_API (*oHpiDomainAddPtr)(
     SaHpiDomainIdT *domain_id
 );
 
+typedef
+SaErrorT SAHPI_API (*oHpiEventsGetPtr)(
+    SaHpiSessionIdT sid,
+    SaHpiTimeoutT Timeout,
+    SaHpiUint32T MaxEvents,
+    SaHpiUint32T MaxBytes,
+    SaHpiUint32T *NumberOfEvents,
+    SaHpiEventT *Events,
+    SaHpiRdrT *Rdrs,
+    SaHpiRptEntryT *RptEntries,
+    SaHpiEvtQueueStatusT *EventQueueStatus
+);
+
+typedef
+SaErrorT SAHPI_API (*oHpiEventLogEntriesGetPtr)(
+    SaHpiSessionIdT sid,
+    SaHpiResourceIdT rid,
+    SaHpiEventLogEntryIdT StartEntryId,
+    SaHpiUint32T MaxEntries,
+    SaHpiTimeT StartTime,
+    SaHpiTimeT EndTime,
+    SaHpiUint32T *NumberOfEntries,
+    SaHpiEventLogEntryT *Entries,
+    SaHpiRdrT *Rdrs,
+    SaHpiRptEntryT *RptEntries,
+    SaHpiEventLogEntryIdT *NextEntryId
+);
+
+typedef
+SaErrorT SAHPI_API (*oHpiIdrGetPtr)(
+    SaHpiSessionIdT sid,
+    SaHpiResourceIdT rid,
+    SaHpiIdrIdT IdrId,
+    SaHpiEntryIdT StartAreaId,
+    SaHpiUint32T MaxAreas,
+    SaHpiUint32T MaxFields,
+    SaHpiIdrInfoT *IdrInfo,
+    SaHpiUint32T *NumberOfAreas,
+    SaHpiIdrAreaHeaderT *Areas,
+    SaHpiUint32T *NumberOfFields,
+    SaHpiIdrFieldT *Fields,
+    SaHpiEntryIdT *NextAreaId
+);
+
 
 namespace Slave {
 
@@ -1120,6 +1164,10 @@ struct BaseLibAbi
     saHpiResourcePowerStateGetPtr             saHpiResourcePowerStateGet;
     saHpiResourcePowerStateSetPtr             saHpiResourcePowerStateSet;
     oHpiDomainAddPtr                          oHpiDomainAdd;
+    // optional, 0 if the base library does not provide it
+    oHpiEventsGetPtr                          oHpiEventsGet;
+    oHpiEventLogEntriesGetPtr                 oHpiEventLogEntriesGet;
+    oHpiIdrGetPtr                             oHpiIdrGet;
 };
 
 
@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include <glib.h>
 
@@ -54,7 +55,8 @@ cHandler::cHandler( unsigned int id,
       m_eventq( eventq ),
       m_stop( false ),
       m_thread( 0 ),
-      m_startup_discovery_status( StartupDiscoveryUncompleted )
+      m_startup_discovery_status( StartupDiscoveryUncompleted ),
+      m_batch_events( false )
 {
     m_host.DataType = SAHPI_TL_TYPE_TEXT;
     m_host.Language = SAHPI_LANG_UNDEF;
@@ -224,6 +226,8 @@ bool cHandler::OpenSession()
     }
 
     m_sid = sid;
+    // The slave daemon may be older than the base library
+    m_batch_events = ( Abi()->oHpiEventsGet != 0 );
 
     return true;
 }
@@ -241,6 +245,7 @@ bool cHandler::CloseSession()
         CRIT( "saHpiSessionClose failed with rv = %d", rv );
     }
     m_sid = InvalidSessionId;
+    DropPendingEvents();
 
     return true;
 }
@@ -293,36 +298,107 @@ void cHandler::RemoveAllResources()
 
 bool cHandler::ReceiveEvent( struct oh_event *& e )
 {
-    e = g_new0( struct oh_event, 1 );
-    SaHpiRdrT * rdr = g_new0( SaHpiRdrT, 1 );
-    e->rdrs = g_slist_append( e->rdrs, rdr );
-
-    SaErrorT rv = Abi()->saHpiEventGet( m_sid,
-                                        GetEventTimeout,
-                                        &e->event,
-                                        rdr,
-                                        &e->resource,
-                                        0 );
+    e = 0;
+
+    if ( m_pending_events.empty() ) {
+        bool rc = ReceiveEvents();
+        if ( !rc ) {
+            return false;
+        }
+    }
+    if ( !m_pending_events.empty() ) {
+        e = m_pending_events.front();
+        m_pending_events.pop();
+    }
+
+    return true;
+}
+
+bool cHandler::ReceiveEvents()
+{
+    SaErrorT rv;
+
+    if ( m_batch_events ) {
+        std::vector<SaHpiEventT> events( GetEventBatchSize );
+        std::vector<SaHpiRdrT> rdrs( GetEventBatchSize );
+        std::vector<SaHpiRptEntryT> rptes( GetEventBatchSize );
+        SaHpiUint32T n = 0;
+
+        rv = Abi()->oHpiEventsGet( m_sid,
+                                   GetEventTimeout,
+                                   GetEventBatchSize,
+                                   0,
+                                   &n,
+                                   &events[0],
+                                   &rdrs[0],
+                                   &rptes[0],
+                                   0 );
+        if ( rv == SA_OK ) {
+            for ( SaHpiUint32T i = 0; i < n; ++i ) {
+                struct oh_event * e = MakeEvent( events[i], rdrs[i], rptes[i] );
+                if ( e ) {
+                    m_pending_events.push( e );
+                }
+            }
+            return true;
+        }
+        if ( rv != SA_ERR_HPI_UNSUPPORTED_API ) {
+            if ( rv != SA_ERR_HPI_TIMEOUT ) {
+                CRIT( "oHpiEventsGet failed with rv = %d", rv );
+                return false;
+            }
+            return true;
+        }
+        // The slave daemon does not know oHpiEventsGet
+        DBG( "oHpiEventsGet is not supported, using saHpiEventGet" );
+        m_batch_events = false;
+    }
+
+    SaHpiEventT event;
+    SaHpiRdrT rdr;
+    SaHpiRptEntryT rpte;
+
+    rv = Abi()->saHpiEventGet( m_sid, GetEventTimeout, &event, &rdr, &rpte, 0 );
     if ( rv != SA_OK ) {
-        oh_event_free( e, 0 );
-        e = 0;
         if ( rv != SA_ERR_HPI_TIMEOUT ) {
             CRIT( "saHpiEventGet failed with rv = %d", rv );
             return false;
         }
         return true;
     }
-    if ( !IsRdrValid( *rdr ) ) {
-        oh_event_free( e, 1 );
-        e->rdrs = 0;
+    struct oh_event * e = MakeEvent( event, rdr, rpte );
+    if ( e ) {
+        m_pending_events.push( e );
+    }
+
+    return true;
+}
+
+void cHandler::DropPendingEvents()
+{
+    while( !m_pending_events.empty() ) {
+        oh_event_free( m_pending_events.front(), 0 );
+        m_pending_events.pop();
     }
+}
+
+struct oh_event * cHandler::MakeEvent( const SaHpiEventT& event,
+                                       const SaHpiRdrT& rdr,
+                                       const SaHpiRptEntryT& rpte ) const
+{
     // We do not pass Domain Event to the Master OpenHPI daemon
-    if ( e->event.EventType == SAHPI_ET_DOMAIN ) {
-        oh_event_free( e, 0 );
-        e = 0;
+    if ( event.EventType == SAHPI_ET_DOMAIN ) {
+        return 0;
     }
 
-    return true;
+    struct oh_event * e = g_new0( struct oh_event, 1 );
+    e->event    = event;
+    e->resource = rpte;
+    if ( IsRdrValid( rdr ) ) {
+        e->rdrs = g_slist_append( e->rdrs, g_memdup( &rdr, sizeof(SaHpiRdrT) ) );
+    }
+
+    return e;
 }
 
 void cHandler::HandleEvent( struct oh_event * e )
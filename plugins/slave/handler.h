@@ -82,6 +82,11 @@ private:
     void RemoveAllResources();
 
     bool ReceiveEvent( struct oh_event *& e );
+    bool ReceiveEvents();
+    void DropPendingEvents();
+    struct oh_event * MakeEvent( const SaHpiEventT& event,
+                                 const SaHpiRdrT& rdr,
+                                 const SaHpiRptEntryT& rpte ) const;
 
     void HandleEvent( struct oh_event * e );
 
@@ -105,6 +110,7 @@ private:
     static const SaHpiTimeoutT   OpenSessionRetryInterval     = 5000000000ULL;
     static const unsigned int    MaxFetchAttempts             = 42;
     static const SaHpiTimeoutT   GetEventTimeout              = 5000000000ULL;
+    static const SaHpiUint32T    GetEventBatchSize            = 64;
 
 
     enum eStartupDiscoveryStatus
@@ -126,6 +132,8 @@ private:
     volatile bool                    m_stop;
     GThread *                        m_thread;
     volatile eStartupDiscoveryStatus m_startup_discovery_status;
+    bool                             m_batch_events;
+    std::queue<struct oh_event *>    m_pending_events;
 };
 
 
@@ -368,6 +368,64 @@ oh_get_el_entry(
 }
 
 
+/**************************************************************
+ * slave_get_el_entries
+ *************************************************************/
+SaErrorT
+oh_get_el_entries(
+    void * hnd,
+    SaHpiResourceIdT id,
+    SaHpiEventLogEntryIdT current,
+    SaHpiUint32T max,
+    SaHpiUint32T * num,
+    SaHpiEventLogEntryT * entries,
+    SaHpiRdrT * rdrs,
+    SaHpiRptEntryT * rptes,
+    SaHpiEventLogEntryIdT * next )
+{
+    cHandler * handler = reinterpret_cast<cHandler *>(hnd);
+    SaErrorT rv;
+    SaHpiResourceIdT slave_id;
+
+    if ( !handler->Abi()->oHpiEventLogEntriesGet ) {
+        return SA_ERR_HPI_UNSUPPORTED_API;
+    }
+
+    GET_SLAVE( handler, id, slave_id );
+    CALL_ABI( handler,
+              oHpiEventLogEntriesGet,
+              rv,
+              slave_id,
+              current,
+              max,
+              SAHPI_TIME_UNSPECIFIED,
+              SAHPI_TIME_UNSPECIFIED,
+              num,
+              entries,
+              rdrs,
+              rptes,
+              next );
+
+    if ( rv == SA_OK ) {
+        const SaHpiEntityPathT& root = handler->GetRoot();
+        for ( SaHpiUint32T i = 0; i < *num; ++i ) {
+            SaHpiEventLogEntryT& entry = entries[i];
+            SaHpiResourceIdT master_src = handler->GetMaster( entry.Event.Source );
+            Slave::TranslateEvent( entry.Event, master_src );
+            if ( rdrs ) {
+                Slave::TranslateRdr( rdrs[i], root );
+            }
+            if ( rptes && Slave::IsRptEntryValid( rptes[i] ) ) {
+                SaHpiResourceIdT master_rpte = handler->GetMaster( rptes[i].ResourceId );
+                Slave::TranslateRptEntry( rptes[i], master_rpte, root );
+            }
+        }
+    }
+
+    return rv;
+}
+
+
 /**************************************************************
  * slave_clear_el
  *************************************************************/
@@ -911,6 +969,52 @@ oh_get_idr_field(
 }
 
 
+/**************************************************************
+ * slave_get_idr_all
+ *************************************************************/
+SaErrorT
+oh_get_idr_all(
+    void * hnd,
+    SaHpiResourceIdT id,
+    SaHpiIdrIdT idrid,
+    SaHpiEntryIdT areaid,
+    SaHpiUint32T max_areas,
+    SaHpiUint32T max_fields,
+    SaHpiIdrInfoT * idrinfo,
+    SaHpiUint32T * num_areas,
+    SaHpiIdrAreaHeaderT * areas,
+    SaHpiUint32T * num_fields,
+    SaHpiIdrFieldT * fields,
+    SaHpiEntryIdT * next )
+{
+    cHandler * handler = reinterpret_cast<cHandler *>(hnd);
+    SaErrorT rv;
+    SaHpiResourceIdT slave_id;
+
+    if ( !handler->Abi()->oHpiIdrGet ) {
+        return SA_ERR_HPI_UNSUPPORTED_API;
+    }
+
+    GET_SLAVE( handler, id, slave_id );
+    CALL_ABI( handler,
+              oHpiIdrGet,
+              rv,
+              slave_id,
+              idrid,
+              areaid,
+              max_areas,
+              max_fields,
+              idrinfo,
+              num_areas,
+              areas,
+              num_fields,
+              fields,
+              next );
+
+    return rv;
+}
+
+
 /**************************************************************
  * slave_add_idr_field
  *************************************************************/
@@ -89,6 +89,18 @@ SaErrorT oh_get_el_entry(
     SaHpiRptEntryT * rpte
 );
 
+SaErrorT oh_get_el_entries(
+    void * hnd,
+    SaHpiResourceIdT id,
+    SaHpiEventLogEntryIdT current,
+    SaHpiUint32T max,
+    SaHpiUint32T * num,
+    SaHpiEventLogEntryT * entries,
+    SaHpiRdrT * rdrs,
+    SaHpiRptEntryT * rptes,
+    SaHpiEventLogEntryIdT * next
+);
+
 SaErrorT oh_clear_el(
     void * hnd,
     SaHpiResourceIdT id
@@ -239,6 +251,21 @@ SaErrorT oh_get_idr_field(
     SaHpiIdrFieldT * field
 );
 
+SaErrorT oh_get_idr_all(
+    void * hnd,
+    SaHpiResourceIdT id,
+    SaHpiIdrIdT idrid,
+    SaHpiEntryIdT areaid,
+    SaHpiUint32T max_areas,
+    SaHpiUint32T max_fields,
+    SaHpiIdrInfoT * idrinfo,
+    SaHpiUint32T * num_areas,
+    SaHpiIdrAreaHeaderT * areas,
+    SaHpiUint32T * num_fields,
+    SaHpiIdrFieldT * fields,
+    SaHpiEntryIdT * next
+);
+
 SaErrorT oh_add_idr_field(
     void * hnd,
     SaHpiResourceIdT id,
@@ -26,31 +26,36 @@
 # Script Description:
 #
 # This script takes raw event information contained in 
-# snmp_bc_event.map and generates code that populates the 
-# errlog2event_hash table. This can be done in two ways - 
-# with C code or with XML code. The C code way is simpler
-# but takes more memory. XML is more complex but takes less space.
+# snmp_bc_event.map and generates the static "Error Log to event"
+# mapping table. This can be done in two ways - with C code or
+# with XML code.
 # 
-# The default way is to generate C code and header files to
-# populate the hash table. This generates the following files:
+# The default way is to generate C code. This generates the 
+# following file:
+#
+# el2event.c - Generated C code holding a constant table of all
+#              events plus the displacement table of a minimal
+#              perfect hash over the event message strings. 
+#              errlog2event_lookup() in snmp_bc_el2event.c
+#              uses it to find an event with two string hashes
+#              and a single string compare. Nothing is parsed
+#              or allocated when the plugin is opened.
+#
+# The perfect hash is built with the "hash and displace" method:
+# every message is put into bucket
+#   el_hash(msg, 0) % EL2EVENT_BUCKETS
+# and each bucket (largest first) gets the smallest displacement d
+# such that all its messages land on distinct free table slots 
+#   el_hash(msg, d) % EL2EVENT_TABLE_SIZE
+# el_hash() here must stay in sync with errlog2event_strhash()
+# in snmp_bc_el2event.c.
+#
+# The second way translates events into XML data. This is kept
+# for debugging the map file only; the plugin no longer uses it.
+# This generates the following file:
 #
-# el.h - Error log header file with common #defines
-# el2event.h - Header file definitions need by generated C file.
-# el2event.c - Generated C code that adds events to directly to
-#              the errlog2event_hash table.
-#
-# The second way is to translate events into XML data which is 
-# (in a later step and script) turned into source code that
-# populates the hash table. This generates the following files:
-#
-# el.h - Error log header file with common #defines
-# el2event.h - Header file definitions need by generated source.
 # event.xml - XML formatted events.
 #
-# If the XML method is used, another script, scripts/text2cstr.pl, 
-# needs to be invoked to turn the XML formatted events into source 
-# code that populates the hash table.
-#
 # Script Input:
 #
 # --debug     (optional)   Turn on debug info.
@@ -62,8 +67,8 @@
 # --odir      (optional)   Directory for output file(s).
 #                          Default is current directory.
 # --xml       (optional)   Generate XML formatted events.
-#                          Default is to generate C formatted
-#                          events and code.
+#                          Default is to generate the C 
+#                          perfect hash table.
 #
 # Exit codes
 # - 1 successful
@@ -79,6 +84,8 @@ sub check4dups($$);
 sub print_c_file_header;
 sub print_c_file_ending;
 sub print_c_file_hash_member($);
+sub el_hash($$);
+sub build_perfect_hash;
 sub print_xml_file_header;
 sub print_xml_file_ending;
 sub print_xml_file_hash_member($);
@@ -139,6 +146,8 @@ open (FILE_C, ">>$file_c") or die "$0 Error! Cannot open file $file_c. $! Stoppe
 #################################################################
 my $err = 0;
 my %eventmap = ();
+my @ph_slots = ();
+my @ph_displ = ();
 #my %defmap = ();
 
 while ( <FILE_MAP> ) {
@@ -209,8 +218,9 @@ if ($xml) {
     if (&print_xml_file_ending) { $err = 0; goto CLEANUP; }
 }
 else {
+    if (&build_perfect_hash) { $err = 0; goto CLEANUP; }
     if (&print_c_file_header) { $err = 0; goto CLEANUP; }
-    foreach my $event_message (sort keys %eventmap) {
+    foreach my $event_message (@ph_slots) {
 	if (&print_c_file_hash_member($event_message)) { $err = 0; goto CLEANUP; }
     }
     if (&print_c_file_ending) { $err = 0; goto CLEANUP; }
@@ -350,11 +360,97 @@ sub check4dups($$) {
 #    return 0;
 #}
 
+##################################################################
+# String hash used for the perfect hash table. FNV-1a with the
+# seed folded into the offset basis. Must produce the same values
+# as errlog2event_strhash() in snmp_bc_el2event.c.
+##################################################################
+sub el_hash($$) {
+    my ($str, $seed) = @_;
+    my $h = ($seed ^ 2166136261) & 0xFFFFFFFF;
+
+    foreach my $c (unpack("C*", $str)) {
+	$h ^= $c;
+	$h = ($h * 16777619) & 0xFFFFFFFF;
+    }
+
+    return $h;
+}
+
+##################################################################
+# Build a minimal perfect hash over all event message strings.
+# Fills @ph_slots (message key stored in each table slot) and
+# @ph_displ (displacement for each bucket).
+##################################################################
+sub build_perfect_hash {
+
+    my @keys = sort keys %eventmap;
+    my $nkeys = scalar(@keys);
+    my $nbuckets = int(($nkeys + 3) / 4);
+    if ($nbuckets == 0) { $nbuckets = 1; }
+
+    my @buckets = ();
+    for (my $b = 0; $b < $nbuckets; $b++) {
+	$buckets[$b] = [];
+	$ph_displ[$b] = 0;
+    }
+    foreach my $key (@keys) {
+	my $str = $key;
+	$str =~ s/^\"//;
+	$str =~ s/\"$//;
+	push @{$buckets[el_hash($str, 0) % $nbuckets]}, $key;
+    }
+
+    my @order = sort { scalar(@{$buckets[$b]}) <=> scalar(@{$buckets[$a]}) || $a <=> $b }
+                (0 .. $nbuckets - 1);
+
+    @ph_slots = ();
+    foreach my $b (@order) {
+	my @members = @{$buckets[$b]};
+	next if (scalar(@members) == 0);
+
+	my $found = 0;
+	for (my $d = 1; $d < 65536 && !$found; $d++) {
+	    my %taken = ();
+	    my $ok = 1;
+	    foreach my $key (@members) {
+		my $str = $key;
+		$str =~ s/^\"//;
+		$str =~ s/\"$//;
+		my $slot = el_hash($str, $d) % $nkeys;
+		if (defined($ph_slots[$slot]) || defined($taken{$slot})) {
+		    $ok = 0;
+		    last;
+		}
+		$taken{$slot} = $key;
+	    }
+	    if ($ok) {
+		foreach my $slot (keys %taken) {
+		    $ph_slots[$slot] = $taken{$slot};
+		}
+		$ph_displ[$b] = $d;
+		$found = 1;
+	    }
+	}
+
+	if (!$found) {
+	    print "*************************************************************\n";
+	    print "$0: Error! Cannot find displacement for hash bucket $b.\n";
+	    print "*************************************************************\n\n";
+	    return 1;
+	}
+    }
+
+    return 0;
+}
+
 ####################################
 # Print c file's static leading text 
 ####################################
 sub print_c_file_header {
 
+    my $nkeys = scalar(@ph_slots);
+
     print FILE_C <<EOF;
 /*      -*- linux-c -*-
  *
@@ -375,44 +471,13 @@ sub print_c_file_header {
  *******************************************************************/
 
 #include <glib.h>
-#include <string.h>
 #include <SaHpi.h>
 
-#include <openhpi.h>
 #include <snmp_bc_plugin.h>
 
-GHashTable *errlog2event_hash;
-
-static void free_hash_data(gpointer key, gpointer value, gpointer user_data);
-
-/************************************************************************
- * errlog2event_hash_init:
- * \@custom_handle: Plugin's data pointer.
- * 
- * Initializes the Error Log to event translation hash table.
- *
- * Returns:
- * SA_OK - Normal operation.
- * SA_ERR_HPI_OUT_OF_SPACE - No memory to allocate hash table structures.
- * SA_ERR_HPI_INVALID_PARAMS - \@custom_handle is NULL.
- ************************************************************************/
-SaErrorT errlog2event_hash_init(struct snmp_bc_hnd *custom_handle) {
-
-	gchar *key;
-/*       gchar *key_exists; */
-	ErrLog2EventInfoT *strinfo;
-
-	if (!custom_handle) {
-		dbg("Invalid parameter.");
-		return(SA_ERR_HPI_INVALID_PARAMS);
-	}
-
-	errlog2event_hash = g_hash_table_new(g_str_hash, g_str_equal);
-	if (errlog2event_hash == NULL) {
-		dbg("No memory.");
-		return(SA_ERR_HPI_OUT_OF_SPACE);
-	}
+const guint errlog2event_table_size = $nkeys;
 
+const ErrLog2EventInfoT errlog2event_table[] = {
 EOF
     return 0;
 }
@@ -422,32 +487,23 @@ EOF
 #####################################
 sub print_c_file_ending {
 
-   print FILE_C <<EOF;
+    my $nbuckets = scalar(@ph_displ);
 
-	return(SA_OK);
-}
+    print FILE_C <<EOF;
+};
 
-/**********************************************************************
- * errlog2event_hash_free:
- *
- * Frees the Error Log to event translation hash table.
- *
- * Returns:
- * SA_OK - Normal operation.
- **********************************************************************/
-SaErrorT errlog2event_hash_free()
-{
-        g_hash_table_foreach(errlog2event_hash, free_hash_data, NULL);
-	g_hash_table_destroy(errlog2event_hash);
-
-	return(SA_OK);
-}
+const guint errlog2event_displ_size = $nbuckets;
 
-static void free_hash_data(gpointer key, gpointer value, gpointer user_data)
-{
-/*        g_free(key);  keys are string constants - cannot free them */
-        g_free(value);
-}
+const guint16 errlog2event_displ[] = {
+EOF
+
+    for (my $i = 0; $i < $nbuckets; $i += 8) {
+	my $last = ($i + 8 < $nbuckets) ? $i + 8 : $nbuckets;
+	print FILE_C "\t" . join(", ", @ph_displ[$i .. $last - 1]) . ",\n";
+    }
+
+    print FILE_C <<EOF;
+};
 EOF
 
     return 0;
@@ -468,44 +524,29 @@ sub print_c_file_hash_member($) {
     my $event_hex_str = "\"$event_hex\"";
     $event_hex_str =~ s/^\"0x/\"/;
 
-    my $tab = "";
-
-    # Format override flags
-    if ($override_flags ne "NO_OVR") { 
-	$override_flags =~ s/,/ | /g;
+    # Format override flags. Match flag names the same way the
+    # old XML parser did, so any other values are ignored.
+    my @flags = ();
+    foreach my $flag ("OVR_SEV", "OVR_RID", "OVR_EXP", "OVR_VMM",
+		      "OVR_MM1", "OVR_MM2", "OVR_MM_STBY", "OVR_MM_PRIME") {
+	if (index($override_flags, $flag) >= 0) {
+	    push @flags, $flag;
+	}
+    }
+    if (scalar(@flags) == 0) {
+	push @flags, "NO_OVR";
     }
+    $override_flags = join(" | ", @flags);
     
     print FILE_C <<EOF;
-$tab	key = $event_msg;
-$tab	strinfo = g_malloc0(sizeof(ErrLog2EventInfoT));
-$tab	if (!strinfo) {
-$tab		dbg("No memory. Key=%s.", key);
-$tab		errlog2event_hash_free();
-$tab		return(SA_ERR_HPI_OUT_OF_SPACE);
-$tab	}
-$tab	strinfo->event = $event_hex_str; /* $event_name */
-$tab	strinfo->event_sev = $event_severity;
-$tab	strinfo->event_ovr = $override_flags;
-$tab	strinfo->event_dup = $event_count;
-$tab	g_hash_table_insert(errlog2event_hash, key, strinfo);
+	{ /* $event_name */
+		.msg = $event_msg,
+		.event = $event_hex_str,
+		.event_sev = $event_severity,
+		.event_ovr = $override_flags,
+		.event_dup = $event_count,
+	},
 EOF
-#$tab
-#$tab	key_exists = g_hash_table_lookup(errlog2event_hash, key); 
-#$tab	if (!key_exists) {
-#$tab		strinfo->event = $event_hex_str; /* $event_name */
-#$tab		strinfo->event_sev = $event_severity;
-#$tab		strinfo->event_ovr = $override_flags;
-#$tab		strinfo->event_dup = $event_count;
-#$tab		g_hash_table_insert(errlog2event_hash, key, strinfo);
-#$tab	}
-#$tab	else {
-#$tab		dbg("Error!: Key %s defined twice", key);
-#$tab		errlog2event_hash_free();
-#$tab		return -1;
-#$tab	}
-#EOF
-
-    print FILE_C "\n";
 
     return 0;
 }
@@ -0,0 +1,72 @@
+/*      -*- linux-c -*-
+ *
+ * (C) Copyright IBM Corp. 2004, 2006
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. This
+ * file and program are licensed under a BSD style license. See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Author(s):
+ *      Steve Sherman <stevees@us.ibm.com>
+ *      W. David Ashley <dashley@us.ibm.com>
+ */
+
+#include <glib.h>
+#include <string.h>
+
+#include <snmp_bc_plugin.h>
+
+/**********************************************************************
+ * errlog2event_strhash:
+ * @str: String to hash.
+ * @seed: Hash seed (displacement).
+ *
+ * 32-bit FNV-1a hash with the seed folded into the offset basis.
+ * This must produce the same values as el_hash() in eventmap2code.pl,
+ * which builds the perfect hash table in el2event.c.
+ *
+ * Returns:
+ * Hash value of @str.
+ **********************************************************************/
+static guint32 errlog2event_strhash(const gchar *str, guint32 seed)
+{
+        guint32 h = seed ^ 2166136261U;
+        const guchar *p;
+
+        for (p = (const guchar *)str; *p != '\0'; p++) {
+                h ^= *p;
+                h *= 16777619U;
+        }
+
+        return(h);
+}
+
+/**********************************************************************
+ * errlog2event_lookup:
+ * @msg: Normalized Error Log message string.
+ *
+ * Finds the "Error Log to event" mapping of @msg in the generated
+ * perfect hash table. The table is constant, so no initialization or
+ * locking is needed and it can be shared by all plugin instances.
+ *
+ * Returns:
+ * Pointer to the table entry - @msg is a known event.
+ * NULL - @msg is not in the table.
+ **********************************************************************/
+const ErrLog2EventInfoT *errlog2event_lookup(const gchar *msg)
+{
+        const ErrLog2EventInfoT *entry;
+        guint32 displ;
+
+        if (!msg || errlog2event_table_size == 0) return(NULL);
+
+        displ = errlog2event_displ[errlog2event_strhash(msg, 0) % errlog2event_displ_size];
+        entry = &errlog2event_table[errlog2event_strhash(msg, displ) % errlog2event_table_size];
+
+        if (strcmp(entry->msg, msg) != 0) return(NULL);
+
+        return(entry);
+}
@@ -26,24 +26,19 @@
 #define OVR_MM_PRIME  0x0000000010000000  /* Override Error Log's source - set resource to primary MM */
 
 typedef struct {
-        gchar *event;
+        const gchar        *msg;
+        const gchar        *event;
 	SaHpiSeverityT      event_sev;
 	unsigned long long  event_ovr;
         short               event_dup;
 } ErrLog2EventInfoT;
 
-/* Global "Error Log to Event" mapping hash table and usage count */
-extern GHashTable *errlog2event_hash;
-extern unsigned int errlog2event_hash_use_count;
+/* Generated "Error Log to event" perfect hash table (el2event.c) */
+extern const ErrLog2EventInfoT errlog2event_table[];
+extern const guint errlog2event_table_size;
+extern const guint16 errlog2event_displ[];
+extern const guint errlog2event_displ_size;
 
-SaErrorT errlog2event_hash_init(struct snmp_bc_hnd *custom_handle);
-SaErrorT errlog2event_hash_free(void);
-
-/* XML event code and mapping structures */
-extern char *eventxml;
-
-struct errlog2event_hash_info {
-	GHashTable *hashtable;
-};
+const ErrLog2EventInfoT *errlog2event_lookup(const gchar *msg);
 
 #endif
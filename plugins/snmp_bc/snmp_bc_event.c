@@ -21,6 +21,10 @@
 
 #include <snmp_bc_plugin.h>
 
+static void snmp_bc_normalize_event_str(const gchar *text,
+					gchar *search_str,
+					SaHpiBoolT *is_recovery_event);
+
 static SaErrorT snmp_bc_parse_threshold_str(gchar *str,
 					    gchar *root_str,
 					    SaHpiTextBufferT *read_value_str,
@@ -45,9 +49,9 @@ static SaErrorT snmp_bc_map2oem(SaHpiEventT *event,
 				sel_entry *sel_entry,
 				OEMReasonCodeT reason);
 
-static ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
-						     ErrLog2EventInfoT *dupstrhash_data,
-						     LogSource2ResourceT *logsrc2res);
+static const ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
+							   const ErrLog2EventInfoT *dupstrhash_data,
+							   LogSource2ResourceT *logsrc2res);
 /**
  * event2hpi_hash_init:
  * @handle: Pointer to handler's data.
@@ -359,7 +363,6 @@ SaErrorT snmp_bc_log2event(struct oh_handler_state *handle,
 			   LogSource2ResourceT *ret_logsrc2res)
 {
 	sel_entry           log_entry;
-	gchar               *recovery_str, *login_str, *post_str;
 	gchar               root_str[SNMP_BC_MAX_SEL_ENTRY_LENGTH];
 	gchar               search_str[SNMP_BC_MAX_SEL_ENTRY_LENGTH];
 	EventMapInfoT       *eventmap_info;
@@ -371,7 +374,7 @@ SaErrorT snmp_bc_log2event(struct oh_handler_state *handle,
 	SaHpiSeverityT      event_severity;
 	SaHpiTextBufferT    thresh_read_value, thresh_trigger_value;
 	SaHpiTimeT          event_time;
-	ErrLog2EventInfoT   *strhash_data;
+	const ErrLog2EventInfoT *strhash_data;
         struct snmp_bc_hnd *custom_handle;
 	int dupovrovr;
 	struct oh_event *e;
@@ -406,55 +409,8 @@ SaErrorT snmp_bc_log2event(struct oh_handler_state *handle,
          * string, since its what mapped in the event hash table.
          **********************************************************************/
 
-	/* Set default search string */
-	strncpy(search_str, log_entry.text, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-
-	/* Discover "recovery" event strings */
-	recovery_str = strstr(search_str, EVT_RECOVERY);
-	if (recovery_str && (recovery_str == search_str)) {
-		is_recovery_event = SAHPI_TRUE;
-		memset(search_str, 0, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-		strncpy(search_str, (log_entry.text + strlen(EVT_RECOVERY)),
-			SNMP_BC_MAX_SEL_ENTRY_LENGTH - strlen(EVT_RECOVERY));
-	}
-
-	/* Adjust "login" event strings - strip username */
-	login_str = strstr(log_entry.text, LOG_LOGIN_STRING);
-	if (login_str) {
-		gchar *id_str = strstr(log_entry.text, LOG_LOGIN_CHAR);
-		if (id_str != NULL) {
-			memset(search_str, 0, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-			strncpy(search_str, log_entry.text, (id_str - log_entry.text));
-			search_str[(id_str - log_entry.text)] = '\0';
-		}
-	}
-
-	/* Adjust "POST" event strings - strip post results */
-	post_str = strstr(log_entry.text, LOG_POST_STRING);
-	if (post_str) {
-		memset(search_str, 0, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-		strncpy(search_str, log_entry.text, (post_str - log_entry.text));
-		search_str[(post_str - log_entry.text - 1)] = '\0';
-	}
-
-        /* Replace internal double blanks with a single blank */
-	{
-		gchar *double_blanks;
-		double_blanks = strstr(log_entry.text, "  ");
-		if (double_blanks) {
-			gchar *tmp_str;
-			int len;
-			tmp_str = log_entry.text;
-			memset(search_str, 0, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-			do {
-				strncat(search_str, tmp_str, (double_blanks - tmp_str));
-				tmp_str = double_blanks + 1;
-				len = strlen(tmp_str);
-				double_blanks = strstr(tmp_str, "  ");
-			} while (double_blanks);
-			strncat(search_str, tmp_str, len);
-		}
-	}
+	/* Strip recovery prefix, login user names, POST results and extra blanks */
+	snmp_bc_normalize_event_str(log_entry.text, search_str, &is_recovery_event);
 
 	/* Adjust "threshold" event strings */
 	if (strstr(log_entry.text, LOG_THRESHOLD_VALUE_STRING) ||
@@ -473,16 +429,9 @@ SaErrorT snmp_bc_log2event(struct oh_handler_state *handle,
 		}
 	}
 
-	/* Strip any leading/trailing blanks */
-	{
-		gchar *tmp_str;
-		tmp_str = g_strstrip(g_strdup(search_str));
-		strncpy(search_str, tmp_str, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-		g_free(tmp_str);
-		if ((search_str == NULL || search_str[0] == '\0')) {
-			err("Search string is NULL for log string=%s", log_entry.text);
-			return(SA_ERR_HPI_INTERNAL_ERROR);
-		}
+	if (search_str[0] == '\0') {
+		err("Search string is NULL for log string=%s", log_entry.text);
+		return(SA_ERR_HPI_INTERNAL_ERROR);
 	}
 
 	/* Strip any trailing period */
@@ -504,10 +453,10 @@ SaErrorT snmp_bc_log2event(struct oh_handler_state *handle,
 	}
 	event_rid = logsrc2res.rid;
 
-	/***********************************************************
-	 * See if adjusted root string is in errlog2event_hash table
-         ***********************************************************/
-	strhash_data = (ErrLog2EventInfoT *)g_hash_table_lookup(errlog2event_hash, search_str);
+	/************************************************************
+	 * See if adjusted root string is in errlog2event_table table
+         ************************************************************/
+	strhash_data = errlog2event_lookup(search_str);
 	if (!strhash_data) {
 		if (snmp_bc_map2oem(&working, &log_entry, EVENT_NOT_ALERTABLE)) {
 			err("Cannot map to OEM Event %s.", log_entry.text);
@@ -804,10 +753,10 @@ RESUME_TO_EXIT:
  * information. A NULL is returned if the information cannot be found.
  * 
  * There are several identical Error Log messages strings that are shared by
- * multiple resources. The scripts that populate errlog2event_hash
- * create unique entries for these duplicate strings by tacking on
+ * multiple resources. The script that generates errlog2event_table
+ * creates unique entries for these duplicate strings by tacking on
  * an unique string (HPIDUP_duplicate_number) to the error log message.
- * This is then stored in errlog2event_hash. So there is a unique mapping
+ * This is then stored in errlog2event_table. So there is a unique mapping
  * for each resource with a duplicate string.
  * 
  * This routine goes finds the unique mapping for all the duplicate strings.
@@ -820,12 +769,12 @@ RESUME_TO_EXIT:
  * SA_OK - Normal case.
  * SA_ERR_HPI_INVALID_PARAMS - Parameter pointer(s) are NULL.
  **/
-static ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
-						   ErrLog2EventInfoT *strhash_data,
-						   LogSource2ResourceT *logsrc2res)
+static const ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
+							 const ErrLog2EventInfoT *strhash_data,
+							 LogSource2ResourceT *logsrc2res)
 {	
 	gchar dupstr[SNMP_BC_MAX_SEL_ENTRY_LENGTH];
-	ErrLog2EventInfoT *dupstr_hash_data;
+	const ErrLog2EventInfoT *dupstr_hash_data;
 	short strnum;
 
 	if (!search_str || !strhash_data || !logsrc2res) {
@@ -869,15 +818,10 @@ static ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
 		/* Find next duplicate string */
 		strnum--;
 		if (strnum) {
-			gchar strnum_str[OH_MAX_LOCATION_DIGITS];
-			gchar *tmpstr;
-
-			snprintf(strnum_str, OH_MAX_LOCATION_DIGITS, "%d", strnum);
-			tmpstr = g_strconcat(search_str, HPIDUP_STRING, strnum_str, NULL);
-			strncpy(dupstr, tmpstr, SNMP_BC_MAX_SEL_ENTRY_LENGTH);
-			g_free(tmpstr);
+			snprintf(dupstr, SNMP_BC_MAX_SEL_ENTRY_LENGTH, "%s%s%d",
+				 search_str, HPIDUP_STRING, strnum);
 
-			dupstr_hash_data = (ErrLog2EventInfoT *)g_hash_table_lookup(errlog2event_hash, dupstr);
+			dupstr_hash_data = errlog2event_lookup(dupstr);
 			if (dupstr_hash_data == NULL) {
 				err("Cannot find duplicate string=%s.", dupstr);
 			}
@@ -887,6 +831,67 @@ static ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
 	return(NULL);
 }
 
+/**
+ * snmp_bc_normalize_event_str:
+ * @text: Error Log entry's text.
+ * @search_str: Location to store the normalized string.
+ *              Must be SNMP_BC_MAX_SEL_ENTRY_LENGTH bytes long.
+ * @is_recovery_event: Location to store if @text is a recovery event.
+ *
+ * Builds the string used to search the "Error Log to event" table in
+ * one pass over @text without allocating memory. The recovery prefix,
+ * login user names and POST results are stripped, internal runs of
+ * blanks are replaced with a single blank and leading/trailing blanks
+ * are removed. Threshold values are handled by snmp_bc_parse_threshold_str().
+ *
+ * Return values:
+ * None.
+ **/
+static void snmp_bc_normalize_event_str(const gchar *text,
+					gchar *search_str,
+					SaHpiBoolT *is_recovery_event)
+{
+	const gchar *start, *end, *p;
+	gchar *out, *out_end;
+
+	start = text;
+	end = text + strlen(text);
+	*is_recovery_event = SAHPI_FALSE;
+
+	/* Discover "recovery" event strings */
+	if (strncmp(text, EVT_RECOVERY, strlen(EVT_RECOVERY)) == 0) {
+		*is_recovery_event = SAHPI_TRUE;
+		start = text + strlen(EVT_RECOVERY);
+	}
+
+	/* Adjust "login" event strings - strip username */
+	if (strstr(text, LOG_LOGIN_STRING)) {
+		p = strstr(text, LOG_LOGIN_CHAR);
+		if (p) end = p;
+	}
+
+	/* Adjust "POST" event strings - strip post results and preceding blank */
+	p = strstr(text, LOG_POST_STRING);
+	if (p) end = (p > text) ? p - 1 : p;
+
+	if (end < start) end = start;
+
+	/* Skip leading blanks */
+	while (start < end && g_ascii_isspace(*start)) start++;
+
+	/* Copy, replacing internal double blanks with a single blank */
+	out = search_str;
+	out_end = search_str + SNMP_BC_MAX_SEL_ENTRY_LENGTH - 1;
+	for (p = start; p < end && out < out_end; p++) {
+		if (*p == ' ' && out > search_str && *(out - 1) == ' ') continue;
+		*out++ = *p;
+	}
+
+	/* Strip trailing blanks */
+	while (out > search_str && g_ascii_isspace(*(out - 1))) out--;
+	*out = '\0';
+}
+
 /**
  * snmp_bc_parse_threshold_str:
  * @str: Input Error Log threshold string.
@@ -897,119 +902,115 @@ static ErrLog2EventInfoT *snmp_bc_findevent4dupstr(gchar *search_str,
  * Parses a Error Log threshold string into its root string, read, 
  * and trigger value strings.
  * 
- * Format is a root string (in the errlog2event_hash table) followed by a
+ * Format is a root string (in the errlog2event_table table) followed by a
  * read threshold value string, followed by a trigger threshold value string.
  * Unfortunately cannot convert directly to sensor values yet because 
  * don't yet know if event is in the event2hpi_hash table or if it is, 
  * what the sensor's threshold data type is.
  *
+ * Works on stack copies of @str; no memory is allocated.
+ *
  * Return values:
  * SA_OK - Normal case.
  * SA_ERR_HPI_INVALID_PARAMS - Parameter pointer(s) are NULL.
+ * SA_ERR_HPI_INTERNAL_ERROR - @str isn't a valid threshold string.
  **/
 static SaErrorT snmp_bc_parse_threshold_str(gchar *str,
 					    gchar *root_str,
 					    SaHpiTextBufferT *read_value_str,
 					    SaHpiTextBufferT *trigger_value_str)
 {
-	gchar  **event_substrs;
-	gchar  **thresh_substrs;
-	SaErrorT err;
+	const gchar *read_sep, *thresh_sep, *read_start, *read_end;
+	gchar values[SNMP_BC_MAX_SEL_ENTRY_LENGTH];
+	gchar *read_value, *trigger_value, *thresh_start;
+	gsize len;
 
 	if (!str || !root_str || !read_value_str || !trigger_value_str) {
 		err("Invalid parameter.");
 		return(SA_ERR_HPI_INVALID_PARAMS);
 	}
-		
-	event_substrs = NULL;
-	thresh_substrs = NULL;
-	err = SA_OK;
 	
 	/* Handle BladeCenter's two basic threshold event formats */
 	if (strstr(str, LOG_READ_VALUE_STRING)) {
-		event_substrs = g_strsplit(str, LOG_READ_VALUE_STRING, -1);
-		thresh_substrs = g_strsplit(event_substrs[1], LOG_THRESHOLD_VALUE_STRING, -1);
+		read_sep = LOG_READ_VALUE_STRING;
+		thresh_sep = LOG_THRESHOLD_VALUE_STRING;
 	}
 	else {
-		event_substrs = g_strsplit(str, LOG_READ_STRING, -1);
-		thresh_substrs = g_strsplit(event_substrs[1], LOG_THRESHOLD_STRING, -1);
-	}
-   
-	if (thresh_substrs == NULL ||
-	    (thresh_substrs[0] == NULL || thresh_substrs[0][0] == '\0') ||
-	    (thresh_substrs[1] == NULL || thresh_substrs[1][0] == '\0') ||
-	    (thresh_substrs[2] != NULL)) {
+		read_sep = LOG_READ_STRING;
+		thresh_sep = LOG_THRESHOLD_STRING;
+	}
+
+	/* Root string ends at the read separator; the values run
+           up to the next read separator, if any */
+	read_start = strstr(str, read_sep);
+	if (read_start == NULL) {
 		err("Cannot split threshold string=%s.", str);
-		err = SA_ERR_HPI_INTERNAL_ERROR;
-		goto CLEANUP;
+		return(SA_ERR_HPI_INTERNAL_ERROR);
 	}
-	
+	len = read_start - str;
+	read_start += strlen(read_sep);
+	read_end = strstr(read_start, read_sep);
+	if (read_end == NULL) read_end = read_start + strlen(read_start);
+
+	memcpy(values, read_start, read_end - read_start);
+	values[read_end - read_start] = '\0';
+
+	/* Split values into read and trigger value strings */
+	thresh_start = strstr(values, thresh_sep);
+	if (thresh_start == NULL ||
+	    strstr(thresh_start + strlen(thresh_sep), thresh_sep) != NULL) {
+		err("Cannot split threshold string=%s.", str);
+		return(SA_ERR_HPI_INTERNAL_ERROR);
+	}
+	*thresh_start = '\0';
+	read_value = values;
+	trigger_value = thresh_start + strlen(thresh_sep);
+
 	/* Strip any leading/trailing blanks */
-	event_substrs[0]= g_strstrip(event_substrs[0]);
-	thresh_substrs[0] = g_strstrip(thresh_substrs[0]);
-	thresh_substrs[1] = g_strstrip(thresh_substrs[1]);
-	if ((event_substrs[0] == NULL || event_substrs[0] == '\0') ||
-	    (thresh_substrs[0] == NULL || thresh_substrs[0][0] == '\0') ||
-	    (thresh_substrs[1] == NULL || thresh_substrs[1][0] == '\0')) {
+	read_value = g_strstrip(read_value);
+	trigger_value = g_strstrip(trigger_value);
+	if (read_value[0] == '\0' || trigger_value[0] == '\0') {
 		err("NULL base string or threshold values=%s.", str);
-		err = SA_ERR_HPI_INTERNAL_ERROR;
-		goto CLEANUP;
+		return(SA_ERR_HPI_INTERNAL_ERROR);
 	}
 
 	/* Change any leading period to a blank.
            This put here because MM code added a period after the 
            Threadhold Value string and before the threshold value 
            (e.g. "Threshold value. 23.0") */
-	if (thresh_substrs[0][0] == '.') thresh_substrs[0][0] = ' ';
-	if (thresh_substrs[1][0] == '.') thresh_substrs[1][0] = ' ';
+	if (read_value[0] == '.') read_value[0] = ' ';
+	if (trigger_value[0] == '.') trigger_value[0] = ' ';
 
 	/* Strip any leading/trailing blanks - in case of leading period */
-	thresh_substrs[0] = g_strstrip(thresh_substrs[0]);
-	thresh_substrs[1] = g_strstrip(thresh_substrs[1]);
-	if ((event_substrs[0] == NULL || event_substrs[0] == '\0') ||
-	    (thresh_substrs[0] == NULL || thresh_substrs[0][0] == '\0') ||
-	    (thresh_substrs[1] == NULL || thresh_substrs[1][0] == '\0')) {
+	read_value = g_strstrip(read_value);
+	trigger_value = g_strstrip(trigger_value);
+	if (read_value[0] == '\0' || trigger_value[0] == '\0') {
 		err("NULL base string or threshold values=%s.", str);
-		err = SA_ERR_HPI_INTERNAL_ERROR;
-		goto CLEANUP;
+		return(SA_ERR_HPI_INTERNAL_ERROR);
 	}
 
 	/* Strip any ending periods, commas, colons, or semicolons */
-	if ((thresh_substrs[0][strlen(thresh_substrs[0]) - 1] == '.') ||
-	    (thresh_substrs[0][strlen(thresh_substrs[0]) - 1] == ',') ||
-	    (thresh_substrs[0][strlen(thresh_substrs[0]) - 1] == ':') ||
-	    (thresh_substrs[0][strlen(thresh_substrs[0]) - 1] == ';'))
-		thresh_substrs[0][strlen(thresh_substrs[0]) - 1] = '\0';
-	if ((thresh_substrs[1][strlen(thresh_substrs[1]) - 1]  == '.') ||
-	    (thresh_substrs[1][strlen(thresh_substrs[1]) - 1]  == ',') ||
-	    (thresh_substrs[1][strlen(thresh_substrs[1]) - 1]  == ':') ||
-	    (thresh_substrs[1][strlen(thresh_substrs[1]) - 1]  == ';'))
-		thresh_substrs[1][strlen(thresh_substrs[1]) - 1] = '\0';
+	if (strchr(".,:;", read_value[strlen(read_value) - 1]))
+		read_value[strlen(read_value) - 1] = '\0';
+	if (strchr(".,:;", trigger_value[strlen(trigger_value) - 1]))
+		trigger_value[strlen(trigger_value) - 1] = '\0';
 
 	/* Check for valid length */
-	if ((strlen(thresh_substrs[0]) > SAHPI_MAX_TEXT_BUFFER_LENGTH) ||
-	    (strlen(thresh_substrs[1]) > SAHPI_MAX_TEXT_BUFFER_LENGTH)) {
+	if ((strlen(read_value) > SAHPI_MAX_TEXT_BUFFER_LENGTH) ||
+	    (strlen(trigger_value) > SAHPI_MAX_TEXT_BUFFER_LENGTH)) {
 		err("Threshold value string(s) exceed max size for %s.", str);
-		err = SA_ERR_HPI_INTERNAL_ERROR;
-		goto CLEANUP;
+		return(SA_ERR_HPI_INTERNAL_ERROR);
 	}
 
-	dbg("Threshold strings: %s and %s", thresh_substrs[0], thresh_substrs[1]);
+	dbg("Threshold strings: %s and %s", read_value, trigger_value);
 	
-	strcpy(root_str, event_substrs[0]);
-	oh_append_textbuffer(read_value_str, thresh_substrs[0]);
-	oh_append_textbuffer(trigger_value_str, thresh_substrs[1]);
+	memmove(root_str, str, len);
+	root_str[len] = '\0';
+	g_strstrip(root_str);
+	oh_append_textbuffer(read_value_str, read_value);
+	oh_append_textbuffer(trigger_value_str, trigger_value);
 
-	if (root_str == NULL) {
-		err("Cannot parse threshold string=%s.", str);
-		err = SA_ERR_HPI_INTERNAL_ERROR;
-	}
-
- CLEANUP:
-	g_strfreev(event_substrs);
-	g_strfreev(thresh_substrs);
-
-	return(err);
+	return(SA_OK);
 }
 
 /**
@@ -16,7 +16,7 @@
 /************************************************************************
  * Notes:
  *
- * All these test cases depend on values defined in errlog2event_hash and
+ * All these test cases depend on values defined in errlog2event_table and
  * sensor and resource definitions in snmp_bc_resources.c. These are real
  * hardware events and sensors, which hopefully won't change much.
  ************************************************************************/
@@ -0,0 +1,331 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
+#include <glib.h>
+
+#include <oh_error.h>
+
+#include "shmchan.h"
+
+
+#ifdef _WIN32
+
+/***************************************************************
+ * Shared memory channels are not supported on Windows
+ **************************************************************/
+struct ShmRegion
+{
+    int dummy;
+};
+
+struct ShmRing
+{
+    int dummy;
+};
+
+cShmChannel * cShmChannel::Create()
+{
+    CRIT( "shared memory transport is not supported on this platform." );
+    return 0;
+}
+
+cShmChannel * cShmChannel::Attach( const char * )
+{
+    CRIT( "shared memory transport is not supported on this platform." );
+    return 0;
+}
+
+cShmChannel::~cShmChannel()
+{
+    // empty
+}
+
+void cShmChannel::Unlink()
+{
+    // empty
+}
+
+int cShmChannel::Read( void *, size_t, unsigned int )
+{
+    return -1;
+}
+
+int cShmChannel::Write( const void *, size_t, unsigned int )
+{
+    return -1;
+}
+
+#else
+
+
+/***************************************************************
+ * Shared Memory Layout
+ *
+ * head and tail count the bytes written to and read from a ring.
+ * Only the writer moves head and only the reader moves tail.
+ * data is posted after head moved, space after tail moved.
+ **************************************************************/
+static const uint32_t dShmMagic    = 0x4f485348; // "OHSH"
+static const uint32_t dShmRingSize = 1 << 17;    // power of 2
+static const char     dShmPrefix[] = "/openhpi-";
+
+struct ShmRing
+{
+    sem_t         data;
+    sem_t         space;
+    volatile gint head;
+    volatile gint tail;
+    uint8_t       buf[dShmRingSize];
+};
+
+struct ShmRegion
+{
+    uint32_t magic;
+    uint32_t ring_size;
+    ShmRing  rings[2]; // 0: client to server, 1: server to client
+};
+
+
+/***************************************************************
+ * Helper functions
+ **************************************************************/
+// Returns 1 if posted, 0 on timeout, -1 on error
+static int TimedWait( sem_t * sem, unsigned int timeout_ms )
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_REALTIME, &ts );
+    ts.tv_sec  += timeout_ms / 1000;
+    ts.tv_nsec += ( timeout_ms % 1000 ) * 1000000L;
+    if ( ts.tv_nsec >= 1000000000L ) {
+        ++ts.tv_sec;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    while ( sem_timedwait( sem, &ts ) != 0 ) {
+        if ( errno == ETIMEDOUT ) {
+            return 0;
+        } else if ( errno != EINTR ) {
+            CRIT( "waiting on shared memory semaphore failed." );
+            return -1;
+        }
+    }
+
+    return 1;
+}
+
+static ShmRegion * MapRegion( int fd )
+{
+    void * addr = mmap( 0,
+                        sizeof(ShmRegion),
+                        PROT_READ | PROT_WRITE,
+                        MAP_SHARED,
+                        fd,
+                        0 );
+    if ( addr == MAP_FAILED ) {
+        CRIT( "cannot map shared memory object." );
+        return 0;
+    }
+
+    return reinterpret_cast<ShmRegion *>(addr);
+}
+
+
+/***************************************************************
+ * Shared Memory Channel class
+ **************************************************************/
+cShmChannel::cShmChannel( ShmRegion * region, bool creator, const char * name )
+    : m_region( region ),
+      m_rx( &region->rings[creator ? 1 : 0] ),
+      m_tx( &region->rings[creator ? 0 : 1] ),
+      m_linked( creator )
+{
+    g_strlcpy( m_name, name, sizeof(m_name) );
+}
+
+cShmChannel::~cShmChannel()
+{
+    Unlink();
+    munmap( m_region, sizeof(ShmRegion) );
+}
+
+cShmChannel * cShmChannel::Create()
+{
+    char name[NameLength];
+    int fd = -1;
+
+    for ( int attempt = 0; ( fd < 0 ) && ( attempt < 8 ); ++attempt ) {
+        snprintf( name, sizeof(name), "%s%u-%08x",
+                  dShmPrefix, (unsigned int)getpid(), g_random_int() );
+        fd = shm_open( name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR );
+        if ( ( fd < 0 ) && ( errno != EEXIST ) ) {
+            break;
+        }
+    }
+    if ( fd < 0 ) {
+        CRIT( "cannot create shared memory object." );
+        return 0;
+    }
+
+    ShmRegion * region = 0;
+    if ( ftruncate( fd, sizeof(ShmRegion) ) == 0 ) {
+        region = MapRegion( fd );
+    } else {
+        CRIT( "cannot size shared memory object." );
+    }
+    close( fd );
+    if ( !region ) {
+        shm_unlink( name );
+        return 0;
+    }
+
+    for ( size_t i = 0; i < 2; ++i ) {
+        ShmRing * ring = &region->rings[i];
+        if ( ( sem_init( &ring->data, 1, 0 ) != 0 ) ||
+             ( sem_init( &ring->space, 1, 0 ) != 0 ) )
+        {
+            CRIT( "cannot create shared memory semaphores." );
+            munmap( region, sizeof(ShmRegion) );
+            shm_unlink( name );
+            return 0;
+        }
+        ring->head = 0;
+        ring->tail = 0;
+    }
+    region->ring_size = dShmRingSize;
+    g_atomic_int_set( reinterpret_cast<volatile gint *>(&region->magic),
+                      (gint)dShmMagic );
+
+    return new cShmChannel( region, true, name );
+}
+
+cShmChannel * cShmChannel::Attach( const char * name )
+{
+    // Only accept objects made by cShmChannel::Create()
+    if ( ( strncmp( name, dShmPrefix, sizeof(dShmPrefix) - 1 ) != 0 ) ||
+         ( strchr( name + 1, '/' ) != 0 ) ||
+         ( strlen( name ) >= NameLength ) )
+    {
+        CRIT( "invalid shared memory object name." );
+        return 0;
+    }
+
+    int fd = shm_open( name, O_RDWR, 0 );
+    if ( fd < 0 ) {
+        CRIT( "cannot open shared memory object %s.", name );
+        return 0;
+    }
+
+    ShmRegion * region = 0;
+    struct stat st;
+    if ( ( fstat( fd, &st ) == 0 ) && ( st.st_size == sizeof(ShmRegion) ) ) {
+        region = MapRegion( fd );
+    } else {
+        CRIT( "shared memory object %s has wrong size.", name );
+    }
+    close( fd );
+    if ( !region ) {
+        return 0;
+    }
+
+    if ( ( region->magic != dShmMagic ) || ( region->ring_size != dShmRingSize ) ) {
+        CRIT( "shared memory object %s has wrong layout.", name );
+        munmap( region, sizeof(ShmRegion) );
+        return 0;
+    }
+
+    return new cShmChannel( region, false, name );
+}
+
+void cShmChannel::Unlink()
+{
+    if ( m_linked ) {
+        shm_unlink( m_name );
+        m_linked = false;
+    }
+}
+
+int cShmChannel::Read( void * buf, size_t len, unsigned int timeout_ms )
+{
+    ShmRing * ring = m_rx;
+
+    while ( true ) {
+        uint32_t head  = (uint32_t)g_atomic_int_get( &ring->head );
+        uint32_t tail  = (uint32_t)g_atomic_int_get( &ring->tail );
+        uint32_t avail = head - tail;
+        if ( avail > dShmRingSize ) {
+            CRIT( "shared memory ring is corrupted." );
+            return -1;
+        }
+        if ( avail > 0 ) {
+            size_t n   = ( len < avail ) ? len : avail;
+            size_t off = tail & ( dShmRingSize - 1 );
+            size_t n1  = ( n < dShmRingSize - off ) ? n : dShmRingSize - off;
+            memcpy( buf, &ring->buf[off], n1 );
+            memcpy( reinterpret_cast<uint8_t *>(buf) + n1, &ring->buf[0], n - n1 );
+            g_atomic_int_set( &ring->tail, (gint)( tail + n ) );
+            sem_post( &ring->space );
+            return (int)n;
+        }
+
+        int cc = TimedWait( &ring->data, timeout_ms );
+        if ( cc <= 0 ) {
+            return cc;
+        }
+    }
+}
+
+int cShmChannel::Write( const void * buf, size_t len, unsigned int timeout_ms )
+{
+    ShmRing * ring = m_tx;
+
+    while ( true ) {
+        uint32_t head = (uint32_t)g_atomic_int_get( &ring->head );
+        uint32_t tail = (uint32_t)g_atomic_int_get( &ring->tail );
+        uint32_t used = head - tail;
+        if ( used > dShmRingSize ) {
+            CRIT( "shared memory ring is corrupted." );
+            return -1;
+        }
+        uint32_t room = dShmRingSize - used;
+        if ( room > 0 ) {
+            size_t n   = ( len < room ) ? len : room;
+            size_t off = head & ( dShmRingSize - 1 );
+            size_t n1  = ( n < dShmRingSize - off ) ? n : dShmRingSize - off;
+            memcpy( &ring->buf[off], buf, n1 );
+            memcpy( &ring->buf[0], reinterpret_cast<const uint8_t *>(buf) + n1, n - n1 );
+            g_atomic_int_set( &ring->head, (gint)( head + n ) );
+            sem_post( &ring->data );
+            return (int)n;
+        }
+
+        int cc = TimedWait( &ring->space, timeout_ms );
+        if ( cc <= 0 ) {
+            return cc;
+        }
+    }
+}
+
+#endif /* _WIN32 */
+
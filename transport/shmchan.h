@@ -0,0 +1,75 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef SHMCHAN_H_INCLUDED
+#define SHMCHAN_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+struct ShmRegion;
+struct ShmRing;
+
+
+/***************************************************************
+ * Shared Memory Channel class
+ *
+ * A pair of byte rings in a POSIX shared memory object,
+ * one for each direction.
+ * The client creates the object and passes its name to the server
+ * over a Unix-domain connection, see cStreamSock::AttachShm.
+ * Both sides then exchange the same framed messages as over
+ * the socket, the socket is only kept to detect a dead peer.
+ **************************************************************/
+class cShmChannel
+{
+public:
+
+    static const size_t NameLength = 64;
+
+    static cShmChannel * Create();
+    static cShmChannel * Attach( const char * name );
+
+    ~cShmChannel();
+
+    const char * Name() const
+    {
+        return m_name;
+    }
+
+    // Removes the name, the mappings stay valid
+    void Unlink();
+
+    // Return the number of bytes transferred,
+    // 0 on timeout and -1 on error.
+    int Read( void * buf, size_t len, unsigned int timeout_ms );
+    int Write( const void * buf, size_t len, unsigned int timeout_ms );
+
+private:
+
+    cShmChannel( ShmRegion * region, bool creator, const char * name );
+
+    cShmChannel( const cShmChannel& );
+    cShmChannel& operator =( const cShmChannel& );
+
+private:
+
+    ShmRegion * m_region;
+    ShmRing *   m_rx;
+    ShmRing *   m_tx;
+    bool        m_linked;
+    char        m_name[NameLength];
+};
+
+
+#endif  // SHMCHAN_H_INCLUDED
+
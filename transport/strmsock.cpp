@@ -30,19 +30,36 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <unistd.h>
 #endif
 
+#include <config.h>
+
 #include <glib.h>
 
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
 #include <oh_error.h>
 
+#include "shmchan.h"
 #include "strmsock.h"
 
 
+// Shared memory waits are cut in slices to check the peer connection
+static const unsigned int dShmPollMs = 1000;
+
+// Smaller payloads are not worth compressing
+static const uint32_t dMinCompressLength = 128;
+
+
 /***************************************************************
  * Initialization/Finalization
  **************************************************************/
@@ -119,12 +136,61 @@ static void SelectAddresses( int ipvflags,
     }
 }
 
+#ifndef _WIN32
+static bool MakeUnixAddress( const char * path,
+                             struct sockaddr_un& addr,
+                             struct addrinfo& info )
+{
+    memset( &addr, 0, sizeof(addr) );
+    if ( strlen( path ) >= sizeof(addr.sun_path) ) {
+        CRIT( "Unix-domain socket path %s is too long.", path );
+        return false;
+    }
+    addr.sun_family = AF_UNIX;
+    strcpy( addr.sun_path, path );
+
+    memset( &info, 0, sizeof(info) );
+    info.ai_family   = AF_UNIX;
+    info.ai_socktype = SOCK_STREAM;
+    info.ai_protocol = 0;
+    info.ai_addr     = reinterpret_cast<struct sockaddr *>( &addr );
+    info.ai_addrlen  = sizeof(addr);
+
+    return true;
+}
+#endif
+
+
+/***************************************************************
+ * Compression streams, set up on first use
+ **************************************************************/
+#ifdef HAVE_ZLIB
+struct cStreamSock::ZStreams
+{
+    bool       tx_ready;
+    bool       tx_failed;
+    bool       rx_ready;
+    z_stream   tx;
+    z_stream   rx;
+    uint8_t *  rx_buf;
+};
+#else
+struct cStreamSock::ZStreams
+{
+    int dummy;
+};
+#endif
+
 
 /***************************************************************
  * Base Stream Socket class
  **************************************************************/
 cStreamSock::cStreamSock( SockFdT sockfd )
-    : m_sockfd( sockfd )
+    : m_sockfd( sockfd ),
+      m_rpc_version( dMhRpcVersion ),
+      m_peer_caps( 0 ),
+      m_shm( 0 ),
+      m_z( 0 )
 {
     // empty
 }
@@ -132,6 +198,19 @@ cStreamSock::cStreamSock( SockFdT sockfd )
 cStreamSock::~cStreamSock()
 {
     Close();
+    delete m_shm;
+#ifdef HAVE_ZLIB
+    if ( m_z ) {
+        if ( m_z->tx_ready ) {
+            deflateEnd( &m_z->tx );
+        }
+        if ( m_z->rx_ready ) {
+            inflateEnd( &m_z->rx );
+        }
+        g_free( m_z->rx_buf );
+    }
+#endif
+    delete m_z;
 }
 
 bool cStreamSock::GetPeerAddress( SockAddrStorageT& storage ) const
@@ -143,6 +222,239 @@ bool cStreamSock::GetPeerAddress( SockAddrStorageT& storage ) const
     return ( cc == 0 );
 }
 
+bool cStreamSock::IsLocal() const
+{
+#ifdef _WIN32
+    return false;
+#else
+    SockAddrStorageT storage;
+    SockAddrLenT len = sizeof(storage);
+    int cc = getsockname( m_sockfd,
+                          reinterpret_cast<struct sockaddr *>( &storage ),
+                          &len );
+    return ( cc == 0 ) && ( storage.ss_family == AF_UNIX );
+#endif
+}
+
+bool cStreamSock::AttachShm( uint32_t id, const void * name, uint32_t name_len )
+{
+    cShmChannel * shm = 0;
+
+    if ( m_shm ) {
+        CRIT( "connection already uses shared memory." );
+    } else if ( !IsLocal() ) {
+        CRIT( "shared memory requested over a non-local connection." );
+    } else {
+        char buf[cShmChannel::NameLength];
+        size_t len = ( name_len < sizeof(buf) ) ? name_len : sizeof(buf) - 1;
+        memcpy( buf, name, len );
+        buf[len] = '\0';
+        shm = cShmChannel::Attach( buf );
+    }
+
+    if ( !shm ) {
+        return WriteMsg( eMhError, id, 0, 0 );
+    }
+
+    // The reply goes over the socket, the next messages over shm
+    if ( !WriteMsg( eMhShm, id, 0, 0 ) ) {
+        delete shm;
+        return false;
+    }
+    SetShm( shm );
+
+    return true;
+}
+
+void cStreamSock::SetShm( cShmChannel * shm )
+{
+    delete m_shm;
+    m_shm = shm;
+}
+
+bool cStreamSock::EnableCompression()
+{
+#ifdef HAVE_ZLIB
+    if ( !m_z ) {
+        m_z = new ZStreams;
+        memset( m_z, 0, sizeof(ZStreams) );
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool cStreamSock::Compress( const void * src, uint32_t src_len,
+                            void * dst, uint32_t& dst_len )
+{
+#ifdef HAVE_ZLIB
+    z_stream& z = m_z->tx;
+    if ( m_z->tx_failed ) {
+        return false;
+    }
+    if ( !m_z->tx_ready ) {
+        if ( deflateInit( &z, Z_BEST_SPEED ) != Z_OK ) {
+            return false;
+        }
+        m_z->tx_ready = true;
+    }
+
+    // Once deflate has consumed the payload, the peer must get it.
+    // So leave room for the flush and do not start otherwise.
+    if ( ( deflateBound( &z, src_len ) + 16 ) > dst_len ) {
+        return false;
+    }
+
+    z.next_in   = reinterpret_cast<Bytef *>( const_cast<void *>(src) );
+    z.avail_in  = src_len;
+    z.next_out  = reinterpret_cast<Bytef *>(dst);
+    z.avail_out = dst_len;
+    int cc = deflate( &z, Z_SYNC_FLUSH );
+    if ( ( cc != Z_OK ) || ( z.avail_in != 0 ) || ( z.avail_out == 0 ) ) {
+        // The peer stream misses this payload now. Uncompressed
+        // payloads do not touch it, so send only those from now on.
+        CRIT( "payload compression failed, compression disabled." );
+        m_z->tx_failed = true;
+        return false;
+    }
+    dst_len -= z.avail_out;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+char * cStreamSock::RxCompressedBuffer()
+{
+#ifdef HAVE_ZLIB
+    if ( !m_z ) {
+        CRIT( "got compressed payload without announcing compression." );
+        return 0;
+    }
+    if ( !m_z->rx_ready ) {
+        if ( inflateInit( &m_z->rx ) != Z_OK ) {
+            CRIT( "cannot set up payload decompression." );
+            return 0;
+        }
+        m_z->rx_ready = true;
+        m_z->rx_buf = reinterpret_cast<uint8_t *>( g_malloc( dMaxCompressedPayloadLength ) );
+    }
+    return reinterpret_cast<char *>( m_z->rx_buf );
+#else
+    CRIT( "got compressed payload, compression is not supported." );
+    return 0;
+#endif
+}
+
+bool cStreamSock::Decompress( const void * src, uint32_t src_len,
+                              void * dst, uint32_t& dst_len )
+{
+#ifdef HAVE_ZLIB
+    z_stream& z = m_z->rx;
+
+    z.next_in   = reinterpret_cast<Bytef *>( const_cast<void *>(src) );
+    z.avail_in  = src_len;
+    z.next_out  = reinterpret_cast<Bytef *>(dst);
+    z.avail_out = dst_len;
+    int cc = inflate( &z, Z_SYNC_FLUSH );
+    if ( ( cc != Z_OK ) || ( z.avail_in != 0 ) ) {
+        CRIT( "payload decompression failed." );
+        return false;
+    }
+    dst_len -= z.avail_out;
+    if ( z.avail_out == 0 ) {
+        // The payload must not expand beyond the buffer
+        uint8_t extra;
+        z.next_out  = &extra;
+        z.avail_out = 1;
+        inflate( &z, Z_SYNC_FLUSH );
+        if ( z.avail_out == 0 ) {
+            CRIT( "decompressed payload too large." );
+            return false;
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool cStreamSock::PeerClosed() const
+{
+    if ( m_sockfd == InvalidSockFd ) {
+        return true;
+    }
+#ifdef _WIN32
+    return false;
+#else
+    // In shared memory mode nothing is sent over the socket,
+    // so it gets readable only when the peer closes it.
+    struct pollfd pfd;
+    pfd.fd      = m_sockfd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    int cc = poll( &pfd, 1, 0 );
+    if ( cc < 0 ) {
+        return ( errno != EINTR );
+    } else if ( cc == 0 ) {
+        return false;
+    }
+    if ( pfd.revents & ( POLLERR | POLLHUP | POLLNVAL ) ) {
+        return true;
+    }
+    char c;
+    ssize_t len = recv( m_sockfd, &c, 1, MSG_PEEK | MSG_DONTWAIT );
+    return ( len == 0 ) || ( ( len < 0 ) && ( errno != EAGAIN ) && ( errno != EINTR ) );
+#endif
+}
+
+ssize_t cStreamSock::RecvBytes( void * buf, size_t len )
+{
+    if ( !m_shm ) {
+        // Windows recv() takes char *
+        return recv( m_sockfd, reinterpret_cast<char *>(buf), len, 0 );
+    }
+
+    while ( true ) {
+        int cc = m_shm->Read( buf, len, dShmPollMs );
+        if ( cc != 0 ) {
+            return cc;
+        }
+        if ( PeerClosed() ) {
+            return 0;
+        }
+    }
+}
+
+bool cStreamSock::SendBytes( const void * buf, size_t len )
+{
+    if ( !m_shm ) {
+        // Windows send() takes const char *
+        ssize_t cc = send( m_sockfd, reinterpret_cast<const char *>(buf), len, 0 );
+        return ( cc == (ssize_t)len );
+    }
+
+    const uint8_t * src = reinterpret_cast<const uint8_t *>(buf);
+    while ( len > 0 ) {
+        int cc = m_shm->Write( src, len, dShmPollMs );
+        if ( cc < 0 ) {
+            return false;
+        } else if ( cc == 0 ) {
+            if ( PeerClosed() ) {
+                return false;
+            }
+            continue;
+        }
+        src += cc;
+        len -= cc;
+    }
+
+    return true;
+}
+
 bool cStreamSock::Close()
 {
     if ( m_sockfd == InvalidSockFd ) {
@@ -172,7 +484,8 @@ bool cStreamSock::ReadMsg( uint8_t& type,
                            uint32_t& id,
                            void * payload,
                            uint32_t& payload_len,
-                           int& payload_byte_order )
+                           int& payload_byte_order,
+                           uint8_t& payload_rpc_version )
 {
     // Windows recv() takes char * so we need the workaround below.
     union {
@@ -183,8 +496,9 @@ bool cStreamSock::ReadMsg( uint8_t& type,
     char * dst = rawhdr;
     size_t got  = 0;
     size_t need = dMhSize;
+    bool compressed = false;
     while ( got < need ) {
-        ssize_t len = recv( m_sockfd, dst + got, need - got, 0 );
+        ssize_t len = RecvBytes( dst + got, need - got );
         if ( len < 0 ) {
             CRIT( "error while reading message in thread %p.", 
             g_thread_self() );
@@ -198,26 +512,54 @@ bool cStreamSock::ReadMsg( uint8_t& type,
         if ( ( got == need ) && ( dst == rawhdr ) ) {
             // we got header
             uint8_t ver = hdr[dMhOffFlags] >> 4;
-            if ( ver != dMhRpcVersion ) {
-                CRIT( "unsupported version 0x%x != 0x%x.",
+            if ( ( ver < dMhRpcVersion ) || ( ver > dMhMaxRpcVersion ) ) {
+                CRIT( "unsupported version 0x%x, supported 0x%x-0x%x.",
                      ver,
-                     dMhRpcVersion );
+                     dMhRpcVersion,
+                     dMhMaxRpcVersion );
                 return false;
             }
+            payload_rpc_version = ver;
+            uint8_t peer_ver = hdr[dMhOffMaxRpcVersion];
+            if ( peer_ver < ver ) {
+                peer_ver = ver;
+            }
+            m_rpc_version = ( peer_ver < dMhMaxRpcVersion ) ? peer_ver : dMhMaxRpcVersion;
             type = hdr[dMhOffType];
             payload_byte_order = ( ( hdr[dMhOffFlags] & dMhEndianBit ) != 0 ) ?
                                  G_LITTLE_ENDIAN : G_BIG_ENDIAN;
             id = DecodeUint32( &hdr[dMhOffId], payload_byte_order );
             payload_len = DecodeUint32( &hdr[dMhOffLen], payload_byte_order );
+            m_peer_caps = hdr[dMhOffCaps];
+            compressed = ( ( hdr[dMhOffFlags] & dMhCompressedBit ) != 0 );
+            if ( payload_len > ( compressed ? dMaxCompressedPayloadLength
+                                            : dMaxPayloadLength ) )
+            {
+                CRIT( "message payload too large." );
+                return false;
+            }
 
             // now prepare to get payload
             dst  = reinterpret_cast<char *>(payload);
             got  = 0;
             need = payload_len;
+
+            if ( compressed ) {
+                dst = RxCompressedBuffer();
+                if ( !dst ) {
+                    return false;
+                }
+            }
         }
     }
 
     payload_len = got;
+    if ( compressed ) {
+        payload_len = dMaxPayloadLength;
+        if ( !Decompress( dst, got, payload, payload_len ) ) {
+            return false;
+        }
+    }
 
 /*
     printf( "Transport: got message of %u bytes in buffer %p:\n",
@@ -248,7 +590,8 @@ bool cStreamSock::ReadMsg( uint8_t& type,
 bool cStreamSock::WriteMsg( uint8_t type,
                             uint32_t id,
                             const void * payload,
-                            uint32_t payload_len )
+                            uint32_t payload_len,
+                            uint8_t payload_rpc_version )
 {
     if ( ( payload_len > 0 ) && ( payload == 0 ) ) {
         return false;
@@ -261,23 +604,34 @@ bool cStreamSock::WriteMsg( uint8_t type,
     // Windows send() takes char * so we need the workaround below.
     union {
         MessageHeader hdr;
-        char msg[dMaxMessageLength];
+        char msg[dMhSize + dMaxCompressedPayloadLength];
     };
 
     hdr[dMhOffType] = type;
-    hdr[dMhOffFlags] = dMhRpcVersion << 4;
+    hdr[dMhOffFlags] = payload_rpc_version << 4;
     if ( G_BYTE_ORDER == G_LITTLE_ENDIAN ) {
         hdr[dMhOffFlags] |= dMhEndianBit;
     }
-    hdr[dMhOffReserved1] = 0;
-    hdr[dMhOffReserved2] = 0;
+    hdr[dMhOffMaxRpcVersion] = dMhMaxRpcVersion;
+    hdr[dMhOffCaps] = m_z ? dMhCapZlib : 0;
+
+    uint32_t wire_len = dMaxCompressedPayloadLength;
+    bool compressed = m_z &&
+                      ( ( m_peer_caps & dMhCapZlib ) != 0 ) &&
+                      ( payload_len >= dMinCompressLength ) &&
+                      Compress( payload, payload_len, &msg[dMhSize], wire_len );
+    if ( compressed ) {
+        hdr[dMhOffFlags] |= dMhCompressedBit;
+    } else {
+        wire_len = payload_len;
+        if ( payload ) {
+            memcpy( &msg[dMhSize], payload, payload_len );
+        }
+    }
     EncodeUint32( &hdr[dMhOffId], id, G_BYTE_ORDER );
-    EncodeUint32( &hdr[dMhOffLen], payload_len, G_BYTE_ORDER );
+    EncodeUint32( &hdr[dMhOffLen], wire_len, G_BYTE_ORDER );
 
-    if ( payload ) {
-        memcpy( &msg[dMhSize], payload, payload_len );
-    }
-    size_t msg_len = dMhSize + payload_len;
+    size_t msg_len = dMhSize + wire_len;
 
 /*
     printf("Transport: sending message of %d bytes:\n", msg_len );
@@ -292,8 +646,7 @@ bool cStreamSock::WriteMsg( uint8_t type,
     printf( "\n" );
 */
 
-    ssize_t cc = send( m_sockfd, &msg[0], msg_len, 0 );
-    if ( cc != (ssize_t)msg_len ) {
+    if ( !SendBytes( &msg[0], msg_len ) ) {
         CRIT( "error while sending message." );
         return false;
     }
@@ -354,6 +707,9 @@ bool cStreamSock::CreateAttempt( const struct addrinfo * info, bool last_attempt
                     case AF_INET6:
                         aif = "IPv6";
                         break;
+                    case AF_UNIX:
+                        aif = "Unix-domain";
+                        break;
                     default:
                         aif = "";
                 }
@@ -387,6 +743,13 @@ cClientStreamSock::~cClientStreamSock()
 
 bool cClientStreamSock::Create( const char * host, uint16_t port )
 {
+    if ( strncmp( host, dUnixHostPrefix, sizeof(dUnixHostPrefix) - 1 ) == 0 ) {
+        return CreateUnix( host + sizeof(dUnixHostPrefix) - 1 );
+    }
+    if ( strncmp( host, dShmHostPrefix, sizeof(dShmHostPrefix) - 1 ) == 0 ) {
+        return CreateShm( host + sizeof(dShmHostPrefix) - 1 );
+    }
+
     bool connected = false;
     struct addrinfo * info;
     std::list<struct addrinfo *> infos;
@@ -405,10 +768,77 @@ bool cClientStreamSock::Create( const char * host, uint16_t port )
     return connected;
 }
 
+bool cClientStreamSock::CreateUnix( const char * path )
+{
+#ifdef _WIN32
+    CRIT( "Unix-domain sockets are not supported on this platform." );
+    return false;
+#else
+    struct sockaddr_un addr;
+    struct addrinfo info;
+
+    if ( !MakeUnixAddress( path, addr, info ) ) {
+        return false;
+    }
+
+    return CreateAttempt( &info, true );
+#endif
+}
+
+bool cClientStreamSock::CreateShm( const char * path )
+{
+    bool rc = CreateUnix( path );
+    if ( !rc ) {
+        return false;
+    }
+
+    cShmChannel * shm = cShmChannel::Create();
+    if ( !shm ) {
+        WARN( "Using Unix-domain socket without shared memory." );
+        return true;
+    }
+
+    rc = WriteMsg( eMhShm, 0, shm->Name(), strlen( shm->Name() ) + 1 );
+    if ( !rc ) {
+        delete shm;
+        Close();
+        return false;
+    }
+
+    uint8_t  type;
+    uint32_t id;
+    uint32_t len;
+    int      byte_order;
+    uint8_t  rpc_version;
+    void *   buf = g_malloc( dMaxPayloadLength );
+    rc = ReadMsg( type, id, buf, len, byte_order, rpc_version );
+    g_free( buf );
+
+    // The server has mapped the channel or has refused it
+    shm->Unlink();
+    if ( !rc ) {
+        delete shm;
+        Close();
+        return false;
+    }
+    if ( type != eMhShm ) {
+        delete shm;
+        WARN( "Server refused shared memory, using Unix-domain socket." );
+        return true;
+    }
+    SetShm( shm );
+
+    return true;
+}
+
 bool cClientStreamSock::EnableKeepAliveProbes( int keepalive_time,
                                                int keepalive_intvl,
                                                int keepalive_probes )
 {
+    if ( IsLocal() ) {
+        return true;
+    }
+
 #ifdef __linux__
     int rc;
     int val;
@@ -473,14 +903,21 @@ bool cClientStreamSock::CreateAttempt( const struct addrinfo * info, bool last_a
  * Server Stream Socket class
  **************************************************************/
 cServerStreamSock::cServerStreamSock()
-    : cStreamSock()
+    : cStreamSock(),
+      m_path( 0 )
 {
     // empty
 }
 
 cServerStreamSock::~cServerStreamSock()
 {
-    // empty
+    if ( m_path ) {
+        Close();
+#ifndef _WIN32
+        unlink( m_path );
+#endif
+        g_free( m_path );
+    }
 }
 
 bool cServerStreamSock::Create( int ipvflags, const char * bindaddr, uint16_t port )
@@ -503,6 +940,40 @@ bool cServerStreamSock::Create( int ipvflags, const char * bindaddr, uint16_t po
     return bound;
 }
 
+bool cServerStreamSock::CreateUnix( const char * path )
+{
+#ifdef _WIN32
+    CRIT( "Unix-domain sockets are not supported on this platform." );
+    return false;
+#else
+    struct sockaddr_un addr;
+    struct addrinfo info;
+
+    if ( !MakeUnixAddress( path, addr, info ) ) {
+        return false;
+    }
+
+    // A socket file left by a previous run makes bind fail
+    struct stat st;
+    if ( ( lstat( path, &st ) == 0 ) && S_ISSOCK( st.st_mode ) ) {
+        unlink( path );
+    }
+
+    bool rc = CreateAttempt( &info, true );
+    if ( !rc ) {
+        return false;
+    }
+    m_path = g_strdup( path );
+
+    // Same access as the TCP socket on localhost
+    if ( chmod( path, 0666 ) != 0 ) {
+        WARN( "cannot change mode of %s.", path );
+    }
+
+    return true;
+#endif
+}
+
 bool cServerStreamSock::CreateAttempt( const struct addrinfo * info, bool last_attempt )
 {
     bool rc = cStreamSock::CreateAttempt( info, last_attempt );
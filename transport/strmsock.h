@@ -50,23 +50,61 @@ const size_t dMhSize = 12;
 typedef uint8_t MessageHeader[dMhSize];
 const size_t dMhOffType      = 0;
 const size_t dMhOffFlags     = 1;
-const size_t dMhOffReserved1 = 2;
-const size_t dMhOffReserved2 = 3;
+const size_t dMhOffMaxRpcVersion = 2;
+const size_t dMhOffCaps      = 3;
 const size_t dMhOffId        = 4;
 const size_t dMhOffLen       = 8;
 
 const uint8_t eMhMsg   = 1;
 const uint8_t eMhError = 2;
+// Switches a Unix-domain connection to a shared memory channel.
+// The payload is the channel name, the peer answers with eMhShm
+// on success and with eMhError otherwise.
+const uint8_t eMhShm   = 3;
 
 // message flags
-// bits 0-3 : flags, bit 4-7 : OpenHPI RPC version
+// bits 0-3 : flags, bit 4-7 : OpenHPI RPC version of the payload
 // if endian bit is set the byte order is Little Endian
-const uint8_t dMhEndianBit  = 1;
+// if compressed bit is set the payload is compressed
+const uint8_t dMhEndianBit     = 1;
+const uint8_t dMhCompressedBit = 2;
 const uint8_t dMhRpcVersion = 1;
 
+// RPC version 2 uses the compact payload encoding.
+// Every message carries the highest RPC version the sender supports
+// in the dMhOffMaxRpcVersion byte (older peers send zero there).
+// A sender uses version 2 only after it got a message from the peer
+// that announced it, so older peers only ever see version 1 messages.
+const uint8_t dMhRpcVersion2   = 2;
+const uint8_t dMhMaxRpcVersion = dMhRpcVersion2;
+
+// Capabilities of the sender, in the dMhOffCaps byte
+// (older peers send zero there).
+// A sender compresses a payload only if it enabled compression
+// and got a message from the peer that announced dMhCapZlib.
+// The compressed payloads of one direction of a connection form
+// a single zlib stream, every payload ends with a sync flush.
+// The header carries the compressed payload length, which may exceed
+// dMaxPayloadLength a little for incompressible payloads.
+const uint8_t dMhCapZlib = 1;
+
 
 const size_t dMaxMessageLength = 0xFFFF;
 const size_t dMaxPayloadLength = dMaxMessageLength - sizeof(MessageHeader);
+const size_t dMaxCompressedPayloadLength = dMaxPayloadLength + 1024;
+
+
+/***************************************************************
+ * Local transports, selected by host name prefix:
+ * "unix:/path" - Unix-domain socket at /path
+ * "shm:/path"  - shared memory channel set up over the Unix-domain
+ *                socket at /path
+ **************************************************************/
+const char dUnixHostPrefix[] = "unix:";
+const char dShmHostPrefix[]  = "shm:";
+
+
+class cShmChannel;
 
 
 /***************************************************************
@@ -99,12 +137,21 @@ public:
                   uint32_t& id,
                   void * payload,
                   uint32_t& payload_len,
-                  int& payload_byte_order );
+                  int& payload_byte_order,
+                  uint8_t& payload_rpc_version );
 
     bool WriteMsg( uint8_t type,
                    uint32_t id,
                    const void * payload,
-                   uint32_t payload_len );
+                   uint32_t payload_len,
+                   uint8_t payload_rpc_version = dMhRpcVersion );
+
+    // Highest RPC version supported by both sides.
+    // It is dMhRpcVersion until a message from the peer has been read.
+    uint8_t RpcVersion() const
+    {
+        return m_rpc_version;
+    }
 
     enum eWaitCc
     {
@@ -115,6 +162,18 @@ public:
 
     eWaitCc Wait();
 
+    // True for Unix-domain connections
+    bool IsLocal() const;
+
+    // Announces to the peer that compressed payloads are accepted
+    // and compresses payloads if the peer announced the same.
+    // Returns false if compression is not supported in this build.
+    bool EnableCompression();
+
+    // Server side of the eMhShm request with the given id.
+    // Returns false if the reply could not be sent.
+    bool AttachShm( uint32_t id, const void * name, uint32_t name_len );
+
 protected:
 
     SockFdT SockFd() const
@@ -122,6 +181,8 @@ protected:
         return m_sockfd;
     }
 
+    void SetShm( cShmChannel * shm );
+
     bool CreateAttempt( const struct addrinfo * ainfo, bool last_attempt );
 
 private:
@@ -129,9 +190,25 @@ private:
     cStreamSock( const cStreamSock& );
     cStreamSock& operator =( const cStreamSock& );
 
+    ssize_t RecvBytes( void * buf, size_t len );
+    bool SendBytes( const void * buf, size_t len );
+    bool PeerClosed() const;
+
+    bool Compress( const void * src, uint32_t src_len,
+                   void * dst, uint32_t& dst_len );
+    char * RxCompressedBuffer();
+    bool Decompress( const void * src, uint32_t src_len,
+                     void * dst, uint32_t& dst_len );
+
 private:
 
+    struct ZStreams;
+
     SockFdT m_sockfd;
+    uint8_t m_rpc_version;
+    uint8_t m_peer_caps;
+    cShmChannel * m_shm;
+    ZStreams * m_z;
 };
 
 
@@ -145,8 +222,15 @@ public:
     explicit cClientStreamSock();
     ~cClientStreamSock();
 
+    // host may carry the dUnixHostPrefix or dShmHostPrefix prefix
     bool Create( const char * host, uint16_t port );
 
+    bool CreateUnix( const char * path );
+
+    // Falls back to the plain Unix-domain connection
+    // if the server does not support shared memory.
+    bool CreateShm( const char * path );
+
     /***********************
      * TCP Keep-Alive
      *
@@ -155,6 +239,8 @@ public:
      * keepalive_intvl  - interval(sec) between subsequential keepalive probes
      * keepalive_probes - number of unacknowledged probes to send before
      *                    considering the connection dead
+     *
+     * Does nothing for Unix-domain connections.
      **********************/
     bool EnableKeepAliveProbes( int keepalive_time,
                                 int keepalive_intvl,
@@ -181,6 +267,10 @@ public:
 
     bool Create( int ipvflags, const char * bindaddr, uint16_t port );
 
+    // Removes a stale socket file at path first.
+    // The socket file is removed again on destruction.
+    bool CreateUnix( const char * path );
+
     cStreamSock * Accept();
 
 private:
@@ -189,6 +279,10 @@ private:
     cServerStreamSock& operator =( const cServerStreamSock& );
 
     bool CreateAttempt( const struct addrinfo * ainfo, bool last_attempt );
+
+private:
+
+    char * m_path;
 };
 
 
@@ -27,46 +27,67 @@
 #include <oh_utils.h>
 
 
+static struct oh_pool event_pool = OH_POOL_INIT("event", struct oh_event);
+static struct oh_pool rdr_pool = OH_POOL_INIT("rdr", SaHpiRdrT);
+
+
+struct oh_event *oh_new_event(void)
+{
+	return (struct oh_event *)oh_pool_alloc0(&event_pool);
+}
+
+SaHpiRdrT *oh_new_rdr(void)
+{
+	return (SaHpiRdrT *)oh_pool_alloc0(&rdr_pool);
+}
+
+static void free_rdrs(GSList *rdrs)
+{
+	GSList *node = NULL;
+
+	for (node = rdrs; node; node = node->next) {
+		oh_pool_free(&rdr_pool, node->data);
+	}
+	g_slist_free(rdrs);
+}
+
+static GSList *dup_rdrs(GSList *rdrs)
+{
+	GSList *node = NULL;
+	GSList *copy = NULL;
+
+	for (node = rdrs; node; node = node->next) {
+		SaHpiRdrT *rdr = (SaHpiRdrT *)oh_pool_alloc(&rdr_pool);
+		*rdr = *(SaHpiRdrT *)node->data;
+		copy = g_slist_prepend(copy, rdr);
+	}
+
+	return g_slist_reverse(copy);
+}
+
 void oh_event_free(struct oh_event *e, int only_rdrs)
 {
 	if (e) {
 		if (e->rdrs) {
-			GSList *node = NULL;
-			for (node = e->rdrs; node; node = node->next) {
-				g_free(node->data);
-			}
-			g_slist_free(e->rdrs);
+			free_rdrs(e->rdrs);
 		}
 		if (e->rdrs_to_remove) {
-			GSList *node = NULL;
-			for (node = e->rdrs_to_remove; node; node = node->next) {
-				g_free(node->data);
-			}
-			g_slist_free(e->rdrs_to_remove);
+			free_rdrs(e->rdrs_to_remove);
 		}
-		if (!only_rdrs) g_free(e);
+		if (!only_rdrs) oh_pool_free(&event_pool, e);
 	}
 }
 
 struct oh_event *oh_dup_event(struct oh_event *old_event)
 {
-	GSList *node = NULL;
 	struct oh_event *e = NULL;
 
 	if (!old_event) return NULL;
 
-	e = g_new0(struct oh_event, 1);
+	e = (struct oh_event *)oh_pool_alloc(&event_pool);
 	*e = *old_event;
-	e->rdrs = NULL;
-	for (node = old_event->rdrs; node; node = node->next) {
-		e->rdrs = g_slist_append(e->rdrs, g_memdup(node->data,
-							   sizeof(SaHpiRdrT)));
-	}
-    e->rdrs_to_remove = NULL;
-	for (node = old_event->rdrs_to_remove; node; node = node->next) {
-		e->rdrs_to_remove = g_slist_append(e->rdrs_to_remove, g_memdup(node->data,
-							   sizeof(SaHpiRdrT)));
-	}
+	e->rdrs = dup_rdrs(old_event->rdrs);
+	e->rdrs_to_remove = dup_rdrs(old_event->rdrs_to_remove);
 
 	return e;
 }
@@ -105,7 +105,11 @@ struct oh_event {
 
 typedef GAsyncQueue oh_evt_queue;
 
-#define oh_new_event() g_new0(struct oh_event, 1)
+/* oh_new_event() and oh_dup_event() take events and their RDRs from
+ * object pools. Free them with oh_event_free() or oh_pool_free(),
+ * never with g_free(). */
+struct oh_event *oh_new_event(void);
+SaHpiRdrT *oh_new_rdr(void);
 void oh_event_free(struct oh_event *e, int only_rdrs);
 struct oh_event *oh_dup_event(struct oh_event *old_event);
 void oh_evt_queue_push(oh_evt_queue *equeue, gpointer data);
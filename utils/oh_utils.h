@@ -20,6 +20,7 @@
 /* Order is important */
 #include <SaHpiXtca.h>
 #include <SaHpiAtca.h>
+#include <pool_utils.h>
 #include <announcement_utils.h>
 #include <el_utils.h>
 #include <event_utils.h>
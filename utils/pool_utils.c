@@ -0,0 +1,449 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ *     Fixed size object pools with per-thread caches.
+ *
+ *     oh_pool_alloc
+ *     oh_pool_alloc0
+ *     oh_pool_free
+ *     oh_pool_get_stats
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include <glib.h>
+
+#include <oh_error.h>
+#include <oh_utils.h>
+#include <sahpi_wrappers.h>
+
+
+/* Objects a thread cache takes from or returns to the free list at once */
+#define POOL_BATCH          32
+#define POOL_SLAB_HDR_SIZE  64
+#define POOL_SLAB_MAGIC     0x4f48504cU /* "OHPL" */
+#define POOL_TABLE_SIZE     (2 * OH_POOL_MAX_SLABS) /* power of 2 */
+
+/* At the start of every slab, the objects follow */
+struct pool_slab {
+        guint32 magic;
+        guint32 id;
+};
+
+struct pool_state {
+        struct oh_pool *pool;
+        gsize size;
+        guint per_slab;
+#if GLIB_CHECK_VERSION (2, 32, 0)
+        GMutex lock;
+#else
+        GStaticMutex lock;
+#endif
+        /* protected by lock */
+        gpointer free_list;
+        guint free;
+        guint slabs;
+        /* counters of exited threads, protected by cache_lock */
+        guint64 allocs;
+        guint64 frees;
+        guint64 heap_allocs;
+        guint64 heap_frees;
+};
+
+/* Free objects of one pool cached by one thread */
+struct pool_magazine {
+        gpointer head;
+        guint count;
+        guint64 allocs;
+        guint64 frees;
+        guint64 heap_allocs;
+        guint64 heap_frees;
+};
+
+struct pool_cache {
+        struct pool_magazine mags[OH_POOL_MAX_POOLS];
+};
+
+static struct pool_state pools[OH_POOL_MAX_POOLS];
+static volatile gint npools = 0;
+
+/* Slab base addresses, open addressing. Entries are only added,
+ * so lookups need no lock. */
+static gpointer volatile slab_table[POOL_TABLE_SIZE];
+static guint nslabs = 0;
+
+#if GLIB_CHECK_VERSION (2, 32, 0)
+static GMutex pool_lock;  /* pool registration, slab table */
+static GMutex cache_lock; /* caches, counters of exited threads */
+#else
+static GStaticMutex pool_lock = G_STATIC_MUTEX_INIT;
+static GStaticMutex cache_lock = G_STATIC_MUTEX_INIT;
+#endif
+static GSList *caches = NULL;
+
+static void cache_release(gpointer data);
+
+#if GLIB_CHECK_VERSION (2, 32, 0)
+static GPrivate cache_key = G_PRIVATE_INIT(cache_release);
+#else
+static GStaticPrivate cache_key = G_STATIC_PRIVATE_INIT;
+#endif
+
+
+static guint slab_hash(gsize base)
+{
+        return (guint)((base / OH_POOL_SLAB_SIZE) * 2654435761U) &
+               (POOL_TABLE_SIZE - 1);
+}
+
+/* Returns the slab holding obj or NULL if obj is not from a pool */
+static struct pool_slab *slab_find(gconstpointer obj)
+{
+        gsize base = (gsize)obj & ~(gsize)(OH_POOL_SLAB_SIZE - 1);
+        guint i, n;
+
+        for (i = slab_hash(base), n = 0; n < POOL_TABLE_SIZE;
+             i = (i + 1) & (POOL_TABLE_SIZE - 1), ++n) {
+                gpointer slab = g_atomic_pointer_get(&slab_table[i]);
+                if (!slab) {
+                        return NULL;
+                }
+                if ((gsize)slab == base) {
+                        return (struct pool_slab *)slab;
+                }
+        }
+
+        return NULL;
+}
+
+static gpointer slab_memory(void)
+{
+        gpointer mem = NULL;
+
+#ifdef _WIN32
+        mem = _aligned_malloc(OH_POOL_SLAB_SIZE, OH_POOL_SLAB_SIZE);
+#else
+        if (posix_memalign(&mem, OH_POOL_SLAB_SIZE, OH_POOL_SLAB_SIZE) != 0) {
+                mem = NULL;
+        }
+#endif
+
+        return mem;
+}
+
+/* Called with ps->lock held. Returns FALSE if no slab could be added. */
+static gboolean pool_grow(struct pool_state *ps, guint id)
+{
+        struct pool_slab *slab;
+        guint8 *obj;
+        guint i;
+
+        wrap_g_static_mutex_lock(&pool_lock);
+        if (nslabs >= OH_POOL_MAX_SLABS) {
+                wrap_g_static_mutex_unlock(&pool_lock);
+                return FALSE;
+        }
+        slab = (struct pool_slab *)slab_memory();
+        if (!slab) {
+                wrap_g_static_mutex_unlock(&pool_lock);
+                return FALSE;
+        }
+        slab->magic = POOL_SLAB_MAGIC;
+        slab->id = id;
+        for (i = slab_hash((gsize)slab); slab_table[i];
+             i = (i + 1) & (POOL_TABLE_SIZE - 1)) {
+                /* empty */
+        }
+        g_atomic_pointer_set(&slab_table[i], slab);
+        ++nslabs;
+        wrap_g_static_mutex_unlock(&pool_lock);
+
+        obj = (guint8 *)slab + POOL_SLAB_HDR_SIZE;
+        for (i = 0; i < ps->per_slab; ++i, obj += ps->size) {
+                *(gpointer *)obj = ps->free_list;
+                ps->free_list = obj;
+        }
+        ps->free += ps->per_slab;
+        ++ps->slabs;
+
+        return TRUE;
+}
+
+static struct pool_state *pool_state(struct oh_pool *pool)
+{
+        gint id = g_atomic_int_get(&pool->id);
+
+        if (id > 0) {
+                return &pools[id - 1];
+        }
+
+        wrap_g_static_mutex_lock(&pool_lock);
+        id = pool->id;
+        if (id == 0 && npools < OH_POOL_MAX_POOLS) {
+                struct pool_state *ps = &pools[npools];
+                ps->pool = pool;
+                ps->size = (pool->size + sizeof(gpointer) - 1) &
+                           ~(sizeof(gpointer) - 1);
+                if (ps->size < sizeof(gpointer)) {
+                        ps->size = sizeof(gpointer);
+                }
+                ps->per_slab = (OH_POOL_SLAB_SIZE - POOL_SLAB_HDR_SIZE) /
+                               ps->size;
+#if !GLIB_CHECK_VERSION (2, 32, 0)
+                wrap_g_static_mutex_init(&ps->lock);
+#endif
+                id = npools + 1;
+                g_atomic_int_set(&npools, id);
+                g_atomic_int_set(&pool->id, id);
+        }
+        wrap_g_static_mutex_unlock(&pool_lock);
+
+        if (id == 0 || pools[id - 1].per_slab == 0) {
+                CRIT("Cannot set up object pool %s.", pool->name);
+                return NULL;
+        }
+
+        return &pools[id - 1];
+}
+
+static struct pool_cache *cache_get(void)
+{
+        struct pool_cache *cache;
+
+        cache = (struct pool_cache *)wrap_g_static_private_get(&cache_key);
+        if (cache) {
+                return cache;
+        }
+
+        cache = g_new0(struct pool_cache, 1);
+#if GLIB_CHECK_VERSION (2, 32, 0)
+        wrap_g_static_private_set(&cache_key, cache);
+#else
+        wrap_g_static_private_set(&cache_key, cache, cache_release);
+#endif
+        wrap_g_static_mutex_lock(&cache_lock);
+        caches = g_slist_prepend(caches, cache);
+        wrap_g_static_mutex_unlock(&cache_lock);
+
+        return cache;
+}
+
+/* Gives the cached objects of an exiting thread back to the pools */
+static void cache_release(gpointer data)
+{
+        struct pool_cache *cache = (struct pool_cache *)data;
+        gint i, n = g_atomic_int_get(&npools);
+
+        wrap_g_static_mutex_lock(&cache_lock);
+        caches = g_slist_remove(caches, cache);
+        for (i = 0; i < n; ++i) {
+                struct pool_state *ps = &pools[i];
+                struct pool_magazine *mag = &cache->mags[i];
+
+                ps->allocs += mag->allocs;
+                ps->frees += mag->frees;
+                ps->heap_allocs += mag->heap_allocs;
+                ps->heap_frees += mag->heap_frees;
+
+                wrap_g_static_mutex_lock(&ps->lock);
+                while (mag->head) {
+                        gpointer obj = mag->head;
+                        mag->head = *(gpointer *)obj;
+                        *(gpointer *)obj = ps->free_list;
+                        ps->free_list = obj;
+                        ++ps->free;
+                }
+                wrap_g_static_mutex_unlock(&ps->lock);
+        }
+        wrap_g_static_mutex_unlock(&cache_lock);
+
+        g_free(cache);
+}
+
+static void magazine_refill(struct pool_state *ps, guint id,
+                            struct pool_magazine *mag)
+{
+        guint n;
+
+        wrap_g_static_mutex_lock(&ps->lock);
+        if (!ps->free_list) {
+                pool_grow(ps, id);
+        }
+        for (n = 0; n < POOL_BATCH && ps->free_list; ++n) {
+                gpointer obj = ps->free_list;
+                ps->free_list = *(gpointer *)obj;
+                --ps->free;
+                *(gpointer *)obj = mag->head;
+                mag->head = obj;
+                ++mag->count;
+        }
+        wrap_g_static_mutex_unlock(&ps->lock);
+}
+
+static void magazine_drain(struct pool_state *ps, struct pool_magazine *mag)
+{
+        guint n;
+
+        wrap_g_static_mutex_lock(&ps->lock);
+        for (n = 0; n < POOL_BATCH && mag->head; ++n) {
+                gpointer obj = mag->head;
+                mag->head = *(gpointer *)obj;
+                --mag->count;
+                *(gpointer *)obj = ps->free_list;
+                ps->free_list = obj;
+                ++ps->free;
+        }
+        wrap_g_static_mutex_unlock(&ps->lock);
+}
+
+
+/**
+ * oh_pool_alloc
+ * @pool: pool to allocate from
+ *
+ * Returns an uninitialized object of the pool size.
+ * Falls back to g_malloc() if the pool cannot grow.
+ **/
+gpointer oh_pool_alloc(struct oh_pool *pool)
+{
+        struct pool_state *ps = pool_state(pool);
+        struct pool_magazine *mag;
+        gpointer obj;
+        guint id;
+
+        if (!ps) {
+                return g_malloc(pool->size);
+        }
+        id = (guint)(ps - pools);
+        mag = &cache_get()->mags[id];
+
+        if (!mag->head) {
+                magazine_refill(ps, id, mag);
+                if (!mag->head) {
+                        ++mag->heap_allocs;
+                        return g_malloc(pool->size);
+                }
+        }
+
+        obj = mag->head;
+        mag->head = *(gpointer *)obj;
+        --mag->count;
+        ++mag->allocs;
+
+        return obj;
+}
+
+/**
+ * oh_pool_alloc0
+ * @pool: pool to allocate from
+ *
+ * Same as oh_pool_alloc(), the object is zeroed.
+ **/
+gpointer oh_pool_alloc0(struct oh_pool *pool)
+{
+        gpointer obj = oh_pool_alloc(pool);
+
+        memset(obj, 0, pool->size);
+
+        return obj;
+}
+
+/**
+ * oh_pool_free
+ * @pool: pool the object was allocated from
+ * @obj: object to free, may be NULL
+ *
+ * Objects that do not come from a pool are freed with g_free().
+ **/
+void oh_pool_free(struct oh_pool *pool, gpointer obj)
+{
+        struct pool_slab *slab;
+        struct pool_state *ps;
+        struct pool_magazine *mag;
+
+        if (!obj) {
+                return;
+        }
+
+        slab = slab_find(obj);
+        if (!slab) {
+                g_free(obj);
+                ps = pool_state(pool);
+                if (ps) {
+                        ++cache_get()->mags[ps - pools].heap_frees;
+                }
+                return;
+        }
+
+        /* The slab knows the pool, in case the caller got it wrong */
+        ps = &pools[slab->id];
+        mag = &cache_get()->mags[slab->id];
+
+        *(gpointer *)obj = mag->head;
+        mag->head = obj;
+        ++mag->count;
+        ++mag->frees;
+
+        if (mag->count >= 2 * POOL_BATCH) {
+                magazine_drain(ps, mag);
+        }
+}
+
+/**
+ * oh_pool_get_stats
+ * @index: pool number, from 0
+ * @stats: filled in with the pool statistics
+ *
+ * The counters of running threads are read without locking them,
+ * so they may be slightly behind.
+ *
+ * Returns: FALSE if there is no pool with that number.
+ **/
+gboolean oh_pool_get_stats(guint index, struct oh_pool_stats *stats)
+{
+        struct pool_state *ps;
+        GSList *node;
+
+        if (!stats || index >= (guint)g_atomic_int_get(&npools)) {
+                return FALSE;
+        }
+        ps = &pools[index];
+
+        memset(stats, 0, sizeof(*stats));
+        stats->name = ps->pool->name;
+        stats->size = ps->pool->size;
+
+        wrap_g_static_mutex_lock(&cache_lock);
+        stats->allocs = ps->allocs;
+        stats->frees = ps->frees;
+        stats->heap_allocs = ps->heap_allocs;
+        stats->heap_frees = ps->heap_frees;
+        for (node = caches; node; node = node->next) {
+                struct pool_magazine *mag =
+                        &((struct pool_cache *)node->data)->mags[index];
+                stats->cached += mag->count;
+                stats->allocs += mag->allocs;
+                stats->frees += mag->frees;
+                stats->heap_allocs += mag->heap_allocs;
+                stats->heap_frees += mag->heap_frees;
+        }
+        wrap_g_static_mutex_unlock(&cache_lock);
+
+        wrap_g_static_mutex_lock(&ps->lock);
+        stats->slabs = ps->slabs;
+        stats->capacity = ps->slabs * ps->per_slab;
+        stats->free = ps->free;
+        wrap_g_static_mutex_unlock(&ps->lock);
+
+        return TRUE;
+}
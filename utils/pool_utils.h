@@ -0,0 +1,80 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ */
+
+#ifndef __POOL_UTILS_H
+#define __POOL_UTILS_H
+
+#ifndef __OH_UTILS_H
+#warning *** Include oh_utils.h instead of individual utility header files ***
+#endif
+
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***
+ * Object pools
+ **************
+ * A pool hands out objects of one fixed size from slabs of
+ * OH_POOL_SLAB_SIZE bytes. Every thread keeps a small cache of free
+ * objects per pool, so most allocations and frees take no lock.
+ * Slabs are never returned to the system.
+ *
+ * oh_pool_free() also accepts objects that were allocated with
+ * g_malloc() and frees them with g_free(). So code that still builds
+ * events or RDRs with g_new0() can pass them to oh_event_free().
+ * Pooled objects must never be passed to g_free().
+ *
+ * Pools are declared statically:
+ *     static struct oh_pool rdr_pool = OH_POOL_INIT("rdr", SaHpiRdrT);
+ **/
+
+#define OH_POOL_SLAB_SIZE  (64 * 1024)
+#define OH_POOL_MAX_POOLS  16
+#define OH_POOL_MAX_SLABS  4096 /* per process, more goes to the heap */
+
+struct oh_pool {
+        const char *name;
+        gsize size;
+        volatile gint id; /* set on first use */
+};
+
+#define OH_POOL_INIT(name, type) { (name), sizeof(type), 0 }
+
+struct oh_pool_stats {
+        const char *name;
+        gsize size;          /* object size */
+        guint slabs;
+        guint capacity;      /* objects in all slabs */
+        guint free;          /* free objects in the shared free list */
+        guint cached;        /* free objects in thread caches */
+        guint64 allocs;
+        guint64 frees;
+        guint64 heap_allocs; /* pool was full, served by g_malloc() */
+        guint64 heap_frees;  /* objects passed to oh_pool_free()
+                                that did not come from a pool */
+};
+
+gpointer oh_pool_alloc(struct oh_pool *pool);
+gpointer oh_pool_alloc0(struct oh_pool *pool);
+void oh_pool_free(struct oh_pool *pool, gpointer obj);
+
+/* Pools are numbered from 0 in order of first use.
+ * Returns FALSE if there is no pool with that number. */
+gboolean oh_pool_get_stats(guint index, struct oh_pool_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POOL_UTILS_H */
@@ -33,6 +33,9 @@ typedef struct {
        void *data; /* private data for the owner of the rpt entry. */
 } RDRecord;
 
+static struct oh_pool rptentry_pool = OH_POOL_INIT("rpt_entry", RPTEntry);
+static struct oh_pool rdrecord_pool = OH_POOL_INIT("rdr_record", RDRecord);
+
 
 static RPTEntry *get_rptentry_by_rid(RPTable *table, SaHpiResourceIdT rid)
 {
@@ -423,7 +426,7 @@ SaErrorT oh_add_resource(RPTable *table, SaHpiRptEntryT *entry, void *data, int
         rptentry = get_rptentry_by_rid(table, entry->ResourceId);
         /* If not, create new RPTEntry */
         if (!rptentry) {
-                rptentry = g_new0(RPTEntry, 1);
+                rptentry = (RPTEntry *)oh_pool_alloc0(&rptentry_pool);
                 if (!rptentry) {
                         return SA_ERR_HPI_OUT_OF_MEMORY;
                 }
@@ -485,7 +488,7 @@ SaErrorT oh_remove_resource(RPTable *table, SaHpiResourceIdT rid)
                 table->rptlist = g_slist_remove(table->rptlist, (gpointer)rptentry);
                 if (!rptentry->owndata) g_free(rptentry->data);
                 g_hash_table_remove(table->rptable, &(rptentry->rpt_entry.EntryId));
-                g_free((gpointer)rptentry);
+                oh_pool_free(&rptentry_pool, rptentry);
                 if (!table->rptlist) {
                         g_hash_table_destroy(table->rptable);
                         table->rptable = NULL;
@@ -706,7 +709,7 @@ SaErrorT oh_add_rdr(RPTable *table, SaHpiResourceIdT rid, SaHpiRdrT *rdr, void *
         rdrecord = get_rdrecord_by_id(rptentry, rdr->RecordId);
         /* If not, create new rdr */
         if (!rdrecord) {
-                rdrecord = g_new0(RDRecord, 1);
+                rdrecord = (RDRecord *)oh_pool_alloc0(&rdrecord_pool);
                 if (!rdrecord) {
                         return SA_ERR_HPI_OUT_OF_MEMORY;
                 }
@@ -768,7 +771,7 @@ SaErrorT oh_remove_rdr(RPTable *table, SaHpiResourceIdT rid, SaHpiEntryIdT rdrid
                 rptentry->rdrlist = g_slist_remove(rptentry->rdrlist, (gpointer)rdrecord);
                 if (!rdrecord->owndata) g_free(rdrecord->data);
                 g_hash_table_remove(rptentry->rdrtable, &(rdrecord->rdr.RecordId));
-                g_free((gpointer)rdrecord);
+                oh_pool_free(&rdrecord_pool, rdrecord);
                 if (!rptentry->rdrlist) {
                         g_hash_table_destroy(rptentry->rdrtable);
                         rptentry->rdrtable = NULL;
@@ -0,0 +1,93 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "bench.h"
+
+guint64 bench_now(void)
+{
+#if defined(CLOCK_MONOTONIC) && !defined(_WIN32)
+        struct timespec ts;
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (guint64)ts.tv_sec * 1000000000ULL + (guint64)ts.tv_nsec;
+#elif GLIB_CHECK_VERSION (2, 28, 0)
+        return (guint64)g_get_monotonic_time() * 1000;
+#else
+        GTimeVal tv;
+
+        g_get_current_time(&tv);
+        return ((guint64)tv.tv_sec * G_USEC_PER_SEC + tv.tv_usec) * 1000;
+#endif
+}
+
+guint bench_rounds(guint size, guint min_ops)
+{
+        if (size == 0 || size >= min_ops) {
+                return 1;
+        }
+        return min_ops / size;
+}
+
+GArray *bench_sizes(int argc, char **argv, const guint *defaults, guint n)
+{
+        GArray *sizes = g_array_new(FALSE, FALSE, sizeof(guint));
+        int i;
+
+        for (i = 1; i < argc; ++i) {
+                guint size = (guint)strtoul(argv[i], NULL, 10);
+                if (size > 0) {
+                        g_array_append_val(sizes, size);
+                }
+        }
+        if (sizes->len == 0) {
+                g_array_append_vals(sizes, defaults, n);
+        }
+
+        return sizes;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+        double da = *(const double *)a, db = *(const double *)b;
+
+        return (da < db) ? -1 : (da > db) ? 1 : 0;
+}
+
+void bench_header(const char *program)
+{
+        printf("# %s\n", program);
+        printf("# %-34s %9s %10s %12s %12s\n",
+               "benchmark", "size", "ops", "min-ns/op", "median-ns/op");
+}
+
+void bench_run(const char *name, bench_func func, guint size)
+{
+        double ns[BENCH_REPEAT];
+        guint64 ops = 0, t;
+        int i;
+
+        /* Warm up caches and allocators */
+        func(size, &ops);
+
+        for (i = 0; i < BENCH_REPEAT; ++i) {
+                ops = 0;
+                t = func(size, &ops);
+                ns[i] = ops ? (double)t / ops : 0.0;
+        }
+        qsort(ns, BENCH_REPEAT, sizeof(double), cmp_double);
+
+        printf("  %-34s %9u %10" G_GUINT64_FORMAT " %12.1f %12.1f\n",
+               name, size, ops, ns[0], ns[BENCH_REPEAT / 2]);
+        fflush(stdout);
+}
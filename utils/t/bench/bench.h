@@ -0,0 +1,53 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Timing harness for the micro-benchmarks (make check-bench).
+ */
+
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <glib.h>
+
+/* Number of timed runs of each benchmark, after one untimed run */
+#define BENCH_REPEAT   5
+
+/* A run does at least this many operations, so small sizes
+ * are repeated until the time is long enough to measure.
+ * Operations that are O(size) use fewer. */
+#define BENCH_MIN_OPS  50000
+
+/*
+ * A benchmark does its setup, times its operations with bench_now()
+ * and returns the time in ns. It sets *ops to the number of
+ * operations it timed. Everything it does must depend only on size,
+ * so that runs and builds can be compared.
+ */
+typedef guint64 (*bench_func)(guint size, guint64 *ops);
+
+/* Monotonic time in ns */
+guint64 bench_now(void);
+
+/* How often to repeat size operations to do at least min_ops */
+guint bench_rounds(guint size, guint min_ops);
+
+/* Reads the sizes from the command line, or uses the defaults */
+GArray *bench_sizes(int argc, char **argv, const guint *defaults, guint n);
+
+/*
+ * Runs func BENCH_REPEAT times and prints one line:
+ *     name  size  ops  min-ns/op  median-ns/op
+ * The minimum is the most stable number for comparing builds.
+ */
+void bench_run(const char *name, bench_func func, guint size);
+
+/* Prints the column header */
+void bench_header(const char *program);
+
+#endif /* __BENCH_H */
@@ -0,0 +1,166 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Event log benchmarks. The size is the number of entries in the log.
+ *
+ * Usage: el_bench [size...]
+ */
+
+#include <string.h>
+
+#include <SaHpi.h>
+#include <oh_utils.h>
+
+#include "bench.h"
+
+static const guint default_sizes[] = { 10, 100, 1000, 10000 };
+
+/* Appends and lookups walk the log, so they are repeated less */
+#define EL_MIN_OPS  5000
+
+static void make_event(SaHpiEventT *event, guint i)
+{
+        memset(event, 0, sizeof(*event));
+        event->Source = i % 64 + 1;
+        event->EventType = SAHPI_ET_SENSOR;
+        event->Severity = SAHPI_MINOR;
+        event->Timestamp = (SaHpiTimeT)i * 1000;
+        event->EventDataUnion.SensorEvent.SensorNum = i % 16;
+        event->EventDataUnion.SensorEvent.SensorType = SAHPI_TEMPERATURE;
+        event->EventDataUnion.SensorEvent.EventCategory = SAHPI_EC_THRESHOLD;
+        event->EventDataUnion.SensorEvent.Assertion = SAHPI_TRUE;
+        event->EventDataUnion.SensorEvent.EventState = SAHPI_ES_UPPER_MINOR;
+}
+
+static oh_el *fill_el(guint size)
+{
+        oh_el *el = oh_el_create(size);
+        SaHpiEventT event;
+        guint i;
+
+        for (i = 0; i < size; ++i) {
+                make_event(&event, i);
+                oh_el_append(el, &event, NULL, NULL);
+        }
+
+        return el;
+}
+
+/* Append size events to an empty log */
+static guint64 append(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, EL_MIN_OPS), r, i;
+        guint64 total = 0, start;
+        SaHpiEventT event;
+        oh_el *el;
+
+        make_event(&event, 0);
+        for (r = 0; r < rounds; ++r) {
+                el = oh_el_create(size);
+                start = bench_now();
+                for (i = 0; i < size; ++i) {
+                        oh_el_append(el, &event, NULL, NULL);
+                }
+                total += bench_now() - start;
+                oh_el_close(el);
+        }
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Append size events to a full log, each drops the oldest entry */
+static guint64 append_full(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, EL_MIN_OPS), r, i;
+        guint64 start, total;
+        SaHpiEventT event;
+        oh_el *el;
+
+        el = fill_el(size);
+        make_event(&event, 0);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                for (i = 0; i < size; ++i) {
+                        oh_el_append(el, &event, NULL, NULL);
+                }
+        }
+        total = bench_now() - start;
+        oh_el_close(el);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Get entries spread over a log of size entries by id */
+static guint64 get(guint size, guint64 *ops)
+{
+        SaHpiEventLogEntryIdT first, prev, next;
+        oh_el_entry *entry;
+        guint64 start, total;
+        guint i;
+        oh_el *el;
+
+        el = fill_el(size);
+        oh_el_get(el, SAHPI_OLDEST_ENTRY, &prev, &next, &entry);
+        first = entry->event.EntryId;
+        start = bench_now();
+        for (i = 0; i < EL_MIN_OPS; ++i) {
+                oh_el_get(el, first + (i * 7919) % size, &prev, &next, &entry);
+        }
+        total = bench_now() - start;
+        oh_el_close(el);
+        *ops = EL_MIN_OPS;
+
+        return total;
+}
+
+/* Walk a log of size entries from the oldest to the newest */
+static guint64 get_next(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, EL_MIN_OPS), r;
+        SaHpiEventLogEntryIdT id, prev, next;
+        oh_el_entry *entry;
+        guint64 start, total;
+        oh_el *el;
+
+        el = fill_el(size);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                id = SAHPI_OLDEST_ENTRY;
+                while (id != SAHPI_NO_MORE_ENTRIES &&
+                       oh_el_get(el, id, &prev, &next, &entry) == SA_OK) {
+                        id = next;
+                }
+        }
+        total = bench_now() - start;
+        oh_el_close(el);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+int main(int argc, char **argv)
+{
+        GArray *sizes = bench_sizes(argc, argv, default_sizes,
+                                    G_N_ELEMENTS(default_sizes));
+        guint i;
+
+        bench_header("el_bench");
+        for (i = 0; i < sizes->len; ++i) {
+                guint size = g_array_index(sizes, guint, i);
+                bench_run("oh_el_append", append, size);
+                bench_run("oh_el_append (full)", append_full, size);
+                bench_run("oh_el_get", get, size);
+                bench_run("oh_el_get (walk)", get_next, size);
+        }
+        g_array_free(sizes, TRUE);
+
+        return 0;
+}
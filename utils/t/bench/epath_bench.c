@@ -0,0 +1,177 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * Entity path and uid benchmarks. The size is the number of different
+ * entity paths. The uid map file is taken from OPENHPI_UID_MAP,
+ * check-bench points it to a file in the build directory.
+ *
+ * Usage: epath_bench [size...]
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <SaHpi.h>
+#include <oh_utils.h>
+
+#include "bench.h"
+
+static const guint default_sizes[] = { 10, 100, 1000, 10000 };
+
+/* Every new uid grows the uid table and the map file */
+#define UID_NEW_MIN_OPS  2000
+
+/* Uids are never removed, so every run assigns uids
+ * to paths in a chassis that was not used before */
+static guint chassis = 0;
+
+static void make_ep(SaHpiEntityPathT *ep, guint chassis_num, guint i)
+{
+        oh_init_ep(ep);
+        ep->Entry[0].EntityType = SAHPI_ENT_PROCESSOR;
+        ep->Entry[0].EntityLocation = i % 4;
+        ep->Entry[1].EntityType = SAHPI_ENT_SYSTEM_BLADE;
+        ep->Entry[1].EntityLocation = i / 4;
+        ep->Entry[2].EntityType = SAHPI_ENT_SYSTEM_CHASSIS;
+        ep->Entry[2].EntityLocation = chassis_num;
+        ep->Entry[3].EntityType = SAHPI_ENT_ROOT;
+        ep->Entry[3].EntityLocation = 0;
+}
+
+static SaHpiEntityPathT *make_eps(guint chassis_num, guint size)
+{
+        SaHpiEntityPathT *eps = g_new(SaHpiEntityPathT, size);
+        guint i;
+
+        for (i = 0; i < size; ++i) {
+                make_ep(&eps[i], chassis_num, i);
+        }
+
+        return eps;
+}
+
+/* Assign uids to size new entity paths */
+static guint64 uid_new(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, UID_NEW_MIN_OPS), r, i;
+        guint64 total = 0, start;
+        SaHpiEntityPathT *eps;
+
+        for (r = 0; r < rounds; ++r) {
+                eps = make_eps(++chassis, size);
+                start = bench_now();
+                for (i = 0; i < size; ++i) {
+                        oh_uid_from_entity_path(&eps[i]);
+                }
+                total += bench_now() - start;
+                g_free(eps);
+        }
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Get the uids of size entity paths that have uids */
+static guint64 uid_existing(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r, i;
+        guint64 start, total;
+        SaHpiEntityPathT *eps;
+
+        eps = make_eps(0, size);
+        for (i = 0; i < size; ++i) {
+                oh_uid_from_entity_path(&eps[i]);
+        }
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                for (i = 0; i < size; ++i) {
+                        oh_uid_from_entity_path(&eps[(i * 7919) % size]);
+                }
+        }
+        total = bench_now() - start;
+        g_free(eps);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Encode size entity path strings */
+static guint64 encode(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r, i;
+        gchar **strs = g_new(gchar *, size);
+        guint64 start, total;
+        SaHpiEntityPathT ep;
+
+        for (i = 0; i < size; ++i) {
+                strs[i] = g_strdup_printf("{SYSTEM_CHASSIS,1}"
+                                          "{SYSTEM_BLADE,%u}{PROCESSOR,%u}",
+                                          i / 4, i % 4);
+        }
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                for (i = 0; i < size; ++i) {
+                        oh_encode_entitypath(strs[i], &ep);
+                }
+        }
+        total = bench_now() - start;
+        for (i = 0; i < size; ++i) {
+                g_free(strs[i]);
+        }
+        g_free(strs);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Decode size entity paths to strings */
+static guint64 decode(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r, i;
+        guint64 start, total;
+        SaHpiEntityPathT *eps;
+        oh_big_textbuffer buf;
+
+        eps = make_eps(1, size);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                for (i = 0; i < size; ++i) {
+                        oh_decode_entitypath(&eps[i], &buf);
+                }
+        }
+        total = bench_now() - start;
+        g_free(eps);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+int main(int argc, char **argv)
+{
+        GArray *sizes = bench_sizes(argc, argv, default_sizes,
+                                    G_N_ELEMENTS(default_sizes));
+        guint i;
+
+        if (oh_uid_initialize()) {
+                fprintf(stderr, "oh_uid_initialize failed\n");
+                return 1;
+        }
+
+        bench_header("epath_bench");
+        for (i = 0; i < sizes->len; ++i) {
+                guint size = g_array_index(sizes, guint, i);
+                bench_run("oh_encode_entitypath", encode, size);
+                bench_run("oh_decode_entitypath", decode, size);
+                bench_run("oh_uid_from_entity_path (new)", uid_new, size);
+                bench_run("oh_uid_from_entity_path", uid_existing, size);
+        }
+        g_array_free(sizes, TRUE);
+
+        return 0;
+}
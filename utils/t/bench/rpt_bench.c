@@ -0,0 +1,246 @@
+/*      -*- linux-c -*-
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  This
+ * file and program are licensed under a BSD style license.  See
+ * the Copying file included with the OpenHPI distribution for
+ * full licensing terms.
+ *
+ * RPT benchmarks. The size is the number of resources in the table,
+ * or the number of RDRs of one resource.
+ *
+ * Usage: rpt_bench [size...]
+ */
+
+#include <string.h>
+
+#include <SaHpi.h>
+#include <oh_utils.h>
+
+#include "bench.h"
+
+static const guint default_sizes[] = { 10, 100, 1000, 10000 };
+
+/* Adding walks the list of resources or RDRs, so it is repeated less */
+#define ADD_MIN_OPS  20000
+
+static void make_resource(SaHpiRptEntryT *rpte, guint i)
+{
+        memset(rpte, 0, sizeof(*rpte));
+        rpte->ResourceId = i + 1;
+        rpte->ResourceCapabilities = SAHPI_CAPABILITY_RESOURCE |
+                                     SAHPI_CAPABILITY_RDR |
+                                     SAHPI_CAPABILITY_SENSOR;
+        oh_init_ep(&rpte->ResourceEntity);
+        rpte->ResourceEntity.Entry[0].EntityType = SAHPI_ENT_SYSTEM_BOARD;
+        rpte->ResourceEntity.Entry[0].EntityLocation = i;
+        rpte->ResourceEntity.Entry[1].EntityType = SAHPI_ENT_ROOT;
+        oh_init_textbuffer(&rpte->ResourceTag);
+        oh_append_textbuffer(&rpte->ResourceTag, "Benchmark resource");
+}
+
+static void make_sensor(SaHpiRdrT *rdr, guint i)
+{
+        memset(rdr, 0, sizeof(*rdr));
+        rdr->RdrType = SAHPI_SENSOR_RDR;
+        rdr->RdrTypeUnion.SensorRec.Num = i;
+        rdr->RdrTypeUnion.SensorRec.Type = SAHPI_TEMPERATURE;
+        rdr->RdrTypeUnion.SensorRec.Category = SAHPI_EC_THRESHOLD;
+        oh_init_textbuffer(&rdr->IdString);
+        oh_append_textbuffer(&rdr->IdString, "Benchmark sensor");
+}
+
+static void fill_table(RPTable *table, guint size)
+{
+        SaHpiRptEntryT rpte;
+        guint i;
+
+        oh_init_rpt(table);
+        for (i = 0; i < size; ++i) {
+                make_resource(&rpte, i);
+                oh_add_resource(table, &rpte, NULL, 0);
+        }
+}
+
+static void fill_rdrs(RPTable *table, guint size)
+{
+        SaHpiRptEntryT rpte;
+        SaHpiRdrT rdr;
+        guint i;
+
+        oh_init_rpt(table);
+        make_resource(&rpte, 0);
+        oh_add_resource(table, &rpte, NULL, 0);
+        for (i = 0; i < size; ++i) {
+                make_sensor(&rdr, i);
+                oh_add_rdr(table, rpte.ResourceId, &rdr, NULL, 0);
+        }
+}
+
+/* Add size resources to an empty table */
+static guint64 add_resource(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, ADD_MIN_OPS), r, i;
+        SaHpiRptEntryT *entries = g_new(SaHpiRptEntryT, size);
+        guint64 total = 0, start;
+        RPTable table;
+
+        for (i = 0; i < size; ++i) {
+                make_resource(&entries[i], i);
+        }
+        for (r = 0; r < rounds; ++r) {
+                oh_init_rpt(&table);
+                start = bench_now();
+                for (i = 0; i < size; ++i) {
+                        oh_add_resource(&table, &entries[i], NULL, 0);
+                }
+                total += bench_now() - start;
+                oh_flush_rpt(&table);
+        }
+        g_free(entries);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Look up every resource of a table of size resources by id */
+static guint64 get_resource_by_id(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r, i;
+        guint64 start, total;
+        RPTable table;
+
+        fill_table(&table, size);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                for (i = 0; i < size; ++i) {
+                        /* A stride visits the ids out of order */
+                        oh_get_resource_by_id(&table, (i * 7919) % size + 1);
+                }
+        }
+        total = bench_now() - start;
+        oh_flush_rpt(&table);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Walk a table of size resources with oh_get_resource_next */
+static guint64 get_resource_next(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r;
+        SaHpiRptEntryT *rpte;
+        guint64 start, total;
+        RPTable table;
+
+        fill_table(&table, size);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                rpte = oh_get_resource_next(&table, SAHPI_FIRST_ENTRY);
+                while (rpte) {
+                        rpte = oh_get_resource_next(&table, rpte->ResourceId);
+                }
+        }
+        total = bench_now() - start;
+        oh_flush_rpt(&table);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Add size RDRs to one resource */
+static guint64 add_rdr(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, ADD_MIN_OPS), r, i;
+        SaHpiRdrT *rdrs = g_new(SaHpiRdrT, size);
+        guint64 total = 0, start;
+        SaHpiRptEntryT rpte;
+        RPTable table;
+
+        for (i = 0; i < size; ++i) {
+                make_sensor(&rdrs[i], i);
+        }
+        make_resource(&rpte, 0);
+        for (r = 0; r < rounds; ++r) {
+                oh_init_rpt(&table);
+                oh_add_resource(&table, &rpte, NULL, 0);
+                start = bench_now();
+                for (i = 0; i < size; ++i) {
+                        oh_add_rdr(&table, rpte.ResourceId, &rdrs[i], NULL, 0);
+                }
+                total += bench_now() - start;
+                oh_flush_rpt(&table);
+        }
+        g_free(rdrs);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Walk the size RDRs of one resource with oh_get_rdr_next */
+static guint64 get_rdr_next(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r;
+        guint64 start, total;
+        SaHpiRdrT *rdr;
+        RPTable table;
+
+        fill_rdrs(&table, size);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                rdr = oh_get_rdr_next(&table, 1, SAHPI_FIRST_ENTRY);
+                while (rdr) {
+                        rdr = oh_get_rdr_next(&table, 1, rdr->RecordId);
+                }
+        }
+        total = bench_now() - start;
+        oh_flush_rpt(&table);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+/* Look up every RDR of one resource with size RDRs by id */
+static guint64 get_rdr_by_id(guint size, guint64 *ops)
+{
+        guint rounds = bench_rounds(size, BENCH_MIN_OPS), r, i;
+        guint64 start, total;
+        RPTable table;
+
+        fill_rdrs(&table, size);
+        start = bench_now();
+        for (r = 0; r < rounds; ++r) {
+                for (i = 0; i < size; ++i) {
+                        oh_get_rdr_by_id(&table, 1,
+                                oh_get_rdr_uid(SAHPI_SENSOR_RDR,
+                                               (i * 7919) % size));
+                }
+        }
+        total = bench_now() - start;
+        oh_flush_rpt(&table);
+        *ops = (guint64)rounds * size;
+
+        return total;
+}
+
+int main(int argc, char **argv)
+{
+        GArray *sizes = bench_sizes(argc, argv, default_sizes,
+                                    G_N_ELEMENTS(default_sizes));
+        guint i;
+
+        bench_header("rpt_bench");
+        for (i = 0; i < sizes->len; ++i) {
+                guint size = g_array_index(sizes, guint, i);
+                bench_run("oh_add_resource", add_resource, size);
+                bench_run("oh_get_resource_by_id", get_resource_by_id, size);
+                bench_run("oh_get_resource_next", get_resource_next, size);
+                bench_run("oh_add_rdr", add_rdr, size);
+                bench_run("oh_get_rdr_by_id", get_rdr_by_id, size);
+                bench_run("oh_get_rdr_next", get_rdr_next, size);
+        }
+        g_array_free(sizes, TRUE);
+
+        return 0;
+}